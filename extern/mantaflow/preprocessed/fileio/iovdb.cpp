@@ -594,6 +594,7 @@ int readObjectsVDB(const string &filename, std::vector<PbClass *> *objects, floa
   openvdb::initialize();
   openvdb::io::File file(filename);
   openvdb::GridPtrVec gridsVDB;
+  size_t gridsInFile = 0;
 
   // Register custom codecs, this makes sure custom attributes can be read
   registerCustomCodecs();
@@ -601,7 +602,23 @@ int readObjectsVDB(const string &filename, std::vector<PbClass *> *objects, floa
   try {
     file.setCopyMaxBytes(0);
     file.open();
-    gridsVDB = *(file.getGrids());
+    // Only read the grids of the given objects. Files may contain more grids than requested,
+    // e.g. when only the final grids of a resumable cache are loaded for playback.
+    openvdb::GridPtrVecPtr gridsMeta = file.readAllGridMetadata();
+    gridsInFile = gridsMeta->size();
+    if (gridsInFile == 1) {
+      gridsVDB = *(file.getGrids());
+    }
+    else {
+      for (const openvdb::GridBase::Ptr &gridMeta : *gridsMeta) {
+        for (PbClass *object : *objects) {
+          if (gridMeta->getName() == object->getName()) {
+            gridsVDB.push_back(file.readGrid(gridMeta->getName()));
+            break;
+          }
+        }
+      }
+    }
     openvdb::MetaMap::Ptr metadata = file.getMetadata();
     unusedParameter(metadata);  // Unused for now
   }
@@ -626,7 +643,7 @@ int readObjectsVDB(const string &filename, std::vector<PbClass *> *objects, floa
     }
     // If there is just one grid in this file, load it regardless of name match (to vdb caches per
     // grid).
-    const bool onlyGrid = (gridsVDB.size() == 1);
+    const bool onlyGrid = (gridsInFile == 1);
 
     PbClass *object = dynamic_cast<PbClass *>(*iter);
     const Real dx = object->getParent()->getDx();
@@ -5,7 +5,12 @@
 
 #include "device/device.h"
 #include "scene/camera.h"
+#include "scene/geometry.h"
 #include "scene/integrator.h"
+#include "scene/light.h"
+#include "scene/object.h"
+#include "scene/particles.h"
+#include "scene/procedural.h"
 #include "scene/scene.h"
 #include "session/buffers.h"
 #include "session/session.h"
@@ -37,6 +42,8 @@ struct Options {
   Session *session;
   Scene *scene;
   string filepath;
+  /* All input files, rendered one after another with the same session. */
+  vector<string> filepaths;
   int width, height;
   SceneParams scene_params;
   SessionParams session_params;
@@ -111,6 +118,32 @@ static void scene_init()
   options.scene->camera->compute_auto_viewplane();
 }
 
+/* Output file path for the input file with the given index. A sequence of `#` in the output path
+ * is replaced by the zero padded index. */
+static string session_output_filepath(const int file_index)
+{
+  const size_t start = options.output_filepath.find('#');
+  if (start == string::npos) {
+    return options.output_filepath;
+  }
+  const size_t end = options.output_filepath.find_first_not_of('#', start);
+  const int digits = ((end == string::npos) ? options.output_filepath.size() : end) - start;
+  string filepath = options.output_filepath;
+  filepath.replace(start, digits, string_printf("%0*d", digits, file_index));
+  return filepath;
+}
+
+static void session_output_driver_init(const int file_index)
+{
+  if (!options.output_filepath.empty()) {
+    options.session->set_output_driver(make_unique<OIIOOutputDriver>(
+        session_output_filepath(file_index),
+        options.output_pass,
+        options.session_params.samples,
+        session_print));
+  }
+}
+
 static void session_init()
 {
   options.output_pass = "combined";
@@ -123,10 +156,7 @@ static void session_init()
   }
 #endif
 
-  if (!options.output_filepath.empty()) {
-    options.session->set_output_driver(make_unique<OIIOOutputDriver>(
-        options.output_filepath, options.output_pass, session_print));
-  }
+  session_output_driver_init(0);
 
   if (options.session_params.background && !options.quiet)
     options.session->progress.set_update_callback(function_bind(&session_print_status));
@@ -147,6 +177,37 @@ static void session_init()
   options.session->start();
 }
 
+/* Remove everything read from the previous input file. Shaders can not be deleted from a scene,
+ * unused ones are kept. */
+static void scene_clear()
+{
+  Scene *scene = options.scene;
+  scene->delete_nodes(set<Object *>(scene->objects.begin(), scene->objects.end()));
+  scene->delete_nodes(set<Geometry *>(scene->geometry.begin(), scene->geometry.end()));
+  scene->delete_nodes(set<Light *>(scene->lights.begin(), scene->lights.end()));
+  scene->delete_nodes(
+      set<ParticleSystem *>(scene->particle_systems.begin(), scene->particle_systems.end()));
+  scene->delete_nodes(set<Procedural *>(scene->procedurals.begin(), scene->procedurals.end()));
+}
+
+/* Render the next input file with the existing session. The device with its loaded kernels is
+ * kept, and images that are used by the next file again are not reloaded, because they are only
+ * freed on the next device update when no node uses them anymore. */
+static void session_next_file(const int file_index)
+{
+  options.filepath = options.filepaths[file_index];
+  session_output_driver_init(file_index);
+
+  {
+    thread_scoped_lock scene_lock(options.scene->mutex);
+    scene_clear();
+    scene_init();
+  }
+
+  options.session->reset(options.session_params, session_buffer_params());
+  options.session->start();
+}
+
 static void session_exit()
 {
   if (options.session) {
@@ -334,7 +395,10 @@ static void keyboard(unsigned char key)
 
 static int files_parse(int argc, const char *argv[])
 {
-  if (argc > 0)
+  for (int i = 0; i < argc; i++) {
+    options.filepaths.push_back(argv[i]);
+  }
+  if (options.filepath == "" && argc > 0)
     options.filepath = argv[0];
 
   return 0;
@@ -372,7 +436,7 @@ static void options_parse(int argc, const char **argv)
   bool help = false, debug = false, version = false;
   int verbosity = 1;
 
-  ap.options("Usage: cycles [options] file.xml",
+  ap.options("Usage: cycles [options] file.xml [file.xml ...]",
              "%*",
              files_parse,
              "",
@@ -393,9 +457,14 @@ static void options_parse(int argc, const char **argv)
              "--samples %d",
              &options.session_params.samples,
              "Number of samples to render",
+             "--sample-offset %d",
+             &options.session_params.sample_offset,
+             "Number of samples to skip, to render distinct samples of the same image on "
+             "multiple machines and merge the results",
              "--output %s",
              &options.output_filepath,
-             "File path to write output image",
+             "File path to write output image, # characters are replaced by the index of the "
+             "input file when rendering multiple files",
              "--threads %d",
              &options.session_params.threads,
              "CPU Rendering Threads",
@@ -503,10 +572,23 @@ static void options_parse(int argc, const char **argv)
     fprintf(stderr, "Invalid number of samples: %d\n", options.session_params.samples);
     exit(EXIT_FAILURE);
   }
+  else if (options.session_params.sample_offset < 0) {
+    fprintf(stderr, "Invalid sample offset: %d\n", options.session_params.sample_offset);
+    exit(EXIT_FAILURE);
+  }
   else if (options.filepath == "") {
     fprintf(stderr, "No file path specified\n");
     exit(EXIT_FAILURE);
   }
+  else if (options.filepaths.size() > 1 && !options.session_params.background) {
+    fprintf(stderr, "Multiple input files can only be rendered in background mode\n");
+    exit(EXIT_FAILURE);
+  }
+  else if (options.filepaths.size() > 1 && !options.output_filepath.empty() &&
+           options.output_filepath.find('#') == string::npos) {
+    fprintf(stderr, "Output file path must contain # when rendering multiple files\n");
+    exit(EXIT_FAILURE);
+  }
 }
 
 CCL_NAMESPACE_END
@@ -524,6 +606,10 @@ int main(int argc, const char **argv)
 #endif
     session_init();
     options.session->wait();
+    for (int i = 1; i < options.filepaths.size(); i++) {
+      session_next_file(i);
+      options.session->wait();
+    }
     session_exit();
 #ifdef WITH_CYCLES_STANDALONE_GUI
   }
@@ -15,7 +15,10 @@ class OIIOOutputDriver : public OutputDriver {
  public:
   typedef function<void(const string &)> LogFunction;
 
-  OIIOOutputDriver(const string_view filepath, const string_view pass, LogFunction log);
+  OIIOOutputDriver(const string_view filepath,
+                   const string_view pass,
+                   const int samples,
+                   LogFunction log);
   virtual ~OIIOOutputDriver();
 
   void write_render_tile(const Tile &tile) override;
@@ -23,6 +26,7 @@ class OIIOOutputDriver : public OutputDriver {
  protected:
   string filepath_;
   string pass_;
+  int samples_;
   LogFunction log_;
 };
 
@@ -51,6 +51,7 @@ class AddPresetSampling(AddPresetBase, Operator):
         "cycles.samples",
         "cycles.adaptive_threshold",
         "cycles.adaptive_min_samples",
+        "cycles.adaptive_max_noisy_fraction",
         "cycles.time_limit",
         "cycles.use_denoising",
         "cycles.denoiser",
@@ -377,6 +377,12 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         min=0.0, max=1.0,
         default=0.01,
     )
+    use_light_power_sampling: BoolProperty(
+        name="Light Power Sampling",
+        description="Pick point, spot and area lights proportionally to their strength instead of uniformly. "
+        "Reduces noise in scenes with many lights of very different strength",
+        default=False,
+    )
 
     use_adaptive_sampling: BoolProperty(
         name="Use Adaptive Sampling",
@@ -397,6 +403,13 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         min=0, max=4096,
         default=0,
     )
+    adaptive_max_noisy_fraction: FloatProperty(
+        name="Adaptive Max Noisy Pixels",
+        description="Stop rendering when at most this fraction of pixels is still above the noise threshold, instead of rendering until all pixels are below it or the maximum samples are reached",
+        min=0.0, max=1.0,
+        default=0.0,
+        subtype='FACTOR',
+    )
 
     use_preview_adaptive_sampling: BoolProperty(
         name="Use Adaptive Sampling",
@@ -653,6 +666,13 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         description="Use special type BVH optimized for curves (uses more ram but renders faster)",
         default=True,
     )
+    debug_bvh_curve_strand_leaf_size: IntProperty(
+        name="Strand Leaf Size",
+        description="Maximum number of segments of the same hair strand in a BVH leaf, "
+        "higher values save memory for dense hair",
+        default=1,
+        min=1, max=16,
+    )
     debug_use_compact_bvh: BoolProperty(
         name="Use Compact BVH",
         description="Use compact BVH structure (uses less ram but renders slower)",
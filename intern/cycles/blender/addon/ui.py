@@ -230,6 +230,7 @@ class CYCLES_RENDER_PT_sampling_render(CyclesButtonsPanel, Panel):
         if cscene.use_adaptive_sampling:
             col.prop(cscene, "samples", text=" Max Samples")
             col.prop(cscene, "adaptive_min_samples", text="Min Samples")
+            col.prop(cscene, "adaptive_max_noisy_fraction", text="Max Noisy Pixels")
         else:
             col.prop(cscene, "samples", text="Samples")
         col.prop(cscene, "time_limit")
@@ -299,6 +300,7 @@ class CYCLES_RENDER_PT_sampling_advanced(CyclesButtonsPanel, Panel):
         col.prop(cscene, "min_light_bounces")
         col.prop(cscene, "min_transparent_bounces")
         col.prop(cscene, "light_sampling_threshold", text="Light Threshold")
+        col.prop(cscene, "use_light_power_sampling", text="Light Power Sampling")
 
         for view_layer in scene.view_layers:
             if view_layer.samples > 0:
@@ -687,6 +689,7 @@ class CYCLES_RENDER_PT_performance_acceleration_structure(CyclesButtonsPanel, Pa
                 sub.prop(cscene, "debug_bvh_time_steps")
 
                 col.prop(cscene, "debug_use_hair_bvh")
+                col.prop(cscene, "debug_bvh_curve_strand_leaf_size")
 
                 sub = col.column(align=True)
                 sub.label(text="Cycles built without Embree support")
@@ -698,6 +701,7 @@ class CYCLES_RENDER_PT_performance_acceleration_structure(CyclesButtonsPanel, Pa
             sub.prop(cscene, "debug_bvh_time_steps")
 
             col.prop(cscene, "debug_use_hair_bvh")
+            col.prop(cscene, "debug_bvh_curve_strand_leaf_size")
 
             # CPU is used in addition to a GPU
             if use_multi_device(context) and use_embree:
@@ -405,8 +405,13 @@ static float4 lookup_instance_property(BL::DepsgraphObjectInstance &b_instance,
   string idprop_name = string_printf("[\"%s\"]", name.c_str());
   float4 value;
 
-  /* If requesting instance data, check the parent particle system and object. */
+  /* If requesting instance data, check the instance attributes of geometry nodes instances, the
+   * parent particle system and object. */
   if (use_instancer && b_instance.is_instance()) {
+    if (b_instance.instance_attribute_lookup(name.c_str(), &value.x)) {
+      return value;
+    }
+
     BL::ParticleSystem b_psys = b_instance.particle_system();
 
     if (b_psys) {
@@ -10,6 +10,7 @@
 
 #include "util/algorithm.h"
 #include "util/boundbox.h"
+#include "util/tbb.h"
 #include "util/types.h"
 
 CCL_NAMESPACE_BEGIN
@@ -83,75 +84,38 @@ BVHObjectBinning::BVHObjectBinning(const BVHRange &job,
   num_bins = min(size_t(MAX_BINS), size_t(4.0f + 0.05f * size()));
   scale = rcp(cent_bounds_.size()) * make_float3((float)num_bins);
 
-  /* initialize binning counter and bounds */
-  BoundBox bin_bounds[MAX_BINS][4]; /* bounds for every bin in every dimension */
-  int4 bin_count[MAX_BINS];         /* number of primitives mapped to bin */
+  /* map geometry to bins */
+  Bins bins;
+  init_bins(bins);
 
-  for (size_t i = 0; i < num_bins; i++) {
-    bin_count[i] = make_int4(0);
-    bin_bounds[i][0] = bin_bounds[i][1] = bin_bounds[i][2] = BoundBox::empty;
+  if (size() < PARALLEL_MIN_SIZE) {
+    bin_primitives(prims, 0, size(), bins);
   }
-
-  /* map geometry to bins, unrolled once */
-  {
-    int64_t i;
-
-    for (i = 0; i < int64_t(size()) - 1; i += 2) {
-      prefetch_L2(&prims[start() + i + 8]);
-
-      /* map even and odd primitive to bin */
-      const BVHReference &prim0 = prims[start() + i + 0];
-      const BVHReference &prim1 = prims[start() + i + 1];
-
-      BoundBox bounds0 = get_prim_bounds(prim0);
-      BoundBox bounds1 = get_prim_bounds(prim1);
-
-      int4 bin0 = get_bin(bounds0);
-      int4 bin1 = get_bin(bounds1);
-
-      /* increase bounds for bins for even primitive */
-      int b00 = (int)extract<0>(bin0);
-      bin_count[b00][0]++;
-      bin_bounds[b00][0].grow(bounds0);
-      int b01 = (int)extract<1>(bin0);
-      bin_count[b01][1]++;
-      bin_bounds[b01][1].grow(bounds0);
-      int b02 = (int)extract<2>(bin0);
-      bin_count[b02][2]++;
-      bin_bounds[b02][2].grow(bounds0);
-
-      /* increase bounds of bins for odd primitive */
-      int b10 = (int)extract<0>(bin1);
-      bin_count[b10][0]++;
-      bin_bounds[b10][0].grow(bounds1);
-      int b11 = (int)extract<1>(bin1);
-      bin_count[b11][1]++;
-      bin_bounds[b11][1].grow(bounds1);
-      int b12 = (int)extract<2>(bin1);
-      bin_count[b12][2]++;
-      bin_bounds[b12][2].grow(bounds1);
-    }
-
-    /* for uneven number of primitives */
-    if (i < int64_t(size())) {
-      /* map primitive to bin */
-      const BVHReference &prim0 = prims[start() + i];
-      BoundBox bounds0 = get_prim_bounds(prim0);
-      int4 bin0 = get_bin(bounds0);
-
-      /* increase bounds of bins */
-      int b00 = (int)extract<0>(bin0);
-      bin_count[b00][0]++;
-      bin_bounds[b00][0].grow(bounds0);
-      int b01 = (int)extract<1>(bin0);
-      bin_count[b01][1]++;
-      bin_bounds[b01][1].grow(bounds0);
-      int b02 = (int)extract<2>(bin0);
-      bin_count[b02][2]++;
-      bin_bounds[b02][2].grow(bounds0);
+  else {
+    /* Every thread bins into its own histogram. Merging them is independent of the order, so the
+     * result is the same as binning on a single thread. */
+    enumerable_thread_specific<Bins> thread_bins([&]() {
+      Bins local_bins;
+      init_bins(local_bins);
+      return local_bins;
+    });
+    parallel_for(blocked_range<int64_t>(0, size(), 4096),
+                 [&](const blocked_range<int64_t> &r) {
+                   bin_primitives(prims, r.begin(), r.end(), thread_bins.local());
+                 });
+    for (const Bins &local_bins : thread_bins) {
+      for (size_t i = 0; i < num_bins; i++) {
+        bins.count[i] = bins.count[i] + local_bins.count[i];
+        for (int d = 0; d < 3; d++) {
+          bins.bounds[i][d] = merge(bins.bounds[i][d], local_bins.bounds[i][d]);
+        }
+      }
     }
   }
 
+  const BoundBox(*bin_bounds)[4] = bins.bounds;
+  const int4 *bin_count = bins.count;
+
   /* sweep from right to left and compute parallel prefix of merged bounds */
   float4 r_area[MAX_BINS];  /* area of bounds of primitives on the right */
   float4 r_count[MAX_BINS]; /* number of primitives on the right */
@@ -213,6 +177,106 @@ BVHObjectBinning::BVHObjectBinning(const BVHRange &job,
   leafSAH = bounds_.half_area() * blocks(size());
 }
 
+void BVHObjectBinning::init_bins(Bins &bins) const
+{
+  for (size_t i = 0; i < num_bins; i++) {
+    bins.count[i] = make_int4(0);
+    bins.bounds[i][0] = bins.bounds[i][1] = bins.bounds[i][2] = BoundBox::empty;
+  }
+}
+
+void BVHObjectBinning::bin_primitives(const BVHReference *prims,
+                                      const int64_t begin,
+                                      const int64_t end,
+                                      Bins &bins) const
+{
+  BoundBox(*bin_bounds)[4] = bins.bounds;
+  int4 *bin_count = bins.count;
+
+  /* map geometry to bins, unrolled once */
+  int64_t i;
+
+  for (i = begin; i < end - 1; i += 2) {
+    prefetch_L2(&prims[start() + i + 8]);
+
+    /* map even and odd primitive to bin */
+    const BVHReference &prim0 = prims[start() + i + 0];
+    const BVHReference &prim1 = prims[start() + i + 1];
+
+    BoundBox bounds0 = get_prim_bounds(prim0);
+    BoundBox bounds1 = get_prim_bounds(prim1);
+
+    int4 bin0 = get_bin(bounds0);
+    int4 bin1 = get_bin(bounds1);
+
+    /* increase bounds for bins for even primitive */
+    int b00 = (int)extract<0>(bin0);
+    bin_count[b00][0]++;
+    bin_bounds[b00][0].grow(bounds0);
+    int b01 = (int)extract<1>(bin0);
+    bin_count[b01][1]++;
+    bin_bounds[b01][1].grow(bounds0);
+    int b02 = (int)extract<2>(bin0);
+    bin_count[b02][2]++;
+    bin_bounds[b02][2].grow(bounds0);
+
+    /* increase bounds of bins for odd primitive */
+    int b10 = (int)extract<0>(bin1);
+    bin_count[b10][0]++;
+    bin_bounds[b10][0].grow(bounds1);
+    int b11 = (int)extract<1>(bin1);
+    bin_count[b11][1]++;
+    bin_bounds[b11][1].grow(bounds1);
+    int b12 = (int)extract<2>(bin1);
+    bin_count[b12][2]++;
+    bin_bounds[b12][2].grow(bounds1);
+  }
+
+  /* for uneven number of primitives */
+  if (i < end) {
+    /* map primitive to bin */
+    const BVHReference &prim0 = prims[start() + i];
+    BoundBox bounds0 = get_prim_bounds(prim0);
+    int4 bin0 = get_bin(bounds0);
+
+    /* increase bounds of bins */
+    int b00 = (int)extract<0>(bin0);
+    bin_count[b00][0]++;
+    bin_bounds[b00][0].grow(bounds0);
+    int b01 = (int)extract<1>(bin0);
+    bin_count[b01][1]++;
+    bin_bounds[b01][1].grow(bounds0);
+    int b02 = (int)extract<2>(bin0);
+    bin_count[b02][2]++;
+    bin_bounds[b02][2].grow(bounds0);
+  }
+}
+
+/* Bounds and centroid bounds of a range of primitives, merging the bounds is independent of the
+ * order so the result is the same as computing them on a single thread. */
+static void compute_bounds_parallel(const BVHReference *prims,
+                                    const int64_t begin,
+                                    const int64_t end,
+                                    BoundBox &r_geom_bounds,
+                                    BoundBox &r_cent_bounds)
+{
+  enumerable_thread_specific<std::pair<BoundBox, BoundBox>> thread_bounds(
+      std::pair<BoundBox, BoundBox>(BoundBox::empty, BoundBox::empty));
+  parallel_for(blocked_range<int64_t>(begin, end, 4096), [&](const blocked_range<int64_t> &r) {
+    std::pair<BoundBox, BoundBox> &bounds = thread_bounds.local();
+    for (int64_t i = r.begin(); i < r.end(); i++) {
+      bounds.first.grow(prims[i].bounds());
+      bounds.second.grow(prims[i].bounds().center2());
+    }
+  });
+  r_geom_bounds = BoundBox::empty;
+  r_cent_bounds = BoundBox::empty;
+  for (const std::pair<BoundBox, BoundBox> &bounds : thread_bounds) {
+    r_geom_bounds.grow(bounds.first);
+    r_cent_bounds.grow(bounds.second);
+  }
+}
+
 void BVHObjectBinning::split(BVHReference *prims,
                              BVHObjectBinning &left_o,
                              BVHObjectBinning &right_o) const
@@ -226,6 +290,9 @@ void BVHObjectBinning::split(BVHReference *prims,
 
   int64_t l = 0, r = N - 1;
 
+  /* The bounds of large ranges are computed by multiple threads after partitioning. */
+  const bool use_threads = N >= PARALLEL_MIN_SIZE;
+
   while (l <= r) {
     prefetch_L2(&prims[start() + l + 8]);
     prefetch_L2(&prims[start() + r - 8]);
@@ -233,20 +300,28 @@ void BVHObjectBinning::split(BVHReference *prims,
     BVHReference prim = prims[start() + l];
     BoundBox unaligned_bounds = get_prim_bounds(prim);
     float3 unaligned_center = unaligned_bounds.center2();
-    float3 center = prim.bounds().center2();
 
     if (get_bin(unaligned_center)[dim] < pos) {
-      lgeom_bounds.grow(prim.bounds());
-      lcent_bounds.grow(center);
+      if (!use_threads) {
+        lgeom_bounds.grow(prim.bounds());
+        lcent_bounds.grow(prim.bounds().center2());
+      }
       l++;
     }
     else {
-      rgeom_bounds.grow(prim.bounds());
-      rcent_bounds.grow(center);
+      if (!use_threads) {
+        rgeom_bounds.grow(prim.bounds());
+        rcent_bounds.grow(prim.bounds().center2());
+      }
       swap(prims[start() + l], prims[start() + r]);
       r--;
     }
   }
+
+  if (use_threads) {
+    compute_bounds_parallel(prims + start(), 0, l, lgeom_bounds, lcent_bounds);
+    compute_bounds_parallel(prims + start(), l, N, rgeom_bounds, rcent_bounds);
+  }
   /* finish */
   if (l != 0 && N - 1 - r != 0) {
     right_o = BVHObjectBinning(BVHRange(rgeom_bounds, rcent_bounds, start() + l, N - 1 - r),
@@ -58,6 +58,19 @@ class BVHObjectBinning : public BVHRange {
   enum { MAX_BINS = 32 };
   enum { LOG_BLOCK_SIZE = 2 };
 
+  /* Ranges with more primitives are binned and partitioned by multiple threads, this is mainly
+   * the case for the top levels of a large BVH, which are not parallelized by the builder. */
+  enum { PARALLEL_MIN_SIZE = 65536 };
+
+  /* bounds and number of primitives for every bin in every dimension */
+  struct Bins {
+    BoundBox bounds[MAX_BINS][4];
+    int4 count[MAX_BINS];
+  };
+
+  void init_bins(Bins &bins) const;
+  void bin_primitives(const BVHReference *prims, int64_t begin, int64_t end, Bins &bins) const;
+
   /* computes the bin numbers for each dimension for a box. */
   __forceinline int4 get_bin(const BoundBox &box) const
   {
@@ -628,7 +628,7 @@ bool BVHBuild::range_within_max_leaf_size(const BVHRange &range,
 {
   size_t size = range.size();
   size_t max_leaf_size = max(max(params.max_triangle_leaf_size, params.max_curve_leaf_size),
-                             params.max_point_leaf_size);
+                             max(params.max_curve_strand_leaf_size, params.max_point_leaf_size));
 
   if (size > max_leaf_size)
     return false;
@@ -639,6 +639,9 @@ bool BVHBuild::range_within_max_leaf_size(const BVHRange &range,
   size_t num_motion_curves = 0;
   size_t num_points = 0;
   size_t num_motion_points = 0;
+  /* Whether all static curve segments belong to the same strand. */
+  bool curves_single_strand = true;
+  const BVHReference *first_curve_ref = nullptr;
 
   for (int i = 0; i < size; i++) {
     const BVHReference &ref = references[range.start() + i];
@@ -649,6 +652,13 @@ bool BVHBuild::range_within_max_leaf_size(const BVHRange &range,
       }
       else {
         num_curves++;
+        if (first_curve_ref == nullptr) {
+          first_curve_ref = &ref;
+        }
+        else if (ref.prim_object() != first_curve_ref->prim_object() ||
+                 ref.prim_index() != first_curve_ref->prim_index()) {
+          curves_single_strand = false;
+        }
       }
     }
     else if (ref.prim_type() & PRIMITIVE_TRIANGLE) {
@@ -671,7 +681,8 @@ bool BVHBuild::range_within_max_leaf_size(const BVHRange &range,
 
   return (num_triangles <= params.max_triangle_leaf_size) &&
          (num_motion_triangles <= params.max_motion_triangle_leaf_size) &&
-         (num_curves <= params.max_curve_leaf_size) &&
+         ((num_curves <= params.max_curve_leaf_size) ||
+          (curves_single_strand && num_curves <= params.max_curve_strand_leaf_size)) &&
          (num_motion_curves <= params.max_motion_curve_leaf_size) &&
          (num_points <= params.max_point_leaf_size) &&
          (num_motion_points <= params.max_motion_point_leaf_size);
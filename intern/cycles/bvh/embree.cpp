@@ -817,7 +817,12 @@ void BVHEmbree::refit(Progress &progress)
 {
   progress.set_substatus("Refitting BVH nodes");
 
-  /* Update all vertex buffers, then tell Embree to rebuild/-fit the BVHs. */
+  /* Update all vertex buffers, then tell Embree to rebuild/-fit the BVHs.
+   *
+   * In the viewport the triangle BVHs are refitted instead of built again. This is much faster
+   * when meshes deform every frame, at the cost of gradually lower trace performance until the
+   * topology changes and the BVH is built again. */
+  const bool refit_triangles = params.bvh_type == BVH_TYPE_DYNAMIC;
   unsigned geom_id = 0;
   foreach (Object *ob, objects) {
     if (!params.top_level || (ob->is_traceable() && !ob->get_geometry()->is_instanced())) {
@@ -829,6 +834,9 @@ void BVHEmbree::refit(Progress &progress)
           RTCGeometry geom = rtcGetGeometry(scene, geom_id);
           set_tri_vertex_buffer(geom, mesh, true);
           rtcSetGeometryUserData(geom, (void *)mesh->prim_offset);
+          if (refit_triangles) {
+            rtcSetGeometryBuildQuality(geom, RTC_BUILD_QUALITY_REFIT);
+          }
           rtcCommitGeometry(geom);
         }
       }
@@ -70,6 +70,10 @@ class BVHParams {
   int max_motion_triangle_leaf_size;
   int max_curve_leaf_size;
   int max_motion_curve_leaf_size;
+  /* Maximum number of segments in a leaf when all of them belong to the same strand. Neighboring
+   * segments of a strand are bounded well together by an unaligned node, which saves nodes and
+   * node tests for dense hair. */
+  int max_curve_strand_leaf_size;
   int max_point_leaf_size;
   int max_motion_point_leaf_size;
 
@@ -124,6 +128,7 @@ class BVHParams {
     max_motion_triangle_leaf_size = 8;
     max_curve_leaf_size = 1;
     max_motion_curve_leaf_size = 4;
+    max_curve_strand_leaf_size = 1;
     max_point_leaf_size = 8;
     max_motion_point_leaf_size = 8;
 
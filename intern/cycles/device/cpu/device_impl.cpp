@@ -149,6 +149,15 @@ void CPUDevice::mem_copy_to(device_memory &mem)
   }
 }
 
+void CPUDevice::mem_copy_to(device_memory &mem, size_t /*size*/, size_t /*offset*/)
+{
+  if (!mem.device_pointer || mem.type == MEM_TEXTURE) {
+    mem_copy_to(mem);
+  }
+
+  /* copy is no-op */
+}
+
 void CPUDevice::mem_copy_from(
     device_memory & /*mem*/, size_t /*y*/, size_t /*w*/, size_t /*h*/, size_t /*elem*/)
 {
@@ -547,11 +547,15 @@ void CUDADevice::move_textures_to_host(size_t size, bool for_texture)
   /* Signal to reallocate textures in host memory only. */
   move_texture_to_host = true;
 
+  size_t moved_image_size = 0;
+  size_t moved_other_size = 0;
+
   while (size > 0) {
     /* Find suitable memory allocation to move. */
     device_memory *max_mem = NULL;
     size_t max_size = 0;
     bool max_is_image = false;
+    bool max_frees_enough = false;
 
     thread_scoped_lock lock(cuda_mem_map_mutex);
     foreach (CUDAMemMap::value_type &pair, cuda_mem_map) {
@@ -578,9 +582,24 @@ void CUDADevice::move_textures_to_host(size_t size, bool for_texture)
         continue;
       }
 
-      /* Try to move largest allocation, prefer moving images. */
-      if (is_image > max_is_image || (is_image == max_is_image && mem.device_size > max_size)) {
+      /* Prefer moving images. Of those, move the smallest allocation that frees enough memory,
+       * so that as little data as possible is accessed through slower host memory. When none
+       * frees enough, move the largest allocation and continue with the next one. */
+      const bool frees_enough = mem.device_size >= size;
+      bool is_better = false;
+      if (is_image != max_is_image) {
+        is_better = is_image;
+      }
+      else if (frees_enough != max_frees_enough) {
+        is_better = frees_enough;
+      }
+      else {
+        is_better = frees_enough ? mem.device_size < max_size : mem.device_size > max_size;
+      }
+
+      if (max_mem == NULL || is_better) {
         max_is_image = is_image;
+        max_frees_enough = frees_enough;
         max_size = mem.device_size;
         max_mem = &mem;
       }
@@ -607,6 +626,12 @@ void CUDADevice::move_textures_to_host(size_t size, bool for_texture)
        * if it so happens to do an allocation at the same time as well. */
       max_mem->device_copy_to();
       size = (max_size >= size) ? 0 : size - max_size;
+      if (max_is_image) {
+        moved_image_size += max_size;
+      }
+      else {
+        moved_other_size += max_size;
+      }
 
       any_device_moving_textures_to_host = false;
     }
@@ -618,6 +643,13 @@ void CUDADevice::move_textures_to_host(size_t size, bool for_texture)
   /* Unset flag before texture info is reloaded, since it should stay in device memory. */
   move_texture_to_host = false;
 
+  if (moved_image_size + moved_other_size > 0) {
+    VLOG(1) << "Moved " << string_human_readable_size(moved_image_size) << " of images and "
+            << string_human_readable_size(moved_other_size)
+            << " of other textures from device to host, mapped host memory in use: "
+            << string_human_readable_size(map_host_used) << ".";
+  }
+
   /* Update texture info array with new pointers. */
   load_texture_info();
 }
@@ -747,6 +779,11 @@ CUDADevice::CUDAMem *CUDADevice::generic_alloc(device_memory &mem, size_t pitch_
 }
 
 void CUDADevice::generic_copy_to(device_memory &mem)
+{
+  generic_copy_to(mem, mem.memory_size(), 0);
+}
+
+void CUDADevice::generic_copy_to(device_memory &mem, size_t size, size_t offset)
 {
   if (!mem.host_pointer || !mem.device_pointer) {
     return;
@@ -758,8 +795,9 @@ void CUDADevice::generic_copy_to(device_memory &mem)
   thread_scoped_lock lock(cuda_mem_map_mutex);
   if (!cuda_mem_map[&mem].use_mapped_host || mem.host_pointer != mem.shared_pointer) {
     const CUDAContextScope scope(this);
-    cuda_assert(
-        cuMemcpyHtoD((CUdeviceptr)mem.device_pointer, mem.host_pointer, mem.memory_size()));
+    cuda_assert(cuMemcpyHtoD((CUdeviceptr)mem.device_pointer + offset,
+                             (char *)mem.host_pointer + offset,
+                             size));
   }
 }
 
@@ -832,6 +870,17 @@ void CUDADevice::mem_copy_to(device_memory &mem)
   }
 }
 
+void CUDADevice::mem_copy_to(device_memory &mem, size_t size, size_t offset)
+{
+  if (mem.type == MEM_TEXTURE || !mem.device_pointer) {
+    mem_copy_to(mem);
+    return;
+  }
+
+  /* Global memory keeps its device pointer, so the kernel globals don't need an update. */
+  generic_copy_to(mem, size, offset);
+}
+
 void CUDADevice::mem_copy_from(device_memory &mem, size_t y, size_t w, size_t h, size_t elem)
 {
   if (mem.type == MEM_TEXTURE || mem.type == MEM_GLOBAL) {
@@ -190,10 +190,16 @@ void CUDADeviceQueue::copy_to_device(device_memory &mem)
 }
 
 void CUDADeviceQueue::copy_from_device(device_memory &mem)
+{
+  copy_from_device(mem, mem.memory_size());
+}
+
+void CUDADeviceQueue::copy_from_device(device_memory &mem, size_t size)
 {
   assert(mem.type != MEM_GLOBAL && mem.type != MEM_TEXTURE);
 
-  if (mem.memory_size() == 0) {
+  size = min(size, mem.memory_size());
+  if (size == 0) {
     return;
   }
 
@@ -203,8 +209,7 @@ void CUDADeviceQueue::copy_from_device(device_memory &mem)
   /* Copy memory from device. */
   const CUDAContextScope scope(cuda_device_);
   assert_success(
-      cuMemcpyDtoHAsync(
-          mem.host_pointer, (CUdeviceptr)mem.device_pointer, mem.memory_size(), cuda_stream_),
+      cuMemcpyDtoHAsync(mem.host_pointer, (CUdeviceptr)mem.device_pointer, size, cuda_stream_),
       "copy_from_device");
 }
 
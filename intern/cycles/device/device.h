@@ -260,6 +260,9 @@ class Device {
 
   virtual void mem_alloc(device_memory &mem) = 0;
   virtual void mem_copy_to(device_memory &mem) = 0;
+  /* Copy a range of the memory in bytes, memory that is not allocated on the device yet is copied
+   * entirely. */
+  virtual void mem_copy_to(device_memory &mem, size_t size, size_t offset) = 0;
   virtual void mem_copy_from(device_memory &mem, size_t y, size_t w, size_t h, size_t elem) = 0;
   virtual void mem_zero(device_memory &mem) = 0;
   virtual void mem_free(device_memory &mem) = 0;
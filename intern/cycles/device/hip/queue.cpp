@@ -188,10 +188,16 @@ void HIPDeviceQueue::copy_to_device(device_memory &mem)
 }
 
 void HIPDeviceQueue::copy_from_device(device_memory &mem)
+{
+  copy_from_device(mem, mem.memory_size());
+}
+
+void HIPDeviceQueue::copy_from_device(device_memory &mem, size_t size)
 {
   assert(mem.type != MEM_GLOBAL && mem.type != MEM_TEXTURE);
 
-  if (mem.memory_size() == 0) {
+  size = min(size, mem.memory_size());
+  if (size == 0) {
     return;
   }
 
@@ -201,8 +207,7 @@ void HIPDeviceQueue::copy_from_device(device_memory &mem)
   /* Copy memory from device. */
   const HIPContextScope scope(hip_device_);
   assert_success(
-      hipMemcpyDtoHAsync(
-          mem.host_pointer, (hipDeviceptr_t)mem.device_pointer, mem.memory_size(), hip_stream_),
+      hipMemcpyDtoHAsync(mem.host_pointer, (hipDeviceptr_t)mem.device_pointer, size, hip_stream_),
       "copy_from_device");
 }
 
@@ -38,6 +38,7 @@ class HIPDeviceQueue : public DeviceQueue {
   virtual void zero_to_device(device_memory &mem) override;
   virtual void copy_to_device(device_memory &mem) override;
   virtual void copy_from_device(device_memory &mem) override;
+  virtual void copy_from_device(device_memory &mem, size_t size) override;
 
   virtual hipStream_t stream()
   {
@@ -275,6 +275,7 @@ class device_memory {
   void device_alloc();
   void device_free();
   void device_copy_to();
+  void device_copy_to(size_t size, size_t offset);
   void device_copy_from(size_t y, size_t w, size_t h, size_t elem);
   void device_zero();
 
@@ -527,6 +528,17 @@ template<typename T> class device_vector : public device_memory {
     copy_to_device();
   }
 
+  /* Copy only a range of elements, when the rest of the data did not change since the last copy.
+   * The entire array is copied when it is not allocated on the device yet. */
+  void copy_to_device_if_modified(size_t width, size_t offset)
+  {
+    if (!modified || width == 0) {
+      return;
+    }
+
+    device_copy_to(sizeof(T) * width, sizeof(T) * offset);
+  }
+
   void clear_modified()
   {
     modified = false;
@@ -117,12 +117,16 @@ class MetalDevice : public Device {
 
   void generic_copy_to(device_memory &mem);
 
+  void generic_copy_to(device_memory &mem, size_t size, size_t offset);
+
   void generic_free(device_memory &mem);
 
   void mem_alloc(device_memory &mem) override;
 
   void mem_copy_to(device_memory &mem) override;
 
+  void mem_copy_to(device_memory &mem, size_t size, size_t offset) override;
+
   void mem_copy_from(device_memory &mem)
   {
     mem_copy_from(mem, -1, -1, -1, -1);
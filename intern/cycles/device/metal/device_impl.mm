@@ -511,6 +511,11 @@ MetalDevice::MetalMem *MetalDevice::generic_alloc(device_memory &mem)
 }
 
 void MetalDevice::generic_copy_to(device_memory &mem)
+{
+  generic_copy_to(mem, mem.memory_size(), 0);
+}
+
+void MetalDevice::generic_copy_to(device_memory &mem, size_t size, size_t offset)
 {
   if (!mem.host_pointer || !mem.device_pointer) {
     return;
@@ -519,9 +524,9 @@ void MetalDevice::generic_copy_to(device_memory &mem)
   std::lock_guard<std::recursive_mutex> lock(metal_mem_map_mutex);
   if (!metal_mem_map.at(&mem)->use_UMA || mem.host_pointer != mem.shared_pointer) {
     MetalMem &mmem = *metal_mem_map.at(&mem);
-    memcpy(mmem.hostPtr, mem.host_pointer, mem.memory_size());
+    memcpy((char *)mmem.hostPtr + offset, (char *)mem.host_pointer + offset, size);
     if (mmem.mtlBuffer.storageMode == MTLStorageModeManaged) {
-      [mmem.mtlBuffer didModifyRange:NSMakeRange(0, mem.memory_size())];
+      [mmem.mtlBuffer didModifyRange:NSMakeRange(offset, size)];
     }
   }
 }
@@ -601,6 +606,27 @@ void MetalDevice::mem_copy_to(device_memory &mem)
   }
 }
 
+void MetalDevice::mem_copy_to(device_memory &mem, size_t size, size_t offset)
+{
+  if (mem.type == MEM_TEXTURE || !mem.device_pointer) {
+    mem_copy_to(mem);
+    return;
+  }
+
+  {
+    std::lock_guard<std::recursive_mutex> lock(metal_mem_map_mutex);
+    auto it = metal_mem_map.find(&mem);
+    if (it == metal_mem_map.end() || offset + size > it->second->size) {
+      /* Not allocated by this device, or the host memory grew since the buffer was allocated. */
+      mem_copy_to(mem);
+      return;
+    }
+  }
+
+  /* Global memory keeps its buffer, so the kernel globals don't need an update. */
+  generic_copy_to(mem, size, offset);
+}
+
 void MetalDevice::mem_copy_from(device_memory &mem, size_t y, size_t w, size_t h, size_t elem)
 {
   if (mem.host_pointer) {
@@ -38,6 +38,7 @@ class MetalDeviceQueue : public DeviceQueue {
   virtual void zero_to_device(device_memory &mem) override;
   virtual void copy_to_device(device_memory &mem) override;
   virtual void copy_from_device(device_memory &mem) override;
+  virtual void copy_from_device(device_memory &mem, size_t size) override;
 
   virtual bool kernel_available(DeviceKernel kernel) const override;
 
@@ -454,10 +454,16 @@ void MetalDeviceQueue::copy_to_device(device_memory &mem)
 }
 
 void MetalDeviceQueue::copy_from_device(device_memory &mem)
+{
+  copy_from_device(mem, mem.memory_size());
+}
+
+void MetalDeviceQueue::copy_from_device(device_memory &mem, size_t size)
 {
   assert(mem.type != MEM_GLOBAL && mem.type != MEM_TEXTURE);
 
-  if (mem.memory_size() == 0) {
+  size = min(size, mem.memory_size());
+  if (size == 0) {
     return;
   }
 
@@ -467,8 +473,6 @@ void MetalDeviceQueue::copy_from_device(device_memory &mem)
   std::lock_guard<std::recursive_mutex> lock(metal_device->metal_mem_map_mutex);
   MetalDevice::MetalMem &mmem = *metal_device->metal_mem_map.at(&mem);
   if (mmem.mtlBuffer) {
-    const size_t size = mem.memory_size();
-
     if (mem.device_pointer) {
       if ([mmem.mtlBuffer storageMode] == MTLStorageModeManaged) {
         id<MTLBlitCommandEncoder> blitEncoder = get_blit_encoder();
@@ -309,6 +309,27 @@ class MultiDevice : public Device {
     stats.mem_alloc(mem.device_size - existing_size);
   }
 
+  void mem_copy_to(device_memory &mem, size_t size, size_t offset) override
+  {
+    device_ptr existing_key = mem.device_pointer;
+    if (!existing_key) {
+      mem_copy_to(mem);
+      return;
+    }
+
+    /* Device pointers don't change when copying a range, only the owner devices need a copy. */
+    foreach (const vector<SubDevice *> &island, peer_islands) {
+      SubDevice *owner_sub = find_suitable_mem_device(existing_key, island);
+      mem.device = owner_sub->device;
+      mem.device_pointer = owner_sub->ptr_map[existing_key];
+
+      owner_sub->device->mem_copy_to(mem, size, offset);
+    }
+
+    mem.device = this;
+    mem.device_pointer = existing_key;
+  }
+
   void mem_copy_from(device_memory &mem, size_t y, size_t w, size_t h, size_t elem) override
   {
     device_ptr key = mem.device_pointer;
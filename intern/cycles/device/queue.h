@@ -135,6 +135,9 @@ class DeviceQueue {
   virtual void zero_to_device(device_memory &mem) = 0;
   virtual void copy_to_device(device_memory &mem) = 0;
   virtual void copy_from_device(device_memory &mem) = 0;
+  /* Copy only the first size bytes of the memory from device, for when only part of the buffer
+   * was written. */
+  virtual void copy_from_device(device_memory &mem, size_t size) = 0;
 
   /* Graphics resources interoperability.
    *
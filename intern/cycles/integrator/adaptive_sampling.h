@@ -37,6 +37,8 @@ class AdaptiveSampling {
   int adaptive_step = 0;
   int min_samples = 0;
   float threshold = 0.0f;
+  /* Fraction of pixels which are allowed to stay above the threshold when rendering stops. */
+  float max_noisy_fraction = 0.0f;
 };
 
 CCL_NAMESPACE_END
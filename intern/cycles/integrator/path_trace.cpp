@@ -420,8 +420,8 @@ void PathTrace::adaptive_sample(RenderWork &render_work)
     render_scheduler_.report_adaptive_filter_time(
         render_work, time_dt() - start_time, is_cancel_requested());
 
-    if (num_active_pixels == 0) {
-      VLOG(3) << "All pixels converged.";
+    if (render_scheduler_.is_adaptive_sampling_converged(num_active_pixels)) {
+      VLOG(3) << "Pixels converged, " << num_active_pixels << " pixels still active.";
       if (!render_scheduler_.render_work_reschedule_on_converge(render_work)) {
         break;
       }
@@ -665,10 +665,13 @@ void PathTrace::rebalance(const RenderWork &render_work)
 
   if (VLOG_IS_ON(kLogLevel)) {
     VLOG(kLogLevel) << "Perform rebalance work.";
-    VLOG(kLogLevel) << "Per-device path tracing time (seconds):";
+    VLOG(kLogLevel) << "Per-device path tracing time (seconds) and throughput (work fraction "
+                       "per second):";
     for (int i = 0; i < num_works; ++i) {
+      const WorkBalanceInfo &info = work_balance_infos_[i];
       VLOG(kLogLevel) << path_trace_works_[i]->get_device()->info.description << ": "
-                      << work_balance_infos_[i].time_spent;
+                      << info.time_spent << ", "
+                      << ((info.time_spent > 0) ? info.weight / info.time_spent : 0.0);
     }
   }
 
@@ -19,8 +19,14 @@ struct KernelGlobalsCPU;
 
 class CPUKernels;
 
-/* Implementation of PathTraceWork which schedules work on to queues pixel-by-pixel,
- * for CPU devices.
+/* Implementation of PathTraceWork which schedules work on to queues in small square blocks of
+ * pixels, for CPU devices.
+ *
+ * Every path is traced by the megakernel from start to end, unlike the wavefront scheduling of
+ * PathTraceWorkGPU. The CPU kernels operate on a single IntegratorStateCPU rather than the state
+ * of arrays layout, and the Embree ray-tracing is done for single rays, so a wavefront mode would
+ * have to duplicate the whole integrator and intersection code. Coherence is instead improved by
+ * rendering neighboring pixels one after another on the same thread.
  *
  * NOTE: For the CPU rendering there are assumptions about TBB arena size and number of concurrent
  * queues on the render device which makes this work be only usable on CPU. */
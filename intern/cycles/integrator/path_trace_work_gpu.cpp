@@ -885,7 +885,9 @@ void PathTraceWorkGPU::copy_to_display_naive(PathTraceDisplay *display,
 
   get_render_tile_film_pixels(destination, pass_mode, num_samples);
 
-  queue_->copy_from_device(display_rgba_half_);
+  /* With a resolution divider only the beginning of the buffer is written, avoid transferring the
+   * rest of the final resolution allocation. */
+  queue_->copy_from_device(display_rgba_half_, sizeof(half4) * width * height);
   queue_->synchronize();
 
   display->copy_pixels_to_texture(display_rgba_half_.data(), texture_x, texture_y, width, height);
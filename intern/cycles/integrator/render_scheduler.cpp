@@ -55,6 +55,20 @@ bool RenderScheduler::is_adaptive_sampling_used() const
   return adaptive_sampling_.use;
 }
 
+bool RenderScheduler::is_adaptive_sampling_converged(uint num_active_pixels) const
+{
+  if (num_active_pixels == 0) {
+    return true;
+  }
+
+  if (state_.resolution_divider != pixel_size_ || adaptive_sampling_.max_noisy_fraction == 0.0f) {
+    return false;
+  }
+
+  const double num_pixels = (double)buffer_params_.width * buffer_params_.height;
+  return num_active_pixels <= adaptive_sampling_.max_noisy_fraction * num_pixels;
+}
+
 void RenderScheduler::set_start_sample(int start_sample)
 {
   start_sample_ = start_sample;
@@ -132,6 +146,8 @@ void RenderScheduler::reset(const BufferParams &buffer_params, int num_samples,
   state_.last_display_update_time = 0.0;
   state_.last_display_update_sample = -1;
 
+  state_.last_denoise_path_trace_time = 0.0;
+
   state_.last_rebalance_time = 0.0;
   state_.num_rebalance_requested = 0;
   state_.num_rebalance_changes = 0;
@@ -364,6 +380,10 @@ void RenderScheduler::update_state_for_render_work(const RenderWork &render_work
     state_.last_display_update_sample = state_.num_rendered_samples;
   }
 
+  if (render_work.tile.denoise) {
+    state_.last_denoise_path_trace_time = path_trace_time_.get_wall();
+  }
+
   state_.last_work_tile_was_denoised = render_work.tile.denoise;
   state_.tile_result_was_written |= render_work.tile.write;
   state_.full_frame_was_written |= render_work.full.write;
@@ -962,6 +982,15 @@ bool RenderScheduler::work_need_denoise(bool &delayed, bool &ready_to_display)
     return false;
   }
 
+  /* Don't spend more time denoising than path tracing. Otherwise, with a fast device, every
+   * update adds only a few samples that barely change the denoised result, while the denoiser
+   * takes most of the time until the next update. */
+  if (path_trace_time_.get_wall() - state_.last_denoise_path_trace_time <
+      denoise_time_.get_average()) {
+    delayed = true;
+    return false;
+  }
+
   /* Avoid excessive denoising in viewport after reaching a certain sample count and render time.
    */
   /* TODO(sergey): Consider making time interval and sample configurable. */
@@ -102,6 +102,10 @@ class RenderScheduler {
 
   bool is_adaptive_sampling_used() const;
 
+  /* Check whether few enough pixels are still active for the adaptive sampling to be considered
+   * converged. */
+  bool is_adaptive_sampling_converged(uint num_active_pixels) const;
+
   /* Start sample for path tracing.
    * The scheduler will schedule work using this sample as the first one. */
   void set_start_sample(int start_sample);
@@ -360,6 +364,9 @@ class RenderScheduler {
      * noise floor. */
     float adaptive_sampling_threshold = 0.0f;
 
+    /* Wall time spent on path tracing at the point the latest denoising work was scheduled. */
+    double last_denoise_path_trace_time = 0.0;
+
     bool last_work_tile_was_denoised = false;
     bool tile_result_was_written = false;
     bool postprocess_work_scheduled = false;
@@ -53,8 +53,17 @@ bool work_balance_do_rebalance(vector<WorkBalanceInfo> &work_balance_infos)
    * amount of work based on the current average, but that after the weights changes the time will
    * equalize.
    * Can think of it that if one of the devices is 10% faster than another, then one device needs
-   * to do 5% less of the current work, and another needs to do 5% more. */
-  const double lerp_weight = 1.0 / num_infos;
+   * to do 5% less of the current work, and another needs to do 5% more.
+   *
+   * When the devices differ a lot in performance, as with a mix of a fast and an old GPU, this
+   * takes many rebalance steps during which the slowest device holds back all others. In that
+   * case the times are equalized directly, with the work scaled by the observed throughput. */
+  double min_time = DBL_MAX, max_time = 0;
+  for (const WorkBalanceInfo &info : work_balance_infos) {
+    min_time = min(min_time, info.time_spent);
+    max_time = max(max_time, info.time_spent);
+  }
+  const double lerp_weight = (max_time > 2.0 * min_time) ? 1.0 : 1.0 / num_infos;
 
   bool has_big_difference = false;
 
@@ -64,7 +73,9 @@ bool work_balance_do_rebalance(vector<WorkBalanceInfo> &work_balance_infos)
     new_weights.push_back(new_weight);
     total_weight += new_weight;
 
-    if (std::fabs(1.0 - time_target / time_average) > 0.02) {
+    /* Compare the observed time rather than the target, which equals the average when the
+     * times are equalized directly. */
+    if (std::fabs(1.0 - info.time_spent / time_average) > 0.02) {
       has_big_difference = true;
     }
   }
@@ -207,9 +207,9 @@ ccl_device_forceinline void mnee_setup_manifold_vertex(KernelGlobals kg,
     /* Smooth normal. */
     if (sd_vtx->shader & SHADER_SMOOTH_NORMAL) {
       /* Load triangle vertices. */
-      normals[0] = kernel_tex_fetch(__tri_vnormal, tri_vindex.x);
-      normals[1] = kernel_tex_fetch(__tri_vnormal, tri_vindex.y);
-      normals[2] = kernel_tex_fetch(__tri_vnormal, tri_vindex.z);
+      normals[0] = triangle_vertex_normal(kg, tri_vindex.x);
+      normals[1] = triangle_vertex_normal(kg, tri_vindex.y);
+      normals[2] = triangle_vertex_normal(kg, tri_vindex.z);
     }
   }
   else { /* if (sd_vtx->type & PRIMITIVE_MOTION_TRIANGLE) */
@@ -222,7 +222,7 @@ ccl_device_inline bool light_sample(KernelGlobals kg,
     }
   }
 
-  ls->pdf *= kernel_data.integrator.pdf_lights;
+  ls->pdf *= kernel_data.integrator.pdf_lights * klight->pdf_scale;
 
   return in_volume_segment || (ls->pdf > 0.0f);
 }
@@ -421,7 +421,7 @@ ccl_device bool light_sample_from_distant_ray(KernelGlobals kg,
   float invarea = klight->distant.invarea;
   ls->pdf = invarea / (costheta * costheta * costheta);
   ls->eval_fac = ls->pdf;
-  ls->pdf *= kernel_data.integrator.pdf_lights;
+  ls->pdf *= kernel_data.integrator.pdf_lights * klight->pdf_scale;
 
   return true;
 }
@@ -550,7 +550,7 @@ ccl_device bool light_sample_from_intersection(KernelGlobals kg,
     return false;
   }
 
-  ls->pdf *= kernel_data.integrator.pdf_lights;
+  ls->pdf *= kernel_data.integrator.pdf_lights * klight->pdf_scale;
 
   return true;
 }
@@ -1442,6 +1442,9 @@ typedef struct KernelLight {
     KernelAreaLight area;
     KernelDistantLight distant;
   };
+  /* Probability of picking this light relative to the uniform light selection. */
+  float pdf_scale;
+  float pad[3];
 } KernelLight;
 static_assert_align(KernelLight, 16);
 
@@ -3,6 +3,8 @@
 
 #include "scene/alembic.h"
 
+#include <atomic>
+
 #include "scene/alembic_read.h"
 #include "scene/camera.h"
 #include "scene/curves.h"
@@ -12,9 +14,12 @@
 #include "scene/scene.h"
 #include "scene/shader.h"
 
+#include "util/atomic.h"
 #include "util/foreach.h"
 #include "util/log.h"
 #include "util/progress.h"
+#include "util/task.h"
+#include "util/tbb.h"
 #include "util/transform.h"
 #include "util/vector.h"
 
@@ -830,6 +835,8 @@ void AlembicProcedural::generate(Scene *scene, Progress &progress)
   if (!archive.valid() || filepath_is_modified() || layers_is_modified()) {
     Alembic::AbcCoreFactory::IFactory factory;
     factory.setPolicy(Alembic::Abc::ErrorHandler::kQuietNoopPolicy);
+    /* Use a file stream per thread, so that objects can be loaded in parallel. */
+    factory.setOgawaNumStreams(TaskScheduler::max_concurrency());
 
     std::vector<std::string> filenames;
     filenames.push_back(filepath.c_str());
@@ -1440,81 +1447,98 @@ void AlembicProcedural::walk_hierarchy(
 
 void AlembicProcedural::build_caches(Progress &progress)
 {
+  const size_t memory_limit = use_prefetch ? get_prefetch_cache_size_in_bytes() : SIZE_MAX;
   size_t memory_used = 0;
+  std::atomic<bool> memory_limit_reached = false;
 
-  for (Node *node : objects) {
-    AlembicObject *object = static_cast<AlembicObject *>(node);
+  /* Objects are read independently of each other, the archive supports reading from multiple
+   * threads, and converting the data to the cache takes a significant part of the time. */
+  parallel_for(blocked_range<size_t>(0, objects.size(), 1), [&](const blocked_range<size_t> &r) {
+    for (size_t i = r.begin(); i != r.end(); i++) {
+      AlembicObject *object = static_cast<AlembicObject *>(objects[i]);
 
-    if (progress.get_cancel()) {
-      return;
-    }
-
-    if (object->schema_type == AlembicObject::POLY_MESH) {
-      if (!object->has_data_loaded()) {
-        IPolyMesh polymesh(object->iobject, Alembic::Abc::kWrapExisting);
-        IPolyMeshSchema schema = polymesh.getSchema();
-        object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
+      /* Don't load the remaining objects once the limit is exceeded. */
+      if (progress.get_cancel() || memory_limit_reached) {
+        return;
       }
-      else if (object->need_shader_update) {
-        IPolyMesh polymesh(object->iobject, Alembic::Abc::kWrapExisting);
-        IPolyMeshSchema schema = polymesh.getSchema();
-        read_attributes(this,
-                        object->get_cached_data(),
-                        schema,
-                        schema.getUVsParam(),
-                        object->get_requested_attributes(),
-                        progress);
+
+      build_object_cache(object, progress);
+
+      const size_t object_memory = object->get_cached_data().memory_used();
+      if (atomic_add_and_fetch_z(&memory_used, object_memory) > memory_limit) {
+        memory_limit_reached = true;
       }
     }
-    else if (object->schema_type == AlembicObject::CURVES) {
-      if (!object->has_data_loaded() || default_radius_is_modified() ||
-          object->radius_scale_is_modified()) {
-        ICurves curves(object->iobject, Alembic::Abc::kWrapExisting);
-        ICurvesSchema schema = curves.getSchema();
-        object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
-      }
+  });
+
+  if (progress.get_cancel()) {
+    return;
+  }
+
+  if (memory_limit_reached) {
+    progress.set_error("Error: Alembic Procedural memory limit reached");
+    return;
+  }
+
+  VLOG(1) << "AlembicProcedural memory usage : " << string_human_readable_size(memory_used);
+}
+
+void AlembicProcedural::build_object_cache(AlembicObject *object, Progress &progress)
+{
+  if (object->schema_type == AlembicObject::POLY_MESH) {
+    if (!object->has_data_loaded()) {
+      IPolyMesh polymesh(object->iobject, Alembic::Abc::kWrapExisting);
+      IPolyMeshSchema schema = polymesh.getSchema();
+      object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
     }
-    else if (object->schema_type == AlembicObject::POINTS) {
-      if (!object->has_data_loaded() || default_radius_is_modified() ||
-          object->radius_scale_is_modified()) {
-        IPoints points(object->iobject, Alembic::Abc::kWrapExisting);
-        IPointsSchema schema = points.getSchema();
-        object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
-      }
+    else if (object->need_shader_update) {
+      IPolyMesh polymesh(object->iobject, Alembic::Abc::kWrapExisting);
+      IPolyMeshSchema schema = polymesh.getSchema();
+      read_attributes(this,
+                      object->get_cached_data(),
+                      schema,
+                      schema.getUVsParam(),
+                      object->get_requested_attributes(),
+                      progress);
     }
-    else if (object->schema_type == AlembicObject::SUBD) {
-      if (!object->has_data_loaded()) {
-        ISubD subd_mesh(object->iobject, Alembic::Abc::kWrapExisting);
-        ISubDSchema schema = subd_mesh.getSchema();
-        object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
-      }
-      else if (object->need_shader_update) {
-        ISubD subd_mesh(object->iobject, Alembic::Abc::kWrapExisting);
-        ISubDSchema schema = subd_mesh.getSchema();
-        read_attributes(this,
-                        object->get_cached_data(),
-                        schema,
-                        schema.getUVsParam(),
-                        object->get_requested_attributes(),
-                        progress);
-      }
+  }
+  else if (object->schema_type == AlembicObject::CURVES) {
+    if (!object->has_data_loaded() || default_radius_is_modified() ||
+        object->radius_scale_is_modified()) {
+      ICurves curves(object->iobject, Alembic::Abc::kWrapExisting);
+      ICurvesSchema schema = curves.getSchema();
+      object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
     }
-
-    if (scale_is_modified() || object->get_cached_data().transforms.size() == 0) {
-      object->setup_transform_cache(object->get_cached_data(), scale);
+  }
+  else if (object->schema_type == AlembicObject::POINTS) {
+    if (!object->has_data_loaded() || default_radius_is_modified() ||
+        object->radius_scale_is_modified()) {
+      IPoints points(object->iobject, Alembic::Abc::kWrapExisting);
+      IPointsSchema schema = points.getSchema();
+      object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
     }
-
-    memory_used += object->get_cached_data().memory_used();
-
-    if (use_prefetch) {
-      if (memory_used > get_prefetch_cache_size_in_bytes()) {
-        progress.set_error("Error: Alembic Procedural memory limit reached");
-        return;
-      }
+  }
+  else if (object->schema_type == AlembicObject::SUBD) {
+    if (!object->has_data_loaded()) {
+      ISubD subd_mesh(object->iobject, Alembic::Abc::kWrapExisting);
+      ISubDSchema schema = subd_mesh.getSchema();
+      object->load_data_in_cache(object->get_cached_data(), this, schema, progress);
+    }
+    else if (object->need_shader_update) {
+      ISubD subd_mesh(object->iobject, Alembic::Abc::kWrapExisting);
+      ISubDSchema schema = subd_mesh.getSchema();
+      read_attributes(this,
+                      object->get_cached_data(),
+                      schema,
+                      schema.getUVsParam(),
+                      object->get_requested_attributes(),
+                      progress);
     }
   }
 
-  VLOG(1) << "AlembicProcedural memory usage : " << string_human_readable_size(memory_used);
+  if (scale_is_modified() || object->get_cached_data().transforms.size() == 0) {
+    object->setup_transform_cache(object->get_cached_data(), scale);
+  }
 }
 
 CCL_NAMESPACE_END
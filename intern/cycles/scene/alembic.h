@@ -559,6 +559,10 @@ class AlembicProcedural : public Procedural {
 
   void build_caches(Progress &progress);
 
+  /* Load the data of a single object into its cache, can be called from multiple threads for
+   * different objects. */
+  void build_object_cache(AlembicObject *object, Progress &progress);
+
   size_t get_prefetch_cache_size_in_bytes() const
   {
     /* prefetch_cache_size is in megabytes, so convert to bytes. */
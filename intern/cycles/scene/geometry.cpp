@@ -231,6 +231,7 @@ void Geometry::compute_bvh(Device *device,
       bparams.bvh_layout = bvh_layout;
       bparams.use_unaligned_nodes = dscene->data.bvh.have_curves &&
                                     params->use_bvh_unaligned_nodes;
+      bparams.max_curve_strand_leaf_size = params->bvh_curve_strand_leaf_size;
       bparams.num_motion_triangle_steps = params->num_bvh_time_steps;
       bparams.num_motion_curve_steps = params->num_bvh_time_steps;
       bparams.num_motion_point_steps = params->num_bvh_time_steps;
@@ -1076,6 +1077,36 @@ void GeometryManager::geom_calc_offset(Scene *scene, BVHLayout bvh_layout)
   }
 }
 
+/* Range of the elements of a device array that were written while packing the modified geometry.
+ * Only this range has to be copied to the device when the rest of the array didn't change. */
+struct PackedRange {
+  size_t begin = SIZE_MAX;
+  size_t end = 0;
+
+  void add(size_t offset, size_t size)
+  {
+    if (size != 0) {
+      begin = min(begin, offset);
+      end = max(end, offset + size);
+    }
+  }
+
+  /* The array may store multiple elements for every item of the range. */
+  template<typename T>
+  void copy_to_device(device_vector<T> &vector,
+                      bool copy_all_data,
+                      size_t elements_per_item = 1) const
+  {
+    if (copy_all_data) {
+      vector.copy_to_device_if_modified();
+    }
+    else if (begin < end) {
+      vector.copy_to_device_if_modified((end - begin) * elements_per_item,
+                                        begin * elements_per_item);
+    }
+  }
+};
+
 void GeometryManager::device_update_mesh(Device *,
                                          DeviceScene *dscene,
                                          Scene *scene,
@@ -1131,17 +1162,21 @@ void GeometryManager::device_update_mesh(Device *,
 
     packed_float3 *tri_verts = dscene->tri_verts.alloc(tri_size * 3);
     uint *tri_shader = dscene->tri_shader.alloc(tri_size);
-    packed_float3 *vnormal = dscene->tri_vnormal.alloc(vert_size);
+    uint *vnormal = dscene->tri_vnormal.alloc(vert_size);
     uint4 *tri_vindex = dscene->tri_vindex.alloc(tri_size);
     uint *tri_patch = dscene->tri_patch.alloc(tri_size);
     float2 *tri_patch_uv = dscene->tri_patch_uv.alloc(vert_size);
 
-    const bool copy_all_data = dscene->tri_shader.need_realloc() ||
+    const bool copy_all_data = dscene->tri_verts.need_realloc() ||
+                               dscene->tri_shader.need_realloc() ||
                                dscene->tri_vindex.need_realloc() ||
                                dscene->tri_vnormal.need_realloc() ||
                                dscene->tri_patch.need_realloc() ||
                                dscene->tri_patch_uv.need_realloc();
 
+    /* Only the data of modified meshes is copied to the device. */
+    PackedRange shader_range, normal_range, triangle_range, vert_range;
+
     foreach (Geometry *geom, scene->geometry) {
       if (geom->geometry_type == Geometry::MESH || geom->geometry_type == Geometry::VOLUME) {
         Mesh *mesh = static_cast<Mesh *>(geom);
@@ -1149,10 +1184,12 @@ void GeometryManager::device_update_mesh(Device *,
         if (mesh->shader_is_modified() || mesh->smooth_is_modified() ||
             mesh->triangles_is_modified() || copy_all_data) {
           mesh->pack_shaders(scene, &tri_shader[mesh->prim_offset]);
+          shader_range.add(mesh->prim_offset, mesh->num_triangles());
         }
 
         if (mesh->verts_is_modified() || copy_all_data) {
           mesh->pack_normals(&vnormal[mesh->vert_offset]);
+          normal_range.add(mesh->vert_offset, mesh->get_verts().size());
         }
 
         if (mesh->verts_is_modified() || mesh->triangles_is_modified() ||
@@ -1161,6 +1198,8 @@ void GeometryManager::device_update_mesh(Device *,
                            &tri_vindex[mesh->prim_offset],
                            &tri_patch[mesh->prim_offset],
                            &tri_patch_uv[mesh->vert_offset]);
+          triangle_range.add(mesh->prim_offset, mesh->num_triangles());
+          vert_range.add(mesh->vert_offset, mesh->get_verts().size());
         }
 
         if (progress.get_cancel())
@@ -1171,12 +1210,12 @@ void GeometryManager::device_update_mesh(Device *,
     /* vertex coordinates */
     progress.set_status("Updating Mesh", "Copying Mesh to device");
 
-    dscene->tri_verts.copy_to_device_if_modified();
-    dscene->tri_shader.copy_to_device_if_modified();
-    dscene->tri_vnormal.copy_to_device_if_modified();
-    dscene->tri_vindex.copy_to_device_if_modified();
-    dscene->tri_patch.copy_to_device_if_modified();
-    dscene->tri_patch_uv.copy_to_device_if_modified();
+    triangle_range.copy_to_device(dscene->tri_verts, copy_all_data, 3);
+    shader_range.copy_to_device(dscene->tri_shader, copy_all_data);
+    normal_range.copy_to_device(dscene->tri_vnormal, copy_all_data);
+    triangle_range.copy_to_device(dscene->tri_vindex, copy_all_data);
+    triangle_range.copy_to_device(dscene->tri_patch, copy_all_data);
+    vert_range.copy_to_device(dscene->tri_patch_uv, copy_all_data);
   }
 
   if (curve_segment_size != 0) {
@@ -1190,6 +1229,9 @@ void GeometryManager::device_update_mesh(Device *,
                                dscene->curves.need_realloc() ||
                                dscene->curve_segments.need_realloc();
 
+    /* Only the data of modified curves is copied to the device. */
+    PackedRange curve_key_range, curve_range, curve_segment_range;
+
     foreach (Geometry *geom, scene->geometry) {
       if (geom->is_hair()) {
         Hair *hair = static_cast<Hair *>(geom);
@@ -1207,14 +1249,17 @@ void GeometryManager::device_update_mesh(Device *,
                           &curve_keys[hair->curve_key_offset],
                           &curves[hair->prim_offset],
                           &curve_segments[hair->curve_segment_offset]);
+        curve_key_range.add(hair->curve_key_offset, hair->get_curve_keys().size());
+        curve_range.add(hair->prim_offset, hair->num_curves());
+        curve_segment_range.add(hair->curve_segment_offset, hair->num_segments());
         if (progress.get_cancel())
           return;
       }
     }
 
-    dscene->curve_keys.copy_to_device_if_modified();
-    dscene->curves.copy_to_device_if_modified();
-    dscene->curve_segments.copy_to_device_if_modified();
+    curve_key_range.copy_to_device(dscene->curve_keys, copy_all_data);
+    curve_range.copy_to_device(dscene->curves, copy_all_data);
+    curve_segment_range.copy_to_device(dscene->curve_segments, copy_all_data);
   }
 
   if (point_size != 0) {
@@ -1276,6 +1321,7 @@ void GeometryManager::device_update_bvh(Device *device,
   bparams.use_spatial_split = scene->params.use_bvh_spatial_split;
   bparams.use_unaligned_nodes = dscene->data.bvh.have_curves &&
                                 scene->params.use_bvh_unaligned_nodes;
+  bparams.max_curve_strand_leaf_size = scene->params.bvh_curve_strand_leaf_size;
   bparams.num_motion_triangle_steps = scene->params.num_bvh_time_steps;
   bparams.num_motion_curve_steps = scene->params.num_bvh_time_steps;
   bparams.num_motion_point_steps = scene->params.num_bvh_time_steps;
@@ -1861,6 +1907,10 @@ void GeometryManager::device_update(Device *device,
                                    dicing_camera->get_full_height());
     dicing_camera->update(scene);
 
+    /* Meshes are tessellated independently of each other, so that scenes with many subdivided
+     * meshes use all threads. */
+    TaskPool pool;
+
     size_t i = 0;
     foreach (Geometry *geom, scene->geometry) {
       if (!(geom->is_modified() && geom->is_mesh())) {
@@ -1876,20 +1926,25 @@ void GeometryManager::device_update(Device *device,
           msg += string_printf(
               "%s %u/%u", mesh->name.c_str(), (uint)(i + 1), (uint)total_tess_needed);
 
-        progress.set_status("Updating Mesh", msg);
-
         mesh->subd_params->camera = dicing_camera;
-        DiagSplit dsplit(*mesh->subd_params);
-        mesh->tessellate(&dsplit);
 
-        i++;
+        pool.push([mesh, msg, &progress]() {
+          if (progress.get_cancel()) {
+            return;
+          }
 
-        if (progress.get_cancel()) {
-          return;
-        }
+          progress.set_status("Updating Mesh", msg);
+
+          DiagSplit dsplit(*mesh->subd_params);
+          mesh->tessellate(&dsplit);
+        });
+
+        i++;
       }
     }
 
+    pool.wait_work();
+
     if (progress.get_cancel()) {
       return;
     }
@@ -206,7 +206,8 @@ ImageMetaData::ImageMetaData()
       colorspace(u_colorspace_raw),
       colorspace_file_format(""),
       use_transform_3d(false),
-      compress_as_srgb(false)
+      compress_as_srgb(false),
+      miplevel(0)
 {
 }
 
@@ -261,6 +262,11 @@ ImageLoader::ImageLoader()
 {
 }
 
+bool ImageLoader::load_metadata_miplevel(const int /*max_size*/, ImageMetaData & /*metadata*/)
+{
+  return false;
+}
+
 ustring ImageLoader::osl_filepath() const
 {
   return ustring();
@@ -486,20 +492,31 @@ bool ImageManager::file_load_image(Image *img, int texture_limit)
   }
 
   /* Get metadata. */
-  int width = img->metadata.width;
-  int height = img->metadata.height;
-  int depth = img->metadata.depth;
-  int components = img->metadata.channels;
-
-  /* Read pixels. */
-  vector<StorageType> pixels_storage;
-  StorageType *pixels;
-  const size_t max_size = max(max(width, height), depth);
+  ImageMetaData metadata = img->metadata;
+  size_t max_size = max(max(metadata.width, metadata.height), metadata.depth);
   if (max_size == 0) {
     /* Don't bother with empty images. */
     return false;
   }
 
+  /* Read a lower resolution level stored in the file if there is one that fits the limit, to
+   * avoid reading and resizing the full resolution image. */
+  if (texture_limit > 0 && max_size > texture_limit &&
+      img->loader->load_metadata_miplevel(texture_limit, metadata)) {
+    VLOG(1) << "Loading level " << metadata.miplevel << " of image " << img->loader->name()
+            << ".";
+    max_size = max(max(metadata.width, metadata.height), metadata.depth);
+  }
+
+  int width = metadata.width;
+  int height = metadata.height;
+  int depth = metadata.depth;
+  int components = metadata.channels;
+
+  /* Read pixels. */
+  vector<StorageType> pixels_storage;
+  StorageType *pixels;
+
   /* Allocate memory as needed, may be smaller to resize down. */
   if (texture_limit > 0 && max_size > texture_limit) {
     pixels_storage.resize(((size_t)width) * height * depth * 4);
@@ -516,8 +533,7 @@ bool ImageManager::file_load_image(Image *img, int texture_limit)
   }
 
   const size_t num_pixels = ((size_t)width) * height * depth;
-  img->loader->load_pixels(
-      img->metadata, pixels, num_pixels * components, image_associate_alpha(img));
+  img->loader->load_pixels(metadata, pixels, num_pixels * components, image_associate_alpha(img));
 
   /* The kernel can handle 1 and 4 channel images. Anything that is not a single
    * channel image is converted to RGBA format. */
@@ -78,6 +78,9 @@ class ImageMetaData {
   /* Automatically set. */
   bool compress_as_srgb;
 
+  /* Lower resolution level of the image to load, set by ImageLoader.load_metadata_miplevel(). */
+  int miplevel;
+
   ImageMetaData();
   bool operator==(const ImageMetaData &other) const;
   bool is_float() const;
@@ -106,6 +109,11 @@ class ImageLoader {
                            const size_t pixels_size,
                            const bool associate_alpha) = 0;
 
+  /* Optional, for images that store lower resolution levels (e.g. MIP-mapped .tx files). Find
+   * the largest level that is no bigger than max_size, and set the metadata resolution and level
+   * so that load_pixels() reads that level instead of resizing the full resolution image. */
+  virtual bool load_metadata_miplevel(const int max_size, ImageMetaData &metadata);
+
   /* Name for logs and stats. */
   virtual string name() const = 0;
 
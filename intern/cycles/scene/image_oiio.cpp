@@ -180,6 +180,10 @@ bool OIIOImageLoader::load_pixels(const ImageMetaData &metadata,
     return false;
   }
 
+  if (metadata.miplevel > 0 && !in->seek_subimage(0, metadata.miplevel, spec)) {
+    return false;
+  }
+
   switch (metadata.type) {
     case IMAGE_DATA_TYPE_BYTE:
     case IMAGE_DATA_TYPE_BYTE4:
@@ -207,6 +211,40 @@ bool OIIOImageLoader::load_pixels(const ImageMetaData &metadata,
   return true;
 }
 
+bool OIIOImageLoader::load_metadata_miplevel(const int max_size, ImageMetaData &metadata)
+{
+  if (!path_exists(filepath.string()) || path_is_directory(filepath.string())) {
+    return false;
+  }
+
+  unique_ptr<ImageInput> in(ImageInput::create(filepath.string()));
+  if (!in) {
+    return false;
+  }
+
+  ImageSpec spec;
+  if (!in->open(filepath.string(), spec)) {
+    return false;
+  }
+
+  /* Levels are stored from large to small, the first one that fits is used. Only the resolution
+   * changes between levels, the pixel format is the same as the full resolution image. */
+  bool found = false;
+  for (int miplevel = 1; in->seek_subimage(0, miplevel, spec); miplevel++) {
+    if (max(max(spec.width, spec.height), spec.depth) <= max_size) {
+      metadata.width = spec.width;
+      metadata.height = spec.height;
+      metadata.depth = spec.depth;
+      metadata.miplevel = miplevel;
+      found = true;
+      break;
+    }
+  }
+
+  in->close();
+  return found;
+}
+
 string OIIOImageLoader::name() const
 {
   return path_filename(filepath.string());
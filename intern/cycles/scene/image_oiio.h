@@ -20,6 +20,8 @@ class OIIOImageLoader : public ImageLoader {
                    const size_t pixels_size,
                    const bool associate_alpha) override;
 
+  bool load_metadata_miplevel(const int max_size, ImageMetaData &metadata) override;
+
   string name() const override;
 
   ustring osl_filepath() const override;
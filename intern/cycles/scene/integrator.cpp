@@ -83,8 +83,10 @@ NODE_DEFINE(Integrator)
   SOCKET_BOOLEAN(use_adaptive_sampling, "Use Adaptive Sampling", false);
   SOCKET_FLOAT(adaptive_threshold, "Adaptive Threshold", 0.0f);
   SOCKET_INT(adaptive_min_samples, "Adaptive Min Samples", 0);
+  SOCKET_FLOAT(adaptive_max_noisy_fraction, "Adaptive Max Noisy Fraction", 0.0f);
 
   SOCKET_FLOAT(light_sampling_threshold, "Light Sampling Threshold", 0.05f);
+  SOCKET_BOOLEAN(use_light_power_sampling, "Use Light Power Sampling", false);
 
   static NodeEnum sampling_pattern_enum;
   sampling_pattern_enum.insert("sobol", SAMPLING_PATTERN_SOBOL);
@@ -309,6 +311,10 @@ void Integrator::tag_update(Scene *scene, uint32_t flag)
     }
   }
 
+  if (use_light_power_sampling_is_modified()) {
+    scene->light_manager->tag_update(scene, LightManager::LIGHT_MODIFIED);
+  }
+
   if (motion_blur_is_modified()) {
     scene->object_manager->tag_update(scene, ObjectManager::MOTION_BLUR_MODIFIED);
     scene->camera->tag_modified();
@@ -363,6 +369,8 @@ AdaptiveSampling Integrator::get_adaptive_sampling() const
 
   adaptive_sampling.adaptive_step = 16;
 
+  adaptive_sampling.max_noisy_fraction = clamp(adaptive_max_noisy_fraction, 0.0f, 1.0f);
+
   DCHECK(is_power_of_two(adaptive_sampling.adaptive_step))
       << "Adaptive step must be a power of two for bitwise operations to work";
 
@@ -68,10 +68,13 @@ class Integrator : public Node {
   NODE_SOCKET_API(int, start_sample)
 
   NODE_SOCKET_API(float, light_sampling_threshold)
+  /* Pick point, spot and area lights proportionally to their strength instead of uniformly. */
+  NODE_SOCKET_API(bool, use_light_power_sampling)
 
   NODE_SOCKET_API(bool, use_adaptive_sampling)
   NODE_SOCKET_API(int, adaptive_min_samples)
   NODE_SOCKET_API(float, adaptive_threshold)
+  NODE_SOCKET_API(float, adaptive_max_noisy_fraction)
 
   NODE_SOCKET_API(SamplingPattern, sampling_pattern)
   NODE_SOCKET_API(float, scrambling_distance)
@@ -261,6 +261,43 @@ bool LightManager::object_usable_as_light(Object *object)
   return false;
 }
 
+/* Probability of picking each enabled light relative to uniform selection, in the order of
+ * Scene::lights. With power sampling, point, spot and area lights are weighted by their strength.
+ * The weights of those lights are normalized to sum up to their number, so that distant and
+ * background lights keep the probability of uniform selection, which the background importance
+ * sampling depends on. */
+static vector<float> light_selection_weights(const Scene *scene)
+{
+  vector<float> weights;
+  float weighted_total = 0.0f;
+  int weighted_num = 0;
+
+  const bool use_power = scene->integrator->get_use_light_power_sampling();
+  foreach (const Light *light, scene->lights) {
+    if (!light->is_enabled) {
+      continue;
+    }
+    if (use_power && (light->light_type == LIGHT_POINT || light->light_type == LIGHT_SPOT ||
+                      light->light_type == LIGHT_AREA)) {
+      /* The emitted power of these lights is proportional to the strength, the size is already
+       * accounted for in the strength. */
+      const float weight = average(fabs(light->strength));
+      weights.push_back(weight);
+      weighted_total += weight;
+      weighted_num++;
+    }
+    else {
+      weights.push_back(-1.0f);
+    }
+  }
+
+  const float weight_scale = (weighted_total > 0.0f) ? weighted_num / weighted_total : 0.0f;
+  for (float &weight : weights) {
+    weight = (weight < 0.0f || weight_scale == 0.0f) ? 1.0f : weight * weight_scale;
+  }
+  return weights;
+}
+
 void LightManager::device_update_distribution(Device *,
                                               DeviceScene *dscene,
                                               Scene *scene,
@@ -395,6 +432,7 @@ void LightManager::device_update_distribution(Device *,
 
   if (num_lights > 0) {
     float lightarea = (totarea > 0.0f) ? totarea / num_lights : 1.0f;
+    const vector<float> weights = light_selection_weights(scene);
     foreach (Light *light, scene->lights) {
       if (!light->is_enabled)
         continue;
@@ -403,7 +441,7 @@ void LightManager::device_update_distribution(Device *,
       distribution[offset].prim = ~light_index;
       distribution[offset].lamp.pad = 1.0f;
       distribution[offset].lamp.size = light->size;
-      totarea += lightarea;
+      totarea += lightarea * weights[light_index];
 
       if (light->light_type == LIGHT_DISTANT) {
         use_lamp_mis |= (light->angle > 0.0f && light->use_mis);
@@ -730,6 +768,7 @@ void LightManager::device_update_points(Device *, DeviceScene *dscene, Scene *sc
   }
 
   int light_index = 0;
+  const vector<float> weights = light_selection_weights(scene);
 
   foreach (Light *light, scene->lights) {
     if (!light->is_enabled) {
@@ -900,6 +939,7 @@ void LightManager::device_update_points(Device *, DeviceScene *dscene, Scene *sc
     klights[light_index].max_bounces = max_bounces;
     klights[light_index].random = random;
     klights[light_index].use_caustics = light->use_caustics;
+    klights[light_index].pdf_scale = weights[light_index];
 
     klights[light_index].tfm = light->tfm;
     klights[light_index].itfm = transform_inverse(light->tfm);
@@ -951,6 +991,7 @@ void LightManager::device_update_points(Device *, DeviceScene *dscene, Scene *sc
     klights[light_index].area.dir[2] = dir.z;
     klights[light_index].tfm = light->tfm;
     klights[light_index].itfm = transform_inverse(light->tfm);
+    klights[light_index].pdf_scale = 1.0f;
 
     light_index++;
   }
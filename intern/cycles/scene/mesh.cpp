@@ -710,7 +710,7 @@ void Mesh::pack_shaders(Scene *scene, uint *tri_shader)
   }
 }
 
-void Mesh::pack_normals(packed_float3 *vnormal)
+void Mesh::pack_normals(uint *vnormal)
 {
   Attribute *attr_vN = attributes.find(ATTR_STD_VERTEX_NORMAL);
   if (attr_vN == NULL) {
@@ -730,7 +730,7 @@ void Mesh::pack_normals(packed_float3 *vnormal)
     if (do_transform)
       vNi = safe_normalize(transform_direction(&ntfm, vNi));
 
-    vnormal[i] = make_float3(vNi.x, vNi.y, vNi.z);
+    vnormal[i] = encode_unit_vector_octahedral(vNi);
   }
 }
 
@@ -32,6 +32,30 @@ static float3 compute_face_normal(const Mesh::Triangle &t, float3 *verts)
   return norm / normlen;
 }
 
+/* Get the triangles of the mesh ordered by their shader, so that the displacement shader is
+ * evaluated for all points of one shader after another. Threads then run the same SVM program
+ * for consecutive points, which keeps its nodes and textures in the CPU caches. */
+static vector<int> triangles_sorted_by_shader(const Mesh *mesh)
+{
+  const array<int> &mesh_shaders = mesh->get_shader();
+  const int num_shaders = mesh->get_used_shaders().size() + 1;
+  const int num_triangles = mesh->num_triangles();
+
+  /* Counting sort, shader indices that are out of range use the default surface. */
+  vector<int> shader_offsets(num_shaders + 1, 0);
+  for (int i = 0; i < num_triangles; i++) {
+    shader_offsets[min(mesh_shaders[i], num_shaders - 1) + 1]++;
+  }
+  for (int i = 0; i < num_shaders; i++) {
+    shader_offsets[i + 1] += shader_offsets[i];
+  }
+  vector<int> triangles(num_triangles);
+  for (int i = 0; i < num_triangles; i++) {
+    triangles[shader_offsets[min(mesh_shaders[i], num_shaders - 1)]++] = i;
+  }
+  return triangles;
+}
+
 /* Fill in coordinates for mesh displacement shader evaluation on device. */
 static int fill_shader_input(const Scene *scene,
                              const Mesh *mesh,
@@ -48,8 +72,7 @@ static int fill_shader_input(const Scene *scene,
   const int num_verts = mesh_verts.size();
   vector<bool> done(num_verts, false);
 
-  int num_triangles = mesh->num_triangles();
-  for (int i = 0; i < num_triangles; i++) {
+  for (const int i : triangles_sorted_by_shader(mesh)) {
     Mesh::Triangle t = mesh->get_triangle(i);
     int shader_index = mesh_shaders[i];
     Shader *shader = (shader_index < mesh_used_shaders.size()) ?
@@ -116,8 +139,7 @@ static void read_shader_output(const Scene *scene,
   int d_output_index = 0;
 
   Attribute *attr_mP = mesh->attributes.find(ATTR_STD_MOTION_VERTEX_POSITION);
-  int num_triangles = mesh->num_triangles();
-  for (int i = 0; i < num_triangles; i++) {
+  for (const int i : triangles_sorted_by_shader(mesh)) {
     Mesh::Triangle t = mesh->get_triangle(i);
     int shader_index = mesh_shaders[i];
     Shader *shader = (shader_index < mesh_used_shaders.size()) ?
@@ -71,7 +71,7 @@ class DeviceScene {
   /* mesh */
   device_vector<packed_float3> tri_verts;
   device_vector<uint> tri_shader;
-  device_vector<packed_float3> tri_vnormal;
+  device_vector<uint> tri_vnormal;
   device_vector<uint4> tri_vindex;
   device_vector<uint> tri_patch;
   device_vector<float2> tri_patch_uv;
@@ -149,6 +149,8 @@ class SceneParams {
   bool use_bvh_spatial_split;
   bool use_bvh_compact_structure;
   bool use_bvh_unaligned_nodes;
+  /* Maximum number of segments of the same strand in a BVH2 leaf, see BVHParams. */
+  int bvh_curve_strand_leaf_size;
   int num_bvh_time_steps;
   int hair_subdivisions;
   CurveShapeType hair_shape;
@@ -164,6 +166,7 @@ class SceneParams {
     use_bvh_spatial_split = false;
     use_bvh_compact_structure = true;
     use_bvh_unaligned_nodes = true;
+    bvh_curve_strand_leaf_size = 1;
     num_bvh_time_steps = 0;
     hair_subdivisions = 3;
     hair_shape = CURVE_RIBBON;
@@ -178,6 +181,7 @@ class SceneParams {
              use_bvh_spatial_split == params.use_bvh_spatial_split &&
              use_bvh_compact_structure == params.use_bvh_compact_structure &&
              use_bvh_unaligned_nodes == params.use_bvh_unaligned_nodes &&
+             bvh_curve_strand_leaf_size == params.bvh_curve_strand_leaf_size &&
              num_bvh_time_steps == params.num_bvh_time_steps &&
              hair_subdivisions == params.hair_subdivisions && hair_shape == params.hair_shape &&
              texture_limit == params.texture_limit);
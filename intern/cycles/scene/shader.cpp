@@ -206,6 +206,7 @@ Shader::Shader() : Node(get_node_type())
   displacement_method = DISPLACE_BUMP;
 
   id = -1;
+  svm_nodes_background = false;
 
   need_update_uvs = true;
   need_update_attribute = true;
@@ -120,6 +120,10 @@ class Shader : public Node {
   /* determined before compiling */
   uint id;
 
+  /* SVM nodes from the last compilation, reused while the shader is not modified. */
+  array<int4> svm_nodes;
+  bool svm_nodes_background;
+
 #ifdef WITH_OSL
   /* osl shading state references */
   OSL::ShaderGroupRef osl_surface_ref;
@@ -44,11 +44,13 @@ void SVMShaderManager::device_update_shader(Scene *scene,
   }
   assert(shader->graph);
 
+  svm_nodes->clear();
   svm_nodes->push_back_slow(make_int4(NODE_SHADER_JUMP, 0, 0, 0));
 
   SVMCompiler::Summary summary;
   SVMCompiler compiler(scene);
   compiler.background = (shader == scene->background->get_shader(scene));
+  shader->svm_nodes_background = compiler.background;
   compiler.compile(shader, *svm_nodes, 0, &summary);
 
   VLOG(3) << "Compilation summary:\n"
@@ -79,19 +81,34 @@ void SVMShaderManager::device_update_specific(Device *device,
   /* test if we need to update */
   device_free(device, dscene, scene);
 
-  /* Build all shaders. */
+  /* Build all shaders that changed since they were last compiled. The nodes of each shader are
+   * local to the shader, so the nodes of other shaders are reused as they are. */
+  Shader *background_shader = scene->background->get_shader(scene);
+  const bool integrator_modified = (update_flags & INTEGRATOR_MODIFIED);
+  int num_compiled_shaders = 0;
+
   TaskPool task_pool;
-  vector<array<int4>> shader_svm_nodes(num_shaders);
   for (int i = 0; i < num_shaders; i++) {
+    Shader *shader = scene->shaders[i];
+
+    if (!shader->is_modified() && shader->svm_nodes.size() > 0 &&
+        shader->svm_nodes_background == (shader == background_shader) &&
+        !(integrator_modified && shader->has_integrator_dependency)) {
+      continue;
+    }
+
     task_pool.push(function_bind(&SVMShaderManager::device_update_shader,
                                  this,
                                  scene,
-                                 scene->shaders[i],
+                                 shader,
                                  &progress,
-                                 &shader_svm_nodes[i]));
+                                 &shader->svm_nodes));
+    num_compiled_shaders++;
   }
   task_pool.wait_work();
 
+  VLOG(1) << "Compiled " << num_compiled_shaders << " of " << num_shaders << " shaders.";
+
   if (progress.get_cancel()) {
     return;
   }
@@ -101,7 +118,7 @@ void SVMShaderManager::device_update_specific(Device *device,
   int svm_nodes_size = num_shaders;
   for (int i = 0; i < num_shaders; i++) {
     /* Since we're not copying the local jump node, the size ends up being one node lower. */
-    svm_nodes_size += shader_svm_nodes[i].size() - 1;
+    svm_nodes_size += scene->shaders[i]->svm_nodes.size() - 1;
   }
 
   int4 *svm_nodes = dscene->svm_nodes.alloc(svm_nodes_size);
@@ -119,22 +136,23 @@ void SVMShaderManager::device_update_specific(Device *device,
      * Each compiled shader starts with a jump node that has offsets local
      * to the shader, so copy those and add the offset into the global node list. */
     int4 &global_jump_node = svm_nodes[shader->id];
-    int4 &local_jump_node = shader_svm_nodes[i][0];
+    int4 &local_jump_node = shader->svm_nodes[0];
 
     global_jump_node.x = NODE_SHADER_JUMP;
     global_jump_node.y = local_jump_node.y - 1 + node_offset;
     global_jump_node.z = local_jump_node.z - 1 + node_offset;
     global_jump_node.w = local_jump_node.w - 1 + node_offset;
 
-    node_offset += shader_svm_nodes[i].size() - 1;
+    node_offset += shader->svm_nodes.size() - 1;
   }
 
   /* Copy the nodes of each shader into the correct location. */
   svm_nodes += num_shaders;
   for (int i = 0; i < num_shaders; i++) {
-    int shader_size = shader_svm_nodes[i].size() - 1;
+    const array<int4> &shader_svm_nodes = scene->shaders[i]->svm_nodes;
+    int shader_size = shader_svm_nodes.size() - 1;
 
-    memcpy(svm_nodes, &shader_svm_nodes[i][1], sizeof(int4) * shader_size);
+    memcpy(svm_nodes, &shader_svm_nodes[1], sizeof(int4) * shader_size);
     svm_nodes += shader_size;
   }
 
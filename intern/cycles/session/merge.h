@@ -9,7 +9,14 @@
 
 CCL_NAMESPACE_BEGIN
 
-/* Merge OpenEXR multilayer renders. */
+/* Merge OpenEXR multilayer renders.
+ *
+ * Render layers with the same name are combined, weighting each image by the number of samples
+ * stored in its `cycles.<layer>.samples` metadata. This is how a single frame is rendered on
+ * multiple machines: every machine renders a disjoint range of samples using the sample offset
+ * (`--sample-offset` in the standalone app, the Sample Offset setting in Blender), and the
+ * resulting files are merged here afterwards. There is no networked rendering where hosts stream
+ * render buffers to a coordinator, the images are exchanged as files. */
 
 class ImageMerger {
  public:
@@ -0,0 +1,52 @@
+/* SPDX-License-Identifier: Apache-2.0
+ * Copyright 2011-2022 Blender Foundation */
+
+#include "testing/testing.h"
+
+#include "integrator/work_balancer.h"
+#include "util/vector.h"
+
+CCL_NAMESPACE_BEGIN
+
+TEST(WorkBalancer, rebalance_balanced)
+{
+  vector<WorkBalanceInfo> infos(2);
+  work_balance_do_initial(infos);
+  infos[0].time_spent = 1.0;
+  infos[1].time_spent = 1.0;
+
+  EXPECT_FALSE(work_balance_do_rebalance(infos));
+  EXPECT_NEAR(infos[0].weight, 0.5, 1e-6);
+  EXPECT_NEAR(infos[1].weight, 0.5, 1e-6);
+}
+
+TEST(WorkBalancer, rebalance_small_difference)
+{
+  vector<WorkBalanceInfo> infos(2);
+  work_balance_do_initial(infos);
+  infos[0].time_spent = 1.0;
+  infos[1].time_spent = 1.2;
+
+  EXPECT_TRUE(work_balance_do_rebalance(infos));
+  EXPECT_GT(infos[0].weight, 0.5);
+  EXPECT_LT(infos[1].weight, 0.5);
+  EXPECT_NEAR(infos[0].weight + infos[1].weight, 1.0, 1e-6);
+}
+
+TEST(WorkBalancer, rebalance_big_difference)
+{
+  vector<WorkBalanceInfo> infos(2);
+  work_balance_do_initial(infos);
+  /* The second device is three times slower than the first one. */
+  infos[0].time_spent = 1.0;
+  infos[1].time_spent = 3.0;
+
+  EXPECT_TRUE(work_balance_do_rebalance(infos));
+  /* Times are equalized directly, so the work is split by throughput. */
+  EXPECT_NEAR(infos[0].weight, 0.75, 1e-6);
+  EXPECT_NEAR(infos[1].weight, 0.25, 1e-6);
+  EXPECT_EQ(infos[0].time_spent, 0.0);
+  EXPECT_EQ(infos[1].time_spent, 0.0);
+}
+
+CCL_NAMESPACE_END
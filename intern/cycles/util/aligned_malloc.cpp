@@ -30,6 +30,7 @@ CCL_NAMESPACE_BEGIN
 void *util_aligned_malloc(size_t size, int alignment)
 {
 #ifdef WITH_BLENDER_GUARDEDALLOC
+  MEM_TagScope tag_scope(MEM_TAG_CYCLES);
   return MEM_mallocN_aligned(size, alignment, "Cycles Aligned Alloc");
 #elif defined(_WIN32)
   return _aligned_malloc(size, alignment);
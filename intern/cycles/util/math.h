@@ -875,6 +875,42 @@ ccl_device_inline float2 map_to_sphere(const float3 co)
   return make_float2(u, v);
 }
 
+/* Octahedral encoding of unit vectors with 16 bits per component, see "A Survey of Efficient
+ * Representations for Independent Unit Vectors" by Cigolle et al. The angular error is far below
+ * what is visible when used for shading normals. */
+ccl_device_inline uint encode_unit_vector_octahedral(const float3 N)
+{
+  /* Degenerate vectors are encoded as the Z axis. */
+  const float l1 = fabsf(N.x) + fabsf(N.y) + fabsf(N.z);
+  const float inv_l1 = (l1 > 0.0f) ? 1.0f / l1 : 0.0f;
+
+  float u = N.x * inv_l1;
+  float v = N.y * inv_l1;
+  if (N.z < 0.0f) {
+    /* Fold the lower hemisphere over the diagonals. */
+    const float fold_u = (1.0f - fabsf(v)) * signf(u);
+    const float fold_v = (1.0f - fabsf(u)) * signf(v);
+    u = fold_u;
+    v = fold_v;
+  }
+
+  const uint iu = (uint)(clamp(u * 0.5f + 0.5f, 0.0f, 1.0f) * 65535.0f + 0.5f);
+  const uint iv = (uint)(clamp(v * 0.5f + 0.5f, 0.0f, 1.0f) * 65535.0f + 0.5f);
+  return (iu << 16) | iv;
+}
+
+ccl_device_inline float3 decode_unit_vector_octahedral(const uint encoded)
+{
+  const float u = (float)(encoded >> 16) * (2.0f / 65535.0f) - 1.0f;
+  const float v = (float)(encoded & 0xFFFF) * (2.0f / 65535.0f) - 1.0f;
+
+  float3 N = make_float3(u, v, 1.0f - fabsf(u) - fabsf(v));
+  const float t = max(-N.z, 0.0f);
+  N.x += (N.x >= 0.0f) ? -t : t;
+  N.y += (N.y >= 0.0f) ? -t : t;
+  return normalize(N);
+}
+
 /* Compares two floats.
  * Returns true if their absolute difference is smaller than abs_diff (for numbers near zero)
  * or their relative difference is less than ulp_diff ULPs.
@@ -220,6 +220,45 @@ void MEM_use_memleak_detection(bool enabled);
  */
 void MEM_enable_fail_on_memleak(void);
 
+/**
+ * Subsystems that memory usage is attributed to, see #MEM_tag_set.
+ * Keep in sync with #MEM_tag_name.
+ */
+typedef enum eMEMTag {
+  MEM_TAG_NONE = 0,
+  MEM_TAG_MESH,
+  MEM_TAG_IMAGE,
+  MEM_TAG_UNDO,
+  MEM_TAG_GPU,
+  MEM_TAG_CYCLES,
+  MEM_TAG_SEQUENCER,
+} eMEMTag;
+#define MEM_TAG_NUM (MEM_TAG_SEQUENCER + 1)
+
+/**
+ * Set the tag for blocks allocated by the calling thread from now on, returning the previous
+ * tag so it can be restored. The tag is stored in the block, memory in use is counted per tag
+ * until the block is freed, no matter which thread frees it.
+ */
+eMEMTag MEM_tag_set(eMEMTag tag);
+/** Tag for blocks allocated by the calling thread. */
+eMEMTag MEM_tag_get(void);
+
+/**
+ * Memory in use by blocks with the tag. For #MEM_TAG_NONE this is all memory that is not
+ * attributed to any other tag.
+ */
+size_t MEM_get_memory_in_use_by_tag(eMEMTag tag);
+
+/**
+ * Total number of bytes allocated by the calling thread since it started. Frees are not
+ * subtracted, so the difference between two calls is what the thread allocated in between.
+ */
+size_t MEM_get_thread_allocated(void);
+
+/** Human readable name of the tag. */
+const char *MEM_tag_name(eMEMTag tag);
+
 /* Switch allocator to fast mode, with less tracking.
  *
  * Use in the production code where performance is the priority, and exact details about allocation
@@ -238,6 +277,16 @@ void MEM_use_lockfree_allocator(void);
  * NOTE: The switch between allocator types can only happen before any allocation did happen. */
 void MEM_use_guarded_allocator(void);
 
+/* Switch allocator to fast mode with per-thread caches of freed blocks.
+ *
+ * Use for allocation heavy multi-threaded work. Tracks the same information as the lock-free
+ * allocator, but small blocks are recycled through per-thread free lists instead of going to the
+ * system allocator every time, which avoids contention between threads. Freed blocks stay cached
+ * and are not returned to the system right away.
+ *
+ * NOTE: The switch between allocator types can only happen before any allocation did happen. */
+void MEM_use_threadcache_allocator(void);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -248,6 +297,24 @@ void MEM_use_guarded_allocator(void);
 #  include <type_traits>
 #  include <utility>
 
+/**
+ * Attribute all allocations of the current thread to the tag while in scope.
+ */
+class MEM_TagScope {
+  eMEMTag previous_tag_;
+
+ public:
+  explicit MEM_TagScope(const eMEMTag tag) : previous_tag_(MEM_tag_set(tag))
+  {
+  }
+  ~MEM_TagScope()
+  {
+    MEM_tag_set(previous_tag_);
+  }
+  MEM_TagScope(const MEM_TagScope &other) = delete;
+  MEM_TagScope &operator=(const MEM_TagScope &other) = delete;
+};
+
 /**
  * Allocate new memory for and constructs an object of type #T.
  * #MEM_delete should be used to delete the object. Just calling #MEM_freeN is not enough when #T
@@ -13,6 +13,7 @@
 
 #include <assert.h>
 
+#include "atomic_ops.h"
 #include "mallocn_intern.h"
 
 #ifdef WITH_JEMALLOC_CONF
@@ -51,6 +52,62 @@ size_t (*MEM_get_peak_memory)(void) = MEM_lockfree_get_peak_memory;
 const char *(*MEM_name_ptr)(void *vmemh) = MEM_lockfree_name_ptr;
 #endif
 
+MEM_THREAD_LOCAL eMEMTag mem_tag_current = MEM_TAG_NONE;
+MEM_THREAD_LOCAL size_t mem_thread_allocated = 0;
+size_t mem_tag_in_use[MEM_TAG_NUM] = {0};
+
+eMEMTag MEM_tag_set(eMEMTag tag)
+{
+  const eMEMTag previous_tag = mem_tag_current;
+  mem_tag_current = tag;
+  return previous_tag;
+}
+
+eMEMTag MEM_tag_get(void)
+{
+  return mem_tag_current;
+}
+
+size_t MEM_get_memory_in_use_by_tag(eMEMTag tag)
+{
+  if (tag != MEM_TAG_NONE) {
+    return mem_tag_in_use[tag];
+  }
+  size_t tagged = 0;
+  for (int i = MEM_TAG_NONE + 1; i < MEM_TAG_NUM; i++) {
+    tagged += mem_tag_in_use[i];
+  }
+  const size_t total = MEM_get_memory_in_use();
+  /* Counters are read one by one while other threads may be allocating. */
+  return total > tagged ? total - tagged : 0;
+}
+
+size_t MEM_get_thread_allocated(void)
+{
+  return mem_thread_allocated;
+}
+
+const char *MEM_tag_name(eMEMTag tag)
+{
+  switch (tag) {
+    case MEM_TAG_NONE:
+      return "Other";
+    case MEM_TAG_MESH:
+      return "Mesh";
+    case MEM_TAG_IMAGE:
+      return "Image";
+    case MEM_TAG_UNDO:
+      return "Undo";
+    case MEM_TAG_GPU:
+      return "GPU Staging";
+    case MEM_TAG_CYCLES:
+      return "Cycles";
+    case MEM_TAG_SEQUENCER:
+      return "Sequencer Cache";
+  }
+  return "Unknown";
+}
+
 void *aligned_malloc(size_t size, size_t alignment)
 {
   /* #posix_memalign requires alignment to be a multiple of `sizeof(void *)`. */
@@ -161,3 +218,34 @@ void MEM_use_guarded_allocator(void)
   MEM_name_ptr = MEM_guarded_name_ptr;
 #endif
 }
+
+void MEM_use_threadcache_allocator(void)
+{
+  assert_for_allocator_change();
+
+  MEM_allocN_len = MEM_threadcache_allocN_len;
+  MEM_freeN = MEM_threadcache_freeN;
+  MEM_dupallocN = MEM_threadcache_dupallocN;
+  MEM_reallocN_id = MEM_threadcache_reallocN_id;
+  MEM_recallocN_id = MEM_threadcache_recallocN_id;
+  MEM_callocN = MEM_threadcache_callocN;
+  MEM_calloc_arrayN = MEM_threadcache_calloc_arrayN;
+  MEM_mallocN = MEM_threadcache_mallocN;
+  MEM_malloc_arrayN = MEM_threadcache_malloc_arrayN;
+  MEM_mallocN_aligned = MEM_threadcache_mallocN_aligned;
+  MEM_printmemlist_pydict = MEM_threadcache_printmemlist_pydict;
+  MEM_printmemlist = MEM_threadcache_printmemlist;
+  MEM_callbackmemlist = MEM_threadcache_callbackmemlist;
+  MEM_printmemlist_stats = MEM_threadcache_printmemlist_stats;
+  MEM_set_error_callback = MEM_threadcache_set_error_callback;
+  MEM_consistency_check = MEM_threadcache_consistency_check;
+  MEM_set_memory_debug = MEM_threadcache_set_memory_debug;
+  MEM_get_memory_in_use = MEM_threadcache_get_memory_in_use;
+  MEM_get_memory_blocks_in_use = MEM_threadcache_get_memory_blocks_in_use;
+  MEM_reset_peak_memory = MEM_threadcache_reset_peak_memory;
+  MEM_get_peak_memory = MEM_threadcache_get_peak_memory;
+
+#ifndef NDEBUG
+  MEM_name_ptr = MEM_threadcache_name_ptr;
+#endif
+}
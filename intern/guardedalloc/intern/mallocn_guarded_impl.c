@@ -81,7 +81,8 @@ typedef struct MemHead {
   const char *name;
   const char *nextname;
   int tag2;
-  short pad1;
+  /** #eMEMTag, see #MEM_tag_set. */
+  short mem_tag;
   /* if non-zero aligned allocation was used and alignment is stored here. */
   short alignment;
 #ifdef DEBUG_MEMCOUNTER
@@ -295,6 +296,8 @@ void *MEM_guarded_reallocN_id(void *vmemh, size_t len, const char *str)
     MemHead *memh = vmemh;
     memh--;
 
+    /* Keep the tag of the original allocation. */
+    const eMEMTag tag_prev = MEM_tag_set((eMEMTag)memh->mem_tag);
     if (LIKELY(memh->alignment == 0)) {
       newp = MEM_guarded_mallocN(len, memh->name);
     }
@@ -313,6 +316,8 @@ void *MEM_guarded_reallocN_id(void *vmemh, size_t len, const char *str)
       }
     }
 
+    MEM_tag_set(tag_prev);
+
     MEM_guarded_freeN(vmemh);
   }
   else {
@@ -330,6 +335,8 @@ void *MEM_guarded_recallocN_id(void *vmemh, size_t len, const char *str)
     MemHead *memh = vmemh;
     memh--;
 
+    /* Keep the tag of the original allocation. */
+    const eMEMTag tag_prev = MEM_tag_set((eMEMTag)memh->mem_tag);
     if (LIKELY(memh->alignment == 0)) {
       newp = MEM_guarded_mallocN(len, memh->name);
     }
@@ -353,6 +360,8 @@ void *MEM_guarded_recallocN_id(void *vmemh, size_t len, const char *str)
       }
     }
 
+    MEM_tag_set(tag_prev);
+
     MEM_guarded_freeN(vmemh);
   }
   else {
@@ -402,7 +411,7 @@ static void make_memhead_header(MemHead *memh, size_t len, const char *str)
   memh->name = str;
   memh->nextname = NULL;
   memh->len = len;
-  memh->pad1 = 0;
+  memh->mem_tag = (short)mem_tag_alloc(len);
   memh->alignment = 0;
   memh->tag2 = MEMTAG2;
 
@@ -990,6 +999,7 @@ static void rem_memblock(MemHead *memh)
 
   atomic_sub_and_fetch_u(&totblock, 1);
   atomic_sub_and_fetch_z(&mem_in_use, memh->len);
+  mem_tag_free((eMEMTag)memh->mem_tag, memh->len);
 
 #ifdef DEBUG_MEMDUPLINAME
   if (memh->need_free_name)
@@ -76,6 +76,13 @@ size_t malloc_usable_size(void *ptr);
 /* Real pointer returned by the malloc or aligned_alloc. */
 #define MEMHEAD_REAL_PTR(memh) ((char *)memh - MEMHEAD_ALIGN_PADDING(memh->alignment))
 
+#ifdef _MSC_VER
+#  define MEM_THREAD_LOCAL __declspec(thread)
+#else
+#  define MEM_THREAD_LOCAL __thread
+#endif
+
+#include "atomic_ops.h"
 #include "mallocn_inline.h"
 
 #ifdef __cplusplus
@@ -90,6 +97,36 @@ void aligned_free(void *ptr);
 extern bool leak_detector_has_run;
 extern char free_after_leak_detection_message[];
 
+/* Memory tags, see #MEM_tag_set. */
+
+/* The lock-free allocators store the tag in the top bits of #MemHead.len. */
+#define MEMHEAD_TAG_SHIFT (sizeof(size_t) * 8 - 8)
+#define MEMHEAD_LEN_TAG(len) ((eMEMTag)((len) >> MEMHEAD_TAG_SHIFT))
+#define MEMHEAD_LEN_UNTAGGED(len) ((len) & (((size_t)1 << MEMHEAD_TAG_SHIFT) - 1))
+#define MEMHEAD_TAG_BITS(tag) ((size_t)(tag) << MEMHEAD_TAG_SHIFT)
+
+extern MEM_THREAD_LOCAL eMEMTag mem_tag_current;
+extern MEM_THREAD_LOCAL size_t mem_thread_allocated;
+extern size_t mem_tag_in_use[MEM_TAG_NUM];
+
+/** Account for an allocation of `len` bytes, returns the tag to store in the block. */
+MEM_INLINE eMEMTag mem_tag_alloc(size_t len)
+{
+  const eMEMTag tag = mem_tag_current;
+  mem_thread_allocated += len;
+  if (tag != MEM_TAG_NONE) {
+    atomic_add_and_fetch_z(&mem_tag_in_use[tag], len);
+  }
+  return tag;
+}
+
+MEM_INLINE void mem_tag_free(eMEMTag tag, size_t len)
+{
+  if (tag != MEM_TAG_NONE) {
+    atomic_sub_and_fetch_z(&mem_tag_in_use[tag], len);
+  }
+}
+
 /* Prototypes for counted allocator functions */
 size_t MEM_lockfree_allocN_len(const void *vmemh) ATTR_WARN_UNUSED_RESULT;
 void MEM_lockfree_freeN(void *vmemh);
@@ -133,6 +170,49 @@ size_t MEM_lockfree_get_peak_memory(void) ATTR_WARN_UNUSED_RESULT;
 const char *MEM_lockfree_name_ptr(void *vmemh);
 #endif
 
+/* Prototypes for thread caching allocator functions */
+size_t MEM_threadcache_allocN_len(const void *vmemh) ATTR_WARN_UNUSED_RESULT;
+void MEM_threadcache_freeN(void *vmemh);
+void *MEM_threadcache_dupallocN(const void *vmemh) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT;
+void *MEM_threadcache_reallocN_id(void *vmemh,
+                                  size_t len,
+                                  const char *str) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT
+    ATTR_ALLOC_SIZE(2);
+void *MEM_threadcache_recallocN_id(void *vmemh,
+                                   size_t len,
+                                   const char *str) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT
+    ATTR_ALLOC_SIZE(2);
+void *MEM_threadcache_callocN(size_t len, const char *str) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT
+    ATTR_ALLOC_SIZE(1) ATTR_NONNULL(2);
+void *MEM_threadcache_calloc_arrayN(size_t len,
+                                    size_t size,
+                                    const char *str) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT
+    ATTR_ALLOC_SIZE(1, 2) ATTR_NONNULL(3);
+void *MEM_threadcache_mallocN(size_t len, const char *str) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT
+    ATTR_ALLOC_SIZE(1) ATTR_NONNULL(2);
+void *MEM_threadcache_malloc_arrayN(size_t len,
+                                    size_t size,
+                                    const char *str) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT
+    ATTR_ALLOC_SIZE(1, 2) ATTR_NONNULL(3);
+void *MEM_threadcache_mallocN_aligned(size_t len,
+                                      size_t alignment,
+                                      const char *str) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT
+    ATTR_ALLOC_SIZE(1) ATTR_NONNULL(3);
+void MEM_threadcache_printmemlist_pydict(void);
+void MEM_threadcache_printmemlist(void);
+void MEM_threadcache_callbackmemlist(void (*func)(void *));
+void MEM_threadcache_printmemlist_stats(void);
+void MEM_threadcache_set_error_callback(void (*func)(const char *));
+bool MEM_threadcache_consistency_check(void);
+void MEM_threadcache_set_memory_debug(void);
+size_t MEM_threadcache_get_memory_in_use(void);
+unsigned int MEM_threadcache_get_memory_blocks_in_use(void);
+void MEM_threadcache_reset_peak_memory(void);
+size_t MEM_threadcache_get_peak_memory(void) ATTR_WARN_UNUSED_RESULT;
+#ifndef NDEBUG
+const char *MEM_threadcache_name_ptr(void *vmemh);
+#endif
+
 /* Prototypes for fully guarded allocator functions */
 size_t MEM_guarded_allocN_len(const void *vmemh) ATTR_WARN_UNUSED_RESULT;
 void MEM_guarded_freeN(void *vmemh);
@@ -79,7 +79,7 @@ print_error(const char *str, ...)
 size_t MEM_lockfree_allocN_len(const void *vmemh)
 {
   if (vmemh) {
-    return MEMHEAD_FROM_PTR(vmemh)->len & ~((size_t)(MEMHEAD_ALIGN_FLAG));
+    return MEMHEAD_LEN_UNTAGGED(MEMHEAD_FROM_PTR(vmemh)->len) & ~((size_t)(MEMHEAD_ALIGN_FLAG));
   }
 
   return 0;
@@ -104,6 +104,7 @@ void MEM_lockfree_freeN(void *vmemh)
 
   atomic_sub_and_fetch_u(&totblock, 1);
   atomic_sub_and_fetch_z(&mem_in_use, len);
+  mem_tag_free(MEMHEAD_LEN_TAG(memh->len), len);
 
   if (UNLIKELY(malloc_debug_memset && len)) {
     memset(memh + 1, 255, len);
@@ -144,6 +145,8 @@ void *MEM_lockfree_reallocN_id(void *vmemh, size_t len, const char *str)
     MemHead *memh = MEMHEAD_FROM_PTR(vmemh);
     size_t old_len = MEM_lockfree_allocN_len(vmemh);
 
+    /* Keep the tag of the original allocation. */
+    const eMEMTag tag_prev = MEM_tag_set(MEMHEAD_LEN_TAG(memh->len));
     if (LIKELY(!MEMHEAD_IS_ALIGNED(memh))) {
       newp = MEM_lockfree_mallocN(len, "realloc");
     }
@@ -163,6 +166,8 @@ void *MEM_lockfree_reallocN_id(void *vmemh, size_t len, const char *str)
       }
     }
 
+    MEM_tag_set(tag_prev);
+
     MEM_lockfree_freeN(vmemh);
   }
   else {
@@ -180,6 +185,8 @@ void *MEM_lockfree_recallocN_id(void *vmemh, size_t len, const char *str)
     MemHead *memh = MEMHEAD_FROM_PTR(vmemh);
     size_t old_len = MEM_lockfree_allocN_len(vmemh);
 
+    /* Keep the tag of the original allocation. */
+    const eMEMTag tag_prev = MEM_tag_set(MEMHEAD_LEN_TAG(memh->len));
     if (LIKELY(!MEMHEAD_IS_ALIGNED(memh))) {
       newp = MEM_lockfree_mallocN(len, "recalloc");
     }
@@ -204,6 +211,8 @@ void *MEM_lockfree_recallocN_id(void *vmemh, size_t len, const char *str)
       }
     }
 
+    MEM_tag_set(tag_prev);
+
     MEM_lockfree_freeN(vmemh);
   }
   else {
@@ -222,7 +231,7 @@ void *MEM_lockfree_callocN(size_t len, const char *str)
   memh = (MemHead *)calloc(1, len + sizeof(MemHead));
 
   if (LIKELY(memh)) {
-    memh->len = len;
+    memh->len = len | MEMHEAD_TAG_BITS(mem_tag_alloc(len));
     atomic_add_and_fetch_u(&totblock, 1);
     atomic_add_and_fetch_z(&mem_in_use, len);
     update_maximum(&peak_mem, mem_in_use);
@@ -267,7 +276,7 @@ void *MEM_lockfree_mallocN(size_t len, const char *str)
       memset(memh + 1, 255, len);
     }
 
-    memh->len = len;
+    memh->len = len | MEMHEAD_TAG_BITS(mem_tag_alloc(len));
     atomic_add_and_fetch_u(&totblock, 1);
     atomic_add_and_fetch_z(&mem_in_use, len);
     update_maximum(&peak_mem, mem_in_use);
@@ -337,7 +346,7 @@ void *MEM_lockfree_mallocN_aligned(size_t len, size_t alignment, const char *str
       memset(memh + 1, 255, len);
     }
 
-    memh->len = len | (size_t)MEMHEAD_ALIGN_FLAG;
+    memh->len = len | (size_t)MEMHEAD_ALIGN_FLAG | MEMHEAD_TAG_BITS(mem_tag_alloc(len));
     memh->alignment = (short)alignment;
     atomic_add_and_fetch_u(&totblock, 1);
     atomic_add_and_fetch_z(&mem_in_use, len);
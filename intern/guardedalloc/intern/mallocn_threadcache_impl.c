@@ -0,0 +1,878 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup intern_mem
+ *
+ * Memory allocation which keeps freed blocks in per-thread caches.
+ *
+ * Small allocations are rounded up to a size class. When freed, a block is pushed onto the free
+ * list of the freeing thread, from which the next allocation of the same class is taken without
+ * any synchronization. Free lists which grow too long are handed over in bulk to a depot which is
+ * shared by all threads, threads with an empty free list refill from there. Only when both are
+ * empty the system allocator is used.
+ *
+ * Besides the thread caches this behaves the same as the lock-free allocator: block names are not
+ * stored, only the number of blocks and amount of memory in use are tracked.
+ */
+
+#include <stdarg.h>
+#include <stdio.h> /* printf */
+#include <stdlib.h>
+#include <string.h> /* memcpy */
+#include <sys/types.h>
+
+#ifdef WIN32
+#  include <windows.h>
+#else
+#  include <pthread.h>
+#endif
+#ifdef _MSC_VER
+#  include <intrin.h>
+#endif
+
+#include "MEM_guardedalloc.h"
+
+/* to ensure strict conversions */
+#include "../../source/blender/blenlib/BLI_strict_flags.h"
+
+#include "atomic_ops.h"
+#include "mallocn_intern.h"
+
+typedef struct MemHead {
+  /* Length of allocated memory block. */
+  size_t len;
+} MemHead;
+
+typedef struct MemHeadAligned {
+  short alignment;
+  size_t len;
+} MemHeadAligned;
+
+static unsigned int totblock = 0;
+static size_t mem_in_use = 0, peak_mem = 0;
+static bool malloc_debug_memset = false;
+
+static void (*error_callback)(const char *) = NULL;
+
+enum {
+  MEMHEAD_ALIGN_FLAG = 1,
+};
+
+#define MEMHEAD_FROM_PTR(ptr) (((MemHead *)ptr) - 1)
+#define PTR_FROM_MEMHEAD(memhead) (memhead + 1)
+#define MEMHEAD_ALIGNED_FROM_PTR(ptr) (((MemHeadAligned *)ptr) - 1)
+#define MEMHEAD_IS_ALIGNED(memhead) ((memhead)->len & (size_t)MEMHEAD_ALIGN_FLAG)
+
+/* -------------------------------------------------------------------- */
+/** \name Size Classes
+ *
+ * Steps of 16 bytes up to 128 bytes, then four classes for every power of two up to
+ * #SIZE_CLASS_MAX_LEN. Larger blocks are allocated by the system allocator directly.
+ * \{ */
+
+#define SIZE_CLASS_MAX_LEN 32768
+#define SIZE_CLASS_NUM (8 + 4 * 8)
+
+/** Total size of the memory kept in a thread's free list of one size class. */
+#define THREAD_CACHE_MAX_BYTES (256 * 1024)
+/** Total size of the memory kept in the depot for one size class. */
+#define DEPOT_MAX_BYTES (2 * 1024 * 1024)
+
+MEM_INLINE unsigned int log2_floor_z(size_t x)
+{
+#if defined(__GNUC__)
+  return (unsigned int)(sizeof(unsigned long long) * 8 - 1) -
+         (unsigned int)__builtin_clzll((unsigned long long)x);
+#elif defined(_MSC_VER) && defined(_WIN64)
+  unsigned long index;
+  _BitScanReverse64(&index, x);
+  return (unsigned int)index;
+#else
+  unsigned int result = 0;
+  while (x >>= 1) {
+    result++;
+  }
+  return result;
+#endif
+}
+
+MEM_INLINE unsigned int size_class_index(size_t len)
+{
+  if (len <= 128) {
+    return len == 0 ? 0 : (unsigned int)((len + 15) / 16) - 1;
+  }
+  const unsigned int power = log2_floor_z(len - 1);
+  const size_t step = ((size_t)1 << power) / 4;
+  const size_t sub_index = (len - ((size_t)1 << power) + step - 1) / step;
+  return 8 + (power - 7) * 4 + (unsigned int)sub_index - 1;
+}
+
+MEM_INLINE size_t size_class_len(unsigned int class_index)
+{
+  if (class_index < 8) {
+    return (size_t)(class_index + 1) * 16;
+  }
+  const unsigned int power = 7 + (class_index - 8) / 4;
+  const size_t step = ((size_t)1 << power) / 4;
+  return ((size_t)1 << power) + (size_t)((class_index - 8) % 4 + 1) * step;
+}
+
+/** Number of blocks that are moved between a thread cache and the depot at once. */
+MEM_INLINE unsigned int size_class_batch_num(unsigned int class_index)
+{
+  const size_t num = THREAD_CACHE_MAX_BYTES / 2 / size_class_len(class_index);
+  return (unsigned int)(num < 64 ? num : 64);
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Free Lists
+ * \{ */
+
+/**
+ * Stored in the data of freed blocks, which are at least 16 bytes.
+ */
+typedef struct FreeBlock {
+  struct FreeBlock *next;
+  /** Only used by the first block of a batch in the depot. */
+  struct FreeBlock *next_batch;
+} FreeBlock;
+
+#define FREEBLOCK_FROM_MEMHEAD(memh) ((FreeBlock *)PTR_FROM_MEMHEAD(memh))
+#define MEMHEAD_FROM_FREEBLOCK(block) MEMHEAD_FROM_PTR(block)
+
+typedef struct FreeList {
+  FreeBlock *first;
+  unsigned int num;
+} FreeList;
+
+typedef struct ThreadCache {
+  FreeList lists[SIZE_CLASS_NUM];
+
+  /** Non-zero while owned by a running thread. */
+  uint32_t in_use;
+  struct ThreadCache *next;
+
+  /* Statistics, only written by the owning thread. */
+  size_t alloc_cached_num;
+  size_t alloc_system_num;
+  size_t batches_to_depot_num;
+  size_t batches_from_depot_num;
+} ThreadCache;
+
+typedef struct Depot {
+  uint32_t lock;
+  unsigned int batches_num;
+  FreeBlock *batches;
+} Depot;
+
+static Depot depots[SIZE_CLASS_NUM];
+
+/** All thread caches ever created, caches of finished threads are reused. */
+static ThreadCache *thread_caches = NULL;
+
+static MEM_THREAD_LOCAL ThreadCache *thread_cache = NULL;
+
+static size_t system_freed_num = 0;
+
+MEM_INLINE void depot_lock(Depot *depot)
+{
+  while (atomic_cas_uint32(&depot->lock, 0, 1) != 0) {
+    /* Pass. */
+  }
+}
+
+MEM_INLINE void depot_unlock(Depot *depot)
+{
+  atomic_cas_uint32(&depot->lock, 1, 0);
+}
+
+static void free_list_free_blocks(FreeBlock *block)
+{
+  while (block) {
+    FreeBlock *next = block->next;
+    free(MEMHEAD_FROM_FREEBLOCK(block));
+    atomic_add_and_fetch_z(&system_freed_num, 1);
+    block = next;
+  }
+}
+
+/** Move `num` blocks from the start of the list to the depot, or free them if it is full. */
+static void free_list_to_depot(ThreadCache *cache, unsigned int class_index, unsigned int num)
+{
+  FreeList *list = &cache->lists[class_index];
+  FreeBlock *batch = list->first;
+  FreeBlock *last = batch;
+  for (unsigned int i = 1; i < num; i++) {
+    last = last->next;
+  }
+  list->first = last->next;
+  list->num -= num;
+  last->next = NULL;
+
+  Depot *depot = &depots[class_index];
+  const unsigned int batches_max = (unsigned int)(DEPOT_MAX_BYTES /
+                                                  (size_class_len(class_index) *
+                                                   size_class_batch_num(class_index)));
+  depot_lock(depot);
+  if (depot->batches_num < batches_max) {
+    batch->next_batch = depot->batches;
+    depot->batches = batch;
+    depot->batches_num++;
+    batch = NULL;
+  }
+  depot_unlock(depot);
+
+  if (batch) {
+    free_list_free_blocks(batch);
+  }
+  else {
+    cache->batches_to_depot_num++;
+  }
+}
+
+static bool free_list_from_depot(ThreadCache *cache, unsigned int class_index)
+{
+  Depot *depot = &depots[class_index];
+  if (depot->batches == NULL) {
+    /* Unlocked check, the next allocation will try again. */
+    return false;
+  }
+  depot_lock(depot);
+  FreeBlock *batch = depot->batches;
+  if (batch) {
+    depot->batches = batch->next_batch;
+    depot->batches_num--;
+  }
+  depot_unlock(depot);
+
+  if (batch == NULL) {
+    return false;
+  }
+  FreeList *list = &cache->lists[class_index];
+  list->first = batch;
+  list->num = size_class_batch_num(class_index);
+  cache->batches_from_depot_num++;
+  return true;
+}
+
+static void thread_cache_flush(ThreadCache *cache)
+{
+  for (unsigned int class_index = 0; class_index < SIZE_CLASS_NUM; class_index++) {
+    const unsigned int batch_num = size_class_batch_num(class_index);
+    FreeList *list = &cache->lists[class_index];
+    while (list->num >= batch_num) {
+      free_list_to_depot(cache, class_index, batch_num);
+    }
+    free_list_free_blocks(list->first);
+    list->first = NULL;
+    list->num = 0;
+  }
+}
+
+/* Return the free lists to the depot when the thread finishes, and make the cache available for
+ * other threads. */
+static void thread_cache_release(ThreadCache *cache)
+{
+  thread_cache_flush(cache);
+  thread_cache = NULL;
+  atomic_cas_uint32(&cache->in_use, 1, 0);
+}
+
+#ifdef WIN32
+static DWORD thread_cache_fls_index = FLS_OUT_OF_INDEXES;
+static INIT_ONCE thread_cache_fls_once = INIT_ONCE_STATIC_INIT;
+
+static void NTAPI thread_cache_exit(void *cache_v)
+{
+  if (cache_v) {
+    thread_cache_release((ThreadCache *)cache_v);
+  }
+}
+
+static BOOL CALLBACK thread_cache_fls_init(PINIT_ONCE init_once, void *param, void **context)
+{
+  (void)init_once;
+  (void)param;
+  (void)context;
+  thread_cache_fls_index = FlsAlloc(thread_cache_exit);
+  return TRUE;
+}
+#else
+static pthread_key_t thread_cache_key;
+static pthread_once_t thread_cache_key_once = PTHREAD_ONCE_INIT;
+
+static void thread_cache_exit(void *cache_v)
+{
+  thread_cache_release((ThreadCache *)cache_v);
+}
+
+static void thread_cache_key_init(void)
+{
+  pthread_key_create(&thread_cache_key, thread_cache_exit);
+}
+#endif
+
+static ThreadCache *thread_cache_ensure(void)
+{
+  ThreadCache *cache = thread_cache;
+  if (LIKELY(cache)) {
+    return cache;
+  }
+
+  for (cache = thread_caches; cache; cache = cache->next) {
+    if (atomic_cas_uint32(&cache->in_use, 0, 1) == 0) {
+      break;
+    }
+  }
+  if (cache == NULL) {
+    cache = (ThreadCache *)calloc(1, sizeof(ThreadCache));
+    if (UNLIKELY(cache == NULL)) {
+      return NULL;
+    }
+    cache->in_use = 1;
+    ThreadCache *first;
+    do {
+      first = thread_caches;
+      cache->next = first;
+    } while (atomic_cas_ptr((void **)&thread_caches, first, cache) != first);
+  }
+
+  /* Release the cache when the thread finishes. */
+#ifdef WIN32
+  InitOnceExecuteOnce(&thread_cache_fls_once, thread_cache_fls_init, NULL, NULL);
+  if (thread_cache_fls_index != FLS_OUT_OF_INDEXES) {
+    FlsSetValue(thread_cache_fls_index, cache);
+  }
+#else
+  pthread_once(&thread_cache_key_once, thread_cache_key_init);
+  pthread_setspecific(thread_cache_key, cache);
+#endif
+  thread_cache = cache;
+  return cache;
+}
+
+static MemHead *thread_cache_alloc(unsigned int class_index)
+{
+  ThreadCache *cache = thread_cache_ensure();
+  if (LIKELY(cache)) {
+    FreeList *list = &cache->lists[class_index];
+    if (list->first || free_list_from_depot(cache, class_index)) {
+      FreeBlock *block = list->first;
+      list->first = block->next;
+      list->num--;
+      cache->alloc_cached_num++;
+      return MEMHEAD_FROM_FREEBLOCK(block);
+    }
+    cache->alloc_system_num++;
+  }
+  return (MemHead *)malloc(sizeof(MemHead) + size_class_len(class_index));
+}
+
+static void thread_cache_free(MemHead *memh, unsigned int class_index)
+{
+  ThreadCache *cache = thread_cache_ensure();
+  if (UNLIKELY(cache == NULL)) {
+    free(memh);
+    return;
+  }
+  FreeList *list = &cache->lists[class_index];
+  FreeBlock *block = FREEBLOCK_FROM_MEMHEAD(memh);
+  block->next = list->first;
+  list->first = block;
+  list->num++;
+
+  const unsigned int batch_num = size_class_batch_num(class_index);
+  if (list->num >= batch_num * 2) {
+    free_list_to_depot(cache, class_index, batch_num);
+  }
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Allocator
+ * \{ */
+
+/* Uncomment this to have proper peak counter. */
+#define USE_ATOMIC_MAX
+
+MEM_INLINE void update_maximum(size_t *maximum_value, size_t value)
+{
+#ifdef USE_ATOMIC_MAX
+  atomic_fetch_and_update_max_z(maximum_value, value);
+#else
+  *maximum_value = value > *maximum_value ? value : *maximum_value;
+#endif
+}
+
+#ifdef __GNUC__
+__attribute__((format(printf, 1, 2)))
+#endif
+static void
+print_error(const char *str, ...)
+{
+  char buf[512];
+  va_list ap;
+
+  va_start(ap, str);
+  vsnprintf(buf, sizeof(buf), str, ap);
+  va_end(ap);
+  buf[sizeof(buf) - 1] = '\0';
+
+  if (error_callback) {
+    error_callback(buf);
+  }
+}
+
+size_t MEM_threadcache_allocN_len(const void *vmemh)
+{
+  if (vmemh) {
+    return MEMHEAD_LEN_UNTAGGED(MEMHEAD_FROM_PTR(vmemh)->len) & ~((size_t)(MEMHEAD_ALIGN_FLAG));
+  }
+
+  return 0;
+}
+
+void MEM_threadcache_freeN(void *vmemh)
+{
+  if (leak_detector_has_run) {
+    print_error("%s\n", free_after_leak_detection_message);
+  }
+
+  MemHead *memh = MEMHEAD_FROM_PTR(vmemh);
+  size_t len = MEM_threadcache_allocN_len(vmemh);
+
+  if (vmemh == NULL) {
+    print_error("Attempt to free NULL pointer\n");
+#ifdef WITH_ASSERT_ABORT
+    abort();
+#endif
+    return;
+  }
+
+  atomic_sub_and_fetch_u(&totblock, 1);
+  atomic_sub_and_fetch_z(&mem_in_use, len);
+  mem_tag_free(MEMHEAD_LEN_TAG(memh->len), len);
+
+  if (UNLIKELY(malloc_debug_memset && len)) {
+    memset(memh + 1, 255, len);
+  }
+  if (UNLIKELY(MEMHEAD_IS_ALIGNED(memh))) {
+    MemHeadAligned *memh_aligned = MEMHEAD_ALIGNED_FROM_PTR(vmemh);
+    aligned_free(MEMHEAD_REAL_PTR(memh_aligned));
+  }
+  else if (len <= SIZE_CLASS_MAX_LEN) {
+    thread_cache_free(memh, size_class_index(len));
+  }
+  else {
+    free(memh);
+  }
+}
+
+void *MEM_threadcache_dupallocN(const void *vmemh)
+{
+  void *newp = NULL;
+  if (vmemh) {
+    MemHead *memh = MEMHEAD_FROM_PTR(vmemh);
+    const size_t prev_size = MEM_threadcache_allocN_len(vmemh);
+    if (UNLIKELY(MEMHEAD_IS_ALIGNED(memh))) {
+      MemHeadAligned *memh_aligned = MEMHEAD_ALIGNED_FROM_PTR(vmemh);
+      newp = MEM_threadcache_mallocN_aligned(
+          prev_size, (size_t)memh_aligned->alignment, "dupli_malloc");
+    }
+    else {
+      newp = MEM_threadcache_mallocN(prev_size, "dupli_malloc");
+    }
+    memcpy(newp, vmemh, prev_size);
+  }
+  return newp;
+}
+
+/**
+ * Shrink or grow the block in place when the new length falls in the same size class.
+ */
+static bool threadcache_resize_in_place(void *vmemh, size_t len)
+{
+  MemHead *memh = MEMHEAD_FROM_PTR(vmemh);
+  if (MEMHEAD_IS_ALIGNED(memh)) {
+    return false;
+  }
+  const size_t old_len = MEMHEAD_LEN_UNTAGGED(memh->len);
+  const eMEMTag tag = MEMHEAD_LEN_TAG(memh->len);
+  len = SIZET_ALIGN_4(len);
+  if (old_len > SIZE_CLASS_MAX_LEN || len > SIZE_CLASS_MAX_LEN || len == 0 ||
+      size_class_index(old_len) != size_class_index(len)) {
+    return false;
+  }
+  /* Keep the tag of the original allocation. */
+  memh->len = len | MEMHEAD_TAG_BITS(tag);
+  mem_tag_free(tag, old_len);
+  if (tag != MEM_TAG_NONE) {
+    atomic_add_and_fetch_z(&mem_tag_in_use[tag], len);
+  }
+  if (len > old_len) {
+    atomic_add_and_fetch_z(&mem_in_use, len - old_len);
+    update_maximum(&peak_mem, mem_in_use);
+  }
+  else {
+    atomic_sub_and_fetch_z(&mem_in_use, old_len - len);
+  }
+  return true;
+}
+
+void *MEM_threadcache_reallocN_id(void *vmemh, size_t len, const char *str)
+{
+  void *newp = NULL;
+
+  if (vmemh) {
+    MemHead *memh = MEMHEAD_FROM_PTR(vmemh);
+    size_t old_len = MEM_threadcache_allocN_len(vmemh);
+
+    if (threadcache_resize_in_place(vmemh, len)) {
+      return vmemh;
+    }
+
+    /* Keep the tag of the original allocation. */
+    const eMEMTag tag_prev = MEM_tag_set(MEMHEAD_LEN_TAG(memh->len));
+    if (LIKELY(!MEMHEAD_IS_ALIGNED(memh))) {
+      newp = MEM_threadcache_mallocN(len, "realloc");
+    }
+    else {
+      MemHeadAligned *memh_aligned = MEMHEAD_ALIGNED_FROM_PTR(vmemh);
+      newp = MEM_threadcache_mallocN_aligned(len, (size_t)memh_aligned->alignment, "realloc");
+    }
+
+    if (newp) {
+      if (len < old_len) {
+        /* shrink */
+        memcpy(newp, vmemh, len);
+      }
+      else {
+        /* grow (or remain same size) */
+        memcpy(newp, vmemh, old_len);
+      }
+    }
+
+    MEM_tag_set(tag_prev);
+
+    MEM_threadcache_freeN(vmemh);
+  }
+  else {
+    newp = MEM_threadcache_mallocN(len, str);
+  }
+
+  return newp;
+}
+
+void *MEM_threadcache_recallocN_id(void *vmemh, size_t len, const char *str)
+{
+  void *newp = NULL;
+
+  if (vmemh) {
+    MemHead *memh = MEMHEAD_FROM_PTR(vmemh);
+    size_t old_len = MEM_threadcache_allocN_len(vmemh);
+
+    if (threadcache_resize_in_place(vmemh, len)) {
+      if (len > old_len) {
+        /* zero new bytes */
+        memset(((char *)vmemh) + old_len, 0, len - old_len);
+      }
+      return vmemh;
+    }
+
+    /* Keep the tag of the original allocation. */
+    const eMEMTag tag_prev = MEM_tag_set(MEMHEAD_LEN_TAG(memh->len));
+    if (LIKELY(!MEMHEAD_IS_ALIGNED(memh))) {
+      newp = MEM_threadcache_mallocN(len, "recalloc");
+    }
+    else {
+      MemHeadAligned *memh_aligned = MEMHEAD_ALIGNED_FROM_PTR(vmemh);
+      newp = MEM_threadcache_mallocN_aligned(len, (size_t)memh_aligned->alignment, "recalloc");
+    }
+
+    if (newp) {
+      if (len < old_len) {
+        /* shrink */
+        memcpy(newp, vmemh, len);
+      }
+      else {
+        memcpy(newp, vmemh, old_len);
+
+        if (len > old_len) {
+          /* grow */
+          /* zero new bytes */
+          memset(((char *)newp) + old_len, 0, len - old_len);
+        }
+      }
+    }
+
+    MEM_tag_set(tag_prev);
+
+    MEM_threadcache_freeN(vmemh);
+  }
+  else {
+    newp = MEM_threadcache_callocN(len, str);
+  }
+
+  return newp;
+}
+
+static MemHead *threadcache_alloc(size_t len)
+{
+  if (len <= SIZE_CLASS_MAX_LEN) {
+    return thread_cache_alloc(size_class_index(len));
+  }
+  return (MemHead *)malloc(len + sizeof(MemHead));
+}
+
+void *MEM_threadcache_callocN(size_t len, const char *str)
+{
+  MemHead *memh;
+
+  len = SIZET_ALIGN_4(len);
+
+  memh = threadcache_alloc(len);
+
+  if (LIKELY(memh)) {
+    memset(memh + 1, 0, len);
+    memh->len = len | MEMHEAD_TAG_BITS(mem_tag_alloc(len));
+    atomic_add_and_fetch_u(&totblock, 1);
+    atomic_add_and_fetch_z(&mem_in_use, len);
+    update_maximum(&peak_mem, mem_in_use);
+
+    return PTR_FROM_MEMHEAD(memh);
+  }
+  print_error("Calloc returns null: len=" SIZET_FORMAT " in %s, total %u\n",
+              SIZET_ARG(len),
+              str,
+              (unsigned int)mem_in_use);
+  return NULL;
+}
+
+void *MEM_threadcache_calloc_arrayN(size_t len, size_t size, const char *str)
+{
+  size_t total_size;
+  if (UNLIKELY(!MEM_size_safe_multiply(len, size, &total_size))) {
+    print_error(
+        "Calloc array aborted due to integer overflow: "
+        "len=" SIZET_FORMAT "x" SIZET_FORMAT " in %s, total %u\n",
+        SIZET_ARG(len),
+        SIZET_ARG(size),
+        str,
+        (unsigned int)mem_in_use);
+    abort();
+    return NULL;
+  }
+
+  return MEM_threadcache_callocN(total_size, str);
+}
+
+void *MEM_threadcache_mallocN(size_t len, const char *str)
+{
+  MemHead *memh;
+
+  len = SIZET_ALIGN_4(len);
+
+  memh = threadcache_alloc(len);
+
+  if (LIKELY(memh)) {
+    if (UNLIKELY(malloc_debug_memset && len)) {
+      memset(memh + 1, 255, len);
+    }
+
+    memh->len = len | MEMHEAD_TAG_BITS(mem_tag_alloc(len));
+    atomic_add_and_fetch_u(&totblock, 1);
+    atomic_add_and_fetch_z(&mem_in_use, len);
+    update_maximum(&peak_mem, mem_in_use);
+
+    return PTR_FROM_MEMHEAD(memh);
+  }
+  print_error("Malloc returns null: len=" SIZET_FORMAT " in %s, total %u\n",
+              SIZET_ARG(len),
+              str,
+              (unsigned int)mem_in_use);
+  return NULL;
+}
+
+void *MEM_threadcache_malloc_arrayN(size_t len, size_t size, const char *str)
+{
+  size_t total_size;
+  if (UNLIKELY(!MEM_size_safe_multiply(len, size, &total_size))) {
+    print_error(
+        "Malloc array aborted due to integer overflow: "
+        "len=" SIZET_FORMAT "x" SIZET_FORMAT " in %s, total %u\n",
+        SIZET_ARG(len),
+        SIZET_ARG(size),
+        str,
+        (unsigned int)mem_in_use);
+    abort();
+    return NULL;
+  }
+
+  return MEM_threadcache_mallocN(total_size, str);
+}
+
+void *MEM_threadcache_mallocN_aligned(size_t len, size_t alignment, const char *str)
+{
+  /* Huge alignment values doesn't make sense and they wouldn't fit into 'short' used in the
+   * MemHead. */
+  assert(alignment < 1024);
+
+  /* We only support alignments that are a power of two. */
+  assert(IS_POW2(alignment));
+
+  /* Some OS specific aligned allocators require a certain minimal alignment. */
+  if (alignment < ALIGNED_MALLOC_MINIMUM_ALIGNMENT) {
+    alignment = ALIGNED_MALLOC_MINIMUM_ALIGNMENT;
+  }
+
+  /* It's possible that MemHead's size is not properly aligned,
+   * do extra padding to deal with this.
+   *
+   * We only support small alignments which fits into short in
+   * order to save some bits in MemHead structure.
+   */
+  size_t extra_padding = MEMHEAD_ALIGN_PADDING(alignment);
+
+  len = SIZET_ALIGN_4(len);
+
+  /* Aligned blocks are not cached, they are rare compared to regular allocations. */
+  MemHeadAligned *memh = (MemHeadAligned *)aligned_malloc(
+      len + extra_padding + sizeof(MemHeadAligned), alignment);
+
+  if (LIKELY(memh)) {
+    /* We keep padding in the beginning of MemHead,
+     * this way it's always possible to get MemHead
+     * from the data pointer.
+     */
+    memh = (MemHeadAligned *)((char *)memh + extra_padding);
+
+    if (UNLIKELY(malloc_debug_memset && len)) {
+      memset(memh + 1, 255, len);
+    }
+
+    memh->len = len | (size_t)MEMHEAD_ALIGN_FLAG | MEMHEAD_TAG_BITS(mem_tag_alloc(len));
+    memh->alignment = (short)alignment;
+    atomic_add_and_fetch_u(&totblock, 1);
+    atomic_add_and_fetch_z(&mem_in_use, len);
+    update_maximum(&peak_mem, mem_in_use);
+
+    return PTR_FROM_MEMHEAD(memh);
+  }
+  print_error("Malloc returns null: len=" SIZET_FORMAT " in %s, total %u\n",
+              SIZET_ARG(len),
+              str,
+              (unsigned int)mem_in_use);
+  return NULL;
+}
+
+void MEM_threadcache_printmemlist_pydict(void)
+{
+}
+
+void MEM_threadcache_printmemlist(void)
+{
+}
+
+/* unused */
+void MEM_threadcache_callbackmemlist(void (*func)(void *))
+{
+  (void)func; /* Ignored. */
+}
+
+void MEM_threadcache_printmemlist_stats(void)
+{
+  printf("\ntotal memory len: %.3f MB\n", (double)mem_in_use / (double)(1024 * 1024));
+  printf("peak memory len: %.3f MB\n", (double)peak_mem / (double)(1024 * 1024));
+
+  /* Read without synchronization, the numbers are approximate while other threads run. */
+  size_t threads_num = 0, alloc_cached_num = 0, alloc_system_num = 0;
+  size_t batches_to_depot_num = 0, batches_from_depot_num = 0;
+  size_t thread_cached_len = 0, depot_cached_len = 0;
+  for (const ThreadCache *cache = thread_caches; cache; cache = cache->next) {
+    threads_num++;
+    alloc_cached_num += cache->alloc_cached_num;
+    alloc_system_num += cache->alloc_system_num;
+    batches_to_depot_num += cache->batches_to_depot_num;
+    batches_from_depot_num += cache->batches_from_depot_num;
+    for (unsigned int class_index = 0; class_index < SIZE_CLASS_NUM; class_index++) {
+      thread_cached_len += cache->lists[class_index].num * size_class_len(class_index);
+    }
+  }
+  for (unsigned int class_index = 0; class_index < SIZE_CLASS_NUM; class_index++) {
+    depot_cached_len += depots[class_index].batches_num * size_class_batch_num(class_index) *
+                        size_class_len(class_index);
+  }
+
+  printf("\nThread caches: " SIZET_FORMAT "\n", SIZET_ARG(threads_num));
+  printf("allocations from cache: " SIZET_FORMAT ", from system: " SIZET_FORMAT "\n",
+         SIZET_ARG(alloc_cached_num),
+         SIZET_ARG(alloc_system_num));
+  printf("batches to depot: " SIZET_FORMAT ", from depot: " SIZET_FORMAT "\n",
+         SIZET_ARG(batches_to_depot_num),
+         SIZET_ARG(batches_from_depot_num));
+  printf("blocks returned to system: " SIZET_FORMAT "\n", SIZET_ARG(system_freed_num));
+  printf("cached in threads: %.3f MB, in depot: %.3f MB\n",
+         (double)thread_cached_len / (double)(1024 * 1024),
+         (double)depot_cached_len / (double)(1024 * 1024));
+
+  printf(
+      "\nFor more detailed per-block statistics run Blender with memory debugging command line "
+      "argument.\n");
+
+#ifdef HAVE_MALLOC_STATS
+  printf("System Statistics:\n");
+  malloc_stats();
+#endif
+}
+
+void MEM_threadcache_set_error_callback(void (*func)(const char *))
+{
+  error_callback = func;
+}
+
+bool MEM_threadcache_consistency_check(void)
+{
+  return true;
+}
+
+void MEM_threadcache_set_memory_debug(void)
+{
+  malloc_debug_memset = true;
+}
+
+size_t MEM_threadcache_get_memory_in_use(void)
+{
+  return mem_in_use;
+}
+
+unsigned int MEM_threadcache_get_memory_blocks_in_use(void)
+{
+  return totblock;
+}
+
+/* dummy */
+void MEM_threadcache_reset_peak_memory(void)
+{
+  peak_mem = mem_in_use;
+}
+
+size_t MEM_threadcache_get_peak_memory(void)
+{
+  return peak_mem;
+}
+
+#ifndef NDEBUG
+const char *MEM_threadcache_name_ptr(void *vmemh)
+{
+  if (vmemh) {
+    return "unknown block name ptr";
+  }
+
+  return "MEM_threadcache_name_ptr(NULL)";
+}
+#endif /* NDEBUG */
+
+/** \} */
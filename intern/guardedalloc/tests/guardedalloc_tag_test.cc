@@ -0,0 +1,104 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include <thread>
+
+#include "MEM_guardedalloc.h"
+
+#include "guardedalloc_test_base.h"
+
+namespace {
+
+void DoBasicTagChecks()
+{
+  void *untagged = MEM_mallocN(100, "untagged");
+  void *mesh = nullptr;
+  void *image = nullptr;
+  {
+    MEM_TagScope tag_scope(MEM_TAG_MESH);
+    mesh = MEM_mallocN(200, "mesh");
+    {
+      MEM_TagScope tag_scope_nested(MEM_TAG_IMAGE);
+      image = MEM_mallocN_aligned(400, 64, "image");
+    }
+    EXPECT_EQ(MEM_get_memory_in_use_by_tag(MEM_TAG_MESH), 200);
+  }
+  EXPECT_EQ(MEM_get_memory_in_use_by_tag(MEM_TAG_MESH), 200);
+  EXPECT_EQ(MEM_get_memory_in_use_by_tag(MEM_TAG_IMAGE), 400);
+  EXPECT_EQ(MEM_get_memory_in_use_by_tag(MEM_TAG_NONE), 100);
+  EXPECT_EQ(MEM_allocN_len(mesh), 200);
+  EXPECT_EQ(MEM_allocN_len(image), 400);
+
+  /* Reallocation keeps the tag of the block. */
+  mesh = MEM_reallocN(mesh, 1000);
+  image = MEM_recallocN(image, 40);
+  EXPECT_EQ(MEM_get_memory_in_use_by_tag(MEM_TAG_MESH), 1000);
+  EXPECT_EQ(MEM_get_memory_in_use_by_tag(MEM_TAG_IMAGE), 40);
+  EXPECT_EQ(MEM_get_memory_in_use_by_tag(MEM_TAG_NONE), 100);
+
+  /* Freeing from another thread uses the tag of the block, not of the thread. */
+  std::thread thread([&]() { MEM_freeN(mesh); });
+  thread.join();
+  EXPECT_EQ(MEM_get_memory_in_use_by_tag(MEM_TAG_MESH), 0);
+
+  MEM_freeN(image);
+  MEM_freeN(untagged);
+  EXPECT_EQ(MEM_get_memory_in_use_by_tag(MEM_TAG_IMAGE), 0);
+  EXPECT_EQ(MEM_get_memory_in_use_by_tag(MEM_TAG_NONE), 0);
+}
+
+void DoThreadAllocatedChecks()
+{
+  const size_t allocated_before = MEM_get_thread_allocated();
+  void *a = MEM_mallocN(100, "a");
+  void *b = MEM_callocN(52, "b");
+  MEM_freeN(a);
+  void *c = MEM_mallocN_aligned(200, 64, "c");
+  EXPECT_EQ(MEM_get_thread_allocated() - allocated_before, 352);
+
+  /* Allocations of other threads are not counted. */
+  std::thread thread([&]() {
+    const size_t thread_allocated_before = MEM_get_thread_allocated();
+    void *d = MEM_mallocN(1000, "d");
+    EXPECT_EQ(MEM_get_thread_allocated() - thread_allocated_before, 1000);
+    MEM_freeN(d);
+  });
+  thread.join();
+  EXPECT_EQ(MEM_get_thread_allocated() - allocated_before, 352);
+
+  MEM_freeN(b);
+  MEM_freeN(c);
+}
+
+}  // namespace
+
+TEST_F(LockFreeAllocatorTest, MEM_tag_set)
+{
+  DoBasicTagChecks();
+}
+
+TEST_F(GuardedAllocatorTest, MEM_tag_set)
+{
+  DoBasicTagChecks();
+}
+
+TEST_F(ThreadCacheAllocatorTest, MEM_tag_set)
+{
+  DoBasicTagChecks();
+}
+
+TEST_F(LockFreeAllocatorTest, MEM_get_thread_allocated)
+{
+  DoThreadAllocatedChecks();
+}
+
+TEST_F(GuardedAllocatorTest, MEM_get_thread_allocated)
+{
+  DoThreadAllocatedChecks();
+}
+
+TEST_F(ThreadCacheAllocatorTest, MEM_get_thread_allocated)
+{
+  DoThreadAllocatedChecks();
+}
@@ -0,0 +1,87 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "MEM_guardedalloc.h"
+
+#include "guardedalloc_test_base.h"
+
+namespace {
+
+void AllocFreeSizes()
+{
+  std::vector<void *> blocks;
+  for (size_t len = 0; len < 70000; len += 97) {
+    void *mem = MEM_mallocN(len, "AllocFreeSizes");
+    memset(mem, 1, len);
+    EXPECT_EQ(MEM_allocN_len(mem), (len + 3) & ~size_t(3));
+    blocks.push_back(mem);
+  }
+  for (void *mem : blocks) {
+    MEM_freeN(mem);
+  }
+}
+
+}  // namespace
+
+TEST_F(ThreadCacheAllocatorTest, ReuseFreedBlocks)
+{
+  void *mem = MEM_mallocN(100, "ReuseFreedBlocks");
+  MEM_freeN(mem);
+  /* Same size class, taken from the free list of this thread. */
+  void *mem_reused = MEM_callocN(112, "ReuseFreedBlocks");
+  EXPECT_EQ(mem, mem_reused);
+  for (int i = 0; i < 112; i++) {
+    EXPECT_EQ(((char *)mem_reused)[i], 0);
+  }
+  MEM_freeN(mem_reused);
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), 0);
+  EXPECT_EQ(MEM_get_memory_in_use(), 0);
+}
+
+TEST_F(ThreadCacheAllocatorTest, ReallocInPlace)
+{
+  int *mem = (int *)MEM_mallocN(sizeof(int) * 18, "ReallocInPlace");
+  for (int i = 0; i < 18; i++) {
+    mem[i] = i;
+  }
+  /* Same size class, both round up to 80 bytes. */
+  int *mem_grown = (int *)MEM_recallocN(mem, sizeof(int) * 20);
+  EXPECT_EQ(mem, mem_grown);
+  EXPECT_EQ(MEM_allocN_len(mem_grown), sizeof(int) * 20);
+  EXPECT_EQ(MEM_get_memory_in_use(), sizeof(int) * 20);
+  for (int i = 0; i < 20; i++) {
+    EXPECT_EQ(mem_grown[i], i < 18 ? i : 0);
+  }
+  MEM_freeN(mem_grown);
+  EXPECT_EQ(MEM_get_memory_in_use(), 0);
+}
+
+TEST_F(ThreadCacheAllocatorTest, FreeOnOtherThreads)
+{
+  std::vector<void *> blocks;
+  for (int i = 0; i < 10000; i++) {
+    blocks.push_back(MEM_mallocN(size_t(i % 300), "FreeOnOtherThreads"));
+  }
+
+  std::vector<std::thread> threads;
+  for (int thread_index = 0; thread_index < 4; thread_index++) {
+    threads.emplace_back([&blocks, thread_index]() {
+      for (size_t i = size_t(thread_index); i < blocks.size(); i += 4) {
+        MEM_freeN(blocks[i]);
+      }
+      AllocFreeSizes();
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  AllocFreeSizes();
+
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), 0);
+  EXPECT_EQ(MEM_get_memory_in_use(), 0);
+}
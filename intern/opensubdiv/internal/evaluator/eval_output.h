@@ -542,6 +542,16 @@ class VolatileEvalOutput : public EvalOutputAPI::EvalOutput {
     return patch_table_;
   }
 
+  const BufferDescriptor &getSrcDesc() const
+  {
+    return src_desc_;
+  }
+
+  EvaluatorCache *getEvaluatorCache() const
+  {
+    return evaluator_cache_;
+  }
+
   SRC_VERTEX_BUFFER *getFVarSrcBuffer(const int face_varying_channel) const
   {
     return face_varying_evaluators[face_varying_channel]->getSrcBuffer();
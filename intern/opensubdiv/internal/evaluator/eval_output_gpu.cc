@@ -20,6 +20,9 @@
 
 #include "opensubdiv_evaluator_capi.h"
 
+#include <GL/glew.h>
+
+using OpenSubdiv::Osd::BufferDescriptor;
 using OpenSubdiv::Osd::PatchArray;
 using OpenSubdiv::Osd::PatchArrayVector;
 
@@ -60,6 +63,44 @@ GpuEvalOutput::GpuEvalOutput(const StencilTable *vertex_stencils,
 {
 }
 
+void GpuEvalOutput::evalPatches(const PatchCoord *patch_coord,
+                                const int num_patch_coords,
+                                float *P)
+{
+  if (num_patch_coords == 0) {
+    return;
+  }
+  // The patch kernel reads the coordinates with the same layout as PatchCoord.
+  const int patch_coord_num_elements = sizeof(PatchCoord) / sizeof(float);
+  GLVertexBuffer *patch_coord_buffer = GLVertexBuffer::Create(patch_coord_num_elements,
+                                                              num_patch_coords);
+  patch_coord_buffer->UpdateData(
+      reinterpret_cast<const float *>(patch_coord), 0, num_patch_coords);
+  GLVertexBuffer *P_buffer = GLVertexBuffer::Create(3, num_patch_coords);
+
+  BufferDescriptor P_desc(0, 3, 3);
+  // Without an evaluator cache, EvalPatches() creates a temporary evaluator instance.
+  const GLComputeEvaluator *eval_instance = OpenSubdiv::Osd::GetEvaluator<GLComputeEvaluator>(
+      getEvaluatorCache(), getSrcDesc(), P_desc, static_cast<void *>(nullptr));
+  GLComputeEvaluator::EvalPatches(getSrcBuffer(),
+                                  getSrcDesc(),
+                                  P_buffer,
+                                  P_desc,
+                                  num_patch_coords,
+                                  patch_coord_buffer,
+                                  getPatchTable(),
+                                  eval_instance,
+                                  static_cast<void *>(nullptr));
+
+  glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+  glBindBuffer(GL_ARRAY_BUFFER, P_buffer->BindVBO());
+  glGetBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(float[3]) * num_patch_coords, P);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+  delete P_buffer;
+  delete patch_coord_buffer;
+}
+
 void GpuEvalOutput::fillPatchArraysBuffer(OpenSubdiv_Buffer *patch_arrays_buffer)
 {
   GLPatchTable *patch_table = getPatchTable();
@@ -43,6 +43,10 @@ class GpuEvalOutput : public VolatileEvalOutput<GLVertexBuffer,
                 const PatchTable *patch_table,
                 EvaluatorCache *evaluator_cache = NULL);
 
+  // NOTE: The patch coordinates and P are in host memory, so this uploads the coordinates and
+  // reads the result back from the GPU. Only meant for bulk evaluation of many coordinates.
+  void evalPatches(const PatchCoord *patch_coord, const int num_patch_coords, float *P) override;
+
   void fillPatchArraysBuffer(OpenSubdiv_Buffer *patch_arrays_buffer) override;
 
   void wrapPatchIndexBuffer(OpenSubdiv_Buffer *patch_index_buffer) override;
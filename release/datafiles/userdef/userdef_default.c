@@ -94,6 +94,7 @@ const UserDef U_default = {
 
     .keyconfigstr = "Blender",
     .undosteps = 32,
+    .undo_compress_steps = 0,
     .undomemory = 0,
     .gp_manhattandist = 1,
     .gp_euclideandist = 2,
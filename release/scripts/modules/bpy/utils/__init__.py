@@ -180,6 +180,26 @@ _global_loaded_modules = []  # store loaded module names for reloading.
 import bpy_types as _bpy_types  # keep for comparisons, never ever reload this.
 
 
+def _addons_initialize_is_deferred():
+    if _bpy.app.background:
+        return False
+    return (
+        _preferences.view.show_developer_ui and
+        _preferences.experimental.use_deferred_addon_registration
+    )
+
+
+def _addons_initialize_deferred():
+    """
+    Register the add-ons left out of startup by the "Deferred Add-on Registration" option.
+    Called by the window-manager once the first redraw is done.
+    """
+    _initialize = getattr(_addon_utils, "_initialize", None)
+    if _initialize is not None:
+        _initialize()
+        del _addon_utils._initialize
+
+
 def load_scripts(*, reload_scripts=False, refresh_scripts=False):
     """
     Load scripts and run each modules register function.
@@ -300,8 +320,10 @@ def load_scripts(*, reload_scripts=False, refresh_scripts=False):
     _initialize = getattr(_addon_utils, "_initialize", None)
     if _initialize is not None:
         # first time, use fast-path
-        _initialize()
-        del _addon_utils._initialize
+        # (unless registered after the first redraw, see `_addons_initialize_deferred`).
+        if not _addons_initialize_is_deferred():
+            _initialize()
+            del _addon_utils._initialize
     else:
         _addon_utils.reset_all(reload_scripts=reload_scripts)
     del _initialize
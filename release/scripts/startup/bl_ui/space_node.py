@@ -710,6 +710,7 @@ class NODE_PT_overlay(Panel):
             col.separator()
             col.prop(overlay, "show_timing", text="Timings")
             col.prop(overlay, "show_named_attributes", text="Named Attributes")
+            col.operator("object.geometry_nodes_profile_export", text="Export Timings...")
 
 
 class NODE_UL_interface_sockets(bpy.types.UIList):
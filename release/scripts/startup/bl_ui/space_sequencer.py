@@ -2140,6 +2140,10 @@ class SEQUENCER_PT_cache_settings(SequencerButtonsPanel, Panel):
         col.prop(ed, "use_cache_composite", text="Composite")
         col.prop(ed, "use_cache_final", text="Final")
 
+        col = layout.column(heading="Memory", align=True)
+        col.prop(ed, "use_cache_compression", text="Compress Final")
+        col.prop(ed, "use_cache_recycle_by_cost", text="Free by Render Cost")
+
 
 class SEQUENCER_PT_proxy_settings(SequencerButtonsPanel, Panel):
     bl_label = "Proxy Settings"
@@ -446,7 +446,7 @@ class TOPBAR_MT_file_import(Menu):
     bl_label = "Import"
     bl_owner_use_filter = False
 
-    def draw(self, _context):
+    def draw(self, context):
         if bpy.app.build_options.collada:
             self.layout.operator("wm.collada_import", text="Collada (.dae)")
         if bpy.app.build_options.alembic:
@@ -457,6 +457,8 @@ class TOPBAR_MT_file_import(Menu):
 
         self.layout.operator("wm.gpencil_import_svg", text="SVG as Grease Pencil")
         self.layout.operator("wm.obj_import", text="Wavefront (.obj) (experimental)")
+        if context.preferences.experimental.use_native_stl_io:
+            self.layout.operator("wm.stl_import", text="STL (.stl) (experimental)")
 
 
 class TOPBAR_MT_file_export(Menu):
@@ -464,7 +466,7 @@ class TOPBAR_MT_file_export(Menu):
     bl_label = "Export"
     bl_owner_use_filter = False
 
-    def draw(self, _context):
+    def draw(self, context):
         if bpy.app.build_options.collada:
             self.layout.operator("wm.collada_export", text="Collada (.dae)")
         if bpy.app.build_options.alembic:
@@ -481,6 +483,8 @@ class TOPBAR_MT_file_export(Menu):
             self.layout.operator("wm.gpencil_export_pdf", text="Grease Pencil as PDF")
 
         self.layout.operator("wm.obj_export", text="Wavefront (.obj) (experimental)")
+        if context.preferences.experimental.use_native_stl_io:
+            self.layout.operator("wm.stl_export", text="STL (.stl) (experimental)")
 
 
 class TOPBAR_MT_file_external_data(Menu):
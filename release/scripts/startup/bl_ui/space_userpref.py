@@ -626,10 +626,18 @@ class USERPREF_PT_system_memory(SystemPanel, CenterAlignMixIn, Panel):
         col = layout.column()
         col.prop(edit, "undo_steps", text="Undo Steps")
         col.prop(edit, "undo_memory_limit", text="Undo Memory Limit")
+        col.prop(edit, "undo_compress_steps", text="Compress Steps")
         col.prop(edit, "use_global_undo")
 
         layout.separator()
 
+        col = layout.column()
+        col.prop(system, "geometry_cache_limit", text="Geometry Cache Limit")
+        col.prop(system, "geometry_nodes_cache_limit", text="Geometry Nodes Cache Limit")
+        col.prop(system, "compositor_cache_limit", text="Compositor Cache Limit")
+
+        layout.separator()
+
         col = layout.column()
         col.prop(system, "scrollback", text="Console Scrollback Lines")
 
@@ -669,6 +677,13 @@ class USERPREF_PT_system_video_sequencer(SystemPanel, CenterAlignMixIn, Panel):
 
         layout.prop(system, "sequencer_proxy_setup")
 
+        layout.separator()
+
+        layout.prop(system, "use_movie_hardware_decoding")
+        col = layout.column()
+        col.prop(system, "movie_decode_threads")
+        col.prop(system, "movie_decode_thread_type")
+
 
 # -----------------------------------------------------------------------------
 # Viewport Panels
@@ -2264,6 +2279,31 @@ class USERPREF_PT_experimental_new_features(ExperimentalPanel, Panel):
                 ({"property": "use_extended_asset_browser"}, ("project/view/130/", "Project Page")),
                 ({"property": "use_override_templates"}, ("T73318", "Milestone 4")),
                 ({"property": "use_named_attribute_nodes"}, ("T91742")),
+                ({"property": "use_depsgraph_critical_path"}, None),
+                ({"property": "use_draw_async_mesh_extraction"}, None),
+                ({"property": "use_draw_mesh_lod"}, None),
+                ({"property": "use_draw_occlusion_culling"}, None),
+                ({"property": "use_gpu_texture_compression"}, None),
+                ({"property": "use_render_write_background"}, None),
+                ({"property": "use_imm_batching"}, None),
+                ({"property": "use_sculpt_gpu_filter"}, None),
+                ({"property": "use_subdiv_gpu_final"}, None),
+                ({"property": "use_subdiv_topology_version"}, None),
+                ({"property": "use_compositor_gpu"}, None),
+                ({"property": "use_compositor_partial_exr"}, None),
+                ({"property": "use_compositor_progressive"}, None),
+                ({"property": "use_sequencer_parallel_strips"}, None),
+                ({"property": "use_sequencer_gpu_blend"}, None),
+                ({"property": "use_sequencer_prefetch_threads"}, None),
+                ({"property": "use_render_lazy_passes"}, None),
+                ({"property": "use_native_stl_io"}, None),
+                ({"property": "use_edit_mesh_partial_undo"}, None),
+                ({"property": "use_edit_mesh_pack"}, None),
+                ({"property": "use_customdata_pool"}, None),
+                ({"property": "use_parallel_main_relations"}, None),
+                ({"property": "use_file_preview_cache"}, None),
+                ({"property": "use_gpencil_partial_draw_update"}, None),
+                ({"property": "use_deferred_addon_registration"}, None),
             ),
         )
 
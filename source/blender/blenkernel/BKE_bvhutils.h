@@ -227,6 +227,23 @@ BVHTree *BKE_bvhtree_from_editmesh_get(BVHTreeFromEditMesh *data,
                                        struct BVHCache **bvh_cache_p,
                                        ThreadMutex *mesh_eval_mutex);
 
+/**
+ * Builds or queries the tree of the edit-mesh elements enabled in \a mask,
+ * for one of the `BVHTREE_FROM_EM_*` types.
+ *
+ * One tree per type is kept in #BMEditMesh.bvh_cache_masked, identified by a hash of the enabled
+ * elements and their positions. It is reused until those change, so it stays valid across
+ * evaluations of the edit-mesh, and is replaced by the next call with different elements.
+ *
+ * \note Not thread-safe, unlike #BKE_bvhtree_from_editmesh_get.
+ */
+BVHTree *BKE_bvhtree_from_editmesh_masked_get(BVHTreeFromEditMesh *data,
+                                              struct BMEditMesh *em,
+                                              const BLI_bitmap *mask,
+                                              int elems_num_active,
+                                              int tree_type,
+                                              BVHCacheType bvh_cache_type);
+
 /**
  * Frees data allocated by a call to `bvhtree_from_editmesh_*`.
  */
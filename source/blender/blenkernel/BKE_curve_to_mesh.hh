@@ -2,7 +2,6 @@
 
 #pragma once
 
-struct CurveEval;
 struct Mesh;
 
 /** \file
@@ -11,8 +10,10 @@ struct Mesh;
 
 namespace blender::bke {
 
+class CurvesGeometry;
+
 /**
- * Extrude all splines in the profile curve along the path of every spline in the curve input.
+ * Extrude all of the profile curves along the path of every main curve.
  * Transfer curve attributes to the mesh.
  *
  * \note Normal calculation is by far the slowest part of calculations relating to the result mesh.
@@ -21,11 +22,13 @@ namespace blender::bke {
  * changed anyway in a way that affects the normals. So currently this code uses the safer /
  * simpler solution of deferring normal calculation to the rest of Blender.
  */
-Mesh *curve_to_mesh_sweep(const CurveEval &curve, const CurveEval &profile, bool fill_caps);
+Mesh *curve_to_mesh_sweep(const CurvesGeometry &main,
+                          const CurvesGeometry &profile,
+                          bool fill_caps);
 /**
- * Create a loose-edge mesh based on the evaluated path of the curve's splines.
+ * Create a loose-edge mesh based on the evaluated path of the curves.
  * Transfer curve attributes to the mesh.
  */
-Mesh *curve_to_wire_mesh(const CurveEval &curve);
+Mesh *curve_to_wire_mesh(const CurvesGeometry &curves);
 
 }  // namespace blender::bke
@@ -169,6 +169,17 @@ class CurvesGeometry : public ::CurvesGeometry {
   Span<float3> positions() const;
   MutableSpan<float3> positions_for_write();
 
+  /** The radius of every control point, 1 when the attribute doesn't exist. */
+  VArray<float> radii() const;
+  MutableSpan<float> radii_for_write();
+
+  /**
+   * The rotation of the normals around the tangents at every control point, in radians.
+   * Call #tag_normals_changed after changes.
+   */
+  VArray<float> tilts() const;
+  MutableSpan<float> tilts_for_write();
+
   /** Whether the curve loops around to connect to itself, on the curve domain. */
   VArray<bool> cyclic() const;
   /** Mutable access to curve cyclic values. Call #tag_topology_changed after changes. */
@@ -420,6 +431,11 @@ void calculate_normals_minimum(Span<float3> tangents, bool cyclic, MutableSpan<f
  */
 void calculate_normals_z_up(Span<float3> tangents, MutableSpan<float3> normals);
 
+/**
+ * Rotate the normals around the tangents by the tilt angles (in radians) at every point.
+ */
+void apply_tilt(Span<float3> tangents, Span<float> tilts, MutableSpan<float3> normals);
+
 }  // namespace poly
 
 namespace bezier {
@@ -57,6 +57,12 @@ typedef enum eCDAllocType {
   CD_REFERENCE = 3,
   /** Do a full copy of all layers, only allowed if source has same number of elements. */
   CD_DUPLICATE = 4,
+  /**
+   * Share the data arrays with the source layers, which are only copied once they are modified
+   * (see #CustomData_duplicate_referenced_layer). Only supported by #CustomData_copy and
+   * #CustomData_merge, layers referenced by the source are duplicated instead.
+   */
+  CD_SHARE = 5,
 } eCDAllocType;
 
 #define CD_TYPE_AS_MASK(_type) (CustomDataMask)((CustomDataMask)1 << (CustomDataMask)(_type))
@@ -97,7 +103,7 @@ bool CustomData_has_interp(const struct CustomData *data);
 bool CustomData_bmesh_has_free(const struct CustomData *data);
 
 /**
- * Checks if any of the custom-data layers is referenced.
+ * Checks if any of the custom-data layers is referenced or shared with other users.
  */
 bool CustomData_has_referenced(const struct CustomData *data);
 
@@ -181,6 +187,15 @@ void CustomData_reset(struct CustomData *data);
  */
 void CustomData_free(struct CustomData *data, int totelem);
 
+/**
+ * Free the layer arrays kept for reuse by the "Recycle Mesh Data Arrays" experimental option.
+ */
+void CustomData_layer_pool_clear(void);
+/**
+ * Free the layer array pool itself, on exit.
+ */
+void CustomData_layer_pool_free(void);
+
 /**
  * Same as above, but only frees layers which matches the given mask.
  */
@@ -252,7 +267,8 @@ int CustomData_number_of_layers(const struct CustomData *data, int type);
 int CustomData_number_of_layers_typemask(const struct CustomData *data, CustomDataMask mask);
 
 /**
- * Duplicate data of a layer with flag NOFREE, and remove that flag.
+ * Duplicate data of a layer with flag NOFREE or shared with other users (see #CD_SHARE),
+ * so that it can be modified.
  * \return the layer data.
  */
 void *CustomData_duplicate_referenced_layer(struct CustomData *data, int type, int totelem);
@@ -269,7 +285,8 @@ void *CustomData_duplicate_referenced_layer_anonymous(
 bool CustomData_is_referenced_layer(struct CustomData *data, int type);
 
 /**
- * Duplicate all the layers with flag NOFREE, and remove the flag from duplicated layers.
+ * Duplicate all the layers with flag NOFREE or shared with other users,
+ * and remove the flag from duplicated layers.
  */
 void CustomData_duplicate_referenced_layers(CustomData *data, int totelem);
 
@@ -451,6 +468,9 @@ void CustomData_bmesh_set_layer_n(struct CustomData *data, void *block, int n, c
 /**
  * Set the pointer of to the first layer of type. the old data is not freed.
  * returns the value of `ptr` if the layer is found, NULL otherwise.
+ *
+ * \note When the old data is shared (see #CD_SHARE), it is kept alive for the other users, so the
+ * caller should only take over the old data after #CustomData_duplicate_referenced_layer.
  */
 void *CustomData_set_layer(const struct CustomData *data, int type, void *ptr);
 void *CustomData_set_layer_n(const struct CustomData *data, int type, int n, void *ptr);
@@ -11,6 +11,7 @@ extern "C" {
 #endif
 
 struct Depsgraph;
+struct GeometrySet;
 struct ID;
 struct ListBase;
 struct Object;
@@ -49,8 +50,23 @@ typedef struct DupliObject {
 
   /* Random ID for shading */
   unsigned int random_id;
+
+  /* Geometry with the instances component and the index of the instance that created this dupli
+   * on every level, in the same order as #persistent_id. Null for levels that are not geometry
+   * instances. Used to look up instance attributes. */
+  const struct GeometrySet *instance_data[8]; /* MAX_DUPLI_RECUR */
+  int instance_idx[8];                        /* MAX_DUPLI_RECUR */
 } DupliObject;
 
+/**
+ * Look up an attribute on the instance domain of the geometry the dupli was instanced from,
+ * starting at the innermost instancing level, converted to a color.
+ * \return False when none of the instance levels has the attribute.
+ */
+bool BKE_object_dupli_find_rgba_attribute(const struct DupliObject *dupli,
+                                          const char *name,
+                                          float r_value[4]);
+
 #ifdef __cplusplus
 }
 #endif
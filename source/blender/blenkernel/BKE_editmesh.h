@@ -21,6 +21,7 @@ struct BMLoop;
 struct BMPartialUpdate;
 struct BMesh;
 struct BMeshCalcTessellation_Params;
+struct BVHCache;
 struct BoundBox;
 struct Depsgraph;
 struct Mesh;
@@ -67,6 +68,9 @@ typedef struct BMEditMesh {
    */
   char needs_flush_to_id;
 
+  /** Trees of some of the elements, see #BKE_bvhtree_from_editmesh_masked_get. */
+  struct BVHCache *bvh_cache_masked;
+
 } BMEditMesh;
 
 /* editmesh.c */
@@ -0,0 +1,66 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bke
+ *
+ * Cache of the evaluated geometry of mesh objects for each frame, so that playing back a range of
+ * frames again does not evaluate the modifier stacks again. The cache is only used by the active
+ * depsgraphs and is enabled by setting its memory limit in the preferences
+ * (#UserDef.geometry_cache_limit). Entries furthest from the current frame are removed first
+ * when the limit is exceeded.
+ *
+ * Cached geometry only stays valid as long as nothing but the frame changes, any update tagged
+ * for a depsgraph clears its entries.
+ */
+
+#include "BKE_geometry_set.hh"
+
+struct CustomData_MeshMasks;
+struct Depsgraph;
+struct Mesh;
+struct Object;
+
+namespace blender::bke {
+
+/**
+ * Whether the evaluated geometry of the object can be stored in the cache. Objects running
+ * simulations, which need to be evaluated on every frame, are not supported.
+ */
+bool geometry_frame_cache_use(const Depsgraph *depsgraph, const Object *object);
+
+/**
+ * Get a copy of the geometry cached for the object at the current frame of the depsgraph, with
+ * at least the layers of `mask`. The mesh is not part of the returned geometry set.
+ * `r_mesh_deform_eval` is the result of the leading deform modifiers
+ * (see #Object_Runtime.mesh_deform_eval).
+ *
+ * \return False when there is nothing cached.
+ */
+bool geometry_frame_cache_lookup(const Depsgraph *depsgraph,
+                                 const Object *object,
+                                 const CustomData_MeshMasks *mask,
+                                 bool need_mapping,
+                                 Mesh **r_mesh_eval,
+                                 Mesh **r_mesh_deform_eval,
+                                 GeometrySet **r_geometry_set);
+
+/**
+ * Store the evaluated geometry of the object at the current frame of the depsgraph.
+ * The data is shared with the cache until it is modified.
+ */
+void geometry_frame_cache_add(const Depsgraph *depsgraph,
+                              const Object *object,
+                              const Mesh *mesh_eval,
+                              const Mesh *mesh_deform_eval,
+                              const GeometrySet &geometry_set,
+                              const CustomData_MeshMasks *mask,
+                              bool need_mapping);
+
+/**
+ * Remove all the entries of the depsgraph.
+ */
+void geometry_frame_cache_clear(const Depsgraph *depsgraph);
+
+}  // namespace blender::bke
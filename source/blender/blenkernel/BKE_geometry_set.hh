@@ -57,6 +57,7 @@ class GeometryComponent {
    * larger than one, the component becomes immutable. */
   mutable std::atomic<int> users_ = 1;
   GeometryComponentType type_;
+  uint64_t version_;
 
  public:
   GeometryComponent(GeometryComponentType type);
@@ -78,6 +79,15 @@ class GeometryComponent {
 
   GeometryComponentType type() const;
 
+  /**
+   * Number that identifies the data of the component. It is unique among all components of the
+   * session and changes when the component is retrieved for write from a #GeometrySet, so two
+   * components with the same version have the same data. This allows detecting that geometry
+   * did not change without comparing it.
+   */
+  uint64_t version() const;
+  void tag_version_changed();
+
   /**
    * Return true when any attribute with this name exists, including built in attributes.
    */
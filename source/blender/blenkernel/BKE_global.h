@@ -195,7 +195,9 @@ enum {
   G_DEBUG_XR = (1 << 19),                    /* XR/OpenXR messages */
   G_DEBUG_XR_TIME = (1 << 20),               /* XR/OpenXR timing messages */
 
-  G_DEBUG_GHOST = (1 << 21), /* Debug GHOST module. */
+  G_DEBUG_GHOST = (1 << 21),           /* Debug GHOST module. */
+  G_DEBUG_IO_STATS = (1 << 22),        /* Blend file read/write statistics per ID. */
+  G_DEBUG_DEPSGRAPH_TRACE = (1 << 23), /* Record a timeline of depsgraph evaluation. */
 };
 
 #define G_DEBUG_ALL \
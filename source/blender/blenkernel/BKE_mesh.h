@@ -1062,9 +1062,18 @@ void BKE_mesh_eval_geometry(struct Depsgraph *depsgraph, struct Mesh *mesh);
 /* Draw Cache */
 void BKE_mesh_batch_cache_dirty_tag(struct Mesh *me, eMeshBatchDirtyMode mode);
 void BKE_mesh_batch_cache_free(struct Mesh *me);
+/**
+ * Detach the batch cache from its mesh, see #BKE_object_mesh_batch_cache_stash.
+ * \param is_deform_only: The next evaluated mesh shares the topology of `me`.
+ */
+void *BKE_mesh_batch_cache_stash(struct Mesh *me, bool is_deform_only);
+/** Free a batch cache that was detached from its mesh, see #BKE_object_mesh_batch_cache_stash. */
+void BKE_mesh_batch_cache_stash_free(void *batch_cache);
 
 extern void (*BKE_mesh_batch_cache_dirty_tag_cb)(struct Mesh *me, eMeshBatchDirtyMode mode);
 extern void (*BKE_mesh_batch_cache_free_cb)(struct Mesh *me);
+extern void *(*BKE_mesh_batch_cache_stash_cb)(struct Mesh *me, bool is_deform_only);
+extern void (*BKE_mesh_batch_cache_stash_free_cb)(void *batch_cache);
 
 /* mesh_debug.c */
 
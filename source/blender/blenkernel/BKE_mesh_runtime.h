@@ -53,6 +53,14 @@ bool BKE_mesh_runtime_ensure_edit_data(struct Mesh *mesh);
 bool BKE_mesh_runtime_clear_edit_data(struct Mesh *mesh);
 bool BKE_mesh_runtime_reset_edit_data(struct Mesh *mesh);
 void BKE_mesh_runtime_clear_geometry(struct Mesh *mesh);
+/**
+ * Return the topology version of the mesh, assigning a new unique one when it has none.
+ * Two meshes with the same version reference the same edge, polygon and corner arrays, unless
+ * one of them had its topology changed without resetting the version.
+ *
+ * \note Only fills a cache, so the mesh argument can be considered logically const.
+ */
+unsigned int BKE_mesh_topology_version_ensure(const struct Mesh *mesh);
 /**
  * \brief This function clears runtime cache of the given mesh.
  *
@@ -315,6 +315,9 @@ typedef struct bNodeType {
   /* Execute a geometry node. */
   NodeGeometryExecFunction geometry_node_execute;
   bool geometry_node_execute_supports_laziness;
+  /* The outputs only depend on the inputs and the node properties, so they can be reused when the
+   * inputs did not change. Only worth it for nodes that are expensive to execute. */
+  bool geometry_node_execute_supports_caching;
 
   /* Declares which sockets the node has. */
   NodeDeclareFunction declare;
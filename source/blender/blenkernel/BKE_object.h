@@ -64,6 +64,13 @@ void BKE_object_free_curve_cache(struct Object *ob);
  * Free data derived from mesh, called when mesh changes or is freed.
  */
 void BKE_object_free_derived_caches(struct Object *ob);
+/**
+ * Detach the GPU batch cache from the evaluated mesh before it gets freed, so it can be reused for
+ * the next evaluated mesh with the same topology when the mesh was only deformed, or drawn while
+ * the batches of the next evaluated mesh are extracted asynchronously.
+ * See #Object_Runtime.mesh_batch_cache_prev.
+ */
+void BKE_object_mesh_batch_cache_stash(struct Object *ob_eval);
 void BKE_object_free_caches(struct Object *object);
 
 void BKE_object_modifier_hook_reset(struct Object *ob, struct HookModifierData *hmd);
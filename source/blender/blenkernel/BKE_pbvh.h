@@ -66,6 +66,8 @@ typedef enum {
 
   PBVH_UpdateTopology = 1 << 13,
   PBVH_UpdateColor = 1 << 14,
+  /** Positions or normals changed, set along #PBVH_UpdateDrawBuffers. */
+  PBVH_UpdateDrawGeometry = 1 << 15,
 } PBVHNodeFlags;
 
 typedef struct PBVHFrustumPlanes {
@@ -126,7 +128,8 @@ void BKE_pbvh_build_bmesh(PBVH *pbvh,
                           bool smooth_shading,
                           struct BMLog *log,
                           int cd_vert_node_offset,
-                          int cd_face_node_offset);
+                          int cd_face_node_offset,
+                          int cd_vert_draw_index_offset);
 void BKE_pbvh_free(PBVH *pbvh);
 
 /* Hierarchical Search in the BVH, two methods:
@@ -184,6 +184,17 @@ typedef struct Subdiv {
      */
     int *face_ptex_offset;
   } cache_;
+
+  /* Identifies the mesh topology the topology refiner was created for or last compared against,
+   * used to skip the topology comparison in #BKE_subdiv_update_from_mesh. Only valid when
+   * `topology_version` is not zero. */
+  struct {
+    unsigned int topology_version;
+    int totvert, totedge, totloop, totpoly;
+    const void *medge, *mloop, *mpoly;
+    const void *vertex_crease;
+    uint64_t uv_layers_hash;
+  } mesh_key_;
 } Subdiv;
 
 /* =================----====--===== MODULE ==========================------== */
@@ -15,6 +15,7 @@ extern "C" {
 
 struct Mesh;
 struct OpenSubdiv_EvaluatorCache;
+struct OpenSubdiv_PatchCoord;
 struct Subdiv;
 
 typedef enum eSubdivEvaluatorType {
@@ -86,6 +87,20 @@ void BKE_subdiv_eval_displacement(struct Subdiv *subdiv,
 void BKE_subdiv_eval_final_point(
     struct Subdiv *subdiv, int ptex_face_index, float u, float v, float r_P[3]);
 
+/* Bulk queries. */
+
+/* Evaluate many points on the limit surface at once with a temporary GLSL compute evaluator, and
+ * read the result back. Displacement is not applied.
+ *
+ * Only possible when a GPU context is active in the calling thread, returns false when the points
+ * could not be evaluated on the GPU. Does not use or modify the evaluator of the subdiv. */
+bool BKE_subdiv_eval_limit_points_gpu(struct Subdiv *subdiv,
+                                      const struct Mesh *mesh,
+                                      const float (*coarse_vertex_cos)[3],
+                                      const struct OpenSubdiv_PatchCoord *patch_coords,
+                                      int num_patch_coords,
+                                      float (*r_P)[3]);
+
 #ifdef __cplusplus
 }
 #endif
@@ -35,6 +35,7 @@
 #include "BKE_colorband.h"
 #include "BKE_deform.h"
 #include "BKE_editmesh.h"
+#include "BKE_geometry_frame_cache.hh"
 #include "BKE_geometry_set.hh"
 #include "BKE_geometry_set_instances.hh"
 #include "BKE_key.h"
@@ -1620,20 +1621,34 @@ static void mesh_build_data(struct Depsgraph *depsgraph,
   }
 #endif
 
+  /* Evaluated meshes are attributed to meshes, except for work done by other threads. */
+  MEM_TagScope tag_scope(MEM_TAG_MESH);
+
   Mesh *mesh_eval = nullptr, *mesh_deform_eval = nullptr;
   GeometrySet *geometry_set_eval = nullptr;
-  mesh_calc_modifiers(depsgraph,
-                      scene,
-                      ob,
-                      true,
-                      need_mapping,
-                      dataMask,
-                      -1,
-                      true,
-                      true,
-                      &mesh_deform_eval,
-                      &mesh_eval,
-                      &geometry_set_eval);
+  const bool use_frame_cache = blender::bke::geometry_frame_cache_use(depsgraph, ob);
+  const bool is_frame_cached = use_frame_cache &&
+                               blender::bke::geometry_frame_cache_lookup(depsgraph,
+                                                                         ob,
+                                                                         dataMask,
+                                                                         need_mapping,
+                                                                         &mesh_eval,
+                                                                         &mesh_deform_eval,
+                                                                         &geometry_set_eval);
+  if (!is_frame_cached) {
+    mesh_calc_modifiers(depsgraph,
+                        scene,
+                        ob,
+                        true,
+                        need_mapping,
+                        dataMask,
+                        -1,
+                        true,
+                        true,
+                        &mesh_deform_eval,
+                        &mesh_eval,
+                        &geometry_set_eval);
+  }
 
   /* The modifier stack evaluation is storing result in mesh->runtime.mesh_eval, but this result
    * is not guaranteed to be owned by object.
@@ -1661,6 +1676,9 @@ static void mesh_build_data(struct Depsgraph *depsgraph,
    * different topology than the evaluated mesh. */
   BLI_assert(mesh->key == nullptr || DEG_is_evaluated_id(&mesh->key->id));
   mesh_eval->key = mesh->key;
+  if (is_frame_cached) {
+    mesh_deform_eval->key = mesh->key;
+  }
 
   if ((ob->mode & OB_MODE_ALL_SCULPT) && ob->sculpt) {
     if (DEG_is_active(depsgraph)) {
@@ -1669,6 +1687,11 @@ static void mesh_build_data(struct Depsgraph *depsgraph,
   }
 
   mesh_build_extra_data(depsgraph, ob, mesh_eval);
+
+  if (use_frame_cache && !is_frame_cached) {
+    blender::bke::geometry_frame_cache_add(
+        depsgraph, ob, mesh_eval, mesh_deform_eval, *geometry_set_eval, dataMask, need_mapping);
+  }
 }
 
 static void editbmesh_build_data(struct Depsgraph *depsgraph,
@@ -1677,6 +1700,8 @@ static void editbmesh_build_data(struct Depsgraph *depsgraph,
                                  BMEditMesh *em,
                                  CustomData_MeshMasks *dataMask)
 {
+  MEM_TagScope tag_scope(MEM_TAG_MESH);
+
   Mesh *mesh = static_cast<Mesh *>(obedit->data);
   Mesh *me_cage;
   Mesh *me_final;
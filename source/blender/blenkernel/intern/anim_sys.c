@@ -579,6 +579,41 @@ static void animsys_write_orig_anim_rna(PointerRNA *ptr,
   }
 }
 
+/** The last successfully resolved RNA path, see #animsys_rna_path_resolve_cached. */
+typedef struct AnimsysPathResolveCache {
+  const char *rna_path;
+  PathResolvedRNA resolved;
+  int array_len;
+} AnimsysPathResolveCache;
+
+/**
+ * Same as #BKE_animsys_rna_path_resolve, but reuses the previous result when the path is the same
+ * and only the array index differs. The F-Curves of a property are usually stored next to each
+ * other (location X/Y/Z, quaternion W/X/Y/Z...), so this skips most path lookups.
+ */
+static bool animsys_rna_path_resolve_cached(PointerRNA *ptr,
+                                            const char *rna_path,
+                                            const int array_index,
+                                            AnimsysPathResolveCache *cache,
+                                            PathResolvedRNA *r_result)
+{
+  if (cache->rna_path && rna_path && STREQ(cache->rna_path, rna_path) &&
+      (cache->array_len == 0 || array_index < cache->array_len)) {
+    *r_result = cache->resolved;
+    r_result->prop_index = cache->array_len ? array_index : -1;
+    return true;
+  }
+
+  cache->rna_path = NULL;
+  if (!BKE_animsys_rna_path_resolve(ptr, rna_path, array_index, r_result)) {
+    return false;
+  }
+  cache->rna_path = rna_path;
+  cache->resolved = *r_result;
+  cache->array_len = RNA_property_array_length(&r_result->ptr, r_result->prop);
+  return true;
+}
+
 /**
  * Evaluate all the F-Curves in the given list
  * This performs a set of standard checks. If extra checks are required,
@@ -589,6 +624,13 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
                                      const AnimationEvalContext *anim_eval_context,
                                      bool flush_to_original)
 {
+  AnimsysPathResolveCache path_cache = {NULL};
+  AnimsysPathResolveCache path_cache_orig = {NULL};
+  PointerRNA ptr_orig;
+  if (flush_to_original && !animsys_construct_orig_pointer_rna(ptr, &ptr_orig)) {
+    flush_to_original = false;
+  }
+
   /* Calculate then execute each curve. */
   LISTBASE_FOREACH (FCurve *, fcu, list) {
 
@@ -597,11 +639,16 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
     }
 
     PathResolvedRNA anim_rna;
-    if (BKE_animsys_rna_path_resolve(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+    if (animsys_rna_path_resolve_cached(
+            ptr, fcu->rna_path, fcu->array_index, &path_cache, &anim_rna)) {
       const float curval = calculate_fcurve(&anim_rna, fcu, anim_eval_context);
       BKE_animsys_write_to_rna_path(&anim_rna, curval);
       if (flush_to_original) {
-        animsys_write_orig_anim_rna(ptr, fcu->rna_path, fcu->array_index, curval);
+        PathResolvedRNA orig_anim_rna;
+        if (animsys_rna_path_resolve_cached(
+                &ptr_orig, fcu->rna_path, fcu->array_index, &path_cache_orig, &orig_anim_rna)) {
+          BKE_animsys_write_to_rna_path(&orig_anim_rna, curval);
+        }
       }
     }
   }
@@ -19,6 +19,7 @@
 #include "BLI_listbase.h"
 #include "BLI_math.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 #include "BLT_translation.h"
 
@@ -2537,6 +2538,127 @@ void BKE_pose_where_is_bone(struct Depsgraph *depsgraph,
   BKE_pose_where_is_bone_tail(pchan);
 }
 
+/** Fewer bones are evaluated faster on a single thread. */
+#define POSE_PARALLEL_MIN_BONES 64
+
+typedef struct PoseWhereIsTaskData {
+  struct Depsgraph *depsgraph;
+  Scene *scene;
+  Object *ob;
+  float ctime;
+  /** Channels grouped by their root bone, parents before children within each group. */
+  bPoseChannel **pchans;
+  int *group_offsets;
+} PoseWhereIsTaskData;
+
+static void pose_where_is_group_task(void *__restrict userdata,
+                                     const int group,
+                                     const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const PoseWhereIsTaskData *data = userdata;
+  for (int i = data->group_offsets[group]; i < data->group_offsets[group + 1]; i++) {
+    BKE_pose_where_is_bone(
+        data->depsgraph, data->scene, data->ob, data->pchans[i], data->ctime, true);
+  }
+}
+
+/**
+ * Evaluate the bone hierarchies without constraints and IK in parallel, one task per root bone.
+ * Without constraints a bone only depends on its parents, so these hierarchies can't affect
+ * each other. Evaluated channels get the #POSE_DONE flag, the others are left to the main loop.
+ */
+static void pose_where_is_independent_hierarchies(struct Depsgraph *depsgraph,
+                                                  Scene *scene,
+                                                  Object *ob,
+                                                  const float ctime)
+{
+  bPose *pose = ob->pose;
+  const int pchans_num = BLI_listbase_count(&pose->chanbase);
+  if (pchans_num < POSE_PARALLEL_MIN_BONES) {
+    return;
+  }
+
+  GHash *pchan_index_map = BLI_ghash_ptr_new_ex(__func__, (uint)pchans_num);
+  int *root_indices = MEM_malloc_arrayN(pchans_num, sizeof(int), __func__);
+  int *group_indices = MEM_malloc_arrayN(pchans_num, sizeof(int), __func__);
+  bool *root_is_independent = MEM_calloc_arrayN(pchans_num, sizeof(bool), __func__);
+
+  /* Channels are sorted from root to children, so parents are always found. */
+  int i = 0;
+  LISTBASE_FOREACH (bPoseChannel *, pchan, &pose->chanbase) {
+    BLI_ghash_insert(pchan_index_map, pchan, POINTER_FROM_INT(i));
+    void **parent_index_p = pchan->parent ? BLI_ghash_lookup_p(pchan_index_map, pchan->parent) :
+                                            NULL;
+    if (parent_index_p) {
+      root_indices[i] = root_indices[POINTER_AS_INT(*parent_index_p)];
+    }
+    else {
+      root_indices[i] = i;
+      root_is_independent[i] = (pchan->parent == NULL);
+    }
+    if (pchan->constraints.first || (pchan->flag & (POSE_IKTREE | POSE_IKSPLINE | POSE_CHAIN))) {
+      root_is_independent[root_indices[i]] = false;
+    }
+    i++;
+  }
+
+  int groups_num = 0;
+  for (i = 0; i < pchans_num; i++) {
+    group_indices[i] = root_is_independent[i] ? groups_num++ : -1;
+  }
+
+  if (groups_num > 1) {
+    int *group_offsets = MEM_calloc_arrayN(groups_num + 1, sizeof(int), __func__);
+    for (i = 0; i < pchans_num; i++) {
+      const int group = group_indices[root_indices[i]];
+      if (group != -1) {
+        group_offsets[group + 1]++;
+      }
+    }
+    for (int group = 0; group < groups_num; group++) {
+      group_offsets[group + 1] += group_offsets[group];
+    }
+
+    bPoseChannel **pchans = MEM_malloc_arrayN(
+        group_offsets[groups_num], sizeof(bPoseChannel *), __func__);
+    int *group_fill = MEM_dupallocN(group_offsets);
+    i = 0;
+    LISTBASE_FOREACH (bPoseChannel *, pchan, &pose->chanbase) {
+      const int group = group_indices[root_indices[i]];
+      if (group != -1) {
+        pchans[group_fill[group]++] = pchan;
+      }
+      i++;
+    }
+
+    PoseWhereIsTaskData data = {
+        .depsgraph = depsgraph,
+        .scene = scene,
+        .ob = ob,
+        .ctime = ctime,
+        .pchans = pchans,
+        .group_offsets = group_offsets,
+    };
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = group_offsets[groups_num] >= POSE_PARALLEL_MIN_BONES;
+    BLI_task_parallel_range(0, groups_num, &data, pose_where_is_group_task, &settings);
+
+    for (i = 0; i < group_offsets[groups_num]; i++) {
+      pchans[i]->flag |= POSE_DONE;
+    }
+
+    MEM_freeN(group_fill);
+    MEM_freeN(pchans);
+    MEM_freeN(group_offsets);
+  }
+
+  BLI_ghash_free(pchan_index_map, NULL, NULL);
+  MEM_freeN(root_indices);
+  MEM_freeN(group_indices);
+  MEM_freeN(root_is_independent);
+}
+
 void BKE_pose_where_is(struct Depsgraph *depsgraph, Scene *scene, Object *ob)
 {
   bArmature *arm;
@@ -2587,6 +2709,9 @@ void BKE_pose_where_is(struct Depsgraph *depsgraph, Scene *scene, Object *ob)
      */
     BKE_pose_splineik_init_tree(scene, ob, ctime);
 
+    /* 2c. evaluate bone hierarchies that don't depend on other bones in parallel */
+    pose_where_is_independent_hierarchies(depsgraph, scene, ob, ctime);
+
     /* 3. the main loop, channels are already hierarchical sorted from root to children */
     for (pchan = ob->pose->chanbase.first; pchan; pchan = pchan->next) {
       /* 4a. if we find an IK root, we handle it separated */
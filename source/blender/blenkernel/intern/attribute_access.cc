@@ -19,6 +19,7 @@
 #include "BLI_color.hh"
 #include "BLI_math_vec_types.hh"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
 
 #include "BLT_translation.h"
 
@@ -182,6 +183,24 @@ static AttributeIDRef attribute_id_from_custom_data_layer(const CustomDataLayer
   return layer.name;
 }
 
+/**
+ * Fill a new layer from a virtual array. The layer is allocated without initializing it to the
+ * default value first, since every element is overwritten anyway, and large layers are filled
+ * in parallel.
+ */
+static void *add_layer_from_varray(const GVArray &varray,
+                                   const FunctionRef<void *(eCDAllocType alloctype)> add_layer)
+{
+  void *data = add_layer(CD_CALLOC);
+  if (data == nullptr) {
+    return nullptr;
+  }
+  threading::parallel_for(varray.index_range(), 4096, [&](const IndexRange range) {
+    varray.materialize_to_uninitialized(range, data);
+  });
+  return data;
+}
+
 static bool add_builtin_type_custom_data_layer_from_init(CustomData &custom_data,
                                                          const CustomDataType data_type,
                                                          const int domain_size,
@@ -193,13 +212,11 @@ static bool add_builtin_type_custom_data_layer_from_init(CustomData &custom_data
       return data != nullptr;
     }
     case AttributeInit::Type::VArray: {
-      void *data = CustomData_add_layer(&custom_data, data_type, CD_DEFAULT, nullptr, domain_size);
-      if (data == nullptr) {
-        return false;
-      }
       const GVArray &varray = static_cast<const AttributeInitVArray &>(initializer).varray;
-      varray.materialize_to_uninitialized(varray.index_range(), data);
-      return true;
+      const void *data = add_layer_from_varray(varray, [&](const eCDAllocType alloctype) {
+        return CustomData_add_layer(&custom_data, data_type, alloctype, nullptr, domain_size);
+      });
+      return data != nullptr;
     }
     case AttributeInit::Type::MoveArray: {
       void *source_data = static_cast<const AttributeInitMove &>(initializer).data;
@@ -248,14 +265,12 @@ static bool add_custom_data_layer_from_attribute_init(const AttributeIDRef &attr
       return data != nullptr;
     }
     case AttributeInit::Type::VArray: {
-      void *data = add_generic_custom_data_layer(
-          custom_data, data_type, CD_DEFAULT, nullptr, domain_size, attribute_id);
-      if (data == nullptr) {
-        return false;
-      }
       const GVArray &varray = static_cast<const AttributeInitVArray &>(initializer).varray;
-      varray.materialize_to_uninitialized(varray.index_range(), data);
-      return true;
+      const void *data = add_layer_from_varray(varray, [&](const eCDAllocType alloctype) {
+        return add_generic_custom_data_layer(
+            custom_data, data_type, alloctype, nullptr, domain_size, attribute_id);
+      });
+      return data != nullptr;
     }
     case AttributeInit::Type::MoveArray: {
       void *source_data = static_cast<const AttributeInitMove &>(initializer).data;
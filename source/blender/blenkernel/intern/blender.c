@@ -28,6 +28,7 @@
 #include "BKE_brush.h"
 #include "BKE_cachefile.h"
 #include "BKE_callbacks.h"
+#include "BKE_customdata.h"
 #include "BKE_global.h"
 #include "BKE_idprop.h"
 #include "BKE_image.h"
@@ -83,6 +84,8 @@ void BKE_blender_free(void)
   IMB_moviecache_destruct();
 
   BKE_node_system_exit();
+
+  CustomData_layer_pool_free();
 }
 
 /** \} */
@@ -13,6 +13,7 @@
 #include "DNA_meshdata_types.h"
 #include "DNA_pointcloud_types.h"
 
+#include "BLI_hash_mm2a.h"
 #include "BLI_linklist.h"
 #include "BLI_math.h"
 #include "BLI_task.h"
@@ -33,6 +34,9 @@
 struct BVHCacheItem {
   bool is_filled;
   BVHTree *tree;
+  /** Identify the elements of masked trees, see #BKE_bvhtree_from_editmesh_masked_get. */
+  uint32_t mask_hash;
+  int elems_num;
 };
 
 struct BVHCache {
@@ -715,11 +719,24 @@ static BVHTree *bvhtree_from_mesh_verts_create_tree(float epsilon,
     tree = BLI_bvhtree_new(verts_num_active, epsilon, tree_type, axis);
 
     if (tree) {
-      for (int i = 0; i < verts_num; i++) {
-        if (verts_mask && !BLI_BITMAP_TEST_BOOL(verts_mask, i)) {
-          continue;
+      if (verts_mask == nullptr) {
+        BLI_bvhtree_insert_range(
+            tree,
+            verts_num,
+            1,
+            [](void *userdata, const int i, float(*r_co)[3]) {
+              const MVert *vert = static_cast<const MVert *>(userdata);
+              copy_v3_v3(r_co[0], vert[i].co);
+            },
+            const_cast<MVert *>(vert));
+      }
+      else {
+        for (int i = 0; i < verts_num; i++) {
+          if (!BLI_BITMAP_TEST_BOOL(verts_mask, i)) {
+            continue;
+          }
+          BLI_bvhtree_insert(tree, i, vert[i].co, 1);
         }
-        BLI_bvhtree_insert(tree, i, vert[i].co, 1);
       }
       BLI_assert(BLI_bvhtree_get_len(tree) == verts_num_active);
     }
@@ -846,15 +863,33 @@ static BVHTree *bvhtree_from_mesh_edges_create_tree(const MVert *vert,
     /* Create a BVH-tree of the given target */
     tree = BLI_bvhtree_new(edges_num_active, epsilon, tree_type, axis);
     if (tree) {
-      for (int i = 0; i < edge_num; i++) {
-        if (edges_mask && !BLI_BITMAP_TEST_BOOL(edges_mask, i)) {
-          continue;
-        }
-        float co[2][3];
-        copy_v3_v3(co[0], vert[edge[i].v1].co);
-        copy_v3_v3(co[1], vert[edge[i].v2].co);
+      if (edges_mask == nullptr) {
+        struct EdgeCoordsData {
+          const MVert *vert;
+          const MEdge *edge;
+        } data = {vert, edge};
+        BLI_bvhtree_insert_range(
+            tree,
+            edge_num,
+            2,
+            [](void *userdata, const int i, float(*r_co)[3]) {
+              const EdgeCoordsData &data = *static_cast<const EdgeCoordsData *>(userdata);
+              copy_v3_v3(r_co[0], data.vert[data.edge[i].v1].co);
+              copy_v3_v3(r_co[1], data.vert[data.edge[i].v2].co);
+            },
+            &data);
+      }
+      else {
+        for (int i = 0; i < edge_num; i++) {
+          if (!BLI_BITMAP_TEST_BOOL(edges_mask, i)) {
+            continue;
+          }
+          float co[2][3];
+          copy_v3_v3(co[0], vert[edge[i].v1].co);
+          copy_v3_v3(co[1], vert[edge[i].v2].co);
 
-        BLI_bvhtree_insert(tree, i, co[0], 2);
+          BLI_bvhtree_insert(tree, i, co[0], 2);
+        }
       }
     }
   }
@@ -1071,10 +1106,28 @@ static BVHTree *bvhtree_from_mesh_looptri_create_tree(float epsilon,
     // printf("%s: building BVH, total=%d\n", __func__, numFaces);
     tree = BLI_bvhtree_new(looptri_num_active, epsilon, tree_type, axis);
     if (tree) {
-      if (vert && looptri) {
+      if (vert && looptri && looptri_mask == nullptr) {
+        struct LooptriCoordsData {
+          const MVert *vert;
+          const MLoop *mloop;
+          const MLoopTri *looptri;
+        } data = {vert, mloop, looptri};
+        BLI_bvhtree_insert_range(
+            tree,
+            looptri_num,
+            3,
+            [](void *userdata, const int i, float(*r_co)[3]) {
+              const LooptriCoordsData &data = *static_cast<const LooptriCoordsData *>(userdata);
+              for (int j = 0; j < 3; j++) {
+                copy_v3_v3(r_co[j], data.vert[data.mloop[data.looptri[i].tri[j]].v].co);
+              }
+            },
+            &data);
+      }
+      else if (vert && looptri) {
         for (int i = 0; i < looptri_num; i++) {
           float co[3][3];
-          if (looptri_mask && !BLI_BITMAP_TEST_BOOL(looptri_mask, i)) {
+          if (!BLI_BITMAP_TEST_BOOL(looptri_mask, i)) {
             continue;
           }
 
@@ -1414,6 +1467,121 @@ BVHTree *BKE_bvhtree_from_editmesh_get(BVHTreeFromEditMesh *data,
   return data->tree;
 }
 
+/**
+ * Hash of the indices and positions of the elements enabled in \a mask.
+ */
+static uint32_t bvhtree_from_editmesh_mask_hash(BMEditMesh *em,
+                                                const BVHCacheType bvh_cache_type,
+                                                const BLI_bitmap *mask)
+{
+  BMesh *bm = em->bm;
+  BLI_HashMurmur2A mm2;
+  BLI_hash_mm2a_init(&mm2, 0);
+
+  switch (bvh_cache_type) {
+    case BVHTREE_FROM_EM_VERTS:
+      BM_mesh_elem_table_ensure(bm, BM_VERT);
+      for (int i = 0; i < bm->totvert; i++) {
+        if (BLI_BITMAP_TEST_BOOL(mask, i)) {
+          const BMVert *eve = BM_vert_at_index(bm, i);
+          BLI_hash_mm2a_add_int(&mm2, i);
+          BLI_hash_mm2a_add(&mm2, (const uchar *)eve->co, sizeof(eve->co));
+        }
+      }
+      break;
+    case BVHTREE_FROM_EM_EDGES:
+      BM_mesh_elem_table_ensure(bm, BM_EDGE);
+      for (int i = 0; i < bm->totedge; i++) {
+        if (BLI_BITMAP_TEST_BOOL(mask, i)) {
+          const BMEdge *eed = BM_edge_at_index(bm, i);
+          BLI_hash_mm2a_add_int(&mm2, i);
+          BLI_hash_mm2a_add(&mm2, (const uchar *)eed->v1->co, sizeof(eed->v1->co));
+          BLI_hash_mm2a_add(&mm2, (const uchar *)eed->v2->co, sizeof(eed->v2->co));
+        }
+      }
+      break;
+    case BVHTREE_FROM_EM_LOOPTRI:
+      for (int i = 0; i < em->tottri; i++) {
+        if (BLI_BITMAP_TEST_BOOL(mask, i)) {
+          BLI_hash_mm2a_add_int(&mm2, i);
+          for (int j = 0; j < 3; j++) {
+            const BMVert *eve = em->looptris[i][j]->v;
+            BLI_hash_mm2a_add(&mm2, (const uchar *)eve->co, sizeof(eve->co));
+          }
+        }
+      }
+      break;
+    default:
+      BLI_assert_unreachable();
+      break;
+  }
+  return BLI_hash_mm2a_end(&mm2);
+}
+
+BVHTree *BKE_bvhtree_from_editmesh_masked_get(BVHTreeFromEditMesh *data,
+                                              BMEditMesh *em,
+                                              const BLI_bitmap *mask,
+                                              const int elems_num_active,
+                                              const int tree_type,
+                                              const BVHCacheType bvh_cache_type)
+{
+  bvhtree_from_editmesh_setup_data(nullptr, bvh_cache_type, em, data);
+
+  /* Part of the key as well, so that the indices of a reused tree are in range. */
+  int elems_num = 0;
+  switch (bvh_cache_type) {
+    case BVHTREE_FROM_EM_VERTS:
+      elems_num = em->bm->totvert;
+      break;
+    case BVHTREE_FROM_EM_EDGES:
+      elems_num = em->bm->totedge;
+      break;
+    case BVHTREE_FROM_EM_LOOPTRI:
+      elems_num = em->tottri;
+      break;
+    default:
+      BLI_assert_unreachable();
+      return nullptr;
+  }
+  const uint32_t mask_hash = bvhtree_from_editmesh_mask_hash(em, bvh_cache_type, mask);
+
+  if (em->bvh_cache_masked == nullptr) {
+    em->bvh_cache_masked = bvhcache_init();
+  }
+  BVHCacheItem *item = &em->bvh_cache_masked->items[bvh_cache_type];
+  data->cached = true;
+  if (item->is_filled && item->mask_hash == mask_hash && item->elems_num == elems_num) {
+    data->tree = item->tree;
+    return data->tree;
+  }
+
+  BLI_bvhtree_free(item->tree);
+  item->tree = nullptr;
+  item->is_filled = false;
+
+  switch (bvh_cache_type) {
+    case BVHTREE_FROM_EM_VERTS:
+      data->tree = bvhtree_from_editmesh_verts_create_tree(
+          0.0f, tree_type, 6, em, mask, elems_num_active);
+      break;
+    case BVHTREE_FROM_EM_EDGES:
+      data->tree = bvhtree_from_editmesh_edges_create_tree(
+          0.0f, tree_type, 6, em, mask, elems_num_active);
+      break;
+    default:
+      data->tree = bvhtree_from_editmesh_looptri_create_tree(
+          0.0f, tree_type, 6, em, mask, elems_num_active);
+      break;
+  }
+  bvhtree_balance(data->tree, false);
+
+  bvhcache_insert(em->bvh_cache_masked, data->tree, bvh_cache_type);
+  item->mask_hash = mask_hash;
+  item->elems_num = elems_num;
+
+  return data->tree;
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -1454,9 +1622,15 @@ BVHTree *BKE_bvhtree_from_pointcloud_get(BVHTreeFromPointCloud *data,
     return nullptr;
   }
 
-  for (int i = 0; i < pointcloud->totpoint; i++) {
-    BLI_bvhtree_insert(tree, i, pointcloud->co[i], 1);
-  }
+  BLI_bvhtree_insert_range(
+      tree,
+      pointcloud->totpoint,
+      1,
+      [](void *userdata, const int i, float(*r_co)[3]) {
+        const float(*co)[3] = static_cast<const float(*)[3]>(userdata);
+        copy_v3_v3(r_co[0], co[i]);
+      },
+      pointcloud->co);
   BLI_assert(BLI_bvhtree_get_len(tree) == pointcloud->totpoint);
   bvhtree_balance(tree, false);
 
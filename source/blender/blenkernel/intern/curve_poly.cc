@@ -151,4 +151,14 @@ void calculate_normals_minimum(const Span<float3> tangents,
   }
 }
 
+void apply_tilt(const Span<float3> tangents, const Span<float> tilts, MutableSpan<float3> normals)
+{
+  BLI_assert(normals.size() == tangents.size());
+  BLI_assert(normals.size() == tilts.size());
+
+  for (const int i : normals.index_range()) {
+    normals[i] = rotate_direction_around_axis(normals[i], tangents[i], tilts[i]);
+  }
+}
+
 }  // namespace blender::bke::curves::poly
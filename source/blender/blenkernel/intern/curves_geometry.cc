@@ -22,6 +22,7 @@ namespace blender::bke {
 
 static const std::string ATTR_POSITION = "position";
 static const std::string ATTR_RADIUS = "radius";
+static const std::string ATTR_TILT = "tilt";
 static const std::string ATTR_CURVE_TYPE = "curve_type";
 static const std::string ATTR_CYCLIC = "cyclic";
 static const std::string ATTR_RESOLUTION = "resolution";
@@ -65,6 +66,67 @@ CurvesGeometry::CurvesGeometry(const int point_size, const int curve_size)
   this->runtime = MEM_new<CurvesGeometryRuntime>(__func__);
 }
 
+/**
+ * Copy the evaluated data that was already computed for the source curves, so that copies of the
+ * geometry made before changing only some of the data don't have to evaluate the curves again.
+ * The caches of the source may be computed concurrently, so their mutexes are locked to read them.
+ */
+static void copy_runtime_caches(CurvesGeometry &dst, const CurvesGeometry &src)
+{
+  const CurvesGeometryRuntime &src_runtime = *src.runtime;
+  CurvesGeometryRuntime &dst_runtime = *dst.runtime;
+  {
+    std::scoped_lock lock{src_runtime.offsets_cache_mutex};
+    if (!src_runtime.offsets_cache_dirty) {
+      dst_runtime.evaluated_offsets_cache = src_runtime.evaluated_offsets_cache;
+      dst_runtime.bezier_evaluated_offsets = src_runtime.bezier_evaluated_offsets;
+      dst_runtime.offsets_cache_dirty = false;
+    }
+  }
+  {
+    std::scoped_lock lock{src_runtime.nurbs_basis_cache_mutex};
+    if (!src_runtime.nurbs_basis_cache_dirty) {
+      dst_runtime.nurbs_basis_cache = src_runtime.nurbs_basis_cache;
+      dst_runtime.nurbs_basis_cache_dirty = false;
+    }
+  }
+  {
+    std::scoped_lock lock{src_runtime.position_cache_mutex};
+    if (!src_runtime.position_cache_dirty) {
+      if (src_runtime.evaluated_positions_span.data() == src.positions().data()) {
+        /* The evaluated positions of poly curves reference the positions directly. */
+        dst_runtime.evaluated_positions_span = dst.positions();
+      }
+      else {
+        dst_runtime.evaluated_position_cache = src_runtime.evaluated_position_cache;
+        dst_runtime.evaluated_positions_span = dst_runtime.evaluated_position_cache;
+      }
+      dst_runtime.position_cache_dirty = false;
+    }
+  }
+  {
+    std::scoped_lock lock{src_runtime.tangent_cache_mutex};
+    if (!src_runtime.tangent_cache_dirty) {
+      dst_runtime.evaluated_tangent_cache = src_runtime.evaluated_tangent_cache;
+      dst_runtime.tangent_cache_dirty = false;
+    }
+  }
+  {
+    std::scoped_lock lock{src_runtime.normal_cache_mutex};
+    if (!src_runtime.normal_cache_dirty) {
+      dst_runtime.evaluated_normal_cache = src_runtime.evaluated_normal_cache;
+      dst_runtime.normal_cache_dirty = false;
+    }
+  }
+  {
+    std::scoped_lock lock{src_runtime.length_cache_mutex};
+    if (!src_runtime.length_cache_dirty) {
+      dst_runtime.evaluated_length_cache = src_runtime.evaluated_length_cache;
+      dst_runtime.length_cache_dirty = false;
+    }
+  }
+}
+
 /**
  * \note Expects `dst` to be initialized, since the original attributes must be freed.
  */
@@ -84,6 +146,8 @@ static void copy_curves_geometry(CurvesGeometry &dst, const CurvesGeometry &src)
   dst.tag_topology_changed();
 
   dst.update_customdata_pointers();
+
+  copy_runtime_caches(dst, src);
 }
 
 CurvesGeometry::CurvesGeometry(const CurvesGeometry &other)
@@ -294,6 +358,24 @@ MutableSpan<float3> CurvesGeometry::positions_for_write()
   return {(float3 *)this->position, this->point_size};
 }
 
+VArray<float> CurvesGeometry::radii() const
+{
+  return get_varray_attribute<float>(*this, ATTR_DOMAIN_POINT, ATTR_RADIUS, 1.0f);
+}
+MutableSpan<float> CurvesGeometry::radii_for_write()
+{
+  return get_mutable_attribute<float>(*this, ATTR_DOMAIN_POINT, ATTR_RADIUS, 1.0f);
+}
+
+VArray<float> CurvesGeometry::tilts() const
+{
+  return get_varray_attribute<float>(*this, ATTR_DOMAIN_POINT, ATTR_TILT, 0.0f);
+}
+MutableSpan<float> CurvesGeometry::tilts_for_write()
+{
+  return get_mutable_attribute<float>(*this, ATTR_DOMAIN_POINT, ATTR_TILT, 0.0f);
+}
+
 Span<int> CurvesGeometry::offsets() const
 {
   return {this->curve_offsets, this->curve_size + 1};
@@ -697,6 +779,9 @@ Span<float3> CurvesGeometry::evaluated_tangents() const
 
       threading::parallel_for(bezier_mask.index_range(), 1024, [&](IndexRange range) {
         for (const int curve_index : bezier_mask.slice(range)) {
+          if (cyclic[curve_index]) {
+            continue;
+          }
           const IndexRange points = this->points_for_curve(curve_index);
           const IndexRange evaluated_points = this->evaluated_points_for_curve(curve_index);
 
@@ -733,11 +818,18 @@ Span<float3> CurvesGeometry::evaluated_normals() const
     const Span<float3> evaluated_tangents = this->evaluated_tangents();
     const VArray<bool> cyclic = this->cyclic();
     const VArray<int8_t> normal_mode = this->normal_mode();
+    const VArray<int8_t> types = this->curve_types();
+    const VArray<float> tilt = this->tilts();
+    const bool use_tilt = !(tilt.is_single() && tilt.get_internal_single() == 0.0f);
+    const VArray_Span<float> tilt_span{use_tilt ? tilt : VArray<float>::ForSpan({})};
 
     this->runtime->evaluated_normal_cache.resize(this->evaluated_points_num());
     MutableSpan<float3> evaluated_normals = this->runtime->evaluated_normal_cache;
 
     threading::parallel_for(this->curves_range(), 128, [&](IndexRange curves_range) {
+      /* Reuse a buffer for the evaluated tilts. */
+      Vector<float> evaluated_tilts;
+
       for (const int curve_index : curves_range) {
         const IndexRange evaluated_points = this->evaluated_points_for_curve(curve_index);
         if (UNLIKELY(evaluated_points.is_empty())) {
@@ -754,6 +846,26 @@ Span<float3> CurvesGeometry::evaluated_normals() const
                                                     evaluated_normals.slice(evaluated_points));
             break;
         }
+
+        /* If the "tilt" attribute exists, rotate the normals around the tangents by the
+         * evaluated angles. Poly curves don't need interpolation. */
+        if (use_tilt) {
+          const IndexRange points = this->points_for_curve(curve_index);
+          if (types[curve_index] == CURVE_TYPE_POLY) {
+            curves::poly::apply_tilt(evaluated_tangents.slice(evaluated_points),
+                                     tilt_span.slice(points),
+                                     evaluated_normals.slice(evaluated_points));
+          }
+          else {
+            evaluated_tilts.clear();
+            evaluated_tilts.resize(evaluated_points.size());
+            this->interpolate_to_evaluated(
+                curve_index, tilt_span.slice(points), evaluated_tilts.as_mutable_span());
+            curves::poly::apply_tilt(evaluated_tangents.slice(evaluated_points),
+                                     evaluated_tilts.as_span(),
+                                     evaluated_normals.slice(evaluated_points));
+          }
+        }
       }
     });
   });
@@ -63,6 +63,41 @@ TEST(curves_geometry, Move)
   EXPECT_EQ(second_other.offsets().data(), offsets_data);
 }
 
+TEST(curves_geometry, CopyEvaluatedCaches)
+{
+  CurvesGeometry curves(8, 2);
+  curves.offsets_for_write().copy_from({0, 4, 8});
+  MutableSpan<float3> positions = curves.positions_for_write();
+  for (const int i : positions.index_range()) {
+    positions[i] = {float(i), float(i % 3), 0.0f};
+  }
+
+  /* Evaluated positions of poly curves reference the positions of the copy. */
+  curves.evaluated_positions();
+  CurvesGeometry poly_copy(curves);
+  EXPECT_EQ(poly_copy.evaluated_positions().data(), poly_copy.positions().data());
+
+  curves.curve_types_for_write().fill(CURVE_TYPE_CATMULL_ROM);
+  curves.resolution_for_write().fill(4);
+  curves.tag_topology_changed();
+  const Span<float3> evaluated_positions = curves.evaluated_positions();
+  const Array<float3> evaluated_positions_copy(evaluated_positions);
+  curves.ensure_evaluated_lengths();
+
+  CurvesGeometry copy(curves);
+  EXPECT_EQ(copy.evaluated_positions(), evaluated_positions_copy.as_span());
+  EXPECT_EQ(copy.evaluated_lengths_for_curve(1, false),
+            curves.evaluated_lengths_for_curve(1, false));
+
+  /* Changing the positions of the copy doesn't affect the original. */
+  copy.translate({1.0f, 0.0f, 0.0f});
+  for (const int i : evaluated_positions.index_range()) {
+    const float3 expected = evaluated_positions_copy[i] + float3(1.0f, 0.0f, 0.0f);
+    EXPECT_V3_NEAR(copy.evaluated_positions()[i], expected, 1e-5f);
+  }
+  EXPECT_EQ(curves.evaluated_positions(), evaluated_positions_copy.as_span());
+}
+
 TEST(curves_geometry, TypeCount)
 {
   CurvesGeometry curves = create_basic_curves(100, 10);
@@ -8,6 +8,9 @@
  * BKE_customdata.h contains the function prototypes for this file.
  */
 
+#include <atomic>
+#include <mutex>
+
 #include "MEM_guardedalloc.h"
 
 /* Since we have versioning code here (CustomData_verify_versions()). */
@@ -16,10 +19,12 @@
 #include "DNA_ID.h"
 #include "DNA_customdata_types.h"
 #include "DNA_meshdata_types.h"
+#include "DNA_userdef_types.h"
 
 #include "BLI_bitmap.h"
 #include "BLI_color.hh"
 #include "BLI_endian_switch.h"
+#include "BLI_map.hh"
 #include "BLI_math.h"
 #include "BLI_math_color_blend.h"
 #include "BLI_math_vector.hh"
@@ -28,6 +33,7 @@
 #include "BLI_string.h"
 #include "BLI_string_utils.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #ifndef NDEBUG
 #  include "BLI_dynstr.h"
@@ -2167,11 +2173,216 @@ void customData_mask_layers__print(const CustomData_MeshMasks *mask)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Layer Array Pool
+ *
+ * With the "Recycle Mesh Data Arrays" experimental option, large freed layer arrays are kept and
+ * handed out again for layers of the same size. During playback every frame frees the evaluated
+ * meshes of the previous one and allocates arrays of the same sizes again, recycling them avoids
+ * the allocator and page fault overhead of large meshes.
+ * \{ */
+
+/** Smaller arrays are cheap to allocate. */
+static constexpr size_t LAYER_POOL_MIN_ARRAY_SIZE = 64 * 1024;
+/** Total size of the arrays kept for reuse. */
+static constexpr size_t LAYER_POOL_MAX_SIZE = 256 * 1024 * 1024;
+
+struct CustomDataLayerPool {
+  std::mutex mutex;
+  blender::Map<size_t, blender::Vector<void *>> arrays_by_size;
+  std::atomic<size_t> size = 0;
+};
+
+static CustomDataLayerPool *layer_pool = nullptr;
+static std::mutex layer_pool_create_mutex;
+
+static bool customData_layer_pool_is_enabled()
+{
+  return USER_EXPERIMENTAL_TEST(&U, use_customdata_pool);
+}
+
+static CustomDataLayerPool &customData_layer_pool_ensure()
+{
+  std::lock_guard lock{layer_pool_create_mutex};
+  if (layer_pool == nullptr) {
+    layer_pool = MEM_new<CustomDataLayerPool>(__func__);
+  }
+  return *layer_pool;
+}
+
+/**
+ * Allocate a layer array, reusing a freed array of the same size if possible.
+ */
+static void *customData_layer_array_alloc(const int type, const int totelem, const bool zero)
+{
+  const LayerTypeInfo *typeInfo = layerType_getInfo(type);
+  const size_t size = size_t(totelem) * size_t(typeInfo->size);
+  if (size >= LAYER_POOL_MIN_ARRAY_SIZE && customData_layer_pool_is_enabled()) {
+    CustomDataLayerPool &pool = customData_layer_pool_ensure();
+    void *data = nullptr;
+    {
+      std::lock_guard lock{pool.mutex};
+      blender::Vector<void *> *arrays = pool.arrays_by_size.lookup_ptr(size);
+      if (arrays != nullptr && !arrays->is_empty()) {
+        data = arrays->pop_last();
+        pool.size -= size;
+      }
+    }
+    if (data != nullptr) {
+      if (zero) {
+        memset(data, 0, size);
+      }
+      return data;
+    }
+  }
+  if (zero) {
+    return MEM_calloc_arrayN(size_t(totelem), typeInfo->size, layerType_getName(type));
+  }
+  return MEM_malloc_arrayN(size_t(totelem), typeInfo->size, layerType_getName(type));
+}
+
+/**
+ * Free a layer array or keep it for reuse. Arrays that don't belong to a layer anymore are
+ * passed here, other code may still free layer arrays with #MEM_freeN directly.
+ */
+static void customData_layer_array_free(void *data)
+{
+  const size_t size = MEM_allocN_len(data);
+  if (size >= LAYER_POOL_MIN_ARRAY_SIZE && customData_layer_pool_is_enabled()) {
+    CustomDataLayerPool &pool = customData_layer_pool_ensure();
+    std::lock_guard lock{pool.mutex};
+    if (pool.size + size <= LAYER_POOL_MAX_SIZE) {
+      pool.arrays_by_size.lookup_or_add_default(size).append(data);
+      pool.size += size;
+      return;
+    }
+  }
+  else if (layer_pool != nullptr && layer_pool->size > 0 && !customData_layer_pool_is_enabled()) {
+    /* The option has been disabled, don't keep the memory around. */
+    CustomData_layer_pool_clear();
+  }
+  MEM_freeN(data);
+}
+
+void CustomData_layer_pool_clear()
+{
+  if (layer_pool == nullptr) {
+    return;
+  }
+  std::lock_guard lock{layer_pool->mutex};
+  for (blender::Vector<void *> &arrays : layer_pool->arrays_by_size.values()) {
+    for (void *data : arrays) {
+      MEM_freeN(data);
+    }
+  }
+  layer_pool->arrays_by_size.clear();
+  layer_pool->size = 0;
+}
+
+void CustomData_layer_pool_free()
+{
+  CustomData_layer_pool_clear();
+  MEM_delete(layer_pool);
+  layer_pool = nullptr;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Shared Layer Data
+ *
+ * Layers copied with #CD_SHARE use the same data array as their source, avoiding a full copy
+ * for data that is often never modified (e.g. copy-on-write meshes in the depsgraph).
+ * A layer shared with other users is treated like a referenced layer: it has to be duplicated
+ * with #CustomData_duplicate_referenced_layer before it can be modified.
+ * \{ */
+
+struct CustomDataSharingInfo {
+  std::atomic<int> users;
+};
+
+static bool customData_layer_is_shared(const CustomDataLayer *layer)
+{
+  return layer->sharing_info != nullptr && layer->sharing_info->users > 1;
+}
+
+/**
+ * Add a user to the data of `layer`, which has to own its data.
+ */
+static CustomDataSharingInfo *customData_layer_share(CustomDataLayer *layer)
+{
+  BLI_assert(!(layer->flag & CD_FLAG_NOFREE));
+  if (layer->sharing_info == nullptr) {
+    layer->sharing_info = MEM_new<CustomDataSharingInfo>(__func__);
+    layer->sharing_info->users = 1;
+  }
+  layer->sharing_info->users++;
+  return layer->sharing_info;
+}
+
+/**
+ * Remove the user of `layer` from its data.
+ * \return True when `layer` was the last user, so that its data has to be freed.
+ */
+static bool customData_layer_unshare(CustomDataLayer *layer)
+{
+  CustomDataSharingInfo *sharing_info = layer->sharing_info;
+  if (sharing_info == nullptr) {
+    return true;
+  }
+  layer->sharing_info = nullptr;
+  if (--sharing_info->users > 0) {
+    return false;
+  }
+  MEM_delete(sharing_info);
+  return true;
+}
+
+/**
+ * Replace the data of `layer` without freeing the old data. The layer stops being a user of
+ * shared data, which stays alive for the other users.
+ */
+static void customData_layer_data_set(CustomDataLayer *layer, void *data)
+{
+  customData_layer_unshare(layer);
+  layer->data = data;
+}
+
+static void customData_layer_data_free(const int type, void *data, const int totelem)
+{
+  const LayerTypeInfo *typeInfo = layerType_getInfo(type);
+
+  if (typeInfo->free) {
+    typeInfo->free(data, totelem, typeInfo->size);
+  }
+
+  customData_layer_array_free(data);
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name CustomData Functions
  * \{ */
 
 static void customData_update_offsets(CustomData *data);
+static void *customData_duplicate_referenced_layer_index(CustomData *data,
+                                                         int layer_index,
+                                                         int totelem);
+
+/**
+ * Make a copy of shared layer data before it is modified in place, for callers that don't
+ * know the number of elements.
+ */
+static void customData_layer_ensure_unshared(CustomData *data, const int layer_index)
+{
+  CustomDataLayer *layer = &data->layers[layer_index];
+  if (customData_layer_is_shared(layer)) {
+    const LayerTypeInfo *typeInfo = layerType_getInfo(layer->type);
+    const int totelem = int(MEM_allocN_len(layer->data) / typeInfo->size);
+    customData_duplicate_referenced_layer_index(data, layer_index, totelem);
+  }
+}
 
 static CustomDataLayer *customData_add_layer__internal(CustomData *data,
                                                        int type,
@@ -2257,6 +2468,7 @@ bool CustomData_merge(const struct CustomData *source,
       case CD_ASSIGN:
       case CD_REFERENCE:
       case CD_DUPLICATE:
+      case CD_SHARE:
         data = layer->data;
         break;
       default:
@@ -2268,8 +2480,21 @@ bool CustomData_merge(const struct CustomData *source,
       newlayer = customData_add_layer__internal(
           dest, type, CD_REFERENCE, data, totelem, layer->name);
     }
+    else if (alloctype == CD_SHARE) {
+      /* Referenced data is owned by someone else, so it can't be shared. */
+      const bool use_share = data && !(flag & CD_FLAG_NOFREE);
+      newlayer = customData_add_layer__internal(
+          dest, type, use_share ? CD_ASSIGN : CD_DUPLICATE, data, totelem, layer->name);
+      if (newlayer && use_share && newlayer->data == data) {
+        newlayer->sharing_info = customData_layer_share(layer);
+      }
+    }
     else {
       newlayer = customData_add_layer__internal(dest, type, alloctype, data, totelem, layer->name);
+      if (newlayer && alloctype == CD_ASSIGN && newlayer->data == data) {
+        /* The ownership of the data is transferred, including its other users. */
+        newlayer->sharing_info = layer->sharing_info;
+      }
     }
 
     if (newlayer) {
@@ -2303,6 +2528,8 @@ void CustomData_realloc(CustomData *data, int totelem)
       continue;
     }
     typeInfo = layerType_getInfo(layer->type);
+    /* Other users keep the original array. */
+    customData_layer_ensure_unshared(data, i);
     /* Use calloc to avoid the need to manually initialize new data in layers.
      * Useful for types like #MDeformVert which contain a pointer. */
     layer->data = MEM_recallocN(layer->data, (size_t)totelem * typeInfo->size);
@@ -2326,21 +2553,13 @@ void CustomData_copy(const struct CustomData *source,
 
 static void customData_free_layer__internal(CustomDataLayer *layer, int totelem)
 {
-  const LayerTypeInfo *typeInfo;
-
   if (layer->anonymous_id != nullptr) {
     BKE_anonymous_attribute_id_decrement_weak(layer->anonymous_id);
     layer->anonymous_id = nullptr;
   }
   if (!(layer->flag & CD_FLAG_NOFREE) && layer->data) {
-    typeInfo = layerType_getInfo(layer->type);
-
-    if (typeInfo->free) {
-      typeInfo->free(layer->data, totelem, typeInfo->size);
-    }
-
-    if (layer->data) {
-      MEM_freeN(layer->data);
+    if (customData_layer_unshare(layer)) {
+      customData_layer_data_free(layer->type, layer->data, totelem);
     }
   }
 }
@@ -2661,12 +2880,8 @@ static CustomDataLayer *customData_add_layer__internal(CustomData *data,
     newlayerdata = layerdata;
   }
   else if (totelem > 0 && typeInfo->size > 0) {
-    if (alloctype == CD_DUPLICATE && layerdata) {
-      newlayerdata = MEM_malloc_arrayN((size_t)totelem, typeInfo->size, layerType_getName(type));
-    }
-    else {
-      newlayerdata = MEM_calloc_arrayN((size_t)totelem, typeInfo->size, layerType_getName(type));
-    }
+    newlayerdata = customData_layer_array_alloc(
+        type, totelem, !(alloctype == CD_DUPLICATE && layerdata));
 
     if (!newlayerdata) {
       return nullptr;
@@ -2933,12 +3148,13 @@ static void *customData_duplicate_referenced_layer_index(CustomData *data,
 
   CustomDataLayer *layer = &data->layers[layer_index];
 
-  if (layer->flag & CD_FLAG_NOFREE) {
+  if ((layer->flag & CD_FLAG_NOFREE) || customData_layer_is_shared(layer)) {
     /* MEM_dupallocN won't work in case of complex layers, like e.g.
      * CD_MDEFORMVERT, which has pointers to allocated data...
      * So in case a custom copy function is defined, use it!
      */
     const LayerTypeInfo *typeInfo = layerType_getInfo(layer->type);
+    void *src_data = layer->data;
 
     if (typeInfo->copy) {
       void *dst_data = MEM_malloc_arrayN(
@@ -2950,7 +3166,13 @@ static void *customData_duplicate_referenced_layer_index(CustomData *data,
       layer->data = MEM_dupallocN(layer->data);
     }
 
-    layer->flag &= ~CD_FLAG_NOFREE;
+    if (layer->flag & CD_FLAG_NOFREE) {
+      layer->flag &= ~CD_FLAG_NOFREE;
+    }
+    else if (customData_layer_unshare(layer)) {
+      /* The other users have been freed in the meantime. */
+      customData_layer_data_free(layer->type, src_data, totelem);
+    }
   }
 
   return layer->data;
@@ -3018,7 +3240,7 @@ bool CustomData_is_referenced_layer(struct CustomData *data, int type)
 
   CustomDataLayer *layer = &data->layers[layer_index];
 
-  return (layer->flag & CD_FLAG_NOFREE) != 0;
+  return (layer->flag & CD_FLAG_NOFREE) || customData_layer_is_shared(layer);
 }
 
 void CustomData_free_temporary(CustomData *data, int totelem)
@@ -3195,6 +3417,7 @@ void CustomData_free_elem(CustomData *data, int index, int count)
       if (typeInfo->free) {
         size_t offset = (size_t)index * typeInfo->size;
 
+        customData_layer_ensure_unshared(data, i);
         typeInfo->free(POINTER_OFFSET(data->layers[i].data, offset), count, typeInfo->size);
       }
     }
@@ -3440,7 +3663,7 @@ void *CustomData_set_layer(const CustomData *data, int type, void *ptr)
     return nullptr;
   }
 
-  data->layers[layer_index].data = ptr;
+  customData_layer_data_set(&data->layers[layer_index], ptr);
 
   return ptr;
 }
@@ -3453,7 +3676,7 @@ void *CustomData_set_layer_n(const struct CustomData *data, int type, int n, voi
     return nullptr;
   }
 
-  data->layers[layer_index].data = ptr;
+  customData_layer_data_set(&data->layers[layer_index], ptr);
 
   return ptr;
 }
@@ -4025,7 +4248,7 @@ bool CustomData_has_interp(const struct CustomData *data)
 bool CustomData_has_referenced(const struct CustomData *data)
 {
   for (int i = 0; i < data->totlayer; i++) {
-    if (data->layers[i].flag & CD_FLAG_NOFREE) {
+    if ((data->layers[i].flag & CD_FLAG_NOFREE) || customData_layer_is_shared(&data->layers[i])) {
       return true;
     }
   }
@@ -4379,7 +4602,10 @@ void CustomData_blend_write_prepare(CustomData *data,
         }
         write_layers_size += chunk_size;
       }
-      write_layers[j++] = *layer;
+      write_layers[j] = *layer;
+      /* Run-time only, avoids differences in undo steps when only the users changed. */
+      write_layers[j].sharing_info = nullptr;
+      j++;
     }
   }
   BLI_assert(j == data->totlayer);
@@ -5313,6 +5539,7 @@ void CustomData_blend_read(BlendDataReader *reader, CustomData *data, int count)
     }
 
     layer->flag &= ~CD_FLAG_NOFREE;
+    layer->sharing_info = nullptr;
 
     if (CustomData_verify_versions(data, i)) {
       BLO_read_data_address(reader, &layer->data);
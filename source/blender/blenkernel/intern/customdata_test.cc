@@ -0,0 +1,116 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BKE_customdata.h"
+
+#include "DNA_meshdata_types.h"
+
+namespace blender::bke::tests {
+
+static float *add_float_layer(CustomData *data, const int totelem)
+{
+  float *values = static_cast<float *>(
+      CustomData_add_layer(data, CD_PROP_FLOAT, CD_CALLOC, nullptr, totelem));
+  for (int i = 0; i < totelem; i++) {
+    values[i] = float(i);
+  }
+  return values;
+}
+
+TEST(customdata, ShareLayer)
+{
+  const int blocks_num = MEM_get_memory_blocks_in_use();
+
+  CustomData src, dst;
+  CustomData_reset(&src);
+  float *src_values = add_float_layer(&src, 4);
+  CustomData_copy(&src, &dst, CD_MASK_PROP_FLOAT, CD_SHARE, 4);
+
+  EXPECT_EQ(CustomData_get_layer(&dst, CD_PROP_FLOAT), src_values);
+  EXPECT_TRUE(CustomData_is_referenced_layer(&src, CD_PROP_FLOAT));
+  EXPECT_TRUE(CustomData_is_referenced_layer(&dst, CD_PROP_FLOAT));
+
+  /* Modifying the copy doesn't change the source. */
+  float *dst_values = static_cast<float *>(
+      CustomData_duplicate_referenced_layer(&dst, CD_PROP_FLOAT, 4));
+  EXPECT_NE(dst_values, src_values);
+  EXPECT_FALSE(CustomData_is_referenced_layer(&src, CD_PROP_FLOAT));
+  EXPECT_FALSE(CustomData_is_referenced_layer(&dst, CD_PROP_FLOAT));
+  dst_values[1] = 10.0f;
+  EXPECT_EQ(src_values[1], 1.0f);
+
+  CustomData_free(&src, 4);
+  CustomData_free(&dst, 4);
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_num);
+}
+
+TEST(customdata, ShareLayerFreeSource)
+{
+  const int blocks_num = MEM_get_memory_blocks_in_use();
+
+  CustomData src, dst;
+  CustomData_reset(&src);
+  float *src_values = add_float_layer(&src, 4);
+  CustomData_copy(&src, &dst, CD_MASK_PROP_FLOAT, CD_SHARE, 4);
+  CustomData_free(&src, 4);
+
+  /* The copy is the only user left, so it can modify the data without copying it. */
+  EXPECT_FALSE(CustomData_is_referenced_layer(&dst, CD_PROP_FLOAT));
+  EXPECT_EQ(CustomData_duplicate_referenced_layer(&dst, CD_PROP_FLOAT, 4), src_values);
+  EXPECT_EQ(src_values[3], 3.0f);
+
+  CustomData_free(&dst, 4);
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_num);
+}
+
+TEST(customdata, ShareLayerSetLayer)
+{
+  const int blocks_num = MEM_get_memory_blocks_in_use();
+
+  CustomData src, dst;
+  CustomData_reset(&src);
+  float *src_values = add_float_layer(&src, 4);
+  CustomData_copy(&src, &dst, CD_MASK_PROP_FLOAT, CD_SHARE, 4);
+
+  /* Replacing the data of the copy keeps the shared data alive for the source. */
+  float *new_values = static_cast<float *>(MEM_calloc_arrayN(4, sizeof(float), __func__));
+  EXPECT_EQ(CustomData_set_layer(&dst, CD_PROP_FLOAT, new_values), new_values);
+  EXPECT_FALSE(CustomData_is_referenced_layer(&src, CD_PROP_FLOAT));
+  EXPECT_FALSE(CustomData_is_referenced_layer(&dst, CD_PROP_FLOAT));
+  EXPECT_EQ(src_values[2], 2.0f);
+
+  CustomData_free(&src, 4);
+  CustomData_free(&dst, 4);
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_num);
+}
+
+TEST(customdata, ShareLayerFreeElem)
+{
+  const int blocks_num = MEM_get_memory_blocks_in_use();
+
+  CustomData src, dst;
+  CustomData_reset(&src);
+  MDeformVert *src_dverts = static_cast<MDeformVert *>(
+      CustomData_add_layer(&src, CD_MDEFORMVERT, CD_CALLOC, nullptr, 2));
+  for (int i = 0; i < 2; i++) {
+    src_dverts[i].dw = static_cast<MDeformWeight *>(MEM_callocN(sizeof(MDeformWeight), __func__));
+    src_dverts[i].dw->weight = 0.5f;
+    src_dverts[i].totweight = 1;
+  }
+  CustomData_copy(&src, &dst, CD_MASK_MDEFORMVERT, CD_SHARE, 2);
+
+  /* Freeing elements of the copy must not free the weights of the source. */
+  CustomData_free_elem(&dst, 1, 1);
+  EXPECT_NE(CustomData_get_layer(&dst, CD_MDEFORMVERT), src_dverts);
+  EXPECT_EQ(src_dverts[1].totweight, 1);
+  EXPECT_EQ(src_dverts[1].dw->weight, 0.5f);
+
+  CustomData_free(&src, 2);
+  CustomData_free(&dst, 2);
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_num);
+}
+
+}  // namespace blender::bke::tests
@@ -15,6 +15,7 @@
 #include "BLI_math.h"
 
 #include "BKE_DerivedMesh.h"
+#include "BKE_bvhutils.h"
 #include "BKE_editmesh.h"
 #include "BKE_editmesh_cache.h"
 #include "BKE_lib_id.h"
@@ -46,6 +47,7 @@ BMEditMesh *BKE_editmesh_copy(BMEditMesh *em)
    * in that case it makes more sense to do the
    * tessellation only when/if that copy ends up getting used. */
   em_copy->looptris = NULL;
+  em_copy->bvh_cache_masked = NULL;
 
   /* Copy various settings. */
   em_copy->selectmode = em->selectmode;
@@ -187,6 +189,11 @@ void BKE_editmesh_free_data(BMEditMesh *em)
   if (em->bm) {
     BM_mesh_free(em->bm);
   }
+
+  if (em->bvh_cache_masked) {
+    bvhcache_free(em->bvh_cache_masked);
+    em->bvh_cache_masked = NULL;
+  }
 }
 
 struct CageUserData {
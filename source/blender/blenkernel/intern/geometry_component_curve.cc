@@ -165,14 +165,16 @@ static void adapt_curve_domain_point_to_spline_impl(const CurveEval &curve,
   BLI_assert(r_values.size() == splines_len);
   attribute_math::DefaultMixer<T> mixer(r_values);
 
-  for (const int i_spline : IndexRange(splines_len)) {
-    const int spline_offset = offsets[i_spline];
-    const int spline_point_len = offsets[i_spline + 1] - spline_offset;
-    for (const int i_point : IndexRange(spline_point_len)) {
-      const T value = old_values[spline_offset + i_point];
-      mixer.mix_in(i_spline, value);
+  devirtualize_varray(old_values, [&](const auto old_values) {
+    for (const int i_spline : IndexRange(splines_len)) {
+      const int spline_offset = offsets[i_spline];
+      const int spline_point_len = offsets[i_spline + 1] - spline_offset;
+      for (const int i_point : IndexRange(spline_point_len)) {
+        const T value = old_values[spline_offset + i_point];
+        mixer.mix_in(i_spline, value);
+      }
     }
-  }
+  });
 
   mixer.finalize();
 }
@@ -195,17 +197,19 @@ void adapt_curve_domain_point_to_spline_impl(const CurveEval &curve,
 
   r_values.fill(true);
 
-  for (const int i_spline : IndexRange(splines_len)) {
-    const int spline_offset = offsets[i_spline];
-    const int spline_point_len = offsets[i_spline + 1] - spline_offset;
+  devirtualize_varray(old_values, [&](const auto old_values) {
+    for (const int i_spline : IndexRange(splines_len)) {
+      const int spline_offset = offsets[i_spline];
+      const int spline_point_len = offsets[i_spline + 1] - spline_offset;
 
-    for (const int i_point : IndexRange(spline_point_len)) {
-      if (!old_values[spline_offset + i_point]) {
-        r_values[i_spline] = false;
-        break;
+      for (const int i_point : IndexRange(spline_point_len)) {
+        if (!old_values[spline_offset + i_point]) {
+          r_values[i_spline] = false;
+          break;
+        }
       }
     }
-  }
+  });
 }
 
 static GVArray adapt_curve_domain_point_to_spline(const CurveEval &curve, GVArray varray)
@@ -0,0 +1,265 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bke
+ */
+
+#include <cmath>
+#include <mutex>
+
+#include "BLI_hash.hh"
+#include "BLI_map.hh"
+
+#include "DNA_curves_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_modifier_types.h"
+#include "DNA_object_types.h"
+#include "DNA_pointcloud_types.h"
+#include "DNA_userdef_types.h"
+
+#include "BKE_customdata.h"
+#include "BKE_geometry_frame_cache.hh"
+#include "BKE_lib_id.h"
+#include "BKE_modifier.h"
+#include "BKE_pointcache.h"
+
+#include "DEG_depsgraph.h"
+#include "DEG_depsgraph_query.h"
+
+namespace blender::bke {
+
+struct FrameCacheKey {
+  const Depsgraph *depsgraph;
+  uint session_uuid;
+  float frame;
+
+  uint64_t hash() const
+  {
+    return get_default_hash_3(depsgraph, session_uuid, frame);
+  }
+
+  friend bool operator==(const FrameCacheKey &a, const FrameCacheKey &b)
+  {
+    return a.depsgraph == b.depsgraph && a.session_uuid == b.session_uuid && a.frame == b.frame;
+  }
+};
+
+struct FrameCacheEntry {
+  /** Owned by the entry, freed with #frame_cache_entry_free. */
+  Mesh *mesh;
+  /** Result of the leading deform modifiers, owned by the entry as well. */
+  Mesh *mesh_deform;
+  /** Other components of the evaluated geometry. */
+  GeometrySet geometry_set;
+  CustomData_MeshMasks mask;
+  bool need_mapping;
+  /** Estimated memory usage in bytes. */
+  int64_t size;
+};
+
+struct FrameCache {
+  /** Lookups and additions happen from the threads evaluating the depsgraph. */
+  std::mutex mutex;
+  Map<FrameCacheKey, FrameCacheEntry> entries;
+  int64_t size = 0;
+};
+
+static FrameCache &get_frame_cache()
+{
+  static FrameCache cache;
+  return cache;
+}
+
+static int64_t customdata_size(const CustomData &data, const int totelem)
+{
+  int64_t size = 0;
+  for (const int i : IndexRange(data.totlayer)) {
+    size += int64_t(CustomData_sizeof(data.layers[i].type)) * totelem;
+  }
+  return size;
+}
+
+static int64_t mesh_size(const Mesh &mesh)
+{
+  return customdata_size(mesh.vdata, mesh.totvert) + customdata_size(mesh.edata, mesh.totedge) +
+         customdata_size(mesh.ldata, mesh.totloop) + customdata_size(mesh.pdata, mesh.totpoly);
+}
+
+static int64_t geometry_set_size(const GeometrySet &geometry_set)
+{
+  int64_t size = 0;
+  if (const PointCloud *pointcloud = geometry_set.get_pointcloud_for_read()) {
+    size += customdata_size(pointcloud->pdata, pointcloud->totpoint);
+  }
+  if (const Curves *curves = geometry_set.get_curves_for_read()) {
+    size += customdata_size(curves->geometry.point_data, curves->geometry.point_size) +
+            customdata_size(curves->geometry.curve_data, curves->geometry.curve_size) +
+            int64_t(curves->geometry.curve_size + 1) * sizeof(int);
+  }
+  if (const InstancesComponent *instances =
+          geometry_set.get_component_for_read<InstancesComponent>()) {
+    size += int64_t(instances->instances_amount()) * (sizeof(float4x4) + sizeof(int));
+  }
+  return size;
+}
+
+static void frame_cache_entry_free(FrameCache &cache, FrameCacheEntry &entry)
+{
+  BKE_id_free(nullptr, entry.mesh);
+  BKE_id_free(nullptr, entry.mesh_deform);
+  entry.mesh = nullptr;
+  entry.mesh_deform = nullptr;
+  cache.size -= entry.size;
+}
+
+/**
+ * Remove the entry furthest from `frame`, entries at `frame` itself are kept.
+ * \return False when nothing could be removed.
+ */
+static bool frame_cache_remove_furthest(FrameCache &cache, const float frame)
+{
+  const FrameCacheKey *furthest_key = nullptr;
+  float furthest_distance = 0.0f;
+  for (const FrameCacheKey &key : cache.entries.keys()) {
+    const float distance = std::abs(key.frame - frame);
+    if (distance > furthest_distance) {
+      furthest_key = &key;
+      furthest_distance = distance;
+    }
+  }
+  if (furthest_key == nullptr) {
+    return false;
+  }
+  const FrameCacheKey key = *furthest_key;
+  frame_cache_entry_free(cache, cache.entries.lookup(key));
+  cache.entries.remove(key);
+  return true;
+}
+
+static Mesh *frame_cache_mesh_copy(const Mesh *mesh)
+{
+  Mesh *mesh_copy = reinterpret_cast<Mesh *>(BKE_id_copy_ex(
+      nullptr, &mesh->id, nullptr, LIB_ID_COPY_LOCALIZE | LIB_ID_COPY_CD_SHARE));
+  mesh_copy->runtime.deformed_only = mesh->runtime.deformed_only;
+  return mesh_copy;
+}
+
+bool geometry_frame_cache_use(const Depsgraph *depsgraph, const Object *object)
+{
+  if (U.geometry_cache_limit <= 0 || !DEG_is_active(depsgraph)) {
+    return false;
+  }
+  if (object->mode != OB_MODE_OBJECT || object->particlesystem.first != nullptr) {
+    return false;
+  }
+  Object *object_mut = const_cast<Object *>(object);
+  if (BKE_ptcache_object_has(nullptr, object_mut, 0)) {
+    return false;
+  }
+  /* Both keep the geometry of the previous frame. */
+  if (BKE_modifiers_findby_type(object, eModifierType_Collision) != nullptr ||
+      BKE_modifiers_findby_type(object, eModifierType_Surface) != nullptr) {
+    return false;
+  }
+  /* Nothing worth caching without modifiers, also accounting for shape keys and deformation by
+   * the parent. */
+  VirtualModifierData virtual_modifier_data;
+  return BKE_modifiers_get_virtual_modifierlist(object, &virtual_modifier_data) != nullptr;
+}
+
+bool geometry_frame_cache_lookup(const Depsgraph *depsgraph,
+                                 const Object *object,
+                                 const CustomData_MeshMasks *mask,
+                                 const bool need_mapping,
+                                 Mesh **r_mesh_eval,
+                                 Mesh **r_mesh_deform_eval,
+                                 GeometrySet **r_geometry_set)
+{
+  FrameCache &cache = get_frame_cache();
+  const FrameCacheKey key{depsgraph, object->id.session_uuid, DEG_get_ctime(depsgraph)};
+
+  std::scoped_lock lock{cache.mutex};
+  const FrameCacheEntry *entry = cache.entries.lookup_ptr(key);
+  if (entry == nullptr) {
+    return false;
+  }
+  if (!CustomData_MeshMasks_are_matching(&entry->mask, mask) ||
+      (need_mapping && !entry->need_mapping)) {
+    return false;
+  }
+  *r_mesh_eval = frame_cache_mesh_copy(entry->mesh);
+  *r_mesh_deform_eval = frame_cache_mesh_copy(entry->mesh_deform);
+  *r_geometry_set = new GeometrySet(entry->geometry_set);
+  return true;
+}
+
+void geometry_frame_cache_add(const Depsgraph *depsgraph,
+                              const Object *object,
+                              const Mesh *mesh_eval,
+                              const Mesh *mesh_deform_eval,
+                              const GeometrySet &geometry_set,
+                              const CustomData_MeshMasks *mask,
+                              const bool need_mapping)
+{
+  if (geometry_set.has_volume()) {
+    /* Volume grids are not accounted for in the memory limit. */
+    return;
+  }
+  if (mesh_deform_eval == nullptr) {
+    /* Callers of #mesh_get_eval_deform expect the deformed mesh to exist. */
+    return;
+  }
+
+  GeometrySet geometry_set_copy = geometry_set;
+  geometry_set_copy.remove<MeshComponent>();
+  geometry_set_copy.ensure_owns_direct_data();
+
+  const int64_t size = mesh_size(*mesh_eval) + mesh_size(*mesh_deform_eval) +
+                       geometry_set_size(geometry_set_copy);
+  const int64_t limit = int64_t(U.geometry_cache_limit) * 1024 * 1024;
+  if (size > limit) {
+    return;
+  }
+
+  FrameCache &cache = get_frame_cache();
+  const FrameCacheKey key{depsgraph, object->id.session_uuid, DEG_get_ctime(depsgraph)};
+
+  std::scoped_lock lock{cache.mutex};
+  if (FrameCacheEntry *entry = cache.entries.lookup_ptr(key)) {
+    frame_cache_entry_free(cache, *entry);
+    cache.entries.remove(key);
+  }
+  while (cache.size + size > limit) {
+    if (!frame_cache_remove_furthest(cache, key.frame)) {
+      return;
+    }
+  }
+
+  FrameCacheEntry entry;
+  entry.mesh = frame_cache_mesh_copy(mesh_eval);
+  entry.mesh_deform = frame_cache_mesh_copy(mesh_deform_eval);
+  /* The shape key is owned by the evaluated object data, it is set again when restoring. */
+  entry.mesh->key = nullptr;
+  entry.mesh_deform->key = nullptr;
+  entry.geometry_set = std::move(geometry_set_copy);
+  entry.mask = *mask;
+  entry.need_mapping = need_mapping;
+  entry.size = size;
+  cache.entries.add_new(key, std::move(entry));
+  cache.size += size;
+}
+
+void geometry_frame_cache_clear(const Depsgraph *depsgraph)
+{
+  FrameCache &cache = get_frame_cache();
+  std::scoped_lock lock{cache.mutex};
+  for (auto it = cache.entries.items().begin(); it != cache.entries.items().end(); ++it) {
+    auto item = *it;
+    if (item.key.depsgraph == depsgraph) {
+      frame_cache_entry_free(cache, item.value);
+      cache.entries.remove(it);
+    }
+  }
+}
+
+}  // namespace blender::bke
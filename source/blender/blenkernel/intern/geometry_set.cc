@@ -37,7 +37,11 @@ using blender::Vector;
 /** \name Geometry Component
  * \{ */
 
-GeometryComponent::GeometryComponent(GeometryComponentType type) : type_(type)
+/* Zero is never used as version. */
+static std::atomic<uint64_t> next_component_version = 1;
+
+GeometryComponent::GeometryComponent(GeometryComponentType type)
+    : type_(type), version_(next_component_version.fetch_add(1, std::memory_order_relaxed))
 {
 }
 
@@ -84,6 +88,16 @@ GeometryComponentType GeometryComponent::type() const
   return type_;
 }
 
+uint64_t GeometryComponent::version() const
+{
+  return version_;
+}
+
+void GeometryComponent::tag_version_changed()
+{
+  version_ = next_component_version.fetch_add(1, std::memory_order_relaxed);
+}
+
 bool GeometryComponent::is_empty() const
 {
   return false;
@@ -111,7 +125,9 @@ GeometryComponent &GeometrySet::get_component_for_write(GeometryComponentType co
     return *component_ptr;
   }
   if (component_ptr->is_mutable()) {
-    /* If the referenced component is already mutable, return it directly. */
+    /* If the referenced component is already mutable, return it directly. It is expected to be
+     * modified by the caller. */
+    component_ptr->tag_version_changed();
     return *component_ptr;
   }
   /* If the referenced component is shared, make a copy. The copy is not shared and is
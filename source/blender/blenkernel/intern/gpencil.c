@@ -2844,6 +2844,8 @@ typedef struct tGPencilUpdateOnWriteTraverseData {
   int gpl_index;
   int gpf_index;
   int gps_index;
+  /** No layer or frame was copied, only strokes. */
+  bool strokes_only;
 } tGPencilUpdateOnWriteTraverseData;
 
 static bool gpencil_update_on_write_layer_cb(GPencilUpdateCache *gpl_cache, void *user_data)
@@ -2864,6 +2866,7 @@ static bool gpencil_update_on_write_layer_cb(GPencilUpdateCache *gpl_cache, void
 
     BKE_gpencil_layer_original_pointers_update(gpl, td->gpl_eval);
     td->gpl_eval->runtime.gpl_orig = gpl;
+    td->strokes_only = false;
     return true;
   }
   if (gpl_cache->flag == GP_UPDATE_NODE_LIGHT_COPY) {
@@ -2903,6 +2906,7 @@ static bool gpencil_update_on_write_frame_cb(GPencilUpdateCache *gpf_cache, void
     if (update_actframe) {
       td->gpl_eval->actframe = td->gpf_eval;
     }
+    td->strokes_only = false;
 
     return true;
   }
@@ -2947,11 +2951,13 @@ static bool gpencil_update_on_write_stroke_cb(GPencilUpdateCache *gps_cache, voi
       pt_eval->runtime.pt_orig = pt_orig;
       pt_eval->runtime.idx_orig = i;
     }
+    td->gps_eval->runtime.draw_dirty = true;
   }
   else if (gps_cache->flag == GP_UPDATE_NODE_LIGHT_COPY) {
     BLI_assert(gps != NULL);
     BKE_gpencil_stroke_copy_settings(gps, td->gps_eval);
     td->gps_eval->runtime.gps_orig = gps;
+    td->gps_eval->runtime.draw_dirty = true;
   }
 
   return false;
@@ -2990,10 +2996,17 @@ void BKE_gpencil_update_on_write(bGPdata *gpd_orig, bGPdata *gpd_eval)
       .gpl_index = 0,
       .gpf_index = 0,
       .gps_index = 0,
+      .strokes_only = true,
   };
 
   BKE_gpencil_traverse_update_cache(update_cache, &ts, &data);
 
+  /* Let the draw cache update the changed strokes only, unless it was already invalidated for
+   * another reason. */
+  const bool was_dirty = (gpd_eval->flag & GP_DATA_CACHE_IS_DIRTY) != 0;
+  gpd_eval->runtime.draw_dirty_strokes_only = data.strokes_only &&
+                                              (!was_dirty ||
+                                               gpd_eval->runtime.draw_dirty_strokes_only);
   gpd_eval->flag |= GP_DATA_CACHE_IS_DIRTY;
 
   /* TODO: This might cause issues when we have multiple depsgraphs? */
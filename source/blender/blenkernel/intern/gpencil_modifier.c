@@ -732,6 +732,9 @@ void BKE_gpencil_prepare_eval_data(Depsgraph *depsgraph, Scene *scene, Object *o
     return;
   }
 
+  /* Evaluated strokes are copied again below, the draw cache can't update them in place. */
+  ((bGPdata *)ob->data)->runtime.draw_dirty_strokes_only = false;
+
   /* If datablock has only one user, we can update its eval data directly.
    * Otherwise, we need to have distinct copies for each instance, since applied transformations
    * may differ. */
@@ -454,21 +454,37 @@ static GPUTexture *image_get_gpu_texture(Image *ima,
     const bool store_premultiplied = BKE_image_has_gpu_texture_premultiplied_alpha(ima,
                                                                                    ibuf_intern);
 
-    *tex = IMB_create_gpu_texture(
-        ima->id.name + 2, ibuf_intern, use_high_bitdepth, store_premultiplied, limit_resolution);
+    const bool use_compression = USER_EXPERIMENTAL_TEST(&U, use_gpu_texture_compression) &&
+                                 (ima->gpuflag & IMA_GPU_NO_COMPRESSION) == 0 &&
+                                 ibuf_intern->dds_data.data == nullptr;
+    if (use_compression) {
+      *tex = IMB_create_gpu_texture_compressed(
+          ima->id.name + 2, ibuf_intern, store_premultiplied, limit_resolution);
+    }
 
     if (*tex) {
+      /* All mipmap levels are stored in the compressed texture. */
       GPU_texture_wrap_mode(*tex, true, false);
+      GPU_texture_mipmap_mode(*tex, GPU_mipmap_enabled(), true);
+      ima->gpuflag |= IMA_GPU_MIPMAP_COMPLETE;
+    }
+    else {
+      *tex = IMB_create_gpu_texture(
+          ima->id.name + 2, ibuf_intern, use_high_bitdepth, store_premultiplied, limit_resolution);
 
-      if (GPU_mipmap_enabled()) {
-        GPU_texture_generate_mipmap(*tex);
-        if (ima) {
-          ima->gpuflag |= IMA_GPU_MIPMAP_COMPLETE;
+      if (*tex) {
+        GPU_texture_wrap_mode(*tex, true, false);
+
+        if (GPU_mipmap_enabled()) {
+          GPU_texture_generate_mipmap(*tex);
+          if (ima) {
+            ima->gpuflag |= IMA_GPU_MIPMAP_COMPLETE;
+          }
+          GPU_texture_mipmap_mode(*tex, true, true);
+        }
+        else {
+          GPU_texture_mipmap_mode(*tex, false, true);
         }
-        GPU_texture_mipmap_mode(*tex, true, true);
-      }
-      else {
-        GPU_texture_mipmap_mode(*tex, false, true);
       }
     }
   }
@@ -894,6 +910,16 @@ static void image_update_gputexture_ex(
     Image *ima, ImageTile *tile, ImBuf *ibuf, int x, int y, int w, int h)
 {
   const int eye = 0;
+  for (int resolution = 0; resolution < IMA_TEXTURE_RESOLUTION_LEN; resolution++) {
+    GPUTexture *tex = ima->gputexture[TEXTARGET_2D][eye][resolution];
+    if (tex != nullptr && GPU_texture_is_compressed(tex)) {
+      /* Compressed textures can't be updated, use uncompressed textures from now on. */
+      ima->gpuflag |= IMA_GPU_NO_COMPRESSION;
+      image_free_gpu(ima, true);
+      return;
+    }
+  }
+
   for (int resolution = 0; resolution < IMA_TEXTURE_RESOLUTION_LEN; resolution++) {
     GPUTexture *tex = ima->gputexture[TEXTARGET_2D][eye][resolution];
     eImageTextureResolution texture_resolution = static_cast<eImageTextureResolution>(resolution);
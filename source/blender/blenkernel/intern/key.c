@@ -15,6 +15,7 @@
 #include "BLI_endian_switch.h"
 #include "BLI_math_vector.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -609,8 +610,17 @@ static void rel_flerp(int tot, float *in, const float *ref, const float *out, fl
   }
 }
 
-static char *key_block_get_data(Key *key, KeyBlock *actkb, KeyBlock *kb, char **freedata)
+/**
+ * \param actkb_data: Optional data of the active key block that was already read from the
+ * BMesh by the caller, so that ranges evaluated in parallel don't copy it again.
+ */
+static char *key_block_get_data(
+    Key *key, KeyBlock *actkb, char *actkb_data, KeyBlock *kb, char **freedata)
 {
+  if (kb == actkb && actkb_data) {
+    *freedata = NULL;
+    return actkb_data;
+  }
   if (kb == actkb) {
     /* this hack makes it possible to edit shape keys in
      * edit mode with shape keys blending applied */
@@ -685,6 +695,7 @@ static void cp_key(const int start,
                    char *poin,
                    Key *key,
                    KeyBlock *actkb,
+                   char *actkb_data,
                    KeyBlock *kb,
                    float *weights,
                    const int mode)
@@ -716,8 +727,8 @@ static void cp_key(const int start,
     }
   }
 
-  k1 = key_block_get_data(key, actkb, kb, &freek1);
-  kref = key_block_get_data(key, actkb, key->refkey, &freekref);
+  k1 = key_block_get_data(key, actkb, actkb_data, kb, &freek1);
+  kref = key_block_get_data(key, actkb, actkb_data, key->refkey, &freekref);
 
   /* this exception is needed curves with multiple splines */
   if (start != 0) {
@@ -836,7 +847,7 @@ static void cp_cu_key(Curve *cu,
       a2 = min_ii(a + step, end);
 
       if (a1 < a2) {
-        cp_key(a1, a2, tot, out, key, actkb, kb, NULL, KEY_MODE_BPOINT);
+        cp_key(a1, a2, tot, out, key, actkb, NULL, kb, NULL, KEY_MODE_BPOINT);
       }
     }
     else if (nu->bezt) {
@@ -847,7 +858,7 @@ static void cp_cu_key(Curve *cu,
       a2 = min_ii(a + step, end);
 
       if (a1 < a2) {
-        cp_key(a1, a2, tot, out, key, actkb, kb, NULL, KEY_MODE_BEZTRIPLE);
+        cp_key(a1, a2, tot, out, key, actkb, NULL, kb, NULL, KEY_MODE_BEZTRIPLE);
       }
     }
     else {
@@ -862,6 +873,7 @@ static void key_evaluate_relative(const int start,
                                   char *basispoin,
                                   Key *key,
                                   KeyBlock *actkb,
+                                  char *actkb_data,
                                   float **per_keyblock_weights,
                                   const int mode)
 {
@@ -890,7 +902,7 @@ static void key_evaluate_relative(const int start,
   elemsize = key->elemsize * step;
 
   /* step 1 init */
-  cp_key(start, end, tot, basispoin, key, actkb, key->refkey, NULL, mode);
+  cp_key(start, end, tot, basispoin, key, actkb, actkb_data, key->refkey, NULL, mode);
 
   /* step 2: do it */
 
@@ -912,7 +924,7 @@ static void key_evaluate_relative(const int start,
         }
 
         poin = basispoin;
-        from = key_block_get_data(key, actkb, kb, &freefrom);
+        from = key_block_get_data(key, actkb, actkb_data, kb, &freefrom);
 
         /* For meshes, use the original values instead of the bmesh values to
          * maintain a constant offset. */
@@ -921,6 +933,9 @@ static void key_evaluate_relative(const int start,
         poin += start * poinsize;
         reffrom += key->elemsize * start; /* key elemsize yes! */
         from += key->elemsize * start;
+        if (weights) {
+          weights += start;
+        }
 
         for (b = start; b < end; b += step) {
 
@@ -1016,10 +1031,10 @@ static void do_key(const int start,
     end = tot;
   }
 
-  k1 = key_block_get_data(key, actkb, k[0], &freek1);
-  k2 = key_block_get_data(key, actkb, k[1], &freek2);
-  k3 = key_block_get_data(key, actkb, k[2], &freek3);
-  k4 = key_block_get_data(key, actkb, k[3], &freek4);
+  k1 = key_block_get_data(key, actkb, NULL, k[0], &freek1);
+  k2 = key_block_get_data(key, actkb, NULL, k[1], &freek2);
+  k3 = key_block_get_data(key, actkb, NULL, k[2], &freek3);
+  k4 = key_block_get_data(key, actkb, NULL, k[3], &freek4);
 
   /* Test for more or less points (per key!) */
   if (tot != k[0]->totelem) {
@@ -1376,6 +1391,38 @@ static void keyblock_free_per_block_weights(Key *key,
   MEM_freeN(per_keyblock_weights);
 }
 
+/**
+ * Grain size of the parallel evaluation in #do_mesh_key: number of vertices evaluated by each
+ * task. Meshes with fewer vertices are evaluated on the calling thread.
+ */
+#define KEY_EVALUATE_RELATIVE_GRAIN_SIZE 1024
+
+typedef struct KeyEvaluateRelativeData {
+  Key *key;
+  KeyBlock *actkb;
+  char *actkb_data;
+  float **per_keyblock_weights;
+  char *out;
+  int tot;
+} KeyEvaluateRelativeData;
+
+static void key_evaluate_relative_chunk_task(void *__restrict userdata,
+                                             const int chunk,
+                                             const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const KeyEvaluateRelativeData *data = userdata;
+  const int start = chunk * KEY_EVALUATE_RELATIVE_GRAIN_SIZE;
+  key_evaluate_relative(start,
+                        start + KEY_EVALUATE_RELATIVE_GRAIN_SIZE,
+                        data->tot,
+                        data->out,
+                        data->key,
+                        data->actkb,
+                        data->actkb_data,
+                        data->per_keyblock_weights,
+                        KEY_MODE_DUMMY);
+}
+
 static void do_mesh_key(Object *ob, Key *key, char *out, const int tot)
 {
   KeyBlock *k[4], *actkb = BKE_keyblock_from_object(ob);
@@ -1386,8 +1433,32 @@ static void do_mesh_key(Object *ob, Key *key, char *out, const int tot)
     WeightsArrayCache cache = {0, NULL};
     float **per_keyblock_weights;
     per_keyblock_weights = keyblock_get_per_block_weights(ob, key, &cache);
-    key_evaluate_relative(
-        0, tot, tot, (char *)out, key, actkb, per_keyblock_weights, KEY_MODE_DUMMY);
+
+    /* In edit mode the active key block is read from the BMesh. Do that once here instead of
+     * in every range, the ranges then only read shared data and write their own vertices. */
+    char *actkb_data = NULL;
+    if (actkb != NULL && key->from != NULL) {
+      key_block_get_data(key, actkb, NULL, actkb, &actkb_data);
+    }
+
+    KeyEvaluateRelativeData data = {
+        .key = key,
+        .actkb = actkb,
+        .actkb_data = actkb_data,
+        .per_keyblock_weights = per_keyblock_weights,
+        .out = out,
+        .tot = tot,
+    };
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (tot > KEY_EVALUATE_RELATIVE_GRAIN_SIZE);
+    const int chunks_num = (tot + KEY_EVALUATE_RELATIVE_GRAIN_SIZE - 1) /
+                           KEY_EVALUATE_RELATIVE_GRAIN_SIZE;
+    BLI_task_parallel_range(0, chunks_num, &data, key_evaluate_relative_chunk_task, &settings);
+
+    if (actkb_data) {
+      MEM_freeN(actkb_data);
+    }
     keyblock_free_per_block_weights(key, per_keyblock_weights, &cache);
   }
   else {
@@ -1399,7 +1470,7 @@ static void do_mesh_key(Object *ob, Key *key, char *out, const int tot)
       do_key(0, tot, tot, (char *)out, key, actkb, k, t, KEY_MODE_DUMMY);
     }
     else {
-      cp_key(0, tot, tot, (char *)out, key, actkb, k[2], NULL, KEY_MODE_DUMMY);
+      cp_key(0, tot, tot, (char *)out, key, actkb, NULL, k[2], NULL, KEY_MODE_DUMMY);
     }
   }
 }
@@ -1433,11 +1504,11 @@ static void do_rel_cu_key(Curve *cu, Key *key, KeyBlock *actkb, char *out, const
   for (a = 0, nu = cu->nurb.first; nu; nu = nu->next, a += step) {
     if (nu->bp) {
       step = KEYELEM_ELEM_LEN_BPOINT * nu->pntsu * nu->pntsv;
-      key_evaluate_relative(a, a + step, tot, out, key, actkb, NULL, KEY_MODE_BPOINT);
+      key_evaluate_relative(a, a + step, tot, out, key, actkb, NULL, NULL, KEY_MODE_BPOINT);
     }
     else if (nu->bezt) {
       step = KEYELEM_ELEM_LEN_BEZTRIPLE * nu->pntsu;
-      key_evaluate_relative(a, a + step, tot, out, key, actkb, NULL, KEY_MODE_BEZTRIPLE);
+      key_evaluate_relative(a, a + step, tot, out, key, actkb, NULL, NULL, KEY_MODE_BEZTRIPLE);
     }
     else {
       step = 0;
@@ -1480,7 +1551,7 @@ static void do_latt_key(Object *ob, Key *key, char *out, const int tot)
     float **per_keyblock_weights;
     per_keyblock_weights = keyblock_get_per_block_weights(ob, key, NULL);
     key_evaluate_relative(
-        0, tot, tot, (char *)out, key, actkb, per_keyblock_weights, KEY_MODE_DUMMY);
+        0, tot, tot, (char *)out, key, actkb, NULL, per_keyblock_weights, KEY_MODE_DUMMY);
     keyblock_free_per_block_weights(key, per_keyblock_weights, NULL);
   }
   else {
@@ -1492,7 +1563,7 @@ static void do_latt_key(Object *ob, Key *key, char *out, const int tot)
       do_key(0, tot, tot, (char *)out, key, actkb, k, t, KEY_MODE_DUMMY);
     }
     else {
-      cp_key(0, tot, tot, (char *)out, key, actkb, k[2], NULL, KEY_MODE_DUMMY);
+      cp_key(0, tot, tot, (char *)out, key, actkb, NULL, k[2], NULL, KEY_MODE_DUMMY);
     }
   }
 
@@ -1565,7 +1636,7 @@ float *BKE_key_evaluate_object_ex(Object *ob, int *r_totelem, float *arr, size_t
     if (OB_TYPE_SUPPORT_VGROUP(ob->type)) {
       float *weights = get_weights_array(ob, kb->vgroup, NULL);
 
-      cp_key(0, tot, tot, out, key, actkb, kb, weights, 0);
+      cp_key(0, tot, tot, out, key, actkb, NULL, kb, weights, 0);
 
       if (weights) {
         MEM_freeN(weights);
@@ -14,9 +14,11 @@
 #include "BLI_blenlib.h"
 #include "BLI_ghash.h"
 #include "BLI_mempool.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "DNA_ID.h"
+#include "DNA_userdef_types.h"
 
 #include "BKE_global.h"
 #include "BKE_idtype.h"
@@ -209,13 +211,11 @@ void BKE_main_unlock(struct Main *bmain)
   BLI_spin_unlock((SpinLock *)bmain->lock);
 }
 
-static int main_relations_create_idlink_cb(LibraryIDLinkCallbackData *cb_data)
+static void main_relations_add_link(MainIDRelations *bmain_relations,
+                                    ID *id_self,
+                                    ID **id_pointer,
+                                    const int cb_flag)
 {
-  MainIDRelations *bmain_relations = cb_data->user_data;
-  ID *id_self = cb_data->id_self;
-  ID **id_pointer = cb_data->id_pointer;
-  const int cb_flag = cb_data->cb_flag;
-
   if (*id_pointer) {
     MainIDRelationsEntry **entry_p;
 
@@ -257,10 +257,110 @@ static int main_relations_create_idlink_cb(LibraryIDLinkCallbackData *cb_data)
       (*entry_p)->from_ids = from_id_entry;
     }
   }
+}
 
+static int main_relations_create_idlink_cb(LibraryIDLinkCallbackData *cb_data)
+{
+  main_relations_add_link(
+      cb_data->user_data, cb_data->id_self, cb_data->id_pointer, cb_data->cb_flag);
+  return IDWALK_RET_NOP;
+}
+
+/* Below this amount of IDs, building the relations from multiple threads is not worth it. */
+#define MAIN_RELATIONS_PARALLEL_MIN_IDS 1024
+
+/** ID pointers used by one ID, gathered from a worker thread. */
+typedef struct MainRelationsIDLinks {
+  struct MainRelationsIDLink {
+    ID *id_self;
+    ID **id_pointer;
+    int cb_flag;
+  } * links;
+  int links_num;
+  int links_num_alloc;
+} MainRelationsIDLinks;
+
+static int main_relations_gather_idlink_cb(LibraryIDLinkCallbackData *cb_data)
+{
+  if (*cb_data->id_pointer == NULL) {
+    return IDWALK_RET_NOP;
+  }
+  MainRelationsIDLinks *id_links = cb_data->user_data;
+  if (id_links->links_num == id_links->links_num_alloc) {
+    id_links->links_num_alloc = id_links->links_num_alloc ? id_links->links_num_alloc * 2 : 16;
+    id_links->links = MEM_reallocN(id_links->links,
+                                   sizeof(*id_links->links) * (size_t)id_links->links_num_alloc);
+  }
+  struct MainRelationsIDLink *link = &id_links->links[id_links->links_num++];
+  link->id_self = cb_data->id_self;
+  link->id_pointer = cb_data->id_pointer;
+  link->cb_flag = cb_data->cb_flag;
   return IDWALK_RET_NOP;
 }
 
+typedef struct MainRelationsGatherData {
+  ID **ids;
+  MainRelationsIDLinks *ids_links;
+  int idwalk_flag;
+} MainRelationsGatherData;
+
+static void main_relations_gather_task(void *__restrict userdata,
+                                       const int i,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  MainRelationsGatherData *data = userdata;
+  BKE_library_foreach_ID_link(
+      NULL, data->ids[i], main_relations_gather_idlink_cb, &data->ids_links[i], data->idwalk_flag);
+}
+
+/**
+ * Walk the ID pointers of all IDs in parallel, then add the relations in the same order as the
+ * serial code does, so that the resulting lists are identical. Only the #GHash and the
+ * #BLI_mempool insertions remain serial.
+ */
+static void main_relations_create_parallel(Main *bmain, const int ids_num, const int idwalk_flag)
+{
+  MainRelationsGatherData data;
+  data.ids = MEM_malloc_arrayN((size_t)ids_num, sizeof(*data.ids), __func__);
+  data.ids_links = MEM_calloc_arrayN((size_t)ids_num, sizeof(*data.ids_links), __func__);
+  data.idwalk_flag = idwalk_flag;
+
+  int i = 0;
+  ID *id;
+  FOREACH_MAIN_ID_BEGIN (bmain, id) {
+    data.ids[i++] = id;
+  }
+  FOREACH_MAIN_ID_END;
+  BLI_assert(i == ids_num);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 64;
+  BLI_task_parallel_range(0, ids_num, &data, main_relations_gather_task, &settings);
+
+  for (i = 0; i < ids_num; i++) {
+    id = data.ids[i];
+    MainIDRelationsEntry **entry_p;
+    if (!BLI_ghash_ensure_p(bmain->relations->relations_from_pointers, id, (void ***)&entry_p)) {
+      *entry_p = MEM_callocN(sizeof(**entry_p), __func__);
+      (*entry_p)->session_uuid = id->session_uuid;
+    }
+    else {
+      BLI_assert((*entry_p)->session_uuid == id->session_uuid);
+    }
+
+    MainRelationsIDLinks *id_links = &data.ids_links[i];
+    for (int j = 0; j < id_links->links_num; j++) {
+      const struct MainRelationsIDLink *link = &id_links->links[j];
+      main_relations_add_link(bmain->relations, link->id_self, link->id_pointer, link->cb_flag);
+    }
+    MEM_SAFE_FREE(id_links->links);
+  }
+
+  MEM_freeN(data.ids_links);
+  MEM_freeN(data.ids);
+}
+
 void BKE_main_relations_create(Main *bmain, const short flag)
 {
   if (bmain->relations != NULL) {
@@ -275,11 +375,24 @@ void BKE_main_relations_create(Main *bmain, const short flag)
 
   bmain->relations->flag = flag;
 
+  const int idwalk_flag = IDWALK_READONLY |
+                          ((flag & MAINIDRELATIONS_INCLUDE_UI) != 0 ? IDWALK_INCLUDE_UI : 0);
+
+  if (USER_EXPERIMENTAL_TEST(&U, use_parallel_main_relations)) {
+    int ids_num = 0;
+    ID *id;
+    FOREACH_MAIN_ID_BEGIN (bmain, id) {
+      ids_num++;
+    }
+    FOREACH_MAIN_ID_END;
+    if (ids_num >= MAIN_RELATIONS_PARALLEL_MIN_IDS) {
+      main_relations_create_parallel(bmain, ids_num, idwalk_flag);
+      return;
+    }
+  }
+
   ID *id;
   FOREACH_MAIN_ID_BEGIN (bmain, id) {
-    const int idwalk_flag = IDWALK_READONLY |
-                            ((flag & MAINIDRELATIONS_INCLUDE_UI) != 0 ? IDWALK_INCLUDE_UI : 0);
-
     /* Ensure all IDs do have an entry, even if they are not connected to any other. */
     MainIDRelationsEntry **entry_p;
     if (!BLI_ghash_ensure_p(bmain->relations->relations_from_pointers, id, (void ***)&entry_p)) {
@@ -39,7 +39,7 @@
 #include "BKE_mesh_runtime.h"
 #include "BKE_mesh_wrapper.h"
 #include "BKE_modifier.h"
-#include "BKE_spline.hh"
+#include "BKE_curves.hh"
 /* these 2 are only used by conversion functions */
 #include "BKE_curve.h"
 /* -- */
@@ -970,8 +970,7 @@ static Mesh *mesh_new_from_evaluated_curve_type_object(const Object *evaluated_o
   }
   const Curves *curves = get_evaluated_curves_from_object(evaluated_object);
   if (curves) {
-    std::unique_ptr<CurveEval> curve = curves_to_curve_eval(*curves);
-    return blender::bke::curve_to_wire_mesh(*curve);
+    return blender::bke::curve_to_wire_mesh(blender::bke::CurvesGeometry::wrap(curves->geometry));
   }
   return nullptr;
 }
@@ -1552,6 +1551,11 @@ void BKE_mesh_nomain_to_mesh(Mesh *mesh_src,
   if (CustomData_has_layer(&mesh_dst->ldata, CD_MDISPS)) {
     if (totloop == mesh_dst->totloop) {
       MDisps *mdisps = (MDisps *)CustomData_get_layer(&mesh_dst->ldata, CD_MDISPS);
+      if (alloctype == CD_ASSIGN) {
+        /* Data shared with other meshes can't be moved, they still use it. */
+        mdisps = (MDisps *)CustomData_duplicate_referenced_layer(
+            &mesh_dst->ldata, CD_MDISPS, totloop);
+      }
       CustomData_add_layer(&tmp.ldata, CD_MDISPS, alloctype, mdisps, totloop);
       if (alloctype == CD_ASSIGN) {
         /* Assign nullptr to prevent double-free. */
@@ -37,6 +37,7 @@
 
 #include "atomic_ops.h"
 
+using blender::IndexRange;
 using blender::Span;
 
 // #define DEBUG_TIME
@@ -169,24 +170,6 @@ void BKE_mesh_assert_normals_dirty_or_calculated(const Mesh *mesh)
 /** \name Mesh Normal Calculation (Polygons)
  * \{ */
 
-struct MeshCalcNormalsData_Poly {
-  const MVert *mvert;
-  const MLoop *mloop;
-  const MPoly *mpoly;
-
-  /** Polygon normal output. */
-  float (*pnors)[3];
-};
-
-static void mesh_calc_normals_poly_fn(void *__restrict userdata,
-                                      const int pidx,
-                                      const TaskParallelTLS *__restrict UNUSED(tls))
-{
-  const MeshCalcNormalsData_Poly *data = (MeshCalcNormalsData_Poly *)userdata;
-  const MPoly *mp = &data->mpoly[pidx];
-  BKE_mesh_calc_poly_normal(mp, data->mloop + mp->loopstart, data->mvert, data->pnors[pidx]);
-}
-
 void BKE_mesh_calc_normals_poly(const MVert *mvert,
                                 int UNUSED(mvert_len),
                                 const MLoop *mloop,
@@ -195,19 +178,16 @@ void BKE_mesh_calc_normals_poly(const MVert *mvert,
                                 int mpoly_len,
                                 float (*r_poly_normals)[3])
 {
-  TaskParallelSettings settings;
-  BLI_parallel_range_settings_defaults(&settings);
-  settings.min_iter_per_thread = 1024;
-
   BLI_assert((r_poly_normals != nullptr) || (mpoly_len == 0));
 
-  MeshCalcNormalsData_Poly data = {};
-  data.mpoly = mpoly;
-  data.mloop = mloop;
-  data.mvert = mvert;
-  data.pnors = r_poly_normals;
-
-  BLI_task_parallel_range(0, mpoly_len, &data, mesh_calc_normals_poly_fn, &settings);
+  static blender::threading::AdaptiveGrainSize grain_size("mesh_calc_normals_poly", 1024);
+  blender::threading::parallel_for(
+      IndexRange(mpoly_len), grain_size, [&](const IndexRange range) {
+        for (const int i : range) {
+          const MPoly *mp = &mpoly[i];
+          BKE_mesh_calc_poly_normal(mp, mloop + mp->loopstart, mvert, r_poly_normals[i]);
+        }
+      });
 }
 
 /** \} */
@@ -315,10 +295,6 @@ void BKE_mesh_calc_normals_poly_and_vertex(const MVert *mvert,
                                            float (*r_poly_normals)[3],
                                            float (*r_vert_normals)[3])
 {
-  TaskParallelSettings settings;
-  BLI_parallel_range_settings_defaults(&settings);
-  settings.min_iter_per_thread = 1024;
-
   memset(r_vert_normals, 0, sizeof(*r_vert_normals) * (size_t)mvert_len);
 
   MeshCalcNormalsData_PolyAndVertex data = {};
@@ -329,12 +305,24 @@ void BKE_mesh_calc_normals_poly_and_vertex(const MVert *mvert,
   data.vnors = r_vert_normals;
 
   /* Compute poly normals, accumulating them into vertex normals. */
-  BLI_task_parallel_range(
-      0, mpoly_len, &data, mesh_calc_normals_poly_and_vertex_accum_fn, &settings);
+  static blender::threading::AdaptiveGrainSize accum_grain_size(
+      "mesh_calc_normals_poly_and_vertex_accum", 1024);
+  blender::threading::parallel_for(
+      IndexRange(mpoly_len), accum_grain_size, [&](const IndexRange range) {
+        for (const int i : range) {
+          mesh_calc_normals_poly_and_vertex_accum_fn(&data, i, nullptr);
+        }
+      });
 
   /* Normalize and validate computed vertex normals. */
-  BLI_task_parallel_range(
-      0, mvert_len, &data, mesh_calc_normals_poly_and_vertex_finalize_fn, &settings);
+  static blender::threading::AdaptiveGrainSize finalize_grain_size(
+      "mesh_calc_normals_poly_and_vertex_finalize", 1024);
+  blender::threading::parallel_for(
+      IndexRange(mvert_len), finalize_grain_size, [&](const IndexRange range) {
+        for (const int i : range) {
+          mesh_calc_normals_poly_and_vertex_finalize_fn(&data, i, nullptr);
+        }
+      });
 }
 
 /** \} */
@@ -32,6 +32,7 @@
 #include "BKE_mesh_mapping.h"
 #include "BKE_mesh_remesh_voxel.h" /* own include */
 #include "BKE_mesh_runtime.h"
+#include "BKE_volume_to_mesh.hh"
 
 #include "bmesh_tools.h"
 
@@ -184,31 +185,59 @@ Mesh *BKE_mesh_remesh_quadriflow(const Mesh *mesh,
 }
 
 #ifdef WITH_OPENVDB
-static openvdb::FloatGrid::Ptr remesh_voxel_level_set_create(const Mesh *mesh,
-                                                             const float voxel_size)
-{
-  Span<MLoop> mloop{mesh->mloop, mesh->totloop};
-  Span<MLoopTri> looptris{BKE_mesh_runtime_looptri_ensure(mesh),
-                          BKE_mesh_runtime_looptri_len(mesh)};
+/**
+ * Give OpenVDB access to the triangles of the mesh without copying them, following its
+ * MeshDataAdapter interface.
+ */
+class RemeshVoxelMeshAdapter {
+ private:
+  Span<MVert> verts_;
+  Span<MLoop> loops_;
+  Span<MLoopTri> looptris_;
+  const openvdb::math::Transform &transform_;
+
+ public:
+  RemeshVoxelMeshAdapter(const Mesh &mesh, const openvdb::math::Transform &transform)
+      : verts_(mesh.mvert, mesh.totvert),
+        loops_(mesh.mloop, mesh.totloop),
+        looptris_(BKE_mesh_runtime_looptri_ensure(&mesh), BKE_mesh_runtime_looptri_len(&mesh)),
+        transform_(transform)
+  {
+  }
 
-  std::vector<openvdb::Vec3s> points(mesh->totvert);
-  std::vector<openvdb::Vec3I> triangles(looptris.size());
+  size_t polygonCount() const
+  {
+    return size_t(looptris_.size());
+  }
 
-  for (const int i : IndexRange(mesh->totvert)) {
-    const float3 co = mesh->mvert[i].co;
-    points[i] = openvdb::Vec3s(co.x, co.y, co.z);
+  size_t pointCount() const
+  {
+    return size_t(verts_.size());
   }
 
-  for (const int i : IndexRange(looptris.size())) {
-    const MLoopTri &loop_tri = looptris[i];
-    triangles[i] = openvdb::Vec3I(
-        mloop[loop_tri.tri[0]].v, mloop[loop_tri.tri[1]].v, mloop[loop_tri.tri[2]].v);
+  size_t vertexCount(size_t UNUSED(polygon_index)) const
+  {
+    return 3;
   }
 
+  void getIndexSpacePoint(size_t polygon_index, size_t vertex_index, openvdb::Vec3d &pos) const
+  {
+    const MLoopTri &looptri = looptris_[polygon_index];
+    const float3 co = verts_[loops_[looptri.tri[vertex_index]].v].co;
+    pos = transform_.worldToIndex(openvdb::Vec3d(co.x, co.y, co.z));
+  }
+};
+
+static openvdb::FloatGrid::Ptr remesh_voxel_level_set_create(const Mesh *mesh,
+                                                             const float voxel_size)
+{
   openvdb::math::Transform::Ptr transform = openvdb::math::Transform::createLinearTransform(
       voxel_size);
-  openvdb::FloatGrid::Ptr grid = openvdb::tools::meshToLevelSet<openvdb::FloatGrid>(
-      *transform, points, triangles, 1.0f);
+  /* The voxelization is multi-threaded by OpenVDB, reading the mesh directly avoids the copies of
+   * the positions and triangles. */
+  const RemeshVoxelMeshAdapter mesh_adapter{*mesh, *transform};
+  openvdb::FloatGrid::Ptr grid = openvdb::tools::meshToVolume<openvdb::FloatGrid>(
+      mesh_adapter, *transform, 1.0f, 1.0f);
 
   return grid;
 }
@@ -226,35 +255,15 @@ static Mesh *remesh_voxel_volume_to_mesh(const openvdb::FloatGrid::Ptr level_set
 
   Mesh *mesh = BKE_mesh_new_nomain(
       vertices.size(), 0, 0, quads.size() * 4 + tris.size() * 3, quads.size() + tris.size());
-  MutableSpan<MVert> mverts{mesh->mvert, mesh->totvert};
-  MutableSpan<MLoop> mloops{mesh->mloop, mesh->totloop};
-  MutableSpan<MPoly> mpolys{mesh->mpoly, mesh->totpoly};
-
-  for (const int i : mverts.index_range()) {
-    copy_v3_v3(mverts[i].co, float3(vertices[i].x(), vertices[i].y(), vertices[i].z()));
-  }
-
-  for (const int i : IndexRange(quads.size())) {
-    MPoly &poly = mpolys[i];
-    const int loopstart = i * 4;
-    poly.loopstart = loopstart;
-    poly.totloop = 4;
-    mloops[loopstart].v = quads[i][0];
-    mloops[loopstart + 1].v = quads[i][3];
-    mloops[loopstart + 2].v = quads[i][2];
-    mloops[loopstart + 3].v = quads[i][1];
-  }
-
-  const int triangle_loop_start = quads.size() * 4;
-  for (const int i : IndexRange(tris.size())) {
-    MPoly &poly = mpolys[quads.size() + i];
-    const int loopstart = triangle_loop_start + i * 3;
-    poly.loopstart = loopstart;
-    poly.totloop = 3;
-    mloops[loopstart].v = tris[i][2];
-    mloops[loopstart + 1].v = tris[i][1];
-    mloops[loopstart + 2].v = tris[i][0];
-  }
+  blender::bke::fill_mesh_from_openvdb_data(vertices,
+                                            tris,
+                                            quads,
+                                            0,
+                                            0,
+                                            0,
+                                            {mesh->mvert, mesh->totvert},
+                                            {mesh->mpoly, mesh->totpoly},
+                                            {mesh->mloop, mesh->totloop});
 
   BKE_mesh_calc_edges(mesh, false, false);
   BKE_mesh_normals_tag_dirty(mesh);
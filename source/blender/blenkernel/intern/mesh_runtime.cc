@@ -91,6 +91,7 @@ void BKE_mesh_runtime_reset_on_copy(Mesh *mesh, const int UNUSED(flag))
   runtime->poly_normals_dirty = true;
   runtime->vert_normals = nullptr;
   runtime->poly_normals = nullptr;
+  runtime->topology_version = 0;
 
   mesh_runtime_init_mutexes(mesh);
 }
@@ -254,6 +255,33 @@ void BKE_mesh_runtime_clear_geometry(Mesh *mesh)
     mesh->runtime.subdiv_ccg = nullptr;
   }
   BKE_shrinkwrap_discard_boundary_data(mesh);
+  mesh->runtime.topology_version = 0;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Topology Version
+ * \{ */
+
+/** Source of unique topology versions, zero is reserved for "not assigned". */
+static uint32_t mesh_topology_version_counter = 0;
+
+unsigned int BKE_mesh_topology_version_ensure(const Mesh *mesh)
+{
+  uint32_t *version = const_cast<uint32_t *>(&mesh->runtime.topology_version);
+  const uint32_t current = *version;
+  if (current != 0) {
+    return current;
+  }
+  uint32_t new_version = atomic_add_and_fetch_uint32(&mesh_topology_version_counter, 1);
+  if (new_version == 0) {
+    /* Skip the reserved value on wrap-around. */
+    new_version = atomic_add_and_fetch_uint32(&mesh_topology_version_counter, 1);
+  }
+  /* Another thread may have assigned a version in the meantime, keep that one. */
+  const uint32_t old_version = atomic_cas_uint32(version, 0, new_version);
+  return old_version == 0 ? new_version : old_version;
 }
 
 /** \} */
@@ -265,6 +293,8 @@ void BKE_mesh_runtime_clear_geometry(Mesh *mesh)
 /* Draw Engine */
 void (*BKE_mesh_batch_cache_dirty_tag_cb)(Mesh *me, eMeshBatchDirtyMode mode) = nullptr;
 void (*BKE_mesh_batch_cache_free_cb)(Mesh *me) = nullptr;
+void *(*BKE_mesh_batch_cache_stash_cb)(Mesh *me, bool is_deform_only) = nullptr;
+void (*BKE_mesh_batch_cache_stash_free_cb)(void *batch_cache) = nullptr;
 
 void BKE_mesh_batch_cache_dirty_tag(Mesh *me, eMeshBatchDirtyMode mode)
 {
@@ -278,6 +308,19 @@ void BKE_mesh_batch_cache_free(Mesh *me)
     BKE_mesh_batch_cache_free_cb(me);
   }
 }
+void *BKE_mesh_batch_cache_stash(Mesh *me, bool is_deform_only)
+{
+  if (me->runtime.batch_cache) {
+    return BKE_mesh_batch_cache_stash_cb(me, is_deform_only);
+  }
+  return nullptr;
+}
+void BKE_mesh_batch_cache_stash_free(void *batch_cache)
+{
+  if (batch_cache) {
+    BKE_mesh_batch_cache_stash_free_cb(batch_cache);
+  }
+}
 
 /** \} */
 
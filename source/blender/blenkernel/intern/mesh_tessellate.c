@@ -30,6 +30,8 @@
 
 /** Compared against total loops. */
 #define MESH_FACE_TESSELLATE_THREADED_LIMIT 4096
+/** Approximate number of loops handled by one task of the multi-threaded tessellation. */
+#define MESH_FACE_TESSELLATE_LOOPS_PER_TASK 1024
 
 /* -------------------------------------------------------------------- */
 /** \name MFace Tessellation
@@ -638,7 +640,7 @@ static void mesh_calc_tessellation_for_face_free_fn(const void *__restrict UNUSE
 static void mesh_recalc_looptri__multi_threaded(const MLoop *mloop,
                                                 const MPoly *mpoly,
                                                 const MVert *mvert,
-                                                int UNUSED(totloop),
+                                                int totloop,
                                                 int totpoly,
                                                 MLoopTri *mlooptri,
                                                 const float (*poly_normals)[3])
@@ -661,6 +663,12 @@ static void mesh_recalc_looptri__multi_threaded(const MLoop *mloop,
 
   settings.func_free = mesh_calc_tessellation_for_face_free_fn;
 
+  /* Triangles and quads are very cheap to tessellate, so scheduling every face separately is
+   * mostly overhead. Group faces so each task handles about the same number of loops, which keeps
+   * the work balanced on meshes with many n-gons as well. */
+  settings.min_iter_per_thread = max_ii(
+      1, (int)(((int64_t)totpoly * MESH_FACE_TESSELLATE_LOOPS_PER_TASK) / max_ii(totloop, 1)));
+
   BLI_task_parallel_range(0,
                           totpoly,
                           &data,
@@ -1186,6 +1186,8 @@ void BKE_mesh_strip_loose_faces(Mesh *me)
   if (a != b) {
     CustomData_free_elem(&me->fdata, b, a - b);
     me->totface = b;
+    /* Shared layers are copied before their elements are freed. */
+    BKE_mesh_update_customdata_pointers(me, false);
   }
 }
 
@@ -1228,6 +1230,7 @@ void BKE_mesh_strip_loose_polysloops(Mesh *me)
   if (a != b) {
     CustomData_free_elem(&me->pdata, b, a - b);
     me->totpoly = b;
+    BKE_mesh_update_customdata_pointers(me, false);
   }
 
   /* And now, get rid of invalid loops. */
@@ -1249,6 +1252,7 @@ void BKE_mesh_strip_loose_polysloops(Mesh *me)
   if (a != b) {
     CustomData_free_elem(&me->ldata, b, a - b);
     me->totloop = b;
+    BKE_mesh_update_customdata_pointers(me, false);
   }
 
   /* And now, update polys' start loop index. */
@@ -1283,6 +1287,7 @@ void BKE_mesh_strip_loose_edges(Mesh *me)
   if (a != b) {
     CustomData_free_elem(&me->edata, b, a - b);
     me->totedge = b;
+    BKE_mesh_update_customdata_pointers(me, false);
   }
 
   /* And now, update loops' edge indices. */
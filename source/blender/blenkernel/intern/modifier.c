@@ -64,6 +64,7 @@
 /* end */
 
 #include "DEG_depsgraph.h"
+#include "DEG_depsgraph_debug.h"
 #include "DEG_depsgraph_query.h"
 
 #include "MOD_modifiertypes.h"
@@ -1002,6 +1003,13 @@ struct Mesh *BKE_modifier_modify_mesh(ModifierData *md,
   if (mti->dependsOnNormals && mti->dependsOnNormals(md)) {
     modwrap_dependsOnNormals(me);
   }
+
+  if (DEG_debug_trace_is_enabled()) {
+    DEG_debug_trace_begin("modifier", md->name);
+    Mesh *result = mti->modifyMesh(md, ctx, me);
+    DEG_debug_trace_end();
+    return result;
+  }
   return mti->modifyMesh(md, ctx, me);
 }
 
@@ -1015,7 +1023,15 @@ void BKE_modifier_deform_verts(ModifierData *md,
   if (me && mti->dependsOnNormals && mti->dependsOnNormals(md)) {
     modwrap_dependsOnNormals(me);
   }
+
+  const bool do_trace = DEG_debug_trace_is_enabled();
+  if (do_trace) {
+    DEG_debug_trace_begin("modifier", md->name);
+  }
   mti->deformVerts(md, ctx, me, vertexCos, numVerts);
+  if (do_trace) {
+    DEG_debug_trace_end();
+  }
 }
 
 void BKE_modifier_deform_vertsEM(ModifierData *md,
@@ -16,6 +16,7 @@
 
 #include "BLI_listbase.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.h"
 
 #include "BKE_customdata.h"
 #include "BKE_lib_id.h"
@@ -27,31 +28,66 @@
 
 #include "DEG_depsgraph_query.h"
 
+typedef struct UpdateMeshCoordsTaskData {
+  const MultiresReshapeContext *reshape_context;
+  MVert *mvert;
+  /* Grid whose corner is used for the coordinate of every vertex, -1 for loose vertices. */
+  const int *vert_grid_index;
+} UpdateMeshCoordsTaskData;
+
+static void update_mesh_coords_task(void *__restrict userdata_v,
+                                    const int vert_index,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  UpdateMeshCoordsTaskData *data = userdata_v;
+  const int grid_index = data->vert_grid_index[vert_index];
+  if (grid_index == -1) {
+    return;
+  }
+
+  GridCoord grid_coord;
+  grid_coord.grid_index = grid_index;
+  grid_coord.u = 1.0f;
+  grid_coord.v = 1.0f;
+
+  float P[3];
+  float tangent_matrix[3][3];
+  multires_reshape_evaluate_limit_at_grid(data->reshape_context, &grid_coord, P, tangent_matrix);
+
+  ReshapeConstGridElement grid_element = multires_reshape_orig_grid_element_for_grid_coord(
+      data->reshape_context, &grid_coord);
+  float D[3];
+  mul_v3_m3v3(D, tangent_matrix, grid_element.displacement);
+
+  add_v3_v3v3(data->mvert[vert_index].co, P, D);
+}
+
 void multires_reshape_apply_base_update_mesh_coords(MultiresReshapeContext *reshape_context)
 {
   Mesh *base_mesh = reshape_context->base_mesh;
   const MLoop *mloop = base_mesh->mloop;
-  MVert *mvert = base_mesh->mvert;
-  for (int loop_index = 0; loop_index < base_mesh->totloop; ++loop_index) {
-    const MLoop *loop = &mloop[loop_index];
-    MVert *vert = &mvert[loop->v];
 
-    GridCoord grid_coord;
-    grid_coord.grid_index = loop_index;
-    grid_coord.u = 1.0f;
-    grid_coord.v = 1.0f;
+  /* Evaluate the limit surface once per vertex instead of once per loop. Every vertex uses the
+   * grid corner of its last loop, which is the one that used to be written last. */
+  int *vert_grid_index = MEM_malloc_arrayN(
+      base_mesh->totvert, sizeof(int), "multires apply base vert grid index");
+  copy_vn_i(vert_grid_index, base_mesh->totvert, -1);
+  for (int loop_index = 0; loop_index < base_mesh->totloop; ++loop_index) {
+    vert_grid_index[mloop[loop_index].v] = loop_index;
+  }
 
-    float P[3];
-    float tangent_matrix[3][3];
-    multires_reshape_evaluate_limit_at_grid(reshape_context, &grid_coord, P, tangent_matrix);
+  UpdateMeshCoordsTaskData data;
+  data.reshape_context = reshape_context;
+  data.mvert = base_mesh->mvert;
+  data.vert_grid_index = vert_grid_index;
 
-    ReshapeConstGridElement grid_element = multires_reshape_orig_grid_element_for_grid_coord(
-        reshape_context, &grid_coord);
-    float D[3];
-    mul_v3_m3v3(D, tangent_matrix, grid_element.displacement);
+  TaskParallelSettings parallel_range_settings;
+  BLI_parallel_range_settings_defaults(&parallel_range_settings);
+  parallel_range_settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(
+      0, base_mesh->totvert, &data, update_mesh_coords_task, &parallel_range_settings);
 
-    add_v3_v3v3(vert->co, P, D);
-  }
+  MEM_freeN(vert_grid_index);
 }
 
 /* Assumes no is normalized; return value's sign is negative if v is on the other side of the
@@ -207,6 +207,8 @@ static void ntree_copy_data(Main *UNUSED(bmain), ID *id_dst, const ID *id_src, c
     ntree_dst->field_inferencing_interface = new FieldInferencingInterface(
         *ntree_src->field_inferencing_interface);
   }
+  /* The tree ref references the nodes of the source tree. */
+  ntree_dst->shared_tree_ref = nullptr;
 
   if (flag & LIB_ID_COPY_NO_PREVIEW) {
     ntree_dst->preview = nullptr;
@@ -259,6 +261,7 @@ static void ntree_free_data(ID *id)
   }
 
   delete ntree->field_inferencing_interface;
+  delete ntree->shared_tree_ref;
 
   /* free preview hash */
   if (ntree->previews) {
@@ -666,6 +669,7 @@ void ntreeBlendReadData(BlendDataReader *reader, bNodeTree *ntree)
   ntree->execdata = nullptr;
 
   ntree->field_inferencing_interface = nullptr;
+  ntree->shared_tree_ref = nullptr;
   BKE_ntree_update_tag_missing_runtime_data(ntree);
 
   BLO_read_data_address(reader, &ntree->adt);
@@ -46,6 +46,7 @@
 #include "DNA_sequence_types.h"
 #include "DNA_shader_fx_types.h"
 #include "DNA_space_types.h"
+#include "DNA_userdef_types.h"
 #include "DNA_view3d_types.h"
 #include "DNA_world_types.h"
 
@@ -280,6 +281,8 @@ static void object_free_data(ID *id)
   MEM_SAFE_FREE(ob->matbits);
   MEM_SAFE_FREE(ob->iuser);
   MEM_SAFE_FREE(ob->runtime.bb);
+  BKE_mesh_batch_cache_stash_free(ob->runtime.mesh_batch_cache_prev);
+  ob->runtime.mesh_batch_cache_prev = nullptr;
 
   BLI_freelistN(&ob->fmaps);
   if (ob->pose) {
@@ -1770,6 +1773,30 @@ void BKE_object_eval_assign_data(Object *object_eval, ID *data_eval, bool is_own
   object_eval->runtime.geometry_set_eval = nullptr;
 }
 
+void BKE_object_mesh_batch_cache_stash(Object *ob_eval)
+{
+  BKE_mesh_batch_cache_stash_free(ob_eval->runtime.mesh_batch_cache_prev);
+  ob_eval->runtime.mesh_batch_cache_prev = nullptr;
+
+  ID *data_eval = ob_eval->runtime.data_eval;
+  const ID *data_orig = ob_eval->runtime.data_orig;
+  if (ob_eval->type != OB_MESH || data_eval == nullptr || data_orig == nullptr ||
+      !ob_eval->runtime.is_data_eval_owned || GS(data_eval->name) != ID_ME) {
+    return;
+  }
+  Mesh *mesh_eval = (Mesh *)data_eval;
+  if (mesh_eval->edit_mesh != nullptr) {
+    return;
+  }
+  /* A geometry update of the mesh itself can change its topology. */
+  const bool is_deform_only = mesh_eval->runtime.deformed_only &&
+                              (data_orig->recalc & ID_RECALC_GEOMETRY) == 0;
+  if (!is_deform_only && !USER_EXPERIMENTAL_TEST(&U, use_draw_async_mesh_extraction)) {
+    return;
+  }
+  ob_eval->runtime.mesh_batch_cache_prev = BKE_mesh_batch_cache_stash(mesh_eval, is_deform_only);
+}
+
 void BKE_object_free_derived_caches(Object *ob)
 {
   MEM_SAFE_FREE(ob->runtime.bb);
@@ -4962,6 +4989,7 @@ void BKE_object_runtime_reset_on_copy(Object *object, const int UNUSED(flag))
   runtime->data_eval = nullptr;
   runtime->gpd_eval = nullptr;
   runtime->mesh_deform_eval = nullptr;
+  runtime->mesh_batch_cache_prev = nullptr;
   runtime->curve_cache = nullptr;
   runtime->object_as_temp_mesh = nullptr;
   runtime->object_as_temp_curve = nullptr;
@@ -4973,8 +5001,8 @@ void BKE_object_runtime_reset_on_copy(Object *object, const int UNUSED(flag))
 
 void BKE_object_runtime_free_data(Object *object)
 {
-  /* Currently this is all that's needed. */
   BKE_object_free_derived_caches(object);
+  BKE_mesh_batch_cache_stash_free(object->runtime.mesh_batch_cache_prev);
 
   BKE_object_runtime_reset(object);
 }
@@ -83,6 +83,9 @@ struct DupliContext {
   Vector<Object *> *instance_stack;
 
   int persistent_id[MAX_DUPLI_RECUR];
+  /** Geometry instances of every level, see #DupliObject.instance_data. */
+  const GeometrySet *instance_data[MAX_DUPLI_RECUR];
+  int instance_idx[MAX_DUPLI_RECUR];
   int level;
 
   const struct DupliGenerator *gen;
@@ -130,9 +133,17 @@ static void init_context(DupliContext *r_ctx,
 
 /**
  * Create sub-context for recursive duplis.
+ *
+ * \param geometry: The geometry with the instances component when the sub-context is created for
+ * a geometry instance, with #instance_index being its index in the component.
  */
-static bool copy_dupli_context(
-    DupliContext *r_ctx, const DupliContext *ctx, Object *ob, const float mat[4][4], int index)
+static bool copy_dupli_context(DupliContext *r_ctx,
+                               const DupliContext *ctx,
+                               Object *ob,
+                               const float mat[4][4],
+                               int index,
+                               const GeometrySet *geometry = nullptr,
+                               int64_t instance_index = 0)
 {
   *r_ctx = *ctx;
 
@@ -148,6 +159,8 @@ static bool copy_dupli_context(
     mul_m4_m4m4(r_ctx->space_mat, (float(*)[4])ctx->space_mat, mat);
   }
   r_ctx->persistent_id[r_ctx->level] = index;
+  r_ctx->instance_data[r_ctx->level] = geometry;
+  r_ctx->instance_idx[r_ctx->level] = int(instance_index);
   ++r_ctx->level;
 
   if (r_ctx->level == MAX_DUPLI_RECUR - 1) {
@@ -167,7 +180,9 @@ static bool copy_dupli_context(
 static DupliObject *make_dupli(const DupliContext *ctx,
                                Object *ob,
                                const float mat[4][4],
-                               int index)
+                               int index,
+                               const GeometrySet *geometry = nullptr,
+                               int64_t instance_index = 0)
 {
   DupliObject *dob;
   int i;
@@ -191,8 +206,12 @@ static DupliObject *make_dupli(const DupliContext *ctx,
    * dupli-object between frames, which is needed for motion blur.
    * The last level is ordered first in the array. */
   dob->persistent_id[0] = index;
+  dob->instance_data[0] = geometry;
+  dob->instance_idx[0] = int(instance_index);
   for (i = 1; i < ctx->level + 1; i++) {
     dob->persistent_id[i] = ctx->persistent_id[ctx->level - i];
+    dob->instance_data[i] = ctx->instance_data[ctx->level - i];
+    dob->instance_idx[i] = ctx->instance_idx[ctx->level - i];
   }
   /* Fill rest of values with #INT_MAX which index will never have as value. */
   for (; i < MAX_DUPLI_RECUR; i++) {
@@ -234,7 +253,9 @@ static DupliObject *make_dupli(const DupliContext *ctx,
 static void make_recursive_duplis(const DupliContext *ctx,
                                   Object *ob,
                                   const float space_mat[4][4],
-                                  int index)
+                                  int index,
+                                  const GeometrySet *geometry = nullptr,
+                                  int64_t instance_index = 0)
 {
   if (ctx->instance_stack->contains(ob)) {
     /* Avoid recursive instances. */
@@ -244,7 +265,7 @@ static void make_recursive_duplis(const DupliContext *ctx,
   /* Simple preventing of too deep nested collections with #MAX_DUPLI_RECUR. */
   if (ctx->level < MAX_DUPLI_RECUR) {
     DupliContext rctx;
-    if (!copy_dupli_context(&rctx, ctx, ob, space_mat, index)) {
+    if (!copy_dupli_context(&rctx, ctx, ob, space_mat, index, geometry, instance_index)) {
       return;
     }
     if (rctx.gen) {
@@ -833,12 +854,12 @@ static void make_duplis_geometry_set_impl(const DupliContext *ctx,
         Object &object = reference.object();
         float matrix[4][4];
         mul_m4_m4m4(matrix, parent_transform, instance_offset_matrices[i].values);
-        make_dupli(instances_ctx, &object, matrix, id);
+        make_dupli(instances_ctx, &object, matrix, id, &geometry_set, i);
 
         float space_matrix[4][4];
         mul_m4_m4m4(space_matrix, instance_offset_matrices[i].values, object.imat);
         mul_m4_m4_pre(space_matrix, parent_transform);
-        make_recursive_duplis(instances_ctx, &object, space_matrix, id);
+        make_recursive_duplis(instances_ctx, &object, space_matrix, id, &geometry_set, i);
         break;
       }
       case InstanceReference::Type::Collection: {
@@ -850,7 +871,8 @@ static void make_duplis_geometry_set_impl(const DupliContext *ctx,
         mul_m4_m4_pre(collection_matrix, parent_transform);
 
         DupliContext sub_ctx;
-        if (!copy_dupli_context(&sub_ctx, instances_ctx, instances_ctx->object, nullptr, id)) {
+        if (!copy_dupli_context(
+                &sub_ctx, instances_ctx, instances_ctx->object, nullptr, id, &geometry_set, i)) {
           break;
         }
 
@@ -875,7 +897,8 @@ static void make_duplis_geometry_set_impl(const DupliContext *ctx,
         mul_m4_m4m4(new_transform, parent_transform, instance_offset_matrices[i].values);
 
         DupliContext sub_ctx;
-        if (copy_dupli_context(&sub_ctx, instances_ctx, instances_ctx->object, nullptr, id)) {
+        if (copy_dupli_context(
+                &sub_ctx, instances_ctx, instances_ctx->object, nullptr, id, &geometry_set, i)) {
           make_duplis_geometry_set_impl(&sub_ctx, reference.geometry_set(), new_transform, true);
         }
         break;
@@ -1627,4 +1650,32 @@ void free_object_duplilist(ListBase *lb)
   MEM_freeN(lb);
 }
 
+bool BKE_object_dupli_find_rgba_attribute(const DupliObject *dupli,
+                                          const char *name,
+                                          float r_value[4])
+{
+  for (int level = 0; level < MAX_DUPLI_RECUR; level++) {
+    if (dupli->persistent_id[level] == INT_MAX) {
+      break;
+    }
+    const GeometrySet *geometry = dupli->instance_data[level];
+    if (geometry == nullptr) {
+      continue;
+    }
+    const InstancesComponent *component = geometry->get_component_for_read<InstancesComponent>();
+    if (component == nullptr) {
+      continue;
+    }
+    const blender::VArray<blender::ColorGeometry4f> colors =
+        component->attribute_try_get_for_read(name, ATTR_DOMAIN_INSTANCE, CD_PROP_COLOR)
+            .typed<blender::ColorGeometry4f>();
+    if (!colors) {
+      continue;
+    }
+    copy_v4_v4(r_value, colors[dupli->instance_idx[level]]);
+    return true;
+  }
+  return false;
+}
+
 /** \} */
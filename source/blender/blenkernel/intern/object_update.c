@@ -53,6 +53,7 @@
 
 void BKE_object_eval_reset(Object *ob_eval)
 {
+  BKE_object_mesh_batch_cache_stash(ob_eval);
   BKE_object_free_derived_caches(ob_eval);
 }
 
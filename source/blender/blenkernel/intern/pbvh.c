@@ -237,15 +237,14 @@ void pbvh_grow_nodes(PBVH *pbvh, int totnode)
 /* Add a vertex to the map, with a positive value for unique vertices and
  * a negative value for additional vertices */
 static int map_insert_vert(
-    PBVH *pbvh, GHash *map, unsigned int *face_verts, unsigned int *uniq_verts, int vertex)
+    GHash *map, unsigned int *face_verts, unsigned int *uniq_verts, int vertex, bool is_unique)
 {
   void *key, **value_p;
 
   key = POINTER_FROM_INT(vertex);
   if (!BLI_ghash_ensure_p(map, key, &value_p)) {
     int value_i;
-    if (BLI_BITMAP_TEST(pbvh->vert_bitmap, vertex) == 0) {
-      BLI_BITMAP_ENABLE(pbvh->vert_bitmap, vertex);
+    if (is_unique) {
       value_i = *uniq_verts;
       (*uniq_verts)++;
     }
@@ -260,8 +259,16 @@ static int map_insert_vert(
   return POINTER_AS_INT(*value_p);
 }
 
-/* Find vertices used by the faces in this node and update the draw buffers */
-static void build_mesh_leaf_node(PBVH *pbvh, PBVHNode *node)
+/**
+ * Find vertices used by the faces in this node and update the draw buffers.
+ *
+ * \param vert_owners: The order of the first leaf node using each vertex, see
+ * #pbvh_build_leaf_nodes. The vertex is unique to that node.
+ */
+static void build_mesh_leaf_node(PBVH *pbvh,
+                                 PBVHNode *node,
+                                 const int *vert_owners,
+                                 const int leaf_order)
 {
   bool has_visible = false;
 
@@ -282,8 +289,9 @@ static void build_mesh_leaf_node(PBVH *pbvh, PBVHNode *node)
   for (int i = 0; i < totface; i++) {
     const MLoopTri *lt = &pbvh->looptri[node->prim_indices[i]];
     for (int j = 0; j < 3; j++) {
+      const int vertex = pbvh->mloop[lt->tri[j]].v;
       face_vert_indices[i][j] = map_insert_vert(
-          pbvh, map, &node->face_verts, &node->uniq_verts, pbvh->mloop[lt->tri[j]].v);
+          map, &node->face_verts, &node->uniq_verts, vertex, vert_owners[vertex] == leaf_order);
     }
 
     if (has_visible == false) {
@@ -406,14 +414,113 @@ static void build_leaf(PBVH *pbvh, int node_index, BBC *prim_bbc, int offset, in
   /* Still need vb for searches */
   update_vb(pbvh, &pbvh->nodes[node_index], prim_bbc, offset, count);
 
+  /* The vertices and draw buffers of the leaf are set up by #pbvh_build_leaf_nodes, once the
+   * tree is complete. */
+}
+
+typedef struct PBVHBuildLeavesData {
+  PBVH *pbvh;
+  /** Leaf node indices, in the order they were created by #build_sub. */
+  const int *leaf_indices;
+  /** The lowest order of the leaf nodes using each vertex. */
+  int *vert_owners;
+} PBVHBuildLeavesData;
+
+static void pbvh_vert_owner_update(int *vert_owner, const int leaf_order)
+{
+  int owner = *vert_owner;
+  while (leaf_order < owner) {
+    const int owner_prev = atomic_cas_int32(vert_owner, owner, leaf_order);
+    if (owner_prev == owner) {
+      break;
+    }
+    owner = owner_prev;
+  }
+}
+
+static void pbvh_build_vert_owners_task_cb(void *__restrict userdata,
+                                           const int leaf_order,
+                                           const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PBVHBuildLeavesData *data = userdata;
+  PBVH *pbvh = data->pbvh;
+  const PBVHNode *node = &pbvh->nodes[data->leaf_indices[leaf_order]];
+
+  for (int i = 0; i < node->totprim; i++) {
+    const MLoopTri *lt = &pbvh->looptri[node->prim_indices[i]];
+    for (int j = 0; j < 3; j++) {
+      pbvh_vert_owner_update(&data->vert_owners[pbvh->mloop[lt->tri[j]].v], leaf_order);
+    }
+  }
+}
+
+static void pbvh_build_leaf_node_task_cb(void *__restrict userdata,
+                                         const int leaf_order,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PBVHBuildLeavesData *data = userdata;
+  PBVH *pbvh = data->pbvh;
+  PBVHNode *node = &pbvh->nodes[data->leaf_indices[leaf_order]];
+
   if (pbvh->looptri) {
-    build_mesh_leaf_node(pbvh, pbvh->nodes + node_index);
+    build_mesh_leaf_node(pbvh, node, data->vert_owners, leaf_order);
   }
   else {
-    build_grid_leaf_node(pbvh, pbvh->nodes + node_index);
+    build_grid_leaf_node(pbvh, node);
   }
 }
 
+/**
+ * Set up the vertices and draw buffers of all leaf nodes in parallel.
+ *
+ * Every vertex is unique to the first leaf node using it, in the order the leaves were created.
+ * That order is found again with a depth first traversal, so the result doesn't depend on the
+ * scheduling of the tasks.
+ */
+static void pbvh_build_leaf_nodes(PBVH *pbvh)
+{
+  int *leaf_indices = MEM_mallocN(sizeof(int) * pbvh->totnode, __func__);
+  int leaves_len = 0;
+  {
+    int *stack = MEM_mallocN(sizeof(int) * pbvh->totnode, __func__);
+    int stack_len = 0;
+    stack[stack_len++] = 0;
+    while (stack_len > 0) {
+      const int node_index = stack[--stack_len];
+      const PBVHNode *node = &pbvh->nodes[node_index];
+      if (node->flag & PBVH_Leaf) {
+        leaf_indices[leaves_len++] = node_index;
+      }
+      else {
+        /* Push the second child first, so that the first one is visited first. */
+        stack[stack_len++] = node->children_offset + 1;
+        stack[stack_len++] = node->children_offset;
+      }
+    }
+    MEM_freeN(stack);
+  }
+
+  PBVHBuildLeavesData data = {
+      .pbvh = pbvh,
+      .leaf_indices = leaf_indices,
+      .vert_owners = NULL,
+  };
+
+  TaskParallelSettings settings;
+  BKE_pbvh_parallel_range_settings(&settings, true, leaves_len);
+
+  if (pbvh->looptri) {
+    data.vert_owners = MEM_mallocN(sizeof(int) * pbvh->totvert, __func__);
+    copy_vn_i(data.vert_owners, pbvh->totvert, INT_MAX);
+    BLI_task_parallel_range(0, leaves_len, &data, pbvh_build_vert_owners_task_cb, &settings);
+  }
+
+  BLI_task_parallel_range(0, leaves_len, &data, pbvh_build_leaf_node_task_cb, &settings);
+
+  MEM_SAFE_FREE(data.vert_owners);
+  MEM_freeN(leaf_indices);
+}
+
 /* Return zero if all primitives in the node can be drawn with the
  * same material (including flat/smooth shading), non-zero otherwise */
 static bool leaf_needs_material_split(PBVH *pbvh, int offset, int count)
@@ -537,6 +644,88 @@ static void pbvh_build(PBVH *pbvh, BB *cb, BBC *prim_bbc, int totprim)
 
   pbvh->totnode = 1;
   build_sub(pbvh, 0, cb, prim_bbc, 0, totprim);
+  pbvh_build_leaf_nodes(pbvh);
+}
+
+typedef struct PBVHPrimBoundsData {
+  PBVH *pbvh;
+  BBC *prim_bbc;
+} PBVHPrimBoundsData;
+
+static void pbvh_mesh_prim_bounds_task_cb(void *__restrict userdata,
+                                          const int i,
+                                          const TaskParallelTLS *__restrict tls)
+{
+  PBVHPrimBoundsData *data = userdata;
+  const PBVH *pbvh = data->pbvh;
+  const MLoopTri *lt = &pbvh->looptri[i];
+  const int sides = 3;
+  BBC *bbc = data->prim_bbc + i;
+
+  BB_reset((BB *)bbc);
+
+  for (int j = 0; j < sides; j++) {
+    BB_expand((BB *)bbc, pbvh->verts[pbvh->mloop[lt->tri[j]].v].co);
+  }
+
+  BBC_update_centroid(bbc);
+
+  BB_expand((BB *)tls->userdata_chunk, bbc->bcentroid);
+}
+
+static void pbvh_grids_prim_bounds_task_cb(void *__restrict userdata,
+                                           const int i,
+                                           const TaskParallelTLS *__restrict tls)
+{
+  PBVHPrimBoundsData *data = userdata;
+  const PBVH *pbvh = data->pbvh;
+  const CCGKey *key = &pbvh->gridkey;
+  CCGElem *grid = pbvh->grids[i];
+  BBC *bbc = data->prim_bbc + i;
+
+  BB_reset((BB *)bbc);
+
+  for (int j = 0; j < key->grid_area; j++) {
+    BB_expand((BB *)bbc, CCG_elem_offset_co(key, grid, j));
+  }
+
+  BBC_update_centroid(bbc);
+
+  BB_expand((BB *)tls->userdata_chunk, bbc->bcentroid);
+}
+
+static void pbvh_prim_bounds_reduce(const void *__restrict UNUSED(userdata),
+                                    void *__restrict chunk_join,
+                                    void *__restrict chunk)
+{
+  BB_expand_with_bb((BB *)chunk_join, (BB *)chunk);
+}
+
+/**
+ * For each primitive, store the AABB and the AABB centroid.
+ * \param r_cb: The bounds of all centroids.
+ */
+static void pbvh_prim_bounds_calc(PBVH *pbvh,
+                                  BBC *prim_bbc,
+                                  const int totprim,
+                                  TaskParallelRangeFunc func,
+                                  BB *r_cb)
+{
+  PBVHPrimBoundsData data = {
+      .pbvh = pbvh,
+      .prim_bbc = prim_bbc,
+  };
+
+  BB_reset(r_cb);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = totprim > LEAF_LIMIT;
+  settings.min_iter_per_thread = LEAF_LIMIT;
+  settings.userdata_chunk = r_cb;
+  settings.userdata_chunk_size = sizeof(*r_cb);
+  settings.func_reduce = pbvh_prim_bounds_reduce;
+  BLI_task_parallel_range(0, totprim, &data, func, &settings);
 }
 
 void BKE_pbvh_build_mesh(PBVH *pbvh,
@@ -572,26 +761,9 @@ void BKE_pbvh_build_mesh(PBVH *pbvh,
   pbvh->face_sets_color_seed = mesh->face_sets_color_seed;
   pbvh->face_sets_color_default = mesh->face_sets_color_default;
 
-  BB_reset(&cb);
-
   /* For each face, store the AABB and the AABB centroid */
   prim_bbc = MEM_mallocN(sizeof(BBC) * looptri_num, "prim_bbc");
-
-  for (int i = 0; i < looptri_num; i++) {
-    const MLoopTri *lt = &looptri[i];
-    const int sides = 3;
-    BBC *bbc = prim_bbc + i;
-
-    BB_reset((BB *)bbc);
-
-    for (int j = 0; j < sides; j++) {
-      BB_expand((BB *)bbc, verts[pbvh->mloop[lt->tri[j]].v].co);
-    }
-
-    BBC_update_centroid(bbc);
-
-    BB_expand(&cb, bbc->bcentroid);
-  }
+  pbvh_prim_bounds_calc(pbvh, prim_bbc, looptri_num, pbvh_mesh_prim_bounds_task_cb, &cb);
 
   if (looptri_num) {
     pbvh_build(pbvh, &cb, prim_bbc, looptri_num);
@@ -599,9 +771,6 @@ void BKE_pbvh_build_mesh(PBVH *pbvh,
 
   MEM_freeN(prim_bbc);
 
-  /* Clear the bitmap so it can be used as an update tag later on. */
-  BLI_bitmap_set_all(pbvh->vert_bitmap, false, totvert);
-
   BKE_pbvh_update_active_vcol(pbvh, mesh);
 }
 
@@ -625,25 +794,10 @@ void BKE_pbvh_build_grids(PBVH *pbvh,
   pbvh->leaf_limit = max_ii(LEAF_LIMIT / (gridsize * gridsize), 1);
 
   BB cb;
-  BB_reset(&cb);
 
   /* For each grid, store the AABB and the AABB centroid */
   BBC *prim_bbc = MEM_mallocN(sizeof(BBC) * totgrid, "prim_bbc");
-
-  for (int i = 0; i < totgrid; i++) {
-    CCGElem *grid = grids[i];
-    BBC *bbc = prim_bbc + i;
-
-    BB_reset((BB *)bbc);
-
-    for (int j = 0; j < gridsize * gridsize; j++) {
-      BB_expand((BB *)bbc, CCG_elem_offset_co(key, grid, j));
-    }
-
-    BBC_update_centroid(bbc);
-
-    BB_expand(&cb, bbc->bcentroid);
-  }
+  pbvh_prim_bounds_calc(pbvh, prim_bbc, totgrid, pbvh_grids_prim_bounds_task_cb, &cb);
 
   if (totgrid) {
     pbvh_build(pbvh, &cb, prim_bbc, totgrid);
@@ -1351,7 +1505,9 @@ static void pbvh_update_draw_buffer_cb(void *__restrict userdata,
                                      CustomData_get_layer(pbvh->pdata, CD_SCULPT_FACE_SETS),
                                      pbvh->face_sets_color_seed,
                                      pbvh->face_sets_color_default,
-                                     update_flags);
+                                     (node->flag & PBVH_UpdateDrawGeometry) ?
+                                         update_flags :
+                                         update_flags | GPU_PBVH_BUFFERS_PAINT_ONLY);
         break;
       }
       case PBVH_BMESH:
@@ -1360,6 +1516,9 @@ static void pbvh_update_draw_buffer_cb(void *__restrict userdata,
                                       node->bm_faces,
                                       node->bm_unique_verts,
                                       node->bm_other_verts,
+                                      (int)(node - pbvh->nodes),
+                                      pbvh->cd_vert_node_offset,
+                                      pbvh->cd_vert_draw_index_offset,
                                       update_flags);
         break;
     }
@@ -1406,7 +1565,7 @@ static void pbvh_update_draw_buffers(PBVH *pbvh, PBVHNode **nodes, int totnode,
       GPU_pbvh_buffers_update_flush(node->draw_buffers);
     }
 
-    node->flag &= ~(PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers);
+    node->flag &= ~(PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers | PBVH_UpdateDrawGeometry);
   }
 }
 
@@ -1769,7 +1928,7 @@ BMesh *BKE_pbvh_get_bmesh(PBVH *pbvh)
 void BKE_pbvh_node_mark_update(PBVHNode *node)
 {
   node->flag |= PBVH_UpdateNormals | PBVH_UpdateBB | PBVH_UpdateOriginalBB |
-                PBVH_UpdateDrawBuffers | PBVH_UpdateRedraw;
+                PBVH_UpdateDrawBuffers | PBVH_UpdateDrawGeometry | PBVH_UpdateRedraw;
 }
 
 void BKE_pbvh_node_mark_update_mask(PBVHNode *node)
@@ -1785,17 +1944,18 @@ void BKE_pbvh_node_mark_update_color(PBVHNode *node)
 void BKE_pbvh_node_mark_update_visibility(PBVHNode *node)
 {
   node->flag |= PBVH_UpdateVisibility | PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers |
-                PBVH_UpdateRedraw;
+                PBVH_UpdateDrawGeometry | PBVH_UpdateRedraw;
 }
 
 void BKE_pbvh_node_mark_rebuild_draw(PBVHNode *node)
 {
-  node->flag |= PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers | PBVH_UpdateRedraw;
+  node->flag |= PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers | PBVH_UpdateDrawGeometry |
+                PBVH_UpdateRedraw;
 }
 
 void BKE_pbvh_node_mark_redraw(PBVHNode *node)
 {
-  node->flag |= PBVH_UpdateDrawBuffers | PBVH_UpdateRedraw;
+  node->flag |= PBVH_UpdateDrawBuffers | PBVH_UpdateDrawGeometry | PBVH_UpdateRedraw;
 }
 
 void BKE_pbvh_node_mark_normals_update(PBVHNode *node)
@@ -1866,10 +1866,12 @@ void BKE_pbvh_build_bmesh(PBVH *pbvh,
                           bool smooth_shading,
                           BMLog *log,
                           const int cd_vert_node_offset,
-                          const int cd_face_node_offset)
+                          const int cd_face_node_offset,
+                          const int cd_vert_draw_index_offset)
 {
   pbvh->cd_vert_node_offset = cd_vert_node_offset;
   pbvh->cd_face_node_offset = cd_face_node_offset;
+  pbvh->cd_vert_draw_index_offset = cd_vert_draw_index_offset;
   pbvh->bm = bm;
 
   BKE_pbvh_bmesh_detail_size_set(pbvh, 0.75);
@@ -158,8 +158,7 @@ struct PBVH {
   int totgrid;
   BLI_bitmap **grid_hidden;
 
-  /* Used during BVH build and later to mark that a vertex needs to update
-   * (its normal must be recalculated). */
+  /* Used to mark that a vertex needs to update (its normal must be recalculated). */
   BLI_bitmap *vert_bitmap;
 
 #ifdef PERFCNTRS
@@ -178,6 +177,8 @@ struct PBVH {
   float bm_min_edge_len;
   int cd_vert_node_offset;
   int cd_face_node_offset;
+  /** Scratch index of unique vertices in the draw buffers of their node. */
+  int cd_vert_draw_index_offset;
 
   float planes[6][4];
   int num_planes;
@@ -76,6 +76,10 @@
 #  include "LzmaLib.h"
 #endif
 
+#include <zstd.h>
+
+#define PTCACHE_ZSTD_COMPRESSION_LEVEL 3
+
 /* needed for directory lookup */
 #ifndef WIN32
 #  include <dirent.h>
@@ -1537,6 +1541,10 @@ static int ptcache_file_compressed_read(PTCacheFile *pf, unsigned char *result,
         r = LzmaUncompress(result, &leno, in, &leni, props, sizeOfIt);
       }
 #endif
+      if (compressed == 3) {
+        const size_t out_len_zstd = ZSTD_decompress(result, len, in, in_len);
+        r = (ZSTD_isError(out_len_zstd) || out_len_zstd != len) ? 1 : 0;
+      }
       MEM_freeN(in);
     }
   }
@@ -1598,6 +1606,17 @@ static int ptcache_file_compressed_write(
     }
   }
 #endif
+  if (mode == 3) {
+    /* Callers allocate `out` with at least #LZO_OUT_LEN bytes, which is more than
+     * `ZSTD_compressBound` for any input size. */
+    out_len = ZSTD_compress(out, LZO_OUT_LEN(in_len), in, in_len, PTCACHE_ZSTD_COMPRESSION_LEVEL);
+    if (ZSTD_isError(out_len) || (out_len >= in_len)) {
+      compressed = 0;
+    }
+    else {
+      compressed = 3;
+    }
+  }
 
   ptcache_file_write(pf, &compressed, 1, sizeof(unsigned char));
   if (compressed) {
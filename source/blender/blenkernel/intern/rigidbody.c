@@ -1660,8 +1660,12 @@ static void rigidbody_update_sim_world(Scene *scene, RigidBodyWorld *rbw)
   rigidbody_update_ob_array(rbw);
 }
 
-static void rigidbody_update_sim_ob(
-    Depsgraph *depsgraph, Scene *scene, RigidBodyWorld *rbw, Object *ob, RigidBodyOb *rbo)
+static void rigidbody_update_sim_ob(Depsgraph *depsgraph,
+                                    Scene *scene,
+                                    RigidBodyWorld *rbw,
+                                    Object *ob,
+                                    RigidBodyOb *rbo,
+                                    ListBase *effectors)
 {
   /* only update if rigid body exists */
   if (rbo->shared->physics_object == NULL) {
@@ -1718,10 +1722,7 @@ static void rigidbody_update_sim_ob(
            ((ob->pd == NULL) || (ob->pd->forcefield == PFIELD_NULL))) {
     EffectorWeights *effector_weights = rbw->effector_weights;
     EffectedPoint epoint;
-    ListBase *effectors;
 
-    /* get effectors present in the group specified by effector_weights */
-    effectors = BKE_effectors_create(depsgraph, ob, NULL, effector_weights, false);
     if (effectors) {
       float eff_force[3] = {0.0f, 0.0f, 0.0f};
       float eff_loc[3], eff_vel[3];
@@ -1754,9 +1755,6 @@ static void rigidbody_update_sim_ob(
     else if (G.f & G_DEBUG) {
       printf("\tno forces to apply to '%s'\n", ob->id.name + 2);
     }
-
-    /* cleanup */
-    BKE_effectors_free(effectors);
   }
   /* NOTE: passive objects don't need to be updated since they don't move */
 
@@ -1804,6 +1802,10 @@ static void rigidbody_update_simulation(Depsgraph *depsgraph,
     FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
   }
 
+  /* Get effectors present in the group specified by effector_weights. Bodies which are force
+   * fields themselves don't get effector forces, so the list is the same for all objects. */
+  ListBase *effectors = BKE_effectors_create(depsgraph, NULL, NULL, rbw->effector_weights, false);
+
   /* update objects */
   FOREACH_COLLECTION_OBJECT_RECURSIVE_BEGIN (rbw->group, ob) {
     if (ob->type == OB_MESH) {
@@ -1854,11 +1856,13 @@ static void rigidbody_update_simulation(Depsgraph *depsgraph,
       rbo->flag &= ~(RBO_FLAG_NEEDS_VALIDATE | RBO_FLAG_NEEDS_RESHAPE);
 
       /* update simulation object... */
-      rigidbody_update_sim_ob(depsgraph, scene, rbw, ob, rbo);
+      rigidbody_update_sim_ob(depsgraph, scene, rbw, ob, rbo, effectors);
     }
   }
   FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
 
+  BKE_effectors_free(effectors);
+
   /* update constraints */
   if (rbw->constraints == NULL) { /* no constraints, move on */
     return;
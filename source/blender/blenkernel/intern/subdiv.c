@@ -10,9 +10,12 @@
 #include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
 #include "DNA_modifier_types.h"
+#include "DNA_userdef_types.h"
 
 #include "BLI_utildefines.h"
 
+#include "BKE_customdata.h"
+#include "BKE_mesh_runtime.h"
 #include "BKE_modifier.h"
 #include "BKE_subdiv_modifier.h"
 
@@ -160,14 +163,65 @@ Subdiv *BKE_subdiv_update_from_converter(Subdiv *subdiv,
   return BKE_subdiv_new_from_converter(settings, converter);
 }
 
+/* The topology version alone is not enough: modifiers which write to a layer referenced from the
+ * original mesh get their own copy of that layer, so the data pointers are part of the key too. */
+static void subdiv_mesh_key_fill(Subdiv *subdiv, const Mesh *mesh)
+{
+  subdiv->mesh_key_.topology_version = BKE_mesh_topology_version_ensure(mesh);
+  subdiv->mesh_key_.totvert = mesh->totvert;
+  subdiv->mesh_key_.totedge = mesh->totedge;
+  subdiv->mesh_key_.totloop = mesh->totloop;
+  subdiv->mesh_key_.totpoly = mesh->totpoly;
+  subdiv->mesh_key_.medge = mesh->medge;
+  subdiv->mesh_key_.mloop = mesh->mloop;
+  subdiv->mesh_key_.mpoly = mesh->mpoly;
+  subdiv->mesh_key_.vertex_crease = CustomData_get_layer(&mesh->vdata, CD_CREASE);
+  uint64_t uv_layers_hash = 0;
+  const int num_uv_layers = CustomData_number_of_layers(&mesh->ldata, CD_MLOOPUV);
+  for (int layer_index = 0; layer_index < num_uv_layers; layer_index++) {
+    const void *layer = CustomData_get_layer_n(&mesh->ldata, CD_MLOOPUV, layer_index);
+    uv_layers_hash = uv_layers_hash * 31 + (uint64_t)(uintptr_t)layer;
+  }
+  subdiv->mesh_key_.uv_layers_hash = uv_layers_hash ^ (uint64_t)num_uv_layers;
+}
+
+static bool subdiv_mesh_key_matches(const Subdiv *subdiv, const Mesh *mesh)
+{
+  if (subdiv->mesh_key_.topology_version == 0 ||
+      subdiv->mesh_key_.topology_version != mesh->runtime.topology_version) {
+    return false;
+  }
+  Subdiv key;
+  subdiv_mesh_key_fill(&key, mesh);
+  return subdiv->mesh_key_.totvert == key.mesh_key_.totvert &&
+         subdiv->mesh_key_.totedge == key.mesh_key_.totedge &&
+         subdiv->mesh_key_.totloop == key.mesh_key_.totloop &&
+         subdiv->mesh_key_.totpoly == key.mesh_key_.totpoly &&
+         subdiv->mesh_key_.medge == key.mesh_key_.medge &&
+         subdiv->mesh_key_.mloop == key.mesh_key_.mloop &&
+         subdiv->mesh_key_.mpoly == key.mesh_key_.mpoly &&
+         subdiv->mesh_key_.vertex_crease == key.mesh_key_.vertex_crease &&
+         subdiv->mesh_key_.uv_layers_hash == key.mesh_key_.uv_layers_hash;
+}
+
 Subdiv *BKE_subdiv_update_from_mesh(Subdiv *subdiv,
                                     const SubdivSettings *settings,
                                     const Mesh *mesh)
 {
+  const bool use_topology_version = U.experimental.use_subdiv_topology_version;
+  if (use_topology_version && subdiv != NULL && subdiv->topology_refiner != NULL &&
+      BKE_subdiv_settings_equal(&subdiv->settings, settings) &&
+      subdiv_mesh_key_matches(subdiv, mesh)) {
+    return subdiv;
+  }
   OpenSubdiv_Converter converter;
   BKE_subdiv_converter_init_for_mesh(&converter, settings, mesh);
   subdiv = BKE_subdiv_update_from_converter(subdiv, settings, &converter);
   BKE_subdiv_converter_free(&converter);
+  /* Filled even when the option is disabled, so the key never describes an older topology. */
+  if (subdiv != NULL) {
+    subdiv_mesh_key_fill(subdiv, mesh);
+  }
   return subdiv;
 }
 
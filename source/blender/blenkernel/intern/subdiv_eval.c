@@ -18,6 +18,10 @@
 #include "BKE_customdata.h"
 #include "BKE_subdiv.h"
 
+#include "GPU_capabilities.h"
+#include "GPU_context.h"
+#include "GPU_platform.h"
+
 #include "MEM_guardedalloc.h"
 
 #include "opensubdiv_evaluator_capi.h"
@@ -70,7 +74,7 @@ bool BKE_subdiv_eval_begin(Subdiv *subdiv,
   return true;
 }
 
-static void set_coarse_positions(Subdiv *subdiv,
+static void set_coarse_positions(OpenSubdiv_Evaluator *evaluator,
                                  const Mesh *mesh,
                                  const float (*coarse_vertex_cos)[3])
 {
@@ -109,8 +113,7 @@ static void set_coarse_positions(Subdiv *subdiv,
     manifold_vertex_index++;
     manifold_vertex_count++;
   }
-  subdiv->evaluator->setCoarsePositions(
-      subdiv->evaluator, &buffer[0][0], 0, manifold_vertex_count);
+  evaluator->setCoarsePositions(evaluator, &buffer[0][0], 0, manifold_vertex_count);
   MEM_freeN(vertex_used_map);
   MEM_freeN(buffer);
 }
@@ -201,7 +204,7 @@ bool BKE_subdiv_eval_refine_from_mesh(Subdiv *subdiv,
     return false;
   }
   /* Set coordinates of base mesh vertices. */
-  set_coarse_positions(subdiv, mesh, coarse_vertex_cos);
+  set_coarse_positions(subdiv->evaluator, mesh, coarse_vertex_cos);
   /* Set face-varyign data to UV maps. */
   const int num_uv_layers = CustomData_number_of_layers(&mesh->ldata, CD_MLOOPUV);
   for (int layer_index = 0; layer_index < num_uv_layers; layer_index++) {
@@ -321,3 +324,37 @@ void BKE_subdiv_eval_final_point(
     BKE_subdiv_eval_limit_point(subdiv, ptex_face_index, u, v, r_P);
   }
 }
+
+/* ===================  Bulk Limit Evaluation on the GPU ==================== */
+
+bool BKE_subdiv_eval_limit_points_gpu(Subdiv *subdiv,
+                                      const Mesh *mesh,
+                                      const float (*coarse_vertex_cos)[3],
+                                      const OpenSubdiv_PatchCoord *patch_coords,
+                                      const int num_patch_coords,
+                                      float (*r_P)[3])
+{
+  if (subdiv->topology_refiner == NULL || GPU_context_active_get() == NULL) {
+    return false;
+  }
+  /* Same requirements as the GPU subdivision of the draw code. */
+  if (GPU_backend_get_type() != GPU_BACKEND_OPENGL ||
+      !(GPU_compute_shader_support() && GPU_shader_storage_buffer_objects_support())) {
+    return false;
+  }
+  OpenSubdiv_Evaluator *evaluator = openSubdiv_createEvaluatorFromTopologyRefiner(
+      subdiv->topology_refiner, OPENSUBDIV_EVALUATOR_GLSL_COMPUTE, NULL);
+  if (evaluator == NULL) {
+    return false;
+  }
+  if (evaluator->impl == NULL) {
+    openSubdiv_deleteEvaluator(evaluator);
+    return false;
+  }
+  set_coarse_positions(evaluator, mesh, coarse_vertex_cos);
+  evaluator->refine(evaluator);
+  evaluator->evaluatePatchesLimit(
+      evaluator, patch_coords, num_patch_coords, &r_P[0][0], NULL, NULL);
+  openSubdiv_deleteEvaluator(evaluator);
+  return true;
+}
@@ -13,6 +13,7 @@
 #include "DNA_key_types.h"
 #include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
+#include "DNA_userdef_types.h"
 
 #include "BLI_alloca.h"
 #include "BLI_math_vector.h"
@@ -26,6 +27,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "opensubdiv_capi_type.h"
+
 /* -------------------------------------------------------------------- */
 /** \name Subdivision Context
  * \{ */
@@ -46,6 +49,9 @@ typedef struct SubdivMeshContext {
   /* Per-subdivided vertex counter of averaged values. */
   int *accumulated_counters;
   bool have_displacement;
+  /* Limit positions of all subdivided vertices when they are evaluated on the GPU beforehand,
+   * see #UserDef_Experimental.use_subdiv_gpu_final. */
+  float (*vertex_positions)[3];
 } SubdivMeshContext;
 
 static void subdiv_mesh_ctx_cache_uv_layers(SubdivMeshContext *ctx)
@@ -81,6 +87,7 @@ static void subdiv_mesh_prepare_accumulator(SubdivMeshContext *ctx, int num_vert
 
 static void subdiv_mesh_context_free(SubdivMeshContext *ctx)
 {
+  MEM_SAFE_FREE(ctx->vertex_positions);
   MEM_SAFE_FREE(ctx->accumulated_counters);
 }
 
@@ -505,6 +512,21 @@ static void subdiv_vertex_data_interpolate(const SubdivMeshContext *ctx,
   }
 }
 
+static void subdiv_mesh_vertex_limit_point(const SubdivMeshContext *ctx,
+                                           const int ptex_face_index,
+                                           const float u,
+                                           const float v,
+                                           const int subdiv_vertex_index,
+                                           float r_P[3])
+{
+  if (ctx->vertex_positions != NULL) {
+    copy_v3_v3(r_P, ctx->vertex_positions[subdiv_vertex_index]);
+  }
+  else {
+    BKE_subdiv_eval_limit_point(ctx->subdiv, ptex_face_index, u, v, r_P);
+  }
+}
+
 static void evaluate_vertex_and_apply_displacement_copy(const SubdivMeshContext *ctx,
                                                         const int ptex_face_index,
                                                         const float u,
@@ -523,7 +545,8 @@ static void evaluate_vertex_and_apply_displacement_copy(const SubdivMeshContext
   }
   /* Copy custom data and evaluate position. */
   subdiv_vertex_data_copy(ctx, coarse_vert, subdiv_vert);
-  BKE_subdiv_eval_limit_point(ctx->subdiv, ptex_face_index, u, v, subdiv_vert->co);
+  subdiv_mesh_vertex_limit_point(
+      ctx, ptex_face_index, u, v, subdiv_vertex_index, subdiv_vert->co);
   /* Apply displacement. */
   add_v3_v3(subdiv_vert->co, D);
   /* Remove facedot flag. This can happen if there is more than one subsurf modifier. */
@@ -549,7 +572,8 @@ static void evaluate_vertex_and_apply_displacement_interpolate(
   }
   /* Interpolate custom data and evaluate position. */
   subdiv_vertex_data_interpolate(ctx, subdiv_vert, vertex_interpolation, u, v);
-  BKE_subdiv_eval_limit_point(ctx->subdiv, ptex_face_index, u, v, subdiv_vert->co);
+  subdiv_mesh_vertex_limit_point(
+      ctx, ptex_face_index, u, v, subdiv_vertex_index, subdiv_vert->co);
   /* Apply displacement. */
   add_v3_v3(subdiv_vert->co, D);
 }
@@ -716,7 +740,13 @@ static void subdiv_mesh_vertex_inner(const SubdivForeachContext *foreach_context
   MVert *subdiv_vert = &subdiv_mvert[subdiv_vertex_index];
   subdiv_mesh_ensure_vertex_interpolation(ctx, tls, coarse_poly, coarse_corner);
   subdiv_vertex_data_interpolate(ctx, subdiv_vert, &tls->vertex_interpolation, u, v);
-  BKE_subdiv_eval_final_point(subdiv, ptex_face_index, u, v, subdiv_vert->co);
+  if (ctx->vertex_positions != NULL) {
+    /* Only evaluated on the GPU without displacement. */
+    copy_v3_v3(subdiv_vert->co, ctx->vertex_positions[subdiv_vertex_index]);
+  }
+  else {
+    BKE_subdiv_eval_final_point(subdiv, ptex_face_index, u, v, subdiv_vert->co);
+  }
   subdiv_mesh_tag_center_vertex(coarse_poly, subdiv_vert, u, v);
 }
 
@@ -1104,6 +1134,121 @@ static void setup_foreach_callbacks(const SubdivMeshContext *subdiv_context,
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name GPU evaluation of vertex positions
+ *
+ * Gather the patch coordinates of all subdivided vertices in a first traversal, so their limit
+ * positions can be evaluated in a single batch on the GPU.
+ * \{ */
+
+typedef struct SubdivMeshPatchCoordsContext {
+  OpenSubdiv_PatchCoord *patch_coords;
+  int num_vertices;
+} SubdivMeshPatchCoordsContext;
+
+static bool subdiv_mesh_patch_coords_topology_info(const SubdivForeachContext *foreach_context,
+                                                   const int num_vertices,
+                                                   const int UNUSED(num_edges),
+                                                   const int UNUSED(num_loops),
+                                                   const int UNUSED(num_polygons),
+                                                   const int *UNUSED(subdiv_polygon_offset))
+{
+  SubdivMeshPatchCoordsContext *ctx = foreach_context->user_data;
+  ctx->num_vertices = num_vertices;
+  /* Loose vertices are not evaluated, keep their coordinates initialized anyway. */
+  ctx->patch_coords = MEM_calloc_arrayN(
+      num_vertices, sizeof(OpenSubdiv_PatchCoord), "subdiv patch coords");
+  return true;
+}
+
+static void subdiv_mesh_patch_coord_set(const SubdivForeachContext *foreach_context,
+                                        const int ptex_face_index,
+                                        const float u,
+                                        const float v,
+                                        const int subdiv_vertex_index)
+{
+  SubdivMeshPatchCoordsContext *ctx = foreach_context->user_data;
+  OpenSubdiv_PatchCoord *patch_coord = &ctx->patch_coords[subdiv_vertex_index];
+  patch_coord->ptex_face = ptex_face_index;
+  patch_coord->u = u;
+  patch_coord->v = v;
+}
+
+static void subdiv_mesh_patch_coord_corner(const SubdivForeachContext *foreach_context,
+                                           void *UNUSED(tls),
+                                           const int ptex_face_index,
+                                           const float u,
+                                           const float v,
+                                           const int UNUSED(coarse_vertex_index),
+                                           const int UNUSED(coarse_poly_index),
+                                           const int UNUSED(coarse_corner),
+                                           const int subdiv_vertex_index)
+{
+  subdiv_mesh_patch_coord_set(foreach_context, ptex_face_index, u, v, subdiv_vertex_index);
+}
+
+static void subdiv_mesh_patch_coord_edge(const SubdivForeachContext *foreach_context,
+                                         void *UNUSED(tls),
+                                         const int ptex_face_index,
+                                         const float u,
+                                         const float v,
+                                         const int UNUSED(coarse_edge_index),
+                                         const int UNUSED(coarse_poly_index),
+                                         const int UNUSED(coarse_corner),
+                                         const int subdiv_vertex_index)
+{
+  subdiv_mesh_patch_coord_set(foreach_context, ptex_face_index, u, v, subdiv_vertex_index);
+}
+
+static void subdiv_mesh_patch_coord_inner(const SubdivForeachContext *foreach_context,
+                                          void *UNUSED(tls),
+                                          const int ptex_face_index,
+                                          const float u,
+                                          const float v,
+                                          const int UNUSED(coarse_poly_index),
+                                          const int UNUSED(coarse_corner),
+                                          const int subdiv_vertex_index)
+{
+  subdiv_mesh_patch_coord_set(foreach_context, ptex_face_index, u, v, subdiv_vertex_index);
+}
+
+static void subdiv_mesh_vertex_positions_evaluate_gpu(SubdivMeshContext *subdiv_context)
+{
+  if (!U.experimental.use_subdiv_gpu_final || subdiv_context->have_displacement) {
+    return;
+  }
+  Subdiv *subdiv = subdiv_context->subdiv;
+  SubdivMeshPatchCoordsContext ctx = {NULL};
+  SubdivForeachContext foreach_context = {NULL};
+  foreach_context.topology_info = subdiv_mesh_patch_coords_topology_info;
+  foreach_context.vertex_corner = subdiv_mesh_patch_coord_corner;
+  foreach_context.vertex_edge = subdiv_mesh_patch_coord_edge;
+  foreach_context.vertex_inner = subdiv_mesh_patch_coord_inner;
+  foreach_context.user_data = &ctx;
+  BKE_subdiv_foreach_subdiv_geometry(
+      subdiv, &foreach_context, subdiv_context->settings, subdiv_context->coarse_mesh);
+  if (ctx.patch_coords == NULL) {
+    return;
+  }
+
+  float(*vertex_positions)[3] = MEM_malloc_arrayN(
+      ctx.num_vertices, sizeof(float[3]), "subdiv vertex positions");
+  if (BKE_subdiv_eval_limit_points_gpu(subdiv,
+                                       subdiv_context->coarse_mesh,
+                                       NULL,
+                                       ctx.patch_coords,
+                                       ctx.num_vertices,
+                                       vertex_positions)) {
+    subdiv_context->vertex_positions = vertex_positions;
+  }
+  else {
+    MEM_freeN(vertex_positions);
+  }
+  MEM_freeN(ctx.patch_coords);
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Public entry point
  * \{ */
@@ -1133,6 +1278,7 @@ Mesh *BKE_subdiv_to_mesh(Subdiv *subdiv,
   subdiv_context.coarse_mesh = coarse_mesh;
   subdiv_context.subdiv = subdiv;
   subdiv_context.have_displacement = (subdiv->displacement_evaluator != NULL);
+  subdiv_mesh_vertex_positions_evaluate_gpu(&subdiv_context);
   /* Multi-threaded traversal/evaluation. */
   BKE_subdiv_stats_begin(&subdiv->stats, SUBDIV_STATS_SUBDIV_TO_MESH_GEOMETRY);
   SubdivForeachContext foreach_context;
@@ -0,0 +1,299 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * A `blender::ConcurrentMap<Key, Value>` is a hash map that can be accessed from multiple threads
+ * at the same time. It is meant for code that fills a map from parallel tasks and currently has
+ * to protect a `blender::Map` or `GHash` with a single global mutex.
+ *
+ * The map is split into a fixed number of shards. Every shard is a `blender::Map` with its own
+ * mutex, and the shard of a key is chosen by its hash. Threads only contend when they access keys
+ * in the same shard at the same time, which is rare with the default of 64 shards.
+ *
+ * Some noteworthy information:
+ * - The API follows `blender::Map` where possible, so that existing code is easy to port.
+ * - Since other threads can change the map at any time, there are no methods that return
+ *   references or pointers to keys or values. Lookups return copies instead. Use `add_or_modify`
+ *   to change a value in place while the shard is locked.
+ * - The callbacks passed to `add_or_modify` and `lookup_or_add_cb` are called while the shard is
+ *   locked. They must not access the same map.
+ * - `foreach_item` locks one shard at a time, so it does not see a consistent snapshot when other
+ *   threads change the map concurrently.
+ * - A rudimentary benchmark comparing it to a `blender::Map` protected by a single mutex can be
+ *   found in BLI_concurrent_map_test.cc.
+ */
+
+#include <array>
+#include <mutex>
+#include <optional>
+
+#include "BLI_map.hh"
+
+namespace blender {
+
+template<
+    /**
+     * Type of the keys stored in the map. See #blender::Map.
+     */
+    typename Key,
+    /**
+     * Type of the value that is stored per key. Lookups return copies, so it should be cheap to
+     * copy.
+     */
+    typename Value,
+    /**
+     * The map is split into `2^ShardBits` independently locked shards.
+     */
+    int ShardBits = 6,
+    /**
+     * The hash function used to hash the keys. It is used to select the shard and inside of it.
+     */
+    typename Hash = DefaultHash<Key>,
+    /**
+     * The equality operator used to compare keys.
+     */
+    typename IsEqual = DefaultEquality>
+class ConcurrentMap {
+ public:
+  using size_type = int64_t;
+  using MapType = Map<Key, Value, 0, DefaultProbingStrategy, Hash, IsEqual>;
+
+ private:
+  static_assert(ShardBits > 0 && ShardBits < 16);
+  static constexpr int64_t shards_num_ = int64_t(1) << ShardBits;
+
+  /**
+   * Shards are aligned to a cache line, so that threads working on different shards don't slow
+   * each other down by writing to the same cache line.
+   */
+  struct alignas(64) Shard {
+    mutable std::mutex mutex;
+    MapType map;
+  };
+
+  std::array<Shard, shards_num_> shards_;
+  Hash hash_;
+
+ public:
+  ConcurrentMap() = default;
+
+  /* Copying or moving the map would require locking all shards of both maps. This is not
+   * supported, because a concurrent map is usually shared data that stays in one place. */
+  ConcurrentMap(const ConcurrentMap &other) = delete;
+  ConcurrentMap(ConcurrentMap &&other) = delete;
+  ConcurrentMap &operator=(const ConcurrentMap &other) = delete;
+  ConcurrentMap &operator=(ConcurrentMap &&other) = delete;
+
+  /**
+   * Add a key-value-pair to the map. If the map contains the key already, nothing is changed.
+   * Returns true when the key has been newly added.
+   */
+  bool add(const Key &key, const Value &value)
+  {
+    return this->add_as(key, value);
+  }
+  bool add(Key &&key, Value &&value)
+  {
+    return this->add_as(std::move(key), std::move(value));
+  }
+  template<typename ForwardKey, typename... ForwardValue>
+  bool add_as(ForwardKey &&key, ForwardValue &&...value)
+  {
+    Shard &shard = this->shard_for_key(key);
+    std::lock_guard lock{shard.mutex};
+    return shard.map.add_as(std::forward<ForwardKey>(key), std::forward<ForwardValue>(value)...);
+  }
+
+  /**
+   * Add a key-value-pair to the map. If the map contains the key already, the corresponding value
+   * will be replaced. Returns true when the key has been newly added.
+   */
+  bool add_overwrite(const Key &key, const Value &value)
+  {
+    return this->add_overwrite_as(key, value);
+  }
+  bool add_overwrite(Key &&key, Value &&value)
+  {
+    return this->add_overwrite_as(std::move(key), std::move(value));
+  }
+  template<typename ForwardKey, typename... ForwardValue>
+  bool add_overwrite_as(ForwardKey &&key, ForwardValue &&...value)
+  {
+    Shard &shard = this->shard_for_key(key);
+    std::lock_guard lock{shard.mutex};
+    return shard.map.add_overwrite_as(std::forward<ForwardKey>(key),
+                                      std::forward<ForwardValue>(value)...);
+  }
+
+  /**
+   * Returns true if there is a key in the map that compares equal to the given key.
+   */
+  bool contains(const Key &key) const
+  {
+    return this->contains_as(key);
+  }
+  template<typename ForwardKey> bool contains_as(const ForwardKey &key) const
+  {
+    const Shard &shard = this->shard_for_key(key);
+    std::lock_guard lock{shard.mutex};
+    return shard.map.contains_as(key);
+  }
+
+  /**
+   * Deletes the key-value-pair with the given key. Returns true when the key was contained and is
+   * now removed, false otherwise.
+   */
+  bool remove(const Key &key)
+  {
+    return this->remove_as(key);
+  }
+  template<typename ForwardKey> bool remove_as(const ForwardKey &key)
+  {
+    Shard &shard = this->shard_for_key(key);
+    std::lock_guard lock{shard.mutex};
+    return shard.map.remove_as(key);
+  }
+
+  /**
+   * Returns a copy of the value that corresponds to the given key. If the key is not in the map,
+   * nothing is returned.
+   */
+  std::optional<Value> lookup_try(const Key &key) const
+  {
+    return this->lookup_try_as(key);
+  }
+  template<typename ForwardKey> std::optional<Value> lookup_try_as(const ForwardKey &key) const
+  {
+    const Shard &shard = this->shard_for_key(key);
+    std::lock_guard lock{shard.mutex};
+    const Value *value = shard.map.lookup_ptr_as(key);
+    if (value == nullptr) {
+      return std::nullopt;
+    }
+    return *value;
+  }
+
+  /**
+   * Returns a copy of the value that corresponds to the given key. If the key is not in the map,
+   * the provided default value is returned.
+   */
+  Value lookup_default(const Key &key, const Value &default_value) const
+  {
+    return this->lookup_default_as(key, default_value);
+  }
+  template<typename ForwardKey, typename... ForwardValue>
+  Value lookup_default_as(const ForwardKey &key, ForwardValue &&...default_value) const
+  {
+    const Shard &shard = this->shard_for_key(key);
+    std::lock_guard lock{shard.mutex};
+    return shard.map.lookup_default_as(key, std::forward<ForwardValue>(default_value)...);
+  }
+
+  /**
+   * Returns a copy of the value that corresponds to the given key. If the key is not yet in the
+   * map, it will be newly added first. The create_value callback is called while the shard is
+   * locked, so only one value is ever created per key.
+   */
+  template<typename CreateValueF>
+  Value lookup_or_add_cb(const Key &key, const CreateValueF &create_value)
+  {
+    return this->lookup_or_add_cb_as(key, create_value);
+  }
+  template<typename ForwardKey, typename CreateValueF>
+  Value lookup_or_add_cb_as(ForwardKey &&key, const CreateValueF &create_value)
+  {
+    Shard &shard = this->shard_for_key(key);
+    std::lock_guard lock{shard.mutex};
+    return shard.map.lookup_or_add_cb_as(std::forward<ForwardKey>(key), create_value);
+  }
+
+  /**
+   * Same as #blender::Map::add_or_modify. Both callbacks are called while the shard is locked,
+   * so this can be used for thread-safe read-modify-write of values.
+   */
+  template<typename CreateValueF, typename ModifyValueF>
+  auto add_or_modify(const Key &key,
+                     const CreateValueF &create_value,
+                     const ModifyValueF &modify_value) -> decltype(create_value(nullptr))
+  {
+    return this->add_or_modify_as(key, create_value, modify_value);
+  }
+  template<typename ForwardKey, typename CreateValueF, typename ModifyValueF>
+  auto add_or_modify_as(ForwardKey &&key,
+                        const CreateValueF &create_value,
+                        const ModifyValueF &modify_value) -> decltype(create_value(nullptr))
+  {
+    Shard &shard = this->shard_for_key(key);
+    std::lock_guard lock{shard.mutex};
+    return shard.map.add_or_modify_as(std::forward<ForwardKey>(key), create_value, modify_value);
+  }
+
+  /**
+   * Calls the provided callback for every key-value-pair in the map. The shard containing the
+   * current item is locked, so the callback must not access the same map.
+   */
+  template<typename FuncT> void foreach_item(const FuncT &func) const
+  {
+    for (const Shard &shard : shards_) {
+      std::lock_guard lock{shard.mutex};
+      shard.map.foreach_item(func);
+    }
+  }
+
+  /**
+   * Return the number of key-value-pairs that are stored in the map. When other threads change
+   * the map at the same time, the result is only approximate.
+   */
+  int64_t size() const
+  {
+    int64_t size = 0;
+    for (const Shard &shard : shards_) {
+      std::lock_guard lock{shard.mutex};
+      size += shard.map.size();
+    }
+    return size;
+  }
+
+  /**
+   * Returns true if there are no elements in the map.
+   */
+  bool is_empty() const
+  {
+    return this->size() == 0;
+  }
+
+  /**
+   * Removes all key-value-pairs from the map.
+   */
+  void clear()
+  {
+    for (Shard &shard : shards_) {
+      std::lock_guard lock{shard.mutex};
+      shard.map.clear();
+    }
+  }
+
+ private:
+  template<typename ForwardKey> int64_t shard_index(const ForwardKey &key) const
+  {
+    /* The shard maps use the low bits of the hash to find a slot. Use the high bits of a mixed
+     * hash to select the shard, so that the keys in one shard are still spread over its slots. */
+    const uint64_t hash = hash_(key) * uint64_t(0x9e3779b97f4a7c15);
+    return int64_t(hash >> (64 - ShardBits));
+  }
+
+  template<typename ForwardKey> Shard &shard_for_key(const ForwardKey &key)
+  {
+    return shards_[this->shard_index(key)];
+  }
+
+  template<typename ForwardKey> const Shard &shard_for_key(const ForwardKey &key) const
+  {
+    return shards_[this->shard_index(key)];
+  }
+};
+
+}  // namespace blender
@@ -88,6 +88,9 @@ enum {
 #define BVH_RAYCAST_DEFAULT (BVH_RAYCAST_WATERTIGHT)
 #define BVH_RAYCAST_DIST_MAX (FLT_MAX / 2.0f)
 
+/** Maximum number of coordinates of one leaf inserted with #BLI_bvhtree_insert_range. */
+#define BVH_INSERT_RANGE_MAX_POINTS 4
+
 /**
  * Callback must update nearest in case it finds a nearest result.
  */
@@ -114,6 +117,12 @@ typedef bool (*BVHTree_OverlapCallback)(void *userdata, int index_a, int index_b
  */
 typedef void (*BVHTree_RangeQuery)(void *userdata, int index, const float co[3], float dist_sq);
 
+/**
+ * Callback to get the coordinates of a leaf for #BLI_bvhtree_insert_range.
+ * \param r_co: Space for up to #BVH_INSERT_RANGE_MAX_POINTS coordinates.
+ */
+typedef void (*BVHTree_LeafCoordsCallback)(void *userdata, int index, float (*r_co)[3]);
+
 /**
  * Callback to find nearest projected.
  */
@@ -153,6 +162,15 @@ void BLI_bvhtree_free(BVHTree *tree);
  * Construct: first insert points, then call balance.
  */
 void BLI_bvhtree_insert(BVHTree *tree, int index, const float co[3], int numpoints);
+/**
+ * Insert leaves with the indices from 0 to `leaf_num - 1` at once, which is multi-threaded for
+ * large trees. The callback is called from multiple threads.
+ */
+void BLI_bvhtree_insert_range(BVHTree *tree,
+                              int leaf_num,
+                              int numpoints,
+                              BVHTree_LeafCoordsCallback coords_fn,
+                              void *userdata);
 void BLI_bvhtree_balance(BVHTree *tree);
 
 /**
@@ -33,6 +33,12 @@ bool BLI_mmap_read(BLI_mmap_file *file, void *dest, size_t offset, size_t length
 
 void *BLI_mmap_get_pointer(BLI_mmap_file *file) ATTR_WARN_UNUSED_RESULT;
 
+/* Hints that the given range was consumed and won't be needed again soon, so that the OS can
+ * drop its pages from the resident set of the process. Accessing the range again stays valid,
+ * the pages are simply faulted in from the file again.
+ * Only pages that are fully inside of the range are released. */
+void BLI_mmap_release(BLI_mmap_file *file, size_t offset, size_t length) ATTR_NONNULL(1);
+
 void BLI_mmap_free(BLI_mmap_file *file) ATTR_NONNULL(1);
 
 #ifdef __cplusplus
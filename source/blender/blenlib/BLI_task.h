@@ -34,6 +34,11 @@ struct BLI_mempool;
 void BLI_task_scheduler_init(void);
 void BLI_task_scheduler_exit(void);
 int BLI_task_scheduler_num_threads(void);
+/**
+ * Number of NUMA nodes work can be bound to, see #BLI_task_numa_node_isolate.
+ * 1 when the system has a single node or its topology can't be queried.
+ */
+int BLI_task_scheduler_numa_nodes_num(void);
 
 /** \} */
 
@@ -115,6 +120,12 @@ void BLI_task_pool_cancel(TaskPool *pool);
  */
 bool BLI_task_pool_current_canceled(TaskPool *pool);
 
+/**
+ * Execute the tasks of the pool on the threads of the NUMA node, see
+ * #BLI_task_numa_node_isolate. Has to be called before any task is pushed.
+ */
+void BLI_task_pool_numa_node_set(TaskPool *pool, int numa_node);
+
 /**
  * Optional `userdata` pointer to pass along to run function.
  */
@@ -192,6 +203,9 @@ typedef struct TaskParallelSettings {
    * having a global use_threading switch based on just range size.
    */
   int min_iter_per_thread;
+  /* Execute the range on the threads of this NUMA node, -1 to use any thread.
+   * See #BLI_task_numa_node_isolate. Only supported by #BLI_task_parallel_range. */
+  int numa_node;
 } TaskParallelSettings;
 
 BLI_INLINE void BLI_parallel_range_settings_defaults(TaskParallelSettings *settings);
@@ -296,12 +310,14 @@ BLI_INLINE void BLI_parallel_range_settings_defaults(TaskParallelSettings *setti
   settings->use_threading = true;
   /* Use default heuristic to define actual chunk size. */
   settings->min_iter_per_thread = 0;
+  settings->numa_node = -1;
 }
 
 BLI_INLINE void BLI_parallel_mempool_settings_defaults(TaskParallelSettings *settings)
 {
   memset(settings, 0, sizeof(*settings));
   settings->use_threading = true;
+  settings->numa_node = -1;
 }
 
 /**
@@ -310,6 +326,13 @@ BLI_INLINE void BLI_parallel_mempool_settings_defaults(TaskParallelSettings *set
  */
 int BLI_task_parallel_thread_id(const TaskParallelTLS *tls);
 
+/**
+ * Print the counters of every `threading::AdaptiveGrainSize` call site that has run, sorted by
+ * the time spent in their chunks. Loops with many serial calls or few chunks per call are
+ * under-parallelized. Chunk counts and times are extrapolated from the sampled chunks.
+ */
+void BLI_task_parallel_for_stats_print(void);
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -433,6 +456,22 @@ void BLI_task_isolate(void (*func)(void *userdata), void *userdata);
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name NUMA Nodes
+ *
+ * On systems with multiple NUMA nodes, each node has its own task arena with threads pinned to
+ * the cores of the node. Work executed there allocates and accesses memory local to the node,
+ * instead of moving between sockets. Nested task pools and parallel ranges are executed by the
+ * threads of the node as well.
+ *
+ * When the node does not exist, for example on systems with a single node, the work is executed
+ * on any thread as usual.
+ * \{ */
+
+void BLI_task_numa_node_isolate(int numa_node, void (*func)(void *userdata), void *userdata);
+
+/** \} */
+
 #ifdef __cplusplus
 }
 #endif
@@ -30,9 +30,19 @@
 #  endif
 #endif
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
 #include "BLI_index_range.hh"
 #include "BLI_utildefines.h"
 
+/* Declared here as well, because including BLI_task.h would pull in the `ThreadLocal` macro from
+ * BLI_threads.h, which conflicts with other libraries (e.g. GTest). */
+extern "C" void BLI_task_numa_node_isolate(int numa_node,
+                                           void (*func)(void *userdata),
+                                           void *userdata);
+
 namespace blender::threading {
 
 template<typename Range, typename Function>
@@ -69,6 +79,130 @@ void parallel_for(IndexRange range, int64_t grain_size, const Function &function
   function(range);
 }
 
+/**
+ * Grain size of a #parallel_for call site that is tuned from the measured cost of its chunks,
+ * so that every chunk runs long enough to amortize the scheduling overhead. Declare it static
+ * next to the loop so the estimate and the counters persist across calls:
+ *
+ * \code{.cc}
+ * static threading::AdaptiveGrainSize grain_size("mesh_calc_normals_poly");
+ * threading::parallel_for(polys.index_range(), grain_size, [&](IndexRange range) { ... });
+ * \endcode
+ *
+ * The counters of all call sites are printed by #BLI_task_parallel_for_stats_print.
+ */
+class AdaptiveGrainSize {
+ public:
+  /** Target duration of a single chunk. */
+  static constexpr int64_t target_chunk_ns = 50000;
+  /**
+   * Only one in this many chunks of every thread is timed and counted, so that most chunks don't
+   * pay for reading the clock and updating the shared counters.
+   */
+  static constexpr int sample_interval = 8;
+
+  const char *name;
+  /** Grain size used until the first chunk has been measured. */
+  const int64_t initial_grain_size;
+
+  std::atomic<int64_t> calls_num = 0;
+  /** Calls that were run on the calling thread, because the range was smaller than the grain. */
+  std::atomic<int64_t> serial_calls_num = 0;
+  std::atomic<int64_t> items_num = 0;
+  /** Counters of the timed chunks only. */
+  std::atomic<int64_t> sampled_chunks_num = 0;
+  std::atomic<int64_t> sampled_items_num = 0;
+  std::atomic<int64_t> sampled_time_ns = 0;
+
+  AdaptiveGrainSize *next = nullptr;
+
+  AdaptiveGrainSize(const char *name, int64_t initial_grain_size = 512);
+
+  int64_t grain_size() const
+  {
+    const double ns_per_item = ns_per_item_.load(std::memory_order_relaxed);
+    if (ns_per_item <= 0.0) {
+      return initial_grain_size;
+    }
+    return std::max<int64_t>(1, int64_t(double(target_chunk_ns) / ns_per_item));
+  }
+
+  /** Update the estimate from a timed chunk of `items` that took `ns` nanoseconds. */
+  void add_chunk_sample(const int64_t items, const int64_t ns)
+  {
+    sampled_chunks_num.fetch_add(1, std::memory_order_relaxed);
+    sampled_items_num.fetch_add(items, std::memory_order_relaxed);
+    sampled_time_ns.fetch_add(ns, std::memory_order_relaxed);
+
+    /* Exponential moving average, concurrent updates may get lost which is fine here. */
+    const double sample = double(std::max<int64_t>(ns, 1)) / double(items);
+    const double ns_per_item = ns_per_item_.load(std::memory_order_relaxed);
+    ns_per_item_.store(ns_per_item <= 0.0 ? sample : ns_per_item * 0.875 + sample * 0.125,
+                       std::memory_order_relaxed);
+  }
+
+  /** Time spent in all chunks, extrapolated from the timed ones. */
+  double estimated_time_ns() const
+  {
+    const int64_t sampled_items = sampled_items_num.load(std::memory_order_relaxed);
+    if (sampled_items == 0) {
+      return 0.0;
+    }
+    return double(sampled_time_ns.load(std::memory_order_relaxed)) *
+           double(items_num.load(std::memory_order_relaxed)) / double(sampled_items);
+  }
+
+  /**
+   * True for one in #sample_interval chunks run on the current thread, starting with the first.
+   * The counter is per thread so deciding costs no shared memory access.
+   */
+  static bool sample_chunk()
+  {
+    static thread_local int chunk_counter = 0;
+    const bool sample = chunk_counter == 0;
+    chunk_counter = (chunk_counter + 1) % sample_interval;
+    return sample;
+  }
+
+ private:
+  std::atomic<double> ns_per_item_ = 0.0;
+};
+
+/**
+ * Same as #parallel_for with a fixed grain size, but the grain size is derived from the time
+ * the chunks of previous calls took.
+ */
+template<typename Function>
+void parallel_for(IndexRange range, AdaptiveGrainSize &grain_size, const Function &function)
+{
+  if (range.size() == 0) {
+    return;
+  }
+  using Clock = std::chrono::steady_clock;
+  const auto timed_function = [&](const IndexRange subrange) {
+    if (!AdaptiveGrainSize::sample_chunk()) {
+      function(subrange);
+      return;
+    }
+    const Clock::time_point start = Clock::now();
+    function(subrange);
+    const Clock::duration duration = Clock::now() - start;
+    grain_size.add_chunk_sample(
+        subrange.size(),
+        std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+  };
+
+  grain_size.calls_num.fetch_add(1, std::memory_order_relaxed);
+  grain_size.items_num.fetch_add(range.size(), std::memory_order_relaxed);
+  const int64_t grain = grain_size.grain_size();
+  if (range.size() < grain) {
+    grain_size.serial_calls_num.fetch_add(1, std::memory_order_relaxed);
+    timed_function(range);
+    return;
+  }
+  parallel_for(range, grain, timed_function);
+}
+
 template<typename Value, typename Function, typename Reduction>
 Value parallel_reduce(IndexRange range,
                       int64_t grain_size,
@@ -103,6 +237,18 @@ template<typename... Functions> void parallel_invoke(Functions &&...functions)
 #endif
 }
 
+/**
+ * Execute the function on the threads of the NUMA node, see #BLI_task_numa_node_isolate.
+ * Parallel loops started from the function stay on the node.
+ */
+template<typename Function> void numa_node_isolate(const int numa_node, const Function &function)
+{
+  BLI_task_numa_node_isolate(
+      numa_node,
+      [](void *userdata) { (*static_cast<const Function *>(userdata))(); },
+      const_cast<Function *>(&function));
+}
+
 /** See #BLI_task_isolate for a description of what isolating a task means. */
 template<typename Function> void isolate_task(const Function &function)
 {
@@ -1209,6 +1209,16 @@ template<typename T> class SingleAsSpan {
     UNUSED_VARS_NDEBUG(index);
     return value_;
   }
+
+  int64_t size() const
+  {
+    return size_;
+  }
+
+  IndexRange index_range() const
+  {
+    return IndexRange(size_);
+  }
 };
 
 /**
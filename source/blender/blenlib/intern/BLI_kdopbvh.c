@@ -371,30 +371,80 @@ static void create_kdop_hull(
 /**
  * \note depends on the fact that the BVH's for each face is already built
  */
-static void refit_kdop_hull(const BVHTree *tree, BVHNode *node, int start, int end)
+static void refit_kdop_hull_bv_union(const BVHTree *tree,
+                                     float *__restrict bv,
+                                     const float *__restrict node_bv)
 {
   float newmin, newmax;
+  axis_t axis_iter;
+
+  /* for all Axes. */
+  for (axis_iter = tree->start_axis; axis_iter < tree->stop_axis; axis_iter++) {
+    newmin = node_bv[(2 * axis_iter)];
+    if ((newmin < bv[(2 * axis_iter)])) {
+      bv[(2 * axis_iter)] = newmin;
+    }
+
+    newmax = node_bv[(2 * axis_iter) + 1];
+    if ((newmax > bv[(2 * axis_iter) + 1])) {
+      bv[(2 * axis_iter) + 1] = newmax;
+    }
+  }
+}
+
+typedef struct RefitKdopHullChunk {
+  float bv[13 * 2];
+} RefitKdopHullChunk;
+
+static void refit_kdop_hull_task_cb(void *__restrict userdata,
+                                    const int j,
+                                    const TaskParallelTLS *__restrict tls)
+{
+  const BVHTree *tree = userdata;
+  RefitKdopHullChunk *chunk = tls->userdata_chunk;
+  refit_kdop_hull_bv_union(tree, chunk->bv, tree->nodes[j]->bv);
+}
+
+static void refit_kdop_hull_reduce(const void *__restrict userdata,
+                                   void *__restrict chunk_join,
+                                   void *__restrict chunk)
+{
+  const BVHTree *tree = userdata;
+  RefitKdopHullChunk *join = chunk_join;
+  const RefitKdopHullChunk *from = chunk;
+  refit_kdop_hull_bv_union(tree, join->bv, from->bv);
+}
+
+static void refit_kdop_hull(const BVHTree *tree, BVHNode *node, int start, int end)
+{
   float *__restrict bv = node->bv;
   int j;
-  axis_t axis_iter;
 
   node_minmax_init(tree, node);
 
-  for (j = start; j < end; j++) {
-    float *__restrict node_bv = tree->nodes[j]->bv;
+  /* The top levels of the tree span most of the leafs, but there are only a few of them to
+   * build in parallel. Split the bounds computation itself for those. */
+  if (end - start > KDOPBVH_THREAD_LEAF_THRESHOLD * 16) {
+    RefitKdopHullChunk chunk;
+    for (axis_t axis_iter = tree->start_axis; axis_iter < tree->stop_axis; axis_iter++) {
+      chunk.bv[(2 * axis_iter)] = FLT_MAX;
+      chunk.bv[(2 * axis_iter) + 1] = -FLT_MAX;
+    }
 
-    /* for all Axes. */
-    for (axis_iter = tree->start_axis; axis_iter < tree->stop_axis; axis_iter++) {
-      newmin = node_bv[(2 * axis_iter)];
-      if ((newmin < bv[(2 * axis_iter)])) {
-        bv[(2 * axis_iter)] = newmin;
-      }
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = KDOPBVH_THREAD_LEAF_THRESHOLD;
+    settings.userdata_chunk = &chunk;
+    settings.userdata_chunk_size = sizeof(chunk);
+    settings.func_reduce = refit_kdop_hull_reduce;
+    BLI_task_parallel_range(start, end, (void *)tree, refit_kdop_hull_task_cb, &settings);
 
-      newmax = node_bv[(2 * axis_iter) + 1];
-      if ((newmax > bv[(2 * axis_iter) + 1])) {
-        bv[(2 * axis_iter) + 1] = newmax;
-      }
-    }
+    refit_kdop_hull_bv_union(tree, bv, chunk.bv);
+    return;
+  }
+
+  for (j = start; j < end; j++) {
+    refit_kdop_hull_bv_union(tree, bv, tree->nodes[j]->bv);
   }
 }
 
@@ -994,6 +1044,62 @@ void BLI_bvhtree_insert(BVHTree *tree, int index, const float co[3], int numpoin
   bvhtree_node_inflate(tree, node, tree->epsilon);
 }
 
+typedef struct BVHInsertRangeData {
+  BVHTree *tree;
+  int leaf_start;
+  int numpoints;
+  BVHTree_LeafCoordsCallback coords_fn;
+  void *userdata;
+} BVHInsertRangeData;
+
+static void bvhtree_insert_range_cb(void *__restrict userdata,
+                                    const int index,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const BVHInsertRangeData *data = (const BVHInsertRangeData *)userdata;
+  BVHTree *tree = data->tree;
+
+  float co[BVH_INSERT_RANGE_MAX_POINTS][3];
+  data->coords_fn(data->userdata, index, co);
+
+  const int leaf_index = data->leaf_start + index;
+  BVHNode *node = tree->nodes[leaf_index] = &(tree->nodearray[leaf_index]);
+  create_kdop_hull(tree, node, co[0], data->numpoints, 0);
+  node->index = index;
+
+  /* inflate the bv with some epsilon */
+  bvhtree_node_inflate(tree, node, tree->epsilon);
+}
+
+void BLI_bvhtree_insert_range(BVHTree *tree,
+                              const int leaf_num,
+                              const int numpoints,
+                              BVHTree_LeafCoordsCallback coords_fn,
+                              void *userdata)
+{
+  /* insert should only possible as long as tree->branch_num is 0 */
+  BLI_assert(tree->branch_num <= 0);
+  BLI_assert((size_t)(tree->leaf_num + leaf_num) <=
+             MEM_allocN_len(tree->nodes) / sizeof(*(tree->nodes)));
+  BLI_assert(numpoints <= BVH_INSERT_RANGE_MAX_POINTS);
+
+  BVHInsertRangeData data = {
+      .tree = tree,
+      .leaf_start = tree->leaf_num,
+      .numpoints = numpoints,
+      .coords_fn = coords_fn,
+      .userdata = userdata,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (leaf_num > KDOPBVH_THREAD_LEAF_THRESHOLD);
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(0, leaf_num, &data, bvhtree_insert_range_cb, &settings);
+
+  tree->leaf_num += leaf_num;
+}
+
 bool BLI_bvhtree_update_node(
     BVHTree *tree, int index, const float co[3], const float co_moving[3], int numpoints)
 {
@@ -207,6 +207,29 @@ void *BLI_mmap_get_pointer(BLI_mmap_file *file)
   return file->memory;
 }
 
+void BLI_mmap_release(BLI_mmap_file *file, size_t offset, size_t length)
+{
+  if (file->io_error || (offset + length > file->length)) {
+    return;
+  }
+
+#ifndef WIN32
+  const size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+  /* Round inwards to page boundaries, partially used pages are kept. */
+  const size_t start = ((offset + page_size - 1) / page_size) * page_size;
+  const size_t end = ((offset + length) / page_size) * page_size;
+  if (start < end) {
+    /* The mapping is private and read-only, so the pages are simply dropped and will be
+     * read from the file again if they are accessed later. */
+    madvise(file->memory + start, end - start, MADV_DONTNEED);
+  }
+#else
+  /* There's no equivalent for file-backed views that is available on all supported versions,
+   * the pages are left to the working set manager. */
+  UNUSED_VARS(offset, length);
+#endif
+}
+
 void BLI_mmap_free(BLI_mmap_file *file)
 {
 #ifndef WIN32
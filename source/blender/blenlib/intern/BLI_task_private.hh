@@ -0,0 +1,30 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * Task arenas created by the task scheduler, shared by task pools and parallel ranges without
+ * exposing TBB types publicly.
+ */
+
+#ifdef WITH_TBB
+#  include <tbb/task_arena.h>
+
+namespace blender::threading {
+
+/**
+ * Arena with threads pinned to the cores of the NUMA node,
+ * null when the node does not exist or NUMA is not supported.
+ */
+tbb::task_arena *task_scheduler_numa_arena(int numa_node);
+
+/**
+ * Arena for #TASK_PRIORITY_LOW task pools, which only gets the threads that are not needed by
+ * the default arena. Null when priorities are set on the task group context instead.
+ */
+tbb::task_arena *task_scheduler_low_priority_arena();
+
+}  // namespace blender::threading
+#endif
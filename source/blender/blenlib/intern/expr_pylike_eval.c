@@ -18,9 +18,11 @@
  *      +, -, *, /, ==, !=, <, <=, >, >=, and, or, not, ternary if
  *  - Functions:
  *      min, max, radians, degrees,
- *      abs, fabs, floor, ceil, trunc, int,
+ *      abs, fabs, floor, ceil, trunc, int, float, bool,
  *      sin, cos, tan, asin, acos, atan, atan2,
- *      exp, log, sqrt, pow, fmod
+ *      sinh, cosh, tanh, asinh, acosh, atanh,
+ *      exp, expm1, log, log1p, log2, log10, sqrt, pow, fmod, hypot, copysign,
+ *      lerp, clamp, smoothstep
  *
  * The implementation has no global state and can be used multi-threaded.
  */
@@ -340,6 +342,16 @@ static double op_smoothstep(double a, double b, double x)
   return t * t * (3.0 - 2.0 * t);
 }
 
+static double op_float(double a)
+{
+  return a;
+}
+
+static double op_bool(double a)
+{
+  return a ? 1.0 : 0.0;
+}
+
 static double op_not(double a)
 {
   return a ? 0.0 : 1.0;
@@ -406,6 +418,8 @@ static BuiltinOpDef builtin_ops[] = {
     {"trunc", OPCODE_FUNC1, trunc},
     {"round", OPCODE_FUNC1, round},
     {"int", OPCODE_FUNC1, trunc},
+    {"float", OPCODE_FUNC1, op_float},
+    {"bool", OPCODE_FUNC1, op_bool},
     {"sin", OPCODE_FUNC1, sin},
     {"cos", OPCODE_FUNC1, cos},
     {"tan", OPCODE_FUNC1, tan},
@@ -413,12 +427,24 @@ static BuiltinOpDef builtin_ops[] = {
     {"acos", OPCODE_FUNC1, acos},
     {"atan", OPCODE_FUNC1, atan},
     {"atan2", OPCODE_FUNC2, atan2},
+    {"sinh", OPCODE_FUNC1, sinh},
+    {"cosh", OPCODE_FUNC1, cosh},
+    {"tanh", OPCODE_FUNC1, tanh},
+    {"asinh", OPCODE_FUNC1, asinh},
+    {"acosh", OPCODE_FUNC1, acosh},
+    {"atanh", OPCODE_FUNC1, atanh},
     {"exp", OPCODE_FUNC1, exp},
+    {"expm1", OPCODE_FUNC1, expm1},
     {"log", OPCODE_FUNC1, log},
     {"log", OPCODE_FUNC2, op_log2},
+    {"log1p", OPCODE_FUNC1, log1p},
+    {"log2", OPCODE_FUNC1, log2},
+    {"log10", OPCODE_FUNC1, log10},
     {"sqrt", OPCODE_FUNC1, sqrt},
     {"pow", OPCODE_FUNC2, pow},
     {"fmod", OPCODE_FUNC2, fmod},
+    {"hypot", OPCODE_FUNC2, hypot},
+    {"copysign", OPCODE_FUNC2, copysign},
     {"lerp", OPCODE_FUNC3, op_lerp},
     {"clamp", OPCODE_FUNC1, op_clamp},
     {"clamp", OPCODE_FUNC3, op_clamp3},
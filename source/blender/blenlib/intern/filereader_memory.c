@@ -86,6 +86,11 @@ FileReader *BLI_filereader_new_memory(const void *data, size_t len)
  * This avoids system call overhead and can significantly speed up file loading.
  */
 
+/* Reads of at least this size are assumed to be block data that is copied into its final
+ * allocation, so the mapped pages are released afterwards. This avoids keeping both the mapped
+ * file and the loaded data resident, which would double the peak memory usage for big arrays. */
+#define MMAP_RELEASE_THRESHOLD (1 << 20) /* 1mb */
+
 static ssize_t memory_read_mmap(FileReader *reader, void *buffer, size_t size)
 {
   MemoryReader *mem = (MemoryReader *)reader;
@@ -97,6 +102,10 @@ static ssize_t memory_read_mmap(FileReader *reader, void *buffer, size_t size)
     return 0;
   }
 
+  if (readsize >= MMAP_RELEASE_THRESHOLD) {
+    BLI_mmap_release(mem->mmap, mem->reader.offset, readsize);
+  }
+
   mem->reader.offset += readsize;
 
   return readsize;
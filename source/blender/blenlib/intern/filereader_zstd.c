@@ -12,9 +12,21 @@
 #include "BLI_endian_switch.h"
 #include "BLI_filereader.h"
 #include "BLI_math_base.h"
+#include "BLI_task.h"
 
 #include "MEM_guardedalloc.h"
 
+/* Upper limit for the amount of frames that are decompressed ahead of the current read position.
+ * The file writer uses 1mb frames, so this bounds the memory used by each window of frames. */
+#define ZSTD_PREFETCH_FRAMES_MAX 64
+
+/* Range of decompressed frames, starting at `first_frame`. */
+typedef struct ZstdFrameWindow {
+  char **content;
+  int first_frame;
+  int frames_num;
+} ZstdFrameWindow;
+
 typedef struct {
   FileReader reader;
 
@@ -29,8 +41,17 @@ typedef struct {
     size_t *compressed_ofs;
     size_t *uncompressed_ofs;
 
-    char *cached_content;
-    int cached_frame;
+    /* Window of frames that reads are served from. */
+    ZstdFrameWindow cached;
+    /* Window following `cached`, decompressed by `prefetch_pool` while reading from `cached`. */
+    ZstdFrameWindow prefetched;
+    TaskPool *prefetch_pool;
+
+    /* Maximum size of a window, each slot has its own decompression context
+     * so that the frames of a window can be decompressed in parallel. Only one
+     * window is decompressed at a time, so the contexts are shared by both. */
+    int prefetch_frames_max;
+    ZSTD_DCtx **prefetch_ctx;
   } seek;
 } ZstdReader;
 
@@ -126,7 +147,20 @@ static bool zstd_read_seek_table(ZstdReader *zstd)
     return false;
   }
 
-  zstd->seek.cached_frame = -1;
+  zstd->seek.cached.first_frame = -1;
+  zstd->seek.prefetched.first_frame = -1;
+
+  /* Keep enough frames in flight to give every thread some work. */
+  zstd->seek.prefetch_frames_max = clamp_i(
+      BLI_task_scheduler_num_threads() * 2, 1, ZSTD_PREFETCH_FRAMES_MAX);
+  zstd->seek.cached.content = MEM_calloc_arrayN(
+      zstd->seek.prefetch_frames_max, sizeof(char *), __func__);
+  zstd->seek.prefetched.content = MEM_calloc_arrayN(
+      zstd->seek.prefetch_frames_max, sizeof(char *), __func__);
+  zstd->seek.prefetch_ctx = MEM_calloc_arrayN(
+      zstd->seek.prefetch_frames_max, sizeof(ZSTD_DCtx *), __func__);
+  /* The first slot reuses the main context, the others are created on demand. */
+  zstd->seek.prefetch_ctx[0] = zstd->ctx;
 
   return true;
 }
@@ -154,41 +188,187 @@ static int zstd_frame_from_pos(ZstdReader *zstd, size_t pos)
   return low;
 }
 
-/* Ensure that the currently loaded frame is the correct one. */
-static const char *zstd_ensure_cache(ZstdReader *zstd, int frame)
+typedef struct ZstdPrefetchData {
+  ZstdReader *zstd;
+  ZstdFrameWindow *window;
+  const char *compressed_data;
+  /* Set for every frame that failed to decompress. */
+  bool *failed;
+} ZstdPrefetchData;
+
+static void zstd_decompress_frame_task(void *__restrict userdata,
+                                       const int slot,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  if (zstd->seek.cached_frame == frame) {
-    /* Cached frame matches, so just return it. */
-    return zstd->seek.cached_content;
-  }
+  ZstdPrefetchData *data = userdata;
+  ZstdReader *zstd = data->zstd;
+  const int first_frame = data->window->first_frame;
+  const int frame = first_frame + slot;
 
-  /* Cached frame doesn't match, so discard it and cache the wanted one instead. */
-  MEM_SAFE_FREE(zstd->seek.cached_content);
+  if (zstd->seek.prefetch_ctx[slot] == NULL) {
+    zstd->seek.prefetch_ctx[slot] = ZSTD_createDCtx();
+  }
 
-  size_t compressed_size = zstd->seek.compressed_ofs[frame + 1] - zstd->seek.compressed_ofs[frame];
-  size_t uncompressed_size = zstd->seek.uncompressed_ofs[frame + 1] -
-                             zstd->seek.uncompressed_ofs[frame];
+  const size_t compressed_size = zstd->seek.compressed_ofs[frame + 1] -
+                                 zstd->seek.compressed_ofs[frame];
+  const size_t uncompressed_size = zstd->seek.uncompressed_ofs[frame + 1] -
+                                   zstd->seek.uncompressed_ofs[frame];
+  const size_t offset_in_window = zstd->seek.compressed_ofs[frame] -
+                                  zstd->seek.compressed_ofs[first_frame];
+  const char *compressed_data = data->compressed_data + offset_in_window;
 
   char *uncompressed_data = MEM_mallocN(uncompressed_size, __func__);
+  size_t res = ZSTD_decompressDCtx(zstd->seek.prefetch_ctx[slot],
+                                   uncompressed_data,
+                                   uncompressed_size,
+                                   compressed_data,
+                                   compressed_size);
+  if (ZSTD_isError(res) || res < uncompressed_size) {
+    MEM_freeN(uncompressed_data);
+    uncompressed_data = NULL;
+    data->failed[slot] = true;
+  }
+  data->window->content[slot] = uncompressed_data;
+}
+
+static void zstd_window_free(ZstdFrameWindow *window)
+{
+  for (int i = 0; i < window->frames_num; i++) {
+    MEM_SAFE_FREE(window->content[i]);
+  }
+  window->first_frame = -1;
+  window->frames_num = 0;
+}
+
+/* Read and decompress `frames_num` frames starting at `frame` into `window`, in parallel.
+ * On failure the window only keeps the frames before the first broken one. */
+static void zstd_window_decompress(ZstdReader *zstd,
+                                   ZstdFrameWindow *window,
+                                   const int frame,
+                                   const int frames_num)
+{
+  window->first_frame = frame;
+  window->frames_num = 0;
+
+  /* The frames are stored contiguously, so read all of their compressed data at once. */
+  size_t compressed_size = zstd->seek.compressed_ofs[frame + frames_num] -
+                           zstd->seek.compressed_ofs[frame];
   char *compressed_data = MEM_mallocN(compressed_size, __func__);
   if (zstd->base->seek(zstd->base, zstd->seek.compressed_ofs[frame], SEEK_SET) < 0 ||
       zstd->base->read(zstd->base, compressed_data, compressed_size) < compressed_size) {
     MEM_freeN(compressed_data);
-    MEM_freeN(uncompressed_data);
-    return NULL;
+    return;
   }
 
-  size_t res = ZSTD_decompressDCtx(
-      zstd->ctx, uncompressed_data, uncompressed_size, compressed_data, compressed_size);
+  bool failed[ZSTD_PREFETCH_FRAMES_MAX] = {false};
+  ZstdPrefetchData data = {
+      .zstd = zstd,
+      .window = window,
+      .compressed_data = compressed_data,
+      .failed = failed,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (frames_num > 1);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, frames_num, &data, zstd_decompress_frame_task, &settings);
   MEM_freeN(compressed_data);
-  if (ZSTD_isError(res) || res < uncompressed_size) {
-    MEM_freeN(uncompressed_data);
+
+  /* Only keep the frames up to the first failure, reading will stop there anyway. */
+  int valid_frames_num = 0;
+  while (valid_frames_num < frames_num && !failed[valid_frames_num]) {
+    valid_frames_num++;
+  }
+  for (int i = valid_frames_num; i < frames_num; i++) {
+    MEM_SAFE_FREE(window->content[i]);
+  }
+  window->frames_num = valid_frames_num;
+}
+
+static void zstd_prefetch_task(TaskPool *__restrict pool, void *UNUSED(taskdata))
+{
+  ZstdReader *zstd = BLI_task_pool_user_data(pool);
+  ZstdFrameWindow *window = &zstd->seek.prefetched;
+  zstd_window_decompress(zstd, window, window->first_frame, window->frames_num);
+}
+
+/* Wait for the prefetching of the next window to finish. Has to be called before accessing
+ * the base reader, the prefetch contexts or the prefetched window. */
+static void zstd_prefetch_wait(ZstdReader *zstd)
+{
+  if (zstd->seek.prefetch_pool) {
+    BLI_task_pool_work_and_wait(zstd->seek.prefetch_pool);
+    BLI_task_pool_free(zstd->seek.prefetch_pool);
+    zstd->seek.prefetch_pool = NULL;
+  }
+}
+
+/* Start decompressing the window following the cached one in the background. */
+static void zstd_prefetch_start(ZstdReader *zstd)
+{
+  BLI_assert(zstd->seek.prefetch_pool == NULL && zstd->seek.prefetched.frames_num == 0);
+
+  const int frame = zstd->seek.cached.first_frame + zstd->seek.cached.frames_num;
+  const int frames_num = min_ii(zstd->seek.prefetch_frames_max, zstd->seek.frames_num - frame);
+  if (frames_num <= 0) {
+    return;
+  }
+
+  /* The task sets the actual amount of decompressed frames. */
+  zstd->seek.prefetched.first_frame = frame;
+  zstd->seek.prefetched.frames_num = frames_num;
+  zstd->seek.prefetch_pool = BLI_task_pool_create(zstd, TASK_PRIORITY_HIGH);
+  BLI_task_pool_push(zstd->seek.prefetch_pool, zstd_prefetch_task, NULL, false, NULL);
+}
+
+/* Ensure that the given frame is part of the currently loaded window of frames.
+ *
+ * The first read and random access only decompress the frame that is needed. Once reading
+ * continues past the cached frames (the common case when reading a .blend file), a whole
+ * window of frames is decompressed in parallel, so that decompression scales with the amount
+ * of threads instead of being bound by a single one, and the window following it is read and
+ * decompressed in the background while the caller processes the current one. */
+static const char *zstd_ensure_cache(ZstdReader *zstd, int frame)
+{
+  ZstdFrameWindow *cached = &zstd->seek.cached;
+  if (frame >= cached->first_frame && frame < cached->first_frame + cached->frames_num) {
+    /* Cached window contains the frame, so just return it. */
+    return cached->content[frame - cached->first_frame];
+  }
+
+  /* Reading continues right after the cached window. A cold cache or random access only
+   * decompresses the wanted frame, so short reads of the file start (e.g. for thumbnails)
+   * don't pay for a whole window they don't use. */
+  const bool is_continued = (cached->frames_num > 0) &&
+                            (frame == cached->first_frame + cached->frames_num);
+
+  /* Cached window doesn't contain the frame, so discard it and cache the wanted one instead. */
+  zstd_prefetch_wait(zstd);
+  zstd_window_free(cached);
+
+  ZstdFrameWindow *prefetched = &zstd->seek.prefetched;
+  if (prefetched->frames_num > 0 && frame == prefetched->first_frame) {
+    /* The wanted window was prefetched, swap it in. */
+    SWAP(ZstdFrameWindow, *cached, *prefetched);
+  }
+  else {
+    zstd_window_free(prefetched);
+    const int frames_num = is_continued ? min_ii(zstd->seek.prefetch_frames_max,
+                                                 zstd->seek.frames_num - frame) :
+                                          1;
+    zstd_window_decompress(zstd, cached, frame, frames_num);
+  }
+
+  if (cached->frames_num == 0) {
+    cached->first_frame = -1;
     return NULL;
   }
 
-  zstd->seek.cached_frame = frame;
-  zstd->seek.cached_content = uncompressed_data;
-  return uncompressed_data;
+  if (is_continued) {
+    zstd_prefetch_start(zstd);
+  }
+  return cached->content[0];
 }
 
 static ssize_t zstd_read_seekable(FileReader *reader, void *buffer, size_t size)
@@ -277,11 +457,24 @@ static void zstd_close(FileReader *reader)
 {
   ZstdReader *zstd = (ZstdReader *)reader;
 
+  if (zstd->reader.seek) {
+    zstd_prefetch_wait(zstd);
+  }
   ZSTD_freeDCtx(zstd->ctx);
   if (zstd->reader.seek) {
+    zstd_window_free(&zstd->seek.cached);
+    zstd_window_free(&zstd->seek.prefetched);
+    /* The first slot is the main context, which is already freed. */
+    for (int i = 1; i < zstd->seek.prefetch_frames_max; i++) {
+      if (zstd->seek.prefetch_ctx[i]) {
+        ZSTD_freeDCtx(zstd->seek.prefetch_ctx[i]);
+      }
+    }
+    MEM_freeN(zstd->seek.prefetch_ctx);
+    MEM_freeN(zstd->seek.cached.content);
+    MEM_freeN(zstd->seek.prefetched.content);
     MEM_freeN(zstd->seek.uncompressed_ofs);
     MEM_freeN(zstd->seek.compressed_ofs);
-    MEM_freeN(zstd->seek.cached_content);
   }
   else {
     MEM_freeN((void *)zstd->in_buf.src);
@@ -8,6 +8,7 @@
 
 #include "BLI_kdtree_impl.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_strict_flags.h"
 #include "BLI_utildefines.h"
 
@@ -318,6 +319,49 @@ int BLI_kdtree_nd_(find_nearest)(const KDTree *tree,
   return min_node->index;
 }
 
+typedef struct KDTreeFindNearestBatchData {
+  const KDTree *tree;
+  const float (*co)[KD_DIMS];
+  int *r_index;
+  KDTreeNearest *r_nearest;
+} KDTreeFindNearestBatchData;
+
+static void find_nearest_batch_cb(void *__restrict userdata,
+                                  const int i,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const KDTreeFindNearestBatchData *data = userdata;
+  data->r_index[i] = BLI_kdtree_nd_(find_nearest)(
+      data->tree, data->co[i], data->r_nearest ? &data->r_nearest[i] : NULL);
+}
+
+/**
+ * Find the nearest point for each of `co_len` points, using multiple threads.
+ * The results are the same as calling #BLI_kdtree_3d_find_nearest for each point.
+ *
+ * \param r_index: Array of `co_len` indices, set to -1 when the tree is empty.
+ * \param r_nearest: Optional array of `co_len` nearest points.
+ */
+void BLI_kdtree_nd_(find_nearest_batch)(const KDTree *tree,
+                                        const float (*co)[KD_DIMS],
+                                        const int co_len,
+                                        int *r_index,
+                                        KDTreeNearest *r_nearest)
+{
+  KDTreeFindNearestBatchData data = {
+      .tree = tree,
+      .co = co,
+      .r_index = r_index,
+      .r_nearest = r_nearest,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (co_len > 1024);
+  settings.min_iter_per_thread = 256;
+  BLI_task_parallel_range(0, co_len, &data, find_nearest_batch_cb, &settings);
+}
+
 /**
  * A version of #BLI_kdtree_3d_find_nearest which runs a callback
  * to filter out values.
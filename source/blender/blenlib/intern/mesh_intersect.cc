@@ -3028,10 +3028,15 @@ IMesh trimesh_nary_intersect(const IMesh &tm_in,
   std::cout << "subdivided non-cluster tris found, time = " << subdivided_tris_time - itt_time
             << "\n";
 #  endif
+  /* The clusters are triangulated independently. Their sizes vary a lot, so every cluster is a
+   * separate task. */
   Array<CDT_data> cluster_subdivided(clinfo.tot_cluster());
-  for (int c : clinfo.index_range()) {
-    cluster_subdivided[c] = calc_cluster_subdivided(clinfo, c, *tm_clean, tri_ov, itt_map, arena);
-  }
+  threading::parallel_for(clinfo.index_range(), 1, [&](IndexRange range) {
+    for (int c : range) {
+      cluster_subdivided[c] = calc_cluster_subdivided(
+          clinfo, c, *tm_clean, tri_ov, itt_map, arena);
+    }
+  });
 #  ifdef PERFDEBUG
   double cluster_subdivide_time = PIL_check_seconds_timer();
   std::cout << "subdivided clusters found, time = "
@@ -25,6 +25,8 @@
 #  include <tbb/task_group.h>
 #endif
 
+#include "BLI_task_private.hh"
+
 /* Task
  *
  * Unit of work to execute. This is a C++ class to work with TBB. */
@@ -110,9 +112,9 @@ class TBBTaskGroup : public tbb::task_group {
   TBBTaskGroup(eTaskPriority priority)
   {
 #  if TBB_INTERFACE_VERSION_MAJOR >= 12
-    /* TODO: support priorities in TBB 2021, where they are only available as
-     * part of task arenas, no longer for task groups. Or remove support for
-     * task priorities if they are no longer useful. */
+    /* In TBB 2021 priorities are only available as part of task arenas, no longer for task
+     * groups. Low priority pools are executed in their own arena instead, see
+     * #tbb_task_pool_create. */
     UNUSED_VARS(priority);
 #  else
     switch (priority) {
@@ -148,6 +150,8 @@ struct TaskPool {
 #ifdef WITH_TBB
   /* TBB task pool. */
   TBBTaskGroup tbb_group;
+  /* Arena to execute the tasks in, null for the arena of the thread pushing them. */
+  tbb::task_arena *tbb_arena;
 #endif
   volatile bool is_suspended;
   BLI_mempool *suspended_mempool;
@@ -182,12 +186,30 @@ static void tbb_task_pool_create(TaskPool *pool, eTaskPriority priority)
 #ifdef WITH_TBB
   if (pool->use_threads) {
     new (&pool->tbb_group) TBBTaskGroup(priority);
+    pool->tbb_arena = (priority == TASK_PRIORITY_LOW) ?
+                          blender::threading::task_scheduler_low_priority_arena() :
+                          nullptr;
   }
 #else
   UNUSED_VARS(priority);
 #endif
 }
 
+#ifdef WITH_TBB
+/* Spawning and waiting for tasks has to happen within the arena of the pool, the waiting thread
+ * joins the arena to help executing the tasks. */
+template<typename Function>
+static void tbb_task_pool_execute(TaskPool *pool, const Function &function)
+{
+  if (pool->tbb_arena) {
+    pool->tbb_arena->execute(function);
+  }
+  else {
+    function();
+  }
+}
+#endif
+
 static void tbb_task_pool_run(TaskPool *pool, Task &&task)
 {
   if (pool->is_suspended) {
@@ -205,7 +227,7 @@ static void tbb_task_pool_run(TaskPool *pool, Task &&task)
 #ifdef WITH_TBB
   else if (pool->use_threads) {
     /* Execute in TBB task group. */
-    pool->tbb_group.run(std::move(task));
+    tbb_task_pool_execute(pool, [&]() { pool->tbb_group.run(std::move(task)); });
   }
 #endif
   else {
@@ -234,7 +256,7 @@ static void tbb_task_pool_work_and_wait(TaskPool *pool)
     /* This is called wait(), but internally it can actually do work. This
      * matters because we don't want recursive usage of task pools to run
      * out of threads and get stuck. */
-    pool->tbb_group.wait();
+    tbb_task_pool_execute(pool, [&]() { pool->tbb_group.wait(); });
   }
 #endif
 }
@@ -244,7 +266,7 @@ static void tbb_task_pool_cancel(TaskPool *pool)
 #ifdef WITH_TBB
   if (pool->use_threads) {
     pool->tbb_group.cancel();
-    pool->tbb_group.wait();
+    tbb_task_pool_execute(pool, [&]() { pool->tbb_group.wait(); });
   }
 #else
   UNUSED_VARS(pool);
@@ -522,6 +544,19 @@ bool BLI_task_pool_current_canceled(TaskPool *pool)
   return false;
 }
 
+void BLI_task_pool_numa_node_set(TaskPool *pool, const int numa_node)
+{
+#ifdef WITH_TBB
+  if (pool->use_threads && ELEM(pool->type, TASK_POOL_TBB, TASK_POOL_TBB_SUSPENDED)) {
+    if (tbb::task_arena *arena = blender::threading::task_scheduler_numa_arena(numa_node)) {
+      pool->tbb_arena = arena;
+    }
+  }
+#else
+  UNUSED_VARS(pool, numa_node);
+#endif
+}
+
 void *BLI_task_pool_user_data(TaskPool *pool)
 {
   return pool->userdata;
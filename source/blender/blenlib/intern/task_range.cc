@@ -6,6 +6,8 @@
  * Task parallel range functions.
  */
 
+#include <algorithm>
+#include <cstdio>
 #include <cstdlib>
 
 #include "MEM_guardedalloc.h"
@@ -13,7 +15,9 @@
 #include "DNA_listBase.h"
 
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
+#include "BLI_vector.hh"
 
 #include "atomic_ops.h"
 
@@ -24,6 +28,8 @@
 #  include <tbb/parallel_reduce.h>
 #endif
 
+#include "BLI_task_private.hh"
+
 #ifdef WITH_TBB
 
 /* Functor for running TBB parallel_for and parallel_reduce. */
@@ -104,14 +110,24 @@ void BLI_task_parallel_range(const int start,
     const size_t grainsize = MAX2(settings->min_iter_per_thread, 1);
     const tbb::blocked_range<int> range(start, stop, grainsize);
 
-    if (settings->func_reduce) {
-      parallel_reduce(range, task);
-      if (settings->userdata_chunk) {
-        memcpy(settings->userdata_chunk, task.userdata_chunk, settings->userdata_chunk_size);
+    auto run = [&]() {
+      if (settings->func_reduce) {
+        parallel_reduce(range, task);
+        if (settings->userdata_chunk) {
+          memcpy(settings->userdata_chunk, task.userdata_chunk, settings->userdata_chunk_size);
+        }
+      }
+      else {
+        parallel_for(range, task);
       }
+    };
+
+    if (tbb::task_arena *arena = blender::threading::task_scheduler_numa_arena(
+            settings->numa_node)) {
+      arena->execute(run);
     }
     else {
-      parallel_for(range, task);
+      run();
     }
     return;
   }
@@ -151,3 +167,66 @@ int BLI_task_parallel_thread_id(const TaskParallelTLS *UNUSED(tls))
   return 0;
 #endif
 }
+
+/* -------------------------------------------------------------------- */
+/** \name Adaptive Grain Size
+ * \{ */
+
+namespace blender::threading {
+
+/** All call sites, linked when their static is first constructed. */
+static std::atomic<AdaptiveGrainSize *> adaptive_grain_sizes = nullptr;
+
+AdaptiveGrainSize::AdaptiveGrainSize(const char *name, const int64_t initial_grain_size)
+    : name(name), initial_grain_size(initial_grain_size)
+{
+  next = adaptive_grain_sizes.load();
+  while (!adaptive_grain_sizes.compare_exchange_weak(next, this)) {
+    /* Pass. */
+  }
+}
+
+}  // namespace blender::threading
+
+void BLI_task_parallel_for_stats_print(void)
+{
+  using blender::threading::AdaptiveGrainSize;
+
+  blender::Vector<const AdaptiveGrainSize *> call_sites;
+  for (const AdaptiveGrainSize *call_site = blender::threading::adaptive_grain_sizes.load();
+       call_site;
+       call_site = call_site->next) {
+    if (call_site->calls_num > 0) {
+      call_sites.append(call_site);
+    }
+  }
+  std::sort(call_sites.begin(),
+            call_sites.end(),
+            [](const AdaptiveGrainSize *a, const AdaptiveGrainSize *b) {
+              return a->estimated_time_ns() > b->estimated_time_ns();
+            });
+
+  printf("Parallel for call sites:\n");
+  printf("  %-40s %10s %8s %12s %11s %10s %10s\n",
+         "Name",
+         "Calls",
+         "Serial",
+         "Items/Call",
+         "Chunks/Call",
+         "Grain",
+         "CPU (ms)");
+  for (const AdaptiveGrainSize *call_site : call_sites) {
+    const int64_t calls_num = call_site->calls_num;
+    printf("  %-40s %10lld %7.1f%% %12lld %11.1f %10lld %10.2f\n",
+           call_site->name,
+           (long long)calls_num,
+           100.0 * double(call_site->serial_calls_num) / double(calls_num),
+           (long long)(call_site->items_num / calls_num),
+           double(call_site->sampled_chunks_num * AdaptiveGrainSize::sample_interval) /
+               double(calls_num),
+           (long long)call_site->grain_size(),
+           call_site->estimated_time_ns() / 1e6);
+  }
+}
+
+/** \} */
@@ -8,8 +8,10 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_math_base.h"
 #include "BLI_task.h"
 #include "BLI_threads.h"
+#include "BLI_vector.hh"
 
 #ifdef WITH_TBB
 /* Need to include at least one header to get the version define. */
@@ -19,14 +21,55 @@
 #    include <tbb/global_control.h>
 #    define WITH_TBB_GLOBAL_CONTROL
 #  endif
+#  if TBB_INTERFACE_VERSION_MAJOR >= 12
+#    include <tbb/info.h>
+#    define WITH_TBB_ARENA_CONSTRAINTS
+#  endif
 #endif
 
+#include "BLI_task_private.hh"
+
 /* Task Scheduler */
 
 static int task_scheduler_num_threads = 1;
 #ifdef WITH_TBB_GLOBAL_CONTROL
 static tbb::global_control *task_scheduler_global_control = nullptr;
 #endif
+#ifdef WITH_TBB_ARENA_CONSTRAINTS
+/* One arena per NUMA node, only created on systems with multiple nodes. */
+static blender::Vector<tbb::task_arena *> task_scheduler_numa_arenas;
+static tbb::task_arena *task_scheduler_low_priority_arena_ptr = nullptr;
+#endif
+
+#ifdef WITH_TBB_ARENA_CONSTRAINTS
+static void task_scheduler_arenas_init(const int threads_override_num)
+{
+  /* Without the TBBBind library to query the topology, a single unknown node is reported. */
+  const std::vector<tbb::numa_node_id> numa_nodes = tbb::info::numa_nodes();
+  if (numa_nodes.size() > 1) {
+    for (const tbb::numa_node_id numa_node : numa_nodes) {
+      tbb::task_arena::constraints constraints(numa_node);
+      if (threads_override_num > 0) {
+        constraints.set_max_concurrency(max_ii(1, threads_override_num / int(numa_nodes.size())));
+      }
+      task_scheduler_numa_arenas.append(MEM_new<tbb::task_arena>(__func__, constraints));
+    }
+  }
+
+  task_scheduler_low_priority_arena_ptr = MEM_new<tbb::task_arena>(
+      __func__, tbb::task_arena::automatic, 1, tbb::task_arena::priority::low);
+}
+
+static void task_scheduler_arenas_exit()
+{
+  for (tbb::task_arena *arena : task_scheduler_numa_arenas) {
+    MEM_delete(arena);
+  }
+  task_scheduler_numa_arenas.clear_and_make_inline();
+  MEM_delete(task_scheduler_low_priority_arena_ptr);
+  task_scheduler_low_priority_arena_ptr = nullptr;
+}
+#endif
 
 void BLI_task_scheduler_init()
 {
@@ -47,6 +90,9 @@ void BLI_task_scheduler_init()
      * at all. */
     task_scheduler_num_threads = BLI_system_thread_count();
   }
+#  ifdef WITH_TBB_ARENA_CONSTRAINTS
+  task_scheduler_arenas_init(threads_override_num);
+#  endif
 #else
   task_scheduler_num_threads = BLI_system_thread_count();
 #endif
@@ -54,6 +100,9 @@ void BLI_task_scheduler_init()
 
 void BLI_task_scheduler_exit()
 {
+#ifdef WITH_TBB_ARENA_CONSTRAINTS
+  task_scheduler_arenas_exit();
+#endif
 #ifdef WITH_TBB_GLOBAL_CONTROL
   MEM_delete(task_scheduler_global_control);
 #endif
@@ -64,6 +113,15 @@ int BLI_task_scheduler_num_threads()
   return task_scheduler_num_threads;
 }
 
+int BLI_task_scheduler_numa_nodes_num()
+{
+#ifdef WITH_TBB_ARENA_CONSTRAINTS
+  return max_ii(1, int(task_scheduler_numa_arenas.size()));
+#else
+  return 1;
+#endif
+}
+
 void BLI_task_isolate(void (*func)(void *userdata), void *userdata)
 {
 #ifdef WITH_TBB
@@ -72,3 +130,45 @@ void BLI_task_isolate(void (*func)(void *userdata), void *userdata)
   func(userdata);
 #endif
 }
+
+void BLI_task_numa_node_isolate(const int numa_node,
+                                void (*func)(void *userdata),
+                                void *userdata)
+{
+#ifdef WITH_TBB
+  if (tbb::task_arena *arena = blender::threading::task_scheduler_numa_arena(numa_node)) {
+    arena->execute([&] { func(userdata); });
+    return;
+  }
+#else
+  UNUSED_VARS(numa_node);
+#endif
+  func(userdata);
+}
+
+#ifdef WITH_TBB
+namespace blender::threading {
+
+tbb::task_arena *task_scheduler_numa_arena(const int numa_node)
+{
+#  ifdef WITH_TBB_ARENA_CONSTRAINTS
+  if (numa_node >= 0 && numa_node < task_scheduler_numa_arenas.size()) {
+    return task_scheduler_numa_arenas[numa_node];
+  }
+#  else
+  UNUSED_VARS(numa_node);
+#  endif
+  return nullptr;
+}
+
+tbb::task_arena *task_scheduler_low_priority_arena()
+{
+#  ifdef WITH_TBB_ARENA_CONSTRAINTS
+  return task_scheduler_low_priority_arena_ptr;
+#  else
+  return nullptr;
+#  endif
+}
+
+}  // namespace blender::threading
+#endif
@@ -0,0 +1,157 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+#include <mutex>
+
+#include "BLI_concurrent_map.hh"
+#include "BLI_rand.h"
+#include "BLI_task.hh"
+#include "BLI_timeit.hh"
+#include "BLI_vector.hh"
+
+namespace blender::tests {
+
+TEST(concurrent_map, DefaultConstructor)
+{
+  ConcurrentMap<int, float> map;
+  EXPECT_EQ(map.size(), 0);
+  EXPECT_TRUE(map.is_empty());
+}
+
+TEST(concurrent_map, AddLookup)
+{
+  ConcurrentMap<int, float> map;
+  EXPECT_TRUE(map.add(2, 5.0f));
+  EXPECT_TRUE(map.add(3, 6.0f));
+  EXPECT_FALSE(map.add(2, 7.0f));
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_TRUE(map.contains(2));
+  EXPECT_FALSE(map.contains(4));
+  EXPECT_EQ(map.lookup_default(2, 0.0f), 5.0f);
+  EXPECT_EQ(map.lookup_default(4, 1.0f), 1.0f);
+  EXPECT_EQ(map.lookup_try(3), 6.0f);
+  EXPECT_FALSE(map.lookup_try(4).has_value());
+}
+
+TEST(concurrent_map, AddOverwrite)
+{
+  ConcurrentMap<int, float> map;
+  EXPECT_TRUE(map.add_overwrite(1, 2.0f));
+  EXPECT_FALSE(map.add_overwrite(1, 3.0f));
+  EXPECT_EQ(map.lookup_default(1, 0.0f), 3.0f);
+}
+
+TEST(concurrent_map, Remove)
+{
+  ConcurrentMap<int, int> map;
+  map.add(1, 2);
+  map.add(3, 4);
+  EXPECT_TRUE(map.remove(1));
+  EXPECT_FALSE(map.remove(1));
+  EXPECT_FALSE(map.contains(1));
+  EXPECT_TRUE(map.contains(3));
+  EXPECT_EQ(map.size(), 1);
+  map.clear();
+  EXPECT_TRUE(map.is_empty());
+}
+
+TEST(concurrent_map, LookupOrAddCB)
+{
+  ConcurrentMap<int, int> map;
+  int calls = 0;
+  auto create = [&]() {
+    calls++;
+    return 10;
+  };
+  EXPECT_EQ(map.lookup_or_add_cb(0, create), 10);
+  EXPECT_EQ(map.lookup_or_add_cb(0, create), 10);
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(concurrent_map, ForeachItem)
+{
+  ConcurrentMap<int, int> map;
+  for (int i = 0; i < 100; i++) {
+    map.add(i, i * 2);
+  }
+  int key_sum = 0;
+  int value_sum = 0;
+  map.foreach_item([&](const int key, const int value) {
+    key_sum += key;
+    value_sum += value;
+  });
+  EXPECT_EQ(key_sum, 4950);
+  EXPECT_EQ(value_sum, 9900);
+}
+
+TEST(concurrent_map, ParallelAdd)
+{
+  ConcurrentMap<int, int> map;
+  threading::parallel_for(IndexRange(10000), 16, [&](const IndexRange range) {
+    for (const int i : range) {
+      map.add(i, -i);
+    }
+  });
+  EXPECT_EQ(map.size(), 10000);
+  for (const int i : IndexRange(10000)) {
+    EXPECT_EQ(map.lookup_default(i, 0), -i);
+  }
+}
+
+TEST(concurrent_map, ParallelAddOrModify)
+{
+  ConcurrentMap<int, int> map;
+  threading::parallel_for(IndexRange(10000), 16, [&](const IndexRange range) {
+    for (const int i : range) {
+      map.add_or_modify(
+          i % 10, [](int *value) { *value = 1; }, [](int *value) { (*value)++; });
+    }
+  });
+  EXPECT_EQ(map.size(), 10);
+  for (const int i : IndexRange(10)) {
+    EXPECT_EQ(map.lookup_default(i, 0), 1000);
+  }
+}
+
+#if 0
+BLI_NOINLINE void benchmark_parallel_random_ints(int amount)
+{
+  RNG *rng = BLI_rng_new(0);
+  Vector<int> values;
+  for (int i = 0; i < amount; i++) {
+    values.append(BLI_rng_get_int(rng));
+  }
+  BLI_rng_free(rng);
+
+  {
+    Map<int, int> map;
+    std::mutex mutex;
+    SCOPED_TIMER("blender::Map with mutex Add");
+    threading::parallel_for(values.index_range(), 1024, [&](const IndexRange range) {
+      for (const int value : values.as_span().slice(range)) {
+        std::lock_guard lock{mutex};
+        map.add(value, value);
+      }
+    });
+  }
+  {
+    ConcurrentMap<int, int> map;
+    SCOPED_TIMER("blender::ConcurrentMap  Add");
+    threading::parallel_for(values.index_range(), 1024, [&](const IndexRange range) {
+      for (const int value : values.as_span().slice(range)) {
+        map.add(value, value);
+      }
+    });
+  }
+}
+
+TEST(concurrent_map, Benchmark)
+{
+  for (int i = 0; i < 3; i++) {
+    benchmark_parallel_random_ints(1000000);
+  }
+}
+
+#endif /* Benchmark */
+
+}  // namespace blender::tests
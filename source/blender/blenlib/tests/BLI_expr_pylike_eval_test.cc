@@ -156,6 +156,24 @@ TEST_CONST(Pow, "pow(4, 0.5)", 2.0)
 TEST_EVAL(Pow, "pow(4, x)", 0.5, 2.0)
 
 TEST_CONST(Log2_1, "log(4, 2)", 2.0)
+TEST_CONST(Log2_2, "log2(8)", 3.0)
+TEST_CONST(Log10, "log10(100)", 2.0)
+TEST_EVAL(Log10, "log10(x)", 1000.0, 3.0)
+
+TEST_CONST(Hypot, "hypot(3, 4)", 5.0)
+TEST_EVAL(Hypot, "hypot(x, 4)", 3.0, 5.0)
+
+TEST_CONST(CopySign, "copysign(2, -1)", -2.0)
+TEST_EVAL(CopySign, "copysign(2, x)", -0.0, -2.0)
+
+TEST_CONST(Sinh, "sinh(0)", 0.0)
+TEST_CONST(Tanh, "tanh(0)", 0.0)
+TEST_CONST(Cosh, "cosh(0)", 1.0)
+
+TEST_CONST(Float, "float(2)", 2.0)
+TEST_CONST(Bool1, "bool(2)", TRUE_VAL)
+TEST_CONST(Bool2, "bool(0)", FALSE_VAL)
+TEST_EVAL(Bool, "bool(x)", -0.5, TRUE_VAL)
 
 TEST_CONST(Round1, "round(-0.5)", -1.0)
 TEST_CONST(Round2, "round(-0.4)", 0.0)
@@ -338,6 +356,12 @@ TEST_ERROR(PowDomain1, "pow(-1, 0.5)", 0.0, EXPR_PYLIKE_MATH_ERROR)
 TEST_ERROR(PowDomain2, "pow(-1, x)", 0.5, EXPR_PYLIKE_MATH_ERROR)
 TEST_ERROR(PowDomain3, "pow(-1, x)", 2.0, EXPR_PYLIKE_SUCCESS)
 
+TEST_ERROR(Log10Domain1, "log10(x)", -1.0, EXPR_PYLIKE_MATH_ERROR)
+TEST_ERROR(Log10Domain2, "log10(x)", 1.0, EXPR_PYLIKE_SUCCESS)
+
+TEST_ERROR(AcoshDomain1, "acosh(x)", 0.5, EXPR_PYLIKE_MATH_ERROR)
+TEST_ERROR(AcoshDomain2, "acosh(x)", 1.0, EXPR_PYLIKE_SUCCESS)
+
 TEST_ERROR(Mixed1, "sqrt(x) + 1 / max(0, x)", -1.0, EXPR_PYLIKE_MATH_ERROR)
 TEST_ERROR(Mixed2, "sqrt(x) + 1 / max(0, x)", 0.0, EXPR_PYLIKE_DIV_BY_ZERO)
 TEST_ERROR(Mixed3, "sqrt(x) + 1 / max(0, x)", 1.0, EXPR_PYLIKE_SUCCESS)
@@ -66,8 +66,18 @@ static void optimal_check_callback(void *userdata,
  * Note that a small epsilon is added to the BVH nodes bounds, even if we pass in zero.
  * Use rounding to ensure very close nodes don't cause the wrong node to be found as nearest.
  */
-static void find_nearest_points_test(
-    int points_len, float scale, int round, int random_seed, bool optimal = false)
+static void insert_range_coords_callback(void *userdata, int index, float (*r_co)[3])
+{
+  float(*points)[3] = (float(*)[3])userdata;
+  copy_v3_v3(r_co[0], points[index]);
+}
+
+static void find_nearest_points_test(int points_len,
+                                     float scale,
+                                     int round,
+                                     int random_seed,
+                                     bool optimal = false,
+                                     bool insert_range = false)
 {
   struct RNG *rng = BLI_rng_new(random_seed);
   BVHTree *tree = BLI_bvhtree_new(points_len, 0.0, 8, 8);
@@ -77,8 +87,14 @@ static void find_nearest_points_test(
 
   for (int i = 0; i < points_len; i++) {
     rng_v3_round(points[i], 3, rng, round, scale);
-    BLI_bvhtree_insert(tree, i, points[i], 1);
+    if (!insert_range) {
+      BLI_bvhtree_insert(tree, i, points[i], 1);
+    }
+  }
+  if (insert_range) {
+    BLI_bvhtree_insert_range(tree, points_len, 1, insert_range_coords_callback, points);
   }
+  EXPECT_EQ(BLI_bvhtree_get_len(tree), points_len);
   BLI_bvhtree_balance(tree);
 
   /* first find each point */
@@ -132,3 +148,12 @@ TEST(kdopbvh, OptimalFindNearest_500)
 {
   find_nearest_points_test(500, 1.0, 1000, 12, true);
 }
+
+TEST(kdopbvh, InsertRangeFindNearest_500)
+{
+  find_nearest_points_test(500, 1.0, 1000, 12, false, true);
+}
+TEST(kdopbvh, InsertRangeOptimalFindNearest_5000)
+{
+  find_nearest_points_test(5000, 1.0, 1000, 12, true, true);
+}
@@ -3,6 +3,7 @@
 #include "testing/testing.h"
 #include <atomic>
 #include <cstring>
+#include <thread>
 
 #include "atomic_ops.h"
 
@@ -67,6 +68,37 @@ TEST(task, RangeIter)
   BLI_threadapi_exit();
 }
 
+TEST(task, RangeIterNumaNode)
+{
+  BLI_threadapi_init();
+
+  /* Also valid on systems with a single node, or for nodes that don't exist. */
+  for (int numa_node = -1; numa_node <= BLI_task_scheduler_numa_nodes_num(); numa_node++) {
+    int data[ITEMS_NUM] = {0};
+    int sum = 0;
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 1;
+    settings.numa_node = numa_node;
+
+    settings.userdata_chunk = &sum;
+    settings.userdata_chunk_size = sizeof(sum);
+    settings.func_reduce = task_range_iter_reduce_func;
+
+    BLI_task_parallel_range(0, ITEMS_NUM, data, task_range_iter_func, &settings);
+
+    int expected_sum = 0;
+    for (int i = 0; i < ITEMS_NUM; i++) {
+      EXPECT_EQ(data[i], i);
+      expected_sum += i;
+    }
+    EXPECT_EQ(sum, expected_sum);
+  }
+
+  BLI_threadapi_exit();
+}
+
 /* *** Parallel iterations over mempool items. *** */
 
 static void task_mempool_iter_func(void *userdata,
@@ -294,3 +326,63 @@ TEST(task, ParallelInvoke)
                                       [&]() { counter++; });
   EXPECT_EQ(counter, 6);
 }
+
+TEST(task, ParallelForAdaptiveGrainSize)
+{
+  static blender::threading::AdaptiveGrainSize grain_size("ParallelForAdaptiveGrainSize", 16);
+
+  for (int iteration = 0; iteration < 4; iteration++) {
+    std::atomic<int> counter = 0;
+    blender::threading::parallel_for(
+        blender::IndexRange(ITEMS_NUM), grain_size, [&](const blender::IndexRange range) {
+          counter += range.size();
+        });
+    EXPECT_EQ(counter, ITEMS_NUM);
+  }
+
+  EXPECT_EQ(grain_size.calls_num, 4);
+  EXPECT_EQ(grain_size.items_num, 4 * ITEMS_NUM);
+  EXPECT_GE(grain_size.sampled_chunks_num, 1);
+}
+
+TEST(task, AdaptiveGrainSizeEstimate)
+{
+  using blender::threading::AdaptiveGrainSize;
+  static AdaptiveGrainSize grain_size("AdaptiveGrainSizeEstimate", 16);
+  EXPECT_EQ(grain_size.grain_size(), 16);
+
+  /* The first sample is taken as is: 100ns per item. */
+  grain_size.add_chunk_sample(1000, 100000);
+  EXPECT_EQ(grain_size.grain_size(), AdaptiveGrainSize::target_chunk_ns / 100);
+
+  /* Cheaper chunks grow the grain size towards the new cost, without jumping to it. */
+  grain_size.add_chunk_sample(1000, 10000);
+  const int64_t grain_after_one = grain_size.grain_size();
+  EXPECT_GT(grain_after_one, AdaptiveGrainSize::target_chunk_ns / 100);
+  EXPECT_LT(grain_after_one, AdaptiveGrainSize::target_chunk_ns / 10);
+  for (int i = 0; i < 100; i++) {
+    grain_size.add_chunk_sample(1000, 10000);
+  }
+  EXPECT_NEAR(grain_size.grain_size(), AdaptiveGrainSize::target_chunk_ns / 10, 1);
+
+  /* Chunks that take no measurable time don't divide by zero. */
+  grain_size.add_chunk_sample(1000, 0);
+  EXPECT_GE(grain_size.grain_size(), 1);
+}
+
+TEST(task, AdaptiveGrainSizeSampling)
+{
+  using blender::threading::AdaptiveGrainSize;
+  /* Run on a new thread so the thread local counter starts at the first chunk. */
+  std::thread thread([]() {
+    int sampled = 0;
+    for (int i = 0; i < AdaptiveGrainSize::sample_interval * 4; i++) {
+      if (AdaptiveGrainSize::sample_chunk()) {
+        EXPECT_EQ(i % AdaptiveGrainSize::sample_interval, 0);
+        sampled++;
+      }
+    }
+    EXPECT_EQ(sampled, 4);
+  });
+  thread.join();
+}
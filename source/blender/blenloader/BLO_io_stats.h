@@ -0,0 +1,66 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup blenloader
+ * Statistics about the time spent in reading and writing each ID, enabled with
+ * `--debug-io-stats` (#G_DEBUG_IO_STATS).
+ */
+
+#include "BLI_sys_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum eBLOIOStatsMode {
+  BLO_IO_STATS_READ = 0,
+  BLO_IO_STATS_WRITE = 1,
+} eBLOIOStatsMode;
+#define BLO_IO_STATS_MODE_NUM 2
+
+typedef enum eBLOIOStatsPhase {
+  /** Reading or writing the blocks of the ID. */
+  BLO_IO_STATS_PHASE_IO = 0,
+  BLO_IO_STATS_PHASE_VERSIONING = 1,
+  BLO_IO_STATS_PHASE_DIRECT_LINK = 2,
+  BLO_IO_STATS_PHASE_LIB_LINK = 3,
+} eBLOIOStatsPhase;
+#define BLO_IO_STATS_PHASE_NUM 4
+
+bool BLO_io_stats_is_enabled(void);
+
+/**
+ * Clear the statistics of `mode` and start collecting for `filepath`.
+ */
+void BLO_io_stats_begin(eBLOIOStatsMode mode, const char *filepath);
+/**
+ * Finish collecting statistics of `mode`, prints a summary per ID type.
+ */
+void BLO_io_stats_end(eBLOIOStatsMode mode);
+/**
+ * Accumulate statistics for one ID.
+ *
+ * \param id_name: The ID name (including the ID code), NULL for time that can't be attributed
+ * to a single ID (e.g. versioning of the whole file).
+ * \param library: Path of the library the ID comes from, NULL for local IDs.
+ */
+void BLO_io_stats_add(eBLOIOStatsMode mode,
+                      eBLOIOStatsPhase phase,
+                      const char *id_name,
+                      const char *library,
+                      double time,
+                      size_t bytes,
+                      int blocks);
+
+/**
+ * \return The collected statistics as JSON text (free with #MEM_freeN),
+ * or NULL when nothing was collected.
+ */
+char *BLO_io_stats_as_json(void);
+void BLO_io_stats_free(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -68,7 +68,7 @@ typedef struct BlendFileData {
 } BlendFileData;
 
 struct BlendFileReadParams {
-  uint skip_flags : 3; /* #eBLOReadSkip */
+  uint skip_flags : 4; /* #eBLOReadSkip */
   uint is_startup : 1;
 
   /** Whether we are reading the memfile for an undo or a redo. */
@@ -123,6 +123,12 @@ typedef enum eBLOReadSkip {
   BLO_READ_SKIP_DATA = (1 << 1),
   /** Do not attempt to re-use IDs from old bmain for unchanged ones in case of undo. */
   BLO_READ_SKIP_UNDO_OLD_MAIN = (1 << 2),
+  /**
+   * Only read IDs that can be reached from the active scene (and the UI/library data-blocks),
+   * skipping everything else. Meant for render-only loading of asset-heavy files, see
+   * #WM_file_read_ex.
+   */
+  BLO_READ_SKIP_UNREACHABLE = (1 << 3),
 } eBLOReadSkip;
 #define BLO_READ_SKIP_ALL (BLO_READ_SKIP_USERDEF | BLO_READ_SKIP_DATA)
 
@@ -10,6 +10,10 @@
 
 #include "BLI_filereader.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 struct GHash;
 struct Scene;
 
@@ -27,11 +31,16 @@ typedef struct {
   /** Session UUID of the ID being currently written (MAIN_ID_SESSION_UUID_UNSET when not writing
    * ID-related data). Used to find matching chunks in previous memundo step. */
   uint id_session_uuid;
+  /** When true, `buf` is NULL and the data is stored in #MemFile.compressed_buf. */
+  bool is_compressed;
 } MemFileChunk;
 
 typedef struct MemFile {
   ListBase chunks;
   size_t size;
+  /** Zstd compressed data of all chunks with #MemFileChunk.is_compressed set, in order. */
+  char *compressed_buf;
+  size_t compressed_size;
 } MemFile;
 
 typedef struct MemFileWriteData {
@@ -87,6 +96,28 @@ extern void BLO_memfile_merge(MemFile *first, MemFile *second);
  * Clear is_identical_future before adding next memfile.
  */
 extern void BLO_memfile_clear_future(MemFile *memfile);
+/**
+ * Create a copy of `memfile` which references the same chunk buffers without copying their
+ * content, so that the copy can be used independently of the undo stack (e.g. to write it from
+ * another thread). The buffers stay valid until the copy is freed with #BLO_memfile_free.
+ *
+ * `memfile` must not be compressed.
+ */
+extern void BLO_memfile_shared_copy(const MemFile *memfile, MemFile *r_memfile);
+/**
+ * Compress the chunks only used by `memfile`, to reduce the memory used by old undo steps.
+ * Chunks shared with `memfile_next` (the next step in the undo stack, may be NULL) or with any
+ * other step are left untouched.
+ *
+ * Can run in a background thread, as long as neither memfile is accessed in the meantime.
+ *
+ * \return True when chunks were compressed.
+ */
+extern bool BLO_memfile_compress(MemFile *memfile, const MemFile *memfile_next);
+/**
+ * Restore the chunks compressed by #BLO_memfile_compress, does nothing when there are none.
+ */
+extern void BLO_memfile_decompress(MemFile *memfile);
 
 /* Utilities. */
 
@@ -100,4 +131,11 @@ extern struct Main *BLO_memfile_main_get(struct MemFile *memfile,
  */
 extern bool BLO_memfile_write_file(struct MemFile *memfile, const char *filename);
 
+/**
+ * \note Compressed chunks are restored first, see #BLO_memfile_decompress.
+ */
 FileReader *BLO_memfile_new_filereader(MemFile *memfile, int undo_direction);
+
+#ifdef __cplusplus
+}
+#endif
@@ -45,6 +45,11 @@ struct BlendFileWriteParams {
   /** On write, restore paths after editing them (see #BLO_WRITE_PATH_REMAP_RELATIVE). */
   uint use_save_as_copy : 1;
   uint use_userdef : 1;
+  /**
+   * When compressing, keep the compressed frames in memory and re-use them for frames with
+   * identical content on the next save of the same file, see #BLO_write_frame_cache_free.
+   */
+  uint use_frame_cache : 1;
   const struct BlendThumbnail *thumb;
 };
 
@@ -65,6 +70,11 @@ extern bool BLO_write_file_mem(struct Main *mainvar,
                                struct MemFile *current,
                                int write_flags);
 
+/**
+ * Free the compressed frames kept by #BlendFileWriteParams.use_frame_cache.
+ */
+extern void BLO_write_frame_cache_free(void);
+
 /** \} */
 
 #ifdef __cplusplus
@@ -0,0 +1,313 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup blenloader
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "MEM_guardedalloc.h"
+
+#include "DNA_ID.h"
+#include "DNA_listBase.h"
+
+#include "BLI_dynstr.h"
+#include "BLI_ghash.h"
+#include "BLI_listbase.h"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
+#include "BLI_utildefines.h"
+
+#include "BKE_global.h"
+#include "BKE_idtype.h"
+
+#include "PIL_time.h"
+
+#include "BLO_io_stats.h"
+
+/* -------------------------------------------------------------------- */
+/** \name Statistics Storage
+ *
+ * Only accessed from the main thread, like reading and writing files.
+ * \{ */
+
+typedef struct IOStats {
+  double time[BLO_IO_STATS_PHASE_NUM];
+  size_t bytes;
+  int blocks;
+  /** Number of IDs, only used for the totals. */
+  int ids_num;
+} IOStats;
+
+typedef struct IOStatsID {
+  struct IOStatsID *next, *prev;
+  /** Key in #IOStatsMode.ids, the library path followed by the ID name. */
+  char *key;
+  char name[MAX_ID_NAME];
+  /** NULL for local IDs. */
+  char *library;
+  IOStats stats;
+} IOStatsID;
+
+typedef struct IOStatsMode {
+  char filepath[FILE_MAX];
+  double time_begin;
+  double time_total;
+  /** Time that can't be attributed to a single ID. */
+  IOStats file;
+  IOStats types[INDEX_ID_MAX];
+  /** #IOStatsID, in the order they were first seen. */
+  ListBase ids;
+  GHash *ids_map;
+} IOStatsMode;
+
+static IOStatsMode *io_stats[BLO_IO_STATS_MODE_NUM] = {NULL};
+
+static const char *io_stats_mode_name[BLO_IO_STATS_MODE_NUM] = {"read", "write"};
+static const char *io_stats_phase_name[BLO_IO_STATS_MODE_NUM][BLO_IO_STATS_PHASE_NUM] = {
+    {"read", "versioning", "direct_link", "lib_link"},
+    {"write", NULL, NULL, NULL},
+};
+
+static void io_stats_id_free(IOStatsID *id_stats)
+{
+  MEM_freeN(id_stats->key);
+  MEM_SAFE_FREE(id_stats->library);
+  MEM_freeN(id_stats);
+}
+
+static void io_stats_mode_free(eBLOIOStatsMode mode)
+{
+  IOStatsMode *stats = io_stats[mode];
+  if (stats == NULL) {
+    return;
+  }
+  LISTBASE_FOREACH_MUTABLE (IOStatsID *, id_stats, &stats->ids) {
+    io_stats_id_free(id_stats);
+  }
+  BLI_ghash_free(stats->ids_map, NULL, NULL);
+  MEM_freeN(stats);
+  io_stats[mode] = NULL;
+}
+
+static IOStatsMode *io_stats_mode_ensure(eBLOIOStatsMode mode)
+{
+  if (io_stats[mode] == NULL) {
+    io_stats[mode] = MEM_callocN(sizeof(IOStatsMode), __func__);
+    io_stats[mode]->ids_map = BLI_ghash_str_new(__func__);
+    io_stats[mode]->time_begin = PIL_check_seconds_timer();
+  }
+  return io_stats[mode];
+}
+
+static void io_stats_accumulate(
+    IOStats *stats, eBLOIOStatsPhase phase, double time, size_t bytes, int blocks)
+{
+  stats->time[phase] += time;
+  stats->bytes += bytes;
+  stats->blocks += blocks;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Public API
+ * \{ */
+
+bool BLO_io_stats_is_enabled(void)
+{
+  return (G.debug & G_DEBUG_IO_STATS) != 0;
+}
+
+void BLO_io_stats_begin(eBLOIOStatsMode mode, const char *filepath)
+{
+  io_stats_mode_free(mode);
+  IOStatsMode *stats = io_stats_mode_ensure(mode);
+  STRNCPY(stats->filepath, filepath);
+}
+
+void BLO_io_stats_end(eBLOIOStatsMode mode)
+{
+  IOStatsMode *stats = io_stats[mode];
+  if (stats == NULL) {
+    return;
+  }
+  stats->time_total = PIL_check_seconds_timer() - stats->time_begin;
+
+  printf("Blend file %s statistics for '%s', %.3f s total:\n",
+         io_stats_mode_name[mode],
+         stats->filepath,
+         stats->time_total);
+  for (int i = 0; i < INDEX_ID_MAX; i++) {
+    const IOStats *type_stats = &stats->types[i];
+    if (type_stats->ids_num == 0) {
+      continue;
+    }
+    printf("  %-16s %6d IDs %8d blocks %10.2f MB",
+           BKE_idtype_idcode_to_name(BKE_idtype_idcode_from_index(i)),
+           type_stats->ids_num,
+           type_stats->blocks,
+           (double)type_stats->bytes / (1024.0 * 1024.0));
+    for (int phase = 0; phase < BLO_IO_STATS_PHASE_NUM; phase++) {
+      if (io_stats_phase_name[mode][phase] != NULL) {
+        printf("  %s %.3f s", io_stats_phase_name[mode][phase], type_stats->time[phase]);
+      }
+    }
+    printf("\n");
+  }
+  if (stats->file.time[BLO_IO_STATS_PHASE_VERSIONING] > 0.0) {
+    printf("  versioning of the whole file %.3f s\n",
+           stats->file.time[BLO_IO_STATS_PHASE_VERSIONING]);
+  }
+}
+
+void BLO_io_stats_add(eBLOIOStatsMode mode,
+                      eBLOIOStatsPhase phase,
+                      const char *id_name,
+                      const char *library,
+                      double time,
+                      size_t bytes,
+                      int blocks)
+{
+  IOStatsMode *stats = io_stats_mode_ensure(mode);
+
+  if (id_name == NULL) {
+    io_stats_accumulate(&stats->file, phase, time, bytes, blocks);
+    return;
+  }
+
+  const int type_index = BKE_idtype_idcode_to_index(GS(id_name));
+  if (type_index < 0) {
+    io_stats_accumulate(&stats->file, phase, time, bytes, blocks);
+    return;
+  }
+  IOStats *type_stats = &stats->types[type_index];
+
+  char *key = BLI_sprintfN("%s|%s", library ? library : "", id_name);
+  void **id_stats_p;
+  if (!BLI_ghash_ensure_p(stats->ids_map, key, &id_stats_p)) {
+    IOStatsID *id_stats = MEM_callocN(sizeof(IOStatsID), __func__);
+    id_stats->key = key;
+    STRNCPY(id_stats->name, id_name);
+    id_stats->library = library ? BLI_strdup(library) : NULL;
+    BLI_addtail(&stats->ids, id_stats);
+    *id_stats_p = id_stats;
+    type_stats->ids_num++;
+  }
+  else {
+    MEM_freeN(key);
+  }
+  IOStatsID *id_stats = *id_stats_p;
+
+  io_stats_accumulate(&id_stats->stats, phase, time, bytes, blocks);
+  io_stats_accumulate(type_stats, phase, time, bytes, blocks);
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name JSON Export
+ * \{ */
+
+static void io_stats_json_string(DynStr *ds, const char *str)
+{
+  BLI_dynstr_append(ds, "\"");
+  for (const char *c = str; *c; c++) {
+    if (ELEM(*c, '"', '\\')) {
+      BLI_dynstr_appendf(ds, "\\%c", *c);
+    }
+    else if ((unsigned char)*c < 0x20) {
+      BLI_dynstr_appendf(ds, "\\u%04x", (unsigned char)*c);
+    }
+    else {
+      BLI_dynstr_nappend(ds, c, 1);
+    }
+  }
+  BLI_dynstr_append(ds, "\"");
+}
+
+static void io_stats_json_stats(DynStr *ds, eBLOIOStatsMode mode, const IOStats *stats)
+{
+  BLI_dynstr_appendf(ds, "\"bytes\": %zu, \"blocks\": %d", stats->bytes, stats->blocks);
+  for (int phase = 0; phase < BLO_IO_STATS_PHASE_NUM; phase++) {
+    if (io_stats_phase_name[mode][phase] != NULL) {
+      BLI_dynstr_appendf(
+          ds, ", \"%s_time\": %.6f", io_stats_phase_name[mode][phase], stats->time[phase]);
+    }
+  }
+}
+
+static void io_stats_json_mode(DynStr *ds, eBLOIOStatsMode mode, const IOStatsMode *stats)
+{
+  BLI_dynstr_append(ds, "{\"filepath\": ");
+  io_stats_json_string(ds, stats->filepath);
+  BLI_dynstr_appendf(ds, ", \"total_time\": %.6f, \"file\": {", stats->time_total);
+  io_stats_json_stats(ds, mode, &stats->file);
+
+  BLI_dynstr_append(ds, "}, \"id_types\": {");
+  bool is_first = true;
+  for (int i = 0; i < INDEX_ID_MAX; i++) {
+    const IOStats *type_stats = &stats->types[i];
+    if (type_stats->ids_num == 0) {
+      continue;
+    }
+    BLI_dynstr_appendf(ds,
+                       "%s\n  \"%s\": {\"ids\": %d, ",
+                       is_first ? "" : ",",
+                       BKE_idtype_idcode_to_name(BKE_idtype_idcode_from_index(i)),
+                       type_stats->ids_num);
+    io_stats_json_stats(ds, mode, type_stats);
+    BLI_dynstr_append(ds, "}");
+    is_first = false;
+  }
+
+  BLI_dynstr_append(ds, "}, \"ids\": [");
+  is_first = true;
+  LISTBASE_FOREACH (const IOStatsID *, id_stats, &stats->ids) {
+    BLI_dynstr_appendf(ds, "%s\n  {\"name\": ", is_first ? "" : ",");
+    io_stats_json_string(ds, id_stats->name);
+    if (id_stats->library != NULL) {
+      BLI_dynstr_append(ds, ", \"library\": ");
+      io_stats_json_string(ds, id_stats->library);
+    }
+    BLI_dynstr_append(ds, ", ");
+    io_stats_json_stats(ds, mode, &id_stats->stats);
+    BLI_dynstr_append(ds, "}");
+    is_first = false;
+  }
+  BLI_dynstr_append(ds, "]}");
+}
+
+char *BLO_io_stats_as_json(void)
+{
+  if (io_stats[BLO_IO_STATS_READ] == NULL && io_stats[BLO_IO_STATS_WRITE] == NULL) {
+    return NULL;
+  }
+
+  DynStr *ds = BLI_dynstr_new();
+  BLI_dynstr_append(ds, "{");
+  bool is_first = true;
+  for (int mode = 0; mode < BLO_IO_STATS_MODE_NUM; mode++) {
+    if (io_stats[mode] == NULL) {
+      continue;
+    }
+    BLI_dynstr_appendf(ds, "%s\"%s\": ", is_first ? "" : ",\n", io_stats_mode_name[mode]);
+    io_stats_json_mode(ds, mode, io_stats[mode]);
+    is_first = false;
+  }
+  BLI_dynstr_append(ds, "}\n");
+
+  char *json = BLI_dynstr_get_cstring(ds);
+  BLI_dynstr_free(ds);
+  return json;
+}
+
+void BLO_io_stats_free(void)
+{
+  for (int mode = 0; mode < BLO_IO_STATS_MODE_NUM; mode++) {
+    io_stats_mode_free(mode);
+  }
+}
+
+/** \} */
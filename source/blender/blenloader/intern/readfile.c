@@ -53,6 +53,8 @@
 #include "BLI_math.h"
 #include "BLI_memarena.h"
 #include "BLI_mempool.h"
+#include "BLI_stack.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "PIL_time.h"
@@ -89,6 +91,7 @@
 
 #include "BLO_blend_defs.h"
 #include "BLO_blend_validate.h"
+#include "BLO_io_stats.h"
 #include "BLO_read_write.h"
 #include "BLO_readfile.h"
 #include "BLO_undofile.h"
@@ -236,12 +239,22 @@ typedef struct OldNew {
   int nr;
 } OldNew;
 
+/**
+ * Slot of the hash-map, the key is stored next to the index into the `entries` array, so that
+ * probing only touches the (contiguous) slots and never has to access unrelated entries.
+ */
+typedef struct OldNewSlot {
+  const void *oldp;
+  /* -1 for empty slots. */
+  int32_t index;
+} OldNewSlot;
+
 typedef struct OldNewMap {
   /* Array that stores the actual entries. */
   OldNew *entries;
   int nentries;
   /* Hash-map that stores indices into the `entries` array. */
-  int32_t *map;
+  OldNewSlot *map;
 
   int capacity_exp;
 } OldNewMap;
@@ -253,21 +266,20 @@ typedef struct OldNewMap {
 #define PERTURB_SHIFT 5
 
 /* based on the probing algorithm used in Python dicts. */
-#define ITER_SLOTS(onm, KEY, SLOT_NAME, INDEX_NAME) \
+#define ITER_SLOTS(onm, KEY, SLOT_NAME) \
   uint32_t hash = BLI_ghashutil_ptrhash(KEY); \
   uint32_t mask = SLOT_MASK(onm); \
   uint perturb = hash; \
-  int SLOT_NAME = mask & hash; \
-  int INDEX_NAME = onm->map[SLOT_NAME]; \
-  for (;; SLOT_NAME = mask & ((5 * SLOT_NAME) + 1 + perturb), \
-          perturb >>= PERTURB_SHIFT, \
-          INDEX_NAME = onm->map[SLOT_NAME])
+  OldNewSlot *SLOT_NAME = &onm->map[mask & hash]; \
+  for (;; SLOT_NAME = &onm->map[mask & ((5 * (SLOT_NAME - onm->map)) + 1 + perturb)], \
+          perturb >>= PERTURB_SHIFT)
 
 static void oldnewmap_insert_index_in_map(OldNewMap *onm, const void *ptr, int index)
 {
-  ITER_SLOTS (onm, ptr, slot, stored_index) {
-    if (stored_index == -1) {
-      onm->map[slot] = index;
+  ITER_SLOTS (onm, ptr, slot) {
+    if (slot->index == -1) {
+      slot->oldp = ptr;
+      slot->index = index;
       break;
     }
   }
@@ -275,15 +287,16 @@ static void oldnewmap_insert_index_in_map(OldNewMap *onm, const void *ptr, int i
 
 static void oldnewmap_insert_or_replace(OldNewMap *onm, OldNew entry)
 {
-  ITER_SLOTS (onm, entry.oldp, slot, index) {
-    if (index == -1) {
+  ITER_SLOTS (onm, entry.oldp, slot) {
+    if (slot->index == -1) {
       onm->entries[onm->nentries] = entry;
-      onm->map[slot] = onm->nentries;
+      slot->oldp = entry.oldp;
+      slot->index = onm->nentries;
       onm->nentries++;
       break;
     }
-    if (onm->entries[index].oldp == entry.oldp) {
-      onm->entries[index] = entry;
+    if (slot->oldp == entry.oldp) {
+      onm->entries[slot->index] = entry;
       break;
     }
   }
@@ -291,16 +304,13 @@ static void oldnewmap_insert_or_replace(OldNewMap *onm, OldNew entry)
 
 static OldNew *oldnewmap_lookup_entry(const OldNewMap *onm, const void *addr)
 {
-  ITER_SLOTS (onm, addr, slot, index) {
-    if (index >= 0) {
-      OldNew *entry = &onm->entries[index];
-      if (entry->oldp == addr) {
-        return entry;
-      }
-    }
-    else {
+  ITER_SLOTS (onm, addr, slot) {
+    if (slot->index == -1) {
       return NULL;
     }
+    if (slot->oldp == addr) {
+      return &onm->entries[slot->index];
+    }
   }
 }
 
@@ -309,15 +319,27 @@ static void oldnewmap_clear_map(OldNewMap *onm)
   memset(onm->map, 0xFF, MAP_CAPACITY(onm) * sizeof(*onm->map));
 }
 
-static void oldnewmap_increase_size(OldNewMap *onm)
+static void oldnewmap_resize(OldNewMap *onm, const int capacity_exp)
 {
-  onm->capacity_exp++;
+  OldNewSlot *map_old = onm->map;
+  const int64_t map_capacity_old = MAP_CAPACITY(onm);
+
+  onm->capacity_exp = capacity_exp;
   onm->entries = MEM_reallocN(onm->entries, sizeof(*onm->entries) * ENTRIES_CAPACITY(onm));
-  onm->map = MEM_reallocN(onm->map, sizeof(*onm->map) * MAP_CAPACITY(onm));
+  onm->map = MEM_malloc_arrayN(MAP_CAPACITY(onm), sizeof(*onm->map), "OldNewMap.map");
   oldnewmap_clear_map(onm);
-  for (int i = 0; i < onm->nentries; i++) {
-    oldnewmap_insert_index_in_map(onm, onm->entries[i].oldp, i);
+  /* Rehash from the old slots, they are contiguous and already contain the keys. */
+  for (int64_t i = 0; i < map_capacity_old; i++) {
+    if (map_old[i].index != -1) {
+      oldnewmap_insert_index_in_map(onm, map_old[i].oldp, map_old[i].index);
+    }
   }
+  MEM_freeN(map_old);
+}
+
+static void oldnewmap_increase_size(OldNewMap *onm)
+{
+  oldnewmap_resize(onm, onm->capacity_exp + 1);
 }
 
 /* Public OldNewMap API */
@@ -342,6 +364,22 @@ static OldNewMap *oldnewmap_new(void)
   return onm;
 }
 
+/**
+ * Ensure that `entries_num` more entries can be inserted without growing the map,
+ * to avoid repeated rehashing when the amount of inserted items is known beforehand.
+ */
+static void oldnewmap_reserve(OldNewMap *onm, const int entries_num)
+{
+  const int64_t needed = (int64_t)onm->nentries + entries_num;
+  int capacity_exp = onm->capacity_exp;
+  while ((1ll << capacity_exp) < needed) {
+    capacity_exp++;
+  }
+  if (capacity_exp != onm->capacity_exp) {
+    oldnewmap_resize(onm, capacity_exp);
+  }
+}
+
 static void oldnewmap_insert(OldNewMap *onm, const void *oldaddr, void *newaddr, int nr)
 {
   if (oldaddr == NULL || newaddr == NULL) {
@@ -404,10 +442,17 @@ static void oldnewmap_clear(OldNewMap *onm)
     }
   }
 
-  MEM_freeN(onm->entries);
-  MEM_freeN(onm->map);
+  /* The map is cleared after every ID, keep the allocations around unless they are much bigger
+   * than what was used, so that consecutive big IDs don't have to grow the map from scratch. */
+  if (onm->capacity_exp > DEFAULT_SIZE_EXP && (int64_t)onm->nentries * 4 < ENTRIES_CAPACITY(onm)) {
+    MEM_freeN(onm->entries);
+    MEM_freeN(onm->map);
+    oldnewmap_init_data(onm, DEFAULT_SIZE_EXP);
+    return;
+  }
 
-  oldnewmap_init_data(onm, DEFAULT_SIZE_EXP);
+  onm->nentries = 0;
+  oldnewmap_clear_map(onm);
 }
 
 static void oldnewmap_free(OldNewMap *onm)
@@ -997,6 +1042,188 @@ AssetMetaData *blo_bhead_id_asset_data_address(const FileData *fd, const BHead *
              NULL;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Reachable IDs Lookup
+ *
+ * Used by #BLO_READ_SKIP_UNREACHABLE to find the IDs that can be reached from the active scene,
+ * before any of them gets read. References are found by conservatively scanning the file data
+ * of each ID for pointer-sized values that match the old address of another ID, only blocks of
+ * structs that contain pointers have to be scanned.
+ * \{ */
+
+/**
+ * \return An array (aligned with `sdna->structs`) telling whether each struct contains pointers,
+ * either directly or in nested structs.
+ */
+static bool *sdna_structs_with_pointers(const SDNA *sdna)
+{
+  bool *has_pointers = MEM_calloc_arrayN(sdna->structs_len, sizeof(bool), __func__);
+  int *type_to_struct = MEM_malloc_arrayN(sdna->types_len, sizeof(int), __func__);
+  for (int i = 0; i < sdna->types_len; i++) {
+    type_to_struct[i] = -1;
+  }
+  for (int i = 0; i < sdna->structs_len; i++) {
+    type_to_struct[sdna->structs[i]->type] = i;
+  }
+
+  /* Propagate through nested structs until nothing changes, nesting is never deep. */
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (int i = 0; i < sdna->structs_len; i++) {
+      if (has_pointers[i]) {
+        continue;
+      }
+      const SDNA_Struct *struct_info = sdna->structs[i];
+      for (int a = 0; a < struct_info->members_len; a++) {
+        const SDNA_StructMember *member = &struct_info->members[a];
+        const char *name = sdna->names[member->name];
+        const int member_struct = type_to_struct[member->type];
+        if (ELEM(name[0], '*', '(') || (member_struct != -1 && has_pointers[member_struct])) {
+          has_pointers[i] = true;
+          changed = true;
+          break;
+        }
+      }
+    }
+  }
+
+  MEM_freeN(type_to_struct);
+  return has_pointers;
+}
+
+static void reachable_ids_scan_block(FileData *fd,
+                                     BHead *bhead,
+                                     GHash *id_bheads_by_old,
+                                     GSet *reachable,
+                                     BLI_Stack *todo)
+{
+  BHead *bhead_data = bhead;
+#ifdef USE_BHEAD_READ_ON_DEMAND
+  if (BHEADN_FROM_BHEAD(bhead)->has_data == false) {
+    bhead_data = blo_bhead_read_full(fd, bhead);
+    if (UNLIKELY(bhead_data == NULL)) {
+      return;
+    }
+  }
+#endif
+
+  const void **values = (const void **)(bhead_data + 1);
+  const int values_num = bhead_data->len / (int)sizeof(void *);
+  for (int i = 0; i < values_num; i++) {
+    if (values[i] == NULL) {
+      continue;
+    }
+    BHead *bhead_id = BLI_ghash_lookup(id_bheads_by_old, values[i]);
+    if (bhead_id && BLI_gset_add(reachable, bhead_id)) {
+      BLI_stack_push(todo, &bhead_id);
+    }
+  }
+
+#ifdef USE_BHEAD_READ_ON_DEMAND
+  if (bhead_data != bhead) {
+    MEM_freeN(BHEADN_FROM_BHEAD(bhead_data));
+  }
+#endif
+}
+
+/**
+ * Fill #FileData.bhead_reachable, leaves it unset when the lookup isn't supported for this file,
+ * in which case all IDs are read.
+ */
+static void read_file_bhead_reachable_create(FileData *fd)
+{
+  BLI_assert(fd->bhead_reachable == NULL);
+
+  /* Scanning relies on the pointers in the file being directly comparable. */
+  if (fd->flags & (FD_FLAGS_SWITCH_ENDIAN | FD_FLAGS_POINTSIZE_DIFFERS)) {
+    return;
+  }
+  const int curscene_offset = DNA_elem_offset(fd->filesdna, "FileGlobal", "Scene", "*curscene");
+  if (curscene_offset < 0) {
+    return;
+  }
+
+  bool *struct_has_pointers = sdna_structs_with_pointers(fd->filesdna);
+  GHash *id_bheads_by_old = BLI_ghash_ptr_new(__func__);
+  GSet *reachable = BLI_gset_ptr_new(__func__);
+  BLI_Stack *todo = BLI_stack_new(sizeof(BHead *), __func__);
+  const void *curscene = NULL;
+
+  for (BHead *bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
+    if (bhead->code == GLOB) {
+      BHead *bhead_glob = bhead;
+#ifdef USE_BHEAD_READ_ON_DEMAND
+      if (BHEADN_FROM_BHEAD(bhead)->has_data == false) {
+        bhead_glob = blo_bhead_read_full(fd, bhead);
+      }
+#endif
+      if (bhead_glob && curscene_offset + (int)sizeof(void *) <= bhead_glob->len) {
+        curscene = *(const void **)POINTER_OFFSET(bhead_glob + 1, curscene_offset);
+      }
+#ifdef USE_BHEAD_READ_ON_DEMAND
+      if (bhead_glob && bhead_glob != bhead) {
+        MEM_freeN(BHEADN_FROM_BHEAD(bhead_glob));
+      }
+#endif
+    }
+    else if (blo_bhead_is_id(bhead)) {
+      BLI_ghash_insert(id_bheads_by_old, (void *)bhead->old, bhead);
+      /* Libraries and UI data-blocks are always kept, the file can't be used without them. */
+      if (ELEM(bhead->code, ID_LI, ID_WM, ID_SCR, ID_SCRN, ID_WS) &&
+          BLI_gset_add(reachable, bhead)) {
+        BLI_stack_push(todo, &bhead);
+      }
+    }
+  }
+
+  BHead *bhead_curscene = curscene ? BLI_ghash_lookup(id_bheads_by_old, curscene) : NULL;
+  if (bhead_curscene == NULL) {
+    /* Without an active scene everything could be needed. */
+    BLI_gset_free(reachable, NULL);
+    reachable = NULL;
+  }
+  else {
+    if (BLI_gset_add(reachable, bhead_curscene)) {
+      BLI_stack_push(todo, &bhead_curscene);
+    }
+
+    while (!BLI_stack_is_empty(todo)) {
+      BHead *bhead_id;
+      BLI_stack_pop(todo, &bhead_id);
+
+      /* The ID itself and all the data blocks written after it. */
+      BHead *bhead = bhead_id;
+      do {
+        if (bhead->len > 0 && bhead->SDNAnr < fd->filesdna->structs_len &&
+            struct_has_pointers[bhead->SDNAnr]) {
+          reachable_ids_scan_block(fd, bhead, id_bheads_by_old, reachable, todo);
+        }
+        bhead = blo_bhead_next(fd, bhead);
+      } while (bhead && bhead->code == DATA);
+    }
+  }
+
+  BLI_stack_free(todo);
+  BLI_ghash_free(id_bheads_by_old, NULL, NULL);
+  MEM_freeN(struct_has_pointers);
+
+  fd->bhead_reachable = reachable;
+}
+
+/**
+ * \return The first block after the ID and its data.
+ */
+static BHead *read_file_bhead_skip_id(FileData *fd, BHead *bhead)
+{
+  do {
+    bhead = blo_bhead_next(fd, bhead);
+  } while (bhead && bhead->code == DATA);
+  return bhead;
+}
+
+/** \} */
+
 static void decode_blender_header(FileData *fd)
 {
   char header[SIZEOFBLENDERHEADER], num[4];
@@ -1387,6 +1614,9 @@ void blo_filedata_free(FileData *fd)
       BLI_ghash_free(fd->bhead_idname_hash, NULL, NULL);
     }
 #endif
+    if (fd->bhead_reachable) {
+      BLI_gset_free(fd->bhead_reachable, NULL);
+    }
 
     MEM_freeN(fd);
   }
@@ -3049,11 +3279,93 @@ static bool direct_link_id(FileData *fd, Main *main, const int tag, ID *id, ID *
   return success;
 }
 
+/**
+ * IDs with at least this many data blocks convert the blocks that are already in memory in
+ * parallel, e.g. grease pencil or particle data with many small blocks.
+ */
+#define READ_DATA_PARALLEL_MIN_BLOCKS 256
+
+typedef struct ReadDataBlocksData {
+  FileData *fd;
+  BHead **bheads;
+  void **data;
+  const char *allocname;
+} ReadDataBlocksData;
+
+static void read_data_blocks_task(void *__restrict userdata,
+                                  const int i,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ReadDataBlocksData *data = userdata;
+  if (BHEADN_FROM_BHEAD(data->bheads[i])->has_data) {
+    data->data[i] = read_struct(data->fd, data->bheads[i], data->allocname);
+  }
+}
+
+/**
+ * Read all data blocks of an ID into #FileData.datamap.
+ *
+ * Blocks that still have to be read from the file are read serially, while the conversion of
+ * blocks that are already in memory (copying, endian switching and DNA reconstruction) only
+ * depends on the immutable file DNA, so it is done in parallel for IDs with many blocks.
+ */
+static BHead *read_data_into_datamap_parallel(FileData *fd,
+                                              BHead *bhead,
+                                              const int blocks_num,
+                                              const char *allocname)
+{
+  BHead **bheads = MEM_malloc_arrayN(blocks_num, sizeof(*bheads), __func__);
+  void **data = MEM_calloc_arrayN(blocks_num, sizeof(*data), __func__);
+
+  for (int i = 0; i < blocks_num; i++, bhead = blo_bhead_next(fd, bhead)) {
+    bheads[i] = bhead;
+    if (!BHEADN_FROM_BHEAD(bhead)->has_data) {
+      data[i] = read_struct(fd, bhead, allocname);
+    }
+  }
+
+  ReadDataBlocksData task_data = {
+      .fd = fd,
+      .bheads = bheads,
+      .data = data,
+      .allocname = allocname,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 64;
+  BLI_task_parallel_range(0, blocks_num, &task_data, read_data_blocks_task, &settings);
+
+  /* Insert in file order, so later duplicates still replace earlier ones. */
+  for (int i = 0; i < blocks_num; i++) {
+    if (data[i]) {
+      oldnewmap_insert(fd->datamap, bheads[i]->old, data[i], 0);
+    }
+  }
+
+  MEM_freeN(bheads);
+  MEM_freeN(data);
+  return bhead;
+}
+
 /* Read all data associated with a datablock into datamap. */
 static BHead *read_data_into_datamap(FileData *fd, BHead *bhead, const char *allocname)
 {
   bhead = blo_bhead_next(fd, bhead);
 
+  /* Reserve space for all the data blocks at once, the blocks are read below anyway. */
+  int blocks_num = 0;
+  fd->datamap_len = 0;
+  for (BHead *bhead_iter = bhead; bhead_iter && bhead_iter->code == DATA;
+       bhead_iter = blo_bhead_next(fd, bhead_iter)) {
+    blocks_num++;
+    fd->datamap_len += (size_t)bhead_iter->len;
+  }
+  oldnewmap_reserve(fd->datamap, blocks_num);
+
+  if (blocks_num >= READ_DATA_PARALLEL_MIN_BLOCKS) {
+    return read_data_into_datamap_parallel(fd, bhead, blocks_num, allocname);
+  }
+
   while (bhead && bhead->code == DATA) {
     /* The code below is useful for debugging leaks in data read from the blend file.
      * Without this the messages only tell us what ID-type the memory came from,
@@ -3325,6 +3637,16 @@ static bool read_libblock_undo_restore(
   return false;
 }
 
+static bool read_io_stats_is_enabled(const FileData *fd)
+{
+  return ((fd->flags & FD_FLAGS_IS_MEMFILE) == 0) && BLO_io_stats_is_enabled();
+}
+
+static const char *read_io_stats_library(const Main *main)
+{
+  return main->curlib ? main->curlib->filepath_abs : NULL;
+}
+
 /* This routine reads a datablock and its direct data, and advances bhead to
  * the next datablock. For library linked datablocks, only a placeholder will
  * be generated, to be replaced in read_library_linked_ids.
@@ -3356,6 +3678,10 @@ static BHead *read_libblock(FileData *fd,
     }
   }
 
+  const bool use_io_stats = read_io_stats_is_enabled(fd);
+  const double time_begin = use_io_stats ? PIL_check_seconds_timer() : 0.0;
+  const size_t id_bhead_len = (size_t)bhead->len;
+
   /* Read libblock struct. */
   ID *id = read_struct(fd, bhead, "lib block");
   if (id == NULL) {
@@ -3422,7 +3748,35 @@ static BHead *read_libblock(FileData *fd,
    * Use convenient malloc name for debugging and better memory link prints. */
   const char *allocname = dataname(idcode);
   bhead = read_data_into_datamap(fd, bhead, allocname);
+
+  /* The ID may be freed by #direct_link_id. */
+  char id_name[MAX_ID_NAME];
+  double time_read = 0.0;
+  if (use_io_stats) {
+    STRNCPY(id_name, id->name);
+    time_read = PIL_check_seconds_timer();
+  }
+
   const bool success = direct_link_id(fd, main, id_tag, id, id_old);
+
+  if (use_io_stats) {
+    const char *library = read_io_stats_library(main);
+    BLO_io_stats_add(BLO_IO_STATS_READ,
+                     BLO_IO_STATS_PHASE_IO,
+                     id_name,
+                     library,
+                     time_read - time_begin,
+                     id_bhead_len + fd->datamap_len,
+                     fd->datamap->nentries + 1);
+    BLO_io_stats_add(BLO_IO_STATS_READ,
+                     BLO_IO_STATS_PHASE_DIRECT_LINK,
+                     id_name,
+                     library,
+                     PIL_check_seconds_timer() - time_read,
+                     0,
+                     0);
+  }
+
   oldnewmap_clear(fd->datamap);
 
   if (!success) {
@@ -3563,6 +3917,9 @@ static void do_versions(FileData *fd, Library *lib, Main *main)
   /* Don't allow versioning to create new data-blocks. */
   main->is_locked_for_linking = true;
 
+  const bool use_io_stats = read_io_stats_is_enabled(fd);
+  const double time_begin = use_io_stats ? PIL_check_seconds_timer() : 0.0;
+
   if (G.debug & G_DEBUG) {
     char build_commit_datetime[32];
     time_t temp_time = main->build_commit_timestamp;
@@ -3598,6 +3955,17 @@ static void do_versions(FileData *fd, Library *lib, Main *main)
 
   /* don't forget to set version number in BKE_blender_version.h! */
 
+  if (use_io_stats) {
+    /* Versioning code works on whole files, it can't be attributed to single IDs. */
+    BLO_io_stats_add(BLO_IO_STATS_READ,
+                     BLO_IO_STATS_PHASE_VERSIONING,
+                     NULL,
+                     NULL,
+                     PIL_check_seconds_timer() - time_begin,
+                     0,
+                     0);
+  }
+
   main->is_locked_for_linking = false;
 }
 
@@ -3614,6 +3982,9 @@ static void do_versions_after_linking(Main *main, ReportList *reports)
   /* Don't allow versioning to create new data-blocks. */
   main->is_locked_for_linking = true;
 
+  const bool use_io_stats = BLO_io_stats_is_enabled();
+  const double time_begin = use_io_stats ? PIL_check_seconds_timer() : 0.0;
+
   do_versions_after_linking_250(main);
   do_versions_after_linking_260(main);
   do_versions_after_linking_270(main);
@@ -3622,6 +3993,16 @@ static void do_versions_after_linking(Main *main, ReportList *reports)
   do_versions_after_linking_300(main, reports);
   do_versions_after_linking_cycles(main);
 
+  if (use_io_stats) {
+    BLO_io_stats_add(BLO_IO_STATS_READ,
+                     BLO_IO_STATS_PHASE_VERSIONING,
+                     NULL,
+                     NULL,
+                     PIL_check_seconds_timer() - time_begin,
+                     0,
+                     0);
+  }
+
   main->is_locked_for_linking = false;
 }
 
@@ -3636,6 +4017,7 @@ static void lib_link_all(FileData *fd, Main *bmain)
   const bool do_partial_undo = (fd->skip_flags & BLO_READ_SKIP_UNDO_OLD_MAIN) == 0;
 
   BlendLibReader reader = {fd, bmain};
+  const bool use_io_stats = read_io_stats_is_enabled(fd);
 
   ID *id;
   FOREACH_MAIN_ID_BEGIN (bmain, id) {
@@ -3658,6 +4040,8 @@ static void lib_link_all(FileData *fd, Main *bmain)
       continue;
     }
 
+    const double time_begin = use_io_stats ? PIL_check_seconds_timer() : 0.0;
+
     lib_link_id(&reader, id);
 
     const IDTypeInfo *id_type = BKE_idtype_get_info_from_id(id);
@@ -3669,6 +4053,16 @@ static void lib_link_all(FileData *fd, Main *bmain)
       lib_link_library(&reader, (Library *)id); /* Only init users. */
     }
 
+    if (use_io_stats) {
+      BLO_io_stats_add(BLO_IO_STATS_READ,
+                       BLO_IO_STATS_PHASE_LIB_LINK,
+                       id->name,
+                       read_io_stats_library(bmain),
+                       PIL_check_seconds_timer() - time_begin,
+                       0,
+                       0);
+    }
+
     id->tag &= ~LIB_TAG_NEED_LINK;
 
     /* Some data that should be persistent, like the 3DCursor or the tool settings, are
@@ -3834,6 +4228,11 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
     CLOG_INFO(&LOG_UNDO, 2, "UNDO: read step");
   }
 
+  const bool use_io_stats = read_io_stats_is_enabled(fd);
+  if (use_io_stats) {
+    BLO_io_stats_begin(BLO_IO_STATS_READ, filepath);
+  }
+
   bfd = MEM_callocN(sizeof(BlendFileData), "blendfiledata");
 
   bfd->main = BKE_main_new();
@@ -3869,6 +4268,11 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
     }
   }
 
+  if ((fd->skip_flags & BLO_READ_SKIP_UNREACHABLE) && (fd->skip_flags & BLO_READ_SKIP_DATA) == 0 &&
+      (fd->flags & FD_FLAGS_IS_MEMFILE) == 0) {
+    read_file_bhead_reachable_create(fd);
+  }
+
   while (bhead) {
     switch (bhead->code) {
       case DATA:
@@ -3902,7 +4306,12 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
            * to the file format definition. So we can use the entry at the
            * end of mainlist, added in direct_link_library. */
           Main *libmain = mainlist.last;
-          bhead = read_libblock(fd, libmain, bhead, 0, true, NULL);
+          if (fd->bhead_reachable && !BLI_gset_haskey(fd->bhead_reachable, bhead)) {
+            bhead = read_file_bhead_skip_id(fd, bhead);
+          }
+          else {
+            bhead = read_libblock(fd, libmain, bhead, 0, true, NULL);
+          }
         }
         break;
         /* in 2.50+ files, the file identifier for screens is patched, forward compatibility */
@@ -3914,6 +4323,9 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
         if (fd->skip_flags & BLO_READ_SKIP_DATA) {
           bhead = blo_bhead_next(fd, bhead);
         }
+        else if (fd->bhead_reachable && !BLI_gset_haskey(fd->bhead_reachable, bhead)) {
+          bhead = read_file_bhead_skip_id(fd, bhead);
+        }
         else {
           bhead = read_libblock(fd, bfd->main, bhead, LIB_TAG_LOCAL, false, NULL);
         }
@@ -4001,6 +4413,10 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
 
   BLI_assert(bfd->main->id_map == NULL);
 
+  if (use_io_stats) {
+    BLO_io_stats_end(BLO_IO_STATS_READ);
+  }
+
   return bfd;
 }
 
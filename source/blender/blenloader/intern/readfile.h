@@ -87,6 +87,8 @@ typedef struct FileData {
   int id_tag_extra;
 
   struct OldNewMap *datamap;
+  /** Total size of the blocks read into #datamap, for #BLO_io_stats_add. */
+  size_t datamap_len;
   struct OldNewMap *globmap;
   struct OldNewMap *libmap;
   struct OldNewMap *packedmap;
@@ -98,6 +100,9 @@ typedef struct FileData {
   /** See: #USE_GHASH_BHEAD. */
   struct GHash *bhead_idname_hash;
 
+  /** ID BHeads to read when using #BLO_READ_SKIP_UNREACHABLE, NULL to read all IDs. */
+  struct GSet *bhead_reachable;
+
   ListBase *mainlist;
   /** Used for undo. */
   ListBase *old_mainlist;
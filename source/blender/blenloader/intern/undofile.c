@@ -19,12 +19,17 @@
 #  include <io.h>
 #endif
 
+#include <zstd.h>
+
 #include "MEM_guardedalloc.h"
 
 #include "DNA_listBase.h"
 
 #include "BLI_blenlib.h"
+#include "BLI_filereader.h"
 #include "BLI_ghash.h"
+#include "BLI_hash_mm3.h"
+#include "BLI_threads.h"
 
 #include "BLO_readfile.h"
 #include "BLO_undofile.h"
@@ -38,50 +43,403 @@
 
 /* **************** support for memory-write, for undo buffers *************** */
 
+/* -------------------------------------------------------------------- */
+/** \name Shared Chunk Buffers
+ *
+ * The buffers of chunks are reference counted, and buffers with identical content are shared
+ * over the whole undo stack. This catches identical data that #BLO_memfile_chunk_add can't find
+ * by comparing against the chunk at the same position in the previous step, e.g. after IDs were
+ * re-ordered or when going back to an earlier state.
+ *
+ * Chunks that are not #MemFileChunk.is_identical hold a reference to their buffer.
+ * \{ */
+
+typedef struct MemFileChunkBuffer {
+  const char *data;
+  size_t size;
+  uint32_t hash;
+  int users;
+  /** Whether the buffer is in #chunk_store.buffers. */
+  bool is_stored;
+} MemFileChunkBuffer;
+
+#define CHUNK_BUFFER_FROM_DATA(buf) (((MemFileChunkBuffer *)(buf)) - 1)
+
+static struct {
+  GSet *buffers;
+  /* Buffers may be released from other threads, e.g. by the auto-save job. */
+  ThreadMutex mutex;
+} chunk_store = {NULL, BLI_MUTEX_INITIALIZER};
+
+static uint chunk_buffer_hash(const void *key)
+{
+  const MemFileChunkBuffer *buffer = key;
+  return buffer->hash;
+}
+
+static bool chunk_buffer_cmp(const void *a, const void *b)
+{
+  const MemFileChunkBuffer *buffer_a = a;
+  const MemFileChunkBuffer *buffer_b = b;
+  return (buffer_a->hash != buffer_b->hash) || (buffer_a->size != buffer_b->size) ||
+         (memcmp(buffer_a->data, buffer_b->data, buffer_a->size) != 0);
+}
+
+/** Allocate memory which is attributed to undo, see #MEM_tag_set. */
+static void *undo_mallocN(size_t size, const char *name)
+{
+  const eMEMTag tag_prev = MEM_tag_set(MEM_TAG_UNDO);
+  void *mem = MEM_mallocN(size, name);
+  MEM_tag_set(tag_prev);
+  return mem;
+}
+
+/** Same as #undo_mallocN, but the memory is cleared. */
+static void *undo_callocN(size_t size, const char *name)
+{
+  const eMEMTag tag_prev = MEM_tag_set(MEM_TAG_UNDO);
+  void *mem = MEM_callocN(size, name);
+  MEM_tag_set(tag_prev);
+  return mem;
+}
+
+static char *chunk_buffer_alloc(size_t size)
+{
+  MemFileChunkBuffer *buffer = undo_mallocN(sizeof(MemFileChunkBuffer) + size, "Chunk buffer");
+  buffer->data = (const char *)(buffer + 1);
+  buffer->size = size;
+  buffer->hash = 0;
+  buffer->users = 1;
+  buffer->is_stored = false;
+  return (char *)(buffer + 1);
+}
+
+/**
+ * \return A buffer with the given content, sharing an existing one when possible.
+ * \param r_is_new: Set when new memory was allocated.
+ */
+static const char *chunk_buffer_ensure(const char *buf, size_t size, bool *r_is_new)
+{
+  MemFileChunkBuffer key = {
+      .data = buf,
+      .size = size,
+      .hash = BLI_hash_mm3((const uchar *)buf, size, 0),
+  };
+
+  BLI_mutex_lock(&chunk_store.mutex);
+  if (chunk_store.buffers == NULL) {
+    chunk_store.buffers = BLI_gset_new(chunk_buffer_hash, chunk_buffer_cmp, __func__);
+  }
+
+  void **buffer_p;
+  if (BLI_gset_ensure_p_ex(chunk_store.buffers, &key, &buffer_p)) {
+    MemFileChunkBuffer *buffer = *buffer_p;
+    buffer->users++;
+    BLI_mutex_unlock(&chunk_store.mutex);
+    *r_is_new = false;
+    return buffer->data;
+  }
+
+  char *buf_new = chunk_buffer_alloc(size);
+  memcpy(buf_new, buf, size);
+  MemFileChunkBuffer *buffer = CHUNK_BUFFER_FROM_DATA(buf_new);
+  buffer->hash = key.hash;
+  buffer->is_stored = true;
+  /* Replace the temporary key with the actual buffer. */
+  *buffer_p = buffer;
+  BLI_mutex_unlock(&chunk_store.mutex);
+
+  *r_is_new = true;
+  return buf_new;
+}
+
+static void chunk_buffer_acquire(const char *buf)
+{
+  MemFileChunkBuffer *buffer = CHUNK_BUFFER_FROM_DATA(buf);
+
+  BLI_mutex_lock(&chunk_store.mutex);
+  BLI_assert(buffer->users > 0);
+  buffer->users++;
+  BLI_mutex_unlock(&chunk_store.mutex);
+}
+
+static void chunk_buffer_release(const char *buf)
+{
+  MemFileChunkBuffer *buffer = CHUNK_BUFFER_FROM_DATA(buf);
+
+  BLI_mutex_lock(&chunk_store.mutex);
+  BLI_assert(buffer->users > 0);
+  if (--buffer->users > 0) {
+    BLI_mutex_unlock(&chunk_store.mutex);
+    return;
+  }
+  if (buffer->is_stored) {
+    BLI_gset_remove(chunk_store.buffers, buffer, NULL);
+    if (BLI_gset_len(chunk_store.buffers) == 0) {
+      BLI_gset_free(chunk_store.buffers, NULL);
+      chunk_store.buffers = NULL;
+    }
+  }
+  BLI_mutex_unlock(&chunk_store.mutex);
+
+  MEM_freeN(buffer);
+}
+
+/**
+ * Add an allocated buffer to the store, or free it in favor of an existing identical one.
+ */
+static const char *chunk_buffer_store(char *buf)
+{
+  MemFileChunkBuffer *buffer = CHUNK_BUFFER_FROM_DATA(buf);
+  buffer->hash = BLI_hash_mm3((const uchar *)buf, buffer->size, 0);
+
+  BLI_mutex_lock(&chunk_store.mutex);
+  if (chunk_store.buffers == NULL) {
+    chunk_store.buffers = BLI_gset_new(chunk_buffer_hash, chunk_buffer_cmp, __func__);
+  }
+
+  void **buffer_p;
+  if (BLI_gset_ensure_p_ex(chunk_store.buffers, buffer, &buffer_p)) {
+    MemFileChunkBuffer *buffer_existing = *buffer_p;
+    buffer_existing->users++;
+    BLI_mutex_unlock(&chunk_store.mutex);
+    MEM_freeN(buffer);
+    return buffer_existing->data;
+  }
+  buffer->is_stored = true;
+  BLI_mutex_unlock(&chunk_store.mutex);
+
+  return buf;
+}
+
+/** \} */
+
 void BLO_memfile_free(MemFile *memfile)
 {
   MemFileChunk *chunk;
 
   while ((chunk = BLI_pophead(&memfile->chunks))) {
-    if (chunk->is_identical == false) {
-      MEM_freeN((void *)chunk->buf);
+    if (chunk->is_identical == false && chunk->is_compressed == false) {
+      chunk_buffer_release(chunk->buf);
     }
     MEM_freeN(chunk);
   }
+  MEM_SAFE_FREE(memfile->compressed_buf);
+  memfile->compressed_size = 0;
   memfile->size = 0;
 }
 
-void BLO_memfile_merge(MemFile *first, MemFile *second)
+void BLO_memfile_shared_copy(const MemFile *memfile, MemFile *r_memfile)
 {
-  /* We use this mapping to store the memory buffers from second memfile chunks which are not owned
-   * by it (i.e. shared with some previous memory steps). */
-  GHash *buffer_to_second_memchunk = BLI_ghash_new(
-      BLI_ghashutil_ptrhash, BLI_ghashutil_ptrcmp, __func__);
+  BLI_assert(memfile->compressed_buf == NULL);
+
+  BLI_listbase_clear(&r_memfile->chunks);
+  r_memfile->size = 0;
+  r_memfile->compressed_buf = NULL;
+  r_memfile->compressed_size = 0;
+
+  /* Buffers are never modified once written, every chunk of the copy can hold its own
+   * reference, including the ones that borrow the buffer of a previous step. */
+  BLI_mutex_lock(&chunk_store.mutex);
+  LISTBASE_FOREACH (const MemFileChunk *, chunk, &memfile->chunks) {
+    MemFileChunkBuffer *buffer = CHUNK_BUFFER_FROM_DATA(chunk->buf);
+    BLI_assert(buffer->users > 0);
+    buffer->users++;
+  }
+  BLI_mutex_unlock(&chunk_store.mutex);
+
+  LISTBASE_FOREACH (const MemFileChunk *, chunk, &memfile->chunks) {
+    MemFileChunk *chunk_copy = undo_callocN(sizeof(MemFileChunk), __func__);
+    chunk_copy->buf = chunk->buf;
+    chunk_copy->size = chunk->size;
+    chunk_copy->id_session_uuid = chunk->id_session_uuid;
+    BLI_addtail(&r_memfile->chunks, chunk_copy);
+    r_memfile->size += chunk->size;
+  }
+}
 
-  /* First, detect all memchunks in second memfile that are not owned by it. */
-  for (MemFileChunk *sc = second->chunks.first; sc != NULL; sc = sc->next) {
-    if (sc->is_identical) {
-      BLI_ghash_insert(buffer_to_second_memchunk, (void *)sc->buf, sc);
+/* -------------------------------------------------------------------- */
+/** \name Compressed Chunks
+ *
+ * Old undo steps are rarely read again, so the data only they use can be kept compressed until
+ * the step is decoded (or written), at which point it's restored into regular chunk buffers.
+ * \{ */
+
+/** Don't bother compressing less data than this. */
+#define MEMFILE_COMPRESS_SIZE_MIN (64 * 1024)
+#define MEMFILE_COMPRESS_LEVEL 1
+
+bool BLO_memfile_compress(MemFile *memfile, const MemFile *memfile_next)
+{
+  if (memfile->compressed_buf != NULL) {
+    return false;
+  }
+
+  /* Buffers borrowed by the next step, steps after it can only borrow them through it. */
+  GSet *buffers_next = BLI_gset_ptr_new(__func__);
+  if (memfile_next != NULL) {
+    LISTBASE_FOREACH (const MemFileChunk *, chunk, &memfile_next->chunks) {
+      if (chunk->is_identical) {
+        BLI_gset_add(buffers_next, (void *)chunk->buf);
+      }
+    }
+  }
+
+  /* Buffers of all chunks which are only used by this memfile. Removing them from the store
+   * ensures no other step starts using them while they are compressed. */
+  size_t size = 0;
+  BLI_mutex_lock(&chunk_store.mutex);
+  LISTBASE_FOREACH (MemFileChunk *, chunk, &memfile->chunks) {
+    if (chunk->is_identical || chunk->size == 0) {
+      continue;
+    }
+    const MemFileChunkBuffer *buffer = CHUNK_BUFFER_FROM_DATA(chunk->buf);
+    if (buffer->users == 1 && !BLI_gset_haskey(buffers_next, chunk->buf)) {
+      chunk->is_compressed = true;
+      size += chunk->size;
+    }
+  }
+  if (size < MEMFILE_COMPRESS_SIZE_MIN) {
+    LISTBASE_FOREACH (MemFileChunk *, chunk, &memfile->chunks) {
+      chunk->is_compressed = false;
+    }
+    BLI_mutex_unlock(&chunk_store.mutex);
+    BLI_gset_free(buffers_next, NULL);
+    return false;
+  }
+  LISTBASE_FOREACH (MemFileChunk *, chunk, &memfile->chunks) {
+    if (chunk->is_compressed) {
+      MemFileChunkBuffer *buffer = CHUNK_BUFFER_FROM_DATA(chunk->buf);
+      if (buffer->is_stored) {
+        BLI_gset_remove(chunk_store.buffers, buffer, NULL);
+        buffer->is_stored = false;
+      }
+    }
+  }
+  if (chunk_store.buffers != NULL && BLI_gset_len(chunk_store.buffers) == 0) {
+    BLI_gset_free(chunk_store.buffers, NULL);
+    chunk_store.buffers = NULL;
+  }
+  BLI_mutex_unlock(&chunk_store.mutex);
+  BLI_gset_free(buffers_next, NULL);
+
+  char *data = MEM_mallocN(size, __func__);
+  size_t offset = 0;
+  LISTBASE_FOREACH (const MemFileChunk *, chunk, &memfile->chunks) {
+    if (chunk->is_compressed) {
+      memcpy(data + offset, chunk->buf, chunk->size);
+      offset += chunk->size;
+    }
+  }
+
+  const size_t compressed_size_max = ZSTD_compressBound(size);
+  char *compressed_buf = undo_mallocN(compressed_size_max, __func__);
+  const size_t compressed_size = ZSTD_compress(
+      compressed_buf, compressed_size_max, data, size, MEMFILE_COMPRESS_LEVEL);
+  MEM_freeN(data);
+
+  if (ZSTD_isError(compressed_size) || compressed_size >= size) {
+    /* Keep the buffers as they are, they just won't be shared anymore. */
+    LISTBASE_FOREACH (MemFileChunk *, chunk, &memfile->chunks) {
+      chunk->is_compressed = false;
+    }
+    MEM_freeN(compressed_buf);
+    return false;
+  }
+
+  LISTBASE_FOREACH (MemFileChunk *, chunk, &memfile->chunks) {
+    if (chunk->is_compressed) {
+      chunk_buffer_release(chunk->buf);
+      chunk->buf = NULL;
+    }
+  }
+
+  memfile->compressed_buf = MEM_reallocN(compressed_buf, compressed_size);
+  memfile->compressed_size = compressed_size;
+  memfile->size = (memfile->size > size ? memfile->size - size : 0) + compressed_size;
+  return true;
+}
+
+void BLO_memfile_decompress(MemFile *memfile)
+{
+  if (memfile->compressed_buf == NULL) {
+    return;
+  }
+
+  FileReader *reader = BLI_filereader_new_zstd(
+      BLI_filereader_new_memory(memfile->compressed_buf, memfile->compressed_size));
+
+  size_t size = 0;
+  LISTBASE_FOREACH (MemFileChunk *, chunk, &memfile->chunks) {
+    if (!chunk->is_compressed) {
+      continue;
     }
+    char *buf = chunk_buffer_alloc(chunk->size);
+    if (reader->read(reader, buf, chunk->size) != (ssize_t)chunk->size) {
+      /* Should never happen, keep the step readable nonetheless. */
+      BLI_assert_unreachable();
+      memset(buf, 0, chunk->size);
+    }
+    chunk->buf = chunk_buffer_store(buf);
+    chunk->is_compressed = false;
+    size += chunk->size;
   }
 
-  /* Now, check all chunks from first memfile (the one we are removing), and if a memchunk owned by
-   * it is also used by the second memfile, transfer the ownership. */
+  reader->close(reader);
+
+  memfile->size = (memfile->size > memfile->compressed_size ?
+                       memfile->size - memfile->compressed_size :
+                       0) +
+                  size;
+  MEM_freeN(memfile->compressed_buf);
+  memfile->compressed_buf = NULL;
+  memfile->compressed_size = 0;
+}
+
+/** \} */
+
+void BLO_memfile_merge(MemFile *first, MemFile *second)
+{
+  /* We use this mapping to find the chunks of the first memfile that own (i.e. hold a reference
+   * to) a given buffer. Several chunks may share the same buffer, only the first one is stored. */
+  GHash *buffer_to_first_memchunk = BLI_ghash_new(
+      BLI_ghashutil_ptrhash, BLI_ghashutil_ptrcmp, __func__);
+
   for (MemFileChunk *fc = first->chunks.first; fc != NULL; fc = fc->next) {
-    if (!fc->is_identical) {
-      MemFileChunk *sc = BLI_ghash_lookup(buffer_to_second_memchunk, fc->buf);
-      if (sc != NULL) {
-        BLI_assert(sc->is_identical);
-        sc->is_identical = false;
-        fc->is_identical = true;
+    if (!fc->is_identical && !fc->is_compressed) {
+      void **val_p;
+      if (!BLI_ghash_ensure_p(buffer_to_first_memchunk, (void *)fc->buf, &val_p)) {
+        *val_p = fc;
       }
-      /* Note that if the second memfile does not use that chunk, we assume that the first one
-       * fully owns it without sharing it with any other memfile, and hence it should be freed with
-       * it. */
     }
   }
 
-  BLI_ghash_free(buffer_to_second_memchunk, NULL, NULL);
+  /* Now, check all chunks from the second memfile that are not owned by it. If they use a buffer
+   * owned by the first memfile (the one we are removing), they need a reference of their own.
+   * The reference of the first owning chunk is transferred, further chunks sharing the same
+   * buffer acquire a new one. */
+  for (MemFileChunk *sc = second->chunks.first; sc != NULL; sc = sc->next) {
+    if (!sc->is_identical) {
+      continue;
+    }
+    MemFileChunk *fc = BLI_ghash_lookup(buffer_to_first_memchunk, sc->buf);
+    if (fc == NULL) {
+      /* Owned by an older memfile, which is kept. */
+      continue;
+    }
+    if (fc->is_identical) {
+      /* The reference of `fc` was already transferred to another chunk. */
+      chunk_buffer_acquire(sc->buf);
+    }
+    else {
+      fc->is_identical = true;
+    }
+    sc->is_identical = false;
+  }
+  /* Note that chunks of the first memfile which still hold a reference release it when it's
+   * freed, the buffer is only freed once its last user is gone. */
+
+  BLI_ghash_free(buffer_to_first_memchunk, NULL, NULL);
 
   BLO_memfile_free(first);
 }
@@ -139,10 +497,11 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
   MemFile *memfile = mem_data->written_memfile;
   MemFileChunk **compchunk_step = &mem_data->reference_current_chunk;
 
-  MemFileChunk *curchunk = MEM_mallocN(sizeof(MemFileChunk), "MemFileChunk");
+  MemFileChunk *curchunk = undo_mallocN(sizeof(MemFileChunk), "MemFileChunk");
   curchunk->size = size;
   curchunk->buf = NULL;
   curchunk->is_identical = false;
+  curchunk->is_compressed = false;
   /* This is unsafe in the sense that an app handler or other code that does not
    * perform an undo push may make changes after the last undo push that
    * will then not be undo. Though it's not entirely clear that is wrong behavior. */
@@ -165,10 +524,12 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
 
   /* not equal... */
   if (curchunk->buf == NULL) {
-    char *buf_new = MEM_mallocN(size, "Chunk buffer");
-    memcpy(buf_new, buf, size);
-    curchunk->buf = buf_new;
-    memfile->size += size;
+    /* The data may still exist elsewhere in the undo stack. */
+    bool is_new;
+    curchunk->buf = chunk_buffer_ensure(buf, size, &is_new);
+    if (is_new) {
+      memfile->size += size;
+    }
   }
 }
 
@@ -216,6 +577,8 @@ bool BLO_memfile_write_file(struct MemFile *memfile, const char *filename)
 #    warning "Symbolic links will be followed on undo save, possibly causing CVE-2008-1103"
 #  endif
 #endif
+  BLO_memfile_decompress(memfile);
+
   file = BLI_open(filename, oflags, 0666);
 
   if (file == -1) {
@@ -331,6 +694,8 @@ static void undo_close(FileReader *reader)
 
 FileReader *BLO_memfile_new_filereader(MemFile *memfile, int undo_direction)
 {
+  BLO_memfile_decompress(memfile);
+
   UndoReader *undo = MEM_callocN(sizeof(UndoReader), __func__);
 
   undo->memfile = memfile;
@@ -85,6 +85,9 @@
 #include "BLI_blenlib.h"
 #include "BLI_endian_defines.h"
 #include "BLI_endian_switch.h"
+#include "BLI_ghash.h"
+#include "BLI_hash.h"
+#include "BLI_hash_mm3.h"
 #include "BLI_link_utils.h"
 #include "BLI_linklist.h"
 #include "BLI_math_base.h"
@@ -108,11 +111,14 @@
 
 #include "BLO_blend_defs.h"
 #include "BLO_blend_validate.h"
+#include "BLO_io_stats.h"
 #include "BLO_read_write.h"
 #include "BLO_readfile.h"
 #include "BLO_undofile.h"
 #include "BLO_writefile.h"
 
+#include "PIL_time.h"
+
 #include "readfile.h"
 
 #include <errno.h>
@@ -133,6 +139,9 @@
 
 #define ZSTD_COMPRESSION_LEVEL 3
 
+/** Upper limit for the compressed frames kept around for the next save of the same file. */
+#define ZSTD_FRAME_CACHE_MAX_SIZE (256 << 20) /* 256mb */
+
 /** Use if we want to store how many bytes have been written to the file. */
 // #define USE_WRITE_DATA_LEN
 
@@ -152,6 +161,72 @@ typedef struct ZstdFrame {
   uint32_t uncompressed_size;
 } ZstdFrame;
 
+/**
+ * Compressed frame of a previous save, re-used as-is when a frame of the same content is
+ * written again, so that unchanged data doesn't need to be compressed again.
+ * Frames are looked up by their size and two hashes of their uncompressed content. Hash
+ * collisions are ruled out by decompressing the frame before re-using it, which is much faster
+ * than compressing the data again.
+ */
+typedef struct ZstdCachedFrame {
+  uint32_t hash[2];
+  size_t uncompressed_size;
+
+  void *compressed_data;
+  size_t compressed_size;
+} ZstdCachedFrame;
+
+static uint zstd_cached_frame_hash(const void *key)
+{
+  const ZstdCachedFrame *frame = key;
+  return frame->hash[0];
+}
+
+static bool zstd_cached_frame_cmp(const void *a, const void *b)
+{
+  const ZstdCachedFrame *frame_a = a;
+  const ZstdCachedFrame *frame_b = b;
+  return (frame_a->hash[0] != frame_b->hash[0]) || (frame_a->hash[1] != frame_b->hash[1]) ||
+         (frame_a->uncompressed_size != frame_b->uncompressed_size);
+}
+
+/**
+ * \return True when the compressed data of `frame` decompresses to `data`.
+ */
+static bool zstd_cached_frame_matches(const ZstdCachedFrame *frame,
+                                      const void *data,
+                                      const size_t size)
+{
+  void *uncompressed = MEM_mallocN(size, __func__);
+  const size_t uncompressed_size = ZSTD_decompress(
+      uncompressed, size, frame->compressed_data, frame->compressed_size);
+  const bool matches = (uncompressed_size == size) && (memcmp(uncompressed, data, size) == 0);
+  MEM_freeN(uncompressed);
+  return matches;
+}
+
+static void zstd_cached_frame_free(void *key)
+{
+  ZstdCachedFrame *frame = key;
+  MEM_freeN(frame->compressed_data);
+  MEM_freeN(frame);
+}
+
+/** Frames of the last compressed save that used #BlendFileWriteParams.use_frame_cache. */
+static struct {
+  char filepath[FILE_MAX];
+  GHash *frames;
+} zstd_frame_cache = {{0}};
+
+void BLO_write_frame_cache_free(void)
+{
+  if (zstd_frame_cache.frames) {
+    BLI_ghash_free(zstd_frame_cache.frames, zstd_cached_frame_free, NULL);
+    zstd_frame_cache.frames = NULL;
+  }
+  zstd_frame_cache.filepath[0] = '\0';
+}
+
 typedef struct WriteWrap WriteWrap;
 struct WriteWrap {
   /* callbacks */
@@ -176,6 +251,12 @@ struct WriteWrap {
     ListBase frames;
 
     bool write_error;
+
+    /* Frames of the previous save that can be re-used, and the frames of this save to keep
+     * for the next one (both NULL when the cache isn't used). Protected by `mutex`. */
+    GHash *cache_prev;
+    GHash *cache_next;
+    size_t cache_next_size;
   } zstd;
 };
 
@@ -217,10 +298,42 @@ static void *zstd_write_task(void *userdata)
   ZstdWriteBlockTask *task = userdata;
   WriteWrap *ww = task->ww;
 
-  size_t out_buf_len = ZSTD_compressBound(task->size);
-  void *out_buf = MEM_mallocN(out_buf_len, "Zstd out buffer");
-  size_t out_size = ZSTD_compress(
-      out_buf, out_buf_len, task->data, task->size, ZSTD_COMPRESSION_LEVEL);
+  ZstdCachedFrame *cached_frame = NULL;
+  if (ww->zstd.cache_prev) {
+    ZstdCachedFrame key = {
+        .hash = {BLI_hash_mm3(task->data, task->size, 0),
+                 BLI_hash_mm3(task->data, task->size, 0x9e3779b9)},
+        .uncompressed_size = task->size,
+    };
+    BLI_mutex_lock(&ww->zstd.mutex);
+    cached_frame = BLI_ghash_popkey(ww->zstd.cache_prev, &key, NULL);
+    BLI_mutex_unlock(&ww->zstd.mutex);
+
+    if (cached_frame == NULL) {
+      cached_frame = MEM_mallocN(sizeof(*cached_frame), __func__);
+      *cached_frame = key;
+      cached_frame->compressed_data = NULL;
+    }
+    else if (!zstd_cached_frame_matches(cached_frame, task->data, task->size)) {
+      /* Hash collision, the frame has to be compressed again. */
+      MEM_freeN(cached_frame->compressed_data);
+      cached_frame->compressed_data = NULL;
+    }
+  }
+
+  void *out_buf;
+  size_t out_size;
+  if (cached_frame && cached_frame->compressed_data) {
+    /* Same content as in the previous save, skip compression. */
+    out_buf = cached_frame->compressed_data;
+    out_size = cached_frame->compressed_size;
+  }
+  else {
+    size_t out_buf_len = ZSTD_compressBound(task->size);
+    out_buf = MEM_mallocN(out_buf_len, "Zstd out buffer");
+    out_size = ZSTD_compress(
+        out_buf, out_buf_len, task->data, task->size, ZSTD_COMPRESSION_LEVEL);
+  }
 
   MEM_freeN(task->data);
 
@@ -245,12 +358,31 @@ static void *zstd_write_task(void *userdata)
     }
   }
 
+  /* Keep the compressed frame for the next save, as long as it fits into the budget. */
+  if (cached_frame) {
+    if (!ZSTD_isError(out_size) &&
+        ww->zstd.cache_next_size + out_size <= ZSTD_FRAME_CACHE_MAX_SIZE &&
+        !BLI_ghash_haskey(ww->zstd.cache_next, cached_frame)) {
+      cached_frame->compressed_data = out_buf;
+      cached_frame->compressed_size = out_size;
+      BLI_ghash_insert(ww->zstd.cache_next, cached_frame, NULL);
+      ww->zstd.cache_next_size += out_size;
+      out_buf = NULL;
+    }
+    else {
+      if (cached_frame->compressed_data == out_buf) {
+        cached_frame->compressed_data = NULL;
+      }
+      MEM_freeN(cached_frame);
+    }
+  }
+
   ww->zstd.next_frame++;
 
   BLI_mutex_unlock(&ww->zstd.mutex);
   BLI_condition_notify_all(&ww->zstd.condition);
 
-  MEM_freeN(out_buf);
+  MEM_SAFE_FREE(out_buf);
   return NULL;
 }
 
@@ -321,7 +453,42 @@ static bool ww_close_zstd(WriteWrap *ww)
   zstd_write_seekable_frames(ww);
   BLI_freelistN(&ww->zstd.frames);
 
-  return ww_close_none(ww) && !ww->zstd.write_error;
+  const bool success = ww_close_none(ww) && !ww->zstd.write_error;
+
+  if (ww->zstd.cache_next) {
+    /* Frames of the previous save that were not written again are outdated. */
+    BLI_ghash_free(ww->zstd.cache_prev, zstd_cached_frame_free, NULL);
+    if (success) {
+      zstd_frame_cache.frames = ww->zstd.cache_next;
+    }
+    else {
+      BLI_ghash_free(ww->zstd.cache_next, zstd_cached_frame_free, NULL);
+      zstd_frame_cache.filepath[0] = '\0';
+    }
+    ww->zstd.cache_prev = ww->zstd.cache_next = NULL;
+  }
+
+  return success;
+}
+
+/**
+ * Use the frames of the previous save of the same file when compressing.
+ * Has to be called before any data is written.
+ */
+static void ww_zstd_frame_cache_begin(WriteWrap *ww, const char *filepath)
+{
+  if (!STREQ(zstd_frame_cache.filepath, filepath)) {
+    BLO_write_frame_cache_free();
+    STRNCPY(zstd_frame_cache.filepath, filepath);
+  }
+
+  ww->zstd.cache_prev = zstd_frame_cache.frames ?
+                            zstd_frame_cache.frames :
+                            BLI_ghash_new(zstd_cached_frame_hash, zstd_cached_frame_cmp, __func__);
+  ww->zstd.cache_next = BLI_ghash_new(zstd_cached_frame_hash, zstd_cached_frame_cmp, __func__);
+  ww->zstd.cache_next_size = 0;
+  /* Owned by the #WriteWrap until it's closed. */
+  zstd_frame_cache.frames = NULL;
 }
 
 static size_t ww_write_zstd(WriteWrap *ww, const char *buf, size_t buf_len)
@@ -410,6 +577,18 @@ typedef struct {
   size_t write_len;
 #endif
 
+  /** Statistics per ID, see #BLO_io_stats_add. */
+  struct {
+    bool use_io_stats;
+    /** Total number of bytes and blocks written. */
+    size_t len;
+    int blocks;
+    /** Values at the start of writing the current ID. */
+    size_t id_len;
+    int id_blocks;
+    double id_time;
+  } stats;
+
   /** Set on unlikely case of an error (ignores further file writing). */
   bool error;
 
@@ -524,6 +703,7 @@ static void mywrite(WriteData *wd, const void *adr, size_t len)
 #ifdef USE_WRITE_DATA_LEN
   wd->write_len += len;
 #endif
+  wd->stats.len += len;
 
   if (wd->buffer.buf == NULL) {
     writedata_do_write(wd, adr, len);
@@ -574,6 +754,9 @@ static WriteData *mywrite_begin(WriteWrap *ww, MemFile *compare, MemFile *curren
     BLO_memfile_write_init(&wd->mem, current, compare);
     wd->use_memfile = true;
   }
+  else {
+    wd->stats.use_io_stats = BLO_io_stats_is_enabled();
+  }
 
   return wd;
 }
@@ -608,6 +791,12 @@ static bool mywrite_end(WriteData *wd)
  */
 static void mywrite_id_begin(WriteData *wd, ID *id)
 {
+  if (wd->stats.use_io_stats) {
+    wd->stats.id_len = wd->stats.len;
+    wd->stats.id_blocks = wd->stats.blocks;
+    wd->stats.id_time = PIL_check_seconds_timer();
+  }
+
   if (wd->use_memfile) {
     wd->mem.current_id_session_uuid = id->session_uuid;
 
@@ -636,14 +825,32 @@ static void mywrite_id_begin(WriteData *wd, ID *id)
  *
  * Only does something when storing an undo step.
  */
-static void mywrite_id_end(WriteData *wd, ID *UNUSED(id))
+static void mywrite_id_end(WriteData *wd, ID *id)
 {
+  if (wd->stats.use_io_stats) {
+    BLO_io_stats_add(BLO_IO_STATS_WRITE,
+                     BLO_IO_STATS_PHASE_IO,
+                     id->name,
+                     id->lib ? id->lib->filepath_abs : NULL,
+                     PIL_check_seconds_timer() - wd->stats.id_time,
+                     wd->stats.len - wd->stats.id_len,
+                     wd->stats.blocks - wd->stats.id_blocks);
+  }
+
   if (wd->use_memfile) {
     /* Very important to do it after every ID write now, otherwise we cannot know whether a
      * specific ID changed or not. */
     mywrite_flush(wd);
     wd->mem.current_id_session_uuid = MAIN_ID_SESSION_UUID_UNSET;
   }
+  else if (wd->ww && wd->ww->zstd.cache_next) {
+    /* Start new compressed frames at ID boundaries that only depend on the IDs themselves, so
+     * that a change in one ID doesn't shift the content of all following frames, which would
+     * prevent re-using them from the previous save. */
+    if (wd->buffer.used_len >= ZSTD_CHUNK_SIZE / 4 && (BLI_hash_string(id->name) & 0x3) == 0) {
+      mywrite_flush(wd);
+    }
+  }
 }
 
 /** \} */
@@ -677,6 +884,7 @@ static void writestruct_at_address_nr(
     return;
   }
 
+  wd->stats.blocks++;
   mywrite(wd, &bh, sizeof(BHead));
   mywrite(wd, data, (size_t)bh.len);
 }
@@ -711,6 +919,7 @@ static void writedata(WriteData *wd, int filecode, size_t len, const void *adr)
   bh.SDNAnr = 0;
   bh.len = (int)len;
 
+  wd->stats.blocks++;
   mywrite(wd, &bh, sizeof(BHead));
   mywrite(wd, adr, len);
 }
@@ -1340,6 +1549,10 @@ bool BLO_write_file(Main *mainvar,
     return false;
   }
 
+  if ((write_flags & G_FILE_COMPRESS) && params->use_frame_cache) {
+    ww_zstd_frame_cache_begin(&ww, filepath);
+  }
+
   if (remap_mode == BLO_WRITE_PATH_REMAP_ABSOLUTE) {
     /* Paths will already be absolute, no remapping to do. */
     if (relbase_valid == false) {
@@ -1416,8 +1629,17 @@ bool BLO_write_file(Main *mainvar,
   }
 
   /* actual file writing */
+  const bool use_io_stats = BLO_io_stats_is_enabled();
+  if (use_io_stats) {
+    BLO_io_stats_begin(BLO_IO_STATS_WRITE, filepath);
+  }
+
   const bool err = write_file_handle(mainvar, &ww, NULL, NULL, write_flags, use_userdef, thumb);
 
+  if (use_io_stats) {
+    BLO_io_stats_end(BLO_IO_STATS_WRITE);
+  }
+
   ww.close(&ww);
 
   if (UNLIKELY(path_list_backup)) {
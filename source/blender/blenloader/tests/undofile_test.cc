@@ -0,0 +1,98 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include <cstring>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_listbase.h"
+#include "BLI_span.hh"
+
+#include "BLO_undofile.h"
+
+namespace blender::blenloader::tests {
+
+static void memfile_write(MemFile *memfile, MemFile *reference, const Span<const char *> chunks)
+{
+  MemFileWriteData mem_data = {nullptr};
+  BLO_memfile_write_init(&mem_data, memfile, reference);
+  for (const char *chunk : chunks) {
+    BLO_memfile_chunk_add(&mem_data, chunk, strlen(chunk) + 1);
+  }
+  BLO_memfile_write_finalize(&mem_data);
+}
+
+static void expect_memfile_content(const MemFile *memfile, const Span<const char *> chunks)
+{
+  EXPECT_EQ(BLI_listbase_count(&memfile->chunks), chunks.size());
+  int i = 0;
+  LISTBASE_FOREACH (const MemFileChunk *, chunk, &memfile->chunks) {
+    EXPECT_STREQ(chunk->buf, chunks[i++]);
+  }
+}
+
+TEST(undofile, Merge)
+{
+  const int blocks_num = MEM_get_memory_blocks_in_use();
+  MemFile first = {{nullptr}};
+  MemFile second = {{nullptr}};
+  memfile_write(&first, nullptr, {"a", "b", "c"});
+  memfile_write(&second, &first, {"a", "x", "c"});
+
+  BLO_memfile_merge(&first, &second);
+  expect_memfile_content(&second, {"a", "x", "c"});
+
+  BLO_memfile_free(&second);
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_num);
+}
+
+TEST(undofile, MergeSharedChunks)
+{
+  const int blocks_num = MEM_get_memory_blocks_in_use();
+  MemFile first = {{nullptr}};
+  MemFile second = {{nullptr}};
+  /* Chunks with identical content share the same buffer, within a memfile as well. */
+  memfile_write(&first, nullptr, {"a", "a", "b", "a"});
+  LISTBASE_FOREACH (const MemFileChunk *, chunk, &first.chunks) {
+    EXPECT_FALSE(chunk->is_identical);
+  }
+  EXPECT_EQ(static_cast<const MemFileChunk *>(first.chunks.first)->buf,
+            static_cast<const MemFileChunk *>(first.chunks.last)->buf);
+  /* All chunks of the second memfile borrow the buffers of the first one. */
+  memfile_write(&second, &first, {"a", "a", "b", "a"});
+  LISTBASE_FOREACH (const MemFileChunk *, chunk, &second.chunks) {
+    EXPECT_TRUE(chunk->is_identical);
+  }
+
+  BLO_memfile_merge(&first, &second);
+  expect_memfile_content(&second, {"a", "a", "b", "a"});
+  LISTBASE_FOREACH (const MemFileChunk *, chunk, &second.chunks) {
+    EXPECT_FALSE(chunk->is_identical);
+  }
+
+  BLO_memfile_free(&second);
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_num);
+}
+
+TEST(undofile, MergeSharedChunksPartially)
+{
+  const int blocks_num = MEM_get_memory_blocks_in_use();
+  MemFile first = {{nullptr}};
+  MemFile second = {{nullptr}};
+  MemFile third = {{nullptr}};
+  memfile_write(&first, nullptr, {"a", "a", "b"});
+  /* Only the first chunk is borrowed, the changed second chunk shares the buffer of "b". */
+  memfile_write(&second, &first, {"a", "b", "c"});
+  memfile_write(&third, &second, {"a", "b", "c"});
+
+  BLO_memfile_merge(&first, &second);
+  expect_memfile_content(&second, {"a", "b", "c"});
+  BLO_memfile_merge(&second, &third);
+  expect_memfile_content(&third, {"a", "b", "c"});
+
+  BLO_memfile_free(&third);
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_num);
+}
+
+}  // namespace blender::blenloader::tests
@@ -331,6 +331,14 @@ typedef struct BMesh {
   struct MLoopNorSpaceArray *lnor_spacearr;
   char spacearr_dirty;
 
+  /**
+   * Changes since the mesh matched the edit-mode undo step #BMesh.undo_state_id,
+   * see #BM_CHANGE_POSITIONS.
+   */
+  char change_flag;
+  /** Identifies the edit-mode undo step this mesh was last written to or read from. */
+  int undo_state_id;
+
   /* Should be copy of scene select mode. */
   /* Stored in #BMEditMesh too, this is a bit confusing,
    * make sure they're in sync!
@@ -405,6 +413,17 @@ enum {
   BM_SPACEARR_BMO_SET = 1 << 2,
 };
 
+/** #BMesh.change_flag */
+enum {
+  /**
+   * Only vertex coordinates changed. Tagged by code that knows it didn't change anything else,
+   * when no other flag is set undo steps only need to write the positions.
+   */
+  BM_CHANGE_POSITIONS = 1 << 0,
+  /** Any change, tagged by #EDBM_update. */
+  BM_CHANGE_ALL = 1 << 1,
+};
+
 /* args for _Generic */
 #define _BM_GENERIC_TYPE_ELEM_NONCONST \
   void *, BMVert *, BMEdge *, BMLoop *, BMFace *, BMVert_OFlag *, BMEdge_OFlag *, BMFace_OFlag *, \
@@ -1049,9 +1049,15 @@ void BM_mesh_rebuild(BMesh *bm,
       BMVert *v_dst = BLI_mempool_alloc(vpool_dst);
       memcpy(v_dst, v_src, sizeof(BMVert));
       if (use_toolflags) {
-        ((BMVert_OFlag *)v_dst)->oflags = bm->vtoolflagpool ?
-                                              BLI_mempool_calloc(bm->vtoolflagpool) :
-                                              NULL;
+        if (bm->use_toolflags) {
+          /* Packing, keep the existing flags. */
+          ((BMVert_OFlag *)v_dst)->oflags = ((BMVert_OFlag *)v_src)->oflags;
+        }
+        else {
+          ((BMVert_OFlag *)v_dst)->oflags = bm->vtoolflagpool ?
+                                                BLI_mempool_calloc(bm->vtoolflagpool) :
+                                                NULL;
+        }
       }
 
       vtable_dst[index] = v_dst;
@@ -1067,9 +1073,15 @@ void BM_mesh_rebuild(BMesh *bm,
       BMEdge *e_dst = BLI_mempool_alloc(epool_dst);
       memcpy(e_dst, e_src, sizeof(BMEdge));
       if (use_toolflags) {
-        ((BMEdge_OFlag *)e_dst)->oflags = bm->etoolflagpool ?
-                                              BLI_mempool_calloc(bm->etoolflagpool) :
-                                              NULL;
+        if (bm->use_toolflags) {
+          /* Packing, keep the existing flags. */
+          ((BMEdge_OFlag *)e_dst)->oflags = ((BMEdge_OFlag *)e_src)->oflags;
+        }
+        else {
+          ((BMEdge_OFlag *)e_dst)->oflags = bm->etoolflagpool ?
+                                                BLI_mempool_calloc(bm->etoolflagpool) :
+                                                NULL;
+        }
       }
 
       etable_dst[index] = e_dst;
@@ -1087,9 +1099,14 @@ void BM_mesh_rebuild(BMesh *bm,
         BMFace *f_dst = BLI_mempool_alloc(fpool_dst);
         memcpy(f_dst, f_src, sizeof(BMFace));
         if (use_toolflags) {
-          ((BMFace_OFlag *)f_dst)->oflags = bm->ftoolflagpool ?
-                                                BLI_mempool_calloc(bm->ftoolflagpool) :
-                                                NULL;
+          if (bm->use_toolflags) {
+            ((BMFace_OFlag *)f_dst)->oflags = ((BMFace_OFlag *)f_src)->oflags;
+          }
+          else {
+            ((BMFace_OFlag *)f_dst)->oflags = bm->ftoolflagpool ?
+                                                  BLI_mempool_calloc(bm->ftoolflagpool) :
+                                                  NULL;
+          }
         }
 
         ftable_dst[index] = f_dst;
@@ -1307,6 +1324,90 @@ void BM_mesh_toolflags_set(BMesh *bm, bool use_toolflags)
   bm->use_toolflags = use_toolflags;
 }
 
+void BM_mesh_elem_pack(BMesh *bm)
+{
+  BM_mesh_elem_table_ensure(bm, BM_VERT | BM_EDGE | BM_FACE);
+  BM_mesh_elem_index_ensure(bm, BM_VERT | BM_EDGE | BM_FACE);
+
+  uint *vert_idx = MEM_mallocN(sizeof(*vert_idx) * bm->totvert, __func__);
+  uint *edge_idx = MEM_mallocN(sizeof(*edge_idx) * bm->totedge, __func__);
+  uint *face_idx = MEM_mallocN(sizeof(*face_idx) * bm->totface, __func__);
+  copy_vn_i((int *)vert_idx, bm->totvert, -1);
+  copy_vn_i((int *)edge_idx, bm->totedge, -1);
+  copy_vn_i((int *)face_idx, bm->totface, -1);
+
+  /* Order faces breadth first over their edges, so that neighbors end up close in memory,
+   * then verts and edges in the order they are first used by those faces. */
+  BMFace **face_queue = MEM_mallocN(sizeof(*face_queue) * bm->totface, __func__);
+  uint vert_len = 0, edge_len = 0, face_len = 0;
+  for (int i = 0; i < bm->totface; i++) {
+    if (face_idx[i] != (uint)-1) {
+      continue;
+    }
+    face_idx[i] = face_len;
+    face_queue[face_len++] = bm->ftable[i];
+    for (uint queue_index = face_len - 1; queue_index < face_len; queue_index++) {
+      BMLoop *l_iter, *l_first;
+      l_iter = l_first = BM_FACE_FIRST_LOOP(face_queue[queue_index]);
+      do {
+        const int v_index = BM_elem_index_get(l_iter->v);
+        const int e_index = BM_elem_index_get(l_iter->e);
+        if (vert_idx[v_index] == (uint)-1) {
+          vert_idx[v_index] = vert_len++;
+        }
+        if (edge_idx[e_index] == (uint)-1) {
+          edge_idx[e_index] = edge_len++;
+        }
+        BMLoop *l_radial = l_iter->radial_next;
+        for (; l_radial != l_iter; l_radial = l_radial->radial_next) {
+          const int f_index = BM_elem_index_get(l_radial->f);
+          if (face_idx[f_index] == (uint)-1) {
+            face_idx[f_index] = face_len;
+            face_queue[face_len++] = l_radial->f;
+          }
+        }
+      } while ((l_iter = l_iter->next) != l_first);
+    }
+  }
+  MEM_freeN(face_queue);
+
+  /* Wire edges and loose verts go last, in their current order. */
+  for (int i = 0; i < bm->totedge; i++) {
+    if (edge_idx[i] == (uint)-1) {
+      edge_idx[i] = edge_len++;
+    }
+  }
+  for (int i = 0; i < bm->totvert; i++) {
+    if (vert_idx[i] == (uint)-1) {
+      vert_idx[i] = vert_len++;
+    }
+  }
+
+  BM_mesh_remap(bm, vert_idx, edge_idx, face_idx);
+  MEM_freeN(vert_idx);
+  MEM_freeN(edge_idx);
+  MEM_freeN(face_idx);
+
+  /* Copy to new pools in the new order, removing the free slots of deleted elements. Loops
+   * follow their faces. */
+  const BMAllocTemplate allocsize = BMALLOC_TEMPLATE_FROM_BM(bm);
+  BLI_mempool *vpool_dst, *epool_dst, *lpool_dst, *fpool_dst;
+  bm_mempool_init_ex(
+      &allocsize, bm->use_toolflags, &vpool_dst, &epool_dst, &lpool_dst, &fpool_dst);
+  BM_mesh_rebuild(bm,
+                  &((struct BMeshCreateParams){
+                      .use_toolflags = bm->use_toolflags,
+                  }),
+                  vpool_dst,
+                  epool_dst,
+                  lpool_dst,
+                  fpool_dst);
+
+  /* Both remapping and rebuilding keep the element order, so keep the tables valid. */
+  BM_mesh_elem_table_ensure(bm, BM_VERT | BM_EDGE | BM_FACE);
+  BM_mesh_elem_index_ensure(bm, BM_VERT | BM_EDGE | BM_FACE);
+}
+
 /* -------------------------------------------------------------------- */
 /** \name BMesh Coordinate Access
  * \{ */
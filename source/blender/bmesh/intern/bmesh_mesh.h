@@ -95,6 +95,15 @@ bool BM_mesh_elem_table_check(BMesh *bm);
  */
 void BM_mesh_toolflags_set(BMesh *bm, bool use_toolflags);
 
+/**
+ * Reorder vertices, edges and faces by topology, so that connected elements are close in memory,
+ * and re-allocate them without the free slots left by deleted elements.
+ * Improves the memory locality of iterating over large meshes after many edits.
+ *
+ * \warning Changes element indices and pointers, like #BM_mesh_remap.
+ */
+void BM_mesh_elem_pack(BMesh *bm);
+
 void BM_mesh_elem_table_ensure(BMesh *bm, char htype);
 /* use BM_mesh_elem_table_ensure where possible to avoid full rebuild */
 void BM_mesh_elem_table_init(BMesh *bm, char htype);
@@ -83,6 +83,7 @@
 #include "BLI_listbase.h"
 #include "BLI_math_vector.h"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
 
 #include "BKE_customdata.h"
 #include "BKE_mesh.h"
@@ -104,6 +105,7 @@ static CLG_LogRef LOG = {"bmesh.mesh.convert"};
 using blender::Array;
 using blender::IndexRange;
 using blender::Span;
+namespace threading = blender::threading;
 
 void BM_mesh_cd_flag_ensure(BMesh *bm, Mesh *mesh, const char cd_flag)
 {
@@ -1199,15 +1201,10 @@ void BM_mesh_bm_to_me_for_eval(BMesh *bm, Mesh *me, const CustomData_MeshMasks *
 
   BKE_mesh_update_customdata_pointers(me, false);
 
-  BMIter iter;
-  BMVert *eve;
-  BMEdge *eed;
-  BMFace *efa;
   MVert *mvert = me->mvert;
   MEdge *medge = me->medge;
   MLoop *mloop = me->mloop;
   MPoly *mpoly = me->mpoly;
-  unsigned int i, j;
 
   const int cd_vert_bweight_offset = CustomData_get_offset(&bm->vdata, CD_BWEIGHT);
   const int cd_edge_bweight_offset = CustomData_get_offset(&bm->edata, CD_BWEIGHT);
@@ -1219,80 +1216,86 @@ void BM_mesh_bm_to_me_for_eval(BMesh *bm, Mesh *me, const CustomData_MeshMasks *
 
   me->runtime.deformed_only = true;
 
-  BM_ITER_MESH_INDEX (eve, &iter, bm, BM_VERTS_OF_MESH, i) {
-    MVert *mv = &mvert[i];
-
-    copy_v3_v3(mv->co, eve->co);
-
-    BM_elem_index_set(eve, i); /* set_inline */
-
-    mv->flag = BM_vert_flag_to_mflag(eve);
-
-    if (cd_vert_bweight_offset != -1) {
-      mv->bweight = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(eve, cd_vert_bweight_offset);
-    }
-
-    CustomData_from_bmesh_block(&bm->vdata, &me->vdata, eve->head.data, i);
-  }
-  bm->elem_index_dirty &= ~BM_VERT;
-
-  BM_ITER_MESH_INDEX (eed, &iter, bm, BM_EDGES_OF_MESH, i) {
-    MEdge *med = &medge[i];
-
-    BM_elem_index_set(eed, i); /* set_inline */
+  /* Valid indices and element tables let vertices, edges and faces be written independently.
+   * Loop indices follow face order, so they are the final loop offsets too. */
+  BM_mesh_elem_index_ensure(bm, BM_VERT | BM_EDGE | BM_FACE | BM_LOOP);
+  BM_mesh_elem_table_ensure(bm, BM_VERT | BM_EDGE | BM_FACE);
 
-    med->v1 = BM_elem_index_get(eed->v1);
-    med->v2 = BM_elem_index_get(eed->v2);
+  threading::parallel_invoke(
+      [&]() {
+        threading::parallel_for(IndexRange(bm->totvert), 1024, [&](IndexRange range) {
+          for (const int i : range) {
+            BMVert *eve = bm->vtable[i];
+            MVert *mv = &mvert[i];
 
-    med->flag = BM_edge_flag_to_mflag(eed);
+            copy_v3_v3(mv->co, eve->co);
 
-    /* Handle this differently to editmode switching,
-     * only enable draw for single user edges rather than calculating angle. */
-    if ((med->flag & ME_EDGEDRAW) == 0) {
-      if (eed->l && eed->l == eed->l->radial_next) {
-        med->flag |= ME_EDGEDRAW;
-      }
-    }
+            mv->flag = BM_vert_flag_to_mflag(eve);
 
-    if (cd_edge_crease_offset != -1) {
-      med->crease = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(eed, cd_edge_crease_offset);
-    }
-    if (cd_edge_bweight_offset != -1) {
-      med->bweight = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(eed, cd_edge_bweight_offset);
-    }
-
-    CustomData_from_bmesh_block(&bm->edata, &me->edata, eed->head.data, i);
-  }
-  bm->elem_index_dirty &= ~BM_EDGE;
-
-  j = 0;
-  BM_ITER_MESH_INDEX (efa, &iter, bm, BM_FACES_OF_MESH, i) {
-    BMLoop *l_iter;
-    BMLoop *l_first;
-    MPoly *mp = &mpoly[i];
-
-    BM_elem_index_set(efa, i); /* set_inline */
-
-    mp->totloop = efa->len;
-    mp->flag = BM_face_flag_to_mflag(efa);
-    mp->loopstart = j;
-    mp->mat_nr = efa->mat_nr;
-
-    l_iter = l_first = BM_FACE_FIRST_LOOP(efa);
-    do {
-      mloop->v = BM_elem_index_get(l_iter->v);
-      mloop->e = BM_elem_index_get(l_iter->e);
-      CustomData_from_bmesh_block(&bm->ldata, &me->ldata, l_iter->head.data, j);
+            if (cd_vert_bweight_offset != -1) {
+              mv->bweight = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(eve, cd_vert_bweight_offset);
+            }
 
-      BM_elem_index_set(l_iter, j); /* set_inline */
+            CustomData_from_bmesh_block(&bm->vdata, &me->vdata, eve->head.data, i);
+          }
+        });
+      },
+      [&]() {
+        threading::parallel_for(IndexRange(bm->totedge), 1024, [&](IndexRange range) {
+          for (const int i : range) {
+            BMEdge *eed = bm->etable[i];
+            MEdge *med = &medge[i];
+
+            med->v1 = BM_elem_index_get(eed->v1);
+            med->v2 = BM_elem_index_get(eed->v2);
+
+            med->flag = BM_edge_flag_to_mflag(eed);
+
+            /* Handle this differently to editmode switching,
+             * only enable draw for single user edges rather than calculating angle. */
+            if ((med->flag & ME_EDGEDRAW) == 0) {
+              if (eed->l && eed->l == eed->l->radial_next) {
+                med->flag |= ME_EDGEDRAW;
+              }
+            }
 
-      j++;
-      mloop++;
-    } while ((l_iter = l_iter->next) != l_first);
+            if (cd_edge_crease_offset != -1) {
+              med->crease = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(eed, cd_edge_crease_offset);
+            }
+            if (cd_edge_bweight_offset != -1) {
+              med->bweight = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(eed, cd_edge_bweight_offset);
+            }
 
-    CustomData_from_bmesh_block(&bm->pdata, &me->pdata, efa->head.data, i);
-  }
-  bm->elem_index_dirty &= ~(BM_FACE | BM_LOOP);
+            CustomData_from_bmesh_block(&bm->edata, &me->edata, eed->head.data, i);
+          }
+        });
+      },
+      [&]() {
+        threading::parallel_for(IndexRange(bm->totface), 1024, [&](IndexRange range) {
+          for (const int i : range) {
+            BMFace *efa = bm->ftable[i];
+            MPoly *mp = &mpoly[i];
+            BMLoop *l_first = BM_FACE_FIRST_LOOP(efa);
+
+            mp->totloop = efa->len;
+            mp->flag = BM_face_flag_to_mflag(efa);
+            mp->loopstart = BM_elem_index_get(l_first);
+            mp->mat_nr = efa->mat_nr;
+
+            BMLoop *l_iter = l_first;
+            int j = mp->loopstart;
+            do {
+              MLoop *ml = &mloop[j];
+              ml->v = BM_elem_index_get(l_iter->v);
+              ml->e = BM_elem_index_get(l_iter->e);
+              CustomData_from_bmesh_block(&bm->ldata, &me->ldata, l_iter->head.data, j);
+              j++;
+            } while ((l_iter = l_iter->next) != l_first);
+
+            CustomData_from_bmesh_block(&bm->pdata, &me->pdata, efa->head.data, i);
+          }
+        });
+      });
 
   me->cd_flag = BM_mesh_cd_flag_from_bmesh(bm);
 }
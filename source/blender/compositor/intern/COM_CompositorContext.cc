@@ -12,6 +12,7 @@ CompositorContext::CompositorContext()
   quality_ = eCompositorQuality::High;
   hasActiveOpenCLDevices_ = false;
   fast_calculation_ = false;
+  resolution_factor_ = 1.0f;
   bnodetree_ = nullptr;
 }
 
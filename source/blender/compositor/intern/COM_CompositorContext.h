@@ -64,6 +64,11 @@ class CompositorContext {
    */
   bool fast_calculation_;
 
+  /**
+   * \brief Factor of the resolution images are composited at, lower than 1 for quick previews.
+   */
+  float resolution_factor_;
+
   /**
    * \brief active rendering view name
    */
@@ -220,6 +225,18 @@ class CompositorContext {
   {
     return fast_calculation_;
   }
+  void set_resolution_factor(float resolution_factor)
+  {
+    resolution_factor_ = resolution_factor;
+  }
+  /**
+   * Nodes with sizes in pixels should multiply them by this factor, image inputs are scaled by it
+   * at the start of the tree and back at the outputs.
+   */
+  float get_resolution_factor() const
+  {
+    return resolution_factor_;
+  }
   bool is_groupnode_buffer_enabled() const
   {
     return (this->get_bnodetree()->flag & NTREE_COM_GROUPNODE_BUFFER) != 0;
@@ -23,7 +23,8 @@ ExecutionSystem::ExecutionSystem(RenderData *rd,
                                  bNodeTree *editingtree,
                                  bool rendering,
                                  bool fastcalculation,
-                                 const char *view_name)
+                                 const char *view_name,
+                                 float resolution_factor)
 {
   num_work_threads_ = WorkScheduler::get_num_cpu_threads();
   context_.set_view_name(view_name);
@@ -31,6 +32,7 @@ ExecutionSystem::ExecutionSystem(RenderData *rd,
   context_.set_bnodetree(editingtree);
   context_.set_preview_hash(editingtree->previews);
   context_.set_fast_calculation(fastcalculation);
+  context_.set_resolution_factor(resolution_factor);
   /* initialize the CompositorContext */
   if (rendering) {
     context_.set_quality((eCompositorQuality)editingtree->render_quality);
@@ -154,13 +154,16 @@ class ExecutionSystem {
    *
    * \param editingtree: [bNodeTree *]
    * \param rendering: [true false]
+   * \param resolution_factor: scale of the composited images, see
+   * #CompositorContext::get_resolution_factor.
    */
   ExecutionSystem(RenderData *rd,
                   Scene *scene,
                   bNodeTree *editingtree,
                   bool rendering,
                   bool fastcalculation,
-                  const char *view_name);
+                  const char *view_name,
+                  float resolution_factor = 1.0f);
 
   /**
    * Destructor
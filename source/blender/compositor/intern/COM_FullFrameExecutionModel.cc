@@ -3,15 +3,26 @@
 
 #include "COM_FullFrameExecutionModel.h"
 
+#include "BLI_set.hh"
+
 #include "BLT_translation.h"
 
+#include "DNA_userdef_types.h"
+
+#include "DRW_engine.h"
+
+#include "GPU_capabilities.h"
+#include "GPU_compute.h"
+#include "GPU_shader.h"
+#include "GPU_state.h"
+#include "GPU_texture.h"
+
 #include "COM_Debug.h"
+#include "COM_OperationResultCache.h"
 #include "COM_ViewerOperation.h"
 #include "COM_WorkScheduler.h"
 
-#ifdef WITH_CXX_GUARDEDALLOC
-#  include "MEM_guardedalloc.h"
-#endif
+#include "MEM_guardedalloc.h"
 
 namespace blender::compositor {
 
@@ -37,7 +48,19 @@ void FullFrameExecutionModel::execute(ExecutionSystem &exec_system)
   DebugInfo::graphviz(&exec_system, "compositor_prior_rendering");
 
   determine_areas_to_render_and_reads();
+  const bool use_gpu = determine_gpu_operations();
   render_operations();
+  if (use_gpu) {
+    free_gpu_data();
+  }
+
+  /* Give back the cached results that weren't used because the execution was cancelled. */
+  for (Map<NodeOperation *, std::unique_ptr<MemoryBuffer>>::MutableItem item :
+       cached_buffers_.items()) {
+    if (item.value) {
+      OperationResultCache::get().add(*item.key->get_result_key(), std::move(item.value));
+    }
+  }
 }
 
 void FullFrameExecutionModel::determine_areas_to_render_and_reads()
@@ -93,6 +116,15 @@ MemoryBuffer *FullFrameExecutionModel::create_operation_buffer(NodeOperation *op
 
 void FullFrameExecutionModel::render_operation(NodeOperation *op)
 {
+  if (cached_buffers_.contains(op)) {
+    render_cached_operation(op);
+    return;
+  }
+  if (gpu_operations_.contains(op)) {
+    render_operation_gpu(op);
+    return;
+  }
+
   /* Output has no offset for easier image algorithms implementation on operations. */
   constexpr int output_x = 0;
   constexpr int output_y = 0;
@@ -118,6 +150,243 @@ void FullFrameExecutionModel::render_operation(NodeOperation *op)
   operation_finished(op);
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Cached Operations
+ * \{ */
+
+bool FullFrameExecutionModel::take_cached_result(NodeOperation *op)
+{
+  if (cached_buffers_.contains(op)) {
+    return true;
+  }
+  const std::optional<OperationResultKey> &key = op->get_result_key();
+  if (!key) {
+    return false;
+  }
+  std::unique_ptr<MemoryBuffer> buffer = OperationResultCache::get().take(*key);
+  if (!buffer) {
+    return false;
+  }
+  cached_buffers_.add_new(op, std::move(buffer));
+  return true;
+}
+
+void FullFrameExecutionModel::render_cached_operation(NodeOperation *op)
+{
+  /* Inputs weren't rendered, there are no reads to report. */
+  std::unique_ptr<MemoryBuffer> &buffer = cached_buffers_.lookup(op);
+  DebugInfo::operation_rendered(op, buffer.get());
+  active_buffers_.set_rendered_buffer(op, std::move(buffer));
+
+  num_operations_finished_++;
+  update_progress_bar();
+}
+
+void FullFrameExecutionModel::cache_result(NodeOperation *op, std::unique_ptr<MemoryBuffer> buffer)
+{
+  const std::optional<OperationResultKey> &key = op->get_result_key();
+  if (!key || buffer->is_a_single_elem()) {
+    return;
+  }
+  if (!cached_buffers_.contains(op)) {
+    /* Results of a cancelled execution may be incomplete. */
+    const bNodeTree *node_tree = context_.get_bnodetree();
+    if (node_tree->test_break(node_tree->tbh)) {
+      return;
+    }
+    /* Only results of the whole canvas can be reused by any reader. */
+    const rcti &canvas = op->get_canvas();
+    bool is_whole_canvas = false;
+    for (const rcti &area : active_buffers_.get_areas_to_render(op, 0, 0)) {
+      is_whole_canvas |= BLI_rcti_inside_rcti(&area, &canvas);
+    }
+    if (!is_whole_canvas) {
+      return;
+    }
+  }
+  OperationResultCache::get().add(*key, std::move(buffer));
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name GPU Operations
+ * \{ */
+
+/** Matches the local group size of the compositor compute shaders. */
+static constexpr int GPU_GROUP_SIZE = 16;
+
+static bool is_gpu_data_type(const DataType data_type)
+{
+  return ELEM(data_type, DataType::Value, DataType::Color);
+}
+
+static eGPUTextureFormat gpu_texture_format(const int num_channels)
+{
+  return num_channels == COM_DATA_TYPE_VALUE_CHANNELS ? GPU_R32F : GPU_RGBA32F;
+}
+
+bool FullFrameExecutionModel::determine_gpu_operations()
+{
+  if (!U.experimental.use_compositor_gpu || !GPU_compute_shader_support()) {
+    return false;
+  }
+
+  for (NodeOperation *op : operations_) {
+    if (op->get_gpu_shader_name() == nullptr || op->get_number_of_output_sockets() == 0 ||
+        op->get_width() == 0 || op->get_height() == 0 ||
+        !is_gpu_data_type(op->get_output_socket()->get_data_type())) {
+      continue;
+    }
+    bool inputs_supported = true;
+    for (int i = 0; i < op->get_number_of_input_sockets(); i++) {
+      NodeOperation *input_op = op->get_input_operation(i);
+      if (input_op->get_width() == 0 || input_op->get_height() == 0 ||
+          !is_gpu_data_type(input_op->get_output_socket()->get_data_type())) {
+        inputs_supported = false;
+        break;
+      }
+    }
+    if (inputs_supported) {
+      gpu_operations_.add(op);
+    }
+  }
+
+  for (NodeOperation *op : operations_) {
+    const bool is_gpu_reader = gpu_operations_.contains(op);
+    for (int i = 0; i < op->get_number_of_input_sockets(); i++) {
+      NodeOperation *input_op = op->get_input_operation(i);
+      if (is_gpu_reader) {
+        gpu_reads_.lookup_or_add(input_op, 0)++;
+      }
+      else if (gpu_operations_.contains(input_op)) {
+        gpu_read_back_operations_.add(input_op);
+      }
+    }
+  }
+
+  return !gpu_operations_.is_empty();
+}
+
+GPUTexture *FullFrameExecutionModel::get_gpu_input_texture(NodeOperation *input_op)
+{
+  return gpu_textures_.lookup_or_add_cb(input_op, [&]() {
+    /* Rendered on the CPU, upload its buffer. Single element buffers become 1x1 textures. */
+    MemoryBuffer *buf = active_buffers_.get_rendered_buffer(input_op);
+    return GPU_texture_create_2d("compositor_input",
+                                 buf->get_memory_width(),
+                                 buf->get_memory_height(),
+                                 1,
+                                 gpu_texture_format(buf->get_num_channels()),
+                                 buf->get_buffer());
+  });
+}
+
+void FullFrameExecutionModel::gpu_read_finished(NodeOperation *input_op)
+{
+  int &reads = gpu_reads_.lookup(input_op);
+  reads--;
+  if (reads == 0) {
+    GPUTexture *texture = gpu_textures_.pop_default(input_op, nullptr);
+    if (texture) {
+      GPU_texture_free(texture);
+    }
+  }
+}
+
+void FullFrameExecutionModel::render_operation_gpu(NodeOperation *op)
+{
+  const int width = op->get_width();
+  const int height = op->get_height();
+  const bool read_back = gpu_read_back_operations_.contains(op);
+
+  /* Operations only read by other GPU operations keep their result on the device, their buffer is
+   * a single element placeholder. */
+  rcti rect;
+  BLI_rcti_init(&rect, 0, width, 0, height);
+  MemoryBuffer *op_buf = new MemoryBuffer(
+      op->get_output_socket()->get_data_type(), rect, !read_back);
+
+  DRW_opengl_context_enable();
+
+  const char *shader_name = op->get_gpu_shader_name();
+  GPUShader *shader = gpu_shaders_.lookup_or_add_cb(
+      shader_name, [&]() { return GPU_shader_create_from_info_name(shader_name); });
+  GPU_shader_bind(shader);
+  op->set_gpu_shader_uniforms(shader);
+
+  const int num_inputs = op->get_number_of_input_sockets();
+  Vector<int> input_offsets;
+  for (int i = 0; i < num_inputs; i++) {
+    NodeOperation *input_op = op->get_input_operation(i);
+    GPU_texture_bind(get_gpu_input_texture(input_op), i);
+    input_offsets.append(input_op->get_canvas().xmin - op->get_canvas().xmin);
+    input_offsets.append(input_op->get_canvas().ymin - op->get_canvas().ymin);
+  }
+  if (num_inputs > 0) {
+    GPU_shader_uniform_vector_int(shader,
+                                  GPU_shader_get_uniform(shader, "input_offsets"),
+                                  2,
+                                  num_inputs,
+                                  input_offsets.data());
+  }
+
+  const eGPUTextureFormat format = gpu_texture_format(op_buf->get_num_channels());
+  GPUTexture *result = GPU_texture_create_2d(
+      "compositor_result", width, height, 1, format, nullptr);
+  GPU_texture_image_bind(result, 0);
+  GPU_compute_dispatch(shader,
+                       (width + GPU_GROUP_SIZE - 1) / GPU_GROUP_SIZE,
+                       (height + GPU_GROUP_SIZE - 1) / GPU_GROUP_SIZE,
+                       1);
+  GPU_memory_barrier(GPU_BARRIER_TEXTURE_FETCH | GPU_BARRIER_TEXTURE_UPDATE);
+  GPU_texture_image_unbind(result);
+  GPU_texture_unbind_all();
+  GPU_shader_unbind();
+
+  if (read_back) {
+    float *data = static_cast<float *>(GPU_texture_read(result, GPU_DATA_FLOAT, 0));
+    memcpy(op_buf->get_buffer(),
+           data,
+           sizeof(float) * op_buf->get_num_channels() * size_t(width) * size_t(height));
+    MEM_freeN(data);
+  }
+  if (gpu_reads_.lookup_default(op, 0) > 0) {
+    gpu_textures_.add_new(op, result);
+  }
+  else {
+    GPU_texture_free(result);
+  }
+  for (int i = 0; i < num_inputs; i++) {
+    gpu_read_finished(op->get_input_operation(i));
+  }
+
+  DRW_opengl_context_disable();
+
+  if (read_back) {
+    DebugInfo::operation_rendered(op, op_buf);
+  }
+  active_buffers_.set_rendered_buffer(op, std::unique_ptr<MemoryBuffer>(op_buf));
+  operation_finished(op);
+}
+
+void FullFrameExecutionModel::free_gpu_data()
+{
+  /* Textures left are read by GPU operations that weren't rendered. */
+  DRW_opengl_context_enable();
+  for (GPUTexture *texture : gpu_textures_.values()) {
+    GPU_texture_free(texture);
+  }
+  for (GPUShader *shader : gpu_shaders_.values()) {
+    GPU_shader_free(shader);
+  }
+  DRW_opengl_context_disable();
+  gpu_textures_.clear();
+  gpu_shaders_.clear();
+}
+
+/** \} */
+
 void FullFrameExecutionModel::render_operations()
 {
   const bool is_rendering = context_.is_rendering();
@@ -141,36 +410,35 @@ void FullFrameExecutionModel::render_operations()
 }
 
 /**
- * Returns all dependencies from inputs to outputs. A dependency may be repeated when
- * several operations depend on it.
+ * Appends all dependencies of given operation from inputs to outputs, without repetitions.
+ * Dependencies are added depth-first so that each input branch is rendered completely before
+ * the next one, allowing its intermediate buffers to be disposed as early as possible instead
+ * of keeping the buffers of all branches alive at the same time.
  */
-static Vector<NodeOperation *> get_operation_dependencies(NodeOperation *operation)
+static void add_operation_dependencies(
+    NodeOperation *operation,
+    const Map<NodeOperation *, std::unique_ptr<MemoryBuffer>> &cached_buffers,
+    Set<NodeOperation *> &visited,
+    Vector<NodeOperation *> &r_dependencies)
 {
-  /* Get dependencies from outputs to inputs. */
-  Vector<NodeOperation *> dependencies;
-  Vector<NodeOperation *> next_outputs;
-  next_outputs.append(operation);
-  while (next_outputs.size() > 0) {
-    Vector<NodeOperation *> outputs(next_outputs);
-    next_outputs.clear();
-    for (NodeOperation *output : outputs) {
-      for (int i = 0; i < output->get_number_of_input_sockets(); i++) {
-        next_outputs.append(output->get_input_operation(i));
-      }
+  if (cached_buffers.contains(operation)) {
+    return;
+  }
+  for (int i = 0; i < operation->get_number_of_input_sockets(); i++) {
+    NodeOperation *input = operation->get_input_operation(i);
+    if (visited.add(input)) {
+      add_operation_dependencies(input, cached_buffers, visited, r_dependencies);
+      r_dependencies.append(input);
     }
-    dependencies.extend(next_outputs);
   }
-
-  /* Reverse to get dependencies from inputs to outputs. */
-  std::reverse(dependencies.begin(), dependencies.end());
-
-  return dependencies;
 }
 
 void FullFrameExecutionModel::render_output_dependencies(NodeOperation *output_op)
 {
   BLI_assert(output_op->is_output_operation(context_.is_rendering()));
-  Vector<NodeOperation *> dependencies = get_operation_dependencies(output_op);
+  Set<NodeOperation *> visited;
+  Vector<NodeOperation *> dependencies;
+  add_operation_dependencies(output_op, cached_buffers_, visited, dependencies);
   for (NodeOperation *op : dependencies) {
     if (!active_buffers_.is_operation_rendered(op)) {
       render_operation(op);
@@ -195,6 +463,9 @@ void FullFrameExecutionModel::determine_areas_to_render(NodeOperation *output_op
     }
 
     active_buffers_.register_area(operation, render_area);
+    if (take_cached_result(operation)) {
+      continue;
+    }
 
     const int num_inputs = operation->get_number_of_input_sockets();
     for (int i = 0; i < num_inputs; i++) {
@@ -218,6 +489,9 @@ void FullFrameExecutionModel::determine_reads(NodeOperation *output_op)
   stack.append(output_op);
   while (stack.size() > 0) {
     NodeOperation *operation = stack.pop_last();
+    if (cached_buffers_.contains(operation)) {
+      continue;
+    }
     const int num_inputs = operation->get_number_of_input_sockets();
     for (int i = 0; i < num_inputs; i++) {
       NodeOperation *input_op = operation->get_input_operation(i);
@@ -260,7 +534,11 @@ void FullFrameExecutionModel::operation_finished(NodeOperation *operation)
   /* Report inputs reads so that buffers may be freed/reused. */
   const int num_inputs = operation->get_number_of_input_sockets();
   for (int i = 0; i < num_inputs; i++) {
-    active_buffers_.read_finished(operation->get_input_operation(i));
+    NodeOperation *input_op = operation->get_input_operation(i);
+    std::unique_ptr<MemoryBuffer> buffer = active_buffers_.read_finished(input_op);
+    if (buffer) {
+      cache_result(input_op, std::move(buffer));
+    }
   }
 
   num_operations_finished_++;
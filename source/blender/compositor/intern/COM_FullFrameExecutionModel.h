@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include "BLI_map.hh"
+#include "BLI_set.hh"
 #include "BLI_vector.hh"
 
 #include "COM_Enums.h"
@@ -12,6 +14,9 @@
 #  include "MEM_guardedalloc.h"
 #endif
 
+struct GPUShader;
+struct GPUTexture;
+
 namespace blender::compositor {
 
 /* Forward declarations. */
@@ -42,6 +47,31 @@ class FullFrameExecutionModel : public ExecutionModel {
    */
   Vector<eCompositorPriority> priorities_;
 
+  /**
+   * Operations rendered with their GPU compute shader, see #determine_gpu_operations.
+   */
+  Set<NodeOperation *> gpu_operations_;
+
+  /**
+   * GPU operations read by CPU operations, only these have their result read back.
+   */
+  Set<NodeOperation *> gpu_read_back_operations_;
+
+  /**
+   * Device side results of operations read by GPU operations: the output of GPU operations and
+   * the uploaded buffers of CPU operations. Freed once all their GPU readers are finished.
+   */
+  Map<NodeOperation *, GPUTexture *> gpu_textures_;
+  Map<NodeOperation *, int> gpu_reads_;
+
+  Map<const char *, GPUShader *> gpu_shaders_;
+
+  /**
+   * Results taken from #OperationResultCache. These operations and the inputs only they read are
+   * not rendered.
+   */
+  Map<NodeOperation *, std::unique_ptr<MemoryBuffer>> cached_buffers_;
+
  public:
   FullFrameExecutionModel(CompositorContext &context,
                           SharedOperationBuffers &shared_buffers,
@@ -64,6 +94,28 @@ class FullFrameExecutionModel : public ExecutionModel {
   MemoryBuffer *create_operation_buffer(NodeOperation *op, int output_x, int output_y);
   void render_operation(NodeOperation *op);
 
+  /**
+   * Takes the result of given operation from #OperationResultCache if it has one.
+   * \return Whether the operation result is cached.
+   */
+  bool take_cached_result(NodeOperation *op);
+  void render_cached_operation(NodeOperation *op);
+  /**
+   * Keeps the result of given operation in #OperationResultCache once it's not read anymore, when
+   * it can be reused by later executions.
+   */
+  void cache_result(NodeOperation *op, std::unique_ptr<MemoryBuffer> buffer);
+
+  /**
+   * Selects the operations to render on the GPU, when enabled in the experimental preferences.
+   * \return Whether any operation will be rendered on the GPU.
+   */
+  bool determine_gpu_operations();
+  void render_operation_gpu(NodeOperation *op);
+  GPUTexture *get_gpu_input_texture(NodeOperation *input_op);
+  void gpu_read_finished(NodeOperation *input_op);
+  void free_gpu_data();
+
   void operation_finished(NodeOperation *operation);
 
   /**
@@ -8,6 +8,8 @@
 namespace blender::compositor {
 
 class MultiThreadedOperation : public NodeOperation {
+  friend class FusedOperation;
+
  protected:
   /**
    * Number of execution passes.
@@ -21,6 +21,8 @@
 
 #include "DNA_node_types.h"
 
+struct GPUShader;
+
 namespace blender::compositor {
 
 class OpenCLDevice;
@@ -237,6 +239,13 @@ struct NodeOperationFlags {
    */
   bool can_be_constant : 1;
 
+  /**
+   * Whether each output pixel only depends on the input pixels at the same coordinates, and the
+   * operation is a #MultiThreadedOperation rendered in a single pass. Chains of such operations
+   * are fused into a #FusedOperation in full-frame execution.
+   */
+  bool is_pixel_local : 1;
+
   NodeOperationFlags()
   {
     complex = false;
@@ -255,6 +264,7 @@ struct NodeOperationFlags {
     is_fullframe_operation = false;
     is_constant_operation = false;
     can_be_constant = false;
+    is_pixel_local = false;
   }
 };
 
@@ -274,6 +284,11 @@ struct NodeOperationHash {
     return operation_;
   }
 
+  size_t get_params_hash() const
+  {
+    return params_hash_;
+  }
+
   bool operator==(const NodeOperationHash &other) const
   {
     return type_hash_ == other.type_hash_ && parents_hash_ == other.parents_hash_ &&
@@ -294,6 +309,29 @@ struct NodeOperationHash {
   }
 };
 
+/**
+ * Identifies an operation output result across executions, see #OperationResultCache.
+ * Unlike #NodeOperationHash it doesn't depend on the operation ids, but on the nodes, constants
+ * and external data the result is computed from, including the keys of its inputs.
+ */
+struct OperationResultKey {
+  size_t type_hash;
+  size_t content_hash;
+  rcti canvas;
+  DataType data_type;
+
+  uint64_t hash() const
+  {
+    return content_hash;
+  }
+
+  friend bool operator==(const OperationResultKey &a, const OperationResultKey &b)
+  {
+    return a.type_hash == b.type_hash && a.content_hash == b.content_hash &&
+           BLI_rcti_compare(&a.canvas, &b.canvas) && a.data_type == b.data_type;
+  }
+};
+
 /**
  * \brief NodeOperation contains calculation logic
  *
@@ -310,6 +348,9 @@ class NodeOperation {
   size_t params_hash_;
   bool is_hash_output_params_implemented_;
 
+  /** Set when the result can be kept in #OperationResultCache. */
+  std::optional<OperationResultKey> result_key_;
+
   /**
    * \brief the index of the input socket that will be used to determine the canvas
    */
@@ -390,6 +431,26 @@ class NodeOperation {
    */
   std::optional<NodeOperationHash> generate_hash();
 
+  void set_result_key(const std::optional<OperationResultKey> &key)
+  {
+    result_key_ = key;
+  }
+
+  const std::optional<OperationResultKey> &get_result_key() const
+  {
+    return result_key_;
+  }
+
+  /**
+   * Hash of the data the operation reads from outside of its node and inputs (i.e. a render
+   * result), or `std::nullopt` when the operation result can't be cached across executions.
+   * Only called for operations of nodes using an ID, these aren't cached by default.
+   */
+  virtual std::optional<size_t> hash_external_data() const
+  {
+    return std::nullopt;
+  }
+
   unsigned int get_number_of_input_sockets() const
   {
     return inputs_.size();
@@ -651,6 +712,32 @@ class NodeOperation {
 
   /** \} */
 
+  /* -------------------------------------------------------------------- */
+  /** \name GPU Methods
+   * \{ */
+
+  /**
+   * Name of the shader create info of a compute shader that renders this operation on the GPU,
+   * or nullptr when the operation can only be rendered on the CPU.
+   *
+   * The shader reads input `i` from the sampler bound to slot `i`, at the output texel minus
+   * `input_offsets[i]`, and writes the whole canvas to the image bound to slot 0.
+   * Used by #FullFrameExecutionModel when GPU compositing is enabled.
+   */
+  virtual const char *get_gpu_shader_name() const
+  {
+    return nullptr;
+  }
+
+  /**
+   * Set the operation parameters on the bound shader of #get_gpu_shader_name.
+   */
+  virtual void set_gpu_shader_uniforms(GPUShader * /*shader*/) const
+  {
+  }
+
+  /** \} */
+
  protected:
   NodeOperation();
 
@@ -3,14 +3,24 @@
 
 #include <set>
 
+#include "BLI_hash_mm2a.h"
 #include "BLI_multi_value_map.hh"
+#include "BLI_set.hh"
+
+#include "BKE_node.h"
+
+#include "DNA_genfile.h"
+#include "DNA_userdef_types.h"
 
 #include "COM_Converter.h"
 #include "COM_Debug.h"
 
 #include "COM_ExecutionGroup.h"
+#include "COM_FusedOperation.h"
+#include "COM_OperationResultCache.h"
 #include "COM_PreviewOperation.h"
 #include "COM_ReadBufferOperation.h"
+#include "COM_ScaleOperation.h"
 #include "COM_SetColorOperation.h"
 #include "COM_SetValueOperation.h"
 #include "COM_SetVectorOperation.h"
@@ -25,7 +35,11 @@ namespace blender::compositor {
 NodeOperationBuilder::NodeOperationBuilder(const CompositorContext *context,
                                            bNodeTree *b_nodetree,
                                            ExecutionSystem *system)
-    : context_(context), exec_system_(system), current_node_(nullptr), active_viewer_(nullptr)
+    : context_(context),
+      exec_system_(system),
+      current_node_(nullptr),
+      current_node_num_operations_(0),
+      active_viewer_(nullptr)
 {
   graph_.from_bNodeTree(*context, b_nodetree);
 }
@@ -37,6 +51,7 @@ void NodeOperationBuilder::convert_to_operations(ExecutionSystem *system)
 
   for (Node *node : graph_.nodes()) {
     current_node_ = node;
+    current_node_num_operations_ = 0;
 
     DebugInfo::node_to_operations(node);
     node->convert_to_operations(converter, *context_);
@@ -81,6 +96,11 @@ void NodeOperationBuilder::convert_to_operations(ExecutionSystem *system)
 
   add_datatype_conversions();
 
+  if (context_->get_execution_model() == eExecutionModel::FullFrame &&
+      context_->get_resolution_factor() != 1.0f) {
+    add_resolution_factor_scales();
+  }
+
   if (context_->get_execution_model() == eExecutionModel::FullFrame) {
     save_graphviz("compositor_prior_folding");
     ConstantFolder folder(*this);
@@ -92,6 +112,13 @@ void NodeOperationBuilder::convert_to_operations(ExecutionSystem *system)
   save_graphviz("compositor_prior_merging");
   merge_equal_operations();
 
+  if (context_->get_execution_model() == eExecutionModel::FullFrame) {
+    if (!context_->is_rendering() && OperationResultCache::is_enabled()) {
+      determine_result_keys();
+    }
+    fuse_pixel_local_operations();
+  }
+
   if (context_->get_execution_model() == eExecutionModel::Tiled) {
     /* surround complex ops with read/write buffer */
     add_complex_operation_buffers();
@@ -121,6 +148,12 @@ void NodeOperationBuilder::add_operation(NodeOperation *operation)
   operations_.append(operation);
   if (current_node_) {
     operation->set_name(current_node_->get_bnode()->name);
+    operation_nodes_.add_overwrite(
+        operation, {current_node_->get_bnode(), current_node_num_operations_++});
+  }
+  else {
+    /* Operations may be allocated at the address of a deleted one. */
+    operation_nodes_.remove(operation);
   }
   operation->set_execution_model(context_->get_execution_model());
   operation->set_execution_system(exec_system_);
@@ -305,6 +338,73 @@ void NodeOperationBuilder::add_datatype_conversions()
   }
 }
 
+NodeOperation *NodeOperationBuilder::make_resolution_scale(NodeOperationOutput *output,
+                                                          const float factor)
+{
+  SetValueOperation *factor_op = new SetValueOperation();
+  factor_op->set_value(factor);
+  add_operation(factor_op);
+
+  ScaleRelativeOperation *scale_op = new ScaleRelativeOperation(output->get_data_type());
+  scale_op->set_sampler(PixelSampler::Bilinear);
+  add_operation(scale_op);
+
+  add_link(output, scale_op->get_input_socket(0));
+  add_link(factor_op->get_output_socket(), scale_op->get_input_socket(1));
+  add_link(factor_op->get_output_socket(), scale_op->get_input_socket(2));
+  return scale_op;
+}
+
+void NodeOperationBuilder::add_resolution_factor_scales()
+{
+  const float factor = context_->get_resolution_factor();
+
+  /* Operations are cached first to avoid modifying operations_ while iterating over it. */
+  Vector<NodeOperation *> sources;
+  Vector<NodeOperation *> outputs;
+  for (NodeOperation *op : operations_) {
+    if (op->get_flags().is_constant_operation || op->get_flags().is_preview_operation) {
+      continue;
+    }
+    if (op->is_output_operation(context_->is_rendering())) {
+      outputs.append(op);
+    }
+    else if (op->get_number_of_input_sockets() == 0 && op->get_number_of_output_sockets() > 0) {
+      sources.append(op);
+    }
+  }
+
+  /* Images are read in full resolution, scale them down before the rest of the tree. */
+  for (NodeOperation *source : sources) {
+    for (int i = 0; i < source->get_number_of_output_sockets(); i++) {
+      NodeOperationOutput *output = source->get_output_socket(i);
+      Vector<NodeOperationInput *> targets = cache_output_links(output);
+      if (targets.is_empty()) {
+        continue;
+      }
+      NodeOperation *scale_op = make_resolution_scale(output, factor);
+      for (NodeOperationInput *target : targets) {
+        remove_input_link(target);
+        add_link(scale_op->get_output_socket(), target);
+      }
+    }
+  }
+
+  /* Scale results back, so outputs keep their size. */
+  for (NodeOperation *output_op : outputs) {
+    for (int i = 0; i < output_op->get_number_of_input_sockets(); i++) {
+      NodeOperationInput *input = output_op->get_input_socket(i);
+      NodeOperationOutput *link = input->get_link();
+      if (link == nullptr || link->get_operation().get_flags().is_constant_operation) {
+        continue;
+      }
+      NodeOperation *scale_op = make_resolution_scale(link, 1.0f / factor);
+      remove_input_link(input);
+      add_link(scale_op->get_output_socket(), input);
+    }
+  }
+}
+
 void NodeOperationBuilder::add_operation_input_constants()
 {
   /* NOTE: unconnected inputs cached first to avoid modifying
@@ -498,6 +598,220 @@ void NodeOperationBuilder::merge_equal_operations(NodeOperation *from, NodeOpera
   delete from;
 }
 
+static bool is_fusion_candidate(NodeOperation *op)
+{
+  if (!op->get_flags().is_pixel_local) {
+    return false;
+  }
+  if (U.experimental.use_compositor_gpu && op->get_gpu_shader_name() != nullptr) {
+    /* Rendered on the GPU instead. */
+    return false;
+  }
+  for (int i = 0; i < op->get_number_of_input_sockets(); i++) {
+    if (!op->get_input_socket(i)->is_connected()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/** Appends the operations fused into given one, inputs before their reader. */
+static void add_fused_operations_recursive(NodeOperation *op,
+                                           const Set<NodeOperation *> &fused_into_reader,
+                                           Vector<NodeOperation *> &r_group)
+{
+  for (int i = 0; i < op->get_number_of_input_sockets(); i++) {
+    NodeOperation *input_op = &op->get_input_socket(i)->get_link()->get_operation();
+    if (fused_into_reader.contains(input_op)) {
+      add_fused_operations_recursive(input_op, fused_into_reader, r_group);
+    }
+  }
+  r_group.append(op);
+}
+
+void NodeOperationBuilder::fuse_pixel_local_operations()
+{
+  Map<NodeOperation *, int> num_readers;
+  for (const Link &link : links_) {
+    num_readers.lookup_or_add(&link.from()->get_operation(), 0)++;
+  }
+
+  /* Operations only read by a single pixel-local operation with the same canvas are rendered
+   * together with it. */
+  Set<NodeOperation *> fused_into_reader;
+  for (const Link &link : links_) {
+    NodeOperation *from = &link.from()->get_operation();
+    NodeOperation *to = &link.to()->get_operation();
+    if (is_fusion_candidate(from) && is_fusion_candidate(to) && num_readers.lookup(from) == 1 &&
+        BLI_rcti_compare(&from->get_canvas(), &to->get_canvas())) {
+      fused_into_reader.add(from);
+    }
+  }
+  if (fused_into_reader.is_empty()) {
+    return;
+  }
+
+  /* Copy as the grouped operations are removed from the list. */
+  const Vector<NodeOperation *> operations = operations_;
+  for (NodeOperation *op : operations) {
+    if (!is_fusion_candidate(op) || fused_into_reader.contains(op)) {
+      continue;
+    }
+    Vector<NodeOperation *> group;
+    add_fused_operations_recursive(op, fused_into_reader, group);
+    if (group.size() < 2) {
+      continue;
+    }
+
+    FusedOperation *fused_op = new FusedOperation(group);
+    add_operation(fused_op);
+    for (int i = 0; i < fused_op->get_number_of_input_sockets(); i++) {
+      add_link(fused_op->get_external_input(i)->get_link(), fused_op->get_input_socket(i));
+    }
+    /* Inputs come before their readers, so links between grouped operations are relinked to the
+     * fused operation first and then removed with the links of their reader. */
+    for (NodeOperation *grouped_op : group) {
+      unlink_inputs_and_relink_outputs(grouped_op, fused_op);
+      operations_.remove_first_occurrence_and_reorder(grouped_op);
+    }
+  }
+}
+
+/**
+ * Hash of the node settings an operation result may depend on, `std::nullopt` when they can't be
+ * hashed.
+ */
+static std::optional<size_t> hash_node_settings(const bNode &node)
+{
+  if (node.type == CMP_NODE_DEFOCUS) {
+    /* Reads the scene camera. */
+    return std::nullopt;
+  }
+
+  size_t hash = get_default_hash_3(node.typeinfo, StringRef(node.name), node.custom1);
+  hash = BLI_ghashutil_combine_hash(hash,
+                                    get_default_hash_3(node.custom2, node.custom3, node.custom4));
+  /* Operation settings may be read from unlinked inputs. */
+  LISTBASE_FOREACH (const bNodeSocket *, socket, &node.inputs) {
+    switch (socket->type) {
+      case SOCK_FLOAT:
+        hash = BLI_ghashutil_combine_hash(
+            hash, get_default_hash(((const bNodeSocketValueFloat *)socket->default_value)->value));
+        break;
+      case SOCK_VECTOR: {
+        const float *value = ((const bNodeSocketValueVector *)socket->default_value)->value;
+        hash = BLI_ghashutil_combine_hash(hash, get_default_hash_3(value[0], value[1], value[2]));
+        break;
+      }
+      case SOCK_RGBA: {
+        const float *value = ((const bNodeSocketValueRGBA *)socket->default_value)->value;
+        hash = BLI_ghashutil_combine_hash(hash, get_default_hash_2(value[0], value[1]));
+        hash = BLI_ghashutil_combine_hash(hash, get_default_hash_2(value[2], value[3]));
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  if (node.storage == nullptr) {
+    return hash;
+  }
+  const SDNA *sdna = DNA_sdna_current_get();
+  const int struct_nr = DNA_struct_find_nr(sdna, node.typeinfo->storagename);
+  if (struct_nr == -1 || DNA_struct_has_pointers(sdna, struct_nr)) {
+    return std::nullopt;
+  }
+  const int size = sdna->types_size[sdna->structs[struct_nr]->type];
+  return BLI_ghashutil_combine_hash(
+      hash, BLI_hash_mm2(static_cast<const unsigned char *>(node.storage), size, 0));
+}
+
+std::optional<OperationResultKey> NodeOperationBuilder::compute_result_key(
+    NodeOperation *op,
+    const size_t context_hash,
+    Map<NodeOperation *, std::optional<OperationResultKey>> &keys) const
+{
+  if (const std::optional<OperationResultKey> *key = keys.lookup_ptr(op)) {
+    return *key;
+  }
+  /* Stays unset when the result can't be cached. */
+  keys.add_new(op, std::nullopt);
+  if (op->get_number_of_output_sockets() == 0) {
+    return std::nullopt;
+  }
+
+  size_t content_hash = context_hash;
+  if (op->get_flags().is_constant_operation) {
+    const float *elem = static_cast<ConstantOperation *>(op)->get_constant_elem();
+    const DataType data_type = op->get_output_socket()->get_data_type();
+    for (const int i : IndexRange(COM_data_type_num_channels(data_type))) {
+      content_hash = BLI_ghashutil_combine_hash(content_hash, get_default_hash(elem[i]));
+    }
+  }
+  else if (const std::pair<const bNode *, int> *node = operation_nodes_.lookup_ptr(op)) {
+    const std::optional<size_t> node_hash = hash_node_settings(*node->first);
+    if (!node_hash) {
+      return std::nullopt;
+    }
+    content_hash = BLI_ghashutil_combine_hash(content_hash,
+                                              get_default_hash_2(*node_hash, node->second));
+    if (node->first->id) {
+      const std::optional<size_t> external_hash = op->hash_external_data();
+      if (!external_hash) {
+        return std::nullopt;
+      }
+      content_hash = BLI_ghashutil_combine_hash(content_hash, *external_hash);
+    }
+  }
+  else {
+    /* Added by the compiler, i.e. conversions. */
+    const std::optional<NodeOperationHash> op_hash = op->generate_hash();
+    if (!op_hash) {
+      return std::nullopt;
+    }
+    content_hash = BLI_ghashutil_combine_hash(content_hash, op_hash->get_params_hash());
+  }
+
+  for (int i = 0; i < op->get_number_of_input_sockets(); i++) {
+    NodeOperationInput *socket = op->get_input_socket(i);
+    if (!socket->is_connected()) {
+      return std::nullopt;
+    }
+    const std::optional<OperationResultKey> input_key = compute_result_key(
+        &socket->get_link()->get_operation(), context_hash, keys);
+    if (!input_key) {
+      return std::nullopt;
+    }
+    content_hash = BLI_ghashutil_combine_hash(
+        content_hash, get_default_hash_2(input_key->type_hash, input_key->content_hash));
+  }
+
+  const OperationResultKey key{typeid(*op).hash_code(),
+                               content_hash,
+                               op->get_canvas(),
+                               op->get_output_socket()->get_data_type()};
+  keys.add_overwrite(op, key);
+  return key;
+}
+
+void NodeOperationBuilder::determine_result_keys()
+{
+  const RenderData *rd = context_->get_render_data();
+  size_t context_hash = get_default_hash_4(context_->get_scene(),
+                                           int(context_->get_quality()),
+                                           context_->is_fast_calculation(),
+                                           context_->get_resolution_factor());
+  context_hash = BLI_ghashutil_combine_hash(
+      context_hash,
+      get_default_hash_2(StringRef(context_->get_view_name() ? context_->get_view_name() : ""),
+                         BLI_hash_mm2((const unsigned char *)rd, sizeof(*rd), 0)));
+
+  Map<NodeOperation *, std::optional<OperationResultKey>> keys;
+  for (NodeOperation *op : operations_) {
+    op->set_result_key(compute_result_key(op, context_hash, keys));
+  }
+}
+
 Vector<NodeOperationInput *> NodeOperationBuilder::cache_output_links(
     NodeOperationOutput *output) const
 {
@@ -64,6 +64,14 @@ class NodeOperationBuilder {
   Map<NodeOutput *, NodeOperationOutput *> output_map_;
 
   Node *current_node_;
+  /** Number of operations added by #current_node_ so far. */
+  int current_node_num_operations_;
+
+  /**
+   * Node that added each operation and the order in which it was added, identifying the
+   * operation result in #determine_result_keys.
+   */
+  Map<NodeOperation *, std::pair<const bNode *, int>> operation_nodes_;
 
   /** Operation that will be writing to the viewer image
    *  Only one operation can occupy this place at a time,
@@ -129,6 +137,10 @@ class NodeOperationBuilder {
   /** Replace proxy operations with direct links */
   void resolve_proxies();
 
+  /** Scale images after source operations and before outputs by the context resolution factor */
+  void add_resolution_factor_scales();
+  NodeOperation *make_resolution_scale(NodeOperationOutput *output, float factor);
+
   /** Calculate canvas area for each operation. */
   void determine_canvases();
 
@@ -157,6 +169,14 @@ class NodeOperationBuilder {
   /** Merge operations with same type, inputs and parameters that produce the same result. */
   void merge_equal_operations();
   void merge_equal_operations(NodeOperation *from, NodeOperation *into);
+  /** Replace groups of pixel-local operations by a #FusedOperation rendering them in one pass. */
+  void fuse_pixel_local_operations();
+  /** Set the keys of operation results that can be kept in #OperationResultCache. */
+  void determine_result_keys();
+  std::optional<OperationResultKey> compute_result_key(
+      NodeOperation *op,
+      size_t context_hash,
+      Map<NodeOperation *, std::optional<OperationResultKey>> &keys) const;
   void save_graphviz(StringRefNull name = "");
 #ifdef WITH_CXX_GUARDEDALLOC
   MEM_CXX_CLASS_ALLOC_FUNCS("COM:NodeCompilerImpl")
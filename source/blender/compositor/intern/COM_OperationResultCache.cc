@@ -0,0 +1,99 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2022 Blender Foundation. */
+
+#include "BKE_global.h"
+
+#include "DNA_userdef_types.h"
+
+#include "COM_MemoryBuffer.h"
+#include "COM_OperationResultCache.h"
+
+namespace blender::compositor {
+
+static OperationResultCache *g_result_cache = nullptr;
+
+static int64_t result_cache_limit()
+{
+  return int64_t(U.compositor_cache_limit) * 1024 * 1024;
+}
+
+static int64_t buffer_size(const MemoryBuffer &buffer)
+{
+  return int64_t(buffer.get_memory_width()) * buffer.get_memory_height() *
+         buffer.get_elem_bytes_len();
+}
+
+bool OperationResultCache::is_enabled()
+{
+  /* Render results change while rendering. */
+  return U.compositor_cache_limit > 0 && !G.is_rendering;
+}
+
+OperationResultCache &OperationResultCache::get()
+{
+  if (g_result_cache == nullptr) {
+    g_result_cache = new OperationResultCache();
+  }
+  return *g_result_cache;
+}
+
+void OperationResultCache::free()
+{
+  delete g_result_cache;
+  g_result_cache = nullptr;
+}
+
+std::unique_ptr<MemoryBuffer> OperationResultCache::take(const OperationResultKey &key)
+{
+  Entry *entry = entries_.lookup_ptr(key);
+  if (entry == nullptr) {
+    return nullptr;
+  }
+  std::unique_ptr<MemoryBuffer> buffer = std::move(entry->buffer);
+  size_ -= entry->size;
+  entries_.remove(key);
+  return buffer;
+}
+
+void OperationResultCache::add(const OperationResultKey &key, std::unique_ptr<MemoryBuffer> buffer)
+{
+  const int64_t size = buffer_size(*buffer);
+  const int64_t limit = result_cache_limit();
+  if (size > limit) {
+    return;
+  }
+
+  if (const Entry *entry = entries_.lookup_ptr(key)) {
+    size_ -= entry->size;
+    entries_.remove(key);
+  }
+  while (size_ + size > limit) {
+    if (!remove_least_recently_used()) {
+      return;
+    }
+  }
+
+  size_ += size;
+  entries_.add_new(key, {std::move(buffer), size, ++use_clock_});
+}
+
+bool OperationResultCache::remove_least_recently_used()
+{
+  const OperationResultKey *oldest_key = nullptr;
+  uint64_t oldest_use = UINT64_MAX;
+  for (const auto item : entries_.items()) {
+    if (item.value.last_use < oldest_use) {
+      oldest_use = item.value.last_use;
+      oldest_key = &item.key;
+    }
+  }
+  if (oldest_key == nullptr) {
+    return false;
+  }
+  const OperationResultKey key = *oldest_key;
+  size_ -= entries_.lookup(key).size;
+  entries_.remove(key);
+  return true;
+}
+
+}  // namespace blender::compositor
@@ -0,0 +1,70 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2022 Blender Foundation. */
+
+#pragma once
+
+#include <memory>
+
+#include "BLI_map.hh"
+
+#include "COM_NodeOperation.h"
+
+#ifdef WITH_CXX_GUARDEDALLOC
+#  include "MEM_guardedalloc.h"
+#endif
+
+namespace blender::compositor {
+
+class MemoryBuffer;
+
+/**
+ * Keeps the results of operations across executions, so that operations whose
+ * #OperationResultKey didn't change aren't rendered again, nor are their inputs. I.e. when
+ * editing nodes further down the tree or going back to a previous frame.
+ *
+ * Memory is limited by the "Compositor Cache Limit" preference, removing the least recently used
+ * results first. Only used by #FullFrameExecutionModel when not rendering, executions are
+ * serialized by the compositor mutex.
+ */
+class OperationResultCache {
+ private:
+  struct Entry {
+    std::unique_ptr<MemoryBuffer> buffer;
+    int64_t size;
+    uint64_t last_use;
+  };
+
+  Map<OperationResultKey, Entry> entries_;
+  int64_t size_ = 0;
+  uint64_t use_clock_ = 0;
+
+ public:
+  /**
+   * Whether operation results may be cached in the current execution.
+   */
+  static bool is_enabled();
+  static OperationResultCache &get();
+  /**
+   * Free the cache and all its results.
+   */
+  static void free();
+
+  /**
+   * Remove the result with given key from the cache and return it, nullptr if there is none.
+   * Results are added back with #add once they are not used anymore.
+   */
+  std::unique_ptr<MemoryBuffer> take(const OperationResultKey &key);
+  /**
+   * Keep given result, removing least recently used ones to stay within the memory limit.
+   */
+  void add(const OperationResultKey &key, std::unique_ptr<MemoryBuffer> buffer);
+
+ private:
+  bool remove_least_recently_used();
+
+#ifdef WITH_CXX_GUARDEDALLOC
+  MEM_CXX_CLASS_ALLOC_FUNCS("COM:OperationResultCache")
+#endif
+};
+
+}  // namespace blender::compositor
@@ -79,15 +79,16 @@ MemoryBuffer *SharedOperationBuffers::get_rendered_buffer(NodeOperation *op)
   return get_buffer_data(op).buffer.get();
 }
 
-void SharedOperationBuffers::read_finished(NodeOperation *read_op)
+std::unique_ptr<MemoryBuffer> SharedOperationBuffers::read_finished(NodeOperation *read_op)
 {
   BufferData &buf_data = get_buffer_data(read_op);
   buf_data.received_reads++;
   BLI_assert(buf_data.received_reads > 0 && buf_data.received_reads <= buf_data.registered_reads);
   if (buf_data.received_reads == buf_data.registered_reads) {
     /* Dispose buffer. */
-    buf_data.buffer = nullptr;
+    return std::move(buf_data.buffer);
   }
+  return nullptr;
 }
 
 }  // namespace blender::compositor
@@ -74,8 +74,9 @@ class SharedOperationBuffers {
   /**
    * Reports an operation has finished reading given operation. If all given operation dependencies
    * have finished its buffer will be disposed.
+   * \return The disposed buffer, for the caller to keep it or let it be freed.
    */
-  void read_finished(NodeOperation *read_op);
+  std::unique_ptr<MemoryBuffer> read_finished(NodeOperation *read_op);
 
  private:
   BufferData &get_buffer_data(NodeOperation *op);
@@ -8,10 +8,17 @@
 #include "BKE_node.h"
 #include "BKE_scene.h"
 
+#include "DNA_userdef_types.h"
+
+#include "COM_DenoiseOperation.h"
 #include "COM_ExecutionSystem.h"
+#include "COM_OperationResultCache.h"
 #include "COM_WorkScheduler.h"
 #include "COM_compositor.h"
 
+/** Resolution factor of the quick first execution, see #UserDef_Experimental. */
+static constexpr float PROGRESSIVE_PREVIEW_RESOLUTION_FACTOR = 0.25f;
+
 static struct {
   bool is_initialized = false;
   ThreadMutex mutex;
@@ -68,6 +75,11 @@ void COM_execute(RenderData *render_data,
     return;
   }
 
+  /* Render results are replaced by every render, and a disabled cache shouldn't keep memory. */
+  if (rendering || !blender::compositor::OperationResultCache::is_enabled()) {
+    blender::compositor::OperationResultCache::free();
+  }
+
   compositor_init_node_previews(render_data, node_tree);
   compositor_reset_node_tree_status(node_tree);
 
@@ -88,6 +100,25 @@ void COM_execute(RenderData *render_data,
     }
   }
 
+  const bool progressive = !rendering && U.experimental.use_compositor_progressive &&
+                           U.experimental.use_full_frame_compositor &&
+                           node_tree->execution_mode == NTREE_EXECUTION_MODE_FULL_FRAME;
+  if (progressive) {
+    blender::compositor::ExecutionSystem preview_pass(render_data,
+                                                      scene,
+                                                      node_tree,
+                                                      rendering,
+                                                      false,
+                                                      view_name,
+                                                      PROGRESSIVE_PREVIEW_RESOLUTION_FACTOR);
+    preview_pass.execute();
+
+    if (node_tree->test_break(node_tree->tbh)) {
+      BLI_mutex_unlock(&g_compositor.mutex);
+      return;
+    }
+  }
+
   blender::compositor::ExecutionSystem system(
       render_data, scene, node_tree, rendering, false, view_name);
   system.execute();
@@ -97,8 +128,10 @@ void COM_execute(RenderData *render_data,
 
 void COM_deinitialize()
 {
+  blender::compositor::COM_denoise_free_device();
   if (g_compositor.is_initialized) {
     BLI_mutex_lock(&g_compositor.mutex);
+    blender::compositor::OperationResultCache::free();
     blender::compositor::WorkScheduler::deinitialize();
     g_compositor.is_initialized = false;
     BLI_mutex_unlock(&g_compositor.mutex);
@@ -23,7 +23,12 @@ void BlurNode::convert_to_operations(NodeConverter &converter,
                                      const CompositorContext &context) const
 {
   bNode *editor_node = this->get_bnode();
-  NodeBlurData *data = (NodeBlurData *)editor_node->storage;
+  NodeBlurData scaled_data = *(const NodeBlurData *)editor_node->storage;
+  NodeBlurData *data = &scaled_data;
+  if (!data->relative) {
+    data->sizex = round_fl_to_int(data->sizex * context.get_resolution_factor());
+    data->sizey = round_fl_to_int(data->sizey * context.get_resolution_factor());
+  }
   NodeInput *input_size_socket = this->get_input_socket(1);
   bool connected_size_socket = input_size_socket->is_linked();
 
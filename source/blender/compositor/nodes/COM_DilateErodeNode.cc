@@ -24,15 +24,22 @@ DilateErodeNode::DilateErodeNode(bNode *editor_node) : Node(editor_node)
   }
 }
 
+static int scaled_iterations(const int iterations, const float resolution_factor)
+{
+  return iterations > 0 ? max_ii(1, round_fl_to_int(iterations * resolution_factor)) : 0;
+}
+
 void DilateErodeNode::convert_to_operations(NodeConverter &converter,
                                             const CompositorContext &context) const
 {
 
   bNode *editor_node = this->get_bnode();
+  /* Distances are in pixels of the composited resolution. */
+  const float resolution_factor = context.get_resolution_factor();
   if (editor_node->custom1 == CMP_NODE_DILATEERODE_DISTANCE_THRESH) {
     DilateErodeThresholdOperation *operation = new DilateErodeThresholdOperation();
-    operation->set_distance(editor_node->custom2);
-    operation->set_inset(editor_node->custom3);
+    operation->set_distance(editor_node->custom2 * resolution_factor);
+    operation->set_inset(editor_node->custom3 * resolution_factor);
     converter.add_operation(operation);
 
     converter.map_input_socket(get_input_socket(0), operation->get_input_socket(0));
@@ -51,7 +58,7 @@ void DilateErodeNode::convert_to_operations(NodeConverter &converter,
   else if (editor_node->custom1 == CMP_NODE_DILATEERODE_DISTANCE) {
     if (editor_node->custom2 > 0) {
       DilateDistanceOperation *operation = new DilateDistanceOperation();
-      operation->set_distance(editor_node->custom2);
+      operation->set_distance(editor_node->custom2 * resolution_factor);
       converter.add_operation(operation);
 
       converter.map_input_socket(get_input_socket(0), operation->get_input_socket(0));
@@ -59,7 +66,7 @@ void DilateErodeNode::convert_to_operations(NodeConverter &converter,
     }
     else {
       ErodeDistanceOperation *operation = new ErodeDistanceOperation();
-      operation->set_distance(-editor_node->custom2);
+      operation->set_distance(-editor_node->custom2 * resolution_factor);
       converter.add_operation(operation);
 
       converter.map_input_socket(get_input_socket(0), operation->get_input_socket(0));
@@ -101,8 +108,8 @@ void DilateErodeNode::convert_to_operations(NodeConverter &converter,
       operationy->set_size(size);
     }
 #else
-    operationx->set_size(1.0f);
-    operationy->set_size(1.0f);
+    operationx->set_size(resolution_factor);
+    operationy->set_size(resolution_factor);
 #endif
     operationx->set_subtract(editor_node->custom2 < 0);
     operationy->set_subtract(editor_node->custom2 < 0);
@@ -116,7 +123,7 @@ void DilateErodeNode::convert_to_operations(NodeConverter &converter,
   else {
     if (editor_node->custom2 > 0) {
       DilateStepOperation *operation = new DilateStepOperation();
-      operation->set_iterations(editor_node->custom2);
+      operation->set_iterations(scaled_iterations(editor_node->custom2, resolution_factor));
       converter.add_operation(operation);
 
       converter.map_input_socket(get_input_socket(0), operation->get_input_socket(0));
@@ -124,7 +131,7 @@ void DilateErodeNode::convert_to_operations(NodeConverter &converter,
     }
     else {
       ErodeStepOperation *operation = new ErodeStepOperation();
-      operation->set_iterations(-editor_node->custom2);
+      operation->set_iterations(scaled_iterations(-editor_node->custom2, resolution_factor));
       converter.add_operation(operation);
 
       converter.map_input_socket(get_input_socket(0), operation->get_input_socket(0));
@@ -31,6 +31,7 @@ ColorBalanceLGGOperation::ColorBalanceLGGOperation()
   input_color_operation_ = nullptr;
   this->set_canvas_input_index(1);
   flags_.can_be_constant = true;
+  flags_.is_pixel_local = true;
 }
 
 void ColorBalanceLGGOperation::init_execution()
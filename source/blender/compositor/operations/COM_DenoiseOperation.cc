@@ -7,6 +7,9 @@
 #  include "BLI_threads.h"
 #  include <OpenImageDenoise/oidn.hpp>
 static pthread_mutex_t oidn_lock = BLI_MUTEX_INITIALIZER;
+/* Created on first use and reused by following executions, creating a device is expensive
+ * compared to denoising small images or animation frames. Only accessed with #oidn_lock held. */
+static oidn::DeviceRef oidn_device;
 #endif
 
 namespace blender::compositor {
@@ -26,10 +29,18 @@ bool COM_is_denoise_supported()
 #endif
 }
 
+void COM_denoise_free_device()
+{
+#ifdef WITH_OPENIMAGEDENOISE
+  BLI_mutex_lock(&oidn_lock);
+  oidn_device = nullptr;
+  BLI_mutex_unlock(&oidn_lock);
+#endif
+}
+
 class DenoiseFilter {
  private:
 #ifdef WITH_OPENIMAGEDENOISE
-  oidn::DeviceRef device_;
   oidn::FilterRef filter_;
 #endif
   bool initialized_ = false;
@@ -48,16 +59,20 @@ class DenoiseFilter {
      * nonetheless. */
     BLI_mutex_lock(&oidn_lock);
 
-    device_ = oidn::newDevice();
-    device_.set("setAffinity", false);
-    device_.commit();
-    filter_ = device_.newFilter("RT");
+    if (!oidn_device) {
+      oidn_device = oidn::newDevice();
+      oidn_device.set("setAffinity", false);
+      oidn_device.commit();
+    }
+    filter_ = oidn_device.newFilter("RT");
     initialized_ = true;
     set_image("output", output);
   }
 
   void deinit_and_unlock_denoiser()
   {
+    /* Release the filter while the shared device is still locked. */
+    filter_ = nullptr;
     BLI_mutex_unlock(&oidn_lock);
     initialized_ = false;
   }
@@ -9,6 +9,10 @@
 namespace blender::compositor {
 
 bool COM_is_denoise_supported();
+/**
+ * Free the OpenImageDenoise device kept between denoise executions.
+ */
+void COM_denoise_free_device();
 
 class DenoiseBaseOperation : public SingleThreadedOperation {
  protected:
@@ -0,0 +1,108 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2022 Blender Foundation. */
+
+#include "COM_FusedOperation.h"
+
+#include "BLI_array.hh"
+
+namespace blender::compositor {
+
+/** Number of pixels rendered at once by every grouped operation. */
+static constexpr int FUSED_CHUNK_PIXELS = 4096;
+
+FusedOperation::FusedOperation(Span<NodeOperation *> operations)
+{
+  BLI_assert(operations.size() > 1);
+  for (NodeOperation *op : operations) {
+    BLI_assert(op->get_flags().is_pixel_local);
+    operations_.append(static_cast<MultiThreadedOperation *>(op));
+  }
+
+  for (MultiThreadedOperation *op : operations_) {
+    Vector<InputSource> sources;
+    for (int i = 0; i < op->get_number_of_input_sockets(); i++) {
+      NodeOperationInput *socket = op->get_input_socket(i);
+      BLI_assert(socket->is_connected());
+      const int operation_index = operations_.first_index_of_try(
+          static_cast<MultiThreadedOperation *>(&socket->get_link()->get_operation()));
+      if (operation_index != -1) {
+        sources.append({operation_index, -1});
+      }
+      else {
+        sources.append({-1, int(external_inputs_.size())});
+        external_inputs_.append(socket);
+        add_input_socket(socket->get_data_type(), ResizeMode::None);
+      }
+    }
+    input_sources_.append(std::move(sources));
+  }
+
+  MultiThreadedOperation *last_op = operations_.last();
+  add_output_socket(last_op->get_output_socket()->get_data_type());
+  set_canvas(last_op->get_canvas());
+  set_name(last_op->get_name());
+  set_result_key(last_op->get_result_key());
+}
+
+FusedOperation::~FusedOperation()
+{
+  for (MultiThreadedOperation *op : operations_) {
+    delete op;
+  }
+}
+
+void FusedOperation::init_execution()
+{
+  for (MultiThreadedOperation *op : operations_) {
+    op->init_execution();
+  }
+}
+
+void FusedOperation::deinit_execution()
+{
+  for (MultiThreadedOperation *op : operations_) {
+    op->deinit_execution();
+  }
+}
+
+void FusedOperation::update_memory_buffer_partial(MemoryBuffer *output,
+                                                  const rcti &area,
+                                                  Span<MemoryBuffer *> inputs)
+{
+  const int width = BLI_rcti_size_x(&area);
+  const int chunk_height = std::max(1, FUSED_CHUNK_PIXELS / std::max(width, 1));
+
+  /* Temporary results of all operations but the last one, which writes to the output. */
+  const int num_temp_ops = operations_.size() - 1;
+  Array<Array<float>> temp_data(num_temp_ops);
+  for (const int i : IndexRange(num_temp_ops)) {
+    const DataType data_type = operations_[i]->get_output_socket()->get_data_type();
+    temp_data[i].reinitialize(width * chunk_height * COM_data_type_num_channels(data_type));
+  }
+
+  Vector<std::unique_ptr<MemoryBuffer>> temp_bufs;
+  Vector<MemoryBuffer *> op_inputs;
+  for (int ymin = area.ymin; ymin < area.ymax; ymin += chunk_height) {
+    rcti chunk;
+    BLI_rcti_init(&chunk, area.xmin, area.xmax, ymin, std::min(ymin + chunk_height, area.ymax));
+
+    temp_bufs.clear();
+    for (const int i : IndexRange(num_temp_ops)) {
+      const DataType data_type = operations_[i]->get_output_socket()->get_data_type();
+      temp_bufs.append(std::make_unique<MemoryBuffer>(
+          temp_data[i].data(), COM_data_type_num_channels(data_type), chunk));
+    }
+
+    for (const int i : operations_.index_range()) {
+      op_inputs.clear();
+      for (const InputSource &source : input_sources_[i]) {
+        op_inputs.append(source.operation_index == -1 ? inputs[source.input_index] :
+                                                        temp_bufs[source.operation_index].get());
+      }
+      MemoryBuffer *op_output = i < num_temp_ops ? temp_bufs[i].get() : output;
+      operations_[i]->update_memory_buffer_partial(op_output, chunk, op_inputs);
+    }
+  }
+}
+
+}  // namespace blender::compositor
@@ -0,0 +1,61 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2022 Blender Foundation. */
+
+#pragma once
+
+#include "COM_MultiThreadedOperation.h"
+
+namespace blender::compositor {
+
+/**
+ * Renders a group of pixel-local operations (see #NodeOperationFlags.is_pixel_local) in a single
+ * pass. The operations are rendered chunk by chunk of rows into small temporary buffers instead
+ * of full-frame buffers, so intermediate results stay in cache.
+ *
+ * Takes ownership of the grouped operations. The last operation gives the output.
+ */
+class FusedOperation : public MultiThreadedOperation {
+ private:
+  /** Where an input of a grouped operation is read from. */
+  struct InputSource {
+    /** Index in #operations_ or -1 when the input is an input of this operation. */
+    int operation_index;
+    /** Index of the input of this operation when #operation_index is -1. */
+    int input_index;
+  };
+
+  /** Grouped operations in dependency order. */
+  Vector<MultiThreadedOperation *> operations_;
+  /** Sources of the inputs of each grouped operation. */
+  Vector<Vector<InputSource>> input_sources_;
+  /** Grouped operation input sockets each input of this operation corresponds to. */
+  Vector<NodeOperationInput *> external_inputs_;
+
+ public:
+  /**
+   * \param operations: Pixel-local operations sorted so that inputs come before their readers,
+   * all with the same canvas. Every operation but the last must only be read by operations of
+   * the group.
+   */
+  FusedOperation(Span<NodeOperation *> operations);
+  ~FusedOperation() override;
+
+  /**
+   * Input socket of a grouped operation that the input socket of this operation at given
+   * index replaces.
+   */
+  NodeOperationInput *get_external_input(int index) const
+  {
+    return external_inputs_[index];
+  }
+
+  void init_execution() override;
+  void deinit_execution() override;
+
+ protected:
+  void update_memory_buffer_partial(MemoryBuffer *output,
+                                    const rcti &area,
+                                    Span<MemoryBuffer *> inputs) override;
+};
+
+}  // namespace blender::compositor
@@ -87,51 +87,62 @@ void GaussianBlurBaseOperation::update_memory_buffer_partial(MemoryBuffer *outpu
   int min_input_coord = -1;
   int max_input_coord = -1;
   int elem_stride = -1;
-  std::function<int()> get_current_coord;
   switch (dimension_) {
     case eDimension::X:
       min_input_coord = input_rect.xmin;
       max_input_coord = input_rect.xmax;
       elem_stride = input->elem_stride;
-      get_current_coord = [&] { return it.x; };
       break;
     case eDimension::Y:
       min_input_coord = input_rect.ymin;
       max_input_coord = input_rect.ymax;
       elem_stride = input->row_stride;
-      get_current_coord = [&] { return it.y; };
       break;
   }
 
+  const int step = QualityStepHelper::get_step();
+  const int in_stride = elem_stride * step;
+
+  /* Sum of the weights when the whole kernel is inside the input, which is the case for most
+   * pixels. Only pixels near the input borders need to sum their clipped weights. */
+  const int gauss_size = filtersize_ * 2 + 1;
+  float full_multiplier_accum = 0.0f;
+  for (int gauss_idx = 0; gauss_idx < gauss_size; gauss_idx += step) {
+    full_multiplier_accum += gausstab_[gauss_idx];
+  }
+
   for (; !it.is_end(); ++it) {
-    const int coord = get_current_coord();
+    const int coord = dimension_ == eDimension::X ? it.x : it.y;
     const int coord_min = max_ii(coord - filtersize_, min_input_coord);
     const int coord_max = min_ii(coord + filtersize_ + 1, max_input_coord);
 
     float ATTR_ALIGN(16) color_accum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
-    float multiplier_accum = 0.0f;
 
-    const int step = QualityStepHelper::get_step();
     const float *in = it.in(0) + ((intptr_t)coord_min - coord) * elem_stride;
-    const int in_stride = elem_stride * step;
-    int gauss_idx = (coord_min - coord) + filtersize_;
-    const int gauss_end = gauss_idx + (coord_max - coord_min);
+    const int gauss_start = (coord_min - coord) + filtersize_;
+    const int gauss_end = gauss_start + (coord_max - coord_min);
+    int gauss_idx = gauss_start;
 #ifdef BLI_HAVE_SSE2
     __m128 accum_r = _mm_load_ps(color_accum);
     for (; gauss_idx < gauss_end; in += in_stride, gauss_idx += step) {
       __m128 reg_a = _mm_load_ps(in);
       reg_a = _mm_mul_ps(reg_a, gausstab_sse_[gauss_idx]);
       accum_r = _mm_add_ps(accum_r, reg_a);
-      multiplier_accum += gausstab_[gauss_idx];
     }
     _mm_store_ps(color_accum, accum_r);
 #else
     for (; gauss_idx < gauss_end; in += in_stride, gauss_idx += step) {
-      const float multiplier = gausstab_[gauss_idx];
-      madd_v4_v4fl(color_accum, in, multiplier);
-      multiplier_accum += multiplier;
+      madd_v4_v4fl(color_accum, in, gausstab_[gauss_idx]);
     }
 #endif
+
+    float multiplier_accum = full_multiplier_accum;
+    if (gauss_start != 0 || gauss_end != gauss_size) {
+      multiplier_accum = 0.0f;
+      for (gauss_idx = gauss_start; gauss_idx < gauss_end; gauss_idx += step) {
+        multiplier_accum += gausstab_[gauss_idx];
+      }
+    }
     mul_v4_v4fl(it.out, color_accum, 1.0f / multiplier_accum);
   }
 }
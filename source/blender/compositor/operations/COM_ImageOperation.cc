@@ -3,11 +3,16 @@
 
 #include "COM_ImageOperation.h"
 
+#include "BLI_path_util.h"
+
 #include "BKE_scene.h"
 
+#include "DNA_userdef_types.h"
+
 #include "IMB_colormanagement.h"
 #include "IMB_imbuf.h"
 #include "IMB_imbuf_types.h"
+#include "IMB_openexr.h"
 
 namespace blender::compositor {
 
@@ -26,14 +31,17 @@ BaseImageOperation::BaseImageOperation()
   number_of_channels_ = 0;
   rd_ = nullptr;
   view_name_ = nullptr;
+  supports_partial_read_ = false;
 }
 ImageOperation::ImageOperation() : BaseImageOperation()
 {
   this->add_output_socket(DataType::Color);
+  supports_partial_read_ = true;
 }
 ImageAlphaOperation::ImageAlphaOperation() : BaseImageOperation()
 {
   this->add_output_socket(DataType::Value);
+  supports_partial_read_ = true;
 }
 ImageDepthOperation::ImageDepthOperation() : BaseImageOperation()
 {
@@ -64,6 +72,9 @@ ImBuf *BaseImageOperation::get_im_buf()
 
 void BaseImageOperation::init_execution()
 {
+  if (!partial_read_filepath_.empty()) {
+    return;
+  }
   ImBuf *stackbuf = get_im_buf();
   buffer_ = stackbuf;
   if (stackbuf) {
@@ -81,6 +92,7 @@ void BaseImageOperation::init_execution()
 
 void BaseImageOperation::deinit_execution()
 {
+  partial_read_rows_.reset();
   image_float_buffer_ = nullptr;
   image_byte_buffer_ = nullptr;
   BKE_image_release_ibuf(image_, buffer_, nullptr);
@@ -90,8 +102,71 @@ void BaseImageOperation::deinit_execution()
   }
 }
 
+bool BaseImageOperation::init_partial_read(rcti &r_area)
+{
+  partial_read_filepath_.clear();
+  if (!U.experimental.use_compositor_partial_exr || !supports_partial_read_ ||
+      execution_model_ != eExecutionModel::FullFrame || image_ == nullptr) {
+    return false;
+  }
+  if (!ELEM(image_->source, IMA_SRC_FILE, IMA_SRC_SEQUENCE) || image_->type != IMA_TYPE_IMAGE ||
+      BKE_image_is_multilayer(image_) || BKE_image_is_multiview(image_) ||
+      BKE_image_has_packedfile(image_) || BKE_image_is_dirty(image_)) {
+    return false;
+  }
+  /* The image buffer would be converted to scene linear or premultiplied when loaded. */
+  const char *colorspace = image_->colorspace_settings.name;
+  const bool is_data = IMB_colormanagement_space_name_is_data(colorspace);
+  if (!is_data && !IMB_colormanagement_space_name_is_scene_linear(colorspace)) {
+    return false;
+  }
+  if (!is_data && !ELEM(image_->alpha_mode, IMA_ALPHA_PREMUL, IMA_ALPHA_CHANNEL_PACKED)) {
+    return false;
+  }
+
+  ImageUser iuser = *image_user_;
+  char filepath[FILE_MAX];
+  BKE_image_user_file_path(&iuser, image_, filepath);
+  int width, height;
+  if (!IMB_exr_rgba_rows_read(filepath, &width, &height, 0, 0, nullptr)) {
+    return false;
+  }
+  partial_read_filepath_ = filepath;
+  imagewidth_ = width;
+  imageheight_ = height;
+  BLI_rcti_init(&r_area, 0, width, 0, height);
+  return true;
+}
+
+void BaseImageOperation::update_memory_buffer_started(MemoryBuffer *UNUSED(output),
+                                                      const rcti &area,
+                                                      Span<MemoryBuffer *> UNUSED(inputs))
+{
+  if (partial_read_filepath_.empty()) {
+    return;
+  }
+  /* Whole rows are read, the file is stored in scan-lines or rows of tiles. */
+  rcti rows_rect;
+  BLI_rcti_init(&rows_rect, 0, imagewidth_, area.ymin, area.ymax);
+  partial_read_rows_ = std::make_unique<MemoryBuffer>(DataType::Color, rows_rect);
+  int width, height;
+  if (!IMB_exr_rgba_rows_read(partial_read_filepath_.c_str(),
+                              &width,
+                              &height,
+                              area.ymin,
+                              area.ymax,
+                              partial_read_rows_->get_buffer()) ||
+      width != imagewidth_ || height != imageheight_) {
+    /* The file changed since the canvas was determined. */
+    partial_read_rows_->clear();
+  }
+}
+
 void BaseImageOperation::determine_canvas(const rcti &UNUSED(preferred_area), rcti &r_area)
 {
+  if (init_partial_read(r_area)) {
+    return;
+  }
   ImBuf *stackbuf = get_im_buf();
 
   r_area = COM_AREA_NONE;
@@ -157,6 +232,10 @@ void ImageOperation::update_memory_buffer_partial(MemoryBuffer *output,
                                                   const rcti &area,
                                                   Span<MemoryBuffer *> UNUSED(inputs))
 {
+  if (partial_read_rows_) {
+    output->copy_from(partial_read_rows_.get(), area);
+    return;
+  }
   output->copy_from(buffer_, area, true);
 }
 
@@ -181,6 +260,10 @@ void ImageAlphaOperation::update_memory_buffer_partial(MemoryBuffer *output,
                                                        const rcti &area,
                                                        Span<MemoryBuffer *> UNUSED(inputs))
 {
+  if (partial_read_rows_) {
+    output->copy_from(partial_read_rows_.get(), area, 3, COM_DATA_TYPE_VALUE_CHANNELS, 0);
+    return;
+  }
   output->copy_from(buffer_, area, 3, COM_DATA_TYPE_VALUE_CHANNELS, 0);
 }
 
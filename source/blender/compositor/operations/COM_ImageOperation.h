@@ -35,6 +35,16 @@ class BaseImageOperation : public MultiThreadedOperation {
   const RenderData *rd_;
   const char *view_name_;
 
+  /** Set by operations outputting the color or alpha of the image. */
+  bool supports_partial_read_;
+  /**
+   * OpenEXR file read one area at a time instead of acquiring the image buffer, see
+   * #init_partial_read. Empty when the image buffer is used.
+   */
+  std::string partial_read_filepath_;
+  /** Rows of the file needed by the area being rendered. */
+  std::unique_ptr<MemoryBuffer> partial_read_rows_;
+
   BaseImageOperation();
   /**
    * Determine the output resolution. The resolution is retrieved from the Renderer
@@ -43,9 +53,18 @@ class BaseImageOperation : public MultiThreadedOperation {
 
   virtual ImBuf *get_im_buf();
 
+  /**
+   * Whether the image can be read from its OpenEXR file one area at a time, without loading the
+   * image buffer. Only for Full Frame, and for images whose pixels don't change when loaded.
+   */
+  bool init_partial_read(rcti &r_area);
+
  public:
   void init_execution() override;
   void deinit_execution() override;
+  void update_memory_buffer_started(MemoryBuffer *output,
+                                    const rcti &area,
+                                    Span<MemoryBuffer *> inputs) override;
   void set_image(Image *image)
   {
     image_ = image;
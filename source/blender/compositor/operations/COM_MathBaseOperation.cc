@@ -18,6 +18,7 @@ MathBaseOperation::MathBaseOperation()
   input_value3_operation_ = nullptr;
   use_clamp_ = false;
   flags_.can_be_constant = true;
+  flags_.is_pixel_local = true;
 }
 
 void MathBaseOperation::init_execution()
@@ -3,6 +3,8 @@
 
 #include "COM_MixOperation.h"
 
+#include "GPU_shader.h"
+
 namespace blender::compositor {
 
 /* ******** Mix Base Operation ******** */
@@ -19,6 +21,7 @@ MixBaseOperation::MixBaseOperation()
   this->set_use_value_alpha_multiply(false);
   this->set_use_clamp(false);
   flags_.can_be_constant = true;
+  flags_.is_pixel_local = true;
 }
 
 void MixBaseOperation::init_execution()
@@ -105,6 +108,18 @@ void MixBaseOperation::update_memory_buffer_partial(MemoryBuffer *output,
   }
 }
 
+const char *MixBaseOperation::get_gpu_shader_name() const
+{
+  return get_gpu_blend_type() == -1 ? nullptr : "gpu_shader_compositor_mix";
+}
+
+void MixBaseOperation::set_gpu_shader_uniforms(GPUShader *shader) const
+{
+  GPU_shader_uniform_1i(shader, "blend_type", get_gpu_blend_type());
+  GPU_shader_uniform_1b(shader, "use_alpha", value_alpha_multiply_);
+  GPU_shader_uniform_1b(shader, "use_clamp", use_clamp_);
+}
+
 void MixBaseOperation::update_memory_buffer_row(PixelCursor &p)
 {
   while (p.out < p.row_end) {
@@ -91,8 +91,20 @@ class MixBaseOperation : public MultiThreadedOperation {
                                     const rcti &area,
                                     Span<MemoryBuffer *> inputs) final;
 
+  const char *get_gpu_shader_name() const override;
+  void set_gpu_shader_uniforms(GPUShader *shader) const override;
+
  protected:
   virtual void update_memory_buffer_row(PixelCursor &p);
+
+  /**
+   * Blend type of `gpu_shader_compositor_mix` computing the same result as this operation,
+   * or -1 when the shader doesn't support it.
+   */
+  virtual int get_gpu_blend_type() const
+  {
+    return -1;
+  }
 };
 
 class MixAddOperation : public MixBaseOperation {
@@ -101,6 +113,10 @@ class MixAddOperation : public MixBaseOperation {
 
  protected:
   void update_memory_buffer_row(PixelCursor &p) override;
+  int get_gpu_blend_type() const override
+  {
+    return 1;
+  }
 };
 
 class MixBlendOperation : public MixBaseOperation {
@@ -109,6 +125,10 @@ class MixBlendOperation : public MixBaseOperation {
 
  protected:
   void update_memory_buffer_row(PixelCursor &p) override;
+  int get_gpu_blend_type() const override
+  {
+    return 0;
+  }
 };
 
 class MixColorBurnOperation : public MixBaseOperation {
@@ -197,6 +217,10 @@ class MixMultiplyOperation : public MixBaseOperation {
 
  protected:
   void update_memory_buffer_row(PixelCursor &p) override;
+  int get_gpu_blend_type() const override
+  {
+    return 3;
+  }
 };
 
 class MixOverlayOperation : public MixBaseOperation {
@@ -237,6 +261,10 @@ class MixSubtractOperation : public MixBaseOperation {
 
  protected:
   void update_memory_buffer_row(PixelCursor &p) override;
+  int get_gpu_blend_type() const override
+  {
+    return 2;
+  }
 };
 
 class MixValueOperation : public MixBaseOperation {
@@ -169,6 +169,31 @@ void RenderLayersProg::deinit_execution()
   }
 }
 
+std::optional<size_t> RenderLayersProg::hash_external_data() const
+{
+  size_t hash = get_default_hash_3(
+      pass_name_, layer_id_, StringRef(view_name_ ? view_name_ : ""));
+
+  Render *re = (scene_) ? RE_GetSceneRender(scene_) : nullptr;
+  if (re == nullptr) {
+    return hash;
+  }
+  /* The pass pointer alone could be reused by a later render result, see
+   * #RenderResult.generation. */
+  RenderResult *rr = RE_AcquireResultRead(re);
+  if (rr) {
+    const float *pass_buffer = nullptr;
+    ViewLayer *view_layer = (ViewLayer *)BLI_findlink(&scene_->view_layers, layer_id_);
+    RenderLayer *rl = view_layer ? RE_GetRenderLayer(rr, view_layer->name) : nullptr;
+    if (rl) {
+      pass_buffer = RE_RenderLayerGetPass(rl, pass_name_.c_str(), view_name_);
+    }
+    combine_hashes(hash, get_default_hash_2(rr->generation, pass_buffer));
+  }
+  RE_ReleaseResult(re);
+  return hash;
+}
+
 void RenderLayersProg::determine_canvas(const rcti &UNUSED(preferred_area), rcti &r_area)
 {
   Scene *sce = this->get_scene();
@@ -114,6 +114,8 @@ class RenderLayersProg : public MultiThreadedOperation {
 
   std::unique_ptr<MetaData> get_meta_data() override;
 
+  std::optional<size_t> hash_external_data() const override;
+
   virtual void update_memory_buffer_partial(MemoryBuffer *output,
                                             const rcti &area,
                                             Span<MemoryBuffer *> inputs) override;
@@ -187,6 +187,26 @@ void DEG_evaluate_on_framechange(Depsgraph *graph, float frame);
  */
 void DEG_evaluate_on_refresh(Depsgraph *graph);
 
+/**
+ * Check whether the evaluated state of the graph at a frame only depends on the original data
+ * and the frame itself, so that different frames can be evaluated in any order and concurrently
+ * by separate graphs.
+ *
+ * This is not the case when the graph contains simulations which step from the state of the
+ * previous frame, like point caches, rigid body worlds or collision modifiers.
+ */
+bool DEG_frames_are_independent(const Depsgraph *graph);
+
+/**
+ * Evaluate each of the graphs at the corresponding frame, concurrently.
+ *
+ * The graphs are to be built for the same scene and view layer, be inactive and independent
+ * from each other, see #DEG_frames_are_independent. Unlike
+ * #BKE_scene_graph_update_for_newframe, frame change handlers are not executed and the
+ * original scene is not modified.
+ */
+void DEG_evaluate_on_framechange_multi(Depsgraph **graphs, const float *frames, int graphs_num);
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
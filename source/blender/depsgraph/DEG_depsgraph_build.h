@@ -67,6 +67,13 @@ void DEG_graph_relations_update(struct Depsgraph *graph);
 /** Tag all relations in the database for update. */
 void DEG_relations_tag_update(struct Main *bmain);
 
+/**
+ * Tag relations of the given ID for update, for changes which only affect the ID itself and its
+ * direct dependencies (like adding or removing a modifier of an object). Allows dependency graphs
+ * to only rebuild the part of the graph around the ID, falling back to a full rebuild otherwise.
+ */
+void DEG_id_relations_tag_update(struct Main *bmain, struct ID *id);
+
 /* Add Dependencies  ----------------------------- */
 
 /**
@@ -52,6 +52,24 @@ void DEG_debug_stats_gnuplot(const struct Depsgraph *graph,
                              const char *label,
                              const char *output_filename);
 
+/* ************************************************ */
+/* Evaluation Timeline Tracing
+ *
+ * Enabled with #G_DEBUG_DEPSGRAPH_TRACE, records the time spent in each operation (and nested
+ * spans like modifiers) per thread, into a ring buffer shared by all dependency graphs. */
+
+bool DEG_debug_trace_is_enabled(void);
+/**
+ * Begin a span on the current thread, must be followed by #DEG_debug_trace_end.
+ * \param category: Static string used to group spans.
+ */
+void DEG_debug_trace_begin(const char *category, const char *name);
+void DEG_debug_trace_end(void);
+/** Write the recorded spans in the Chrome trace event JSON format (also read by Perfetto). */
+void DEG_debug_trace_chrome(FILE *fp);
+/** Free the recorded spans. */
+void DEG_debug_trace_clear(void);
+
 /* ************************************************ */
 
 /** Compare two dependency graphs. */
@@ -103,6 +103,7 @@
 #include "intern/builder/deg_builder.h"
 #include "intern/builder/deg_builder_rna.h"
 #include "intern/depsgraph.h"
+#include "intern/depsgraph_relation.h"
 #include "intern/depsgraph_tag.h"
 #include "intern/depsgraph_type.h"
 #include "intern/eval/deg_eval_copy_on_write.h"
@@ -126,7 +127,8 @@ DepsgraphNodeBuilder::DepsgraphNodeBuilder(Main *bmain,
       view_layer_(nullptr),
       view_layer_index_(-1),
       collection_(nullptr),
-      is_parent_collection_visible_(true)
+      is_parent_collection_visible_(true),
+      kept_id_nodes_num_(0)
 {
 }
 
@@ -354,16 +356,7 @@ void DepsgraphNodeBuilder::begin_build()
   }
 
   for (OperationNode *op_node : graph_->entry_tags) {
-    ComponentNode *comp_node = op_node->owner;
-    IDNode *id_node = comp_node->owner;
-
-    SavedEntryTag entry_tag;
-    entry_tag.id_orig = id_node->id_orig;
-    entry_tag.component_type = comp_node->type;
-    entry_tag.opcode = op_node->opcode;
-    entry_tag.name = op_node->name;
-    entry_tag.name_tag = op_node->name_tag;
-    saved_entry_tags_.append(entry_tag);
+    save_entry_tag(op_node);
   }
 
   /* Make sure graph has no nodes left from previous state. */
@@ -372,6 +365,109 @@ void DepsgraphNodeBuilder::begin_build()
   graph_->entry_tags.clear();
 }
 
+static void remove_node_relations(Node *node)
+{
+  while (!node->inlinks.is_empty()) {
+    Relation *rel = node->inlinks.last();
+    rel->unlink();
+    delete rel;
+  }
+  while (!node->outlinks.is_empty()) {
+    Relation *rel = node->outlinks.last();
+    rel->unlink();
+    delete rel;
+  }
+}
+
+void DepsgraphNodeBuilder::begin_build_incremental(Scene *scene,
+                                                   ViewLayer *view_layer,
+                                                   const Set<ID *> &rebuild_ids)
+{
+  Vector<IDNode *> rebuild_id_nodes;
+  for (IDNode *id_node : graph_->id_nodes) {
+    const bool is_rebuilt = rebuild_ids.contains(id_node->id_orig);
+    IDInfo *id_info = (IDInfo *)MEM_mallocN(sizeof(IDInfo), "depsgraph id info");
+    id_info->id_cow = nullptr;
+    if (is_rebuilt && deg_copy_on_write_is_needed(id_node->id_type) &&
+        deg_copy_on_write_is_expanded(id_node->id_cow) && id_node->id_orig != id_node->id_cow) {
+      id_info->id_cow = id_node->id_cow;
+      id_node->id_cow = nullptr;
+    }
+    id_info->previously_visible_components_mask = id_node->visible_components_mask;
+    id_info->previous_eval_flags = id_node->eval_flags;
+    id_info->previous_customdata_masks = id_node->customdata_masks;
+    BLI_assert(!id_info_hash_.contains(id_node->id_orig_session_uuid));
+    id_info_hash_.add_new(id_node->id_orig_session_uuid, id_info);
+
+    if (is_rebuilt) {
+      rebuild_id_nodes.append(id_node);
+      continue;
+    }
+    /* Kept nodes are not built again, their current state is only compared against the one after
+     * the build to see whether they need to be re-evaluated. */
+    id_node->previously_visible_components_mask = id_node->visible_components_mask;
+    id_node->previous_eval_flags = id_node->eval_flags;
+    id_node->previous_customdata_masks = id_node->customdata_masks;
+    built_map_.tagBuild(id_node->id_orig);
+  }
+
+  for (IDNode *id_node : rebuild_id_nodes) {
+    remove_node_relations(id_node);
+    for (ComponentNode *comp_node : id_node->components.values()) {
+      remove_node_relations(comp_node);
+      for (OperationNode *op_node : comp_node->operations) {
+        if (graph_->entry_tags.remove(op_node)) {
+          save_entry_tag(op_node);
+        }
+        remove_node_relations(op_node);
+      }
+    }
+  }
+
+  Depsgraph::OperationNodes operations;
+  operations.reserve(graph_->operations.size());
+  for (OperationNode *op_node : graph_->operations) {
+    if (!rebuild_ids.contains(op_node->owner->owner->id_orig)) {
+      operations.append(op_node);
+    }
+  }
+  graph_->operations = std::move(operations);
+
+  Depsgraph::IDDepsNodes id_nodes;
+  id_nodes.reserve(graph_->id_nodes.size());
+  for (IDNode *id_node : graph_->id_nodes) {
+    if (!rebuild_ids.contains(id_node->id_orig)) {
+      id_nodes.append(id_node);
+    }
+  }
+  graph_->id_nodes = std::move(id_nodes);
+  kept_id_nodes_num_ = graph_->id_nodes.size();
+
+  for (IDNode *id_node : rebuild_id_nodes) {
+    graph_->id_hash.remove(id_node->id_orig);
+    delete id_node;
+  }
+
+  /* Setup currently building context, matching build_view_layer(). */
+  view_layer_index_ = 0;
+  scene_ = scene;
+  view_layer_ = view_layer;
+}
+
+void DepsgraphNodeBuilder::save_entry_tag(const OperationNode *op_node)
+{
+  const ComponentNode *comp_node = op_node->owner;
+  const IDNode *id_node = comp_node->owner;
+
+  SavedEntryTag entry_tag;
+  entry_tag.id_orig = id_node->id_orig;
+  entry_tag.component_type = comp_node->type;
+  entry_tag.opcode = op_node->opcode;
+  entry_tag.name = op_node->name;
+  entry_tag.name_tag = op_node->name_tag;
+  saved_entry_tags_.append(entry_tag);
+}
+
 /* Util callbacks for `BKE_library_foreach_ID_link`, used to detect when a COW ID is using ID
  * pointers that are either:
  *  - COW ID pointers that do not exist anymore in current depsgraph.
@@ -430,7 +526,7 @@ static int foreach_id_cow_detect_need_for_update_callback(LibraryIDLinkCallbackD
   return builder->foreach_id_cow_detect_need_for_update_callback(id_cow_self, id);
 }
 
-void DepsgraphNodeBuilder::update_invalid_cow_pointers()
+void DepsgraphNodeBuilder::update_invalid_cow_pointers(Span<IDNode *> id_nodes)
 {
   /* NOTE: Currently the only ID types that depsgraph may decide to not evaluate/generate COW
    * copies for, even though they are referenced by other data-blocks, are Collections and Objects
@@ -442,7 +538,7 @@ void DepsgraphNodeBuilder::update_invalid_cow_pointers()
    * some cases. This is slightly unfortunate (as it may hide issues in other parts of Blender
    * code), but cannot really be avoided currently. */
 
-  for (const IDNode *id_node : graph_->id_nodes) {
+  for (const IDNode *id_node : id_nodes) {
     if (id_node->previously_visible_components_mask == 0) {
       /* Newly added node/ID, no need to check it. */
       continue;
@@ -504,7 +600,15 @@ void DepsgraphNodeBuilder::tag_previously_tagged_nodes()
 void DepsgraphNodeBuilder::end_build()
 {
   tag_previously_tagged_nodes();
-  update_invalid_cow_pointers();
+  update_invalid_cow_pointers(graph_->id_nodes);
+}
+
+void DepsgraphNodeBuilder::end_build_incremental()
+{
+  tag_previously_tagged_nodes();
+  /* Pointers of the kept copy-on-write data-blocks remain valid, since the rebuilt nodes re-use
+   * their copy-on-write data-blocks. */
+  update_invalid_cow_pointers(graph_->id_nodes.as_span().drop_front(kept_id_nodes_num_));
 }
 
 void DepsgraphNodeBuilder::build_id(ID *id)
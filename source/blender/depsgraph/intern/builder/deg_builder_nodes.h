@@ -86,6 +86,15 @@ class DepsgraphNodeBuilder : public DepsgraphBuilder {
   virtual void begin_build();
   virtual void end_build();
 
+  /* Incremental counterpart of begin_build(): all existing nodes of the graph are kept, apart from
+   * the ones of `rebuild_ids` which are removed together with their relations, so that they can
+   * be built again. Their copy-on-write data-blocks are re-used by the new nodes, and the kept
+   * nodes are considered built already. */
+  virtual void begin_build_incremental(Scene *scene,
+                                       ViewLayer *view_layer,
+                                       const Set<ID *> &rebuild_ids);
+  virtual void end_build_incremental();
+
   /**
    * `id_cow_self` is the user of `id_pointer`,
    * see also `LibraryIDLinkCallbackData` struct definition.
@@ -267,6 +276,8 @@ class DepsgraphNodeBuilder : public DepsgraphBuilder {
   };
   Vector<SavedEntryTag> saved_entry_tags_;
 
+  void save_entry_tag(const OperationNode *op_node);
+
   struct BuilderWalkUserData {
     DepsgraphNodeBuilder *builder;
   };
@@ -284,7 +295,7 @@ class DepsgraphNodeBuilder : public DepsgraphBuilder {
    * Check for IDs that need to be flushed (COW-updated)
    * because the depsgraph itself created or removed some of their evaluated dependencies.
    */
-  void update_invalid_cow_pointers();
+  void update_invalid_cow_pointers(Span<IDNode *> id_nodes);
 
   /* State which demotes currently built entities. */
   Scene *scene_;
@@ -301,6 +312,10 @@ class DepsgraphNodeBuilder : public DepsgraphBuilder {
   /* Indexed by original ID.session_uuid, values are IDInfo. */
   Map<uint, IDInfo *> id_info_hash_;
 
+  /* Number of ID nodes kept from the previous state of the graph by an incremental build, the
+   * nodes built by it are stored after them in #Depsgraph.id_nodes. */
+  int64_t kept_id_nodes_num_;
+
   /* Set of IDs which were already build. Makes it easier to keep track of
    * what was already built and what was not. */
   BuilderMap built_map_;
@@ -233,7 +233,10 @@ bool object_have_geometry_component(const Object *object)
 DepsgraphRelationBuilder::DepsgraphRelationBuilder(Main *bmain,
                                                    Depsgraph *graph,
                                                    DepsgraphBuilderCache *cache)
-    : DepsgraphBuilder(bmain, graph, cache), scene_(nullptr), rna_node_query_(graph, this)
+    : DepsgraphBuilder(bmain, graph, cache),
+      scene_(nullptr),
+      rna_node_query_(graph, this),
+      relation_flags_(0)
 {
 }
 
@@ -339,7 +342,7 @@ Relation *DepsgraphRelationBuilder::add_time_relation(TimeSourceNode *timesrc,
                                                       int flags)
 {
   if (timesrc && node_to) {
-    return graph_->add_new_relation(timesrc, node_to, description, flags);
+    return graph_->add_new_relation(timesrc, node_to, description, flags | relation_flags_);
   }
 
   DEG_DEBUG_PRINTF((::Depsgraph *)graph_,
@@ -367,7 +370,7 @@ Relation *DepsgraphRelationBuilder::add_operation_relation(OperationNode *node_f
                                                            int flags)
 {
   if (node_from && node_to) {
-    return graph_->add_new_relation(node_from, node_to, description, flags);
+    return graph_->add_new_relation(node_from, node_to, description, flags | relation_flags_);
   }
 
   DEG_DEBUG_PRINTF((::Depsgraph *)graph_,
@@ -481,6 +484,15 @@ void DepsgraphRelationBuilder::begin_build()
 {
 }
 
+void DepsgraphRelationBuilder::begin_build_incremental(Scene *scene, Span<ID *> built_ids)
+{
+  scene_ = scene;
+  relation_flags_ = RELATION_CHECK_BEFORE_ADD;
+  for (ID *id : built_ids) {
+    built_map_.tagBuild(id);
+  }
+}
+
 void DepsgraphRelationBuilder::build_id(ID *id)
 {
   if (id == nullptr) {
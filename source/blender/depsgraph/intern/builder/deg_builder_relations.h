@@ -148,6 +148,10 @@ class DepsgraphRelationBuilder : public DepsgraphBuilder {
   DepsgraphRelationBuilder(Main *bmain, Depsgraph *graph, DepsgraphBuilderCache *cache);
 
   void begin_build();
+  /* Incremental counterpart of begin_build(): relations are only added when they do not exist
+   * yet, and the IDs from `built_ids` are considered to be built already so their relations are
+   * not visited again. */
+  void begin_build_incremental(Scene *scene, Span<ID *> built_ids);
 
   template<typename KeyFrom, typename KeyTo>
   Relation *add_relation(const KeyFrom &key_from,
@@ -363,6 +367,10 @@ class DepsgraphRelationBuilder : public DepsgraphBuilder {
 
   BuilderMap built_map_;
   RNANodeQuery rna_node_query_;
+
+  /* Flags which are added to every new relation, used to avoid duplicate relations when
+   * updating the graph incrementally. */
+  int relation_flags_;
 };
 
 struct DepsNodeHandle {
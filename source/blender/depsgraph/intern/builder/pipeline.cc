@@ -91,6 +91,13 @@ void AbstractBuilderPipeline::build_step_finalize()
 #endif
   /* Relations are up to date. */
   deg_graph_->need_update = false;
+  deg_graph_->need_full_update = !supports_incremental_update();
+  deg_graph_->update_relations_ids.clear();
+}
+
+bool AbstractBuilderPipeline::supports_incremental_update() const
+{
+  return false;
 }
 
 unique_ptr<DepsgraphNodeBuilder> AbstractBuilderPipeline::construct_node_builder()
@@ -45,6 +45,10 @@ class AbstractBuilderPipeline {
   ViewLayer *view_layer_;
   DepsgraphBuilderCache builder_cache_;
 
+  /* Whether the graph built by this pipeline can later be updated with the
+   * #IncrementalBuilderPipeline, otherwise the whole graph is rebuilt on relations update. */
+  virtual bool supports_incremental_update() const;
+
   virtual unique_ptr<DepsgraphNodeBuilder> construct_node_builder();
   virtual unique_ptr<DepsgraphRelationBuilder> construct_relation_builder();
 
@@ -0,0 +1,262 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "pipeline_incremental.h"
+
+#include "PIL_time.h"
+
+#include "BLI_listbase.h"
+
+#include "BKE_collision.h"
+#include "BKE_effect.h"
+#include "BKE_global.h"
+#include "BKE_modifier.h"
+
+#include "DNA_layer_types.h"
+#include "DNA_modifier_types.h"
+#include "DNA_object_force_types.h"
+#include "DNA_object_types.h"
+#include "DNA_particle_types.h"
+#include "DNA_scene_types.h"
+
+#include "intern/builder/deg_builder_nodes.h"
+#include "intern/builder/deg_builder_relations.h"
+#include "intern/depsgraph.h"
+#include "intern/depsgraph_relation.h"
+#include "intern/node/deg_node_component.h"
+#include "intern/node/deg_node_operation.h"
+
+namespace blender::deg {
+
+namespace {
+
+/* Objects which are looked up by other objects through the physics caches of the graph, their
+ * users are not connected to them by regular relations. */
+bool object_is_physics_source(const Object *object)
+{
+  if (object->pd != nullptr && object->pd->forcefield != PFIELD_NULL) {
+    return true;
+  }
+  if (object->rigidbody_object != nullptr || object->rigidbody_constraint != nullptr) {
+    return true;
+  }
+  LISTBASE_FOREACH (const ParticleSystem *, psys, &object->particlesystem) {
+    const ParticleSettings *part = psys->part;
+    if ((part->pd != nullptr && part->pd->forcefield != PFIELD_NULL) ||
+        (part->pd2 != nullptr && part->pd2->forcefield != PFIELD_NULL)) {
+      return true;
+    }
+  }
+  return BKE_modifiers_findby_type(object, eModifierType_Collision) != nullptr ||
+         BKE_modifiers_findby_type(object, eModifierType_Fluid) != nullptr ||
+         BKE_modifiers_findby_type(object, eModifierType_DynamicPaint) != nullptr;
+}
+
+bool object_is_in_physics_relations(const Depsgraph *graph, const Object *object)
+{
+  for (int type = 0; type < DEG_PHYSICS_RELATIONS_NUM; type++) {
+    const Map<const ID *, ListBase *> *hash = graph->physics_relations[type];
+    if (hash == nullptr) {
+      continue;
+    }
+    for (const ListBase *relations : hash->values()) {
+      if (type == DEG_PHYSICS_EFFECTOR) {
+        LISTBASE_FOREACH (const EffectorRelation *, relation, relations) {
+          if (relation->ob == object) {
+            return true;
+          }
+        }
+      }
+      else {
+        LISTBASE_FOREACH (const CollisionRelation *, relation, relations) {
+          if (relation->ob == object) {
+            return true;
+          }
+        }
+      }
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+IncrementalBuilderPipeline::IncrementalBuilderPipeline(::Depsgraph *graph)
+    : AbstractBuilderPipeline(graph), kept_id_nodes_num_(0)
+{
+}
+
+bool IncrementalBuilderPipeline::build_incremental()
+{
+  if (deg_graph_->need_full_update || deg_graph_->update_relations_ids.is_empty()) {
+    return false;
+  }
+
+  double start_time = 0.0;
+  if (G.debug & (G_DEBUG_DEPSGRAPH_BUILD | G_DEBUG_DEPSGRAPH_TIME)) {
+    start_time = PIL_check_seconds_timer();
+  }
+
+  unique_ptr<DepsgraphNodeBuilder> node_builder = construct_node_builder();
+  if (!collect_rebuild_objects(*node_builder) || !collect_neighbour_ids()) {
+    return false;
+  }
+
+  build_step_sanity_check();
+
+  /* Nodes of the tagged objects. */
+  node_builder->begin_build_incremental(scene_, view_layer_, rebuild_ids_);
+  kept_id_nodes_num_ = deg_graph_->id_nodes.size();
+  build_nodes(*node_builder);
+  node_builder->end_build_incremental();
+  node_builder.reset();
+
+  /* Relations of the tagged objects, their neighbours and the newly added IDs. Relations of all
+   * other IDs are kept as-is. */
+  Vector<ID *> built_ids;
+  for (const IDNode *id_node : deg_graph_->id_nodes.as_span().take_front(kept_id_nodes_num_)) {
+    if (!neighbour_ids_.contains(id_node->id_orig)) {
+      built_ids.append(id_node->id_orig);
+    }
+  }
+  unique_ptr<DepsgraphRelationBuilder> relation_builder = construct_relation_builder();
+  relation_builder->begin_build_incremental(scene_, built_ids);
+  build_relations(*relation_builder);
+  for (IDNode *id_node : deg_graph_->id_nodes.as_span().drop_front(kept_id_nodes_num_)) {
+    relation_builder->build_copy_on_write_relations(id_node);
+    relation_builder->build_driver_relations(id_node);
+  }
+  relation_builder.reset();
+
+  build_step_finalize();
+
+  if (G.debug & (G_DEBUG_DEPSGRAPH_BUILD | G_DEBUG_DEPSGRAPH_TIME)) {
+    printf("Depsgraph updated incrementally for %d objects in %f seconds.\n",
+           int(rebuild_objects_.size()),
+           PIL_check_seconds_timer() - start_time);
+  }
+  return true;
+}
+
+bool IncrementalBuilderPipeline::supports_incremental_update() const
+{
+  return true;
+}
+
+bool IncrementalBuilderPipeline::collect_rebuild_objects(DepsgraphNodeBuilder &node_builder)
+{
+  for (ID *id : deg_graph_->update_relations_ids) {
+    const IDNode *id_node = deg_graph_->find_id_node(id);
+    if (id_node == nullptr) {
+      /* Nothing in this graph depends on the ID. */
+      continue;
+    }
+    if (id_node->id_type != ID_OB || id_node->linked_state == DEG_ID_LINKED_VIA_SET) {
+      return false;
+    }
+    Object *object = reinterpret_cast<Object *>(id);
+    if (object_is_physics_source(object) || object_is_in_physics_relations(deg_graph_, object)) {
+      return false;
+    }
+
+    RebuildObject rebuild_object;
+    rebuild_object.object = object;
+    rebuild_object.base_index = -1;
+    rebuild_object.linked_state = id_node->linked_state;
+    rebuild_object.is_directly_visible = id_node->is_directly_visible;
+    rebuild_object.has_base = id_node->has_base;
+    if (id_node->has_base) {
+      /* Same indexing as in DepsgraphNodeBuilder::build_view_layer(). */
+      int base_index = 0;
+      LISTBASE_FOREACH (Base *, base, &view_layer_->object_bases) {
+        if (!node_builder.need_pull_base_into_graph(base)) {
+          continue;
+        }
+        if (base->object == object) {
+          rebuild_object.base_index = base_index;
+          break;
+        }
+        base_index++;
+      }
+      if (rebuild_object.base_index == -1) {
+        return false;
+      }
+    }
+    rebuild_objects_.append(rebuild_object);
+    rebuild_ids_.add(id);
+  }
+  return true;
+}
+
+bool IncrementalBuilderPipeline::collect_neighbour_ids()
+{
+  for (ID *id : rebuild_ids_) {
+    const IDNode *id_node = deg_graph_->find_id_node(id);
+    for (const ComponentNode *comp_node : id_node->components.values()) {
+      for (const OperationNode *op_node : comp_node->operations) {
+        for (const Relation *rel : op_node->inlinks) {
+          if (!add_neighbour(rel->from, false)) {
+            return false;
+          }
+        }
+        for (const Relation *rel : op_node->outlinks) {
+          if (!add_neighbour(rel->to, true)) {
+            return false;
+          }
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool IncrementalBuilderPipeline::add_neighbour(const Node *node, const bool is_user)
+{
+  if (node->type != NodeType::OPERATION) {
+    /* Relations from the time source are created by the object itself. */
+    return true;
+  }
+  const IDNode *id_node = static_cast<const OperationNode *>(node)->owner->owner;
+  if (rebuild_ids_.contains(id_node->id_orig)) {
+    return true;
+  }
+  if (id_node->id_type == ID_SCE) {
+    /* Relations from the scene are created by the object itself, or by its view layer base which
+     * is handled in build_relations(). The scene depending on the object would need relations of
+     * the scene to be rebuilt, which covers most of the graph. */
+    return !is_user && id_node->id_orig == &scene_->id;
+  }
+  neighbour_ids_.add(id_node->id_orig);
+  return true;
+}
+
+void IncrementalBuilderPipeline::build_nodes(DepsgraphNodeBuilder &node_builder)
+{
+  for (const RebuildObject &rebuild_object : rebuild_objects_) {
+    node_builder.build_object(rebuild_object.base_index,
+                              rebuild_object.object,
+                              rebuild_object.linked_state,
+                              rebuild_object.is_directly_visible);
+    /* The object might have been reached in a different way during the full build. */
+    IDNode *id_node = deg_graph_->find_id_node(&rebuild_object.object->id);
+    id_node->linked_state = max(id_node->linked_state, rebuild_object.linked_state);
+    id_node->is_directly_visible |= rebuild_object.is_directly_visible;
+    id_node->has_base |= rebuild_object.has_base;
+  }
+}
+
+void IncrementalBuilderPipeline::build_relations(DepsgraphRelationBuilder &relation_builder)
+{
+  for (const RebuildObject &rebuild_object : rebuild_objects_) {
+    if (rebuild_object.has_base) {
+      relation_builder.build_object_from_view_layer_base(rebuild_object.object);
+    }
+    else {
+      relation_builder.build_object(rebuild_object.object);
+    }
+  }
+  for (ID *id : neighbour_ids_) {
+    relation_builder.build_id(id);
+  }
+}
+
+}  // namespace blender::deg
@@ -0,0 +1,67 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#pragma once
+
+#include "pipeline.h"
+
+#include "intern/node/deg_node_id.h"
+
+struct Object;
+
+namespace blender {
+namespace deg {
+
+/* Builder which updates relations of an existing graph of a view layer by only rebuilding the
+ * nodes of objects tagged with #DEG_id_relations_tag_update and the relations of their direct
+ * neighbours, keeping the rest of the graph untouched.
+ *
+ * General notes:
+ *
+ * - Only changes which do not affect anything beyond the direct neighbours of the objects are
+ *   supported, like adding or removing modifiers. Objects which are part of set scenes or take
+ *   part in physics (colliders, effectors, rigid bodies) need the whole graph to be rebuilt.
+ *
+ * - Special evaluation flags, custom data masks and visibility requested by the rebuilt objects
+ *   from the kept IDs are accumulated, they are only reset by a full rebuild.
+ */
+class IncrementalBuilderPipeline : public AbstractBuilderPipeline {
+ public:
+  IncrementalBuilderPipeline(::Depsgraph *graph);
+
+  /* Returns false without modifying the graph when it can not be updated incrementally, in which
+   * case the whole graph is to be rebuilt. */
+  bool build_incremental();
+
+ protected:
+  virtual bool supports_incremental_update() const override;
+
+  virtual void build_nodes(DepsgraphNodeBuilder &node_builder) override;
+  virtual void build_relations(DepsgraphRelationBuilder &relation_builder) override;
+
+ private:
+  /* State of the object node before the update, which is to be restored on the new node. */
+  struct RebuildObject {
+    Object *object;
+    int base_index;
+    eDepsNode_LinkedState_Type linked_state;
+    bool is_directly_visible;
+    bool has_base;
+  };
+
+  bool collect_rebuild_objects(DepsgraphNodeBuilder &node_builder);
+  bool collect_neighbour_ids();
+  bool add_neighbour(const Node *node, bool is_user);
+
+  Vector<RebuildObject> rebuild_objects_;
+  Set<ID *> rebuild_ids_;
+  Set<ID *> neighbour_ids_;
+  /* Number of ID nodes kept from the previous state of the graph. */
+  int64_t kept_id_nodes_num_;
+};
+
+}  // namespace deg
+}  // namespace blender
@@ -17,6 +17,8 @@ class ViewLayerBuilderPipeline : public AbstractBuilderPipeline {
   ViewLayerBuilderPipeline(::Depsgraph *graph);
 
  protected:
+  virtual bool supports_incremental_update() const override;
+
   virtual void build_nodes(DepsgraphNodeBuilder &node_builder) override;
   virtual void build_relations(DepsgraphRelationBuilder &relation_builder) override;
 };
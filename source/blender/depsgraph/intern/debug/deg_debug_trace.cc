@@ -0,0 +1,166 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ *
+ * Timeline of evaluated operations, exported in the Chrome trace event format which can be
+ * opened with `chrome://tracing` or Perfetto.
+ */
+
+#include "DEG_depsgraph_debug.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_string.h"
+#include "BLI_utildefines.h"
+
+#include "BKE_global.h"
+
+#include "PIL_time.h"
+
+#include "atomic_ops.h"
+
+#include "intern/debug/deg_debug_trace.h"
+
+namespace blender::deg {
+namespace {
+
+/* Number of events kept in the ring buffer, older events get overwritten. */
+constexpr uint64_t TRACE_EVENTS_NUM = 1 << 18;
+/* Maximum nesting of spans within a thread. */
+constexpr int TRACE_DEPTH_MAX = 16;
+
+struct TraceEvent {
+  char name[64];
+  const char *category;
+  double time_begin;
+  double time_end;
+  int thread;
+};
+
+struct TraceSpan {
+  char name[64];
+  const char *category;
+  double time_begin;
+};
+
+struct TraceThreadState {
+  int thread = -1;
+  int depth = 0;
+  TraceSpan spans[TRACE_DEPTH_MAX];
+};
+
+TraceEvent *trace_events = nullptr;
+uint64_t trace_events_num = 0;
+double trace_time_begin = 0.0;
+uint32_t trace_threads_num = 0;
+
+thread_local TraceThreadState trace_thread_state;
+
+void trace_json_string(FILE *fp, const char *str)
+{
+  fputc('"', fp);
+  for (const char *c = str; *c; c++) {
+    if (ELEM(*c, '"', '\\')) {
+      fprintf(fp, "\\%c", *c);
+    }
+    else if ((unsigned char)*c < 0x20) {
+      fprintf(fp, "\\u%04x", (unsigned char)*c);
+    }
+    else {
+      fputc(*c, fp);
+    }
+  }
+  fputc('"', fp);
+}
+
+}  // namespace
+
+void deg_debug_trace_ensure()
+{
+  if ((G.debug & G_DEBUG_DEPSGRAPH_TRACE) == 0 || trace_events != nullptr) {
+    return;
+  }
+  trace_events = (TraceEvent *)MEM_malloc_arrayN(
+      TRACE_EVENTS_NUM, sizeof(TraceEvent), "depsgraph trace events");
+  trace_events_num = 0;
+  trace_time_begin = PIL_check_seconds_timer();
+}
+
+}  // namespace blender::deg
+
+namespace deg = blender::deg;
+
+bool DEG_debug_trace_is_enabled()
+{
+  return deg::trace_events != nullptr && (G.debug & G_DEBUG_DEPSGRAPH_TRACE);
+}
+
+void DEG_debug_trace_begin(const char *category, const char *name)
+{
+  deg::TraceThreadState &state = deg::trace_thread_state;
+  /* Spans nested too deep are still counted, so that begin and end calls remain balanced. */
+  if (state.depth++ >= deg::TRACE_DEPTH_MAX) {
+    return;
+  }
+  deg::TraceSpan &span = state.spans[state.depth - 1];
+  STRNCPY(span.name, name);
+  span.category = category;
+  span.time_begin = PIL_check_seconds_timer();
+}
+
+void DEG_debug_trace_end()
+{
+  deg::TraceThreadState &state = deg::trace_thread_state;
+  if (state.depth == 0) {
+    return;
+  }
+  if (state.depth-- > deg::TRACE_DEPTH_MAX) {
+    return;
+  }
+  if (deg::trace_events == nullptr) {
+    return;
+  }
+  if (state.thread == -1) {
+    state.thread = int(atomic_fetch_and_add_uint32(&deg::trace_threads_num, 1));
+  }
+
+  const deg::TraceSpan &span = state.spans[state.depth];
+  const uint64_t index = atomic_fetch_and_add_uint64(&deg::trace_events_num, 1);
+  deg::TraceEvent &event = deg::trace_events[index % deg::TRACE_EVENTS_NUM];
+  STRNCPY(event.name, span.name);
+  event.category = span.category;
+  event.time_begin = span.time_begin;
+  event.time_end = PIL_check_seconds_timer();
+  event.thread = state.thread;
+}
+
+void DEG_debug_trace_chrome(FILE *fp)
+{
+  fprintf(fp, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [");
+  if (deg::trace_events != nullptr) {
+    const uint64_t events_num = deg::trace_events_num;
+    const uint64_t first = (events_num > deg::TRACE_EVENTS_NUM) ?
+                               events_num - deg::TRACE_EVENTS_NUM :
+                               0;
+    for (uint64_t i = first; i < events_num; i++) {
+      const deg::TraceEvent &event = deg::trace_events[i % deg::TRACE_EVENTS_NUM];
+      fprintf(fp, "%s\n{\"name\": ", (i == first) ? "" : ",");
+      deg::trace_json_string(fp, event.name);
+      fprintf(fp,
+              ", \"cat\": \"%s\", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, \"pid\": 0, "
+              "\"tid\": %d}",
+              event.category,
+              (event.time_begin - deg::trace_time_begin) * 1e6,
+              (event.time_end - event.time_begin) * 1e6,
+              event.thread);
+    }
+  }
+  fprintf(fp, "\n]}\n");
+}
+
+void DEG_debug_trace_clear()
+{
+  MEM_SAFE_FREE(deg::trace_events);
+  deg::trace_events_num = 0;
+}
@@ -0,0 +1,15 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#pragma once
+
+namespace blender::deg {
+
+/* Allocate the trace buffer when tracing is enabled (#G_DEBUG_DEPSGRAPH_TRACE).
+ * Must be called from the main thread, outside of evaluation. */
+void deg_debug_trace_ensure();
+
+}  // namespace blender::deg
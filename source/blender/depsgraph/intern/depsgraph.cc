@@ -10,14 +10,17 @@
 #include "intern/depsgraph.h" /* own include */
 
 #include <algorithm>
+#include <atomic>
 #include <cstring>
 
 #include "MEM_guardedalloc.h"
 
 #include "BLI_console.h"
 #include "BLI_hash.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
+#include "BKE_geometry_frame_cache.hh"
 #include "BKE_global.h"
 #include "BKE_idtype.h"
 #include "BKE_scene.h"
@@ -43,9 +46,16 @@ namespace deg = blender::deg;
 
 namespace blender::deg {
 
+static int depsgraph_numa_node_next()
+{
+  static std::atomic<int> depsgraph_num = 0;
+  return depsgraph_num++ % BLI_task_scheduler_numa_nodes_num();
+}
+
 Depsgraph::Depsgraph(Main *bmain, Scene *scene, ViewLayer *view_layer, eEvaluationMode mode)
     : time_source(nullptr),
       need_update(true),
+      need_full_update(true),
       need_visibility_update(true),
       need_visibility_time_update(false),
       bmain(bmain),
@@ -57,6 +67,7 @@ Depsgraph::Depsgraph(Main *bmain, Scene *scene, ViewLayer *view_layer, eEvaluati
       scene_cow(nullptr),
       is_active(false),
       is_evaluating(false),
+      numa_node(depsgraph_numa_node_next()),
       is_render_pipeline_depsgraph(false),
       use_editors_update(false)
 {
@@ -298,6 +309,7 @@ void DEG_graph_free(Depsgraph *graph)
   using deg::Depsgraph;
   deg::Depsgraph *deg_depsgraph = reinterpret_cast<deg::Depsgraph *>(graph);
   deg::unregister_graph(deg_depsgraph);
+  blender::bke::geometry_frame_cache_clear(graph);
   delete deg_depsgraph;
 }
 
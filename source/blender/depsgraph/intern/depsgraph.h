@@ -91,6 +91,10 @@ struct Depsgraph {
 
   /* Indicates whether relations needs to be updated. */
   bool need_update;
+  /* Indicates whether the whole graph is to be rebuilt when relations are updated. Otherwise only
+   * the part of the graph around IDs from `update_relations_ids` is rebuilt, when possible. */
+  bool need_full_update;
+  Set<ID *> update_relations_ids;
 
   /* Indicated whether IDs in this graph are to be tagged as if they first appear visible, with
    * an optional tag for their animation (time) update. */
@@ -146,6 +150,12 @@ struct Depsgraph {
 
   bool is_evaluating;
 
+  /* NUMA node the threaded evaluation runs on. Dependency graphs are spread over the nodes as
+   * they are created, so the evaluated copies of one graph stay in the memory of one node and
+   * graphs evaluated concurrently (viewport and final render) do not compete for the same
+   * threads. */
+  int numa_node;
+
   /* Is set to truth for dependency graph which are used for post-processing (compositor and
    * sequencer).
    * Such dependency graph needs all view layers (so render pipeline can access names), but it
@@ -23,6 +23,7 @@
 #include "DNA_simulation_types.h"
 
 #include "BKE_collection.h"
+#include "BKE_geometry_frame_cache.hh"
 #include "BKE_main.h"
 #include "BKE_scene.h"
 
@@ -34,6 +35,7 @@
 #include "builder/pipeline_all_objects.h"
 #include "builder/pipeline_compositor.h"
 #include "builder/pipeline_from_ids.h"
+#include "builder/pipeline_incremental.h"
 #include "builder/pipeline_render.h"
 #include "builder/pipeline_view_layer.h"
 
@@ -271,6 +273,7 @@ void DEG_graph_tag_relations_update(Depsgraph *graph)
   DEG_DEBUG_PRINTF(graph, TAG, "%s: Tagging relations for update.\n", __func__);
   deg::Depsgraph *deg_graph = reinterpret_cast<deg::Depsgraph *>(graph);
   deg_graph->need_update = true;
+  deg_graph->need_full_update = true;
   /* NOTE: When relations are updated, it's quite possible that
    * we've got new bases in the scene. This means, we need to
    * re-create flat array of bases in view layer.
@@ -290,6 +293,12 @@ void DEG_graph_relations_update(Depsgraph *graph)
     /* Graph is up to date, nothing to do. */
     return;
   }
+  /* Cached geometry might point to evaluated IDs which are about to be removed. */
+  blender::bke::geometry_frame_cache_clear(graph);
+  deg::IncrementalBuilderPipeline incremental_builder(graph);
+  if (incremental_builder.build_incremental()) {
+    return;
+  }
   DEG_graph_build_from_view_layer(graph);
 }
 
@@ -300,3 +309,14 @@ void DEG_relations_tag_update(Main *bmain)
     DEG_graph_tag_relations_update(reinterpret_cast<Depsgraph *>(depsgraph));
   }
 }
+
+void DEG_id_relations_tag_update(Main *bmain, ID *id)
+{
+  DEG_GLOBAL_DEBUG_PRINTF(TAG, "%s: Tagging relations of %s for update.\n", __func__, id->name);
+  for (deg::Depsgraph *depsgraph : deg::get_all_registered_graphs(bmain)) {
+    depsgraph->need_update = true;
+    if (!depsgraph->need_full_update) {
+      depsgraph->update_relations_ids.add(id);
+    }
+  }
+}
@@ -10,20 +10,29 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_listbase.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
+#include "BKE_modifier.h"
+#include "BKE_pointcache.h"
 #include "BKE_scene.h"
 
+#include "DNA_modifier_types.h"
 #include "DNA_object_types.h"
 #include "DNA_scene_types.h"
 
 #include "DEG_depsgraph.h"
 #include "DEG_depsgraph_query.h"
 
+#ifdef WITH_PYTHON
+#  include "BPY_extern.h"
+#endif
+
 #include "intern/eval/deg_eval.h"
 #include "intern/eval/deg_eval_flush.h"
 
 #include "intern/node/deg_node.h"
+#include "intern/node/deg_node_id.h"
 #include "intern/node/deg_node_operation.h"
 #include "intern/node/deg_node_time.h"
 
@@ -78,3 +87,54 @@ void DEG_evaluate_on_framechange(Depsgraph *graph, float frame)
   deg_graph->ctime = BKE_scene_frame_to_ctime(scene, frame);
   deg_flush_updates_and_refresh(deg_graph);
 }
+
+bool DEG_frames_are_independent(const Depsgraph *graph)
+{
+  const deg::Depsgraph *deg_graph = reinterpret_cast<const deg::Depsgraph *>(graph);
+  Scene *scene = deg_graph->scene;
+
+  if (scene->rigidbody_world != nullptr) {
+    return false;
+  }
+  for (const deg::IDNode *id_node : deg_graph->id_nodes) {
+    if (id_node->id_type == ID_SIM) {
+      return false;
+    }
+    if (id_node->id_type != ID_OB) {
+      continue;
+    }
+    Object *object = reinterpret_cast<Object *>(id_node->id_orig);
+    if (BKE_ptcache_object_has(scene, object, 0)) {
+      return false;
+    }
+    /* Both keep the geometry of the previous frame to compute velocities. */
+    if (BKE_modifiers_findby_type(object, eModifierType_Collision) != nullptr ||
+        BKE_modifiers_findby_type(object, eModifierType_Surface) != nullptr) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void DEG_evaluate_on_framechange_multi(Depsgraph **graphs,
+                                       const float *frames,
+                                       const int graphs_num)
+{
+#ifdef WITH_PYTHON
+  /* Release the GIL so that Python drivers can be evaluated from any of the graphs, the
+   * evaluation of a single graph only releases it when called from the thread holding it. */
+  BPy_BEGIN_ALLOW_THREADS;
+#endif
+
+  blender::threading::parallel_for(
+      blender::IndexRange(graphs_num), 1, [&](const blender::IndexRange range) {
+        for (const int i : range) {
+          BLI_assert(!DEG_is_active(graphs[i]));
+          DEG_evaluate_on_framechange(graphs[i], frames[i]);
+        }
+      });
+
+#ifdef WITH_PYTHON
+  BPy_END_ALLOW_THREADS;
+#endif
+}
@@ -28,6 +28,7 @@
 #include "DNA_windowmanager_types.h"
 
 #include "BKE_anim_data.h"
+#include "BKE_geometry_frame_cache.hh"
 #include "BKE_global.h"
 #include "BKE_idtype.h"
 #include "BKE_node.h"
@@ -462,6 +463,16 @@ int deg_recalc_flags_effective(Depsgraph *graph, int flags)
   return flags;
 }
 
+/* Whether the geometry evaluated for a frame might be different after the update. */
+bool deg_tag_invalidates_frame_cache(int flags)
+{
+  const int keep_flags = ID_RECALC_SELECT | ID_RECALC_BASE_FLAGS | ID_RECALC_SHADING |
+                         ID_RECALC_EDITORS | ID_RECALC_SEQUENCER_STRIPS | ID_RECALC_FRAME_CHANGE |
+                         ID_RECALC_AUDIO_FPS | ID_RECALC_AUDIO_VOLUME | ID_RECALC_AUDIO_MUTE |
+                         ID_RECALC_AUDIO_LISTENER | ID_RECALC_AUDIO;
+  return flags == 0 || (flags & ~keep_flags) != 0;
+}
+
 /* Special tag function which tags all components which needs to be tagged
  * for update flag=0.
  *
@@ -644,6 +655,9 @@ void graph_id_tag_update(
            update_source_as_string(update_source));
   }
   IDNode *id_node = (graph != nullptr) ? graph->find_id_node(id) : nullptr;
+  if (graph != nullptr && graph->is_active && deg_tag_invalidates_frame_cache(flag)) {
+    bke::geometry_frame_cache_clear(reinterpret_cast<::Depsgraph *>(graph));
+  }
   if (graph != nullptr) {
     DEG_graph_id_type_tag(reinterpret_cast<::Depsgraph *>(graph), GS(id->name));
   }
@@ -14,6 +14,7 @@
 #include "DNA_customdata_types.h"
 
 #include "DEG_depsgraph.h"
+#include "DEG_depsgraph_debug.h"
 
 #include "intern/depsgraph_type.h"
 #include "intern/node/deg_node.h"
@@ -33,6 +34,7 @@ void DEG_register_node_types()
 
 void DEG_free_node_types()
 {
+  DEG_debug_trace_clear();
 }
 
 deg::DEGCustomDataMeshMasks::DEGCustomDataMeshMasks(const CustomData_MeshMasks *other)
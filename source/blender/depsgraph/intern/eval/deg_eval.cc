@@ -13,7 +13,10 @@
 
 #include "BLI_compiler_attrs.h"
 #include "BLI_gsqueue.h"
+#include "BLI_heap.h"
+#include "BLI_stack.h"
 #include "BLI_task.h"
+#include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_global.h"
@@ -21,8 +24,10 @@
 #include "DNA_node_types.h"
 #include "DNA_object_types.h"
 #include "DNA_scene_types.h"
+#include "DNA_userdef_types.h"
 
 #include "DEG_depsgraph.h"
+#include "DEG_depsgraph_debug.h"
 #include "DEG_depsgraph_query.h"
 
 #ifdef WITH_PYTHON
@@ -31,6 +36,7 @@
 
 #include "atomic_ops.h"
 
+#include "intern/debug/deg_debug_trace.h"
 #include "intern/depsgraph.h"
 #include "intern/depsgraph_relation.h"
 #include "intern/depsgraph_tag.h"
@@ -84,23 +90,50 @@ struct DepsgraphEvalState {
   bool do_stats;
   EvaluationStage stage;
   bool need_single_thread_pass;
+
+  /* Critical path scheduling: operations which are ready to be evaluated, ordered by their
+   * priority. Every scheduled operation pushes a task which evaluates the operation with the
+   * highest priority at the time the task runs. */
+  bool use_critical_path;
+  Heap *ready_heap;
+  SpinLock ready_lock;
 };
 
+/* Weight of the latest evaluation time in the averaged cost of an operation. */
+static const float EVALUATION_COST_FACTOR = 0.25f;
+
 void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_node)
 {
   ::Depsgraph *depsgraph = reinterpret_cast<::Depsgraph *>(state->graph);
 
   /* Sanity checks. */
   BLI_assert_msg(!operation_node->is_noop(), "NOOP nodes should not actually be scheduled");
+  const bool do_trace = DEG_debug_trace_is_enabled();
+  if (do_trace) {
+    DEG_debug_trace_begin("depsgraph", operation_node->full_identifier().c_str());
+  }
   /* Perform operation. */
-  if (state->do_stats) {
+  if (state->do_stats || state->use_critical_path) {
     const double start_time = PIL_check_seconds_timer();
     operation_node->evaluate(depsgraph);
-    operation_node->stats.current_time += PIL_check_seconds_timer() - start_time;
+    const double time = PIL_check_seconds_timer() - start_time;
+    if (state->do_stats) {
+      operation_node->stats.current_time += time;
+    }
+    if (state->use_critical_path) {
+      operation_node->evaluation_cost = (operation_node->evaluation_cost == 0.0f) ?
+                                            float(time) :
+                                            interpf(float(time),
+                                                    operation_node->evaluation_cost,
+                                                    EVALUATION_COST_FACTOR);
+    }
   }
   else {
     operation_node->evaluate(depsgraph);
   }
+  if (do_trace) {
+    DEG_debug_trace_end();
+  }
 }
 
 void deg_task_run_func(TaskPool *pool, void *taskdata)
@@ -116,6 +149,33 @@ void deg_task_run_func(TaskPool *pool, void *taskdata)
   schedule_children(state, operation_node, schedule_node_to_pool, pool);
 }
 
+void deg_task_run_prioritized_func(TaskPool *pool, void *UNUSED(taskdata));
+
+void schedule_node_to_prioritized_pool(OperationNode *node,
+                                       const int UNUSED(thread_id),
+                                       TaskPool *pool)
+{
+  DepsgraphEvalState *state = (DepsgraphEvalState *)BLI_task_pool_user_data(pool);
+  BLI_spin_lock(&state->ready_lock);
+  BLI_heap_insert(state->ready_heap, -node->priority, node);
+  BLI_spin_unlock(&state->ready_lock);
+  BLI_task_pool_push(pool, deg_task_run_prioritized_func, nullptr, false, nullptr);
+}
+
+void deg_task_run_prioritized_func(TaskPool *pool, void *UNUSED(taskdata))
+{
+  DepsgraphEvalState *state = (DepsgraphEvalState *)BLI_task_pool_user_data(pool);
+
+  /* There is one task per scheduled node, so the heap can't be empty here. */
+  BLI_spin_lock(&state->ready_lock);
+  OperationNode *operation_node = (OperationNode *)BLI_heap_pop_min(state->ready_heap);
+  BLI_spin_unlock(&state->ready_lock);
+
+  evaluate_node(state, operation_node);
+
+  schedule_children(state, operation_node, schedule_node_to_prioritized_pool, pool);
+}
+
 bool check_operation_node_visible(OperationNode *op_node)
 {
   const ComponentNode *comp_node = op_node->owner;
@@ -166,10 +226,69 @@ void calculate_pending_parents(Depsgraph *graph)
   }
 }
 
+bool is_operation_relation_evaluated(const Relation *rel)
+{
+  if (rel->from->type != NodeType::OPERATION || rel->to->type != NodeType::OPERATION ||
+      (rel->flag & RELATION_FLAG_CYCLIC) != 0) {
+    return false;
+  }
+  const OperationNode *from = (const OperationNode *)rel->from;
+  const OperationNode *to = (const OperationNode *)rel->to;
+  return (from->flag & to->flag & DEPSOP_FLAG_NEEDS_UPDATE) &&
+         check_operation_node_visible((OperationNode *)from) &&
+         check_operation_node_visible((OperationNode *)to);
+}
+
+/* Priority of every operation is its cost plus the highest priority of its children, so that the
+ * operations at the start of the longest chains are evaluated first. Only operations that are
+ * evaluated are taken into account, node custom flags are used to count unvisited children. */
+void calculate_critical_path_priorities(Depsgraph *graph)
+{
+  BLI_Stack *stack = BLI_stack_new(sizeof(OperationNode *), __func__);
+
+  for (OperationNode *node : graph->operations) {
+    node->priority = 0.0f;
+    node->custom_flags = 0;
+    if ((node->flag & DEPSOP_FLAG_NEEDS_UPDATE) == 0 || !check_operation_node_visible(node)) {
+      continue;
+    }
+    for (Relation *rel : node->outlinks) {
+      if (is_operation_relation_evaluated(rel)) {
+        node->custom_flags++;
+      }
+    }
+    if (node->custom_flags == 0) {
+      BLI_stack_push(stack, &node);
+    }
+  }
+
+  /* Visit operations in reverse topological order, starting at the ones without children. */
+  while (!BLI_stack_is_empty(stack)) {
+    OperationNode *node;
+    BLI_stack_pop(stack, &node);
+    node->priority += node->evaluation_cost;
+    for (Relation *rel : node->inlinks) {
+      if (!is_operation_relation_evaluated(rel)) {
+        continue;
+      }
+      OperationNode *parent = (OperationNode *)rel->from;
+      parent->priority = max_ff(parent->priority, node->priority);
+      if (--parent->custom_flags == 0) {
+        BLI_stack_push(stack, &parent);
+      }
+    }
+  }
+
+  BLI_stack_free(stack);
+}
+
 void initialize_execution(DepsgraphEvalState *state, Depsgraph *graph)
 {
   const bool do_stats = state->do_stats;
   calculate_pending_parents(graph);
+  if (state->use_critical_path) {
+    calculate_critical_path_priorities(graph);
+  }
   /* Clear tags and other things which needs to be clear. */
   for (OperationNode *node : graph->operations) {
     if (do_stats) {
@@ -342,7 +461,22 @@ static TaskPool *deg_evaluate_task_pool_create(DepsgraphEvalState *state)
     return BLI_task_pool_create_no_threads(state);
   }
 
-  return BLI_task_pool_create_suspended(state, TASK_PRIORITY_HIGH);
+  TaskPool *task_pool = BLI_task_pool_create_suspended(state, TASK_PRIORITY_HIGH);
+  BLI_task_pool_numa_node_set(task_pool, state->graph->numa_node);
+  return task_pool;
+}
+
+static void deg_evaluate_task_pool_run(DepsgraphEvalState *state)
+{
+  TaskPool *task_pool = deg_evaluate_task_pool_create(state);
+  if (state->use_critical_path) {
+    schedule_graph(state, schedule_node_to_prioritized_pool, task_pool);
+  }
+  else {
+    schedule_graph(state, schedule_node_to_pool, task_pool);
+  }
+  BLI_task_pool_work_and_wait(task_pool);
+  BLI_task_pool_free(task_pool);
 }
 
 void deg_evaluate_on_refresh(Depsgraph *graph)
@@ -360,29 +494,36 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
 #endif
 
   graph->is_evaluating = true;
+  deg_debug_trace_ensure();
   depsgraph_ensure_view_layer(graph);
   /* Set up evaluation state. */
   DepsgraphEvalState state;
   state.graph = graph;
   state.do_stats = graph->debug.do_time_debug();
   state.need_single_thread_pass = false;
+  state.use_critical_path = USER_EXPERIMENTAL_TEST(&U, use_depsgraph_critical_path) &&
+                            (G.debug & G_DEBUG_DEPSGRAPH_NO_THREADS) == 0;
+  state.ready_heap = nullptr;
+  if (state.use_critical_path) {
+    state.ready_heap = BLI_heap_new();
+    BLI_spin_init(&state.ready_lock);
+  }
   /* Prepare all nodes for evaluation. */
   initialize_execution(&state, graph);
 
   /* Do actual evaluation now. */
   /* First, process all Copy-On-Write nodes. */
   state.stage = EvaluationStage::COPY_ON_WRITE;
-  TaskPool *task_pool = deg_evaluate_task_pool_create(&state);
-  schedule_graph(&state, schedule_node_to_pool, task_pool);
-  BLI_task_pool_work_and_wait(task_pool);
-  BLI_task_pool_free(task_pool);
+  deg_evaluate_task_pool_run(&state);
 
   /* After that, process all other nodes. */
   state.stage = EvaluationStage::THREADED_EVALUATION;
-  task_pool = deg_evaluate_task_pool_create(&state);
-  schedule_graph(&state, schedule_node_to_pool, task_pool);
-  BLI_task_pool_work_and_wait(task_pool);
-  BLI_task_pool_free(task_pool);
+  deg_evaluate_task_pool_run(&state);
+
+  if (state.use_critical_path) {
+    BLI_heap_free(state.ready_heap, nullptr);
+    BLI_spin_end(&state.ready_lock);
+  }
 
   if (state.need_single_thread_pass) {
     state.stage = EvaluationStage::SINGLE_THREADED_WORKAROUND;
@@ -269,8 +269,8 @@ struct ValidateData {
 };
 
 /* Similar to generic BKE_id_copy() but does not require main and assumes pointer
- * is already allocated. */
-bool id_copy_inplace_no_main(const ID *id, ID *newid)
+ * is already allocated. The `flag` is added to the ID copy flags. */
+bool id_copy_inplace_no_main(const ID *id, ID *newid, const int flag = 0)
 {
   const ID *id_for_copy = id;
 
@@ -291,7 +291,7 @@ bool id_copy_inplace_no_main(const ID *id, ID *newid)
                                 (ID *)id_for_copy,
                                 &newid,
                                 (LIB_ID_COPY_LOCALIZE | LIB_ID_CREATE_NO_ALLOCATE |
-                                 LIB_ID_COPY_SET_COPIED_ON_WRITE)) != nullptr);
+                                 LIB_ID_COPY_SET_COPIED_ON_WRITE | flag)) != nullptr);
 
 #ifdef NESTED_ID_NASTY_WORKAROUND
   if (result) {
@@ -791,8 +791,6 @@ ID *deg_expand_copy_on_write_datablock(const Depsgraph *depsgraph, const IDNode
   BLI_assert(id_cow->py_instance == nullptr);
 
   /* Copy data from original ID to a copied version. */
-  /* TODO(sergey): Avoid doing full ID copy somehow, make Mesh to reference
-   * original geometry arrays for until those are modified. */
   /* TODO(sergey): We do some trickery with temp bmain and extra ID pointer
    * just to be able to use existing API. Ideally we need to replace this with
    * in-place copy from existing datablock to a prepared memory.
@@ -816,8 +814,12 @@ ID *deg_expand_copy_on_write_datablock(const Depsgraph *depsgraph, const IDNode
       break;
     }
     case ID_ME: {
-      /* TODO(sergey): Ideally we want to handle meshes in a special
-       * manner here to avoid initial copy of all the geometry arrays. */
+      /* Share the geometry arrays with the original mesh until they are modified. Inactive
+       * dependency graphs (used for rendering) can be evaluated from other threads while the
+       * original mesh is being edited, so they keep using full copies. */
+      if (depsgraph->is_active) {
+        done = id_copy_inplace_no_main(id_orig, id_cow, LIB_ID_COPY_CD_SHARE);
+      }
       break;
     }
     default:
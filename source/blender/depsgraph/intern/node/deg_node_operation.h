@@ -256,6 +256,13 @@ struct OperationNode : public Node {
   uint32_t num_links_pending;
   bool scheduled;
 
+  /* Estimated evaluation time in seconds, averaged over previous evaluations.
+   * Only updated when using critical path scheduling. */
+  float evaluation_cost;
+  /* Estimated evaluation time of the longest chain of operations starting at this one.
+   * Ready operations with higher priority are evaluated first. */
+  float priority;
+
   /* Identifier for the operation being performed. */
   OperationCode opcode;
   int name_tag;
@@ -15,6 +15,7 @@
 #include "BKE_particle.h"
 
 #include "BLI_alloca.h"
+#include "BLI_listbase.h"
 
 #include "DNA_particle_types.h"
 
@@ -217,6 +218,43 @@ static void basic_cache_populate(void *vedata, Object *ob)
   }
 }
 
+/**
+ * Thread safe subset of #basic_cache_populate covering plain mesh surfaces, objects needing
+ * particles, sculpt, material slots or the flat object fallback are declined.
+ */
+static bool basic_cache_populate_parallel(void *vedata, Object *ob, DRWObjectCalls *calls)
+{
+  BASIC_StorageList *stl = ((BASIC_Data *)vedata)->stl;
+
+  if (!DRW_object_is_renderable(ob) || (ob->dt < OB_SOLID)) {
+    return true;
+  }
+
+  const DRWContextState *draw_ctx = DRW_context_state_get();
+  if (ob->type != OB_MESH || ob->sculpt != NULL || stl->g_data->use_material_slot_selection) {
+    return false;
+  }
+  if (ob != draw_ctx->object_edit && !BLI_listbase_is_empty(&ob->particlesystem)) {
+    return false;
+  }
+  /* The flat object check lazily computes bounding boxes, which is not thread safe. */
+  if ((draw_ctx->v3d->overlay.flag & V3D_OVERLAY_WIREFRAMES) ||
+      (draw_ctx->v3d->shading.type == OB_WIRE) || (ob->dtx & OB_DRAWWIRE) || (ob->dt == OB_WIRE)) {
+    return false;
+  }
+
+  const bool do_in_front = (ob->dtx & OB_DRAW_IN_FRONT) != 0;
+  const bool do_cull = (draw_ctx->v3d->shading.flag & V3D_SHADING_BACKFACE_CULLING) != 0;
+  DRWShadingGroup *shgrp = (do_cull) ? stl->g_data->depth_shgrp_cull[do_in_front] :
+                                       stl->g_data->depth_shgrp[do_in_front];
+
+  struct GPUBatch *geom = DRW_cache_object_surface_get(ob);
+  if (geom) {
+    return DRW_object_calls_add(calls, shgrp, geom);
+  }
+  return true;
+}
+
 static void basic_cache_finish(void *vedata)
 {
   BASIC_StorageList *stl = ((BASIC_Data *)vedata)->stl;
@@ -259,6 +297,7 @@ DrawEngineType draw_engine_basic_type = {
     NULL,
     NULL,
     NULL,
+    &basic_cache_populate_parallel,
 };
 
 #undef BASIC_ENGINE
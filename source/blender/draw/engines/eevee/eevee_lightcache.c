@@ -1356,6 +1356,27 @@ static bool lightbake_do_sample(EEVEE_LightBake *lbake,
   return true;
 }
 
+/**
+ * Print the time spent baking a probe with `--debug-jobs`, to find the probes that are the most
+ * expensive to bake. A negative bounce is used for reflection cube-maps.
+ */
+static void lightbake_print_probe_time(const LightProbe *prb, int bounce, double start_time)
+{
+  if ((G.debug & G_DEBUG_JOBS) == 0) {
+    return;
+  }
+  const double time = PIL_check_seconds_timer() - start_time;
+  if (bounce < 0) {
+    printf("Light cache: reflection cube-map \"%s\" baked in %.3fs\n", prb->id.name + 2, time);
+  }
+  else {
+    printf("Light cache: irradiance volume \"%s\" bounce %d baked in %.3fs\n",
+           prb->id.name + 2,
+           bounce + 1,
+           time);
+  }
+}
+
 void EEVEE_lightbake_job(void *custom_data, short *stop, short *do_update, float *progress)
 {
   EEVEE_LightBake *lbake = (EEVEE_LightBake *)custom_data;
@@ -1426,10 +1447,12 @@ void EEVEE_lightbake_job(void *custom_data, short *stop, short *do_update, float
         LightProbe *prb = *lbake->probe;
         lbake->grid_sample_len = prb->grid_resolution_x * prb->grid_resolution_y *
                                  prb->grid_resolution_z;
+        const double start_time = PIL_check_seconds_timer();
         for (lbake->grid_sample = 0; lbake->grid_sample < lbake->grid_sample_len;
              ++lbake->grid_sample) {
           lightbake_do_sample(lbake, eevee_lightbake_render_grid_sample);
         }
+        lightbake_print_probe_time(prb, lbake->bounce_curr, start_time);
       }
     }
   }
@@ -1441,7 +1464,9 @@ void EEVEE_lightbake_job(void *custom_data, short *stop, short *do_update, float
     lbake->cube = lcache->cube_data + 1;
     for (lbake->cube_offset = 1; lbake->cube_offset < lbake->cube_len;
          lbake->cube_offset++, lbake->probe++, lbake->cube++) {
+      const double start_time = PIL_check_seconds_timer();
       lightbake_do_sample(lbake, eevee_lightbake_render_probe_sample);
+      lightbake_print_probe_time(*lbake->probe, -1, start_time);
     }
   }
 
@@ -185,6 +185,32 @@ static bool sphere_bbox_intersect(const BoundSphere *bs, const EEVEE_BoundBox *b
   return x && y && z;
 }
 
+/**
+ * Tag the shadow cubes that intersect an updated shadow caster of the buffer.
+ * \return The number of tagged shadow cubes, all casters are skipped once every cube is tagged.
+ */
+static int shadows_tag_casters_update(EEVEE_LightsInfo *linfo,
+                                      const EEVEE_ShadowCasterBuffer *casters,
+                                      int cube_update_len)
+{
+  const BoundSphere *bsphere = linfo->shadow_bounds;
+  for (int i = 0; i < casters->count && cube_update_len < linfo->cube_len; i++) {
+    /* If the shadow-caster has been deleted or updated. */
+    if (!BLI_BITMAP_TEST(casters->update, i)) {
+      continue;
+    }
+    for (int j = 0; j < linfo->cube_len; j++) {
+      if (!BLI_BITMAP_TEST(&linfo->sh_cube_update[0], j)) {
+        if (sphere_bbox_intersect(&bsphere[j], &casters->bbox[i])) {
+          BLI_BITMAP_ENABLE(&linfo->sh_cube_update[0], j);
+          cube_update_len++;
+        }
+      }
+    }
+  }
+  return cube_update_len;
+}
+
 void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
 {
   EEVEE_StorageList *stl = vedata->stl;
@@ -240,36 +266,15 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
     }
   }
 
-  /* TODO(fclem): This part can be slow, optimize it. */
-  EEVEE_BoundBox *bbox = backbuffer->bbox;
-  BoundSphere *bsphere = linfo->shadow_bounds;
-  /* Search for deleted shadow casters or if shcaster WAS in shadow radius. */
-  for (int i = 0; i < backbuffer->count; i++) {
-    /* If the shadow-caster has been deleted or updated. */
-    if (BLI_BITMAP_TEST(backbuffer->update, i)) {
-      for (int j = 0; j < linfo->cube_len; j++) {
-        if (!BLI_BITMAP_TEST(&linfo->sh_cube_update[0], j)) {
-          if (sphere_bbox_intersect(&bsphere[j], &bbox[i])) {
-            BLI_BITMAP_ENABLE(&linfo->sh_cube_update[0], j);
-          }
-        }
-      }
-    }
+  /* Lights that are already tagged don't need to be tested against the casters. */
+  int cube_update_len = 0;
+  for (int j = 0; j < linfo->cube_len; j++) {
+    cube_update_len += BLI_BITMAP_TEST(&linfo->sh_cube_update[0], j) ? 1 : 0;
   }
+  /* Search for deleted shadow casters or if shcaster WAS in shadow radius. */
+  cube_update_len = shadows_tag_casters_update(linfo, backbuffer, cube_update_len);
   /* Search for updates in current shadow casters. */
-  bbox = frontbuffer->bbox;
-  for (int i = 0; i < frontbuffer->count; i++) {
-    /* If the shadow-caster has been updated. */
-    if (BLI_BITMAP_TEST(frontbuffer->update, i)) {
-      for (int j = 0; j < linfo->cube_len; j++) {
-        if (!BLI_BITMAP_TEST(&linfo->sh_cube_update[0], j)) {
-          if (sphere_bbox_intersect(&bsphere[j], &bbox[i])) {
-            BLI_BITMAP_ENABLE(&linfo->sh_cube_update[0], j);
-          }
-        }
-      }
-    }
-  }
+  shadows_tag_casters_update(linfo, frontbuffer, cube_update_len);
 
   /* Resize shcasters buffers if too big. */
   if (frontbuffer->alloc_count - frontbuffer->count > SH_CASTER_ALLOC_CHUNK) {
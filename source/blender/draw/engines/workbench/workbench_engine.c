@@ -174,6 +174,9 @@ static void workbench_cache_common_populate(WORKBENCH_PrivateData *wpd,
         geom = DRW_cache_mesh_surface_sculptcolors_get(ob);
       }
     }
+    else if (ob->type == OB_MESH) {
+      geom = DRW_cache_mesh_surface_lod_get(ob);
+    }
     else {
       geom = DRW_cache_object_surface_get(ob);
     }
@@ -75,6 +75,7 @@ struct rcti;
 
 typedef struct DRWCallBuffer DRWCallBuffer;
 typedef struct DRWInterface DRWInterface;
+typedef struct DRWObjectCalls DRWObjectCalls;
 typedef struct DRWPass DRWPass;
 typedef struct DRWShaderLibrary DRWShaderLibrary;
 typedef struct DRWShadingGroup DRWShadingGroup;
@@ -133,6 +134,16 @@ typedef struct DrawEngineType {
                           struct RenderLayer *layer,
                           const struct rcti *rect);
   void (*store_metadata)(void *vedata, struct RenderResult *render_result);
+
+  /**
+   * Optional thread safe variant of `cache_populate`, used for objects that are not duplis when
+   * the draw manager populates objects in parallel. It only reads the object, requests batches
+   * and records its draw calls in `calls`, which are replayed in object order on the main thread.
+   * Returning false makes the draw manager call `cache_populate` for this object instead.
+   */
+  bool (*cache_populate_parallel)(void *vedata,
+                                  struct Object *ob,
+                                  DRWObjectCalls *calls);
 } DrawEngineType;
 
 /* Textures */
@@ -406,6 +417,15 @@ void DRW_shgroup_call_ex(DRWShadingGroup *shgroup,
                          bool bypass_culling,
                          void *user_data);
 
+/**
+ * Record a draw call of `ob` from #DrawEngineType.cache_populate_parallel. Safe to call from
+ * worker threads. Returns false when the per object call buffer is full, in which case the
+ * engine should return false so the object gets populated on the main thread.
+ */
+bool DRW_object_calls_add(DRWObjectCalls *calls,
+                          DRWShadingGroup *shgroup,
+                          struct GPUBatch *geom);
+
 /**
  * If ob is NULL, unit modelmatrix is assumed and culling is bypassed.
  */
@@ -14,6 +14,7 @@
 #include "DNA_particle_types.h"
 #include "DNA_pointcloud_types.h"
 #include "DNA_scene_types.h"
+#include "DNA_userdef_types.h"
 #include "DNA_volume_types.h"
 
 #include "UI_resources.h"
@@ -23,6 +24,7 @@
 
 #include "BKE_object.h"
 #include "BKE_paint.h"
+#include "BKE_subdiv_modifier.h"
 
 #include "GPU_batch.h"
 #include "GPU_batch_utils.h"
@@ -2859,6 +2861,53 @@ GPUBatch *DRW_cache_mesh_surface_get(Object *ob)
   return DRW_mesh_batch_cache_get_surface(ob->data);
 }
 
+/** Objects with a smaller projected diameter in pixels are drawn with the simplified surface. */
+#define MESH_LOD_PIXEL_SIZE 96.0f
+/** Meshes with fewer loops are always drawn at full resolution. */
+#define MESH_LOD_MIN_LOOPS 20000
+
+static bool drw_object_is_small_on_screen(Object *ob)
+{
+  const BoundBox *bb = BKE_object_boundbox_get(ob);
+  if (bb == NULL) {
+    return false;
+  }
+  float center[3];
+  mid_v3_v3v3(center, bb->vec[0], bb->vec[6]);
+  mul_m4_v3(ob->obmat, center);
+  const float radius = 0.5f * len_v3v3(bb->vec[0], bb->vec[6]) * mat4_to_scale(ob->obmat);
+
+  float persmat[4][4], winmat[4][4];
+  DRW_view_persmat_get(NULL, persmat, false);
+  DRW_view_winmat_get(NULL, winmat, false);
+  /* Distance along the view axis for perspective views, 1 for orthographic ones. */
+  const float zfac = mul_project_m4_v3_zfac(persmat, center);
+  if (DRW_view_is_persp_get(NULL) && zfac <= radius) {
+    return false;
+  }
+  const float *viewport_size = DRW_viewport_size_get();
+  const float pixel_size = radius * winmat[1][1] * viewport_size[1] / zfac;
+  return pixel_size < MESH_LOD_PIXEL_SIZE;
+}
+
+GPUBatch *DRW_cache_mesh_surface_lod_get(Object *ob)
+{
+  BLI_assert(ob->type == OB_MESH);
+  Mesh *me = ob->data;
+  if (USER_EXPERIMENTAL_TEST(&U, use_draw_mesh_lod) && (ob->mode == OB_MODE_OBJECT) &&
+      (me->edit_mesh == NULL) && (me->totloop >= MESH_LOD_MIN_LOOPS) &&
+      !DRW_state_is_select() && !DRW_state_is_depth() && !DRW_state_is_image_render()) {
+    const DRWContextState *draw_ctx = DRW_context_state_get();
+    const int required_mode = BKE_subsurf_modifier_eval_required_mode(false, false);
+    /* The simplified triangles index the loops of the base mesh. */
+    if (!BKE_subsurf_modifier_can_do_gpu_subdiv(draw_ctx->scene, ob, me, required_mode) &&
+        drw_object_is_small_on_screen(ob)) {
+      return DRW_mesh_batch_cache_get_surface_lod(me);
+    }
+  }
+  return DRW_mesh_batch_cache_get_surface(me);
+}
+
 GPUBatch *DRW_cache_mesh_surface_edges_get(Object *ob)
 {
   BLI_assert(ob->type == OB_MESH);
@@ -152,6 +152,11 @@ struct GPUBatch *DRW_cache_mesh_all_edges_get(struct Object *ob);
 struct GPUBatch *DRW_cache_mesh_loose_edges_get(struct Object *ob);
 struct GPUBatch *DRW_cache_mesh_edge_detection_get(struct Object *ob, bool *r_is_manifold);
 struct GPUBatch *DRW_cache_mesh_surface_get(struct Object *ob);
+/**
+ * Surface of the mesh, or a simplified one when the object is small on screen and the
+ * `use_draw_mesh_lod` experimental option is enabled.
+ */
+struct GPUBatch *DRW_cache_mesh_surface_lod_get(struct Object *ob);
 struct GPUBatch *DRW_cache_mesh_surface_edges_get(struct Object *ob);
 /**
  * Return list of batches with length equal to `max(1, totcol)`.
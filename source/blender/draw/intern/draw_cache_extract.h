@@ -156,6 +156,8 @@ typedef struct MeshBufferList {
     GPUIndexBuf *edituv_lines;
     GPUIndexBuf *edituv_points;
     GPUIndexBuf *edituv_fdots;
+    /* Simplified surface, see #DRW_cache_mesh_surface_lod_get. */
+    GPUIndexBuf *tris_lod;
   } ibo;
 } MeshBufferList;
 
@@ -193,6 +195,7 @@ typedef struct MeshBatchList {
   GPUBatch *wire_loops;     /* Loops around faces. no edges between selected faces */
   GPUBatch *wire_loops_uvs; /* Same as wire_loops but only has uvs. */
   GPUBatch *sculpt_overlays;
+  GPUBatch *surface_lod;
 } MeshBatchList;
 
 #define MBC_BATCH_LEN (sizeof(MeshBatchList) / sizeof(void *))
@@ -230,6 +233,7 @@ typedef enum DRWBatchFlag {
   MBC_WIRE_LOOPS = (1u << MBC_BATCH_INDEX(wire_loops)),
   MBC_WIRE_LOOPS_UVS = (1u << MBC_BATCH_INDEX(wire_loops_uvs)),
   MBC_SCULPT_OVERLAYS = (1u << MBC_BATCH_INDEX(sculpt_overlays)),
+  MBC_SURFACE_LOD = (1u << MBC_BATCH_INDEX(surface_lod)),
 } DRWBatchFlag;
 
 BLI_STATIC_ASSERT(MBC_BATCH_LEN < 32, "Number of batches exceeded the limit of bit fields");
@@ -311,6 +315,41 @@ typedef struct MeshBatchCache {
 
   eV3DShadingColorType color_type;
   bool pbvh_is_drawing;
+
+  /**
+   * Topology of the mesh the cache was created for. Evaluated meshes that are only deformed
+   * share these arrays with the original mesh, which allows a cache to be taken over by the
+   * next evaluated mesh of the same object.
+   */
+  struct {
+    const struct MPoly *mpoly;
+    const struct MLoop *mloop;
+    const struct MEdge *medge;
+    int vert_len, edge_len, poly_len, loop_len;
+  } topology;
+  /** Vertex positions changed since `pos_nor` was uploaded. */
+  bool pos_nor_deformed;
+  /** The cache was detached from a mesh whose next evaluated mesh shares its topology. */
+  bool is_stash_deform_only;
+
+  /**
+   * Extraction that runs in the background for large meshes, while the batches draw the buffers
+   * of the cache of the previous evaluated mesh.
+   */
+  struct {
+    /** Cache of the previous evaluated mesh of the same object. */
+    struct MeshBatchCache *prev;
+    struct TaskGraph *task_graph;
+    struct TaskPool *task_pool;
+    /** Set once all nodes of `task_graph` are done. */
+    uint32_t is_finished;
+    /**
+     * Per batch, followed by one per material: the batch draws the buffers of `prev` and its own
+     * bindings are stored in `bindings` until the extraction is finished.
+     */
+    bool *use_prev;
+    GPUBatch *bindings;
+  } async;
 } MeshBatchCache;
 
 #define MBC_EDITUV \
@@ -673,6 +673,7 @@ static void mesh_buffer_cache_create_requested(struct TaskGraph *task_graph,
   EXTRACT_ADD_REQUESTED(ibo, edituv_lines);
   EXTRACT_ADD_REQUESTED(ibo, edituv_points);
   EXTRACT_ADD_REQUESTED(ibo, edituv_fdots);
+  EXTRACT_ADD_REQUESTED(ibo, tris_lod);
 
 #undef EXTRACT_ADD_REQUESTED
 
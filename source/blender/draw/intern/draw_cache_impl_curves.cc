@@ -17,6 +17,7 @@
 #include "BLI_math_vector.h"
 #include "BLI_math_vector.hh"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "DNA_curves_types.h"
@@ -34,7 +35,9 @@
 #include "draw_hair_private.h" /* own include */
 
 using blender::float3;
+using blender::float4;
 using blender::IndexRange;
+using blender::MutableSpan;
 using blender::Span;
 
 /* ---------------------------------------------------------------------- */
@@ -129,43 +132,45 @@ static void ensure_seg_pt_count(const Curves &curves, ParticleHairCache &curves_
 }
 
 static void curves_batch_cache_fill_segments_proc_pos(const Curves &curves_id,
-                                                      GPUVertBufRaw &attr_step,
-                                                      GPUVertBufRaw &length_step)
+                                                      MutableSpan<float4> posTime_data,
+                                                      MutableSpan<float> hairLength_data)
 {
+  /* This stays on the CPU, unlike the refinement. The positions only exist in CPU memory and have
+   * to be uploaded anyway, the packed buffer only adds a time per point. The time is a running
+   * sum along each curve: a GPU version would need one invocation per curve looping over its
+   * points, and the transform feedback path (no compute shader support) would still need this
+   * fill. */
   /* TODO: use hair radius layer if available. */
   const int curve_size = curves_id.geometry.curve_size;
   const blender::bke::CurvesGeometry &curves = blender::bke::CurvesGeometry::wrap(
       curves_id.geometry);
   Span<float3> positions = curves.positions();
 
-  for (const int i : IndexRange(curve_size)) {
-    const IndexRange curve_range = curves.points_for_curve(i);
-
-    Span<float3> curve_positions = positions.slice(curve_range);
-    float total_len = 0.0f;
-    float *seg_data_first;
-    for (const int i_curve : curve_positions.index_range()) {
-      float *seg_data = (float *)GPU_vertbuf_raw_step(&attr_step);
-      copy_v3_v3(seg_data, curve_positions[i_curve]);
-      if (i_curve == 0) {
-        seg_data_first = seg_data;
+  /* Every curve writes its own range of points, so curves can be filled independently. */
+  blender::threading::parallel_for(IndexRange(curve_size), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const IndexRange curve_range = curves.points_for_curve(i);
+
+      Span<float3> curve_positions = positions.slice(curve_range);
+      MutableSpan<float4> curve_posTime_data = posTime_data.slice(curve_range);
+      float total_len = 0.0f;
+      for (const int i_point : curve_positions.index_range()) {
+        if (i_point > 0) {
+          total_len += blender::math::distance(curve_positions[i_point - 1],
+                                               curve_positions[i_point]);
+        }
+        curve_posTime_data[i_point] = float4(curve_positions[i_point], total_len);
       }
-      else {
-        total_len += blender::math::distance(curve_positions[i_curve - 1],
-                                             curve_positions[i_curve]);
+      /* Assign length value. */
+      hairLength_data[i] = total_len;
+      if (total_len > 0.0f) {
+        /* Divide by total length to have a [0-1] number. */
+        for (float4 &pos_time : curve_posTime_data) {
+          pos_time.w /= total_len;
+        }
       }
-      seg_data[3] = total_len;
     }
-    /* Assign length value. */
-    *(float *)GPU_vertbuf_raw_step(&length_step) = total_len;
-    if (total_len > 0.0f) {
-      /* Divide by total length to have a [0-1] number. */
-      for ([[maybe_unused]] const int i_curve : curve_positions.index_range()) {
-        seg_data_first[3] /= total_len;
-        seg_data_first += 4;
-      }
-    }
-  }
+  });
 }
 
 static void curves_batch_cache_ensure_procedural_pos(Curves &curves,
@@ -175,26 +180,25 @@ static void curves_batch_cache_ensure_procedural_pos(Curves &curves,
   if (cache.proc_point_buf == nullptr || DRW_vbo_requested(cache.proc_point_buf)) {
     /* Initialize vertex format. */
     GPUVertFormat format = {0};
-    uint pos_id = GPU_vertformat_attr_add(&format, "posTime", GPU_COMP_F32, 4, GPU_FETCH_FLOAT);
+    GPU_vertformat_attr_add(&format, "posTime", GPU_COMP_F32, 4, GPU_FETCH_FLOAT);
     GPU_vertformat_alias_add(&format, "pos");
 
     cache.proc_point_buf = GPU_vertbuf_create_with_format(&format);
     GPU_vertbuf_data_alloc(cache.proc_point_buf, cache.point_len);
 
-    GPUVertBufRaw point_step;
-    GPU_vertbuf_attr_get_raw_data(cache.proc_point_buf, pos_id, &point_step);
+    MutableSpan<float4> posTime_data{
+        static_cast<float4 *>(GPU_vertbuf_get_data(cache.proc_point_buf)), cache.point_len};
 
     GPUVertFormat length_format = {0};
-    uint length_id = GPU_vertformat_attr_add(
-        &length_format, "hairLength", GPU_COMP_F32, 1, GPU_FETCH_FLOAT);
+    GPU_vertformat_attr_add(&length_format, "hairLength", GPU_COMP_F32, 1, GPU_FETCH_FLOAT);
 
     cache.proc_length_buf = GPU_vertbuf_create_with_format(&length_format);
     GPU_vertbuf_data_alloc(cache.proc_length_buf, cache.strands_len);
 
-    GPUVertBufRaw length_step;
-    GPU_vertbuf_attr_get_raw_data(cache.proc_length_buf, length_id, &length_step);
+    MutableSpan<float> hairLength_data{
+        static_cast<float *>(GPU_vertbuf_get_data(cache.proc_length_buf)), cache.strands_len};
 
-    curves_batch_cache_fill_segments_proc_pos(curves, point_step, length_step);
+    curves_batch_cache_fill_segments_proc_pos(curves, posTime_data, hairLength_data);
 
     /* Create vbo immediately to bind to texture buffer. */
     GPU_vertbuf_use(cache.proc_point_buf);
@@ -9,6 +9,7 @@
 #include "DNA_gpencil_types.h"
 #include "DNA_meshdata_types.h"
 #include "DNA_screen_types.h"
+#include "DNA_userdef_types.h"
 
 #include "BKE_deform.h"
 #include "BKE_gpencil.h"
@@ -57,12 +58,23 @@ typedef struct GpencilBatchCache {
   GPUBatch *edit_curve_handles_batch;
   GPUBatch *edit_curve_points_batch;
 
+  /** Strokes written to the instancing VBOs, in drawing order. */
+  struct GpencilCachedStroke *strokes;
+  int strokes_len;
+
   /** Cache is dirty */
   bool is_dirty;
   /** Last cache frame */
   int cache_frame;
 } GpencilBatchCache;
 
+/** Layout of a stroke in the instancing VBOs, used to update changed strokes in place. */
+typedef struct GpencilCachedStroke {
+  const bGPDstroke *gps;
+  int vert_start, vert_len;
+  int tri_start, tri_len;
+} GpencilCachedStroke;
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -130,15 +142,27 @@ static void gpencil_batch_cache_clear(GpencilBatchCache *cache)
   GPU_BATCH_DISCARD_SAFE(cache->edit_curve_points_batch);
   GPU_VERTBUF_DISCARD_SAFE(cache->edit_curve_vbo);
 
+  MEM_SAFE_FREE(cache->strokes);
+  cache->strokes_len = 0;
+
   cache->is_dirty = true;
 }
 
+static bool gpencil_batch_cache_update_dirty_strokes(Object *ob,
+                                                     GpencilBatchCache *cache,
+                                                     int cfra);
+
 static GpencilBatchCache *gpencil_batch_cache_get(Object *ob, int cfra)
 {
   bGPdata *gpd = (bGPdata *)ob->data;
 
   GpencilBatchCache *cache = gpd->runtime.gpencil_cache;
   if (!gpencil_batch_cache_valid(cache, gpd, cfra)) {
+    const bool updated = gpencil_batch_cache_update_dirty_strokes(ob, cache, cfra);
+    gpd->runtime.draw_dirty_strokes_only = false;
+    if (updated) {
+      return cache;
+    }
     gpencil_batch_cache_clear(cache);
     return gpencil_batch_cache_init(ob, cfra);
   }
@@ -259,6 +283,9 @@ typedef struct gpIterData {
   int vert_len;
   int tri_len;
   int curve_len;
+  /** Strokes written to the buffers, see #GpencilBatchCache.strokes. */
+  GpencilCachedStroke *strokes;
+  int stroke_len;
 } gpIterData;
 
 static GPUVertBuf *gpencil_dummy_buffer_get(void)
@@ -295,8 +322,8 @@ BLI_INLINE int32_t pack_rotation_aspect_hardness(float rot, float asp, float har
   return packed;
 }
 
-static void gpencil_buffer_add_point(gpStrokeVert *verts,
-                                     gpColorVert *cols,
+static void gpencil_buffer_add_point(gpStrokeVert *vert,
+                                     gpColorVert *col,
                                      const bGPDstroke *gps,
                                      const bGPDspoint *pt,
                                      int v,
@@ -305,8 +332,6 @@ static void gpencil_buffer_add_point(gpStrokeVert *verts,
   /* NOTE: we use the sign of strength and thickness to pass cap flag. */
   const bool round_cap0 = (gps->caps[0] == GP_STROKE_CAP_ROUND);
   const bool round_cap1 = (gps->caps[1] == GP_STROKE_CAP_ROUND);
-  gpStrokeVert *vert = &verts[v];
-  gpColorVert *col = &cols[v];
   copy_v3_v3(vert->pos, &pt->x);
   copy_v2_v2(vert->uv_fill, pt->uv_fill);
   copy_v4_v4(col->vcol, pt->vert_color);
@@ -331,6 +356,14 @@ static void gpencil_buffer_add_point(gpStrokeVert *verts,
       pt->uv_rot, aspect_ratio, gps->hardeness);
 }
 
+static int gpencil_stroke_vert_len(const bGPDstroke *gps)
+{
+  return gps->totpoints + 2 + gpencil_stroke_is_cyclic(gps);
+}
+
+/**
+ * \param verts, cols: Buffers starting at the first vertex of the stroke.
+ */
 static void gpencil_buffer_add_stroke(gpStrokeVert *verts,
                                       gpColorVert *cols,
                                       const bGPDstroke *gps)
@@ -338,18 +371,21 @@ static void gpencil_buffer_add_stroke(gpStrokeVert *verts,
   const bGPDspoint *pts = gps->points;
   int pts_len = gps->totpoints;
   bool is_cyclic = gpencil_stroke_is_cyclic(gps);
-  int v = gps->runtime.stroke_start;
+  const int start = gps->runtime.stroke_start;
+  int v = 0;
 
   /* First point for adjacency (not drawn). */
   int adj_idx = (is_cyclic) ? (pts_len - 1) : min_ii(pts_len - 1, 1);
-  gpencil_buffer_add_point(verts, cols, gps, &pts[adj_idx], v++, true);
+  gpencil_buffer_add_point(&verts[v], &cols[v], gps, &pts[adj_idx], start + v, true);
+  v++;
 
   for (int i = 0; i < pts_len; i++) {
-    gpencil_buffer_add_point(verts, cols, gps, &pts[i], v++, false);
+    gpencil_buffer_add_point(&verts[v], &cols[v], gps, &pts[i], start + v, false);
+    v++;
   }
   /* Draw line to first point to complete the loop for cyclic strokes. */
   if (is_cyclic) {
-    gpencil_buffer_add_point(verts, cols, gps, &pts[0], v, false);
+    gpencil_buffer_add_point(&verts[v], &cols[v], gps, &pts[0], start + v, false);
     /* UV factor needs to be adjusted for the last point to not be equal to the UV factor of the
      * first point. It should be the factor of the last point plus the distance from the last point
      * to the first.
@@ -360,7 +396,7 @@ static void gpencil_buffer_add_stroke(gpStrokeVert *verts,
   }
   /* Last adjacency point (not drawn). */
   adj_idx = (is_cyclic) ? 1 : max_ii(0, pts_len - 2);
-  gpencil_buffer_add_point(verts, cols, gps, &pts[adj_idx], v++, true);
+  gpencil_buffer_add_point(&verts[v], &cols[v], gps, &pts[adj_idx], start + v, true);
 }
 
 static void gpencil_buffer_add_fill(GPUIndexBufBuilder *ibo, const bGPDstroke *gps)
@@ -379,7 +415,27 @@ static void gpencil_stroke_iter_cb(bGPDlayer *UNUSED(gpl),
                                    void *thunk)
 {
   gpIterData *iter = (gpIterData *)thunk;
-  gpencil_buffer_add_stroke(iter->verts, iter->cols, gps);
+  const int start = gps->runtime.stroke_start;
+  gpencil_buffer_add_stroke(&iter->verts[start], &iter->cols[start], gps);
+  if (gps->tot_triangles > 0) {
+    gpencil_buffer_add_fill(&iter->ibo, gps);
+  }
+  gps->runtime.draw_dirty = false;
+
+  GpencilCachedStroke *cached_stroke = &iter->strokes[iter->stroke_len++];
+  cached_stroke->gps = gps;
+  cached_stroke->vert_start = start;
+  cached_stroke->vert_len = gpencil_stroke_vert_len(gps);
+  cached_stroke->tri_start = gps->runtime.fill_start;
+  cached_stroke->tri_len = gps->tot_triangles;
+}
+
+static void gpencil_fill_indices_cb(bGPDlayer *UNUSED(gpl),
+                                    bGPDframe *UNUSED(gpf),
+                                    bGPDstroke *gps,
+                                    void *thunk)
+{
+  gpIterData *iter = (gpIterData *)thunk;
   if (gps->tot_triangles > 0) {
     gpencil_buffer_add_fill(&iter->ibo, gps);
   }
@@ -395,8 +451,9 @@ static void gpencil_object_verts_count_cb(bGPDlayer *UNUSED(gpl),
   /* Store first index offset */
   gps->runtime.stroke_start = iter->vert_len;
   gps->runtime.fill_start = iter->tri_len;
-  iter->vert_len += gps->totpoints + 2 + gpencil_stroke_is_cyclic(gps);
+  iter->vert_len += gpencil_stroke_vert_len(gps);
   iter->tri_len += gps->tot_triangles;
+  iter->stroke_len++;
 }
 
 static void gpencil_batches_ensure(Object *ob, GpencilBatchCache *cache, int cfra)
@@ -438,10 +495,15 @@ static void gpencil_batches_ensure(Object *ob, GpencilBatchCache *cache, int cfr
     iter.cols = (gpColorVert *)GPU_vertbuf_get_data(cache->vbo_col);
     /* Create IBO. */
     GPU_indexbuf_init(&iter.ibo, GPU_PRIM_TRIS, iter.tri_len, iter.vert_len);
+    cache->strokes = MEM_malloc_arrayN(
+        max_ii(iter.stroke_len, 1), sizeof(*cache->strokes), __func__);
+    iter.strokes = cache->strokes;
+    iter.stroke_len = 0;
 
     /* Fill buffers with data. */
     BKE_gpencil_visible_stroke_advanced_iter(
         NULL, ob, NULL, gpencil_stroke_iter_cb, &iter, do_onion, cfra);
+    cache->strokes_len = iter.stroke_len;
 
     /* Mark last 2 verts as invalid. */
     for (int i = 0; i < 2; i++) {
@@ -465,6 +527,146 @@ static void gpencil_batches_ensure(Object *ob, GpencilBatchCache *cache, int cfr
   }
 }
 
+typedef struct gpUpdateIterData {
+  const GpencilCachedStroke *strokes;
+  int strokes_len;
+  int stroke_index;
+  /** All visible strokes still have the layout they were written with. */
+  bool is_layout_unchanged;
+  int dirty_len;
+} gpUpdateIterData;
+
+static void gpencil_stroke_layout_compare_cb(bGPDlayer *UNUSED(gpl),
+                                             bGPDframe *UNUSED(gpf),
+                                             bGPDstroke *gps,
+                                             void *thunk)
+{
+  gpUpdateIterData *iter = (gpUpdateIterData *)thunk;
+  if (!iter->is_layout_unchanged) {
+    return;
+  }
+  if (iter->stroke_index >= iter->strokes_len) {
+    iter->is_layout_unchanged = false;
+    return;
+  }
+  const GpencilCachedStroke *cached_stroke = &iter->strokes[iter->stroke_index++];
+  if (cached_stroke->gps != gps || cached_stroke->vert_len != gpencil_stroke_vert_len(gps) ||
+      cached_stroke->tri_len != gps->tot_triangles) {
+    iter->is_layout_unchanged = false;
+    return;
+  }
+  /* Changed strokes are copied from the original data, restore their offsets in the VBOs. */
+  gps->runtime.stroke_start = cached_stroke->vert_start;
+  gps->runtime.fill_start = cached_stroke->tri_start;
+  if (gps->runtime.draw_dirty) {
+    iter->dirty_len++;
+  }
+}
+
+/**
+ * Rewrite the vertices of the strokes changed by an update-on-write of the grease pencil data
+ * (see #BKE_gpencil_update_on_write), instead of rebuilding the buffers of the whole object.
+ * Only possible when all visible strokes keep their place and size in the buffers.
+ *
+ * \return False if the cache has to be rebuilt.
+ */
+static bool gpencil_batch_cache_update_dirty_strokes(Object *ob,
+                                                     GpencilBatchCache *cache,
+                                                     int cfra)
+{
+  bGPdata *gpd = (bGPdata *)ob->data;
+  if (!USER_EXPERIMENTAL_TEST(&U, use_gpencil_partial_draw_update) ||
+      !gpd->runtime.draw_dirty_strokes_only) {
+    return false;
+  }
+  if (cache == NULL || cache->vbo == NULL || cache->is_dirty || cache->strokes == NULL ||
+      cfra != cache->cache_frame) {
+    return false;
+  }
+
+  /* IMPORTANT: Keep in sync with gpencil_batches_ensure() */
+  bool do_onion = true;
+
+  gpUpdateIterData iter = {
+      .strokes = cache->strokes,
+      .strokes_len = cache->strokes_len,
+      .stroke_index = 0,
+      .is_layout_unchanged = true,
+      .dirty_len = 0,
+  };
+  BKE_gpencil_visible_stroke_advanced_iter(
+      NULL, ob, NULL, gpencil_stroke_layout_compare_cb, &iter, do_onion, cfra);
+  if (!iter.is_layout_unchanged || iter.stroke_index != iter.strokes_len) {
+    return false;
+  }
+
+  /* Upload the vertices of each changed stroke to its range of the VBOs. */
+  bool fill_changed = false;
+  gpStrokeVert *verts = NULL;
+  gpColorVert *cols = NULL;
+  int verts_alloc_len = 0;
+  for (int i = 0; i < cache->strokes_len && iter.dirty_len > 0; i++) {
+    bGPDstroke *gps = (bGPDstroke *)cache->strokes[i].gps;
+    if (!gps->runtime.draw_dirty) {
+      continue;
+    }
+    const int vert_len = cache->strokes[i].vert_len;
+    if (vert_len > verts_alloc_len) {
+      MEM_SAFE_FREE(verts);
+      MEM_SAFE_FREE(cols);
+      verts = MEM_malloc_arrayN(vert_len, sizeof(*verts), __func__);
+      cols = MEM_malloc_arrayN(vert_len, sizeof(*cols), __func__);
+      verts_alloc_len = vert_len;
+    }
+    gpencil_buffer_add_stroke(verts, cols, gps);
+
+    const int start = cache->strokes[i].vert_start;
+    GPU_vertbuf_use(cache->vbo);
+    GPU_vertbuf_update_sub(
+        cache->vbo, start * sizeof(*verts), vert_len * sizeof(*verts), verts);
+    GPU_vertbuf_use(cache->vbo_col);
+    GPU_vertbuf_update_sub(
+        cache->vbo_col, start * sizeof(*cols), vert_len * sizeof(*cols), cols);
+
+    fill_changed |= (gps->tot_triangles > 0);
+    gps->runtime.draw_dirty = false;
+    iter.dirty_len--;
+  }
+  MEM_SAFE_FREE(verts);
+  MEM_SAFE_FREE(cols);
+
+  if (fill_changed) {
+    /* Triangulation may change with the points, rebuild the fill indices. */
+    const GpencilCachedStroke *last_stroke = &cache->strokes[cache->strokes_len - 1];
+    gpIterData fill_iter = {
+        .gpd = gpd,
+        .ibo = {0},
+    };
+    GPU_indexbuf_init(&fill_iter.ibo,
+                      GPU_PRIM_TRIS,
+                      last_stroke->tri_start + last_stroke->tri_len,
+                      GPU_vertbuf_get_vertex_len(cache->vbo));
+    BKE_gpencil_visible_stroke_advanced_iter(
+        NULL, ob, NULL, gpencil_fill_indices_cb, &fill_iter, do_onion, cfra);
+    GPU_BATCH_DISCARD_SAFE(cache->fill_batch);
+    GPU_INDEXBUF_DISCARD_SAFE(cache->ibo);
+    cache->ibo = GPU_indexbuf_build(&fill_iter.ibo);
+    cache->fill_batch = GPU_batch_create(GPU_PRIM_TRIS, cache->vbo, cache->ibo);
+    GPU_batch_vertbuf_add(cache->fill_batch, cache->vbo_col);
+  }
+
+  /* Edit mode buffers are cheap compared to the strokes, rebuild them when needed. */
+  GPU_BATCH_DISCARD_SAFE(cache->edit_lines_batch);
+  GPU_BATCH_DISCARD_SAFE(cache->edit_points_batch);
+  GPU_VERTBUF_DISCARD_SAFE(cache->edit_vbo);
+  GPU_BATCH_DISCARD_SAFE(cache->edit_curve_handles_batch);
+  GPU_BATCH_DISCARD_SAFE(cache->edit_curve_points_batch);
+  GPU_VERTBUF_DISCARD_SAFE(cache->edit_curve_vbo);
+
+  gpd->flag &= ~GP_DATA_CACHE_IS_DIRTY;
+  return true;
+}
+
 GPUBatch *DRW_cache_gpencil_strokes_get(Object *ob, int cfra)
 {
   GpencilBatchCache *cache = gpencil_batch_cache_get(ob, cfra);
@@ -608,7 +810,8 @@ static void gpencil_sbuffer_stroke_ensure(bGPdata *gpd, bool do_stroke, bool do_
     gpColorVert *cols = (gpColorVert *)GPU_vertbuf_get_data(vbo_col);
 
     /* Fill buffers with data. */
-    gpencil_buffer_add_stroke(verts, cols, gps);
+    const int start = gps->runtime.stroke_start;
+    gpencil_buffer_add_stroke(&verts[start], &cols[start], gps);
 
     GPUBatch *batch = GPU_batch_create(GPU_PRIM_TRI_STRIP, gpencil_dummy_buffer_get(), NULL);
     GPU_batch_instbuf_add_ex(batch, vbo, true);
@@ -24,6 +24,7 @@
 #include "DNA_meshdata_types.h"
 #include "DNA_object_types.h"
 #include "DNA_scene_types.h"
+#include "DNA_userdef_types.h"
 
 #include "BKE_attribute.h"
 #include "BKE_customdata.h"
@@ -147,8 +148,9 @@ static const DRWBatchFlag g_buffer_deps[] = {
                                              wire_edges,
                                              wire_loops,
                                              sculpt_overlays) |
-                                  SURFACE_PER_MAT_FLAG,
-    [BUFFER_INDEX(vbo.lnor)] = BATCH_FLAG(surface, edit_lnor, wire_loops) | SURFACE_PER_MAT_FLAG,
+                                  BATCH_FLAG(surface_lod) | SURFACE_PER_MAT_FLAG,
+    [BUFFER_INDEX(vbo.lnor)] = BATCH_FLAG(surface, edit_lnor, wire_loops, surface_lod) |
+                               SURFACE_PER_MAT_FLAG,
     [BUFFER_INDEX(vbo.edge_fac)] = BATCH_FLAG(wire_edges),
     [BUFFER_INDEX(vbo.weights)] = BATCH_FLAG(surface_weights),
     [BUFFER_INDEX(vbo.uv)] = BATCH_FLAG(surface,
@@ -216,6 +218,7 @@ static const DRWBatchFlag g_buffer_deps[] = {
     [BUFFER_INDEX(ibo.edituv_lines)] = BATCH_FLAG(edituv_edges, wire_loops_uvs),
     [BUFFER_INDEX(ibo.edituv_points)] = BATCH_FLAG(edituv_verts),
     [BUFFER_INDEX(ibo.edituv_fdots)] = BATCH_FLAG(edituv_fdots),
+    [BUFFER_INDEX(ibo.tris_lod)] = BATCH_FLAG(surface_lod),
     [TRIS_PER_MAT_INDEX] = SURFACE_PER_MAT_FLAG,
 };
 
@@ -922,6 +925,14 @@ static void mesh_batch_cache_init(Object *object, Mesh *me)
     // cache->vert_len = mesh_render_verts_len_get(me);
   }
 
+  cache->topology.mpoly = me->mpoly;
+  cache->topology.mloop = me->mloop;
+  cache->topology.medge = me->medge;
+  cache->topology.vert_len = me->totvert;
+  cache->topology.edge_len = me->totedge;
+  cache->topology.poly_len = me->totpoly;
+  cache->topology.loop_len = me->totloop;
+
   cache->mat_len = mesh_render_mat_len_get(object, me);
   cache->surface_per_mat = MEM_callocN(sizeof(*cache->surface_per_mat) * cache->mat_len, __func__);
   cache->tris_per_mat = MEM_callocN(sizeof(*cache->tris_per_mat) * cache->mat_len, __func__);
@@ -933,12 +944,285 @@ static void mesh_batch_cache_init(Object *object, Mesh *me)
   drw_mesh_weight_state_clear(&cache->weight_state);
 }
 
+static bool mesh_batch_cache_topology_equal(const MeshBatchCache *cache, const Mesh *me)
+{
+  return cache->topology.mpoly == me->mpoly && cache->topology.mloop == me->mloop &&
+         cache->topology.medge == me->medge && cache->topology.vert_len == me->totvert &&
+         cache->topology.edge_len == me->totedge && cache->topology.poly_len == me->totpoly &&
+         cache->topology.loop_len == me->totloop;
+}
+
+/** Discard the buffers that depend on vertex positions, except `pos_nor` which is updated. */
+static void mesh_batch_cache_discard_deformed(MeshBatchCache *cache)
+{
+  FOREACH_MESH_BUFFER_CACHE (cache, mbc) {
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.lnor);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.edge_fac);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.tan);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.edituv_stretch_area);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.edituv_stretch_angle);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.mesh_analysis);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.fdots_pos);
+    GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.fdots_nor);
+    GPU_INDEXBUF_DISCARD_SAFE(mbc->buff.ibo.tris_lod);
+  }
+  mesh_batch_cache_discard_batch(cache,
+                                 BATCH_MAP(vbo.lnor,
+                                           vbo.edge_fac,
+                                           vbo.tan,
+                                           vbo.edituv_stretch_area,
+                                           vbo.edituv_stretch_angle,
+                                           vbo.mesh_analysis,
+                                           vbo.fdots_pos,
+                                           vbo.fdots_nor,
+                                           ibo.tris_lod));
+  cache->pos_nor_deformed = true;
+}
+
+/**
+ * Take over the cache the previous evaluated mesh of `object` left in
+ * #Object_Runtime.mesh_batch_cache_prev when the topology is unchanged. Index buffers and the
+ * buffers that don't depend on positions are kept as they are.
+ *
+ * \return The previous cache when it could not be taken over.
+ */
+static MeshBatchCache *mesh_batch_cache_take_deformed(Object *object, Mesh *me)
+{
+  MeshBatchCache *cache = object->runtime.mesh_batch_cache_prev;
+  object->runtime.mesh_batch_cache_prev = NULL;
+
+  if (!cache->is_stash_deform_only || cache->is_editmode || cache->subdiv_cache ||
+      (object->sculpt != NULL) || (me->edit_mesh != NULL) ||
+      (me->runtime.wrapper_type != ME_WRAPPER_TYPE_MDATA) ||
+      !mesh_batch_cache_topology_equal(cache, me)) {
+    return cache;
+  }
+
+  me->runtime.batch_cache = cache;
+  mesh_batch_cache_discard_deformed(cache);
+  return NULL;
+}
+
+/* ---------------------------------------------------------------------- */
+/** \name Asynchronous Extraction
+ *
+ * When a large mesh gets a new evaluated mesh, its extraction can take longer than a redraw. With
+ * the `use_draw_async_mesh_extraction` experimental option the extraction graph of such a mesh
+ * runs on its own, and is not waited for by #DRW_mesh_batch_cache_create_requested. Meanwhile the
+ * requested batches draw the buffers of the cache of the previous evaluated mesh, and the viewport
+ * keeps being redrawn until a redraw finds the extraction finished and binds the new buffers.
+ *
+ * The extraction reads the evaluated mesh without holding a lock, so every function that frees or
+ * modifies the cache or the mesh calls #mesh_batch_cache_async_finish first.
+ * \{ */
+
+/** Meshes with fewer loops are always extracted before drawing. */
+#define MESH_EXTRACT_ASYNC_MIN_LOOPS 200000
+
+static int mesh_batch_cache_async_slot_len(const MeshBatchCache *cache)
+{
+  return MBC_BATCH_LEN + cache->mat_len;
+}
+
+static GPUBatch *mesh_batch_cache_async_slot_get(const MeshBatchCache *cache, const int slot)
+{
+  if (slot < MBC_BATCH_LEN) {
+    return ((GPUBatch *const *)&cache->batch)[slot];
+  }
+  return cache->surface_per_mat[slot - MBC_BATCH_LEN];
+}
+
+static bool mesh_batch_cache_async_slot_is_requested(const MeshBatchCache *cache, const int slot)
+{
+  const GPUBatch *batch = mesh_batch_cache_async_slot_get(cache, slot);
+  return (batch != NULL) && (batch->verts[0] == NULL);
+}
+
+static bool mesh_batch_cache_async_is_finished(MeshBatchCache *cache)
+{
+  return atomic_add_and_fetch_uint32(&cache->async.is_finished, 0) != 0;
+}
+
+static bool mesh_batch_cache_async_poll(MeshBatchCache *cache,
+                                        const Object *ob,
+                                        const Mesh *me,
+                                        const bool is_editmode,
+                                        const bool do_subdivision)
+{
+  MeshBatchCache *prev = cache->async.prev;
+  if (prev == NULL || is_editmode || do_subdivision || (ob->sculpt != NULL)) {
+    return false;
+  }
+  if (DRW_state_is_select() || DRW_state_is_depth() || DRW_state_is_image_render()) {
+    return false;
+  }
+  if ((me->totloop < MESH_EXTRACT_ASYNC_MIN_LOOPS) || (BLI_task_scheduler_num_threads() <= 1)) {
+    return false;
+  }
+  /* Layers referenced from the original mesh can be reallocated by an edit before the next
+   * redraw, only read data that is owned by the evaluated mesh. */
+  if ((me->runtime.wrapper_type != ME_WRAPPER_TYPE_MDATA) ||
+      CustomData_has_referenced(&me->vdata) || CustomData_has_referenced(&me->edata) ||
+      CustomData_has_referenced(&me->pdata) || CustomData_has_referenced(&me->ldata)) {
+    return false;
+  }
+  if ((prev->mat_len != cache->mat_len) ||
+      !mesh_cd_layers_type_overlap(prev->cd_used, cache->cd_used) ||
+      !drw_mesh_attributes_overlap(&prev->attr_used, &cache->attr_used)) {
+    return false;
+  }
+  /* Every batch that is going to be extracted needs a counterpart to draw meanwhile. */
+  const int slot_len = mesh_batch_cache_async_slot_len(cache);
+  for (int slot = 0; slot < slot_len; slot++) {
+    if (mesh_batch_cache_async_slot_is_requested(cache, slot)) {
+      const GPUBatch *batch_prev = mesh_batch_cache_async_slot_get(prev, slot);
+      if ((batch_prev == NULL) || (batch_prev->verts[0] == NULL)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/** Remember which batches are going to be extracted, before they get initialized. */
+static void mesh_batch_cache_async_prepare(MeshBatchCache *cache)
+{
+  const int slot_len = mesh_batch_cache_async_slot_len(cache);
+  cache->async.use_prev = MEM_callocN(sizeof(*cache->async.use_prev) * slot_len, __func__);
+  for (int slot = 0; slot < slot_len; slot++) {
+    cache->async.use_prev[slot] = mesh_batch_cache_async_slot_is_requested(cache, slot);
+  }
+  cache->async.task_graph = BLI_task_graph_create();
+}
+
+static void mesh_batch_cache_async_extract_fn(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  MeshBatchCache *cache = taskdata;
+  BLI_task_graph_work_and_wait(cache->async.task_graph);
+  atomic_fetch_and_or_uint32(&cache->async.is_finished, 1);
+}
+
+/**
+ * Called once the extraction of the requested batches has been pushed to `async.task_graph`.
+ * Bind the buffers of the previous cache to the requested batches until it is finished.
+ */
+static void mesh_batch_cache_async_begin(MeshBatchCache *cache)
+{
+  const int slot_len = mesh_batch_cache_async_slot_len(cache);
+  cache->async.bindings = MEM_callocN(sizeof(*cache->async.bindings) * slot_len, __func__);
+  for (int slot = 0; slot < slot_len; slot++) {
+    if (cache->async.use_prev[slot]) {
+      GPUBatch *batch = mesh_batch_cache_async_slot_get(cache, slot);
+      cache->async.bindings[slot] = *batch;
+      GPU_batch_copy(batch, mesh_batch_cache_async_slot_get(cache->async.prev, slot));
+    }
+  }
+
+  cache->async.is_finished = 0;
+  cache->async.task_pool = BLI_task_pool_create(NULL, TASK_PRIORITY_LOW);
+  BLI_task_pool_push(
+      cache->async.task_pool, mesh_batch_cache_async_extract_fn, cache, false, NULL);
+  DRW_viewport_request_redraw();
+}
+
+/**
+ * Wait for a running extraction and bind the new buffers to the batches.
+ * The previous cache is freed.
+ */
+static void mesh_batch_cache_async_finish(MeshBatchCache *cache)
+{
+  if (cache->async.task_pool) {
+    BLI_task_pool_work_and_wait(cache->async.task_pool);
+    BLI_task_pool_free(cache->async.task_pool);
+    cache->async.task_pool = NULL;
+    BLI_task_graph_free(cache->async.task_graph);
+    cache->async.task_graph = NULL;
+
+    const int slot_len = mesh_batch_cache_async_slot_len(cache);
+    for (int slot = 0; slot < slot_len; slot++) {
+      if (cache->async.use_prev[slot]) {
+        GPU_batch_copy(mesh_batch_cache_async_slot_get(cache, slot), &cache->async.bindings[slot]);
+      }
+    }
+  }
+  else if (cache->async.task_graph) {
+    /* Prepared, but nothing to extract. */
+    BLI_task_graph_free(cache->async.task_graph);
+    cache->async.task_graph = NULL;
+  }
+  MEM_SAFE_FREE(cache->async.use_prev);
+  MEM_SAFE_FREE(cache->async.bindings);
+
+  if (cache->async.prev) {
+    DRW_mesh_batch_cache_stash_free(cache->async.prev);
+    cache->async.prev = NULL;
+  }
+}
+
+/**
+ * \return True when the batches of a running extraction keep drawing the previous cache for this
+ * redraw, and no new request needs to be handled.
+ */
+static bool mesh_batch_cache_async_keep(MeshBatchCache *cache)
+{
+  if (cache->async.task_pool == NULL) {
+    return false;
+  }
+  if (!mesh_batch_cache_async_is_finished(cache) && !DRW_state_is_select() &&
+      !DRW_state_is_depth() && !DRW_state_is_image_render()) {
+    bool has_new_request = false;
+    const int slot_len = mesh_batch_cache_async_slot_len(cache);
+    for (int slot = 0; slot < slot_len; slot++) {
+      if (mesh_batch_cache_async_slot_is_requested(cache, slot)) {
+        has_new_request = true;
+        break;
+      }
+    }
+    if (!has_new_request) {
+      DRW_viewport_request_redraw();
+      return true;
+    }
+  }
+  mesh_batch_cache_async_finish(cache);
+  return false;
+}
+
+void *DRW_mesh_batch_cache_stash(Mesh *me, bool is_deform_only)
+{
+  MeshBatchCache *cache = me->runtime.batch_cache;
+  /* The extraction reads the mesh that is about to be freed. */
+  mesh_batch_cache_async_finish(cache);
+  cache->is_stash_deform_only = is_deform_only;
+  me->runtime.batch_cache = NULL;
+  return cache;
+}
+
+/** \} */
+
 void DRW_mesh_batch_cache_validate(Object *object, Mesh *me)
 {
+  MeshBatchCache *cache_prev = NULL;
+  /* Dupli objects are temporary copies that don't own the runtime data. */
+  if ((me->runtime.batch_cache == NULL) && (object->runtime.mesh_batch_cache_prev != NULL) &&
+      (object->base_flag & BASE_FROM_DUPLI) == 0) {
+    cache_prev = mesh_batch_cache_take_deformed(object, me);
+  }
+
   if (!mesh_batch_cache_valid(object, me)) {
     mesh_batch_cache_clear(me);
     mesh_batch_cache_init(object, me);
   }
+
+  if (cache_prev != NULL) {
+    MeshBatchCache *cache = me->runtime.batch_cache;
+    if (USER_EXPERIMENTAL_TEST(&U, use_draw_async_mesh_extraction) &&
+        (cache->async.prev == NULL)) {
+      cache->async.prev = cache_prev;
+    }
+    else {
+      DRW_mesh_batch_cache_stash_free(cache_prev);
+    }
+  }
 }
 
 static MeshBatchCache *mesh_batch_cache_get(Mesh *me)
@@ -1056,6 +1340,7 @@ void DRW_mesh_batch_cache_dirty_tag(Mesh *me, eMeshBatchDirtyMode mode)
   if (cache == NULL) {
     return;
   }
+  mesh_batch_cache_async_finish(cache);
   DRWBatchFlag batch_map;
   switch (mode) {
     case BKE_MESH_BATCH_DIRTY_SELECT:
@@ -1138,12 +1423,9 @@ static void mesh_batch_cache_free_subdiv_cache(MeshBatchCache *cache)
   }
 }
 
-static void mesh_batch_cache_clear(Mesh *me)
+static void mesh_batch_cache_clear_data(MeshBatchCache *cache)
 {
-  MeshBatchCache *cache = me->runtime.batch_cache;
-  if (!cache) {
-    return;
-  }
+  mesh_batch_cache_async_finish(cache);
   FOREACH_MESH_BUFFER_CACHE (cache, mbc) {
     mesh_buffer_cache_clear(mbc);
   }
@@ -1169,12 +1451,27 @@ static void mesh_batch_cache_clear(Mesh *me)
   mesh_batch_cache_free_subdiv_cache(cache);
 }
 
+static void mesh_batch_cache_clear(Mesh *me)
+{
+  MeshBatchCache *cache = me->runtime.batch_cache;
+  if (!cache) {
+    return;
+  }
+  mesh_batch_cache_clear_data(cache);
+}
+
 void DRW_mesh_batch_cache_free(Mesh *me)
 {
   mesh_batch_cache_clear(me);
   MEM_SAFE_FREE(me->runtime.batch_cache);
 }
 
+void DRW_mesh_batch_cache_stash_free(void *batch_cache)
+{
+  mesh_batch_cache_clear_data(batch_cache);
+  MEM_freeN(batch_cache);
+}
+
 /** \} */
 
 /* ---------------------------------------------------------------------- */
@@ -1355,6 +1652,13 @@ int DRW_mesh_material_count_get(const Object *object, const Mesh *me)
   return mesh_render_mat_len_get(object, me);
 }
 
+GPUBatch *DRW_mesh_batch_cache_get_surface_lod(Mesh *me)
+{
+  MeshBatchCache *cache = mesh_batch_cache_get(me);
+  mesh_batch_cache_add_request(cache, MBC_SURFACE_LOD);
+  return DRW_batch_request(&cache->batch.surface_lod);
+}
+
 GPUBatch *DRW_mesh_batch_cache_get_sculpt_overlays(Mesh *me)
 {
   MeshBatchCache *cache = mesh_batch_cache_get(me);
@@ -1575,7 +1879,7 @@ void DRW_mesh_batch_cache_free_old(Mesh *me, int ctime)
 {
   MeshBatchCache *cache = me->runtime.batch_cache;
 
-  if (cache == NULL) {
+  if (cache == NULL || cache->async.task_pool != NULL) {
     return;
   }
 
@@ -1653,6 +1957,22 @@ void DRW_mesh_batch_cache_create_requested(struct TaskGraph *task_graph,
   MeshBatchCache *cache = mesh_batch_cache_get(me);
   bool cd_uv_update = false;
 
+  if (mesh_batch_cache_async_keep(cache)) {
+    cache->batch_requested = 0;
+    return;
+  }
+
+  if (cache->pos_nor_deformed) {
+    cache->pos_nor_deformed = false;
+    GPUVertBuf *pos_nor = cache->final.buff.vbo.pos_nor;
+    if (pos_nor && !extract_pos_nor_update_positions(me, &cache->final.loose_geom, pos_nor)) {
+      FOREACH_MESH_BUFFER_CACHE (cache, mbc) {
+        GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.pos_nor);
+      }
+      mesh_batch_cache_discard_batch(cache, BATCH_MAP(vbo.pos_nor));
+    }
+  }
+
   /* Early out */
   if (cache->batch_requested == 0) {
 #ifdef DEBUG
@@ -1813,6 +2133,15 @@ void DRW_mesh_batch_cache_create_requested(struct TaskGraph *task_graph,
                                                                     is_editmode);
   const bool do_subdivision = BKE_subsurf_modifier_can_do_gpu_subdiv(scene, ob, me, required_mode);
 
+  const bool use_async = mesh_batch_cache_async_poll(cache, ob, me, is_editmode, do_subdivision);
+  if (use_async) {
+    mesh_batch_cache_async_prepare(cache);
+  }
+  else {
+    /* Free the previous cache, it can't be drawn meanwhile. */
+    mesh_batch_cache_async_finish(cache);
+  }
+
   MeshBufferList *mbuflist = &cache->final.buff;
 
   /* Initialize batches and request VBO's & IBO's. */
@@ -1860,6 +2189,12 @@ void DRW_mesh_batch_cache_create_requested(struct TaskGraph *task_graph,
     DRW_vbo_request(cache->batch.sculpt_overlays, &mbuflist->vbo.pos_nor);
     DRW_vbo_request(cache->batch.sculpt_overlays, &mbuflist->vbo.sculpt_data);
   }
+  MDEPS_ASSERT(surface_lod, ibo.tris_lod, vbo.lnor, vbo.pos_nor);
+  if (DRW_batch_requested(cache->batch.surface_lod, GPU_PRIM_TRIS)) {
+    DRW_ibo_request(cache->batch.surface_lod, &mbuflist->ibo.tris_lod);
+    DRW_vbo_request(cache->batch.surface_lod, &mbuflist->vbo.lnor);
+    DRW_vbo_request(cache->batch.surface_lod, &mbuflist->vbo.pos_nor);
+  }
   MDEPS_ASSERT(all_edges, ibo.lines, vbo.pos_nor);
   if (DRW_batch_requested(cache->batch.all_edges, GPU_PRIM_LINES)) {
     DRW_ibo_request(cache->batch.all_edges, &mbuflist->ibo.lines);
@@ -2118,6 +2453,7 @@ void DRW_mesh_batch_cache_create_requested(struct TaskGraph *task_graph,
   MDEPS_ASSERT_MAP(ibo.edituv_lines);
   MDEPS_ASSERT_MAP(ibo.edituv_points);
   MDEPS_ASSERT_MAP(ibo.edituv_fdots);
+  MDEPS_ASSERT_MAP(ibo.tris_lod);
 
   MDEPS_ASSERT_MAP_INDEX(TRIS_PER_MAT_INDEX);
 
@@ -2182,7 +2518,7 @@ void DRW_mesh_batch_cache_create_requested(struct TaskGraph *task_graph,
     mesh_batch_cache_free_subdiv_cache(cache);
   }
 
-  mesh_buffer_cache_create_requested(task_graph,
+  mesh_buffer_cache_create_requested(use_async ? cache->async.task_graph : task_graph,
                                      cache,
                                      &cache->final,
                                      ob,
@@ -2198,13 +2534,21 @@ void DRW_mesh_batch_cache_create_requested(struct TaskGraph *task_graph,
                                      ts,
                                      use_hide);
 
+  if (use_async) {
+    mesh_batch_cache_async_begin(cache);
+    return;
+  }
+
   /* Ensure that all requested batches have finished.
    * Ideally we want to remove this sync, but there are cases where this doesn't work.
    * See T79038 for example.
    *
    * An idea to improve this is to separate the Object mode from the edit mode draw caches. And
    * based on the mode the correct one will be updated. Other option is to look into using
-   * drw_batch_cache_generate_requested_delayed. */
+   * drw_batch_cache_generate_requested_delayed.
+   *
+   * Large meshes outside of edit mode can let the extraction finish after the redraw, see
+   * #mesh_batch_cache_async_begin. */
   BLI_task_graph_work_and_wait(task_graph);
 #ifdef DEBUG
   drw_mesh_batch_cache_check_available(task_graph, me);
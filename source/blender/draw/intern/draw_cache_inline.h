@@ -10,6 +10,8 @@
 #include "GPU_batch.h"
 #include "MEM_guardedalloc.h"
 
+#include "atomic_ops.h"
+
 /* Common */
 // #define DRW_DEBUG_MESH_CACHE_REQUEST
 
@@ -27,9 +29,13 @@
 
 BLI_INLINE GPUBatch *DRW_batch_request(GPUBatch **batch)
 {
-  /* XXX TODO(fclem): We are writing to batch cache here. Need to make this thread safe. */
+  /* Can be called from #DrawEngineType.cache_populate_parallel for objects sharing the same
+   * batch cache, the first thread to publish its batch wins. */
   if (*batch == NULL) {
-    *batch = GPU_batch_calloc();
+    GPUBatch *new_batch = GPU_batch_calloc();
+    if (atomic_cas_ptr((void **)batch, NULL, new_batch) != NULL) {
+      GPU_batch_discard(new_batch);
+    }
   }
   return *batch;
 }
@@ -648,8 +648,12 @@ static void drw_uniform_attribute_lookup(GPUUniformAttr *attr,
     SNPRINTF(idprop_name, "[\"%s\"]", attr_name_esc);
   }
 
-  /* If requesting instance data, check the parent particle system and object. */
+  /* If requesting instance data, check the instance attributes of geometry nodes instances, the
+   * parent particle system and object. */
   if (attr->use_dupli) {
+    if (dupli_source && BKE_object_dupli_find_rgba_attribute(dupli_source, attr->name, r_data)) {
+      return;
+    }
     if (dupli_source && dupli_source->particle_system) {
       ParticleSettings *settings = dupli_source->particle_system->part;
       if (drw_uniform_property_lookup((ID *)settings, idprop_name, r_data) ||
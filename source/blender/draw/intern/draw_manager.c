@@ -43,6 +43,7 @@
 #include "DNA_camera_types.h"
 #include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
+#include "DNA_userdef_types.h"
 #include "DNA_world_types.h"
 #include "draw_manager.h"
 
@@ -371,6 +372,7 @@ static void draw_unit_state_create(void)
 
   /* TODO(fclem): get rid of this. */
   culling->bsphere.radius = -1.0f;
+  culling->skip_occlusion = true;
   culling->user_data = NULL;
 
   DRW_handle_increment(&DST.resource_handle);
@@ -1037,6 +1039,154 @@ static void drw_engines_world_update(Scene *scene)
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Parallel Object Populate
+ *
+ * Engines implementing #DrawEngineType.cache_populate_parallel get the objects that are not
+ * duplis populated from a task pool once the depsgraph iteration is done. The serial part of
+ * #drw_engines_cache_populate (batch cache validation, `id_update` and the engines without a
+ * parallel callback) still runs during the iteration. The recorded draw calls are replayed in
+ * iteration order on the main thread, which keeps resource handles and command order of every
+ * shading group deterministic.
+ * \{ */
+
+#define DRW_PARALLEL_ENGINES_LEN 8
+
+typedef struct DRWPopulateTask {
+  Object *ob;
+  /** Object resource state left by the serial engines. */
+  DRWResourceHandle ob_handle;
+  bool ob_state_obinfo_init;
+  /** Bit per parallel engine that declined the object. */
+  uint declined;
+  DRWObjectCalls calls;
+} DRWPopulateTask;
+
+static struct {
+  ViewportEngineData *engines[DRW_PARALLEL_ENGINES_LEN];
+  int engines_len;
+  DRWPopulateTask *tasks;
+  int tasks_len;
+  int tasks_alloc;
+} g_parallel_populate = {{NULL}};
+
+/**
+ * Enable the parallel populate for the enabled engines that support it. Selection keeps the
+ * serial path since select IDs are loaded between draw calls.
+ */
+static void drw_engines_cache_populate_parallel_begin(void)
+{
+  g_parallel_populate.engines_len = 0;
+  g_parallel_populate.tasks_len = 0;
+
+  if (G.f & G_FLAG_PICKSEL) {
+    return;
+  }
+
+  DRW_ENABLED_ENGINE_ITER (DST.view_data_active, engine, data) {
+    if (engine->cache_populate_parallel &&
+        g_parallel_populate.engines_len < DRW_PARALLEL_ENGINES_LEN) {
+      g_parallel_populate.engines[g_parallel_populate.engines_len++] = data;
+    }
+  }
+}
+
+static bool drw_engine_is_parallel_populated(const ViewportEngineData *data)
+{
+  for (int i = 0; i < g_parallel_populate.engines_len; i++) {
+    if (g_parallel_populate.engines[i] == data) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static void drw_engines_cache_populate_parallel_queue(Object *ob)
+{
+  if (g_parallel_populate.tasks_len == g_parallel_populate.tasks_alloc) {
+    g_parallel_populate.tasks_alloc = max_ii(64, g_parallel_populate.tasks_alloc * 2);
+    g_parallel_populate.tasks = MEM_reallocN(
+        g_parallel_populate.tasks, sizeof(DRWPopulateTask) * g_parallel_populate.tasks_alloc);
+  }
+  DRWPopulateTask *task = &g_parallel_populate.tasks[g_parallel_populate.tasks_len++];
+  task->ob = ob;
+  task->ob_handle = DST.ob_handle;
+  task->ob_state_obinfo_init = DST.ob_state_obinfo_init;
+  task->declined = 0;
+  task->calls.len = 0;
+}
+
+static void drw_engines_cache_populate_parallel_fn(void *__restrict UNUSED(userdata),
+                                                   const int index,
+                                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  DRWPopulateTask *task = &g_parallel_populate.tasks[index];
+
+  for (int i = 0; i < g_parallel_populate.engines_len; i++) {
+    ViewportEngineData *data = g_parallel_populate.engines[i];
+    DrawEngineType *engine = data->engine_type->draw_engine;
+    const int calls_len = task->calls.len;
+    if (!engine->cache_populate_parallel(data, task->ob, &task->calls)) {
+      /* Drop partially recorded calls, the serial callback redoes the whole object. */
+      task->calls.len = calls_len;
+      task->declined |= 1u << i;
+    }
+  }
+}
+
+/** Run the parallel engines on the queued objects and replay their calls in order. */
+static void drw_engines_cache_populate_parallel_end(void)
+{
+  if (g_parallel_populate.tasks_len > 0) {
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 8;
+    BLI_task_parallel_range(0,
+                            g_parallel_populate.tasks_len,
+                            NULL,
+                            drw_engines_cache_populate_parallel_fn,
+                            &settings);
+
+    struct DupliObject *dupli_source = DST.dupli_source;
+    Object *dupli_parent = DST.dupli_parent;
+    DST.dupli_source = NULL;
+    DST.dupli_parent = NULL;
+
+    for (int i = 0; i < g_parallel_populate.tasks_len; i++) {
+      DRWPopulateTask *task = &g_parallel_populate.tasks[i];
+      DST.ob_handle = task->ob_handle;
+      DST.ob_state_obinfo_init = task->ob_state_obinfo_init;
+
+      for (int j = 0; j < task->calls.len; j++) {
+        DRW_shgroup_call_ex(task->calls.calls[j].shgroup,
+                            task->ob,
+                            NULL,
+                            task->calls.calls[j].geom,
+                            false,
+                            NULL);
+      }
+      for (int j = 0; j < g_parallel_populate.engines_len; j++) {
+        if (task->declined & (1u << j)) {
+          ViewportEngineData *data = g_parallel_populate.engines[j];
+          DrawEngineType *engine = data->engine_type->draw_engine;
+          engine->cache_populate(data, task->ob);
+        }
+      }
+      drw_batch_cache_generate_requested(task->ob);
+    }
+
+    DST.dupli_source = dupli_source;
+    DST.dupli_parent = dupli_parent;
+  }
+
+  MEM_SAFE_FREE(g_parallel_populate.tasks);
+  g_parallel_populate.tasks_len = 0;
+  g_parallel_populate.tasks_alloc = 0;
+  g_parallel_populate.engines_len = 0;
+}
+
+/** \} */
+
 static void drw_engines_cache_populate(Object *ob)
 {
   DST.ob_handle = 0;
@@ -1052,16 +1202,28 @@ static void drw_engines_cache_populate(Object *ob)
     drw_batch_cache_validate(ob);
   }
 
+  /* Objects that are not duplis are finished by #drw_engines_cache_populate_parallel_end. */
+  const bool use_parallel = (g_parallel_populate.engines_len > 0) && !DST.dupli_source;
+
   DRW_ENABLED_ENGINE_ITER (DST.view_data_active, engine, data) {
     if (engine->id_update) {
       engine->id_update(data, &ob->id);
     }
 
+    if (use_parallel && drw_engine_is_parallel_populated(data)) {
+      continue;
+    }
+
     if (engine->cache_populate) {
       engine->cache_populate(data, ob);
     }
   }
 
+  if (use_parallel) {
+    drw_engines_cache_populate_parallel_queue(ob);
+    return;
+  }
+
   /* TODO: in the future it would be nice to generate once for all viewports.
    * But we need threaded DRW manager first. */
   if (!DST.dupli_source) {
@@ -1314,6 +1476,7 @@ void DRW_notify_view_update(const DRWUpdateContext *update_ctx)
   int view_count = GPU_viewport_is_stereo_get(viewport) ? 2 : 1;
   for (int view = 0; view < view_count; view++) {
     DST.view_data_active = DST.vmempool->view_data[view];
+    DRW_view_data_occlusion_buffer_get(DST.view_data_active)->is_dirty = true;
 
     drw_engines_enable(view_layer, engine_type, gpencil_engine_needed);
     drw_engines_data_validate();
@@ -1565,6 +1728,126 @@ struct DRWTextStore *DRW_text_cache_ensure(void)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Occlusion Culling
+ *
+ * The depth of a viewport redraw is read back and reduced to a pyramid of farthest depths. The
+ * next redraw culls the objects that are completely behind it from the default view. The depth
+ * is only valid if neither the scene nor the view changed in between, so culling is skipped for
+ * the first redraw after any change and the read-back is skipped when culling was used.
+ * \{ */
+
+static bool drw_occlusion_is_supported(void)
+{
+  const DRWContextState *draw_ctx = &DST.draw_ctx;
+  const View3D *v3d = draw_ctx->v3d;
+  if (!USER_EXPERIMENTAL_TEST(&U, use_draw_occlusion_culling)) {
+    return false;
+  }
+  if (v3d == NULL || draw_ctx->rv3d == NULL || DST.view_default == NULL ||
+      DST.options.is_image_render || DST.options.is_select || DST.options.is_depth) {
+    return false;
+  }
+  /* Shadows are cast by occluded objects too. */
+  return (v3d->shading.type == OB_SOLID) && !XRAY_ENABLED(v3d) &&
+         ((v3d->shading.flag & V3D_SHADING_SHADOW) == 0);
+}
+
+void drw_occlusion_buffer_free(DRWOcclusionBuffer *occlusion)
+{
+  for (int i = 0; i < occlusion->levels_len; i++) {
+    MEM_SAFE_FREE(occlusion->levels[i]);
+  }
+  occlusion->levels_len = 0;
+}
+
+void drw_occlusion_begin(void)
+{
+  DST.occlusion = NULL;
+
+  DRWOcclusionBuffer *occlusion = DRW_view_data_occlusion_buffer_get(DST.view_data_active);
+  if (!drw_occlusion_is_supported()) {
+    drw_occlusion_buffer_free(occlusion);
+    return;
+  }
+
+  const int size[2] = {(int)DST.size[0], (int)DST.size[1]};
+  if (occlusion->levels_len == 0 || occlusion->is_dirty ||
+      !equals_v2v2_int(occlusion->size, size) ||
+      !equals_m4m4(occlusion->persmat, DST.view_default->storage.persmat)) {
+    return;
+  }
+  DST.occlusion = occlusion;
+}
+
+void drw_occlusion_end(void)
+{
+  if (DST.occlusion != NULL || !drw_occlusion_is_supported()) {
+    /* Nothing changed since the depth was read. */
+    return;
+  }
+
+  DRWOcclusionBuffer *occlusion = DRW_view_data_occlusion_buffer_get(DST.view_data_active);
+  DefaultFramebufferList *dfbl = DRW_view_data_default_framebuffer_list_get(
+      DST.view_data_active);
+  drw_occlusion_buffer_free(occlusion);
+
+  const int size[2] = {(int)DST.size[0], (int)DST.size[1]};
+  float *depth = MEM_mallocN(sizeof(float) * size[0] * size[1], __func__);
+  GPU_framebuffer_read_depth(dfbl->depth_only_fb, 0, 0, size[0], size[1], GPU_DATA_FLOAT, depth);
+
+  /* First level: farthest depth of every tile. */
+  int tiles[2] = {divide_ceil_u(size[0], DRW_OCCLUSION_TILE_SIZE),
+                  divide_ceil_u(size[1], DRW_OCCLUSION_TILE_SIZE)};
+  float *level = MEM_mallocN(sizeof(float) * tiles[0] * tiles[1], __func__);
+  for (int ty = 0; ty < tiles[1]; ty++) {
+    for (int tx = 0; tx < tiles[0]; tx++) {
+      const int x_end = min_ii((tx + 1) * DRW_OCCLUSION_TILE_SIZE, size[0]);
+      const int y_end = min_ii((ty + 1) * DRW_OCCLUSION_TILE_SIZE, size[1]);
+      float depth_max = 0.0f;
+      for (int y = ty * DRW_OCCLUSION_TILE_SIZE; y < y_end; y++) {
+        for (int x = tx * DRW_OCCLUSION_TILE_SIZE; x < x_end; x++) {
+          depth_max = max_ff(depth_max, depth[y * size[0] + x]);
+        }
+      }
+      level[ty * tiles[0] + tx] = depth_max;
+    }
+  }
+  MEM_freeN(depth);
+  occlusion->levels[0] = level;
+  copy_v2_v2_int(occlusion->level_size[0], tiles);
+  occlusion->levels_len = 1;
+
+  /* Next levels: farthest depth of 2x2 texels of the previous level. */
+  while (occlusion->levels_len < DRW_OCCLUSION_LEVEL_MAX && (tiles[0] > 1 || tiles[1] > 1)) {
+    const float *prev = occlusion->levels[occlusion->levels_len - 1];
+    const int prev_tiles[2] = {tiles[0], tiles[1]};
+    tiles[0] = divide_ceil_u(tiles[0], 2);
+    tiles[1] = divide_ceil_u(tiles[1], 2);
+    level = MEM_mallocN(sizeof(float) * tiles[0] * tiles[1], __func__);
+    for (int ty = 0; ty < tiles[1]; ty++) {
+      for (int tx = 0; tx < tiles[0]; tx++) {
+        float depth_max = 0.0f;
+        for (int y = ty * 2; y < min_ii(ty * 2 + 2, prev_tiles[1]); y++) {
+          for (int x = tx * 2; x < min_ii(tx * 2 + 2, prev_tiles[0]); x++) {
+            depth_max = max_ff(depth_max, prev[y * prev_tiles[0] + x]);
+          }
+        }
+        level[ty * tiles[0] + tx] = depth_max;
+      }
+    }
+    occlusion->levels[occlusion->levels_len] = level;
+    copy_v2_v2_int(occlusion->level_size[occlusion->levels_len], tiles);
+    occlusion->levels_len++;
+  }
+
+  copy_v2_v2_int(occlusion->size, size);
+  copy_m4_m4(occlusion->persmat, DST.view_default->storage.persmat);
+  occlusion->is_dirty = false;
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Main Draw Loops (DRW_draw)
  * \{ */
@@ -1663,6 +1946,7 @@ void DRW_draw_render_loop_ex(struct Depsgraph *depsgraph,
     if (do_populate_loop) {
       DST.dupli_origin = NULL;
       DST.dupli_origin_data = NULL;
+      drw_engines_cache_populate_parallel_begin();
       DEG_OBJECT_ITER_FOR_RENDER_ENGINE_BEGIN (depsgraph, ob) {
         if ((object_type_exclude_viewport & (1 << ob->type)) != 0) {
           continue;
@@ -1676,6 +1960,7 @@ void DRW_draw_render_loop_ex(struct Depsgraph *depsgraph,
         drw_engines_cache_populate(ob);
       }
       DEG_OBJECT_ITER_FOR_RENDER_ENGINE_END;
+      drw_engines_cache_populate_parallel_end();
     }
 
     drw_duplidata_free();
@@ -1704,8 +1989,12 @@ void DRW_draw_render_loop_ex(struct Depsgraph *depsgraph,
 
   DRW_draw_callbacks_pre_scene();
 
+  drw_occlusion_begin();
+
   drw_engines_draw_scene();
 
+  drw_occlusion_end();
+
   /* Fix 3D view "lagging" on APPLE and WIN32+NVIDIA. (See T56996, T61474) */
   if (GPU_type_matches_ex(GPU_DEVICE_ANY, GPU_OS_ANY, GPU_DRIVER_ANY, GPU_BACKEND_OPENGL)) {
     GPU_flush();
@@ -2591,6 +2880,7 @@ static void drw_draw_depth_loop_impl(struct Depsgraph *depsgraph,
     const int object_type_exclude_viewport = v3d->object_type_exclude_viewport;
     DST.dupli_origin = NULL;
     DST.dupli_origin_data = NULL;
+    drw_engines_cache_populate_parallel_begin();
     DEG_OBJECT_ITER_FOR_RENDER_ENGINE_BEGIN (DST.draw_ctx.depsgraph, ob) {
       if ((object_type_exclude_viewport & (1 << ob->type)) != 0) {
         continue;
@@ -2604,6 +2894,7 @@ static void drw_draw_depth_loop_impl(struct Depsgraph *depsgraph,
       drw_engines_cache_populate(ob);
     }
     DEG_OBJECT_ITER_FOR_RENDER_ENGINE_END;
+    drw_engines_cache_populate_parallel_end();
 
     drw_duplidata_free();
     drw_engines_cache_finish();
@@ -2947,6 +3238,8 @@ void DRW_engines_register(void)
 
     BKE_mesh_batch_cache_dirty_tag_cb = DRW_mesh_batch_cache_dirty_tag;
     BKE_mesh_batch_cache_free_cb = DRW_mesh_batch_cache_free;
+    BKE_mesh_batch_cache_stash_cb = DRW_mesh_batch_cache_stash;
+    BKE_mesh_batch_cache_stash_free_cb = DRW_mesh_batch_cache_stash_free;
 
     BKE_lattice_batch_cache_dirty_tag_cb = DRW_lattice_batch_cache_dirty_tag;
     BKE_lattice_batch_cache_free_cb = DRW_lattice_batch_cache_free;
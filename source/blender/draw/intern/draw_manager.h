@@ -105,10 +105,32 @@ typedef struct DRWCullingState {
   /* Culling: Using Bounding Sphere for now for faster culling.
    * Not ideal for planes. Could be extended. */
   BoundSphere bsphere;
+  /** Drawn on top of other objects, see #DRWOcclusionBuffer. */
+  bool skip_occlusion;
   /* Grrr only used by EEVEE. */
   void *user_data;
 } DRWCullingState;
 
+/** Size in pixels of the tiles of the first level of #DRWOcclusionBuffer. */
+#define DRW_OCCLUSION_TILE_SIZE 8
+#define DRW_OCCLUSION_LEVEL_MAX 10
+
+/**
+ * Depth pyramid of the previous redraw of a viewport, used to cull objects that were hidden by
+ * other objects from the default view. Every texel stores the farthest depth of its area.
+ */
+typedef struct DRWOcclusionBuffer {
+  float *levels[DRW_OCCLUSION_LEVEL_MAX];
+  int level_size[DRW_OCCLUSION_LEVEL_MAX][2];
+  int levels_len;
+  /** Size of the viewport the depth was read from. */
+  int size[2];
+  /** View projection matrix the depth was rendered with. */
+  float persmat[4][4];
+  /** The scene changed since the depth was read, another redraw is needed to be accurate. */
+  bool is_dirty;
+} DRWOcclusionBuffer;
+
 /* Minimum max UBO size is 64KiB. We take the largest
  * UBO struct and alloc the max number.
  * `((1 << 16) / sizeof(DRWObjectMatrix)) = 512`
@@ -303,6 +325,17 @@ struct DRWCallBuffer {
   int count;
 };
 
+#define DRW_OBJECT_CALLS_LEN 8
+
+/** Draw calls recorded by #DrawEngineType.cache_populate_parallel for one object. */
+struct DRWObjectCalls {
+  int len;
+  struct {
+    DRWShadingGroup *shgroup;
+    GPUBatch *geom;
+  } calls[DRW_OBJECT_CALLS_LEN];
+};
+
 /** Used by #DRWUniform.type */
 /* TODO(@jbakker): rename to DRW_RESOURCE/DRWResourceType. */
 typedef enum {
@@ -587,6 +620,8 @@ typedef struct DRWManager {
   /* Per viewport */
   GPUViewport *viewport;
   struct GPUFrameBuffer *default_framebuffer;
+  /** Occlusion buffer used to cull objects in this redraw, NULL if disabled. */
+  DRWOcclusionBuffer *occlusion;
   float size[2];
   float inv_size[2];
   float screenvecs[2][3];
@@ -671,6 +706,15 @@ void drw_batch_cache_generate_requested_evaluated_mesh(Object *ob);
 
 void drw_resource_buffer_finish(DRWData *vmempool);
 
+/**
+ * Use the occlusion buffer of the active view data for the culling of the default view, when
+ * enabled for this redraw.
+ */
+void drw_occlusion_begin(void);
+/** Update the occlusion buffer from the depth of the default frame-buffer. */
+void drw_occlusion_end(void);
+void drw_occlusion_buffer_free(DRWOcclusionBuffer *occlusion);
+
 /* Procedural Drawing */
 GPUBatch *drw_cache_procedural_points_get(void);
 GPUBatch *drw_cache_procedural_lines_get(void);
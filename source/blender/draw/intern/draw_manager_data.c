@@ -656,6 +656,8 @@ static void drw_call_culling_init(DRWCullingState *cull, Object *ob)
     /* Bypass test. */
     cull->bsphere.radius = -1.0f;
   }
+  cull->skip_occlusion = (ob == NULL) || (ob->dtx & OB_DRAW_IN_FRONT) ||
+                        (ob->mode != OB_MODE_OBJECT);
   /* Reset user data */
   cull->user_data = NULL;
 }
@@ -926,6 +928,18 @@ void DRW_shgroup_call_ex(DRWShadingGroup *shgroup,
   }
 }
 
+bool DRW_object_calls_add(DRWObjectCalls *calls, DRWShadingGroup *shgroup, struct GPUBatch *geom)
+{
+  BLI_assert(geom != NULL);
+  if (calls->len == DRW_OBJECT_CALLS_LEN) {
+    return false;
+  }
+  calls->calls[calls->len].shgroup = shgroup;
+  calls->calls[calls->len].geom = geom;
+  calls->len++;
+  return true;
+}
+
 void DRW_shgroup_call_range(
     DRWShadingGroup *shgroup, struct Object *ob, GPUBatch *geom, uint v_sta, uint v_ct)
 {
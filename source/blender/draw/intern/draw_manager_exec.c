@@ -11,6 +11,7 @@
 #include "BLI_math.h"
 #include "BLI_math_bits.h"
 #include "BLI_memblock.h"
+#include "BLI_task.h"
 
 #include "BKE_global.h"
 
@@ -461,48 +462,133 @@ void DRW_culling_frustum_planes_get(const DRWView *view, float planes[6][4])
   memcpy(planes, view->frustum_planes, sizeof(float[6][4]));
 }
 
-static void draw_compute_culling(DRWView *view)
+/* Return true if the bounding sphere is completely behind the depth of the previous redraw. */
+static bool draw_occlusion_test(const DRWOcclusionBuffer *occlusion, const BoundSphere *bsphere)
 {
-  view = view->parent ? view->parent : view;
+  float rect_min[2] = {FLT_MAX, FLT_MAX}, rect_max[2] = {-FLT_MAX, -FLT_MAX};
+  float depth_min = FLT_MAX;
+  for (int i = 0; i < 8; i++) {
+    const float co[3] = {
+        bsphere->center[0] + ((i & 1) ? bsphere->radius : -bsphere->radius),
+        bsphere->center[1] + ((i & 2) ? bsphere->radius : -bsphere->radius),
+        bsphere->center[2] + ((i & 4) ? bsphere->radius : -bsphere->radius),
+    };
+    float co_clip[4];
+    mul_v4_m4v3(co_clip, occlusion->persmat, co);
+    if (co_clip[3] <= 0.0f) {
+      /* Crosses the camera plane. */
+      return false;
+    }
+    for (int axis = 0; axis < 2; axis++) {
+      const float co_px = (co_clip[axis] / co_clip[3] * 0.5f + 0.5f) * occlusion->size[axis];
+      rect_min[axis] = min_ff(rect_min[axis], co_px);
+      rect_max[axis] = max_ff(rect_max[axis], co_px);
+    }
+    depth_min = min_ff(depth_min, co_clip[2] / co_clip[3] * 0.5f + 0.5f);
+  }
 
-  /* TODO(fclem): multi-thread this. */
-  /* TODO(fclem): compute all dirty views at once. */
-  if (!view->is_dirty) {
-    return;
+  if (depth_min <= 0.0f) {
+    return false;
   }
 
-  BLI_memblock_iter iter;
-  BLI_memblock_iternew(DST.vmempool->cullstates, &iter);
-  DRWCullingState *cull;
-  while ((cull = BLI_memblock_iterstep(&iter))) {
-    if (cull->bsphere.radius < 0.0) {
-      cull->mask = 0;
+  /* Use the level where the rectangle spans at most 2x2 texels. */
+  const float extent = max_ff(rect_max[0] - rect_min[0], rect_max[1] - rect_min[1]);
+  int level = 0;
+  while (level < occlusion->levels_len - 1 &&
+         extent > (float)(DRW_OCCLUSION_TILE_SIZE << level) * 2.0f) {
+    level++;
+  }
+
+  const int *level_size = occlusion->level_size[level];
+  const float texel_size = (float)(DRW_OCCLUSION_TILE_SIZE << level);
+  const int x_min = max_ii((int)floorf(rect_min[0] / texel_size), 0);
+  const int y_min = max_ii((int)floorf(rect_min[1] / texel_size), 0);
+  const int x_max = min_ii((int)floorf(rect_max[0] / texel_size), level_size[0] - 1);
+  const int y_max = min_ii((int)floorf(rect_max[1] / texel_size), level_size[1] - 1);
+  const float *depth = occlusion->levels[level];
+  for (int y = y_min; y <= y_max; y++) {
+    for (int x = x_min; x <= x_max; x++) {
+      if (depth[y * level_size[0] + x] >= depth_min) {
+        return false;
+      }
     }
-    else {
-      bool culled = !draw_culling_sphere_test(
-          &view->frustum_bsphere, view->frustum_planes, &cull->bsphere);
+  }
+  /* Objects outside of the view are left to frustum culling. */
+  return (x_min <= x_max) && (y_min <= y_max);
+}
+
+static void draw_compute_culling_state(DRWView *view, DRWCullingState *cull)
+{
+  if (cull->bsphere.radius < 0.0) {
+    cull->mask = 0;
+  }
+  else {
+    bool culled = !draw_culling_sphere_test(
+        &view->frustum_bsphere, view->frustum_planes, &cull->bsphere);
 
 #ifdef DRW_DEBUG_CULLING
-      if (G.debug_value != 0) {
-        if (culled) {
-          DRW_debug_sphere(
-              cull->bsphere.center, cull->bsphere.radius, (const float[4]){1, 0, 0, 1});
-        }
-        else {
-          DRW_debug_sphere(
-              cull->bsphere.center, cull->bsphere.radius, (const float[4]){0, 1, 0, 1});
-        }
+    if (G.debug_value != 0) {
+      if (culled) {
+        DRW_debug_sphere(
+            cull->bsphere.center, cull->bsphere.radius, (const float[4]){1, 0, 0, 1});
       }
+      else {
+        DRW_debug_sphere(
+            cull->bsphere.center, cull->bsphere.radius, (const float[4]){0, 1, 0, 1});
+      }
+    }
 #endif
 
-      if (view->visibility_fn) {
-        culled = !view->visibility_fn(!culled, cull->user_data);
-      }
+    if (!culled && !cull->skip_occlusion && DST.occlusion && view == DST.view_default) {
+      culled = draw_occlusion_test(DST.occlusion, &cull->bsphere);
+    }
 
-      SET_FLAG_FROM_TEST(cull->mask, culled, view->culling_mask);
+    if (view->visibility_fn) {
+      culled = !view->visibility_fn(!culled, cull->user_data);
     }
+
+    SET_FLAG_FROM_TEST(cull->mask, culled, view->culling_mask);
+  }
+}
+
+static void draw_compute_culling_chunk(void *__restrict userdata,
+                                       const int chunk,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  DRWView *view = (DRWView *)userdata;
+  /* Culling states are allocated together with the resource handles. */
+  const int resource_len = (int)DST.resource_handle;
+  const int elem_len = min_ii(DRW_RESOURCE_CHUNK_LEN,
+                              resource_len - chunk * DRW_RESOURCE_CHUNK_LEN);
+
+  DRWCullingState *cull = BLI_memblock_elem_get(DST.vmempool->cullstates, chunk, 0);
+  for (int i = 0; i < elem_len; i++) {
+    draw_compute_culling_state(view, &cull[i]);
+  }
+}
+
+static void draw_compute_culling(DRWView *view)
+{
+  view = view->parent ? view->parent : view;
+
+  /* TODO(fclem): compute all dirty views at once. */
+  if (!view->is_dirty) {
+    return;
   }
 
+  const int resource_len = (int)DST.resource_handle;
+  const int chunk_len = (resource_len + DRW_RESOURCE_CHUNK_LEN - 1) / DRW_RESOURCE_CHUNK_LEN;
+
+  /* Every chunk of culling states is processed by a single task. The visibility callback and
+   * debug drawing are not thread safe. */
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (view->visibility_fn == NULL);
+#ifdef DRW_DEBUG_CULLING
+  settings.use_threading = false;
+#endif
+  BLI_task_parallel_range(0, chunk_len, view, draw_compute_culling_chunk, &settings);
+
   view->is_dirty = false;
 }
 
@@ -30,7 +30,8 @@
 #define GPU_TIMER_FALLOFF 0.1
 
 typedef struct DRWTimer {
-  uint32_t query[2];
+  /** Index of the query in the timer queries of the current and previous redraw, -1 if none. */
+  int query_index[2];
   uint64_t time_average;
   char name[MAX_TIMER_NAME];
   int lvl;       /* Hierarchy level for nested timer. */
@@ -39,6 +40,9 @@ typedef struct DRWTimer {
 
 static struct DRWTimerPool {
   DRWTimer *timers;
+  /** GPU timer queries of the current and previous redraw, and their number. */
+  GPUDebugTimers *queries[2];
+  int queries_len[2];
   int chunk_count;     /* Number of chunk allocated. */
   int timer_count;     /* chunk_count * CHUNK_SIZE */
   int timer_increment; /* Keep track of where we are in the stack. */
@@ -50,13 +54,24 @@ static struct DRWTimerPool {
 void DRW_stats_free(void)
 {
   if (DTP.timers != NULL) {
-    // for (int i = 0; i < DTP.timer_count; i++) {
-    // DRWTimer *timer = &DTP.timers[i];
-    // glDeleteQueries(2, timer->query);
-    // }
     MEM_freeN(DTP.timers);
     DTP.timers = NULL;
   }
+  for (int i = 0; i < 2; i++) {
+    if (DTP.queries[i] != NULL) {
+      GPU_debug_timers_free(DTP.queries[i]);
+      DTP.queries[i] = NULL;
+    }
+    DTP.queries_len[i] = 0;
+  }
+}
+
+static void drw_stats_timers_init(int start, int end)
+{
+  for (int i = start; i < end; i++) {
+    DTP.timers[i].query_index[0] = -1;
+    DTP.timers[i].query_index[1] = -1;
+  }
 }
 
 void DRW_stats_begin(void)
@@ -69,11 +84,17 @@ void DRW_stats_begin(void)
     DTP.chunk_count = 1;
     DTP.timer_count = DTP.chunk_count * MIM_RANGE_LEN;
     DTP.timers = MEM_callocN(sizeof(DRWTimer) * DTP.timer_count, "DRWTimer stack");
+    drw_stats_timers_init(0, DTP.timer_count);
   }
   else if (!DTP.is_recording && DTP.timers != NULL) {
     DRW_stats_free();
   }
 
+  if (DTP.is_recording && DTP.queries[0] == NULL) {
+    DTP.queries[0] = GPU_debug_timers_create();
+    DTP.queries_len[0] = 0;
+  }
+
   DTP.is_querying = false;
   DTP.timer_increment = 0;
   DTP.end_increment = 0;
@@ -83,9 +104,11 @@ static DRWTimer *drw_stats_timer_get(void)
 {
   if (UNLIKELY(DTP.timer_increment >= DTP.timer_count)) {
     /* Resize the stack. */
+    const int prev_timer_count = DTP.timer_count;
     DTP.chunk_count++;
     DTP.timer_count = DTP.chunk_count * MIM_RANGE_LEN;
     DTP.timers = MEM_recallocN(DTP.timers, sizeof(DRWTimer) * DTP.timer_count);
+    drw_stats_timers_init(prev_timer_count, DTP.timer_count);
   }
 
   return &DTP.timers[DTP.timer_increment++];
@@ -101,14 +124,13 @@ static void drw_stats_timer_start_ex(const char *name, const bool is_query)
 
     /* Queries cannot be nested or interleaved. */
     BLI_assert(!DTP.is_querying);
+    timer->query_index[0] = -1;
     if (timer->is_query) {
-      if (timer->query[0] == 0) {
-        // glGenQueries(1, timer->query);
+      /* Issue query, the result is read during the next redraw. */
+      if (DTP.queries[0] != NULL) {
+        GPU_debug_timers_begin(DTP.queries[0]);
+        timer->query_index[0] = DTP.queries_len[0]++;
       }
-
-      // glFinish();
-      /* Issue query for the next frame */
-      // glBeginQuery(GL_TIME_ELAPSED, timer->query[0]);
       DTP.is_querying = true;
     }
   }
@@ -142,7 +164,9 @@ void DRW_stats_query_end(void)
   if (DTP.is_recording) {
     DTP.end_increment++;
     BLI_assert(DTP.is_querying);
-    // glEndQuery(GL_TIME_ELAPSED);
+    if (DTP.queries[0] != NULL) {
+      GPU_debug_timers_end(DTP.queries[0]);
+    }
     DTP.is_querying = false;
   }
 }
@@ -157,17 +181,32 @@ void DRW_stats_reset(void)
   if (DTP.is_recording) {
     uint64_t lvl_time[MAX_NESTED_TIMER] = {0};
 
+    /* Keep the queries of this frame for the next one, and read the results of the previous frame
+     * which are most likely available already. */
+    SWAP(GPUDebugTimers *, DTP.queries[0], DTP.queries[1]);
+    SWAP(int, DTP.queries_len[0], DTP.queries_len[1]);
+    uint64_t *query_times = NULL;
+    if (DTP.queries[0] != NULL) {
+      if (DTP.queries_len[0] > 0) {
+        query_times = MEM_mallocN(sizeof(*query_times) * DTP.queries_len[0], __func__);
+        GPU_debug_timers_result_get(DTP.queries[0], query_times, DTP.queries_len[0]);
+      }
+      GPU_debug_timers_free(DTP.queries[0]);
+      DTP.queries[0] = NULL;
+    }
+
     /* Swap queries for the next frame and sum up each lvl time. */
     for (int i = DTP.timer_increment - 1; i >= 0; i--) {
       DRWTimer *timer = &DTP.timers[i];
-      SWAP(uint32_t, timer->query[0], timer->query[1]);
+      SWAP(int, timer->query_index[0], timer->query_index[1]);
 
       BLI_assert(timer->lvl < MAX_NESTED_TIMER);
 
       if (timer->is_query) {
         uint64_t time = 0;
-        if (timer->query[0] != 0) {
-          // glGetQueryObjectui64v(timer->query[0], GL_QUERY_RESULT, &time);
+        if (query_times != NULL && timer->query_index[0] != -1 &&
+            timer->query_index[0] < DTP.queries_len[0]) {
+          time = query_times[timer->query_index[0]];
         }
         else {
           time = 1000000000; /* 1ms default */
@@ -185,6 +224,9 @@ void DRW_stats_reset(void)
       lvl_time[timer->lvl] += timer->time_average;
     }
 
+    MEM_SAFE_FREE(query_times);
+    DTP.queries_len[0] = 0;
+
     DTP.is_recording = false;
   }
 }
@@ -11,6 +11,7 @@
 
 #include "BLI_dynstr.h"
 #include "BLI_listbase.h"
+#include "BLI_math_base.h"
 #include "BLI_string_utils.h"
 #include "BLI_threads.h"
 
@@ -54,19 +55,36 @@ typedef struct DRWDeferredShader {
   GPUMaterial *mat;
 } DRWDeferredShader;
 
+/* Maximum number of contexts used to compile shaders in parallel. Each context has its own
+ * compilation thread. */
+#define DRW_DEFERRED_COMPILATION_MAX_CONTEXTS 4
+
+typedef struct DRWShaderCompilerContext {
+  void *gl_context;
+  GPUContext *gpu_context;
+
+  DRWDeferredShader *mat_compiling;
+  ThreadMutex compilation_lock;
+
+  /* Compiler using this context, for the compilation thread. */
+  struct DRWShaderCompiler *comp;
+} DRWShaderCompilerContext;
+
 typedef struct DRWShaderCompiler {
   ListBase queue;          /* DRWDeferredShader */
   ListBase queue_conclude; /* DRWDeferredShader */
   SpinLock list_lock;
 
-  DRWDeferredShader *mat_compiling;
-  ThreadMutex compilation_lock;
-
-  void *gl_context;
-  GPUContext *gpu_context;
+  DRWShaderCompilerContext contexts[DRW_DEFERRED_COMPILATION_MAX_CONTEXTS];
+  int contexts_num;
   bool own_context;
 
   int shaders_done; /* To compute progress. */
+
+  /* Job state, shared by the compilation threads. */
+  short *stop;
+  short *do_update;
+  float *progress;
 } DRWShaderCompiler;
 
 static void drw_deferred_shader_free(DRWDeferredShader *dsh)
@@ -83,35 +101,21 @@ static void drw_deferred_shader_queue_free(ListBase *queue)
   }
 }
 
-static void drw_deferred_shader_compilation_exec(
-    void *custom_data,
-    /* Cannot be const, this function implements wm_jobs_start_callback.
-     * NOLINTNEXTLINE: readability-non-const-parameter. */
-    short *stop,
-    short *do_update,
-    float *progress)
+static void *drw_deferred_shader_compilation_thread(void *data)
 {
-  GPU_render_begin();
-  DRWShaderCompiler *comp = (DRWShaderCompiler *)custom_data;
-  void *gl_context = comp->gl_context;
-  GPUContext *gpu_context = comp->gpu_context;
+  DRWShaderCompilerContext *context = (DRWShaderCompilerContext *)data;
+  DRWShaderCompiler *comp = context->comp;
 
-  BLI_assert(gl_context != NULL);
-  BLI_assert(gpu_context != NULL);
+  BLI_assert(context->gl_context != NULL);
+  BLI_assert(context->gpu_context != NULL);
 
-  const bool use_main_context_workaround = GPU_use_main_context_workaround();
-  if (use_main_context_workaround) {
-    BLI_assert(gl_context == DST.gl_context);
-    GPU_context_main_lock();
-  }
-
-  WM_opengl_context_activate(gl_context);
-  GPU_context_active_set(gpu_context);
+  WM_opengl_context_activate(context->gl_context);
+  GPU_context_active_set(context->gpu_context);
 
   while (true) {
     BLI_spin_lock(&comp->list_lock);
 
-    if (*stop != 0) {
+    if (*comp->stop != 0) {
       /* We don't want user to be able to cancel the compilation
        * but wm can kill the task if we are closing blender. */
       BLI_spin_unlock(&comp->list_lock);
@@ -120,8 +124,8 @@ static void drw_deferred_shader_compilation_exec(
 
     /* Pop tail because it will be less likely to lock the main thread
      * if all GPUMaterials are to be freed (see DRW_deferred_shader_remove()). */
-    comp->mat_compiling = BLI_poptail(&comp->queue);
-    if (comp->mat_compiling == NULL) {
+    context->mat_compiling = BLI_poptail(&comp->queue);
+    if (context->mat_compiling == NULL) {
       /* No more Shader to compile. */
       BLI_spin_unlock(&comp->list_lock);
       break;
@@ -130,33 +134,74 @@ static void drw_deferred_shader_compilation_exec(
     comp->shaders_done++;
     int total = BLI_listbase_count(&comp->queue) + comp->shaders_done;
 
-    BLI_mutex_lock(&comp->compilation_lock);
+    BLI_mutex_lock(&context->compilation_lock);
     BLI_spin_unlock(&comp->list_lock);
 
     /* Do the compilation. */
-    GPU_material_compile(comp->mat_compiling->mat);
+    GPU_material_compile(context->mat_compiling->mat);
 
-    *progress = (float)comp->shaders_done / (float)total;
-    *do_update = true;
+    *comp->progress = (float)comp->shaders_done / (float)total;
+    *comp->do_update = true;
 
     if (GPU_type_matches_ex(GPU_DEVICE_ANY, GPU_OS_ANY, GPU_DRIVER_ANY, GPU_BACKEND_OPENGL)) {
       GPU_flush();
     }
-    BLI_mutex_unlock(&comp->compilation_lock);
+    BLI_mutex_unlock(&context->compilation_lock);
 
     BLI_spin_lock(&comp->list_lock);
-    if (GPU_material_status(comp->mat_compiling->mat) == GPU_MAT_QUEUED) {
-      BLI_addtail(&comp->queue_conclude, comp->mat_compiling);
+    if (GPU_material_status(context->mat_compiling->mat) == GPU_MAT_QUEUED) {
+      BLI_addtail(&comp->queue_conclude, context->mat_compiling);
     }
     else {
-      drw_deferred_shader_free(comp->mat_compiling);
+      drw_deferred_shader_free(context->mat_compiling);
     }
-    comp->mat_compiling = NULL;
+    context->mat_compiling = NULL;
     BLI_spin_unlock(&comp->list_lock);
   }
 
   GPU_context_active_set(NULL);
-  WM_opengl_context_release(gl_context);
+  WM_opengl_context_release(context->gl_context);
+
+  return NULL;
+}
+
+static void drw_deferred_shader_compilation_exec(
+    void *custom_data,
+    /* Cannot be const, this function implements wm_jobs_start_callback.
+     * NOLINTNEXTLINE: readability-non-const-parameter. */
+    short *stop,
+    short *do_update,
+    float *progress)
+{
+  GPU_render_begin();
+  DRWShaderCompiler *comp = (DRWShaderCompiler *)custom_data;
+
+  BLI_assert(comp->contexts_num > 0);
+
+  const bool use_main_context_workaround = GPU_use_main_context_workaround();
+  if (use_main_context_workaround) {
+    BLI_assert(comp->contexts_num == 1 && comp->contexts[0].gl_context == DST.gl_context);
+    GPU_context_main_lock();
+  }
+
+  comp->stop = stop;
+  comp->do_update = do_update;
+  comp->progress = progress;
+
+  if (comp->contexts_num == 1) {
+    drw_deferred_shader_compilation_thread(&comp->contexts[0]);
+  }
+  else {
+    /* Every context compiles from the shared queue on its own thread, so that materials are
+     * compiled in parallel. */
+    ListBase threads;
+    BLI_threadpool_init(&threads, drw_deferred_shader_compilation_thread, comp->contexts_num);
+    for (int i = 0; i < comp->contexts_num; i++) {
+      BLI_threadpool_insert(&threads, &comp->contexts[i]);
+    }
+    BLI_threadpool_end(&threads);
+  }
+
   if (use_main_context_workaround) {
     GPU_context_main_unlock();
   }
@@ -181,14 +226,19 @@ static void drw_deferred_shader_compilation_free(void *custom_data)
   }
 
   BLI_spin_end(&comp->list_lock);
-  BLI_mutex_end(&comp->compilation_lock);
+  for (int i = 0; i < DRW_DEFERRED_COMPILATION_MAX_CONTEXTS; i++) {
+    BLI_mutex_end(&comp->contexts[i].compilation_lock);
+  }
 
   if (comp->own_context) {
-    /* Only destroy if the job owns the context. */
-    WM_opengl_context_activate(comp->gl_context);
-    GPU_context_active_set(comp->gpu_context);
-    GPU_context_discard(comp->gpu_context);
-    WM_opengl_context_dispose(comp->gl_context);
+    /* Only destroy if the job owns the contexts. */
+    for (int i = 0; i < comp->contexts_num; i++) {
+      DRWShaderCompilerContext *context = &comp->contexts[i];
+      WM_opengl_context_activate(context->gl_context);
+      GPU_context_active_set(context->gpu_context);
+      GPU_context_discard(context->gpu_context);
+      WM_opengl_context_dispose(context->gl_context);
+    }
 
     wm_window_reset_drawable();
   }
@@ -231,16 +281,22 @@ static void drw_deferred_shader_add(GPUMaterial *mat, bool deferred)
 
   DRWShaderCompiler *comp = MEM_callocN(sizeof(DRWShaderCompiler), "DRWShaderCompiler");
   BLI_spin_init(&comp->list_lock);
-  BLI_mutex_init(&comp->compilation_lock);
+  for (int i = 0; i < DRW_DEFERRED_COMPILATION_MAX_CONTEXTS; i++) {
+    comp->contexts[i].comp = comp;
+    BLI_mutex_init(&comp->contexts[i].compilation_lock);
+  }
 
   if (old_comp) {
     BLI_spin_lock(&old_comp->list_lock);
     BLI_movelisttolist(&comp->queue, &old_comp->queue);
     BLI_spin_unlock(&old_comp->list_lock);
-    /* Do not recreate context, just pass ownership. */
-    if (old_comp->gl_context) {
-      comp->gl_context = old_comp->gl_context;
-      comp->gpu_context = old_comp->gpu_context;
+    /* Do not recreate contexts, just pass ownership. */
+    if (old_comp->contexts_num > 0) {
+      for (int i = 0; i < old_comp->contexts_num; i++) {
+        comp->contexts[i].gl_context = old_comp->contexts[i].gl_context;
+        comp->contexts[i].gpu_context = old_comp->contexts[i].gpu_context;
+      }
+      comp->contexts_num = old_comp->contexts_num;
       old_comp->own_context = false;
       comp->own_context = job_own_context;
     }
@@ -248,16 +304,22 @@ static void drw_deferred_shader_add(GPUMaterial *mat, bool deferred)
 
   BLI_addtail(&comp->queue, dsh);
 
-  /* Create only one context. */
-  if (comp->gl_context == NULL) {
+  /* Create the contexts only once. */
+  if (comp->contexts_num == 0) {
     if (use_main_context) {
-      comp->gl_context = DST.gl_context;
-      comp->gpu_context = DST.gpu_context;
+      comp->contexts[0].gl_context = DST.gl_context;
+      comp->contexts[0].gpu_context = DST.gpu_context;
+      comp->contexts_num = 1;
     }
     else {
-      comp->gl_context = WM_opengl_context_create();
-      comp->gpu_context = GPU_context_create(NULL);
-      GPU_context_active_set(NULL);
+      /* Leave threads for drawing and the rest of Blender. */
+      comp->contexts_num = clamp_i(
+          BLI_system_thread_count() / 2, 1, DRW_DEFERRED_COMPILATION_MAX_CONTEXTS);
+      for (int i = 0; i < comp->contexts_num; i++) {
+        comp->contexts[i].gl_context = WM_opengl_context_create();
+        comp->contexts[i].gpu_context = GPU_context_create(NULL);
+        GPU_context_active_set(NULL);
+      }
 
       WM_opengl_context_activate(DST.gl_context);
       GPU_context_active_set(DST.gpu_context);
@@ -299,9 +361,12 @@ void DRW_deferred_shader_remove(GPUMaterial *mat)
         }
 
         /* Wait for compilation to finish */
-        if ((comp->mat_compiling != NULL) && (comp->mat_compiling->mat == mat)) {
-          BLI_mutex_lock(&comp->compilation_lock);
-          BLI_mutex_unlock(&comp->compilation_lock);
+        for (int i = 0; i < comp->contexts_num; i++) {
+          DRWShaderCompilerContext *context = &comp->contexts[i];
+          if ((context->mat_compiling != NULL) && (context->mat_compiling->mat == mat)) {
+            BLI_mutex_lock(&context->compilation_lock);
+            BLI_mutex_unlock(&context->compilation_lock);
+          }
         }
 
         BLI_spin_unlock(&comp->list_lock);
@@ -31,6 +31,8 @@ struct DRWViewData {
 
   double cache_time = 0.0;
 
+  DRWOcclusionBuffer occlusion = {};
+
   Vector<ViewportEngineData> engines;
   Vector<ViewportEngineData *> enabled_engines;
 };
@@ -147,6 +149,7 @@ static void draw_view_data_clear(DRWViewData *view_data)
 void DRW_view_data_free(DRWViewData *view_data)
 {
   draw_view_data_clear(view_data);
+  drw_occlusion_buffer_free(&view_data->occlusion);
   delete view_data;
 }
 
@@ -215,6 +218,11 @@ DefaultTextureList *DRW_view_data_default_texture_list_get(DRWViewData *view_dat
   return &view_data->dtxl;
 }
 
+DRWOcclusionBuffer *DRW_view_data_occlusion_buffer_get(DRWViewData *view_data)
+{
+  return &view_data->occlusion;
+}
+
 void DRW_view_data_enabled_engine_iter_begin(DRWEngineIterator *iterator, DRWViewData *view_data)
 {
   iterator->id = 0;
@@ -110,6 +110,7 @@ void DRW_view_data_free_unused(DRWViewData *view_data);
 double *DRW_view_data_cache_time_get(DRWViewData *view_data);
 DefaultFramebufferList *DRW_view_data_default_framebuffer_list_get(DRWViewData *view_data);
 DefaultTextureList *DRW_view_data_default_texture_list_get(DRWViewData *view_data);
+struct DRWOcclusionBuffer *DRW_view_data_occlusion_buffer_get(DRWViewData *view_data);
 
 typedef struct DRWEngineIterator {
   int id, end;
@@ -84,7 +84,7 @@ typedef struct MeshRenderData {
   BMFace *efa_act;
   BMFace *efa_act_uv;
   /* Data created on-demand (usually not for #BMesh based data). */
-  MLoopTri *mlooptri;
+  const MLoopTri *mlooptri;
   const float (*vert_normals)[3];
   const float (*poly_normals)[3];
   float (*loop_normals)[3];
@@ -320,6 +320,7 @@ void mesh_render_data_loop_edge_flag(const MeshRenderData *mr,
 
 extern const MeshExtract extract_tris;
 extern const MeshExtract extract_tris_single_mat;
+extern const MeshExtract extract_tris_lod;
 extern const MeshExtract extract_lines;
 extern const MeshExtract extract_lines_with_lines_loose;
 extern const MeshExtract extract_lines_loose_only;
@@ -360,6 +361,14 @@ extern const MeshExtract extract_vert_idx;
 extern const MeshExtract extract_fdot_idx;
 extern const MeshExtract extract_attr[GPU_MAX_ATTR];
 
+/**
+ * Refill the already uploaded `pos_nor` buffer of a mesh whose topology did not change since the
+ * buffer was extracted. Returns false when the buffer can't be updated in place.
+ */
+bool extract_pos_nor_update_positions(const Mesh *me,
+                                      const MeshExtractLooseGeom *loose_geom,
+                                      GPUVertBuf *vbo);
+
 #ifdef __cplusplus
 }
 #endif
@@ -5,8 +5,15 @@
  * \ingroup draw
  */
 
+#include <algorithm>
+
 #include "MEM_guardedalloc.h"
 
+#include "BLI_math_geom.h"
+#include "BLI_math_vector.h"
+#include "BLI_quadric.h"
+#include "BLI_set.hh"
+
 #include "extract_mesh.h"
 
 #include "draw_subdivision.h"
@@ -241,9 +248,159 @@ constexpr MeshExtract create_extractor_tris_single_mat()
 
 /** \} */
 
+/** \name Extract Simplified Triangles Indices
+ *
+ * Vertex clustering on a grid over the bounds of the mesh. Every cell is represented by the loop
+ * whose vertex has the smallest quadric error for the faces around the cell, and only the
+ * triangles spanning three different cells are kept. The indices refer to the loops of the mesh,
+ * so the simplified surface uses the same vertex buffers as the regular one.
+ * \{ */
+
+/** Number of cells along the largest dimension of the bounds. */
+constexpr int TRIS_LOD_GRID_RES = 32;
+
+static void extract_tris_lod_init(const MeshRenderData *mr,
+                                  struct MeshBatchCache *UNUSED(cache),
+                                  void *UNUSED(ibo),
+                                  void *tls_data)
+{
+  GPUIndexBufBuilder *elb = static_cast<GPUIndexBufBuilder *>(tls_data);
+  GPU_indexbuf_init(elb, GPU_PRIM_TRIS, mr->tri_len, mr->loop_len);
+}
+
+static void extract_tris_lod_build(const MeshRenderData *mr, GPUIndexBufBuilder *elb)
+{
+  float min[3], max[3];
+  INIT_MINMAX(min, max);
+  for (int v = 0; v < mr->vert_len; v++) {
+    minmax_v3v3_v3(min, max, mr->mvert[v].co);
+  }
+  float size[3];
+  sub_v3_v3v3(size, max, min);
+  const float max_size = max_fff(size[0], size[1], size[2]);
+  if (max_size <= 0.0f) {
+    return;
+  }
+  const float cell_scale = float(TRIS_LOD_GRID_RES) / max_size;
+  int dims[3];
+  for (int i = 0; i < 3; i++) {
+    dims[i] = int(size[i] * cell_scale) + 1;
+  }
+  const int cells_len = dims[0] * dims[1] * dims[2];
+
+  int *vert_cell = static_cast<int *>(MEM_mallocN(sizeof(int) * mr->vert_len, __func__));
+  for (int v = 0; v < mr->vert_len; v++) {
+    float co[3];
+    sub_v3_v3v3(co, mr->mvert[v].co, min);
+    int cell[3];
+    for (int i = 0; i < 3; i++) {
+      cell[i] = min_ii(int(co[i] * cell_scale), dims[i] - 1);
+    }
+    vert_cell[v] = cell[0] + dims[0] * (cell[1] + dims[1] * cell[2]);
+  }
+
+  /* Accumulate the planes of the faces touching every cell. */
+  Quadric *cell_quadric = static_cast<Quadric *>(
+      MEM_callocN(sizeof(Quadric) * cells_len, __func__));
+  for (int t = 0; t < mr->tri_len; t++) {
+    const MLoopTri *mlt = &mr->mlooptri[t];
+    const float *co[3];
+    for (int i = 0; i < 3; i++) {
+      co[i] = mr->mvert[mr->mloop[mlt->tri[i]].v].co;
+    }
+    const float area = area_tri_v3(co[0], co[1], co[2]);
+    if (area == 0.0f) {
+      continue;
+    }
+    float no[3];
+    normal_tri_v3(no, co[0], co[1], co[2]);
+    const double plane[4] = {no[0], no[1], no[2], -dot_v3v3(no, co[0])};
+    Quadric q;
+    BLI_quadric_from_plane(&q, plane);
+    BLI_quadric_mul(&q, area);
+    for (int i = 0; i < 3; i++) {
+      BLI_quadric_add_qu_qu(&cell_quadric[vert_cell[mr->mloop[mlt->tri[i]].v]], &q);
+    }
+  }
+
+  /* Pick the representative loop of every cell. */
+  int *cell_loop = static_cast<int *>(MEM_mallocN(sizeof(int) * cells_len, __func__));
+  double *cell_error = static_cast<double *>(MEM_mallocN(sizeof(double) * cells_len, __func__));
+  copy_vn_i(cell_loop, cells_len, -1);
+  for (int l = 0; l < mr->loop_len; l++) {
+    const int v = mr->mloop[l].v;
+    const int cell = vert_cell[v];
+    double co[3];
+    copy_v3db_v3fl(co, mr->mvert[v].co);
+    const double error = BLI_quadric_evaluate(&cell_quadric[cell], co);
+    if (cell_loop[cell] == -1 || error < cell_error[cell]) {
+      cell_loop[cell] = l;
+      cell_error[cell] = error;
+    }
+  }
+
+  /* Keep one triangle per set of three cells. */
+  Set<uint64_t> cell_tris;
+  for (int t = 0; t < mr->tri_len; t++) {
+    const MLoopTri *mlt = &mr->mlooptri[t];
+    if (mr->use_hide && (mr->mpoly[mlt->poly].flag & ME_HIDE)) {
+      continue;
+    }
+    int cells[3];
+    for (int i = 0; i < 3; i++) {
+      cells[i] = vert_cell[mr->mloop[mlt->tri[i]].v];
+    }
+    if (ELEM(cells[0], cells[1], cells[2]) || cells[1] == cells[2]) {
+      continue;
+    }
+    int sorted[3] = {cells[0], cells[1], cells[2]};
+    std::sort(sorted, sorted + 3);
+    const uint64_t key = (uint64_t(sorted[0]) << 42) | (uint64_t(sorted[1]) << 21) |
+                         uint64_t(sorted[2]);
+    if (cell_tris.add(key)) {
+      GPU_indexbuf_add_tri_verts(
+          elb, cell_loop[cells[0]], cell_loop[cells[1]], cell_loop[cells[2]]);
+    }
+  }
+
+  MEM_freeN(vert_cell);
+  MEM_freeN(cell_quadric);
+  MEM_freeN(cell_loop);
+  MEM_freeN(cell_error);
+}
+
+static void extract_tris_lod_finish(const MeshRenderData *mr,
+                                    struct MeshBatchCache *UNUSED(cache),
+                                    void *buf,
+                                    void *_data)
+{
+  GPUIndexBuf *ibo = static_cast<GPUIndexBuf *>(buf);
+  GPUIndexBufBuilder *elb = static_cast<GPUIndexBufBuilder *>(_data);
+  /* Only requested outside of edit mode, see #DRW_cache_mesh_surface_lod_get. */
+  if (mr->extract_type != MR_EXTRACT_BMESH) {
+    extract_tris_lod_build(mr, elb);
+  }
+  GPU_indexbuf_build_in_place(elb, ibo);
+}
+
+constexpr MeshExtract create_extractor_tris_lod()
+{
+  MeshExtract extractor = {nullptr};
+  extractor.init = extract_tris_lod_init;
+  extractor.finish = extract_tris_lod_finish;
+  extractor.data_type = MR_DATA_LOOPTRI;
+  extractor.data_size = sizeof(GPUIndexBufBuilder);
+  extractor.use_threading = false;
+  extractor.mesh_buffer_offset = offsetof(MeshBufferList, ibo.tris_lod);
+  return extractor;
+}
+
+/** \} */
+
 }  // namespace blender::draw
 
 extern "C" {
 const MeshExtract extract_tris = blender::draw::create_extractor_tris();
 const MeshExtract extract_tris_single_mat = blender::draw::create_extractor_tris_single_mat();
+const MeshExtract extract_tris_lod = blender::draw::create_extractor_tris_lod();
 }
@@ -7,6 +7,10 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_task.hh"
+
+#include "BKE_mesh.h"
+
 #include "extract_mesh.h"
 
 #include "draw_subdivision.h"
@@ -58,9 +62,11 @@ static void extract_pos_nor_init(const MeshRenderData *mr,
     }
   }
   else {
-    for (int v = 0; v < mr->vert_len; v++) {
-      data->normals[v].low = GPU_normal_convert_i10_v3(mr->vert_normals[v]);
-    }
+    threading::parallel_for(IndexRange(mr->vert_len), 4096, [&](const IndexRange range) {
+      for (const int v : range) {
+        data->normals[v].low = GPU_normal_convert_i10_v3(mr->vert_normals[v]);
+      }
+    });
   }
 }
 
@@ -399,9 +405,11 @@ static void extract_pos_nor_hq_init(const MeshRenderData *mr,
     }
   }
   else {
-    for (int v = 0; v < mr->vert_len; v++) {
-      normal_float_to_short_v3(data->normals[v].high, mr->vert_normals[v]);
-    }
+    threading::parallel_for(IndexRange(mr->vert_len), 4096, [&](const IndexRange range) {
+      for (const int v : range) {
+        normal_float_to_short_v3(data->normals[v].high, mr->vert_normals[v]);
+      }
+    });
   }
 }
 
@@ -547,9 +555,104 @@ constexpr MeshExtract create_extractor_pos_nor_hq()
 
 /** \} */
 
+/* ---------------------------------------------------------------------- */
+/** \name Update Positions of Existing Buffer
+ * \{ */
+
+template<typename LoopT>
+static void pos_nor_fill_loop(LoopT &vert, const float co[3], const float no[3], const int flag);
+
+template<>
+void pos_nor_fill_loop(PosNorLoop &vert, const float co[3], const float no[3], const int flag)
+{
+  copy_v3_v3(vert.pos, co);
+  vert.nor = GPU_normal_convert_i10_v3(no);
+  vert.nor.w = flag;
+}
+
+template<>
+void pos_nor_fill_loop(PosNorHQLoop &vert, const float co[3], const float no[3], const int flag)
+{
+  copy_v3_v3(vert.pos, co);
+  normal_float_to_short_v3(vert.nor, no);
+  vert.nor[3] = flag;
+}
+
+/** Same layout as #extract_pos_nor_iter_poly_mesh and the loose geometry callbacks. */
+template<typename LoopT>
+static void pos_nor_fill_mesh(const Mesh *me,
+                              const MeshExtractLooseGeom *loose_geom,
+                              MutableSpan<LoopT> vbo_data)
+{
+  const float(*vert_normals)[3] = BKE_mesh_vertex_normals_ensure(me);
+  const MVert *mvert = me->mvert;
+  const MLoop *mloop = me->mloop;
+  const MPoly *mpoly = me->mpoly;
+
+  threading::parallel_for(IndexRange(me->totpoly), 1024, [&](const IndexRange range) {
+    for (const int poly_index : range) {
+      const MPoly *mp = &mpoly[poly_index];
+      for (int ml_index = mp->loopstart; ml_index < mp->loopstart + mp->totloop; ml_index++) {
+        const int v = mloop[ml_index].v;
+        const MVert *mv = &mvert[v];
+        int flag = 0;
+        if (mp->flag & ME_HIDE || mv->flag & ME_HIDE) {
+          flag = -1;
+        }
+        else if (mv->flag & SELECT) {
+          flag = 1;
+        }
+        pos_nor_fill_loop(vbo_data[ml_index], mv->co, vert_normals[v], flag);
+      }
+    }
+  });
+
+  int offset = me->totloop;
+  for (int i = 0; i < loose_geom->edge_len; i++) {
+    const MEdge *med = &me->medge[loose_geom->edges[i]];
+    pos_nor_fill_loop(vbo_data[offset++], mvert[med->v1].co, vert_normals[med->v1], 0);
+    pos_nor_fill_loop(vbo_data[offset++], mvert[med->v2].co, vert_normals[med->v2], 0);
+  }
+  for (int i = 0; i < loose_geom->vert_len; i++) {
+    const int v = loose_geom->verts[i];
+    pos_nor_fill_loop(vbo_data[offset++], mvert[v].co, vert_normals[v], 0);
+  }
+}
+
+/** \} */
+
 }  // namespace blender::draw
 
 extern "C" {
 const MeshExtract extract_pos_nor = blender::draw::create_extractor_pos_nor();
 const MeshExtract extract_pos_nor_hq = blender::draw::create_extractor_pos_nor_hq();
+
+bool extract_pos_nor_update_positions(const Mesh *me,
+                                      const MeshExtractLooseGeom *loose_geom,
+                                      GPUVertBuf *vbo)
+{
+  using namespace blender;
+  using namespace blender::draw;
+  const int len = me->totloop + loose_geom->edge_len * 2 + loose_geom->vert_len;
+  if ((GPU_vertbuf_get_status(vbo) & GPU_VERTBUF_DATA_UPLOADED) == 0 ||
+      GPU_vertbuf_get_vertex_len(vbo) != len ||
+      CustomData_has_layer(&me->vdata, CD_ORIGINDEX)) {
+    return false;
+  }
+
+  const uint stride = GPU_vertbuf_get_format(vbo)->stride;
+  void *data = MEM_mallocN(size_t(stride) * len, __func__);
+  if (stride == sizeof(PosNorLoop)) {
+    pos_nor_fill_mesh(me, loose_geom, MutableSpan<PosNorLoop>((PosNorLoop *)data, len));
+  }
+  else {
+    BLI_assert(stride == sizeof(PosNorHQLoop));
+    pos_nor_fill_mesh(me, loose_geom, MutableSpan<PosNorHQLoop>((PosNorHQLoop *)data, len));
+  }
+  /* Binds the buffer, nothing is uploaded since the buffer is not dirty. */
+  GPU_vertbuf_use(vbo);
+  GPU_vertbuf_update_sub(vbo, 0, stride * len, data);
+  MEM_freeN(data);
+  return true;
+}
 }
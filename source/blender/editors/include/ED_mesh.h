@@ -121,6 +121,11 @@ struct EDBMUpdate_Params {
   uint calc_looptri : 1;
   uint calc_normals : 1;
   uint is_destructive : 1;
+  /**
+   * Only recalculate normals around the selected vertices, for operators that select all
+   * geometry they change (their output slots), keeping the normals of the rest of the mesh.
+   */
+  uint calc_normals_from_select : 1;
 };
 
 /**
@@ -92,6 +92,7 @@ static int wm_obj_export_exec(bContext *C, wmOperator *op)
   export_params.export_animation = RNA_boolean_get(op->ptr, "export_animation");
   export_params.start_frame = RNA_int_get(op->ptr, "start_frame");
   export_params.end_frame = RNA_int_get(op->ptr, "end_frame");
+  export_params.parallel_frames = RNA_int_get(op->ptr, "parallel_frames");
 
   export_params.forward_axis = RNA_enum_get(op->ptr, "forward_axis");
   export_params.up_axis = RNA_enum_get(op->ptr, "up_axis");
@@ -135,6 +136,7 @@ static void ui_obj_export_settings(uiLayout *layout, PointerRNA *imfptr)
   sub = uiLayoutColumn(sub, true);
   uiItemR(sub, imfptr, "start_frame", 0, IFACE_("Frame Start"), ICON_NONE);
   uiItemR(sub, imfptr, "end_frame", 0, IFACE_("End"), ICON_NONE);
+  uiItemR(sub, imfptr, "parallel_frames", 0, NULL, ICON_NONE);
   uiLayoutSetEnabled(sub, export_animation);
 
   /* Object Transform options. */
@@ -275,6 +277,16 @@ void WM_OT_obj_export(struct wmOperatorType *ot)
               "The last frame to be exported",
               INT_MIN,
               INT_MAX);
+  RNA_def_int(ot->srna,
+              "parallel_frames",
+              1,
+              1,
+              64,
+              "Parallel Frames",
+              "Number of frames evaluated at the same time, uses more memory. Scenes with "
+              "simulations are always evaluated one frame after the other",
+              1,
+              16);
   /* Object transform options. */
   RNA_def_enum(ot->srna,
                "forward_axis",
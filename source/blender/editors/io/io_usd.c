@@ -359,6 +359,8 @@ static int wm_usd_import_exec(bContext *C, wmOperator *op)
 
   const float light_intensity_scale = RNA_float_get(op->ptr, "light_intensity_scale");
 
+  const bool use_parallel_read = RNA_boolean_get(op->ptr, "use_parallel_read");
+
   /* TODO(makowalski): Add support for sequences. */
   const bool is_sequence = false;
   int offset = 0;
@@ -397,7 +399,8 @@ static int wm_usd_import_exec(bContext *C, wmOperator *op)
                                    .use_instancing = use_instancing,
                                    .import_usd_preview = import_usd_preview,
                                    .set_material_blend = set_material_blend,
-                                   .light_intensity_scale = light_intensity_scale};
+                                   .light_intensity_scale = light_intensity_scale,
+                                   .use_parallel_read = use_parallel_read};
 
   const bool ok = USD_import(C, filename, &params, as_background_job);
 
@@ -448,6 +451,8 @@ static void wm_usd_import_draw(bContext *UNUSED(C), wmOperator *op)
   uiLayout *row = uiLayoutRow(col, true);
   uiItemR(row, ptr, "set_material_blend", 0, NULL, ICON_NONE);
   uiLayoutSetEnabled(row, RNA_boolean_get(ptr, "import_usd_preview"));
+  col = uiLayoutColumn(box, true);
+  uiItemR(col, ptr, "use_parallel_read", 0, NULL, ICON_NONE);
 }
 
 void WM_OT_usd_import(struct wmOperatorType *ot)
@@ -563,6 +568,13 @@ void WM_OT_usd_import(struct wmOperatorType *ot)
                 "Scale for the intensity of imported lights",
                 0.0001f,
                 1000.0f);
+
+  RNA_def_boolean(ot->srna,
+                  "use_parallel_read",
+                  false,
+                  "Parallel Read",
+                  "Read the geometry of meshes on multiple threads before creating the "
+                  "Blender objects");
 }
 
 #endif /* WITH_USD */
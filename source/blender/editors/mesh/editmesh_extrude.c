@@ -434,12 +434,14 @@ static int edbm_extrude_region_exec(bContext *C, wmOperator *op)
       continue;
     }
     /* This normally happens when pushing undo but modal operators
-     * like this one don't push undo data until after modal mode is done. */
+     * like this one don't push undo data until after modal mode is done.
+     * Only the extruded geometry is selected, along with everything it changed. */
     EDBM_update(obedit->data,
                 &(const struct EDBMUpdate_Params){
                     .calc_looptri = true,
                     .calc_normals = true,
                     .is_destructive = true,
+                    .calc_normals_from_select = true,
                 });
   }
   MEM_freeN(objects);
@@ -492,12 +494,14 @@ static int edbm_extrude_context_exec(bContext *C, wmOperator *op)
     edbm_extrude_mesh(obedit, em, op);
 
     /* This normally happens when pushing undo but modal operators
-     * like this one don't push undo data until after modal mode is done. */
+     * like this one don't push undo data until after modal mode is done.
+     * Only the extruded geometry is selected, along with everything it changed. */
     EDBM_update(obedit->data,
                 &(const struct EDBMUpdate_Params){
                     .calc_looptri = true,
                     .calc_normals = true,
                     .is_destructive = true,
+                    .calc_normals_from_select = true,
                 });
   }
   MEM_freeN(objects);
@@ -14,9 +14,11 @@
 #include "DNA_meshdata_types.h"
 #include "DNA_object_types.h"
 #include "DNA_scene_types.h"
+#include "DNA_userdef_types.h"
 
 #include "BLI_array_utils.h"
 #include "BLI_listbase.h"
+#include "BLI_math_vector.h"
 
 #include "BKE_context.h"
 #include "BKE_customdata.h"
@@ -100,6 +102,9 @@ typedef struct UndoMesh {
    * object and editmode operations - Campbell. */
   int shapenr;
 
+  /** Unique for each undo mesh, see #BMesh.undo_state_id. */
+  int state_id;
+
 #ifdef USE_ARRAY_STORE
   /* NULL arrays are considered empty */
   struct { /* most data is stored as 'custom' data */
@@ -568,6 +573,55 @@ static UndoMesh **mesh_undostep_reference_elems_from_objects(Object **object, in
 
 #endif /* USE_ARRAY_STORE */
 
+/** Source of #UndoMesh.state_id. */
+static int um_state_id_last = 0;
+
+#ifdef USE_ARRAY_STORE
+/**
+ * Copy \a um_ref and only write the vertex positions of the edit-mesh, when it matched \a um_ref
+ * and was only tagged with #BM_CHANGE_POSITIONS since. Avoids converting the whole #BMesh after
+ * transforming large meshes.
+ */
+static bool undomesh_from_editmesh_positions(UndoMesh *um, BMesh *bm, UndoMesh *um_ref)
+{
+  if (!USER_EXPERIMENTAL_TEST(&U, use_edit_mesh_partial_undo)) {
+    return false;
+  }
+  if (um_ref == NULL || um_ref->me.key != NULL || bm->change_flag != BM_CHANGE_POSITIONS ||
+      bm->undo_state_id != um_ref->state_id) {
+    return false;
+  }
+  const Mesh *me_ref = &um_ref->me;
+  if (me_ref->totvert != bm->totvert || me_ref->totedge != bm->totedge ||
+      me_ref->totloop != bm->totloop || me_ref->totpoly != bm->totface) {
+    return false;
+  }
+
+  um_arraystore_expand(um_ref);
+
+  Mesh *me = &um->me;
+  /* Nothing in the runtime data of undo meshes is allocated, see #BM_mesh_bm_to_me. */
+  *me = *me_ref;
+  CustomData_copy(&me_ref->vdata, &me->vdata, CD_MASK_ALL, CD_DUPLICATE, me->totvert);
+  CustomData_copy(&me_ref->edata, &me->edata, CD_MASK_ALL, CD_DUPLICATE, me->totedge);
+  CustomData_copy(&me_ref->ldata, &me->ldata, CD_MASK_ALL, CD_DUPLICATE, me->totloop);
+  CustomData_copy(&me_ref->pdata, &me->pdata, CD_MASK_ALL, CD_DUPLICATE, me->totpoly);
+  me->mselect = me_ref->mselect ? MEM_dupallocN(me_ref->mselect) : NULL;
+  BKE_mesh_update_customdata_pointers(me, false);
+
+  um_arraystore_expand_clear(um_ref);
+
+  /* Vertices are in the same order, elements weren't added or removed. */
+  BMIter iter;
+  BMVert *eve;
+  int i;
+  BM_ITER_MESH_INDEX (eve, &iter, bm, BM_VERTS_OF_MESH, i) {
+    copy_v3_v3(me->mvert[i].co, eve->co);
+  }
+  return true;
+}
+#endif
+
 /* for callbacks */
 /* undo simply makes copies of a bmesh */
 /**
@@ -594,17 +648,28 @@ static void *undomesh_from_editmesh(UndoMesh *um, BMEditMesh *em, Key *key, Undo
   /* Uncomment for troubleshooting. */
   // BM_mesh_validate(em->bm);
 
-  BM_mesh_bm_to_me(
-      NULL,
-      em->bm,
-      &um->me,
-      (&(struct BMeshToMeshParams){
-          /* Undo code should not be manipulating 'G_MAIN->object' hooks/vertex-parent. */
-          .calc_object_remap = false,
-          .update_shapekey_indices = false,
-          .cd_mask_extra = {.vmask = CD_MASK_SHAPE_KEYINDEX},
-          .active_shapekey_to_mvert = true,
-      }));
+#ifdef USE_ARRAY_STORE
+  const bool use_positions_only = undomesh_from_editmesh_positions(um, em->bm, um_ref);
+#else
+  const bool use_positions_only = false;
+#endif
+  if (!use_positions_only) {
+    BM_mesh_bm_to_me(
+        NULL,
+        em->bm,
+        &um->me,
+        (&(struct BMeshToMeshParams){
+            /* Undo code should not be manipulating 'G_MAIN->object' hooks/vertex-parent. */
+            .calc_object_remap = false,
+            .update_shapekey_indices = false,
+            .cd_mask_extra = {.vmask = CD_MASK_SHAPE_KEYINDEX},
+            .active_shapekey_to_mvert = true,
+        }));
+  }
+
+  um->state_id = ++um_state_id_last;
+  em->bm->undo_state_id = um->state_id;
+  em->bm->change_flag = 0;
 
   um->selectmode = em->selectmode;
   um->shapenr = em->bm->shapenr;
@@ -689,6 +754,7 @@ static void undomesh_to_editmesh(UndoMesh *um, Object *ob, BMEditMesh *em)
 
   em->selectmode = um->selectmode;
   bm->selectmode = um->selectmode;
+  bm->undo_state_id = um->state_id;
 
   bm->spacearr_dirty = BM_SPACEARR_DIRTY_ALL;
 
@@ -10,8 +10,10 @@
 #include "DNA_key_types.h"
 #include "DNA_mesh_types.h"
 #include "DNA_object_types.h"
+#include "DNA_userdef_types.h"
 
 #include "BLI_alloca.h"
+#include "BLI_bitmap.h"
 #include "BLI_buffer.h"
 #include "BLI_kdtree.h"
 #include "BLI_listbase.h"
@@ -276,6 +278,10 @@ void EDBM_mesh_make(Object *ob, const int select_mode, const bool add_key_index)
                              .use_toolflags = true,
                          }));
 
+  if (USER_EXPERIMENTAL_TEST(&U, use_edit_mesh_pack)) {
+    BM_mesh_elem_pack(bm);
+  }
+
   if (me->edit_mesh) {
     /* this happens when switching shape keys */
     EDBM_mesh_free_data(me->edit_mesh);
@@ -990,7 +996,7 @@ void EDBM_verts_mirror_cache_begin_ex(BMEditMesh *em,
   const float maxdist_sq = square_f(maxdist);
 
   /* one or the other is used depending if topo is enabled */
-  KDTree_3d *tree = NULL;
+  int *index_mirr_table = NULL;
   MirrTopoStore_t mesh_topo_store = {NULL, -1, -1, -1};
 
   BM_mesh_elem_table_ensure(bm, BM_VERT);
@@ -1017,7 +1023,7 @@ void EDBM_verts_mirror_cache_begin_ex(BMEditMesh *em,
     ED_mesh_mirrtopo_init(em, NULL, &mesh_topo_store, true);
   }
   else {
-    tree = BLI_kdtree_3d_new(bm->totvert);
+    KDTree_3d *tree = BLI_kdtree_3d_new(bm->totvert);
     BM_ITER_MESH_INDEX (v, &iter, bm, BM_VERTS_OF_MESH, i) {
       if (respecthide && BM_elem_flag_test(v, BM_ELEM_HIDDEN)) {
         continue;
@@ -1026,6 +1032,36 @@ void EDBM_verts_mirror_cache_begin_ex(BMEditMesh *em,
       BLI_kdtree_3d_insert(tree, i, v->co);
     }
     BLI_kdtree_3d_balance(tree);
+
+    /* The nearest vertex lookups are independent, so do them all at once in parallel. */
+    float(*co_mirr)[3] = MEM_malloc_arrayN(bm->totvert, sizeof(*co_mirr), __func__);
+    int *index_query = MEM_malloc_arrayN(bm->totvert, sizeof(*index_query), __func__);
+    int query_len = 0;
+    BM_ITER_MESH_INDEX (v, &iter, bm, BM_VERTS_OF_MESH, i) {
+      if (respecthide && BM_elem_flag_test(v, BM_ELEM_HIDDEN)) {
+        continue;
+      }
+      if (use_select && !BM_elem_flag_test(v, BM_ELEM_SELECT)) {
+        continue;
+      }
+      copy_v3_v3(co_mirr[query_len], v->co);
+      co_mirr[query_len][axis] *= -1.0f;
+      index_query[query_len++] = i;
+    }
+
+    int *index_nearest = MEM_malloc_arrayN(bm->totvert, sizeof(*index_nearest), __func__);
+    BLI_kdtree_3d_find_nearest_batch(tree, co_mirr, query_len, index_nearest, NULL);
+
+    index_mirr_table = MEM_malloc_arrayN(bm->totvert, sizeof(*index_mirr_table), __func__);
+    for (int query = 0; query < query_len; query++) {
+      index_mirr_table[index_query[query]] = index_nearest[query];
+    }
+
+    MEM_freeN(co_mirr);
+    MEM_freeN(index_query);
+    MEM_freeN(index_nearest);
+
+    BLI_kdtree_3d_free(tree);
   }
 
 #define VERT_INTPTR(_v, _i) (r_index ? &r_index[_i] : BM_ELEM_CD_GET_VOID_P(_v, cd_vmirr_offset))
@@ -1058,7 +1094,7 @@ void EDBM_verts_mirror_cache_begin_ex(BMEditMesh *em,
       co[axis] *= -1.0f;
 
       v_mirr = NULL;
-      i_mirr = BLI_kdtree_3d_find_nearest(tree, co, NULL);
+      i_mirr = index_mirr_table[i];
       if (i_mirr != -1) {
         BMVert *v_test = BM_vert_at_index(bm, i_mirr);
         if (len_squared_v3v3(co, v_test->co) < maxdist_sq) {
@@ -1084,7 +1120,7 @@ void EDBM_verts_mirror_cache_begin_ex(BMEditMesh *em,
     ED_mesh_mirrtopo_free(&mesh_topo_store);
   }
   else {
-    BLI_kdtree_3d_free(tree);
+    MEM_freeN(index_mirr_table);
   }
 }
 
@@ -1352,14 +1388,64 @@ void EDBM_stats_update(BMEditMesh *em)
   }
 }
 
+/**
+ * Recalculate the normals of faces and vertices connected to selected vertices.
+ */
+static void edbm_normals_update_from_select(BMEditMesh *em, const bool face_normals)
+{
+  BMesh *bm = em->bm;
+  BLI_bitmap *verts_mask = BLI_BITMAP_NEW(bm->totvert, __func__);
+  int verts_mask_count = 0;
+  BMIter iter;
+  BMVert *v;
+  int i;
+  BM_ITER_MESH_INDEX (v, &iter, bm, BM_VERTS_OF_MESH, i) {
+    if (!BM_elem_flag_test(v, BM_ELEM_SELECT)) {
+      continue;
+    }
+    BLI_BITMAP_ENABLE(verts_mask, i);
+    verts_mask_count++;
+    if (BM_vert_find_first_loop(v) == NULL) {
+      /* Not handled by partial updates, use the fallback of #BM_mesh_normals_update. */
+      normalize_v3_v3(v->no, v->co);
+    }
+  }
+
+  BMPartialUpdate *bmpinfo = BM_mesh_partial_create_from_verts(bm,
+                                                               &(const BMPartialUpdate_Params){
+                                                                   .do_normals = true,
+                                                               },
+                                                               verts_mask,
+                                                               verts_mask_count);
+  MEM_freeN(verts_mask);
+  BM_mesh_normals_update_with_partial_ex(bm,
+                                         bmpinfo,
+                                         &(const struct BMeshNormalsUpdate_Params){
+                                             .face_normals = face_normals,
+                                         });
+  BM_mesh_partial_destroy(bmpinfo);
+}
+
 void EDBM_update(Mesh *mesh, const struct EDBMUpdate_Params *params)
 {
   BMEditMesh *em = mesh->edit_mesh;
+  em->bm->change_flag |= BM_CHANGE_ALL;
   /* Order of calling isn't important. */
   DEG_id_tag_update(&mesh->id, ID_RECALC_GEOMETRY);
   WM_main_add_notifier(NC_GEOM | ND_DATA, &mesh->id);
 
-  if (params->calc_normals && params->calc_looptri) {
+  if (params->calc_normals && params->calc_normals_from_select) {
+    /* Tessellation can't be partial when the number of faces changed,
+     * calculating it calculates all face normals too. */
+    if (params->calc_looptri) {
+      BKE_editmesh_looptri_calc_ex(em,
+                                   &(const struct BMeshCalcTessellation_Params){
+                                       .face_normals = true,
+                                   });
+    }
+    edbm_normals_update_from_select(em, !params->calc_looptri);
+  }
+  else if (params->calc_normals && params->calc_looptri) {
     /* Calculating both has some performance gains. */
     BKE_editmesh_looptri_and_normals_calc(em);
   }
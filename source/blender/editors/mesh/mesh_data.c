@@ -1283,6 +1283,8 @@ static void mesh_remove_verts(Mesh *mesh, int len)
   const int totvert = mesh->totvert - len;
   CustomData_free_elem(&mesh->vdata, totvert, len);
   mesh->totvert = totvert;
+  /* Shared layers are copied before their elements are freed. */
+  BKE_mesh_update_customdata_pointers(mesh, false);
 }
 
 static void mesh_remove_edges(Mesh *mesh, int len)
@@ -1293,6 +1295,8 @@ static void mesh_remove_edges(Mesh *mesh, int len)
   const int totedge = mesh->totedge - len;
   CustomData_free_elem(&mesh->edata, totedge, len);
   mesh->totedge = totedge;
+  /* Shared layers are copied before their elements are freed. */
+  BKE_mesh_update_customdata_pointers(mesh, false);
 }
 
 static void mesh_remove_loops(Mesh *mesh, int len)
@@ -1303,6 +1307,8 @@ static void mesh_remove_loops(Mesh *mesh, int len)
   const int totloop = mesh->totloop - len;
   CustomData_free_elem(&mesh->ldata, totloop, len);
   mesh->totloop = totloop;
+  /* Shared layers are copied before their elements are freed. */
+  BKE_mesh_update_customdata_pointers(mesh, false);
 }
 
 static void mesh_remove_polys(Mesh *mesh, int len)
@@ -1313,6 +1319,8 @@ static void mesh_remove_polys(Mesh *mesh, int len)
   const int totpoly = mesh->totpoly - len;
   CustomData_free_elem(&mesh->pdata, totpoly, len);
   mesh->totpoly = totpoly;
+  /* Shared layers are copied before their elements are freed. */
+  BKE_mesh_update_customdata_pointers(mesh, false);
 }
 
 void ED_mesh_verts_remove(Mesh *mesh, ReportList *reports, int count)
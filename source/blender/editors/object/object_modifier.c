@@ -224,7 +224,7 @@ ModifierData *ED_object_modifier_add(
   BKE_object_modifier_set_active(ob, new_md);
 
   DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
-  DEG_relations_tag_update(bmain);
+  DEG_id_relations_tag_update(bmain, &ob->id);
 
   return new_md;
 }
@@ -377,7 +377,7 @@ bool ED_object_modifier_remove(
   }
 
   DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
-  DEG_relations_tag_update(bmain);
+  DEG_id_relations_tag_update(bmain, &ob->id);
 
   return true;
 }
@@ -400,7 +400,7 @@ void ED_object_modifier_clear(Main *bmain, Scene *scene, Object *ob)
   }
 
   DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
-  DEG_relations_tag_update(bmain);
+  DEG_id_relations_tag_update(bmain, &ob->id);
 }
 
 bool ED_object_modifier_move_up(ReportList *reports, Object *ob, ModifierData *md)
@@ -495,7 +495,7 @@ void ED_object_modifier_link(bContext *C, Object *ob_dst, Object *ob_src)
   DEG_id_tag_update(&ob_dst->id, ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY | ID_RECALC_ANIMATION);
 
   Main *bmain = CTX_data_main(C);
-  DEG_relations_tag_update(bmain);
+  DEG_id_relations_tag_update(bmain, &ob_dst->id);
 }
 
 void ED_object_modifier_copy_to_object(bContext *C,
@@ -508,7 +508,7 @@ void ED_object_modifier_copy_to_object(bContext *C,
   DEG_id_tag_update(&ob_dst->id, ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY | ID_RECALC_ANIMATION);
 
   Main *bmain = CTX_data_main(C);
-  DEG_relations_tag_update(bmain);
+  DEG_id_relations_tag_update(bmain, &ob_dst->id);
 }
 
 bool ED_object_modifier_convert(ReportList *UNUSED(reports),
@@ -3293,3 +3293,84 @@ void OBJECT_OT_geometry_nodes_input_attribute_toggle(wmOperatorType *ot)
 }
 
 /** \} */
+
+/* ------------------------------------------------------------------- */
+/** \name Export Geometry Nodes Profile Operator
+ * \{ */
+
+static NodesModifierData *geometry_nodes_profile_modifier_get(wmOperator *op, Object *ob)
+{
+  if (RNA_struct_property_is_set(op->ptr, "modifier")) {
+    return (NodesModifierData *)edit_modifier_property_get(op, ob, eModifierType_Nodes);
+  }
+  ModifierData *md = BKE_object_active_modifier(ob);
+  if (md == NULL || md->type != eModifierType_Nodes) {
+    return NULL;
+  }
+  return (NodesModifierData *)md;
+}
+
+static int geometry_nodes_profile_export_exec(bContext *C, wmOperator *op)
+{
+  Object *ob = ED_object_active_context(C);
+  NodesModifierData *nmd = ob ? geometry_nodes_profile_modifier_get(op, ob) : NULL;
+  if (nmd == NULL) {
+    BKE_report(op->reports, RPT_ERROR, "No geometry nodes modifier to export timings of");
+    return OPERATOR_CANCELLED;
+  }
+
+  char filepath[FILE_MAX];
+  RNA_string_get(op->ptr, "filepath", filepath);
+  BLI_path_abs(filepath, BKE_main_blendfile_path(CTX_data_main(C)));
+
+  if (!MOD_nodes_write_profile(nmd, filepath)) {
+    BKE_reportf(op->reports,
+                RPT_ERROR,
+                "Cannot write timings of \"%s\" to \"%s\", the modifier must be evaluated first",
+                nmd->modifier.name,
+                filepath);
+    return OPERATOR_CANCELLED;
+  }
+  return OPERATOR_FINISHED;
+}
+
+static int geometry_nodes_profile_export_invoke(bContext *C,
+                                                wmOperator *op,
+                                                const wmEvent *UNUSED(event))
+{
+  edit_modifier_invoke_properties(C, op);
+
+  if (RNA_struct_property_is_set(op->ptr, "filepath")) {
+    return geometry_nodes_profile_export_exec(C, op);
+  }
+
+  RNA_string_set(op->ptr, "filepath", "//geometry_nodes_profile.json");
+  WM_event_add_fileselect(C, op);
+  return OPERATOR_RUNNING_MODAL;
+}
+
+void OBJECT_OT_geometry_nodes_profile_export(wmOperatorType *ot)
+{
+  ot->name = "Export Geometry Nodes Timings";
+  ot->description =
+      "Write the execution time and allocated memory of every node in the latest evaluation of "
+      "the geometry nodes modifier to a JSON file";
+  ot->idname = "OBJECT_OT_geometry_nodes_profile_export";
+
+  ot->invoke = geometry_nodes_profile_export_invoke;
+  ot->exec = geometry_nodes_profile_export_exec;
+  ot->poll = ED_operator_object_active;
+
+  ot->flag = OPTYPE_REGISTER;
+
+  WM_operator_properties_filesel(ot,
+                                 FILE_TYPE_FOLDER | FILE_TYPE_TEXT,
+                                 FILE_SPECIAL,
+                                 FILE_SAVE,
+                                 WM_FILESEL_FILEPATH,
+                                 FILE_DEFAULTDISPLAY,
+                                 FILE_SORT_DEFAULT);
+  edit_modifier_properties(ot);
+}
+
+/** \} */
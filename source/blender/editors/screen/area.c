@@ -522,6 +522,7 @@ void ED_region_do_draw(bContext *C, ARegion *region)
   }
 
   region->do_draw |= RGN_DRAWING;
+  region->runtime.redraw_count++;
 
   /* Set viewport, scissor, ortho and region->drawrct. */
   wmPartialViewport(&region->drawrct, &region->winrct, &region->drawrct);
@@ -539,7 +540,10 @@ void ED_region_do_draw(bContext *C, ARegion *region)
     region_draw_status_text(area, region);
   }
   else if (at->draw) {
+    immStatsReset();
+    immBatchingSet(USER_EXPERIMENTAL_TEST(&U, use_imm_batching));
     at->draw(C, region);
+    immBatchingSet(false);
   }
 
   /* XXX test: add convention to end regions always in pixel space,
@@ -568,6 +572,21 @@ void ED_region_do_draw(bContext *C, ARegion *region)
              region->drawrct.ymax - region->winrct.ymin);
     immUnbindProgram();
     GPU_blend(GPU_BLEND_NONE);
+
+    /* Redraws of this region and immediate mode draw calls issued by its draw callback. Regions
+     * that are not redrawn keep showing their last count, since their buffer is only blitted. */
+    uint draw_call_len, merged_draw_len;
+    immStatsGet(&draw_call_len, &merged_draw_len);
+    char str[96];
+    const size_t str_len = BLI_snprintf_rlen(str,
+                                             sizeof(str),
+                                             "Redraws: %d, draw calls: %u, merged: %u",
+                                             region->runtime.redraw_count,
+                                             draw_call_len,
+                                             merged_draw_len);
+    BLF_size(BLF_default(), 11.0f * U.pixelsize, U.dpi);
+    BLF_color4f(BLF_default(), 1.0f, 1.0f, 1.0f, 1.0f);
+    BLF_draw_default(U.widget_unit * 0.5f, U.widget_unit * 0.5f, 0.0f, str, str_len);
   }
 
   memset(&region->drawrct, 0, sizeof(region->drawrct));
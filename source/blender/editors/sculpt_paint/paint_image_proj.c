@@ -3769,54 +3769,86 @@ static void proj_paint_state_viewport_init(ProjPaintState *ps, const char symmet
   add_v3_v3(ps->viewPos, ps->obmat_imat[3]);
 }
 
-static void proj_paint_state_screen_coords_init(ProjPaintState *ps, const int diameter)
+typedef struct ProjScreenBounds {
+  float min[2];
+  float max[2];
+} ProjScreenBounds;
+
+static void proj_paint_state_screen_coords_task(void *__restrict userdata,
+                                                const int a,
+                                                const TaskParallelTLS *__restrict tls)
 {
-  const MVert *mv;
-  float *projScreenCo;
-  float projMargin;
-  int a;
+  const ProjPaintState *ps = userdata;
+  ProjScreenBounds *bounds = tls->userdata_chunk;
+  float *projScreenCo = ps->screenCoords[a];
+  const MVert *mv = &ps->mvert_eval[a];
 
-  INIT_MINMAX2(ps->screenMin, ps->screenMax);
+  if (ps->is_ortho) {
+    mul_v3_m4v3(projScreenCo, ps->projectMat, mv->co);
 
-  ps->screenCoords = MEM_mallocN(sizeof(float) * ps->totvert_eval * 4, "ProjectPaint ScreenVerts");
-  projScreenCo = *ps->screenCoords;
+    /* screen space, not clamped */
+    projScreenCo[0] = (float)(ps->winx * 0.5f) + (ps->winx * 0.5f) * projScreenCo[0];
+    projScreenCo[1] = (float)(ps->winy * 0.5f) + (ps->winy * 0.5f) * projScreenCo[1];
+    minmax_v2v2_v2(bounds->min, bounds->max, projScreenCo);
+  }
+  else {
+    copy_v3_v3(projScreenCo, mv->co);
+    projScreenCo[3] = 1.0f;
 
-  if (ps->is_ortho) {
-    for (a = 0, mv = ps->mvert_eval; a < ps->totvert_eval; a++, mv++, projScreenCo += 4) {
-      mul_v3_m4v3(projScreenCo, ps->projectMat, mv->co);
+    mul_m4_v4(ps->projectMat, projScreenCo);
 
+    if (projScreenCo[3] > ps->clip_start) {
       /* screen space, not clamped */
-      projScreenCo[0] = (float)(ps->winx * 0.5f) + (ps->winx * 0.5f) * projScreenCo[0];
-      projScreenCo[1] = (float)(ps->winy * 0.5f) + (ps->winy * 0.5f) * projScreenCo[1];
-      minmax_v2v2_v2(ps->screenMin, ps->screenMax, projScreenCo);
+      projScreenCo[0] = (float)(ps->winx * 0.5f) +
+                        (ps->winx * 0.5f) * projScreenCo[0] / projScreenCo[3];
+      projScreenCo[1] = (float)(ps->winy * 0.5f) +
+                        (ps->winy * 0.5f) * projScreenCo[1] / projScreenCo[3];
+      /* Use the depth for bucket point occlusion */
+      projScreenCo[2] = projScreenCo[2] / projScreenCo[3];
+      minmax_v2v2_v2(bounds->min, bounds->max, projScreenCo);
     }
-  }
-  else {
-    for (a = 0, mv = ps->mvert_eval; a < ps->totvert_eval; a++, mv++, projScreenCo += 4) {
-      copy_v3_v3(projScreenCo, mv->co);
-      projScreenCo[3] = 1.0f;
-
-      mul_m4_v4(ps->projectMat, projScreenCo);
-
-      if (projScreenCo[3] > ps->clip_start) {
-        /* screen space, not clamped */
-        projScreenCo[0] = (float)(ps->winx * 0.5f) +
-                          (ps->winx * 0.5f) * projScreenCo[0] / projScreenCo[3];
-        projScreenCo[1] = (float)(ps->winy * 0.5f) +
-                          (ps->winy * 0.5f) * projScreenCo[1] / projScreenCo[3];
-        /* Use the depth for bucket point occlusion */
-        projScreenCo[2] = projScreenCo[2] / projScreenCo[3];
-        minmax_v2v2_v2(ps->screenMin, ps->screenMax, projScreenCo);
-      }
-      else {
-        /* TODO: deal with cases where 1 side of a face goes behind the view ?
-         *
-         * After some research this is actually very tricky, only option is to
-         * clip the derived mesh before painting, which is a Pain */
-        projScreenCo[0] = FLT_MAX;
-      }
+    else {
+      /* TODO: deal with cases where 1 side of a face goes behind the view ?
+       *
+       * After some research this is actually very tricky, only option is to
+       * clip the derived mesh before painting, which is a Pain */
+      projScreenCo[0] = FLT_MAX;
     }
   }
+}
+
+static void proj_paint_state_screen_coords_reduce(const void *__restrict UNUSED(userdata),
+                                                  void *__restrict chunk_join,
+                                                  void *__restrict chunk)
+{
+  ProjScreenBounds *join = chunk_join;
+  const ProjScreenBounds *bounds = chunk;
+  join->min[0] = min_ff(join->min[0], bounds->min[0]);
+  join->min[1] = min_ff(join->min[1], bounds->min[1]);
+  join->max[0] = max_ff(join->max[0], bounds->max[0]);
+  join->max[1] = max_ff(join->max[1], bounds->max[1]);
+}
+
+static void proj_paint_state_screen_coords_init(ProjPaintState *ps, const int diameter)
+{
+  float projMargin;
+
+  ps->screenCoords = MEM_mallocN(sizeof(float) * ps->totvert_eval * 4, "ProjectPaint ScreenVerts");
+
+  ProjScreenBounds bounds;
+  INIT_MINMAX2(bounds.min, bounds.max);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (ps->totvert_eval > 10000);
+  settings.min_iter_per_thread = 1024;
+  settings.userdata_chunk = &bounds;
+  settings.userdata_chunk_size = sizeof(bounds);
+  settings.func_reduce = proj_paint_state_screen_coords_reduce;
+  BLI_task_parallel_range(0, ps->totvert_eval, ps, proj_paint_state_screen_coords_task, &settings);
+
+  copy_v2_v2(ps->screenMin, bounds.min);
+  copy_v2_v2(ps->screenMax, bounds.max);
 
   /* If this border is not added we get artifacts for faces that
    * have a parallel edge and at the bounds of the 2D projected verts eg
@@ -3929,40 +3961,48 @@ static void proj_paint_state_thread_init(ProjPaintState *ps, const bool reset_th
   }
 }
 
+static void proj_paint_state_vert_flags_task(void *__restrict userdata,
+                                             const int a,
+                                             const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  ProjPaintState *ps = userdata;
+  float viewDirPersp[3];
+  float no[3];
+
+  copy_v3_v3(no, ps->vert_normals[a]);
+  if (UNLIKELY(ps->is_flip_object)) {
+    negate_v3(no);
+  }
+
+  if (ps->is_ortho) {
+    if (dot_v3v3(ps->viewDir, no) <= ps->normal_angle__cos) {
+      /* 1 vert of this face is towards us */
+      ps->vertFlags[a] |= PROJ_VERT_CULL;
+    }
+  }
+  else {
+    sub_v3_v3v3(viewDirPersp, ps->viewPos, ps->mvert_eval[a].co);
+    normalize_v3(viewDirPersp);
+    if (UNLIKELY(ps->is_flip_object)) {
+      negate_v3(viewDirPersp);
+    }
+    if (dot_v3v3(viewDirPersp, no) <= ps->normal_angle__cos) {
+      /* 1 vert of this face is towards us */
+      ps->vertFlags[a] |= PROJ_VERT_CULL;
+    }
+  }
+}
+
 static void proj_paint_state_vert_flags_init(ProjPaintState *ps)
 {
   if (ps->do_backfacecull && ps->do_mask_normal) {
-    float viewDirPersp[3];
-    const MVert *mv;
-    float no[3];
-    int a;
-
     ps->vertFlags = MEM_callocN(sizeof(char) * ps->totvert_eval, "paint-vertFlags");
 
-    for (a = 0, mv = ps->mvert_eval; a < ps->totvert_eval; a++, mv++) {
-      copy_v3_v3(no, ps->vert_normals[a]);
-      if (UNLIKELY(ps->is_flip_object)) {
-        negate_v3(no);
-      }
-
-      if (ps->is_ortho) {
-        if (dot_v3v3(ps->viewDir, no) <= ps->normal_angle__cos) {
-          /* 1 vert of this face is towards us */
-          ps->vertFlags[a] |= PROJ_VERT_CULL;
-        }
-      }
-      else {
-        sub_v3_v3v3(viewDirPersp, ps->viewPos, mv->co);
-        normalize_v3(viewDirPersp);
-        if (UNLIKELY(ps->is_flip_object)) {
-          negate_v3(viewDirPersp);
-        }
-        if (dot_v3v3(viewDirPersp, no) <= ps->normal_angle__cos) {
-          /* 1 vert of this face is towards us */
-          ps->vertFlags[a] |= PROJ_VERT_CULL;
-        }
-      }
-    }
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (ps->totvert_eval > 10000);
+    settings.min_iter_per_thread = 1024;
+    BLI_task_parallel_range(0, ps->totvert_eval, ps, proj_paint_state_vert_flags_task, &settings);
   }
   else {
     ps->vertFlags = NULL;
@@ -2352,6 +2352,41 @@ float SCULPT_brush_strength_factor(SculptSession *ss,
   float rgba[4];
   float point[3];
 
+  /* Hardness. */
+  float final_len = len;
+  const float hardness = cache->paint_brush.hardness;
+  float p = len / cache->radius;
+  if (p < hardness) {
+    final_len = 0.0f;
+  }
+  else if (hardness == 1.0f) {
+    final_len = cache->radius;
+  }
+  else {
+    p = (p - hardness) / (1.0f - hardness);
+    final_len = p * cache->radius;
+  }
+
+  /* The factors that don't depend on the texture are computed first, sampling the texture is
+   * skipped for vertices where one of them is zero (masked, back-facing or auto-masked). */
+  const float curve_factor = BKE_brush_curve_strength(br, final_len, cache->radius);
+  if (curve_factor == 0.0f) {
+    return 0.0f;
+  }
+  const float frontface_factor = frontface(br, cache->view_normal, vno, fno);
+  if (frontface_factor == 0.0f) {
+    return 0.0f;
+  }
+  const float mask_factor = 1.0f - mask;
+  if (mask_factor == 0.0f) {
+    return 0.0f;
+  }
+  const float automasking_factor = SCULPT_automasking_factor_get(
+      cache->automasking, ss, vertex_index);
+  if (automasking_factor == 0.0f) {
+    return 0.0f;
+  }
+
   sub_v3_v3v3(point, brush_point, cache->plane_offset);
 
   if (!mtex->tex) {
@@ -2404,30 +2439,15 @@ float SCULPT_brush_strength_factor(SculptSession *ss,
     }
   }
 
-  /* Hardness. */
-  float final_len = len;
-  const float hardness = cache->paint_brush.hardness;
-  float p = len / cache->radius;
-  if (p < hardness) {
-    final_len = 0.0f;
-  }
-  else if (hardness == 1.0f) {
-    final_len = cache->radius;
-  }
-  else {
-    p = (p - hardness) / (1.0f - hardness);
-    final_len = p * cache->radius;
-  }
-
   /* Falloff curve. */
-  avg *= BKE_brush_curve_strength(br, final_len, cache->radius);
-  avg *= frontface(br, cache->view_normal, vno, fno);
+  avg *= curve_factor;
+  avg *= frontface_factor;
 
   /* Paint mask. */
-  avg *= 1.0f - mask;
+  avg *= mask_factor;
 
   /* Auto-masking. */
-  avg *= SCULPT_automasking_factor_get(cache->automasking, ss, vertex_index);
+  avg *= automasking_factor;
 
   return avg;
 }
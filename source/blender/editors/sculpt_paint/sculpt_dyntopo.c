@@ -93,14 +93,17 @@ void SCULPT_dyntopo_node_layers_add(SculptSession *ss)
   int cd_node_layer_index;
 
   char layer_id[] = "_dyntopo_node_id";
+  char draw_layer_id[] = "_dyntopo_draw_index";
 
-  cd_node_layer_index = CustomData_get_named_layer_index(&ss->bm->vdata, CD_PROP_INT32, layer_id);
-  if (cd_node_layer_index == -1) {
+  /* Add all vertex layers before getting their offsets, adding a layer can move the others. */
+  if (CustomData_get_named_layer_index(&ss->bm->vdata, CD_PROP_INT32, layer_id) == -1) {
     BM_data_layer_add_named(ss->bm, &ss->bm->vdata, CD_PROP_INT32, layer_id);
-    cd_node_layer_index = CustomData_get_named_layer_index(
-        &ss->bm->vdata, CD_PROP_INT32, layer_id);
+  }
+  if (CustomData_get_named_layer_index(&ss->bm->vdata, CD_PROP_INT32, draw_layer_id) == -1) {
+    BM_data_layer_add_named(ss->bm, &ss->bm->vdata, CD_PROP_INT32, draw_layer_id);
   }
 
+  cd_node_layer_index = CustomData_get_named_layer_index(&ss->bm->vdata, CD_PROP_INT32, layer_id);
   ss->cd_vert_node_offset = CustomData_get_n_offset(
       &ss->bm->vdata,
       CD_PROP_INT32,
@@ -108,6 +111,16 @@ void SCULPT_dyntopo_node_layers_add(SculptSession *ss)
 
   ss->bm->vdata.layers[cd_node_layer_index].flag |= CD_FLAG_TEMPORARY;
 
+  /* Index of the vertex in the draw buffers of its node. */
+  cd_node_layer_index = CustomData_get_named_layer_index(
+      &ss->bm->vdata, CD_PROP_INT32, draw_layer_id);
+  ss->cd_vert_draw_index_offset = CustomData_get_n_offset(
+      &ss->bm->vdata,
+      CD_PROP_INT32,
+      cd_node_layer_index - CustomData_get_layer_index(&ss->bm->vdata, CD_PROP_INT32));
+
+  ss->bm->vdata.layers[cd_node_layer_index].flag |= CD_FLAG_TEMPORARY;
+
   cd_node_layer_index = CustomData_get_named_layer_index(&ss->bm->pdata, CD_PROP_INT32, layer_id);
   if (cd_node_layer_index == -1) {
     BM_data_layer_add_named(ss->bm, &ss->bm->pdata, CD_PROP_INT32, layer_id);
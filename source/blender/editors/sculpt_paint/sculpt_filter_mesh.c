@@ -14,6 +14,7 @@
 
 #include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
+#include "DNA_userdef_types.h"
 
 #include "BKE_brush.h"
 #include "BKE_context.h"
@@ -26,6 +27,12 @@
 
 #include "DEG_depsgraph.h"
 
+#include "GPU_capabilities.h"
+#include "GPU_compute.h"
+#include "GPU_shader.h"
+#include "GPU_state.h"
+#include "GPU_storage_buffer.h"
+
 #include "WM_api.h"
 #include "WM_message.h"
 #include "WM_toolsystem.h"
@@ -161,8 +168,13 @@ void SCULPT_filter_cache_init(bContext *C, Object *ob, Sculpt *sd, const int und
   copy_m4_m4(ss->filter_cache->viewmat_inv, vc.rv3d->viewinv);
 }
 
+static void mesh_filter_gpu_smooth_free(struct MeshFilterGPUSmooth *gpu_smooth);
+
 void SCULPT_filter_cache_free(SculptSession *ss)
 {
+  if (ss->filter_cache->gpu_smooth) {
+    mesh_filter_gpu_smooth_free(ss->filter_cache->gpu_smooth);
+  }
   if (ss->filter_cache->cloth_sim) {
     SCULPT_cloth_simulation_free(ss->filter_cache->cloth_sim);
   }
@@ -591,6 +603,221 @@ static void mesh_filter_surface_smooth_displace_task_cb(
   BKE_pbvh_vertex_iter_end;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name GPU Smooth
+ *
+ * Runs the smooth filter in a compute shader. The adjacency, the original positions and the
+ * positions of the last step stay on the GPU for the whole operation. Only the result of each
+ * step is read back, as the PBVH draw buffers and undo are fed from the mesh positions.
+ * \{ */
+
+#define MESH_FILTER_GPU_SMOOTH_GROUP_SIZE 64
+
+typedef struct MeshFilterGPUSmooth {
+  GPUShader *shader;
+  GPUStorageBuf *orig_co;
+  /* Input and output positions of a step, swapped after each step. */
+  GPUStorageBuf *co[2];
+  GPUStorageBuf *neighbor_offsets;
+  GPUStorageBuf *neighbors;
+  GPUStorageBuf *vert_factor;
+
+  /* Factor of each vertex without the filter strength, zero for vertices that don't move. */
+  float *factor;
+  float (*co_read)[4];
+  int verts_len;
+  int step;
+} MeshFilterGPUSmooth;
+
+static bool mesh_filter_gpu_smooth_supported(SculptSession *ss,
+                                             const eSculptMeshFilterType filter_type)
+{
+  return U.experimental.use_sculpt_gpu_filter && filter_type == MESH_FILTER_SMOOTH &&
+         BKE_pbvh_type(ss->pbvh) == PBVH_FACES && !ss->deform_modifiers_active &&
+         !ss->shapekey_active && GPU_compute_shader_support();
+}
+
+static void mesh_filter_gpu_smooth_free(MeshFilterGPUSmooth *gpu_smooth)
+{
+  if (gpu_smooth->shader) {
+    GPU_shader_free(gpu_smooth->shader);
+  }
+  GPU_storagebuf_free(gpu_smooth->orig_co);
+  GPU_storagebuf_free(gpu_smooth->co[0]);
+  GPU_storagebuf_free(gpu_smooth->co[1]);
+  GPU_storagebuf_free(gpu_smooth->neighbor_offsets);
+  GPU_storagebuf_free(gpu_smooth->neighbors);
+  GPU_storagebuf_free(gpu_smooth->vert_factor);
+  MEM_freeN(gpu_smooth->factor);
+  MEM_freeN(gpu_smooth->co_read);
+  MEM_freeN(gpu_smooth);
+}
+
+/**
+ * Gather the neighbors used by #SCULPT_neighbor_coords_average_interior: boundary vertices only
+ * use boundary neighbors and corners are not smoothed at all.
+ *
+ * \param r_neighbors: Filled with the neighbors when not NULL.
+ * \return The number of neighbors.
+ */
+static int mesh_filter_gpu_smooth_neighbors_get(SculptSession *ss,
+                                                const int index,
+                                                uint *r_neighbors)
+{
+  const bool is_boundary = SCULPT_vertex_is_boundary(ss, index);
+  SculptVertexNeighborIter ni;
+
+  if (is_boundary) {
+    int neighbor_count = 0;
+    SCULPT_VERTEX_NEIGHBORS_ITER_BEGIN (ss, index, ni) {
+      neighbor_count++;
+    }
+    SCULPT_VERTEX_NEIGHBORS_ITER_END(ni);
+    if (neighbor_count <= 2) {
+      return 0;
+    }
+  }
+
+  int total = 0;
+  SCULPT_VERTEX_NEIGHBORS_ITER_BEGIN (ss, index, ni) {
+    if (!is_boundary || SCULPT_vertex_is_boundary(ss, ni.index)) {
+      if (r_neighbors) {
+        r_neighbors[total] = (uint)ni.index;
+      }
+      total++;
+    }
+  }
+  SCULPT_VERTEX_NEIGHBORS_ITER_END(ni);
+  return total;
+}
+
+static MeshFilterGPUSmooth *mesh_filter_gpu_smooth_create(SculptSession *ss)
+{
+  GPUShader *shader = GPU_shader_create_from_info_name("gpu_shader_sculpt_smooth");
+  if (shader == NULL) {
+    return NULL;
+  }
+
+  FilterCache *filter_cache = ss->filter_cache;
+  const int totvert = SCULPT_vertex_count_get(ss);
+
+  MeshFilterGPUSmooth *gpu_smooth = MEM_callocN(sizeof(MeshFilterGPUSmooth), __func__);
+  gpu_smooth->shader = shader;
+  gpu_smooth->verts_len = totvert;
+  gpu_smooth->factor = MEM_malloc_arrayN(totvert, sizeof(float), __func__);
+  gpu_smooth->co_read = MEM_malloc_arrayN(totvert, sizeof(float[4]), __func__);
+
+  uint *neighbor_offsets = MEM_malloc_arrayN(totvert + 1, sizeof(uint), __func__);
+  neighbor_offsets[0] = 0;
+  for (int i = 0; i < totvert; i++) {
+    neighbor_offsets[i + 1] = neighbor_offsets[i] +
+                              mesh_filter_gpu_smooth_neighbors_get(ss, i, NULL);
+  }
+  /* Storage buffers can't be empty. */
+  const uint neighbors_len = max_ii(neighbor_offsets[totvert], 1);
+  uint *neighbors = MEM_calloc_arrayN(neighbors_len, sizeof(uint), __func__);
+  for (int i = 0; i < totvert; i++) {
+    mesh_filter_gpu_smooth_neighbors_get(ss, i, neighbors + neighbor_offsets[i]);
+  }
+
+  for (int i = 0; i < totvert; i++) {
+    float factor = 0.0f;
+    if (!(ss->mvert[i].flag & ME_HIDE)) {
+      factor = 1.0f - SCULPT_vertex_mask_get(ss, i);
+      factor *= SCULPT_automasking_factor_get(filter_cache->automasking, ss, i);
+    }
+    gpu_smooth->factor[i] = factor;
+    copy_v3_v3(gpu_smooth->co_read[i], SCULPT_vertex_co_get(ss, i));
+    gpu_smooth->co_read[i][3] = 1.0f;
+  }
+
+  const size_t co_size = sizeof(float[4]) * totvert;
+  gpu_smooth->orig_co = GPU_storagebuf_create_ex(
+      co_size, gpu_smooth->co_read, GPU_USAGE_STATIC, "sculpt_smooth_orig_co");
+  gpu_smooth->co[0] = GPU_storagebuf_create_ex(
+      co_size, gpu_smooth->co_read, GPU_USAGE_DYNAMIC, "sculpt_smooth_co");
+  gpu_smooth->co[1] = GPU_storagebuf_create_ex(
+      co_size, NULL, GPU_USAGE_DYNAMIC, "sculpt_smooth_co");
+  gpu_smooth->neighbor_offsets = GPU_storagebuf_create_ex(sizeof(uint) * (totvert + 1),
+                                                          neighbor_offsets,
+                                                          GPU_USAGE_STATIC,
+                                                          "sculpt_smooth_neighbor_offsets");
+  gpu_smooth->neighbors = GPU_storagebuf_create_ex(
+      sizeof(uint) * neighbors_len, neighbors, GPU_USAGE_STATIC, "sculpt_smooth_neighbors");
+  gpu_smooth->vert_factor = GPU_storagebuf_create_ex(
+      sizeof(float) * totvert, gpu_smooth->factor, GPU_USAGE_STATIC, "sculpt_smooth_factor");
+
+  MEM_freeN(neighbor_offsets);
+  MEM_freeN(neighbors);
+  return gpu_smooth;
+}
+
+/**
+ * Project a displacement on the enabled axes of the filter orientation, as done by
+ * #mesh_filter_task_cb for each vertex.
+ */
+static void mesh_filter_axis_matrix_get(FilterCache *filter_cache, float r_mat[4][4])
+{
+  unit_m4(r_mat);
+  for (int i = 0; i < 3; i++) {
+    float axis[3] = {0.0f, 0.0f, 0.0f};
+    axis[i] = 1.0f;
+    SCULPT_filter_to_orientation_space(axis, filter_cache);
+    for (int it = 0; it < 3; it++) {
+      if (!filter_cache->enabled_axis[it]) {
+        axis[it] = 0.0f;
+      }
+    }
+    SCULPT_filter_to_object_space(axis, filter_cache);
+    copy_v3_v3(r_mat[i], axis);
+  }
+}
+
+static void mesh_filter_gpu_smooth_step(SculptSession *ss, const float filter_strength)
+{
+  FilterCache *filter_cache = ss->filter_cache;
+  MeshFilterGPUSmooth *gpu_smooth = filter_cache->gpu_smooth;
+  GPUStorageBuf *co_in = gpu_smooth->co[gpu_smooth->step % 2];
+  GPUStorageBuf *co_out = gpu_smooth->co[(gpu_smooth->step + 1) % 2];
+
+  float axis_mat[4][4];
+  mesh_filter_axis_matrix_get(filter_cache, axis_mat);
+
+  GPU_shader_bind(gpu_smooth->shader);
+  GPU_shader_uniform_mat4(gpu_smooth->shader, "axis_mat", axis_mat);
+  GPU_shader_uniform_1f(gpu_smooth->shader, "strength", filter_strength);
+  GPU_shader_uniform_1i(gpu_smooth->shader, "verts_len", gpu_smooth->verts_len);
+  GPU_storagebuf_bind(gpu_smooth->orig_co, 0);
+  GPU_storagebuf_bind(co_in, 1);
+  GPU_storagebuf_bind(co_out, 2);
+  GPU_storagebuf_bind(gpu_smooth->neighbor_offsets, 3);
+  GPU_storagebuf_bind(gpu_smooth->neighbors, 4);
+  GPU_storagebuf_bind(gpu_smooth->vert_factor, 5);
+
+  const uint groups_len = (gpu_smooth->verts_len + MESH_FILTER_GPU_SMOOTH_GROUP_SIZE - 1) /
+                          MESH_FILTER_GPU_SMOOTH_GROUP_SIZE;
+  GPU_compute_dispatch(gpu_smooth->shader, groups_len, 1, 1);
+  GPU_memory_barrier(GPU_BARRIER_SHADER_STORAGE);
+  GPU_storagebuf_read(co_out, gpu_smooth->co_read);
+
+  GPU_storagebuf_unbind_all();
+  GPU_shader_unbind();
+  gpu_smooth->step++;
+
+  for (int i = 0; i < gpu_smooth->verts_len; i++) {
+    if (gpu_smooth->factor[i] == 0.0f) {
+      continue;
+    }
+    copy_v3_v3(ss->mvert[i].co, gpu_smooth->co_read[i]);
+    BKE_pbvh_vert_mark_update(ss->pbvh, i);
+  }
+  for (int i = 0; i < filter_cache->totnode; i++) {
+    BKE_pbvh_node_mark_update(filter_cache->nodes[i]);
+  }
+}
+
+/** \} */
+
 static int sculpt_mesh_filter_modal(bContext *C, wmOperator *op, const wmEvent *event)
 {
   Object *ob = CTX_data_active_object(C);
@@ -629,7 +856,12 @@ static int sculpt_mesh_filter_modal(bContext *C, wmOperator *op, const wmEvent *
 
   TaskParallelSettings settings;
   BKE_pbvh_parallel_range_settings(&settings, true, ss->filter_cache->totnode);
-  BLI_task_parallel_range(0, ss->filter_cache->totnode, &data, mesh_filter_task_cb, &settings);
+  if (ss->filter_cache->gpu_smooth) {
+    mesh_filter_gpu_smooth_step(ss, filter_strength);
+  }
+  else {
+    BLI_task_parallel_range(0, ss->filter_cache->totnode, &data, mesh_filter_task_cb, &settings);
+  }
 
   if (filter_type == MESH_FILTER_SURFACE_SMOOTH) {
     BLI_task_parallel_range(0,
@@ -733,6 +965,11 @@ static int sculpt_mesh_filter_invoke(bContext *C, wmOperator *op, const wmEvent
   SculptFilterOrientation orientation = RNA_enum_get(op->ptr, "orientation");
   ss->filter_cache->orientation = orientation;
 
+  if (mesh_filter_gpu_smooth_supported(ss, filter_type)) {
+    /* Stays NULL when the shader fails to compile, using the regular filter instead. */
+    filter_cache->gpu_smooth = mesh_filter_gpu_smooth_create(ss);
+  }
+
   WM_event_add_modal_handler(C, op);
   return OPERATOR_RUNNING_MODAL;
 }
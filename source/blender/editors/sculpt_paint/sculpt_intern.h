@@ -189,6 +189,12 @@ typedef struct SculptUndoNode {
   /* Sculpt Face Sets */
   int *face_sets;
 
+  /* `co` and `orig_co` of old undo steps, see #UserDef.undo_compress_steps. Both arrays are NULL
+   * while compressed. */
+  void *co_compressed;
+  size_t co_compressed_size;
+  size_t co_size, orig_co_size;
+
   size_t undo_size;
 } SculptUndoNode;
 
@@ -442,6 +448,9 @@ typedef struct FilterCache {
 
   /* Pre-smoothed colors used by sharpening. Colors are HSL. */
   float (*pre_smoothed_color)[4];
+
+  /* GPU buffers of the smooth mesh filter, see #UserDef_Experimental.use_sculpt_gpu_filter. */
+  struct MeshFilterGPUSmooth *gpu_smooth;
 } FilterCache;
 
 /**
@@ -7,6 +7,8 @@
  */
 
 #include <stddef.h>
+#include <string.h>
+#include <zstd.h>
 
 #include "MEM_guardedalloc.h"
 
@@ -23,6 +25,7 @@
 #include "DNA_object_types.h"
 #include "DNA_scene_types.h"
 #include "DNA_screen_types.h"
+#include "DNA_userdef_types.h"
 
 #include "BKE_attribute.h"
 #include "BKE_ccg.h"
@@ -102,6 +105,11 @@ typedef struct UndoSculpt {
   ListBase nodes;
 
   size_t undo_size;
+
+  /* Coordinates of the nodes are compressed. */
+  bool is_compressed;
+  /* Memory saved by the compression, set by the compression task. */
+  size_t compressed_size_saved;
 } UndoSculpt;
 
 typedef struct SculptAttrRef {
@@ -930,6 +938,9 @@ static void sculpt_undo_free_list(ListBase *lb)
     if (unode->face_sets) {
       MEM_freeN(unode->face_sets);
     }
+    if (unode->co_compressed) {
+      MEM_freeN(unode->co_compressed);
+    }
 
     MEM_freeN(unode);
 
@@ -1587,6 +1598,200 @@ static void sculpt_undo_set_active_layer(struct bContext *C, SculptAttrRef *attr
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Compressing Old Steps
+ *
+ * The coordinates of sculpt steps older than #UserDef.undo_compress_steps are compressed in a
+ * background task, other data of the nodes is kept as is. Any access to the nodes of an older
+ * step waits for the task to finish first.
+ * \{ */
+
+#define SCULPT_UNDO_COMPRESS_LEVEL 1
+/* Smaller nodes are not worth a compression context. */
+#define SCULPT_UNDO_COMPRESS_SIZE_MIN (16 * 1024)
+
+static TaskPool *sculpt_undo_compress_pool = NULL;
+
+/**
+ * Group the bytes of the same significance of all floats. Sign, exponent and high mantissa bytes
+ * of nearby coordinates are mostly equal, and compress much better next to each other.
+ */
+static void sculpt_undo_bytes_shuffle(const char *src, const size_t size, char *dst)
+{
+  const size_t len = size / sizeof(float);
+  for (size_t i = 0; i < len; i++) {
+    for (size_t b = 0; b < sizeof(float); b++) {
+      dst[b * len + i] = src[i * sizeof(float) + b];
+    }
+  }
+}
+
+static void sculpt_undo_bytes_unshuffle(const char *src, const size_t size, char *dst)
+{
+  const size_t len = size / sizeof(float);
+  for (size_t i = 0; i < len; i++) {
+    for (size_t b = 0; b < sizeof(float); b++) {
+      dst[i * sizeof(float) + b] = src[b * len + i];
+    }
+  }
+}
+
+/** \return The memory saved. */
+static size_t sculpt_undo_node_coords_compress(SculptUndoNode *unode)
+{
+  if (unode->co == NULL || unode->co_compressed != NULL) {
+    return 0;
+  }
+  const size_t co_size = MEM_allocN_len(unode->co);
+  const size_t orig_co_size = unode->orig_co ? MEM_allocN_len(unode->orig_co) : 0;
+  const size_t size = co_size + orig_co_size;
+  if (size < SCULPT_UNDO_COMPRESS_SIZE_MIN) {
+    return 0;
+  }
+
+  char *data = MEM_mallocN(size, __func__);
+  sculpt_undo_bytes_shuffle((const char *)unode->co, co_size, data);
+  if (unode->orig_co) {
+    sculpt_undo_bytes_shuffle((const char *)unode->orig_co, orig_co_size, data + co_size);
+  }
+
+  const size_t compressed_size_max = ZSTD_compressBound(size);
+  char *compressed_buf = MEM_mallocN(compressed_size_max, __func__);
+  const size_t compressed_size = ZSTD_compress(
+      compressed_buf, compressed_size_max, data, size, SCULPT_UNDO_COMPRESS_LEVEL);
+  MEM_freeN(data);
+
+  if (ZSTD_isError(compressed_size) || compressed_size >= size) {
+    MEM_freeN(compressed_buf);
+    return 0;
+  }
+
+  unode->co_compressed = MEM_reallocN(compressed_buf, compressed_size);
+  unode->co_compressed_size = compressed_size;
+  unode->co_size = co_size;
+  unode->orig_co_size = orig_co_size;
+  MEM_freeN(unode->co);
+  unode->co = NULL;
+  MEM_SAFE_FREE(unode->orig_co);
+  return size - compressed_size;
+}
+
+static void sculpt_undo_node_coords_decompress(SculptUndoNode *unode)
+{
+  if (unode->co_compressed == NULL) {
+    return;
+  }
+  const size_t size = unode->co_size + unode->orig_co_size;
+  char *data = MEM_mallocN(size, __func__);
+  const size_t decompressed_size = ZSTD_decompress(
+      data, size, unode->co_compressed, unode->co_compressed_size);
+  /* Should never happen, the buffer was compressed from this size. */
+  BLI_assert(!ZSTD_isError(decompressed_size) && decompressed_size == size);
+  UNUSED_VARS_NDEBUG(decompressed_size);
+
+  unode->co = MEM_mallocN(unode->co_size, "SculptUndoNode.co");
+  sculpt_undo_bytes_unshuffle(data, unode->co_size, (char *)unode->co);
+  if (unode->orig_co_size) {
+    unode->orig_co = MEM_mallocN(unode->orig_co_size, "undoSculpt orig_cos");
+    sculpt_undo_bytes_unshuffle(
+        data + unode->co_size, unode->orig_co_size, (char *)unode->orig_co);
+  }
+  MEM_freeN(data);
+
+  MEM_freeN(unode->co_compressed);
+  unode->co_compressed = NULL;
+  unode->co_compressed_size = 0;
+}
+
+static void sculpt_undo_compress_task(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  UndoSculpt *usculpt = taskdata;
+  size_t size_saved = 0;
+  LISTBASE_FOREACH (SculptUndoNode *, unode, &usculpt->nodes) {
+    size_saved += sculpt_undo_node_coords_compress(unode);
+  }
+  usculpt->compressed_size_saved = size_saved;
+}
+
+/**
+ * \param ustack: When not NULL, update the size of its compressed steps.
+ */
+static void sculpt_undo_compress_wait(UndoStack *ustack)
+{
+  if (sculpt_undo_compress_pool != NULL) {
+    BLI_task_pool_work_and_wait(sculpt_undo_compress_pool);
+    BLI_task_pool_free(sculpt_undo_compress_pool);
+    sculpt_undo_compress_pool = NULL;
+  }
+
+  if (ustack == NULL) {
+    return;
+  }
+
+  /* Account for the memory saved by compression. */
+  LISTBASE_FOREACH (UndoStep *, us_iter, &ustack->steps) {
+    if (us_iter->type == BKE_UNDOSYS_TYPE_SCULPT) {
+      SculptUndoStep *us = (SculptUndoStep *)us_iter;
+      if (us->data.is_compressed) {
+        us_iter->data_size = us->data.undo_size - us->data.compressed_size_saved;
+      }
+    }
+  }
+}
+
+static void sculpt_undo_compress_old_steps(UndoStack *ustack)
+{
+  if (U.undo_compress_steps <= 0 || ustack->step_active == NULL) {
+    return;
+  }
+  BLI_assert(sculpt_undo_compress_pool == NULL);
+
+  /* Skip the newest sculpt steps before (and including) the active one. */
+  int steps = 0;
+  UndoStep *us_iter = ustack->step_active;
+  for (; us_iter; us_iter = us_iter->prev) {
+    if (us_iter->type != BKE_UNDOSYS_TYPE_SCULPT) {
+      continue;
+    }
+    if (steps++ == U.undo_compress_steps) {
+      break;
+    }
+  }
+
+  for (; us_iter; us_iter = us_iter->prev) {
+    if (us_iter->type != BKE_UNDOSYS_TYPE_SCULPT) {
+      continue;
+    }
+    SculptUndoStep *us = (SculptUndoStep *)us_iter;
+    if (us->data.is_compressed) {
+      continue;
+    }
+    us->data.is_compressed = true;
+    us->data.compressed_size_saved = 0;
+
+    if (sculpt_undo_compress_pool == NULL) {
+      sculpt_undo_compress_pool = BLI_task_pool_create_background(NULL, TASK_PRIORITY_LOW);
+    }
+    BLI_task_pool_push(
+        sculpt_undo_compress_pool, sculpt_undo_compress_task, &us->data, false, NULL);
+  }
+}
+
+static void sculpt_undo_decompress(UndoSculpt *usculpt)
+{
+  if (!usculpt->is_compressed) {
+    return;
+  }
+  sculpt_undo_compress_wait(NULL);
+  LISTBASE_FOREACH (SculptUndoNode *, unode, &usculpt->nodes) {
+    sculpt_undo_node_coords_decompress(unode);
+  }
+  usculpt->is_compressed = false;
+  usculpt->compressed_size_saved = 0;
+}
+
+/** \} */
+
 static void sculpt_undosys_step_encode_init(struct bContext *UNUSED(C), UndoStep *us_p)
 {
   SculptUndoStep *us = (SculptUndoStep *)us_p;
@@ -1603,6 +1808,10 @@ static bool sculpt_undosys_step_encode(struct bContext *UNUSED(C),
   SculptUndoStep *us = (SculptUndoStep *)us_p;
   us->step.data_size = us->data.undo_size;
 
+  UndoStack *ustack = ED_undo_stack_get();
+  sculpt_undo_compress_wait(ustack);
+  sculpt_undo_compress_old_steps(ustack);
+
   SculptUndoNode *unode = us->data.nodes.last;
   if (unode && unode->type == SCULPT_UNDO_DYNTOPO_END) {
     us->step.use_memfile_step = true;
@@ -1622,6 +1831,8 @@ static void sculpt_undosys_step_decode_undo_impl(struct bContext *C,
 {
   BLI_assert(us->step.is_applied == true);
 
+  sculpt_undo_decompress(&us->data);
+  us->step.data_size = us->data.undo_size;
   sculpt_undo_restore_list(C, depsgraph, &us->data.nodes);
   us->step.is_applied = false;
 }
@@ -1632,6 +1843,8 @@ static void sculpt_undosys_step_decode_redo_impl(struct bContext *C,
 {
   BLI_assert(us->step.is_applied == false);
 
+  sculpt_undo_decompress(&us->data);
+  us->step.data_size = us->data.undo_size;
   sculpt_undo_restore_list(C, depsgraph, &us->data.nodes);
   us->step.is_applied = true;
 }
@@ -1746,6 +1959,7 @@ static void sculpt_undosys_step_decode(
 static void sculpt_undosys_step_free(UndoStep *us_p)
 {
   SculptUndoStep *us = (SculptUndoStep *)us_p;
+  sculpt_undo_compress_wait(NULL);
   sculpt_undo_free_list(&us->data.nodes);
 }
 
@@ -1791,7 +2005,10 @@ static UndoSculpt *sculpt_undo_get_nodes(void)
 {
   UndoStack *ustack = ED_undo_stack_get();
   UndoStep *us = BKE_undosys_stack_init_or_active_with_type(ustack, BKE_UNDOSYS_TYPE_SCULPT);
-  return sculpt_undosys_step_get_nodes(us);
+  UndoSculpt *usculpt = sculpt_undosys_step_get_nodes(us);
+  /* The active step can be an older one after undo. */
+  sculpt_undo_decompress(usculpt);
+  return usculpt;
 }
 
 /** \} */
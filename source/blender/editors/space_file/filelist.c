@@ -54,6 +54,7 @@
 
 #include "DNA_asset_types.h"
 #include "DNA_space_types.h"
+#include "DNA_userdef_types.h"
 
 #include "ED_datafiles.h"
 #include "ED_fileselect.h"
@@ -341,6 +342,8 @@ typedef struct FileListEntryPreview {
   int index;
   int attributes; /* from FileDirEntry. */
   int icon_id;
+  /** Modification time of the file, 0 when unknown. */
+  int64_t mtime;
 } FileListEntryPreview;
 
 /* Dummy wrapper around FileListEntryPreview to ensure we do not access freed memory when freeing
@@ -1607,6 +1610,127 @@ static int filelist_intern_free_main_files(FileListIntern *filelist_intern)
   return removed_counter;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Preview Memory Cache
+ *
+ * Keeps the decoded previews of recently browsed files in memory, so that going back to a
+ * directory or scrolling back does not decode the on-disk thumbnails again. Entries are keyed by
+ * path and checked against the file modification time. Previews are read and added from the
+ * preview tasks, so all access is guarded by a mutex.
+ * \{ */
+
+/* Memory used by the cached previews, a large thumbnail takes 256 KB. */
+#define FILELIST_PREVIEW_CACHE_LIMIT (128 * 1024 * 1024)
+
+typedef struct FileListPreviewCacheEntry {
+  struct FileListPreviewCacheEntry *next, *prev;
+  char *path;
+  int64_t mtime;
+  ImBuf *imbuf;
+  size_t size;
+} FileListPreviewCacheEntry;
+
+static struct {
+  /** Maps paths to #FileListPreviewCacheEntry. */
+  GHash *entries;
+  /** Least recently used entries first. */
+  ListBase lru;
+  size_t size;
+} filelist_preview_cache = {NULL};
+static ThreadMutex filelist_preview_cache_mutex = BLI_MUTEX_INITIALIZER;
+
+static bool filelist_preview_cache_is_enabled(void)
+{
+  return USER_EXPERIMENTAL_TEST(&U, use_file_preview_cache);
+}
+
+static void filelist_preview_cache_entry_remove(FileListPreviewCacheEntry *cache_entry)
+{
+  BLI_ghash_remove(filelist_preview_cache.entries, cache_entry->path, NULL, NULL);
+  BLI_remlink(&filelist_preview_cache.lru, cache_entry);
+  filelist_preview_cache.size -= cache_entry->size;
+  IMB_freeImBuf(cache_entry->imbuf);
+  MEM_freeN(cache_entry->path);
+  MEM_freeN(cache_entry);
+}
+
+static void filelist_preview_cache_clear_locked(void)
+{
+  if (filelist_preview_cache.entries == NULL) {
+    return;
+  }
+  while (filelist_preview_cache.lru.first) {
+    filelist_preview_cache_entry_remove(filelist_preview_cache.lru.first);
+  }
+  BLI_ghash_free(filelist_preview_cache.entries, NULL, NULL);
+  filelist_preview_cache.entries = NULL;
+}
+
+/**
+ * \return A copy of the cached preview of \a path, NULL if there is none or if the file was
+ * modified since.
+ */
+static ImBuf *filelist_preview_cache_lookup(const char *path, const int64_t mtime)
+{
+  ImBuf *imbuf = NULL;
+  BLI_mutex_lock(&filelist_preview_cache_mutex);
+  if (filelist_preview_cache.entries) {
+    FileListPreviewCacheEntry *cache_entry = BLI_ghash_lookup(filelist_preview_cache.entries,
+                                                              path);
+    if (cache_entry && cache_entry->mtime != mtime) {
+      filelist_preview_cache_entry_remove(cache_entry);
+    }
+    else if (cache_entry) {
+      BLI_remlink(&filelist_preview_cache.lru, cache_entry);
+      BLI_addtail(&filelist_preview_cache.lru, cache_entry);
+      imbuf = IMB_dupImBuf(cache_entry->imbuf);
+    }
+  }
+  BLI_mutex_unlock(&filelist_preview_cache_mutex);
+  return imbuf;
+}
+
+static void filelist_preview_cache_add(const char *path, const int64_t mtime, const ImBuf *imbuf)
+{
+  ImBuf *imbuf_copy = IMB_dupImBuf(imbuf);
+  if (imbuf_copy == NULL) {
+    return;
+  }
+  const size_t size = IMB_get_size_in_memory(imbuf_copy);
+
+  BLI_mutex_lock(&filelist_preview_cache_mutex);
+  if (filelist_preview_cache.entries == NULL) {
+    filelist_preview_cache.entries = BLI_ghash_str_new(__func__);
+  }
+  FileListPreviewCacheEntry *cache_entry = BLI_ghash_lookup(filelist_preview_cache.entries, path);
+  if (cache_entry) {
+    filelist_preview_cache_entry_remove(cache_entry);
+  }
+  while (filelist_preview_cache.lru.first &&
+         filelist_preview_cache.size + size > FILELIST_PREVIEW_CACHE_LIMIT) {
+    filelist_preview_cache_entry_remove(filelist_preview_cache.lru.first);
+  }
+
+  cache_entry = MEM_mallocN(sizeof(*cache_entry), __func__);
+  cache_entry->path = BLI_strdup(path);
+  cache_entry->mtime = mtime;
+  cache_entry->imbuf = imbuf_copy;
+  cache_entry->size = size;
+  BLI_ghash_insert(filelist_preview_cache.entries, cache_entry->path, cache_entry);
+  BLI_addtail(&filelist_preview_cache.lru, cache_entry);
+  filelist_preview_cache.size += size;
+  BLI_mutex_unlock(&filelist_preview_cache_mutex);
+}
+
+void filelist_preview_cache_free(void)
+{
+  BLI_mutex_lock(&filelist_preview_cache_mutex);
+  filelist_preview_cache_clear_locked();
+  BLI_mutex_unlock(&filelist_preview_cache_mutex);
+}
+
+/** \} */
+
 static void filelist_cache_preview_runf(TaskPool *__restrict pool, void *taskdata)
 {
   FileListEntryCache *cache = BLI_task_pool_user_data(pool);
@@ -1636,13 +1760,22 @@ static void filelist_cache_preview_runf(TaskPool *__restrict pool, void *taskdat
     source = THB_SOURCE_FONT;
   }
 
-  IMB_thumb_path_lock(preview->path);
-  /* Always generate biggest preview size for now, it's simpler and avoids having to re-generate
-   * in case user switch to a bigger preview size. Do not create preview when file is offline. */
-  ImBuf *imbuf = (preview->attributes & FILE_ATTR_OFFLINE) ?
-                     IMB_thumb_read(preview->path, THB_LARGE) :
-                     IMB_thumb_manage(preview->path, THB_LARGE, source);
-  IMB_thumb_path_unlock(preview->path);
+  /* Files without a known modification time can't be validated, don't cache them. */
+  const bool use_cache = filelist_preview_cache_is_enabled() && preview->mtime != 0;
+  ImBuf *imbuf = use_cache ? filelist_preview_cache_lookup(preview->path, preview->mtime) : NULL;
+  if (imbuf == NULL) {
+    IMB_thumb_path_lock(preview->path);
+    /* Always generate biggest preview size for now, it's simpler and avoids having to
+     * re-generate in case user switch to a bigger preview size. Do not create preview when file
+     * is offline. */
+    imbuf = (preview->attributes & FILE_ATTR_OFFLINE) ?
+                IMB_thumb_read(preview->path, THB_LARGE) :
+                IMB_thumb_manage(preview->path, THB_LARGE, source);
+    IMB_thumb_path_unlock(preview->path);
+    if (imbuf && use_cache) {
+      filelist_preview_cache_add(preview->path, preview->mtime, imbuf);
+    }
+  }
   if (imbuf) {
     preview->icon_id = BKE_icon_imbuf_create(imbuf);
   }
@@ -1676,6 +1809,10 @@ static void filelist_cache_preview_ensure_running(FileListEntryCache *cache)
 
     IMB_thumb_locks_acquire();
   }
+  if (!filelist_preview_cache_is_enabled()) {
+    /* Release the memory of previews kept while the option was enabled. */
+    filelist_preview_cache_free();
+  }
 }
 
 static void filelist_cache_previews_clear(FileListEntryCache *cache)
@@ -1749,6 +1886,7 @@ static void filelist_cache_previews_push(FileList *filelist, FileDirEntry *entry
   preview->flags = entry->typeflag;
   preview->attributes = entry->attributes;
   preview->icon_id = 0;
+  preview->mtime = entry->time;
 
   if (preview_in_memory) {
     /* TODO(mano-wii): No need to use the thread API here. */
@@ -2802,7 +2940,8 @@ int ED_path_extension_type(const char *path)
   if (BLI_path_extension_check(path, ".zip")) {
     return FILE_TYPE_ARCHIVE;
   }
-  if (BLI_path_extension_check_n(path, ".obj", ".3ds", ".fbx", ".glb", ".gltf", ".svg", NULL)) {
+  if (BLI_path_extension_check_n(
+          path, ".obj", ".3ds", ".fbx", ".glb", ".gltf", ".svg", ".stl", NULL)) {
     return FILE_TYPE_OBJECT_IO;
   }
   if (BLI_path_extension_check_array(path, imb_ext_image)) {
@@ -82,6 +82,10 @@ void filelist_setlibrary(struct FileList *filelist,
 
 void filelist_init_icons(void);
 void filelist_free_icons(void);
+/**
+ * Free the in-memory cache of file previews, see the "Keep File Browser Previews" option.
+ */
+void filelist_preview_cache_free(void);
 struct ImBuf *filelist_getimage(struct FileList *filelist, int index);
 struct ImBuf *filelist_file_getimage(const FileDirEntry *file);
 struct ImBuf *filelist_geticon_image_ex(const FileDirEntry *file);
@@ -1093,6 +1093,7 @@ void ED_file_exit(void)
   if (G.background == false) {
     filelist_free_icons();
   }
+  filelist_preview_cache_free();
 }
 
 void ED_file_read_bookmarks(void)
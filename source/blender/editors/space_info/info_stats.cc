@@ -644,6 +644,22 @@ static const char *info_statusbar_string(Main *bmain,
     uintptr_t mem_in_use = MEM_get_memory_in_use();
     BLI_str_format_byte_unit(formatted_mem, mem_in_use, false);
     ofs += BLI_snprintf_rlen(info + ofs, len, TIP_("Memory: %s"), formatted_mem);
+
+    /* Subsystem using most of the memory, see #MEM_tag_set. */
+    eMEMTag tag_max = MEM_TAG_NONE;
+    size_t tag_max_in_use = 0;
+    for (int tag = MEM_TAG_NONE + 1; tag < MEM_TAG_NUM; tag++) {
+      const size_t tag_in_use = MEM_get_memory_in_use_by_tag(eMEMTag(tag));
+      if (tag_in_use > tag_max_in_use) {
+        tag_max = eMEMTag(tag);
+        tag_max_in_use = tag_in_use;
+      }
+    }
+    if (tag_max != MEM_TAG_NONE) {
+      BLI_str_format_byte_unit(formatted_mem, tag_max_in_use, false);
+      ofs += BLI_snprintf_rlen(
+          info + ofs, len - ofs, " (%s: %s)", IFACE_(MEM_tag_name(tag_max)), formatted_mem);
+    }
   }
 
   /* GPU VRAM status. */
@@ -24,6 +24,7 @@
 #include "BLI_map.hh"
 #include "BLI_set.hh"
 #include "BLI_span.hh"
+#include "BLI_string.h"
 #include "BLI_string_ref.hh"
 #include "BLI_vector.hh"
 
@@ -1583,6 +1584,7 @@ static void node_add_error_message_button(
 static void get_exec_time_other_nodes(const bNode &node,
                                       const SpaceNode &snode,
                                       std::chrono::microseconds &exec_time,
+                                      int64_t &allocated_bytes,
                                       int &node_count)
 {
   if (node.type == NODE_GROUP) {
@@ -1597,6 +1599,7 @@ static void get_exec_time_other_nodes(const bNode &node,
     }
     tree_log->foreach_node_log([&](const geo_log::NodeLog &node_log) {
       exec_time += node_log.execution_time();
+      allocated_bytes += node_log.allocated_bytes();
       node_count++;
     });
   }
@@ -1605,6 +1608,7 @@ static void get_exec_time_other_nodes(const bNode &node,
         snode, node);
     if (node_log) {
       exec_time += node_log->execution_time();
+      allocated_bytes += node_log->allocated_bytes();
       node_count++;
     }
   }
@@ -1613,6 +1617,7 @@ static void get_exec_time_other_nodes(const bNode &node,
 static std::chrono::microseconds node_get_execution_time(const bNodeTree &ntree,
                                                          const bNode &node,
                                                          const SpaceNode &snode,
+                                                         int64_t &allocated_bytes,
                                                          int &node_count)
 {
   std::chrono::microseconds exec_time = std::chrono::microseconds::zero();
@@ -1625,6 +1630,7 @@ static std::chrono::microseconds node_get_execution_time(const bNodeTree &ntree,
     }
     tree_log->foreach_node_log([&](const geo_log::NodeLog &node_log) {
       exec_time += node_log.execution_time();
+      allocated_bytes += node_log.allocated_bytes();
       node_count++;
     });
   }
@@ -1636,24 +1642,27 @@ static std::chrono::microseconds node_get_execution_time(const bNodeTree &ntree,
       }
 
       if (tnode->type == NODE_FRAME) {
-        exec_time += node_get_execution_time(ntree, *tnode, snode, node_count);
+        exec_time += node_get_execution_time(ntree, *tnode, snode, allocated_bytes, node_count);
       }
       else {
-        get_exec_time_other_nodes(*tnode, snode, exec_time, node_count);
+        get_exec_time_other_nodes(*tnode, snode, exec_time, allocated_bytes, node_count);
       }
     }
   }
   else {
-    get_exec_time_other_nodes(node, snode, exec_time, node_count);
+    get_exec_time_other_nodes(node, snode, exec_time, allocated_bytes, node_count);
   }
   return exec_time;
 }
 
-static std::string node_get_execution_time_label(const SpaceNode &snode, const bNode &node)
+static std::string node_get_execution_time_label(const SpaceNode &snode,
+                                                 const bNode &node,
+                                                 int64_t &r_allocated_bytes)
 {
   int node_count = 0;
+  r_allocated_bytes = 0;
   std::chrono::microseconds exec_time = node_get_execution_time(
-      *snode.nodetree, node, snode, node_count);
+      *snode.nodetree, node, snode, r_allocated_bytes, node_count);
 
   if (node_count == 0) {
     return std::string("");
@@ -1693,6 +1702,29 @@ struct NodeExtraInfoRow {
   void (*tooltip_fn_free_arg)(void *) = nullptr;
 };
 
+struct ExecutionTimeTooltipArg {
+  int64_t allocated_bytes;
+  /** Index of the thread that executed the node, -1 for frame and group nodes. */
+  int thread_index;
+};
+
+static char *execution_time_tooltip(bContext *UNUSED(C), void *argN, const char *UNUSED(tip))
+{
+  const ExecutionTimeTooltipArg &arg = *static_cast<ExecutionTimeTooltipArg *>(argN);
+
+  std::stringstream ss;
+  ss << TIP_(
+      "The execution time from the node tree's latest evaluation. For frame and group nodes, the "
+      "time for all sub-nodes");
+  char allocated_str[15];
+  BLI_str_format_byte_unit(allocated_str, arg.allocated_bytes, false);
+  ss << "\n\n" << TIP_("Allocated Memory: ") << allocated_str;
+  if (arg.thread_index != -1) {
+    ss << "\n" << TIP_("Thread: ") << arg.thread_index;
+  }
+  return BLI_strdup(ss.str().c_str());
+}
+
 struct NamedAttributeTooltipArg {
   Map<std::string, NamedAttributeUsage> usage_by_attribute;
 };
@@ -1814,15 +1846,23 @@ static Vector<NodeExtraInfoRow> node_get_extra_info(const SpaceNode &snode, cons
   }
 
   if (snode.overlay.flag & SN_OVERLAY_SHOW_TIMINGS && snode.edittree->type == NTREE_GEOMETRY &&
-      (ELEM(node.typeinfo->nclass, NODE_CLASS_GEOMETRY, NODE_CLASS_GROUP, NODE_CLASS_ATTRIBUTE) ||
-       ELEM(node.type, NODE_FRAME, NODE_GROUP_OUTPUT))) {
+      node.type != NODE_REROUTE) {
     NodeExtraInfoRow row;
-    row.text = node_get_execution_time_label(snode, node);
+    int64_t allocated_bytes;
+    row.text = node_get_execution_time_label(snode, node, allocated_bytes);
     if (!row.text.empty()) {
-      row.tooltip = TIP_(
-          "The execution time from the node tree's latest evaluation. For frame and group nodes, "
-          "the time for all sub-nodes");
+      int thread_index = -1;
+      if (!ELEM(node.type, NODE_GROUP, NODE_FRAME, NODE_GROUP_OUTPUT)) {
+        const geo_log::NodeLog *node_log =
+            geo_log::ModifierLog::find_node_by_node_editor_context(snode, node);
+        thread_index = node_log ? node_log->thread_index() : -1;
+      }
       row.icon = ICON_PREVIEW_RANGE;
+      row.tooltip_fn = execution_time_tooltip;
+      row.tooltip_fn_arg = new ExecutionTimeTooltipArg{allocated_bytes, thread_index};
+      row.tooltip_fn_free_arg = [](void *arg) {
+        delete static_cast<ExecutionTimeTooltipArg *>(arg);
+      };
       rows.append(std::move(row));
     }
   }
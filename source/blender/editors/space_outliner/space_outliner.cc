@@ -127,7 +127,6 @@ static void outliner_main_region_listener(const wmRegionListenerParams *params)
         case ND_OB_RENDER:
         case ND_MODE:
         case ND_KEYINGSET:
-        case ND_FRAME:
         case ND_RENDER_OPTIONS:
         case ND_SEQUENCER:
         case ND_LAYER_CONTENT:
@@ -135,6 +134,17 @@ static void outliner_main_region_listener(const wmRegionListenerParams *params)
         case ND_SCENEBROWSE:
           ED_region_tag_redraw(region);
           break;
+        case ND_FRAME:
+          /* Rebuilding the outliner tree is expensive and shouldn't be done when scrubbing or
+           * during playback. Only the object state filters (visible, selected, ...) depend on
+           * the current frame, e.g. through animated visibility. */
+          if (space_outliner->filter_state != SO_FILTER_OB_ALL) {
+            ED_region_tag_redraw(region);
+          }
+          else {
+            ED_region_tag_redraw_no_rebuild(region);
+          }
+          break;
         case ND_LAYER:
           /* Avoid rebuild if only the active collection changes */
           if ((wmn->subtype == NS_LAYER_COLLECTION) && (wmn->action == NA_ACTIVATED)) {
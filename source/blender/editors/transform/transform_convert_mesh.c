@@ -2142,6 +2142,17 @@ void special_aftertrans_update__mesh(bContext *UNUSED(C), TransInfo *t)
     }
   }
 
+  if (!use_automerge && t->data_type == TC_MESH_VERTS) {
+    FOREACH_TRANS_DATA_CONTAINER (t, tc) {
+      struct TransCustomDataMesh *tcmd = tc->custom.type.data;
+      if (tcmd == NULL || tcmd->cd_layer_correct == NULL) {
+        /* Nothing but the positions changed, without custom-data correction. */
+        BMEditMesh *em = BKE_editmesh_from_object(tc->obedit);
+        em->bm->change_flag |= BM_CHANGE_POSITIONS;
+      }
+    }
+  }
+
   FOREACH_TRANS_DATA_CONTAINER (t, tc) {
     /* table needs to be created for each edit command, since vertices can move etc */
     ED_mesh_mirror_spatial_table_end(tc->obedit);
@@ -10,6 +10,7 @@
 #include "BLI_math.h"
 #include "BLI_math_bits.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 
 #include "BKE_armature.h"
 #include "BKE_context.h"
@@ -26,7 +27,7 @@
 #include "transform_mode.h"
 
 /* -------------------------------------------------------------------- */
-/** \name Transform (Mirror)
+/** \name Transform (Mirror) Element
  * \{ */
 
 /**
@@ -38,7 +39,11 @@
  * \param flip: If true, a mirror on all axis will be performed additionally (point
  * reflection).
  */
-static void ElementMirror(TransInfo *t, TransDataContainer *tc, TransData *td, int axis, bool flip)
+static void ElementMirror(const TransInfo *t,
+                          const TransDataContainer *tc,
+                          TransData *td,
+                          int axis,
+                          bool flip)
 {
   if ((t->flag & T_V3D_ALIGN) == 0 && td->ext) {
     /* Size checked needed since the 3D cursor only uses rotation fields. */
@@ -151,9 +156,61 @@ static void ElementMirror(TransInfo *t, TransDataContainer *tc, TransData *td, i
   }
 }
 
+struct ElemMirrorData {
+  const TransInfo *t;
+  const TransDataContainer *tc;
+  int axis;
+  bool flip;
+};
+
+static void element_mirror_fn(void *__restrict iter_data_v,
+                              const int iter,
+                              const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  struct ElemMirrorData *data = iter_data_v;
+  TransData *td = &data->tc->data[iter];
+  if (td->flag & TD_SKIP) {
+    return;
+  }
+  ElementMirror(data->t, data->tc, td, data->axis, data->flip);
+}
+
+static void transdata_elem_mirror(const TransInfo *t,
+                                  const TransDataContainer *tc,
+                                  const int axis,
+                                  const bool flip)
+{
+  if (tc->data_len < TRANSDATA_THREAD_LIMIT) {
+    TransData *td = tc->data;
+    for (int i = 0; i < tc->data_len; i++, td++) {
+      if (td->flag & TD_SKIP) {
+        continue;
+      }
+      ElementMirror(t, tc, td, axis, flip);
+    }
+  }
+  else {
+    struct ElemMirrorData data = {
+        .t = t,
+        .tc = tc,
+        .axis = axis,
+        .flip = flip,
+    };
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    BLI_task_parallel_range(0, tc->data_len, &data, element_mirror_fn, &settings);
+  }
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Transform (Mirror)
+ * \{ */
+
 static void applyMirror(TransInfo *t, const int UNUSED(mval[2]))
 {
-  int i;
   char str[UI_MAX_DRAW_STR];
   copy_v3_v3(t->values_final, t->values);
 
@@ -178,14 +235,7 @@ static void applyMirror(TransInfo *t, const int UNUSED(mval[2]))
     BLI_snprintf(str, sizeof(str), TIP_("Mirror%s"), t->con.text);
 
     FOREACH_TRANS_DATA_CONTAINER (t, tc) {
-      TransData *td = tc->data;
-      for (i = 0; i < tc->data_len; i++, td++) {
-        if (td->flag & TD_SKIP) {
-          continue;
-        }
-
-        ElementMirror(t, tc, td, special_axis, bitmap_len >= 2);
-      }
+      transdata_elem_mirror(t, tc, special_axis, bitmap_len >= 2);
     }
 
     recalcData(t);
@@ -194,14 +244,7 @@ static void applyMirror(TransInfo *t, const int UNUSED(mval[2]))
   }
   else {
     FOREACH_TRANS_DATA_CONTAINER (t, tc) {
-      TransData *td = tc->data;
-      for (i = 0; i < tc->data_len; i++, td++) {
-        if (td->flag & TD_SKIP) {
-          continue;
-        }
-
-        ElementMirror(t, tc, td, -1, false);
-      }
+      transdata_elem_mirror(t, tc, -1, false);
     }
 
     recalcData(t);
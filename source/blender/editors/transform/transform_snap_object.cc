@@ -347,6 +347,26 @@ static struct Mesh_Runtime *snap_object_data_editmesh_runtime_get(Object *ob_eva
   return &((Mesh *)ob_eval->data)->runtime;
 }
 
+/**
+ * Trees are cached either by the evaluated mesh, or by the edit-mesh when they only contain some
+ * of its elements (see #BKE_bvhtree_from_editmesh_masked_get).
+ */
+static bool snap_object_data_editmesh_tree_is_freed(const SnapObjectData *sod,
+                                                    const BVHTree *tree)
+{
+  return !bvhcache_has_tree(sod->mesh_runtime->bvh_cache, tree) &&
+         !bvhcache_has_tree(sod->treedata_editmesh.em->bvh_cache_masked, tree);
+}
+
+#ifndef NDEBUG
+static bool snap_object_data_editmesh_tree_in_runtime(const SnapObjectData *sod,
+                                                      const BVHTree *tree,
+                                                      const bool cached)
+{
+  return tree && cached && !bvhcache_has_tree(sod->treedata_editmesh.em->bvh_cache_masked, tree);
+}
+#endif
+
 static SnapObjectData *snap_object_data_editmesh_get(SnapObjectContext *sctx,
                                                      Object *ob_eval,
                                                      BMEditMesh *em)
@@ -384,7 +404,12 @@ static SnapObjectData *snap_object_data_editmesh_get(SnapObjectContext *sctx,
       if (sod->mesh_runtime != snap_object_data_editmesh_runtime_get(ob_eval)) {
         if (G.moving) {
           /* Hack to avoid updating while transforming. */
-          BLI_assert(!sod->treedata_editmesh.cached && !sod->cached[0] && !sod->cached[1]);
+          BLI_assert(!snap_object_data_editmesh_tree_in_runtime(
+                         sod, sod->treedata_editmesh.tree, sod->treedata_editmesh.cached) &&
+                     !snap_object_data_editmesh_tree_in_runtime(
+                         sod, sod->bvhtree[0], sod->cached[0]) &&
+                     !snap_object_data_editmesh_tree_in_runtime(
+                         sod, sod->bvhtree[1], sod->cached[1]));
           sod->mesh_runtime = snap_object_data_editmesh_runtime_get(ob_eval);
         }
         else {
@@ -392,17 +417,17 @@ static SnapObjectData *snap_object_data_editmesh_get(SnapObjectContext *sctx,
         }
       }
       else if (sod->treedata_editmesh.tree && sod->treedata_editmesh.cached &&
-               !bvhcache_has_tree(sod->mesh_runtime->bvh_cache, sod->treedata_editmesh.tree)) {
+               snap_object_data_editmesh_tree_is_freed(sod, sod->treedata_editmesh.tree)) {
         /* The tree is owned by the EditMesh and may have been freed since we last used! */
         is_dirty = true;
       }
       else if (sod->bvhtree[0] && sod->cached[0] &&
-               !bvhcache_has_tree(sod->mesh_runtime->bvh_cache, sod->bvhtree[0])) {
+               snap_object_data_editmesh_tree_is_freed(sod, sod->bvhtree[0])) {
         /* The tree is owned by the EditMesh and may have been freed since we last used! */
         is_dirty = true;
       }
       else if (sod->bvhtree[1] && sod->cached[1] &&
-               !bvhcache_has_tree(sod->mesh_runtime->bvh_cache, sod->bvhtree[1])) {
+               snap_object_data_editmesh_tree_is_freed(sod, sod->bvhtree[1])) {
         /* The tree is owned by the EditMesh and may have been freed since we last used! */
         is_dirty = true;
       }
@@ -893,7 +918,8 @@ static bool raycastEditMesh(SnapObjectContext *sctx,
           sctx->callbacks.edit_mesh.test_face_fn,
           sctx->callbacks.edit_mesh.user_data);
 
-      bvhtree_from_editmesh_looptri_ex(treedata, em, elem_mask, looptri_num_active, 0.0f, 4, 6);
+      BKE_bvhtree_from_editmesh_masked_get(
+          treedata, em, elem_mask, looptri_num_active, 4, BVHTREE_FROM_EM_LOOPTRI);
 
       MEM_freeN(elem_mask);
     }
@@ -2545,7 +2571,8 @@ static short snapEditMesh(SnapObjectContext *sctx,
             (bool (*)(BMElem *, void *))sctx->callbacks.edit_mesh.test_vert_fn,
             sctx->callbacks.edit_mesh.user_data);
 
-        bvhtree_from_editmesh_verts_ex(&treedata, em, verts_mask, verts_num_active, 0.0f, 2, 6);
+        BKE_bvhtree_from_editmesh_masked_get(
+            &treedata, em, verts_mask, verts_num_active, 2, BVHTREE_FROM_EM_VERTS);
         MEM_freeN(verts_mask);
       }
       else {
@@ -2577,7 +2604,8 @@ static short snapEditMesh(SnapObjectContext *sctx,
             (bool (*)(BMElem *, void *))sctx->callbacks.edit_mesh.test_edge_fn,
             sctx->callbacks.edit_mesh.user_data);
 
-        bvhtree_from_editmesh_edges_ex(&treedata, em, edges_mask, edges_num_active, 0.0f, 2, 6);
+        BKE_bvhtree_from_editmesh_masked_get(
+            &treedata, em, edges_mask, edges_num_active, 2, BVHTREE_FROM_EM_EDGES);
         MEM_freeN(edges_mask);
       }
       else {
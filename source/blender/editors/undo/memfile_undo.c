@@ -6,11 +6,14 @@
  * Wrapper between 'ED_undo.h' and 'BKE_undo_system.h' API's.
  */
 
+#include "MEM_guardedalloc.h"
+
 #include "BLI_sys_types.h"
 #include "BLI_utildefines.h"
 
 #include "BLI_ghash.h"
 #include "BLI_listbase.h"
+#include "BLI_task.h"
 
 #include "DNA_ID.h"
 #include "DNA_collection_types.h"
@@ -18,6 +21,7 @@
 #include "DNA_object_enums.h"
 #include "DNA_object_types.h"
 #include "DNA_scene_types.h"
+#include "DNA_userdef_types.h"
 
 #include "BKE_blender_undo.h"
 #include "BKE_context.h"
@@ -54,6 +58,99 @@ typedef struct MemFileUndoStep {
   MemFileUndoData *data;
 } MemFileUndoStep;
 
+/* -------------------------------------------------------------------- */
+/** \name Compressing Old Steps
+ *
+ * Memfile steps older than #UserDef.undo_compress_steps are compressed in a background task.
+ * Any access to a memfile step waits for the task to finish first, so that the task never runs
+ * concurrently with code using the steps it compresses.
+ * \{ */
+
+typedef struct MemFileCompressTaskData {
+  MemFile *memfile;
+  const MemFile *memfile_next;
+} MemFileCompressTaskData;
+
+static TaskPool *memfile_compress_pool = NULL;
+
+static void memfile_undosys_compress_task(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  MemFileCompressTaskData *data = taskdata;
+  BLO_memfile_compress(data->memfile, data->memfile_next);
+}
+
+/**
+ * \param ustack: When not NULL, update the size of its compressed steps.
+ */
+static void memfile_undosys_compress_wait(UndoStack *ustack)
+{
+  if (memfile_compress_pool == NULL) {
+    return;
+  }
+  BLI_task_pool_work_and_wait(memfile_compress_pool);
+  BLI_task_pool_free(memfile_compress_pool);
+  memfile_compress_pool = NULL;
+
+  if (ustack == NULL) {
+    return;
+  }
+
+  /* Account for the memory saved by compression. */
+  LISTBASE_FOREACH (UndoStep *, us_iter, &ustack->steps) {
+    if (us_iter->type == BKE_UNDOSYS_TYPE_MEMFILE) {
+      MemFileUndoStep *us = (MemFileUndoStep *)us_iter;
+      if (us->data->memfile.compressed_buf != NULL) {
+        us->data->undo_size = us->data->memfile.size;
+        us_iter->data_size = us->data->undo_size;
+      }
+    }
+  }
+}
+
+static void memfile_undosys_compress_old_steps(UndoStack *ustack)
+{
+  if (U.undo_compress_steps <= 0 || ustack->step_active == NULL) {
+    return;
+  }
+  BLI_assert(memfile_compress_pool == NULL);
+
+  /* Skip the newest memfile steps before (and including) the active one. */
+  int steps = 0;
+  UndoStep *us_next_p = NULL;
+  UndoStep *us_iter = ustack->step_active;
+  for (; us_iter; us_iter = us_iter->prev) {
+    if (us_iter->type != BKE_UNDOSYS_TYPE_MEMFILE) {
+      continue;
+    }
+    if (steps++ == U.undo_compress_steps) {
+      break;
+    }
+    us_next_p = us_iter;
+  }
+
+  for (; us_iter; us_iter = us_iter->prev) {
+    if (us_iter->type != BKE_UNDOSYS_TYPE_MEMFILE) {
+      continue;
+    }
+    MemFileUndoStep *us = (MemFileUndoStep *)us_iter;
+    MemFileUndoStep *us_next = (MemFileUndoStep *)us_next_p;
+    us_next_p = us_iter;
+    if (us->data->memfile.compressed_buf != NULL) {
+      continue;
+    }
+
+    if (memfile_compress_pool == NULL) {
+      memfile_compress_pool = BLI_task_pool_create_background(NULL, TASK_PRIORITY_LOW);
+    }
+    MemFileCompressTaskData *data = MEM_mallocN(sizeof(*data), __func__);
+    data->memfile = &us->data->memfile;
+    data->memfile_next = us_next ? &us_next->data->memfile : NULL;
+    BLI_task_pool_push(memfile_compress_pool, memfile_undosys_compress_task, data, true, NULL);
+  }
+}
+
+/** \} */
+
 static bool memfile_undosys_poll(bContext *C)
 {
   /* other poll functions must run first, this is a catch-all. */
@@ -83,9 +180,14 @@ static bool memfile_undosys_step_encode(struct bContext *UNUSED(C),
     ED_editors_flush_edits_ex(bmain, false, true);
   }
 
+  memfile_undosys_compress_wait(ustack);
+
   /* can be NULL, use when set. */
   MemFileUndoStep *us_prev = (MemFileUndoStep *)BKE_undosys_step_find_by_type(
       ustack, BKE_UNDOSYS_TYPE_MEMFILE);
+  if (us_prev != NULL) {
+    BLO_memfile_decompress(&us_prev->data->memfile);
+  }
   us->data = BKE_memfile_undo_encode(bmain, us_prev ? us_prev->data : NULL);
   us->step.data_size = us->data->undo_size;
 
@@ -94,6 +196,8 @@ static bool memfile_undosys_step_encode(struct bContext *UNUSED(C),
   us->step.use_old_bmain_data = !bmain->use_memfile_full_barrier;
   bmain->use_memfile_full_barrier = false;
 
+  memfile_undosys_compress_old_steps(ustack);
+
   return true;
 }
 
@@ -207,6 +311,12 @@ static void memfile_undosys_step_decode(struct bContext *C,
   ED_preview_kill_jobs(CTX_wm_manager(C), bmain);
 
   MemFileUndoStep *us = (MemFileUndoStep *)us_p;
+  memfile_undosys_compress_wait(NULL);
+  if (us->data->memfile.compressed_buf != NULL) {
+    BLO_memfile_decompress(&us->data->memfile);
+    us->data->undo_size = us->data->memfile.size;
+    us_p->data_size = us->data->undo_size;
+  }
   BKE_memfile_undo_decode(us->data, undo_direction, use_old_bmain_data, C);
 
   for (UndoStep *us_iter = us_p->next; us_iter; us_iter = us_iter->next) {
@@ -300,6 +410,7 @@ static void memfile_undosys_step_free(UndoStep *us_p)
   /* To avoid unnecessary slow down, free backwards
    * (so we don't need to merge when clearing all). */
   MemFileUndoStep *us = (MemFileUndoStep *)us_p;
+  memfile_undosys_compress_wait(NULL);
   if (us_p->next != NULL) {
     UndoStep *us_next_p = BKE_undosys_step_same_type_next(us_p);
     if (us_next_p != NULL) {
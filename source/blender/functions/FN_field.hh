@@ -219,6 +219,10 @@ class FieldOperation : public FieldNode {
 
   Span<GField> inputs() const;
   const MultiFunction &multi_function() const;
+  /** False when the multi-function is not owned, because it has a static lifetime. */
+  bool owns_multi_function() const;
+  /** The owned multi-function, or null when it is not owned. */
+  const std::shared_ptr<const MultiFunction> &owned_multi_function() const;
 
   const CPPType &output_cpp_type(int output_index) const override;
 };
@@ -615,6 +619,16 @@ inline const MultiFunction &FieldOperation::multi_function() const
   return *function_;
 }
 
+inline bool FieldOperation::owns_multi_function() const
+{
+  return owned_function_ != nullptr;
+}
+
+inline const std::shared_ptr<const MultiFunction> &FieldOperation::owned_multi_function() const
+{
+  return owned_function_;
+}
+
 inline const CPPType &FieldOperation::output_cpp_type(int output_index) const
 {
   int output_counter = 0;
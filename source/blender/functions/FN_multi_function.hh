@@ -51,6 +51,8 @@ class MultiFunction {
    * - Automatic multi-threading when possible and appropriate.
    * - Automatic index mask offsetting to avoid large temporary intermediate arrays that are mostly
    *   unused.
+   * - Functions that allocate arrays (see #ExecutionHints::allocates_array) are called with
+   *   cache-sized chunks of the mask, so that peak memory usage does not depend on the mask size.
    */
   void call_auto(IndexMask mask, MFParams params, MFContext context) const;
   virtual void call(IndexMask mask, MFParams params, MFContext context) const = 0;
@@ -119,6 +121,12 @@ class MultiFunction {
      * memory usage.
      */
     bool allocates_array = false;
+    /**
+     * When #allocates_array is set, the function prefers to be called with at most this many
+     * indices at once, e.g. because all its intermediate arrays fit into the L1 cache then. Zero
+     * means that the default chunk size is used.
+     */
+    int64_t max_chunk_size = 0;
     /**
      * Tells the caller that every execution takes about the same time. This helps making a more
      * educated guess about a good grain size.
@@ -282,6 +282,8 @@ class MFProcedure : NonCopyable, NonMovable {
   Span<MFVariable *> variables();
   Span<const MFVariable *> variables() const;
 
+  Span<const MFCallInstruction *> call_instructions() const;
+
   std::string to_dot() const;
 
   bool validate() const;
@@ -538,6 +540,11 @@ inline Span<const MFVariable *> MFProcedure::variables() const
   return variables_;
 }
 
+inline Span<const MFCallInstruction *> MFProcedure::call_instructions() const
+{
+  return call_instructions_;
+}
+
 template<typename T, typename... Args>
 inline const MultiFunction &MFProcedure::construct_function(Args &&...args)
 {
@@ -15,6 +15,13 @@ class MFProcedureExecutor : public MultiFunction {
  private:
   MFSignature signature_;
   const MFProcedure &procedure_;
+  /** Derived from the functions called by the procedure. */
+  ExecutionHints hints_;
+  /**
+   * All instructions in execution order, when the procedure does not branch. Those procedures
+   * are executed as one fused loop over small chunks, without scheduling instructions.
+   */
+  Vector<const MFInstruction *> straight_line_instructions_;
 
  public:
   MFProcedureExecutor(const MFProcedure &procedure);
@@ -1,5 +1,11 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <atomic>
+#include <mutex>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_concurrent_map.hh"
 #include "BLI_index_mask_ops.hh"
 #include "BLI_map.hh"
 #include "BLI_multi_value_map.hh"
@@ -141,7 +147,6 @@ static Set<GFieldRef> find_varying_fields(const FieldTreeInfo &field_tree_info,
  * Builds the #procedure so that it computes the fields.
  */
 static void build_multi_function_procedure_for_fields(MFProcedure &procedure,
-                                                      ResourceScope &scope,
                                                       const FieldTreeInfo &field_tree_info,
                                                       Span<GFieldRef> output_fields)
 {
@@ -234,8 +239,9 @@ static void build_multi_function_procedure_for_fields(MFProcedure &procedure,
         }
         case FieldNodeType::Constant: {
           const FieldConstant &constant_node = static_cast<const FieldConstant &>(field_node);
+          /* The value is copied, because the procedure may be cached and outlive the field. */
           const MultiFunction &fn = procedure.construct_function<CustomMF_GenericConstant>(
-              constant_node.type(), constant_node.value().get(), false);
+              constant_node.type(), constant_node.value().get(), true);
           MFVariable &new_variable = *builder.add_call<1>(fn)[0];
           variable_by_field.add_new(field, &new_variable);
           break;
@@ -251,7 +257,8 @@ static void build_multi_function_procedure_for_fields(MFProcedure &procedure,
     if (!already_output_variables.add(variable)) {
       /* One variable can be output at most once. To output the same value twice, we have to make
        * a copy first. */
-      const MultiFunction &copy_fn = scope.construct<CustomMF_GenericCopy>(variable->data_type());
+      const MultiFunction &copy_fn = procedure.construct_function<CustomMF_GenericCopy>(
+          variable->data_type());
       variable = builder.add_call<1>(copy_fn, {variable})[0];
     }
     builder.add_output_parameter(*variable);
@@ -274,6 +281,284 @@ static void build_multi_function_procedure_for_fields(MFProcedure &procedure,
   BLI_assert(procedure.validate());
 }
 
+/* --------------------------------------------------------------------
+ * Procedure Cache.
+ *
+ * For small inputs, building and optimizing the procedure often takes longer than executing it.
+ * The same field trees are evaluated again and again, e.g. on every frame or for every instance,
+ * so the built procedures are cached, keyed by the structure of the field tree.
+ */
+
+/**
+ * Identifies the procedure that is built for a set of output fields. Field inputs are passed to
+ * the procedure as parameters, so only their types matter. Multi-functions are compared by
+ * identity and constants by value.
+ */
+struct FieldProcedureKey {
+  Vector<uint64_t> words;
+  /** Values of the constant field nodes, referenced from #words by index. */
+  Vector<GPointer> constants;
+  /**
+   * Functions owned by field operations can only be compared by identity while they are alive,
+   * afterwards another function may be allocated at the same address.
+   */
+  Vector<std::weak_ptr<const MultiFunction>> owned_functions;
+  uint64_t hash = 0;
+
+  void add(const uint64_t word)
+  {
+    words.append(word);
+    hash = (hash ^ word) * 1099511628211ull;
+  }
+
+  void add(const void *ptr)
+  {
+    this->add(uint64_t(uintptr_t(ptr)));
+  }
+};
+
+enum class FieldProcedureKeyTag : uint64_t {
+  Reference = 1,
+  Input,
+  Constant,
+  Operation,
+};
+
+/**
+ * Serialize the structure of the field tree below the output fields in depth first order. Field
+ * nodes that are used more than once are referenced by the index of their first occurrence.
+ * \return False when the field tree contains constants that can't be compared.
+ */
+static bool build_field_procedure_key(const FieldTreeInfo &field_tree_info,
+                                      Span<GFieldRef> output_fields,
+                                      FieldProcedureKey &r_key)
+{
+  r_key.add(field_tree_info.deduplicated_field_inputs.size());
+  for (const FieldInput &field_input : field_tree_info.deduplicated_field_inputs) {
+    r_key.add(&field_input.cpp_type());
+  }
+  r_key.add(output_fields.size());
+
+  Map<const FieldNode *, int> node_indices;
+  Stack<GFieldRef> fields_to_add;
+  for (int i = output_fields.size() - 1; i >= 0; i--) {
+    fields_to_add.push(output_fields[i]);
+  }
+  while (!fields_to_add.is_empty()) {
+    const GFieldRef field = fields_to_add.pop();
+    const FieldNode &field_node = field.node();
+    if (const int *node_index = node_indices.lookup_ptr(&field_node)) {
+      r_key.add(uint64_t(FieldProcedureKeyTag::Reference));
+      r_key.add(*node_index);
+      r_key.add(field.node_output_index());
+      continue;
+    }
+    node_indices.add_new(&field_node, node_indices.size());
+    switch (field_node.node_type()) {
+      case FieldNodeType::Input: {
+        const FieldInput &field_input = static_cast<const FieldInput &>(field_node);
+        r_key.add(uint64_t(FieldProcedureKeyTag::Input));
+        r_key.add(field_tree_info.deduplicated_field_inputs.index_of(field_input));
+        break;
+      }
+      case FieldNodeType::Constant: {
+        const FieldConstant &constant_node = static_cast<const FieldConstant &>(field_node);
+        const CPPType &type = constant_node.type();
+        if (!type.is_equality_comparable() || !type.is_hashable()) {
+          return false;
+        }
+        r_key.add(uint64_t(FieldProcedureKeyTag::Constant));
+        r_key.add(&type);
+        r_key.add(type.hash(constant_node.value().get()));
+        r_key.add(r_key.constants.size());
+        r_key.constants.append(constant_node.value());
+        break;
+      }
+      case FieldNodeType::Operation: {
+        const FieldOperation &operation_node = static_cast<const FieldOperation &>(field_node);
+        const MultiFunction &multi_function = operation_node.multi_function();
+        r_key.add(uint64_t(FieldProcedureKeyTag::Operation));
+        r_key.add(field.node_output_index());
+        r_key.add(&multi_function);
+        if (operation_node.owns_multi_function()) {
+          r_key.owned_functions.append(operation_node.owned_multi_function());
+        }
+        /* Outputs that are not used by any field don't get a variable in the procedure. */
+        int output_index = 0;
+        uint64_t used_outputs_bits = 0;
+        for (const int param_index : multi_function.param_indices()) {
+          if (multi_function.param_type(param_index).interface_type() != MFParamType::Output) {
+            continue;
+          }
+          const GFieldRef output_field{operation_node, output_index};
+          if (!field_tree_info.field_users.lookup(output_field).is_empty() ||
+              output_fields.contains(output_field)) {
+            used_outputs_bits |= uint64_t(1) << (output_index % 64);
+          }
+          output_index++;
+          if (output_index % 64 == 0) {
+            r_key.add(used_outputs_bits);
+            used_outputs_bits = 0;
+          }
+        }
+        r_key.add(used_outputs_bits);
+        const Span<GField> operation_inputs = operation_node.inputs();
+        r_key.add(operation_inputs.size());
+        for (int i = operation_inputs.size() - 1; i >= 0; i--) {
+          fields_to_add.push(operation_inputs[i]);
+        }
+        break;
+      }
+    }
+  }
+  return true;
+}
+
+/** A built procedure, together with the key it was built for. */
+class FieldProcedure : NonCopyable, NonMovable {
+ private:
+  Vector<uint64_t> key_words_;
+  /** Copies of the constants in the key. */
+  Vector<GMutablePointer> key_constants_;
+  Vector<std::weak_ptr<const MultiFunction>> key_owned_functions_;
+
+ public:
+  MFProcedure procedure;
+  std::unique_ptr<MFProcedureExecutor> executor;
+  std::atomic<uint64_t> last_used = 0;
+
+  FieldProcedure(const FieldTreeInfo &field_tree_info, Span<GFieldRef> output_fields)
+  {
+    build_multi_function_procedure_for_fields(procedure, field_tree_info, output_fields);
+    executor = std::make_unique<MFProcedureExecutor>(procedure);
+  }
+
+  FieldProcedure(const FieldTreeInfo &field_tree_info,
+                 Span<GFieldRef> output_fields,
+                 FieldProcedureKey &&key)
+      : FieldProcedure(field_tree_info, output_fields)
+  {
+    key_words_ = std::move(key.words);
+    key_owned_functions_ = std::move(key.owned_functions);
+    for (const GPointer value : key.constants) {
+      const CPPType &type = *value.type();
+      void *buffer = MEM_mallocN_aligned(type.size(), type.alignment(), __func__);
+      type.copy_construct(value.get(), buffer);
+      key_constants_.append({type, buffer});
+    }
+  }
+
+  ~FieldProcedure()
+  {
+    for (GMutablePointer value : key_constants_) {
+      value.destruct();
+      MEM_freeN(value.get());
+    }
+  }
+
+  /** False when a function of the key has been freed, so that the procedure can't be used. */
+  bool is_expired() const
+  {
+    for (const std::weak_ptr<const MultiFunction> &owned_function : key_owned_functions_) {
+      if (owned_function.expired()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool matches(const FieldProcedureKey &key) const
+  {
+    if (key_words_.as_span() != key.words.as_span()) {
+      return false;
+    }
+    for (const int i : key_constants_.index_range()) {
+      if (!key_constants_[i].type()->is_equal(key_constants_[i].get(), key.constants[i].get())) {
+        return false;
+      }
+    }
+    return !this->is_expired();
+  }
+};
+
+class FieldProcedureCache {
+ private:
+  static constexpr int64_t max_procedures = 512;
+
+  /* Fields are evaluated from many threads at once, e.g. by geometry nodes, so lookups must not
+   * be serialized by a single mutex. */
+  ConcurrentMap<uint64_t, std::shared_ptr<FieldProcedure>> procedures_;
+  std::atomic<uint64_t> use_counter_ = 0;
+  /** Only one thread at a time removes procedures when the cache is full. */
+  std::mutex remove_mutex_;
+
+ public:
+  std::shared_ptr<const FieldProcedure> lookup(const FieldProcedureKey &key)
+  {
+    std::optional<std::shared_ptr<FieldProcedure>> procedure = procedures_.lookup_try(key.hash);
+    if (!procedure || !(*procedure)->matches(key)) {
+      return {};
+    }
+    (*procedure)->last_used = ++use_counter_;
+    return std::move(*procedure);
+  }
+
+  void add(std::shared_ptr<FieldProcedure> procedure, const uint64_t hash)
+  {
+    procedure->last_used = ++use_counter_;
+    procedures_.add_overwrite(hash, std::move(procedure));
+    if (procedures_.size() <= max_procedures) {
+      return;
+    }
+    std::unique_lock lock{remove_mutex_, std::try_to_lock};
+    if (!lock.owns_lock()) {
+      return;
+    }
+    /* Remove procedures that can't be used anymore, or the least recently used one. */
+    Vector<uint64_t> hashes_to_remove;
+    uint64_t oldest_hash = hash;
+    uint64_t oldest_use = UINT64_MAX;
+    procedures_.foreach_item(
+        [&](const uint64_t item_hash, const std::shared_ptr<FieldProcedure> &item_procedure) {
+          if (item_procedure->is_expired()) {
+            hashes_to_remove.append(item_hash);
+          }
+          else if (item_procedure->last_used < oldest_use) {
+            oldest_use = item_procedure->last_used;
+            oldest_hash = item_hash;
+          }
+        });
+    if (hashes_to_remove.is_empty()) {
+      hashes_to_remove.append(oldest_hash);
+    }
+    for (const uint64_t hash_to_remove : hashes_to_remove) {
+      procedures_.remove(hash_to_remove);
+    }
+  }
+};
+
+/**
+ * Get the procedure that computes the output fields, from the cache if possible.
+ */
+static std::shared_ptr<const FieldProcedure> get_procedure_for_fields(
+    const FieldTreeInfo &field_tree_info, Span<GFieldRef> output_fields)
+{
+  static FieldProcedureCache cache;
+
+  FieldProcedureKey key;
+  if (!build_field_procedure_key(field_tree_info, output_fields, key)) {
+    return std::make_shared<FieldProcedure>(field_tree_info, output_fields);
+  }
+  if (std::shared_ptr<const FieldProcedure> procedure = cache.lookup(key)) {
+    return procedure;
+  }
+  const uint64_t hash = key.hash;
+  std::shared_ptr<FieldProcedure> procedure = std::make_shared<FieldProcedure>(
+      field_tree_info, output_fields, std::move(key));
+  cache.add(procedure, hash);
+  return procedure;
+}
+
 Vector<GVArray> evaluate_fields(ResourceScope &scope,
                                 Span<GFieldRef> fields_to_evaluate,
                                 IndexMask mask,
@@ -363,11 +648,10 @@ Vector<GVArray> evaluate_fields(ResourceScope &scope,
 
   /* Evaluate varying fields if necessary. */
   if (!varying_fields_to_evaluate.is_empty()) {
-    /* Build the procedure for those fields. */
-    MFProcedure procedure;
-    build_multi_function_procedure_for_fields(
-        procedure, scope, field_tree_info, varying_fields_to_evaluate);
-    MFProcedureExecutor procedure_executor{procedure};
+    /* Get the procedure for those fields. */
+    const std::shared_ptr<const FieldProcedure> procedure = get_procedure_for_fields(
+        field_tree_info, varying_fields_to_evaluate);
+    const MFProcedureExecutor &procedure_executor = *procedure->executor;
 
     MFParamsBuilder mf_params{procedure_executor, &mask};
     MFContextBuilder mf_context;
@@ -415,11 +699,10 @@ Vector<GVArray> evaluate_fields(ResourceScope &scope,
 
   /* Evaluate constant fields if necessary. */
   if (!constant_fields_to_evaluate.is_empty()) {
-    /* Build the procedure for those fields. */
-    MFProcedure procedure;
-    build_multi_function_procedure_for_fields(
-        procedure, scope, field_tree_info, constant_fields_to_evaluate);
-    MFProcedureExecutor procedure_executor{procedure};
+    /* Get the procedure for those fields. */
+    const std::shared_ptr<const FieldProcedure> procedure = get_procedure_for_fields(
+        field_tree_info, constant_fields_to_evaluate);
+    const MFProcedureExecutor &procedure_executor = *procedure->executor;
     MFParamsBuilder mf_params{procedure_executor, 1};
     MFContextBuilder mf_context;
 
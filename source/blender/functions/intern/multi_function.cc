@@ -34,6 +34,13 @@ static bool supports_threading_by_slicing_params(const MultiFunction &fn)
   return true;
 }
 
+/**
+ * Functions that allocate arrays for all indices are called with at most this many indices at
+ * once, so that their intermediate arrays stay in the CPU cache and peak memory usage does not
+ * depend on the number of elements.
+ */
+static constexpr int64_t allocating_chunk_size = 4096;
+
 static int64_t compute_grain_size(const ExecutionHints &hints, const IndexMask mask)
 {
   int64_t grain_size = hints.min_grain_size;
@@ -44,14 +51,77 @@ static int64_t compute_grain_size(const ExecutionHints &hints, const IndexMask m
     grain_size = std::max(grain_size, thread_based_grain_size);
   }
   if (hints.allocates_array) {
-    const int64_t max_grain_size = 10000;
     /* Avoid allocating many large intermediate arrays. Better process data in smaller chunks to
      * keep peak memory usage lower. */
-    grain_size = std::min(grain_size, max_grain_size);
+    grain_size = std::min(grain_size, allocating_chunk_size);
   }
   return grain_size;
 }
 
+/**
+ * Call the function for the part of the mask in the given range. When the indices in that part
+ * are large, they are offset so that they start at zero, to keep arrays allocated by the function
+ * small.
+ */
+static void call_sliced(const MultiFunction &fn,
+                        const IndexMask mask,
+                        const IndexRange sub_range,
+                        MFParams params,
+                        MFContext context)
+{
+  const IndexMask sliced_mask = mask.slice(sub_range);
+  if (sliced_mask[0] < allocating_chunk_size) {
+    /* The indices are low, no need to offset them. */
+    fn.call(sliced_mask, params, context);
+    return;
+  }
+  const int64_t input_slice_start = sliced_mask[0];
+  const int64_t input_slice_size = sliced_mask.last() - input_slice_start + 1;
+  const IndexRange input_slice_range{input_slice_start, input_slice_size};
+
+  Vector<int64_t> offset_mask_indices;
+  const IndexMask offset_mask = mask.slice_and_offset(sub_range, offset_mask_indices);
+
+  MFParamsBuilder offset_params{fn, offset_mask.min_array_size()};
+
+  /* Slice all parameters so that for the actual function call. */
+  for (const int param_index : fn.param_indices()) {
+    const MFParamType param_type = fn.param_type(param_index);
+    switch (param_type.category()) {
+      case MFParamType::SingleInput: {
+        const GVArray &varray = params.readonly_single_input(param_index);
+        offset_params.add_readonly_single_input(varray.slice(input_slice_range));
+        break;
+      }
+      case MFParamType::SingleMutable: {
+        const GMutableSpan span = params.single_mutable(param_index);
+        const GMutableSpan sliced_span = span.slice(input_slice_range);
+        offset_params.add_single_mutable(sliced_span);
+        break;
+      }
+      case MFParamType::SingleOutput: {
+        const GMutableSpan span = params.uninitialized_single_output_if_required(param_index);
+        if (span.is_empty()) {
+          offset_params.add_ignored_single_output();
+        }
+        else {
+          const GMutableSpan sliced_span = span.slice(input_slice_range);
+          offset_params.add_uninitialized_single_output(sliced_span);
+        }
+        break;
+      }
+      case MFParamType::VectorInput:
+      case MFParamType::VectorMutable:
+      case MFParamType::VectorOutput: {
+        BLI_assert_unreachable();
+        break;
+      }
+    }
+  }
+
+  fn.call(offset_mask, offset_params, context);
+}
+
 void MultiFunction::call_auto(IndexMask mask, MFParams params, MFContext context) const
 {
   if (mask.is_empty()) {
@@ -72,62 +142,24 @@ void MultiFunction::call_auto(IndexMask mask, MFParams params, MFContext context
   }
 
   threading::parallel_for(mask.index_range(), grain_size, [&](const IndexRange sub_range) {
-    const IndexMask sliced_mask = mask.slice(sub_range);
     if (!hints.allocates_array) {
       /* There is no benefit to changing indices in this case. */
-      this->call(sliced_mask, params, context);
+      this->call(mask.slice(sub_range), params, context);
       return;
     }
-    if (sliced_mask[0] < grain_size) {
-      /* The indices are low, no need to offset them. */
-      this->call(sliced_mask, params, context);
-      return;
-    }
-    const int64_t input_slice_start = sliced_mask[0];
-    const int64_t input_slice_size = sliced_mask.last() - input_slice_start + 1;
-    const IndexRange input_slice_range{input_slice_start, input_slice_size};
-
-    Vector<int64_t> offset_mask_indices;
-    const IndexMask offset_mask = mask.slice_and_offset(sub_range, offset_mask_indices);
-
-    MFParamsBuilder offset_params{*this, offset_mask.min_array_size()};
-
-    /* Slice all parameters so that for the actual function call. */
-    for (const int param_index : this->param_indices()) {
-      const MFParamType param_type = this->param_type(param_index);
-      switch (param_type.category()) {
-        case MFParamType::SingleInput: {
-          const GVArray &varray = params.readonly_single_input(param_index);
-          offset_params.add_readonly_single_input(varray.slice(input_slice_range));
-          break;
-        }
-        case MFParamType::SingleMutable: {
-          const GMutableSpan span = params.single_mutable(param_index);
-          const GMutableSpan sliced_span = span.slice(input_slice_range);
-          offset_params.add_single_mutable(sliced_span);
-          break;
-        }
-        case MFParamType::SingleOutput: {
-          const GMutableSpan span = params.uninitialized_single_output_if_required(param_index);
-          if (span.is_empty()) {
-            offset_params.add_ignored_single_output();
-          }
-          else {
-            const GMutableSpan sliced_span = span.slice(input_slice_range);
-            offset_params.add_uninitialized_single_output(sliced_span);
-          }
-          break;
-        }
-        case MFParamType::VectorInput:
-        case MFParamType::VectorMutable:
-        case MFParamType::VectorOutput: {
-          BLI_assert_unreachable();
-          break;
-        }
-      }
+    /* The ranges passed in here can be much larger than the grain size, e.g. when there are only
+     * a few threads. Process them in chunks of a fixed size, to bound the size of the arrays
+     * allocated by the function. */
+    const int64_t chunk_size = hints.max_chunk_size > 0 ?
+                                   std::min(hints.max_chunk_size, allocating_chunk_size) :
+                                   allocating_chunk_size;
+    for (int64_t chunk_start = sub_range.start(); chunk_start < sub_range.one_after_last();
+         chunk_start += chunk_size) {
+      const int64_t chunk_end = std::min(chunk_start + chunk_size,
+                                         sub_range.one_after_last());
+      const IndexRange chunk_range{chunk_start, chunk_end - chunk_start};
+      call_sliced(*this, mask, chunk_range, params, context);
     }
-
-    this->call(offset_mask, offset_params, context);
   });
 }
 
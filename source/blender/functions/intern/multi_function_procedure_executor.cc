@@ -6,6 +6,43 @@
 
 namespace blender::fn {
 
+/** Number of indices the instructions of a straight-line procedure are executed for at once. */
+static constexpr int64_t fused_chunk_size = 512;
+
+/**
+ * Get all instructions of the procedure in execution order, or an empty vector when the
+ * procedure contains a branch.
+ */
+static Vector<const MFInstruction *> find_straight_line_instructions(const MFProcedure &procedure)
+{
+  Vector<const MFInstruction *> instructions;
+  const MFInstruction *instruction = procedure.entry();
+  while (instruction != nullptr) {
+    instructions.append(instruction);
+    switch (instruction->type()) {
+      case MFInstructionType::Call: {
+        instruction = static_cast<const MFCallInstruction *>(instruction)->next();
+        break;
+      }
+      case MFInstructionType::Destruct: {
+        instruction = static_cast<const MFDestructInstruction *>(instruction)->next();
+        break;
+      }
+      case MFInstructionType::Dummy: {
+        instruction = static_cast<const MFDummyInstruction *>(instruction)->next();
+        break;
+      }
+      case MFInstructionType::Return: {
+        return instructions;
+      }
+      case MFInstructionType::Branch: {
+        return {};
+      }
+    }
+  }
+  return {};
+}
+
 MFProcedureExecutor::MFProcedureExecutor(const MFProcedure &procedure) : procedure_(procedure)
 {
   MFSignatureBuilder signature("Procedure Executor");
@@ -16,6 +53,24 @@ MFProcedureExecutor::MFProcedureExecutor(const MFProcedure &procedure) : procedu
 
   signature_ = signature.build();
   this->set_signature(&signature_);
+
+  hints_.allocates_array = true;
+  hints_.min_grain_size = 10000;
+  for (const MFCallInstruction *instruction : procedure.call_instructions()) {
+    /* Split the work into smaller parts when the procedure calls expensive functions, so that
+     * they are evaluated on more threads. */
+    const ExecutionHints fn_hints = instruction->fn().execution_hints();
+    hints_.min_grain_size = std::min(hints_.min_grain_size, fn_hints.min_grain_size);
+    hints_.uniform_execution_time &= fn_hints.uniform_execution_time;
+  }
+
+  straight_line_instructions_ = find_straight_line_instructions(procedure);
+  if (!straight_line_instructions_.is_empty()) {
+    /* Without branches, every index goes through the same instructions. Evaluating the whole
+     * chain for a small chunk at a time keeps all intermediate arrays in the L1 cache, which
+     * makes the chain behave like one fused loop. */
+    hints_.max_chunk_size = fused_chunk_size;
+  }
 }
 
 using IndicesSplitVectors = std::array<Vector<int64_t>, 2>;
@@ -1163,17 +1218,14 @@ class InstructionScheduler {
   }
 };
 
-void MFProcedureExecutor::call(IndexMask full_mask, MFParams params, MFContext context) const
+/** Execute the procedure, keeping track of which indices are at which instruction. */
+static void execute_scheduled(const MFProcedure &procedure,
+                              const IndexMask full_mask,
+                              VariableStates &variable_states,
+                              const MFContext &context)
 {
-  BLI_assert(procedure_.validate());
-
-  LinearAllocator<> linear_allocator;
-
-  VariableStates variable_states{linear_allocator, full_mask};
-  variable_states.add_initial_variable_states(*this, procedure_, params);
-
   InstructionScheduler scheduler;
-  scheduler.add_referenced_indices(*procedure_.entry(), full_mask);
+  scheduler.add_referenced_indices(*procedure.entry(), full_mask);
 
   /* Loop until all indices got to a return instruction. */
   while (NextInstructionInfo instr_info = scheduler.pop_next()) {
@@ -1218,6 +1270,45 @@ void MFProcedureExecutor::call(IndexMask full_mask, MFParams params, MFContext c
       }
     }
   }
+}
+
+void MFProcedureExecutor::call(IndexMask full_mask, MFParams params, MFContext context) const
+{
+  BLI_assert(procedure_.validate());
+
+  LinearAllocator<> linear_allocator;
+
+  VariableStates variable_states{linear_allocator, full_mask};
+  variable_states.add_initial_variable_states(*this, procedure_, params);
+
+  if (!straight_line_instructions_.is_empty() && !full_mask.is_empty()) {
+    /* All indices take the same path, so the instructions can be executed in order without
+     * keeping track of the indices per instruction. */
+    for (const MFInstruction *instruction : straight_line_instructions_) {
+      switch (instruction->type()) {
+        case MFInstructionType::Call: {
+          execute_call_instruction(static_cast<const MFCallInstruction &>(*instruction),
+                                   full_mask,
+                                   variable_states,
+                                   context);
+          break;
+        }
+        case MFInstructionType::Destruct: {
+          variable_states.destruct(
+              *static_cast<const MFDestructInstruction &>(*instruction).variable(), full_mask);
+          break;
+        }
+        case MFInstructionType::Dummy:
+        case MFInstructionType::Return:
+        case MFInstructionType::Branch: {
+          break;
+        }
+      }
+    }
+  }
+  else {
+    execute_scheduled(procedure_, full_mask, variable_states, context);
+  }
 
   for (const int param_index : this->param_indices()) {
     const MFParamType param_type = this->param_type(param_index);
@@ -1244,10 +1335,7 @@ void MFProcedureExecutor::call(IndexMask full_mask, MFParams params, MFContext c
 
 MultiFunction::ExecutionHints MFProcedureExecutor::get_execution_hints() const
 {
-  ExecutionHints hints;
-  hints.allocates_array = true;
-  hints.min_grain_size = 10000;
-  return hints;
+  return hints_;
 }
 
 }  // namespace blender::fn
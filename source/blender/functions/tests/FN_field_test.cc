@@ -289,4 +289,45 @@ TEST(field, IgnoredOutput)
   EXPECT_EQ(results.get(3), 5);
 }
 
+TEST(field, CachedProcedureWithDifferentConstants)
+{
+  static CustomMF_SI_SI_SO<int, int, int> add_fn{"add", [](int a, int b) { return a + b; }};
+  GField index_field{std::make_shared<IndexFieldInput>()};
+
+  for (const int value : {1, 2, 1}) {
+    GField constant_field = make_constant_field(CPPType::get<int>(), &value);
+    Field<int> output_field{
+        std::make_shared<FieldOperation>(add_fn, Vector<GField>{index_field, constant_field})};
+
+    Array<int> result(4);
+    FieldContext context;
+    FieldEvaluator evaluator{context, 4};
+    evaluator.add_with_destination(output_field, result.as_mutable_span());
+    evaluator.evaluate();
+    EXPECT_EQ(result[0], value);
+    EXPECT_EQ(result[3], 3 + value);
+  }
+}
+
+TEST(field, CachedProcedureWithOwnedFunctions)
+{
+  GField index_field{std::make_shared<IndexFieldInput>()};
+
+  /* Functions that are freed in between may be allocated at the same address. */
+  for (const int value : {10, 20, 30}) {
+    std::unique_ptr<MultiFunction> add_fn = std::make_unique<CustomMF_SI_SO<int, int>>(
+        "add", [value](int a) { return a + value; });
+    Field<int> output_field{std::make_shared<FieldOperation>(
+        FieldOperation(std::move(add_fn), {index_field}))};
+
+    Array<int> result(4);
+    FieldContext context;
+    FieldEvaluator evaluator{context, 4};
+    evaluator.add_with_destination(output_field, result.as_mutable_span());
+    evaluator.evaluate();
+    EXPECT_EQ(result[0], value);
+    EXPECT_EQ(result[3], 3 + value);
+  }
+}
+
 }  // namespace blender::fn::tests
@@ -126,6 +126,8 @@ TEST(multi_function_procedure, BranchTest)
   EXPECT_TRUE(procedure.validate());
 
   MFProcedureExecutor procedure_fn{procedure};
+  /* Procedures with branches are not executed as one fused loop. */
+  EXPECT_EQ(procedure_fn.execution_hints().max_chunk_size, 0);
   MFParamsBuilder params(procedure_fn, 5);
 
   Array<int> values_a = {1, 5, 3, 6, 2};
@@ -378,4 +380,109 @@ TEST(multi_function_procedure, BufferReuse)
   EXPECT_EQ(results[4], 53);
 }
 
+class ExpensiveAdd10Function : public CustomMF_SI_SO<int, int> {
+ public:
+  ExpensiveAdd10Function() : CustomMF_SI_SO<int, int>("add_10", [](int a) { return a + 10; })
+  {
+  }
+
+ private:
+  ExecutionHints get_execution_hints() const override
+  {
+    ExecutionHints hints;
+    hints.min_grain_size = 100;
+    hints.uniform_execution_time = false;
+    return hints;
+  }
+};
+
+TEST(multi_function_procedure, ExecutionHints)
+{
+  CustomMF_SI_SO<int, int> add_10_fn{"add_10", [](int a) { return a + 10; }};
+  ExpensiveAdd10Function expensive_add_10_fn;
+
+  MFProcedure procedure;
+  MFProcedureBuilder builder{procedure};
+
+  MFVariable *var_a = &builder.add_single_input_parameter<int>();
+  auto [var_b] = builder.add_call<1>(add_10_fn, {var_a});
+  builder.add_destruct(*var_a);
+  auto [var_out] = builder.add_call<1>(expensive_add_10_fn, {var_b});
+  builder.add_destruct(*var_b);
+  builder.add_return();
+  builder.add_output_parameter(*var_out);
+
+  EXPECT_TRUE(procedure.validate());
+
+  /* The procedure is split into small parts like the most expensive function it calls. */
+  MFProcedureExecutor procedure_fn{procedure};
+  const MultiFunction::ExecutionHints hints = procedure_fn.execution_hints();
+  EXPECT_TRUE(hints.allocates_array);
+  EXPECT_EQ(hints.min_grain_size, 100);
+  EXPECT_FALSE(hints.uniform_execution_time);
+
+  Array<int> inputs(1000, 1);
+  Array<int> results(1000, -1);
+
+  MFParamsBuilder params{procedure_fn, inputs.size()};
+  params.add_readonly_single_input(inputs.as_span());
+  params.add_uninitialized_single_output(results.as_mutable_span());
+
+  MFContextBuilder context;
+  procedure_fn.call_auto(IndexRange(1000), params, context);
+
+  EXPECT_EQ(results[0], 21);
+  EXPECT_EQ(results[999], 21);
+}
+
+TEST(multi_function_procedure, FusedStraightLine)
+{
+  /**
+   * procedure(int var1, int *var3) {
+   *   int var2 = var1 * 2;
+   *   var3 = var2 + var1;
+   *   var3 += 10;
+   * }
+   */
+
+  CustomMF_SI_SO<int, int> double_fn{"double", [](int a) { return a * 2; }};
+  CustomMF_SI_SI_SO<int, int, int> add_fn{"add", [](int a, int b) { return a + b; }};
+  CustomMF_SM<int> add_10_fn{"add_10", [](int &a) { a += 10; }};
+
+  MFProcedure procedure;
+  MFProcedureBuilder builder{procedure};
+
+  MFVariable *var1 = &builder.add_single_input_parameter<int>();
+  auto [var2] = builder.add_call<1>(double_fn, {var1});
+  auto [var3] = builder.add_call<1>(add_fn, {var2, var1});
+  builder.add_call(add_10_fn, {var3});
+  builder.add_destruct({var1, var2});
+  builder.add_return();
+  builder.add_output_parameter(*var3);
+
+  EXPECT_TRUE(procedure.validate());
+
+  MFProcedureExecutor procedure_fn{procedure};
+  const MultiFunction::ExecutionHints hints = procedure_fn.execution_hints();
+  EXPECT_GT(hints.max_chunk_size, 0);
+
+  const int64_t size = 10000;
+  Array<int> inputs(size);
+  Array<int> results(size, -1);
+  for (const int64_t i : inputs.index_range()) {
+    inputs[i] = int(i);
+  }
+
+  MFParamsBuilder params{procedure_fn, size};
+  params.add_readonly_single_input(inputs.as_span());
+  params.add_uninitialized_single_output(results.as_mutable_span());
+
+  MFContextBuilder context;
+  procedure_fn.call_auto(IndexRange(size), params, context);
+
+  for (const int64_t i : results.index_range()) {
+    EXPECT_EQ(results[i], i * 3 + 10);
+  }
+}
+
 }  // namespace blender::fn::tests
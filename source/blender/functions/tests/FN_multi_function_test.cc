@@ -2,6 +2,8 @@
 
 #include "testing/testing.h"
 
+#include <atomic>
+
 #include "FN_multi_function.hh"
 #include "FN_multi_function_builder.hh"
 #include "FN_multi_function_test_common.hh"
@@ -194,6 +196,53 @@ TEST(multi_function, CustomMF_SI_SI_SO)
   EXPECT_EQ(outputs[3], 90);
 }
 
+int span_mul_calls_num = 0;
+
+void span_mul(Span<int> a, Span<int> b, MutableSpan<int> r_out)
+{
+  span_mul_calls_num++;
+  for (const int64_t i : r_out.index_range()) {
+    r_out[i] = a[i] * b[i];
+  }
+}
+
+TEST(multi_function, CustomMF_SI_SI_SO_SpanFunction)
+{
+  CustomMF_SI_SI_SO<int, int, int> fn("mul", [](int a, int b) { return a * b; }, span_mul);
+
+  Array<int> values_a = {4, 6, 8, 9};
+  Array<int> values_b = {10, 20, 30, 40};
+  int value_b = 10;
+  Array<int> outputs(values_a.size(), -1);
+  MFContextBuilder context;
+
+  {
+    /* Both inputs are spans and the mask is a range, so the span function is used. */
+    MFParamsBuilder params(fn, values_a.size());
+    params.add_readonly_single_input(values_a.as_span());
+    params.add_readonly_single_input(values_b.as_span());
+    params.add_uninitialized_single_output(outputs.as_mutable_span());
+    fn.call(IndexRange(1, 2), params, context);
+  }
+  EXPECT_EQ(span_mul_calls_num, 1);
+  EXPECT_EQ(outputs[0], -1);
+  EXPECT_EQ(outputs[1], 120);
+  EXPECT_EQ(outputs[2], 240);
+  EXPECT_EQ(outputs[3], -1);
+
+  {
+    /* A single input uses the element function. */
+    MFParamsBuilder params(fn, values_a.size());
+    params.add_readonly_single_input(values_a.as_span());
+    params.add_readonly_single_input(&value_b);
+    params.add_uninitialized_single_output(outputs.as_mutable_span());
+    fn.call(IndexRange(4), params, context);
+  }
+  EXPECT_EQ(span_mul_calls_num, 1);
+  EXPECT_EQ(outputs[0], 40);
+  EXPECT_EQ(outputs[3], 90);
+}
+
 TEST(multi_function, CustomMF_SI_SI_SI_SO)
 {
   CustomMF_SI_SI_SI_SO<int, std::string, bool, uint> fn{
@@ -334,5 +383,62 @@ TEST(multi_function, IgnoredOutputs)
   }
 }
 
+static void update_max(std::atomic<int64_t> &max, const int64_t value)
+{
+  int64_t old_max = max;
+  while (old_max < value && !max.compare_exchange_weak(old_max, value)) {
+  }
+}
+
+/** Behaves like a function that allocates arrays for all indices, e.g. a procedure executor. */
+class AllocatingAddFunction : public AddFunction {
+ public:
+  mutable std::atomic<int64_t> max_mask_size = 0;
+  mutable std::atomic<int64_t> max_array_size = 0;
+
+  void call(IndexMask mask, MFParams params, MFContext context) const override
+  {
+    update_max(max_mask_size, mask.size());
+    update_max(max_array_size, mask.min_array_size());
+    AddFunction::call(mask, params, context);
+  }
+
+ private:
+  ExecutionHints get_execution_hints() const override
+  {
+    ExecutionHints hints;
+    hints.allocates_array = true;
+    return hints;
+  }
+};
+
+TEST(multi_function, CallAutoChunksAllocatingFunction)
+{
+  AllocatingAddFunction fn;
+
+  const int64_t size = 100000;
+  Array<int> input1(size);
+  Array<int> output(size, -1);
+  for (const int64_t i : input1.index_range()) {
+    input1[i] = int(i);
+  }
+  const int input2 = 10;
+
+  MFParamsBuilder params(fn, size);
+  params.add_readonly_single_input(input1.as_span());
+  params.add_readonly_single_input(&input2);
+  params.add_uninitialized_single_output(output.as_mutable_span());
+
+  MFContextBuilder context;
+  fn.call_auto(IndexRange(size), params, context);
+
+  for (const int64_t i : output.index_range()) {
+    EXPECT_EQ(output[i], i + 10);
+  }
+  /* The function is never called with all indices at once, and the indices are offset. */
+  EXPECT_LE(fn.max_mask_size, 4096);
+  EXPECT_LE(fn.max_array_size, 2 * 4096);
+}
+
 }  // namespace
 }  // namespace blender::fn::tests
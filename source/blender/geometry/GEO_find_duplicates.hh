@@ -0,0 +1,37 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+#include "BLI_index_mask.hh"
+#include "BLI_math_vec_types.hh"
+#include "BLI_span.hh"
+
+/** \file
+ * \ingroup geo
+ */
+
+namespace blender::geometry {
+
+/**
+ * Find selected positions that are within \a merge_distance of another selected position, with
+ * the same results as #BLI_kdtree_3d_calc_duplicates_fast when it uses the index order. The
+ * selection is processed in order: every position that is not merged yet becomes the target of
+ * all positions within the distance that are not merged yet either. There are no chains, so
+ * merged positions are never further apart than the distance.
+ *
+ * The positions are bucketed in a hash grid instead of being sorted into a KD tree, and the
+ * positions without neighbors are found in parallel, so that only the ones that are actually
+ * merged are processed in serial. The result doesn't depend on the number of threads.
+ *
+ * \param r_merge_map: Indexed by the positions. For selected positions it is set to the index of
+ * the position a position is merged into, to the index itself when other positions are merged
+ * into it, and left at -1 otherwise. Selected positions have to be -1 initially, other values are
+ * not changed.
+ * \return The number of merged positions.
+ */
+int find_duplicates_within_distance(Span<float3> positions,
+                                    IndexMask selection,
+                                    float merge_distance,
+                                    MutableSpan<int> r_merge_map);
+
+}  // namespace blender::geometry
@@ -0,0 +1,228 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "BLI_array.hh"
+#include "BLI_kdtree.h"
+#include "BLI_map.hh"
+#include "BLI_math_vector.hh"
+#include "BLI_task.hh"
+
+#include "GEO_find_duplicates.hh"
+
+namespace blender::geometry {
+
+/* Cell coordinates of every axis are packed into 21 bits of the cell key. */
+static constexpr int cell_axis_bits = 21;
+static constexpr int64_t max_cells_per_axis = int64_t(1) << cell_axis_bits;
+
+struct DuplicateGrid {
+  float3 min;
+  float cell_size_inv;
+  int3 cells_num;
+  Map<uint64_t, int> cell_indices;
+  /** Indices into the selection of the positions in each cell, in increasing order. */
+  Array<int> cell_offsets;
+  Array<int> cell_points;
+
+  int3 cell_coord(const float3 &position) const
+  {
+    const float3 co = (position - min) * cell_size_inv;
+    return int3(std::min(int(co.x), cells_num.x - 1),
+                std::min(int(co.y), cells_num.y - 1),
+                std::min(int(co.z), cells_num.z - 1));
+  }
+
+  static uint64_t cell_key(const int3 &coord)
+  {
+    return uint64_t(coord.x) | (uint64_t(coord.y) << cell_axis_bits) |
+           (uint64_t(coord.z) << (2 * cell_axis_bits));
+  }
+
+  /**
+   * Call the function for the positions in the cell of the coordinate and its neighbors, until it
+   * returns false.
+   */
+  template<typename Fn> void foreach_neighbor_point(const int3 &coord, const Fn &fn) const
+  {
+    for (int z = std::max(coord.z - 1, 0); z <= std::min(coord.z + 1, cells_num.z - 1); z++) {
+      for (int y = std::max(coord.y - 1, 0); y <= std::min(coord.y + 1, cells_num.y - 1); y++) {
+        for (int x = std::max(coord.x - 1, 0); x <= std::min(coord.x + 1, cells_num.x - 1); x++) {
+          const int *cell_index = cell_indices.lookup_ptr(cell_key(int3(x, y, z)));
+          if (cell_index == nullptr) {
+            continue;
+          }
+          for (const int i : IndexRange(cell_offsets[*cell_index],
+                                        cell_offsets[*cell_index + 1] -
+                                            cell_offsets[*cell_index])) {
+            if (!fn(cell_points[i])) {
+              return;
+            }
+          }
+        }
+      }
+    }
+  }
+};
+
+/**
+ * The grid can't be used for a distance of zero or when it would have too many cells. A KD tree
+ * with the same processing order handles those.
+ */
+static int find_duplicates_kdtree(Span<float3> positions,
+                                  const float merge_distance,
+                                  MutableSpan<int> selection_merge_map)
+{
+  KDTree_3d *tree = BLI_kdtree_3d_new(positions.size());
+  for (const int i : positions.index_range()) {
+    BLI_kdtree_3d_insert(tree, i, positions[i]);
+  }
+  BLI_kdtree_3d_balance(tree);
+  const int duplicates_num = BLI_kdtree_3d_calc_duplicates_fast(
+      tree, merge_distance, true, selection_merge_map.data());
+  BLI_kdtree_3d_free(tree);
+  return duplicates_num;
+}
+
+int find_duplicates_within_distance(Span<float3> positions,
+                                    const IndexMask selection,
+                                    const float merge_distance,
+                                    MutableSpan<int> r_merge_map)
+{
+  if (selection.is_empty()) {
+    return 0;
+  }
+
+  /* Work with a compact copy of the selected positions, indices are indices into the selection
+   * until the result is written. */
+  Array<float3> selected_positions(selection.size());
+  threading::parallel_for(selection.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      selected_positions[i] = positions[selection[i]];
+    }
+  });
+
+  using Bounds = std::pair<float3, float3>;
+  const Bounds bounds = threading::parallel_reduce(
+      selected_positions.index_range(),
+      4096,
+      Bounds(float3(FLT_MAX), float3(-FLT_MAX)),
+      [&](const IndexRange range, const Bounds &init) {
+        Bounds result = init;
+        for (const int i : range) {
+          result.first = math::min(result.first, selected_positions[i]);
+          result.second = math::max(result.second, selected_positions[i]);
+        }
+        return result;
+      },
+      [](const Bounds &a, const Bounds &b) {
+        return Bounds(math::min(a.first, b.first), math::max(a.second, b.second));
+      });
+
+  /* Positions within the distance are at most one cell apart. The cells are slightly larger than
+   * the distance, so that rounding doesn't move them further apart at exactly the distance. */
+  const float cell_size = merge_distance * 1.001f;
+  const float3 cells_num_fl = merge_distance > 0.0f ?
+                                  (bounds.second - bounds.first) / cell_size + 1.0f :
+                                  float3(FLT_MAX);
+
+  Array<int> selection_merge_map(selection.size(), -1);
+  int duplicates_num = 0;
+
+  if (!(cells_num_fl.x < max_cells_per_axis) || !(cells_num_fl.y < max_cells_per_axis) ||
+      !(cells_num_fl.z < max_cells_per_axis)) {
+    duplicates_num = find_duplicates_kdtree(
+        selected_positions, merge_distance, selection_merge_map);
+  }
+  else {
+    DuplicateGrid grid;
+    grid.min = bounds.first;
+    grid.cell_size_inv = 1.0f / cell_size;
+    grid.cells_num = int3(cells_num_fl);
+
+    Array<uint64_t> point_keys(selection.size());
+    threading::parallel_for(selection.index_range(), 4096, [&](const IndexRange range) {
+      for (const int i : range) {
+        point_keys[i] = DuplicateGrid::cell_key(grid.cell_coord(selected_positions[i]));
+      }
+    });
+
+    /* Count the positions in each cell, then fill the cells in the order of the positions. */
+    Array<int> point_cells(selection.size());
+    Vector<int> cell_sizes;
+    for (const int i : selection.index_range()) {
+      const int cell_index = grid.cell_indices.lookup_or_add_cb(point_keys[i], [&]() {
+        cell_sizes.append(0);
+        return int(cell_sizes.size() - 1);
+      });
+      point_cells[i] = cell_index;
+      cell_sizes[cell_index]++;
+    }
+    grid.cell_offsets.reinitialize(cell_sizes.size() + 1);
+    int offset = 0;
+    for (const int cell_index : cell_sizes.index_range()) {
+      grid.cell_offsets[cell_index] = offset;
+      offset += cell_sizes[cell_index];
+    }
+    grid.cell_offsets.last() = offset;
+    grid.cell_points.reinitialize(selection.size());
+    cell_sizes.fill(0);
+    for (const int i : selection.index_range()) {
+      const int cell_index = point_cells[i];
+      grid.cell_points[grid.cell_offsets[cell_index] + cell_sizes[cell_index]] = i;
+      cell_sizes[cell_index]++;
+    }
+
+    const float merge_distance_sq = merge_distance * merge_distance;
+
+    /* Most positions usually have no neighbor at all. Finding them doesn't depend on the order, so
+     * it is done in parallel. */
+    Array<bool> has_neighbor(selection.size());
+    threading::parallel_for(selection.index_range(), 1024, [&](const IndexRange range) {
+      for (const int i : range) {
+        const float3 &co = selected_positions[i];
+        bool found = false;
+        grid.foreach_neighbor_point(grid.cell_coord(co), [&](const int other) {
+          if (other != i && math::distance_squared(co, selected_positions[other]) <=
+                                merge_distance_sq) {
+            found = true;
+          }
+          return !found;
+        });
+        has_neighbor[i] = found;
+      }
+    });
+
+    /* Whether a position is merged depends on the positions before it, so the remaining ones are
+     * processed in order. */
+    for (const int i : selection.index_range()) {
+      if (!has_neighbor[i] || selection_merge_map[i] != -1) {
+        continue;
+      }
+      const float3 &co = selected_positions[i];
+      const int duplicates_num_prev = duplicates_num;
+      grid.foreach_neighbor_point(grid.cell_coord(co), [&](const int other) {
+        if (other != i && selection_merge_map[other] == -1 &&
+            math::distance_squared(co, selected_positions[other]) <= merge_distance_sq) {
+          selection_merge_map[other] = i;
+          duplicates_num++;
+        }
+        return true;
+      });
+      if (duplicates_num != duplicates_num_prev) {
+        /* Prevent chains of merged positions. */
+        selection_merge_map[i] = i;
+      }
+    }
+  }
+
+  threading::parallel_for(selection.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const int merge_index = selection_merge_map[i];
+      if (merge_index != -1) {
+        r_merge_map[selection[i]] = selection[merge_index];
+      }
+    }
+  });
+  return duplicates_num;
+}
+
+}  // namespace blender::geometry
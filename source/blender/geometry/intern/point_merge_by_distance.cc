@@ -1,6 +1,5 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
 
-#include "BLI_kdtree.h"
 #include "BLI_task.hh"
 
 #include "DNA_pointcloud_types.h"
@@ -9,6 +8,7 @@
 #include "BKE_geometry_set.hh"
 #include "BKE_pointcloud.h"
 
+#include "GEO_find_duplicates.hh"
 #include "GEO_point_merge_by_distance.hh"
 
 namespace blender::geometry {
@@ -21,21 +21,9 @@ PointCloud *point_merge_by_distance(const PointCloudComponent &src_points,
   const int src_size = src_pointcloud.totpoint;
   Span<float3> positions{reinterpret_cast<float3 *>(src_pointcloud.co), src_size};
 
-  /* Create the KD tree based on only the selected points, to speed up merge detection and
-   * balancing. */
-  KDTree_3d *tree = BLI_kdtree_3d_new(selection.size());
-  for (const int i : selection.index_range()) {
-    BLI_kdtree_3d_insert(tree, i, positions[selection[i]]);
-  }
-  BLI_kdtree_3d_balance(tree);
-
-  /* Find the duplicates in the KD tree. Because the tree only contains the selected points, the
-   * resulting indices are indices into the selection, rather than indices of the source point
-   * cloud. */
-  Array<int> selection_merge_indices(selection.size(), -1);
-  const int duplicate_count = BLI_kdtree_3d_calc_duplicates_fast(
-      tree, merge_distance, false, selection_merge_indices.data());
-  BLI_kdtree_3d_free(tree);
+  Array<int> merge_indices(src_size, -1);
+  const int duplicate_count = find_duplicates_within_distance(
+      positions, selection, merge_distance, merge_indices);
 
   /* Create the new point cloud and add it to a temporary component for the attribute API. */
   const int dst_size = src_size - duplicate_count;
@@ -43,21 +31,14 @@ PointCloud *point_merge_by_distance(const PointCloudComponent &src_points,
   PointCloudComponent dst_points;
   dst_points.replace(dst_pointcloud, GeometryOwnershipType::Editable);
 
-  /* By default, every point is just "merged" with itself. Then fill in the results of the merge
-   * finding, converting from indices into the selection to indices into the full input point
-   * cloud. */
-  Array<int> merge_indices(src_size);
-  for (const int i : merge_indices.index_range()) {
-    merge_indices[i] = i;
-  }
-  for (const int i : selection_merge_indices.index_range()) {
-    const int merge_index = selection_merge_indices[i];
-    if (merge_index != -1) {
-      const int src_merge_index = selection[merge_index];
-      const int src_index = selection[i];
-      merge_indices[src_index] = src_merge_index;
+  /* By default, every point is just "merged" with itself. */
+  threading::parallel_for(merge_indices.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      if (merge_indices[i] == -1) {
+        merge_indices[i] = i;
+      }
     }
-  }
+  });
 
   /* For every source index, find the corresponding index in the result by iterating through the
    * source indices and counting how many merges happened before that point. */
@@ -387,20 +387,29 @@ static Vector<std::pair<int, GSpan>> prepare_attribute_fallbacks(
 }
 
 /**
- * Calls #fn for every geometry in the given #InstanceReference. Also passes on the transformation
- * that is applied to every instance.
+ * A geometry that is instanced by an #InstanceReference. A collection reference contains one
+ * geometry for every object in it.
  */
-static void foreach_geometry_in_reference(
-    const InstanceReference &reference,
-    const float4x4 &base_transform,
-    const uint32_t id,
-    FunctionRef<void(const GeometrySet &geometry_set, const float4x4 &transform, uint32_t id)> fn)
+struct InstanceReferenceGeometry {
+  GeometrySet geometry_set;
+  /** Transform relative to the instance. */
+  float4x4 transform;
+  /** Index of the object in a collection that is mixed into the id, or -1. */
+  int sub_id_index;
+};
+
+/**
+ * Get all geometries in the given #InstanceReference. This is done once for every reference
+ * instead of for every instance, because getting the evaluated geometry of objects is not free.
+ */
+static Vector<InstanceReferenceGeometry> get_instance_reference_geometries(
+    const InstanceReference &reference)
 {
+  Vector<InstanceReferenceGeometry> geometries;
   switch (reference.type()) {
     case InstanceReference::Type::Object: {
       const Object &object = reference.object();
-      const GeometrySet object_geometry_set = object_get_evaluated_geometry_set(object);
-      fn(object_geometry_set, base_transform, id);
+      geometries.append({object_get_evaluated_geometry_set(object), float4x4::identity(), -1});
       break;
     }
     case InstanceReference::Type::Collection: {
@@ -409,24 +418,23 @@ static void foreach_geometry_in_reference(
       sub_v3_v3(offset_matrix.values[3], collection.instance_offset);
       int index = 0;
       FOREACH_COLLECTION_OBJECT_RECURSIVE_BEGIN (&collection, object) {
-        const GeometrySet object_geometry_set = object_get_evaluated_geometry_set(*object);
-        const float4x4 matrix = base_transform * offset_matrix * object->obmat;
-        const int sub_id = noise::hash(id, index);
-        fn(object_geometry_set, matrix, sub_id);
+        geometries.append({object_get_evaluated_geometry_set(*object),
+                           offset_matrix * float4x4(object->obmat),
+                           index});
         index++;
       }
       FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
       break;
     }
     case InstanceReference::Type::GeometrySet: {
-      const GeometrySet &instance_geometry_set = reference.geometry_set();
-      fn(instance_geometry_set, base_transform, id);
+      geometries.append({reference.geometry_set(), float4x4::identity(), -1});
       break;
     }
     case InstanceReference::Type::None: {
       break;
     }
   }
+  return geometries;
 }
 
 static void gather_realize_tasks_for_instances(GatherTasksInfo &gather_info,
@@ -455,10 +463,14 @@ static void gather_realize_tasks_for_instances(GatherTasksInfo &gather_info,
   Vector<std::pair<int, GSpan>> curve_attributes_to_override = prepare_attribute_fallbacks(
       gather_info, instances_component, gather_info.curves.attributes);
 
+  Array<Vector<InstanceReferenceGeometry>> reference_geometries(references.size());
+  for (const int handle : references.index_range()) {
+    reference_geometries[handle] = get_instance_reference_geometries(references[handle]);
+  }
+
   for (const int i : transforms.index_range()) {
     const int handle = handles[i];
     const float4x4 &transform = transforms[i];
-    const InstanceReference &reference = references[handle];
     const float4x4 new_base_transform = base_transform * transform;
 
     /* Update attribute fallbacks for the current instance. */
@@ -484,18 +496,15 @@ static void gather_realize_tasks_for_instances(GatherTasksInfo &gather_info,
     const uint32_t instance_id = noise::hash(base_instance_context.id, local_instance_id);
 
     /* Add realize tasks for all referenced geometry sets recursively. */
-    foreach_geometry_in_reference(reference,
-                                  new_base_transform,
-                                  instance_id,
-                                  [&](const GeometrySet &instance_geometry_set,
-                                      const float4x4 &transform,
-                                      const uint32_t id) {
-                                    instance_context.id = id;
-                                    gather_realize_tasks_recursive(gather_info,
-                                                                   instance_geometry_set,
-                                                                   transform,
-                                                                   instance_context);
-                                  });
+    for (const InstanceReferenceGeometry &geometry : reference_geometries[handle]) {
+      instance_context.id = geometry.sub_id_index == -1 ?
+                                instance_id :
+                                noise::hash(instance_id, geometry.sub_id_index);
+      gather_realize_tasks_recursive(gather_info,
+                                     geometry.geometry_set,
+                                     new_base_transform * geometry.transform,
+                                     instance_context);
+    }
   }
 }
 
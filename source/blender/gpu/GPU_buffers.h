@@ -75,6 +75,8 @@ enum {
   GPU_PBVH_BUFFERS_SHOW_MASK = (1 << 1),
   GPU_PBVH_BUFFERS_SHOW_VCOL = (1 << 2),
   GPU_PBVH_BUFFERS_SHOW_SCULPT_FACE_SETS = (1 << 3),
+  /** Only the mask, colors or face sets changed, mesh buffers keep their positions. */
+  GPU_PBVH_BUFFERS_PAINT_ONLY = (1 << 4),
 };
 
 /**
@@ -102,6 +104,9 @@ void GPU_pbvh_bmesh_buffers_update(GPU_PBVH_Buffers *buffers,
                                    struct GSet *bm_faces,
                                    struct GSet *bm_unique_verts,
                                    struct GSet *bm_other_verts,
+                                   int node_index,
+                                   int cd_vert_node_offset,
+                                   int cd_vert_draw_index_offset,
                                    int update_flags);
 
 /**
@@ -0,0 +1,66 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2022 Blender Foundation. All rights reserved. */
+
+/** \file
+ * \ingroup gpu
+ *
+ * GPUCommandList records shader binds, uniform updates, state changes and batch draws without
+ * touching the GPU context. This allows building the draw commands on worker threads, while only
+ * the submission happens on the thread owning the context. Lists are executed in the order they
+ * are submitted.
+ *
+ * Recording a list is not thread safe, each thread must record its own list. The recorded
+ * shaders and batches must stay valid until the list is submitted.
+ */
+
+#pragma once
+
+#include "GPU_state.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct GPUBatch;
+struct GPUShader;
+
+typedef struct GPUCommandList GPUCommandList;
+
+GPUCommandList *GPU_command_list_create(void);
+void GPU_command_list_discard(GPUCommandList *list);
+
+/** Remove all recorded commands, keeping the allocated memory for the next recording. */
+void GPU_command_list_clear(GPUCommandList *list);
+
+/** Following uniforms and draws use this shader. */
+void GPU_command_list_shader_bind(GPUCommandList *list, struct GPUShader *shader);
+/** The values are copied, \a value can be freed after the call. */
+void GPU_command_list_uniform_vector(
+    GPUCommandList *list, int location, int length, int arraysize, const float *value);
+void GPU_command_list_uniform_vector_int(
+    GPUCommandList *list, int location, int length, int arraysize, const int *value);
+void GPU_command_list_state_set(GPUCommandList *list,
+                                eGPUWriteMask write_mask,
+                                eGPUBlend blend,
+                                eGPUFaceCullTest culling_test,
+                                eGPUDepthTest depth_test,
+                                eGPUStencilTest stencil_test,
+                                eGPUStencilOp stencil_op,
+                                eGPUProvokingVertex provoking_vert);
+/** Same arguments as #GPU_batch_draw_advanced. */
+void GPU_command_list_batch_draw(GPUCommandList *list,
+                                 struct GPUBatch *batch,
+                                 int v_first,
+                                 int v_count,
+                                 int i_first,
+                                 int i_count);
+
+/**
+ * Execute the recorded commands. Needs an active GPU context.
+ * The list is not cleared and can be submitted again.
+ */
+void GPU_command_list_submit(GPUCommandList *list);
+
+#ifdef __cplusplus
+}
+#endif
@@ -29,6 +29,26 @@ void GPU_debug_get_groups_names(int name_buf_len, char *r_name_buf);
  */
 bool GPU_debug_group_match(const char *ref);
 
+/**
+ * Queries of the GPU time spent on a sequence of commands, used for profiling.
+ * Queries can't be nested or interleaved. The results of all queries are read at once, which
+ * waits for the GPU to finish them, so they are usually read a frame later.
+ */
+typedef struct GPUDebugTimers GPUDebugTimers;
+
+/**
+ * \return NULL if the backend doesn't support timer queries.
+ */
+GPUDebugTimers *GPU_debug_timers_create(void);
+void GPU_debug_timers_free(GPUDebugTimers *timers);
+void GPU_debug_timers_begin(GPUDebugTimers *timers);
+void GPU_debug_timers_end(GPUDebugTimers *timers);
+/**
+ * Read the GPU time of every query, in nanoseconds.
+ * \param len: Must be the number of queries that were issued.
+ */
+void GPU_debug_timers_result_get(GPUDebugTimers *timers, uint64_t *r_times, int len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -34,6 +34,16 @@ void immBegin(GPUPrimType, uint vertex_len);
 void immBeginAtMost(GPUPrimType, uint max_vertex_len);
 void immEnd(void); /* finishes and draws. */
 
+/**
+ * Delay the draw calls of #immEnd to merge consecutive draws of points, lines or triangles that
+ * use the same built-in color shader, vertex format, uniforms and state into a single draw call.
+ * Disabling issues the pending draw call.
+ */
+void immBatchingSet(bool enable);
+/** Number of draw calls issued by immediate mode and draws that were merged into them. */
+void immStatsReset(void);
+void immStatsGet(uint *r_draw_call_len, uint *r_merged_draw_len);
+
 /* - #immBegin a batch, then use standard `imm*` functions as usual.
  * - #immEnd will finalize the batch instead of drawing.
  *
@@ -349,8 +349,10 @@ typedef enum eGPUBuiltinShader {
   GPU_SHADER_2D_WIDGET_SHADOW,
   GPU_SHADER_2D_NODELINK,
   GPU_SHADER_2D_NODELINK_INST,
+  /* sequencer strip blending, a compute shader */
+  GPU_SHADER_SEQUENCER_BLEND,
 } eGPUBuiltinShader;
-#define GPU_SHADER_BUILTIN_LEN (GPU_SHADER_2D_NODELINK_INST + 1)
+#define GPU_SHADER_BUILTIN_LEN (GPU_SHADER_SEQUENCER_BLEND + 1)
 
 /** Support multiple configurations. */
 typedef enum eGPUShaderConfig {
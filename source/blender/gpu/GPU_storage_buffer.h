@@ -47,6 +47,12 @@ void GPU_storagebuf_clear(GPUStorageBuf *ssbo,
                           void *data);
 void GPU_storagebuf_clear_to_zero(GPUStorageBuf *ssbo);
 
+/**
+ * Download the whole content of the buffer into \a data, blocking until the GPU is done with it.
+ * Writes from shaders need a #GPU_BARRIER_SHADER_STORAGE memory barrier before.
+ */
+void GPU_storagebuf_read(GPUStorageBuf *ssbo, void *data);
+
 #ifdef __cplusplus
 }
 #endif
@@ -326,6 +326,7 @@ bool GPU_texture_cube(const GPUTexture *tex);
 bool GPU_texture_depth(const GPUTexture *tex);
 bool GPU_texture_stencil(const GPUTexture *tex);
 bool GPU_texture_integer(const GPUTexture *tex);
+bool GPU_texture_is_compressed(const GPUTexture *tex);
 
 #ifndef GPU_NO_USE_PY_REFERENCES
 void **GPU_texture_py_reference_get(GPUTexture *tex);
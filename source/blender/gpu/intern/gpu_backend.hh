@@ -17,6 +17,7 @@ namespace gpu {
 class Context;
 
 class Batch;
+class CommandList;
 class DrawList;
 class FrameBuffer;
 class IndexBuf;
@@ -40,6 +41,7 @@ class GPUBackend {
   virtual Context *context_alloc(void *ghost_window) = 0;
 
   virtual Batch *batch_alloc() = 0;
+  virtual CommandList *commandlist_alloc() = 0;
   virtual DrawList *drawlist_alloc(int list_length) = 0;
   virtual FrameBuffer *framebuffer_alloc(const char *name) = 0;
   virtual IndexBuf *indexbuf_alloc() = 0;
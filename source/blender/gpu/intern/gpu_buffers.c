@@ -51,6 +51,9 @@ struct GPU_PBVH_Buffers {
   GPUIndexBuf *index_buf, *index_buf_fast;
   GPUIndexBuf *index_lines_buf, *index_lines_buf_fast;
   GPUVertBuf *vert_buf;
+  /* Mesh nodes only: mask, color and face set attributes, kept apart from the positions and
+   * normals in `vert_buf` so strokes only upload the attributes they change. */
+  GPUVertBuf *vert_buf_paint;
 
   GPUBatch *lines;
   GPUBatch *lines_fast;
@@ -91,6 +94,9 @@ struct GPU_PBVH_Buffers {
 static struct {
   GPUVertFormat format;
   uint pos, nor, msk, col, fset;
+  /* Formats of the separate geometry and paint buffers of mesh nodes. */
+  GPUVertFormat format_geom, format_paint;
+  uint geom_pos, geom_nor, paint_msk, paint_col, paint_fset;
 } g_vbo_id = {{0}};
 
 /** \} */
@@ -114,6 +120,17 @@ void gpu_pbvh_init()
         &g_vbo_id.format, "ac", GPU_COMP_U16, 4, GPU_FETCH_INT_TO_FLOAT_UNIT);
     g_vbo_id.fset = GPU_vertformat_attr_add(
         &g_vbo_id.format, "fset", GPU_COMP_U8, 3, GPU_FETCH_INT_TO_FLOAT_UNIT);
+
+    g_vbo_id.geom_pos = GPU_vertformat_attr_add(
+        &g_vbo_id.format_geom, "pos", GPU_COMP_F32, 3, GPU_FETCH_FLOAT);
+    g_vbo_id.geom_nor = GPU_vertformat_attr_add(
+        &g_vbo_id.format_geom, "nor", GPU_COMP_I16, 3, GPU_FETCH_INT_TO_FLOAT_UNIT);
+    g_vbo_id.paint_msk = GPU_vertformat_attr_add(
+        &g_vbo_id.format_paint, "msk", GPU_COMP_U8, 1, GPU_FETCH_INT_TO_FLOAT_UNIT);
+    g_vbo_id.paint_col = GPU_vertformat_attr_add(
+        &g_vbo_id.format_paint, "ac", GPU_COMP_U16, 4, GPU_FETCH_INT_TO_FLOAT_UNIT);
+    g_vbo_id.paint_fset = GPU_vertformat_attr_add(
+        &g_vbo_id.format_paint, "fset", GPU_COMP_U8, 3, GPU_FETCH_INT_TO_FLOAT_UNIT);
   }
 }
 
@@ -124,58 +141,71 @@ void gpu_pbvh_exit()
 
 /* Allocates a non-initialized buffer to be sent to GPU.
  * Return is false it indicates that the memory map failed. */
-static bool gpu_pbvh_vert_buf_data_set(GPU_PBVH_Buffers *buffers, uint vert_len)
+static bool gpu_pbvh_vert_buf_data_set(GPUVertBuf **vert_buf,
+                                       const GPUVertFormat *format,
+                                       uint vert_len)
 {
   /* Keep so we can test #GPU_USAGE_DYNAMIC buffer use.
    * Not that format initialization match in both blocks.
    * Do this to keep braces balanced - otherwise indentation breaks. */
 #if 0
-  if (buffers->vert_buf == NULL) {
+  if (*vert_buf == NULL) {
     /* Initialize vertex buffer (match 'VertexBufferFormat'). */
-    buffers->vert_buf = GPU_vertbuf_create_with_format_ex(&g_vbo_id.format, GPU_USAGE_DYNAMIC);
-    GPU_vertbuf_data_alloc(buffers->vert_buf, vert_len);
+    *vert_buf = GPU_vertbuf_create_with_format_ex(format, GPU_USAGE_DYNAMIC);
+    GPU_vertbuf_data_alloc(*vert_buf, vert_len);
   }
-  else if (vert_len != buffers->vert_buf->vertex_len) {
-    GPU_vertbuf_data_resize(buffers->vert_buf, vert_len);
+  else if (vert_len != (*vert_buf)->vertex_len) {
+    GPU_vertbuf_data_resize(*vert_buf, vert_len);
   }
 #else
-  if (buffers->vert_buf == NULL) {
+  if (*vert_buf == NULL) {
     /* Initialize vertex buffer (match 'VertexBufferFormat'). */
-    buffers->vert_buf = GPU_vertbuf_create_with_format_ex(&g_vbo_id.format, GPU_USAGE_STATIC);
+    *vert_buf = GPU_vertbuf_create_with_format_ex(format, GPU_USAGE_STATIC);
   }
-  if (GPU_vertbuf_get_data(buffers->vert_buf) == NULL ||
-      GPU_vertbuf_get_vertex_len(buffers->vert_buf) != vert_len) {
+  if (GPU_vertbuf_get_data(*vert_buf) == NULL ||
+      GPU_vertbuf_get_vertex_len(*vert_buf) != vert_len) {
     /* Allocate buffer if not allocated yet or size changed. */
-    GPU_vertbuf_data_alloc(buffers->vert_buf, vert_len);
+    GPU_vertbuf_data_alloc(*vert_buf, vert_len);
   }
 #endif
 
-  return GPU_vertbuf_get_data(buffers->vert_buf) != NULL;
+  return GPU_vertbuf_get_data(*vert_buf) != NULL;
+}
+
+static GPUBatch *gpu_pbvh_batch_create(GPU_PBVH_Buffers *buffers,
+                                       GPUPrimType prim,
+                                       GPUIndexBuf *index_buf)
+{
+  GPUBatch *batch = GPU_batch_create(prim, buffers->vert_buf, index_buf);
+  if (buffers->vert_buf_paint) {
+    GPU_batch_vertbuf_add(batch, buffers->vert_buf_paint);
+  }
+  return batch;
 }
 
 static void gpu_pbvh_batch_init(GPU_PBVH_Buffers *buffers, GPUPrimType prim)
 {
   if (buffers->triangles == NULL) {
-    buffers->triangles = GPU_batch_create(prim,
-                                          buffers->vert_buf,
-                                          /* can be NULL if buffer is empty */
-                                          buffers->index_buf);
+    buffers->triangles = gpu_pbvh_batch_create(buffers,
+                                               prim,
+                                               /* can be NULL if buffer is empty */
+                                               buffers->index_buf);
   }
 
   if ((buffers->triangles_fast == NULL) && buffers->index_buf_fast) {
-    buffers->triangles_fast = GPU_batch_create(prim, buffers->vert_buf, buffers->index_buf_fast);
+    buffers->triangles_fast = gpu_pbvh_batch_create(buffers, prim, buffers->index_buf_fast);
   }
 
   if (buffers->lines == NULL) {
-    buffers->lines = GPU_batch_create(GPU_PRIM_LINES,
-                                      buffers->vert_buf,
-                                      /* can be NULL if buffer is empty */
-                                      buffers->index_lines_buf);
+    buffers->lines = gpu_pbvh_batch_create(buffers,
+                                           GPU_PRIM_LINES,
+                                           /* can be NULL if buffer is empty */
+                                           buffers->index_lines_buf);
   }
 
   if ((buffers->lines_fast == NULL) && buffers->index_lines_buf_fast) {
-    buffers->lines_fast = GPU_batch_create(
-        GPU_PRIM_LINES, buffers->vert_buf, buffers->index_lines_buf_fast);
+    buffers->lines_fast = gpu_pbvh_batch_create(
+        buffers, GPU_PRIM_LINES, buffers->index_lines_buf_fast);
   }
 }
 
@@ -222,21 +252,29 @@ void GPU_pbvh_mesh_buffers_update(GPU_PBVH_Buffers *buffers,
 
   {
     const int totelem = buffers->tot_tri * 3;
+    /* Positions and normals are kept when only the mask, colors or face sets changed. */
+    const bool update_geom = (update_flags & GPU_PBVH_BUFFERS_PAINT_ONLY) == 0 ||
+                             buffers->vert_buf == NULL ||
+                             GPU_vertbuf_get_vertex_len(buffers->vert_buf) != totelem;
 
     /* Build VBO */
-    if (gpu_pbvh_vert_buf_data_set(buffers, totelem)) {
+    if ((!update_geom ||
+         gpu_pbvh_vert_buf_data_set(&buffers->vert_buf, &g_vbo_id.format_geom, totelem)) &&
+        gpu_pbvh_vert_buf_data_set(&buffers->vert_buf_paint, &g_vbo_id.format_paint, totelem)) {
       GPUVertBufRaw pos_step = {0};
       GPUVertBufRaw nor_step = {0};
       GPUVertBufRaw msk_step = {0};
       GPUVertBufRaw fset_step = {0};
       GPUVertBufRaw col_step = {0};
 
-      GPU_vertbuf_attr_get_raw_data(buffers->vert_buf, g_vbo_id.pos, &pos_step);
-      GPU_vertbuf_attr_get_raw_data(buffers->vert_buf, g_vbo_id.nor, &nor_step);
-      GPU_vertbuf_attr_get_raw_data(buffers->vert_buf, g_vbo_id.msk, &msk_step);
-      GPU_vertbuf_attr_get_raw_data(buffers->vert_buf, g_vbo_id.fset, &fset_step);
+      if (update_geom) {
+        GPU_vertbuf_attr_get_raw_data(buffers->vert_buf, g_vbo_id.geom_pos, &pos_step);
+        GPU_vertbuf_attr_get_raw_data(buffers->vert_buf, g_vbo_id.geom_nor, &nor_step);
+      }
+      GPU_vertbuf_attr_get_raw_data(buffers->vert_buf_paint, g_vbo_id.paint_msk, &msk_step);
+      GPU_vertbuf_attr_get_raw_data(buffers->vert_buf_paint, g_vbo_id.paint_fset, &fset_step);
       if (show_vcol) {
-        GPU_vertbuf_attr_get_raw_data(buffers->vert_buf, g_vbo_id.col, &col_step);
+        GPU_vertbuf_attr_get_raw_data(buffers->vert_buf_paint, g_vbo_id.paint_col, &col_step);
       }
 
       /* calculate normal for each polygon only once */
@@ -256,7 +294,7 @@ void GPU_pbvh_mesh_buffers_update(GPU_PBVH_Buffers *buffers,
         }
 
         /* Face normal and mask */
-        if (lt->poly != mpoly_prev && !buffers->smooth) {
+        if (update_geom && lt->poly != mpoly_prev && !buffers->smooth) {
           const MPoly *mp = &buffers->mpoly[lt->poly];
           float fno[3];
           BKE_mesh_calc_poly_normal(mp, &buffers->mloop[mp->loopstart], mvert, fno);
@@ -282,13 +320,15 @@ void GPU_pbvh_mesh_buffers_update(GPU_PBVH_Buffers *buffers,
         }
 
         for (uint j = 0; j < 3; j++) {
-          const MVert *v = &mvert[vtri[j]];
-          copy_v3_v3(GPU_vertbuf_raw_step(&pos_step), v->co);
+          if (update_geom) {
+            const MVert *v = &mvert[vtri[j]];
+            copy_v3_v3(GPU_vertbuf_raw_step(&pos_step), v->co);
 
-          if (buffers->smooth) {
-            normal_float_to_short_v3(no, vert_normals[vtri[j]]);
+            if (buffers->smooth) {
+              normal_float_to_short_v3(no, vert_normals[vtri[j]]);
+            }
+            copy_v3_v3_short(GPU_vertbuf_raw_step(&nor_step), no);
           }
-          copy_v3_v3_short(GPU_vertbuf_raw_step(&nor_step), no);
 
           if (show_mask && buffers->smooth) {
             cmask = (uchar)(vmask[vtri[j]] * 255);
@@ -653,7 +693,7 @@ void GPU_pbvh_grid_buffers_update(GPU_PBVH_Buffers *buffers,
 
   uint vbo_index_offset = 0;
   /* Build VBO */
-  if (gpu_pbvh_vert_buf_data_set(buffers, vert_count)) {
+  if (gpu_pbvh_vert_buf_data_set(&buffers->vert_buf, &g_vbo_id.format, vert_count)) {
     GPUIndexBufBuilder elb_lines;
 
     if (buffers->index_lines_buf == NULL) {
@@ -901,6 +941,9 @@ void GPU_pbvh_bmesh_buffers_update(GPU_PBVH_Buffers *buffers,
                                    GSet *bm_faces,
                                    GSet *bm_unique_verts,
                                    GSet *bm_other_verts,
+                                   const int node_index,
+                                   const int cd_vert_node_offset,
+                                   const int cd_vert_draw_index_offset,
                                    const int update_flags)
 {
   const bool show_mask = (update_flags & GPU_PBVH_BUFFERS_SHOW_MASK) != 0;
@@ -935,7 +978,7 @@ void GPU_pbvh_bmesh_buffers_update(GPU_PBVH_Buffers *buffers,
   const int cd_vert_mask_offset = CustomData_get_offset(&bm->vdata, CD_PAINT_MASK);
 
   /* Fill vertex buffer */
-  if (!gpu_pbvh_vert_buf_data_set(buffers, totvert)) {
+  if (!gpu_pbvh_vert_buf_data_set(&buffers->vert_buf, &g_vbo_id.format, totvert)) {
     /* Memory map failed */
     return;
   }
@@ -948,9 +991,44 @@ void GPU_pbvh_bmesh_buffers_update(GPU_PBVH_Buffers *buffers,
     GPU_indexbuf_init(&elb, GPU_PRIM_TRIS, tottri, totvert);
     GPU_indexbuf_init(&elb_lines, GPU_PRIM_LINES, tottri * 3, totvert);
 
-    GHash *bm_vert_to_index = BLI_ghash_int_new_ex("bm_vert_to_index", totvert);
+    /* Unique vertices are only used by this node, their index in the vertex buffer is stored
+     * on the vertex. Other vertices are shared with nodes updated in parallel, these few are
+     * mapped with a hash. */
+    GHash *bm_vert_to_index = BLI_ghash_ptr_new_ex("bm_vert_to_index",
+                                                   BLI_gset_len(bm_other_verts));
 
     GSetIterator gs_iter;
+    GSET_ITER (gs_iter, bm_unique_verts) {
+      BMVert *v = BLI_gsetIterator_getKey(&gs_iter);
+      if (!BM_elem_flag_test(v, BM_ELEM_HIDDEN)) {
+        BM_ELEM_CD_SET_INT(v, cd_vert_draw_index_offset, v_index);
+        gpu_bmesh_vert_to_buffer_copy(v,
+                                      buffers->vert_buf,
+                                      v_index++,
+                                      NULL,
+                                      NULL,
+                                      cd_vert_mask_offset,
+                                      show_mask,
+                                      show_vcol,
+                                      &empty_mask);
+      }
+    }
+    GSET_ITER (gs_iter, bm_other_verts) {
+      BMVert *v = BLI_gsetIterator_getKey(&gs_iter);
+      if (!BM_elem_flag_test(v, BM_ELEM_HIDDEN)) {
+        BLI_ghash_insert(bm_vert_to_index, v, POINTER_FROM_UINT(v_index));
+        gpu_bmesh_vert_to_buffer_copy(v,
+                                      buffers->vert_buf,
+                                      v_index++,
+                                      NULL,
+                                      NULL,
+                                      cd_vert_mask_offset,
+                                      show_mask,
+                                      show_vcol,
+                                      &empty_mask);
+      }
+    }
+
     GSET_ITER (gs_iter, bm_faces) {
       f = BLI_gsetIterator_getKey(&gs_iter);
 
@@ -960,27 +1038,11 @@ void GPU_pbvh_bmesh_buffers_update(GPU_PBVH_Buffers *buffers,
 
         uint idx[3];
         for (int i = 0; i < 3; i++) {
-          void **idx_p;
-          if (!BLI_ghash_ensure_p(bm_vert_to_index, v[i], &idx_p)) {
-            /* Add vertex to the vertex buffer each time a new one is encountered */
-            *idx_p = POINTER_FROM_UINT(v_index);
-
-            gpu_bmesh_vert_to_buffer_copy(v[i],
-                                          buffers->vert_buf,
-                                          v_index,
-                                          NULL,
-                                          NULL,
-                                          cd_vert_mask_offset,
-                                          show_mask,
-                                          show_vcol,
-                                          &empty_mask);
-
-            idx[i] = v_index;
-            v_index++;
+          if (BM_ELEM_CD_GET_INT(v[i], cd_vert_node_offset) == node_index) {
+            idx[i] = (uint)BM_ELEM_CD_GET_INT(v[i], cd_vert_draw_index_offset);
           }
           else {
-            /* Vertex already in the vertex buffer, just get the index. */
-            idx[i] = POINTER_AS_UINT(*idx_p);
+            idx[i] = POINTER_AS_UINT(BLI_ghash_lookup(bm_vert_to_index, v[i]));
           }
         }
 
@@ -1105,6 +1167,7 @@ static void gpu_pbvh_buffers_clear(GPU_PBVH_Buffers *buffers)
   GPU_INDEXBUF_DISCARD_SAFE(buffers->index_buf_fast);
   GPU_INDEXBUF_DISCARD_SAFE(buffers->index_buf);
   GPU_VERTBUF_DISCARD_SAFE(buffers->vert_buf);
+  GPU_VERTBUF_DISCARD_SAFE(buffers->vert_buf_paint);
 }
 
 void GPU_pbvh_buffers_update_flush(GPU_PBVH_Buffers *buffers)
@@ -1119,6 +1182,9 @@ void GPU_pbvh_buffers_update_flush(GPU_PBVH_Buffers *buffers)
   if (buffers->vert_buf && GPU_vertbuf_get_data(buffers->vert_buf)) {
     GPU_vertbuf_use(buffers->vert_buf);
   }
+  if (buffers->vert_buf_paint && GPU_vertbuf_get_data(buffers->vert_buf_paint)) {
+    GPU_vertbuf_use(buffers->vert_buf_paint);
+  }
 }
 
 void GPU_pbvh_buffers_free(GPU_PBVH_Buffers *buffers)
@@ -77,6 +77,8 @@ struct GPUPass {
   uint32_t hash;
   /** Did we already tried to compile the attached GPUShader. */
   bool compiled;
+  /** Materials sharing the pass can be compiled from multiple threads at the same time. */
+  ThreadMutex compile_lock;
 };
 
 /* -------------------------------------------------------------------- */
@@ -619,7 +621,9 @@ GPUPass *GPU_generate_pass(GPUMaterial *material,
       return nullptr;
     }
     /* No collision, just return the pass. */
+    BLI_spin_lock(&pass_cache_spin);
     pass_hash->refcount += 1;
+    BLI_spin_unlock(&pass_cache_spin);
     return pass_hash;
   }
 
@@ -645,7 +649,9 @@ GPUPass *GPU_generate_pass(GPUMaterial *material,
       /* Shader has already been created but failed to compile. */
       return nullptr;
     }
+    BLI_spin_lock(&pass_cache_spin);
     pass->refcount += 1;
+    BLI_spin_unlock(&pass_cache_spin);
   }
   else {
     /* We still create a pass even if shader compilation
@@ -656,6 +662,7 @@ GPUPass *GPU_generate_pass(GPUMaterial *material,
     pass->create_info = codegen.create_info;
     pass->hash = codegen.hash_get();
     pass->compiled = false;
+    BLI_mutex_init(&pass->compile_lock);
 
     codegen.create_info = nullptr;
 
@@ -714,6 +721,7 @@ static bool gpu_pass_shader_validate(GPUPass *pass, GPUShader *shader)
 bool GPU_pass_compile(GPUPass *pass, const char *shname)
 {
   bool success = true;
+  BLI_mutex_lock(&pass->compile_lock);
   if (!pass->compiled) {
     GPUShaderCreateInfo *info = reinterpret_cast<GPUShaderCreateInfo *>(
         static_cast<ShaderCreateInfo *>(pass->create_info));
@@ -735,6 +743,7 @@ bool GPU_pass_compile(GPUPass *pass, const char *shname)
     pass->shader = shader;
     pass->compiled = true;
   }
+  BLI_mutex_unlock(&pass->compile_lock);
   return success;
 }
 
@@ -745,8 +754,11 @@ GPUShader *GPU_pass_shader_get(GPUPass *pass)
 
 void GPU_pass_release(GPUPass *pass)
 {
+  /* Materials are released from the compilation threads as well. */
+  BLI_spin_lock(&pass_cache_spin);
   BLI_assert(pass->refcount > 0);
   pass->refcount--;
+  BLI_spin_unlock(&pass_cache_spin);
 }
 
 static void gpu_pass_free(GPUPass *pass)
@@ -756,6 +768,7 @@ static void gpu_pass_free(GPUPass *pass)
     GPU_shader_free(pass->shader);
   }
   delete pass->create_info;
+  BLI_mutex_end(&pass->compile_lock);
   MEM_freeN(pass);
 }
 
@@ -0,0 +1,76 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2022 Blender Foundation. All rights reserved. */
+
+/** \file
+ * \ingroup gpu
+ *
+ * Recording of GPU commands on worker threads.
+ */
+
+#include "MEM_guardedalloc.h"
+
+#include "GPU_command_list.h"
+
+#include "gpu_backend.hh"
+
+#include "gpu_command_list_private.hh"
+
+using namespace blender::gpu;
+
+GPUCommandList *GPU_command_list_create()
+{
+  CommandList *list_ptr = GPUBackend::get()->commandlist_alloc();
+  return wrap(list_ptr);
+}
+
+void GPU_command_list_discard(GPUCommandList *list)
+{
+  CommandList *list_ptr = unwrap(list);
+  delete list_ptr;
+}
+
+void GPU_command_list_clear(GPUCommandList *list)
+{
+  unwrap(list)->clear();
+}
+
+void GPU_command_list_shader_bind(GPUCommandList *list, GPUShader *shader)
+{
+  unwrap(list)->shader_bind(shader);
+}
+
+void GPU_command_list_uniform_vector(
+    GPUCommandList *list, int location, int length, int arraysize, const float *value)
+{
+  unwrap(list)->uniform_vector(location, length, arraysize, value);
+}
+
+void GPU_command_list_uniform_vector_int(
+    GPUCommandList *list, int location, int length, int arraysize, const int *value)
+{
+  unwrap(list)->uniform_vector_int(location, length, arraysize, value);
+}
+
+void GPU_command_list_state_set(GPUCommandList *list,
+                                eGPUWriteMask write_mask,
+                                eGPUBlend blend,
+                                eGPUFaceCullTest culling_test,
+                                eGPUDepthTest depth_test,
+                                eGPUStencilTest stencil_test,
+                                eGPUStencilOp stencil_op,
+                                eGPUProvokingVertex provoking_vert)
+{
+  unwrap(list)->state_set(
+      write_mask, blend, culling_test, depth_test, stencil_test, stencil_op, provoking_vert);
+}
+
+void GPU_command_list_batch_draw(
+    GPUCommandList *list, GPUBatch *batch, int v_first, int v_count, int i_first, int i_count)
+{
+  unwrap(list)->batch_draw(batch, v_first, v_count, i_first, i_count);
+}
+
+void GPU_command_list_submit(GPUCommandList *list)
+{
+  unwrap(list)->submit();
+}
@@ -0,0 +1,55 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2022 Blender Foundation. All rights reserved. */
+
+/** \file
+ * \ingroup gpu
+ */
+
+#pragma once
+
+#include "MEM_guardedalloc.h"
+
+#include "GPU_command_list.h"
+
+namespace blender {
+namespace gpu {
+
+/**
+ * Implementation of command lists.
+ * Recording functions must not use the GPU context, they are called from worker threads.
+ */
+class CommandList {
+ public:
+  virtual ~CommandList(){};
+
+  virtual void clear() = 0;
+  virtual void shader_bind(GPUShader *shader) = 0;
+  virtual void uniform_vector(int location, int length, int arraysize, const float *value) = 0;
+  virtual void uniform_vector_int(int location, int length, int arraysize, const int *value) = 0;
+  virtual void state_set(eGPUWriteMask write_mask,
+                         eGPUBlend blend,
+                         eGPUFaceCullTest culling_test,
+                         eGPUDepthTest depth_test,
+                         eGPUStencilTest stencil_test,
+                         eGPUStencilOp stencil_op,
+                         eGPUProvokingVertex provoking_vert) = 0;
+  virtual void batch_draw(GPUBatch *batch, int v_first, int v_count, int i_first, int i_count) = 0;
+  virtual void submit() = 0;
+};
+
+/* Syntactic sugar. */
+static inline GPUCommandList *wrap(CommandList *list)
+{
+  return reinterpret_cast<GPUCommandList *>(list);
+}
+static inline CommandList *unwrap(GPUCommandList *list)
+{
+  return reinterpret_cast<CommandList *>(list);
+}
+static inline const CommandList *unwrap(const GPUCommandList *list)
+{
+  return reinterpret_cast<const CommandList *>(list);
+}
+
+}  // namespace gpu
+}  // namespace blender
@@ -11,7 +11,9 @@
 
 #include "BLI_string.h"
 
+#include "gpu_backend.hh"
 #include "gpu_context_private.hh"
+#include "gpu_query.hh"
 
 #include "GPU_debug.h"
 
@@ -73,3 +75,44 @@ bool GPU_debug_group_match(const char *ref)
   }
   return false;
 }
+
+/* -------------------------------------------------------------------- */
+/** \name Timer Queries
+ * \{ */
+
+static QueryPool *unwrap(GPUDebugTimers *timers)
+{
+  return reinterpret_cast<QueryPool *>(timers);
+}
+
+GPUDebugTimers *GPU_debug_timers_create()
+{
+  QueryPool *queries = GPUBackend::get()->querypool_alloc();
+  if (queries == nullptr) {
+    return nullptr;
+  }
+  queries->init(GPU_QUERY_TIME_ELAPSED);
+  return reinterpret_cast<GPUDebugTimers *>(queries);
+}
+
+void GPU_debug_timers_free(GPUDebugTimers *timers)
+{
+  delete unwrap(timers);
+}
+
+void GPU_debug_timers_begin(GPUDebugTimers *timers)
+{
+  unwrap(timers)->begin_query();
+}
+
+void GPU_debug_timers_end(GPUDebugTimers *timers)
+{
+  unwrap(timers)->end_query();
+}
+
+void GPU_debug_timers_result_get(GPUDebugTimers *timers, uint64_t *r_times, int len)
+{
+  unwrap(timers)->get_time_elapsed_result(MutableSpan<uint64_t>(r_times, len));
+}
+
+/** \} */
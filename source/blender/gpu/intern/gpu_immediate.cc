@@ -32,9 +32,39 @@ void immActivate()
 
 void immDeactivate()
 {
+  immFlushPending();
   imm = nullptr;
 }
 
+void immFlushPending()
+{
+  if (imm == nullptr) {
+    return;
+  }
+  imm->flush_pending();
+  imm->uniform_color_shader = nullptr;
+}
+
+void immBatchingSet(bool enable)
+{
+  if (!enable) {
+    immFlushPending();
+  }
+  imm->use_batching = enable;
+}
+
+void immStatsReset()
+{
+  imm->draw_call_len = 0;
+  imm->merged_draw_len = 0;
+}
+
+void immStatsGet(uint *r_draw_call_len, uint *r_merged_draw_len)
+{
+  *r_draw_call_len = imm->draw_call_len;
+  *r_merged_draw_len = imm->merged_draw_len;
+}
+
 GPUVertFormat *immVertexFormat()
 {
   GPU_vertformat_clear(&imm->vertex_format);
@@ -54,8 +84,11 @@ void immBindShader(GPUShader *shader)
   }
 
   GPU_shader_bind(shader);
-  GPU_matrix_bind(shader);
-  GPU_shader_set_srgb_uniform(shader);
+  if (!imm->use_batching) {
+    /* Already done by #GPU_shader_bind when needed, but setting uniforms prevents merging. */
+    GPU_matrix_bind(shader);
+    GPU_shader_set_srgb_uniform(shader);
+  }
 }
 
 void immBindBuiltinProgram(eGPUBuiltinShader shader_id)
@@ -626,9 +659,15 @@ void immUniformColor4f(float r, float g, float b, float a)
   int32_t uniform_loc = GPU_shader_get_builtin_uniform(imm->shader, GPU_UNIFORM_COLOR);
   BLI_assert(uniform_loc != -1);
   float data[4] = {r, g, b, a};
+  if (imm->use_batching && imm->uniform_color_shader == imm->shader &&
+      equals_v4v4(imm->uniform_color, data)) {
+    /* Keep merging draws using the same color. */
+    return;
+  }
   GPU_shader_uniform_vector(imm->shader, uniform_loc, 4, 1, data);
   /* For wide Line workaround. */
   copy_v4_v4(imm->uniform_color, data);
+  imm->uniform_color_shader = imm->shader;
 }
 
 void immUniformColor4fv(const float rgba[4])
@@ -47,6 +47,14 @@ class Immediate {
   eGPUBuiltinShader builtin_shader_bound = GPU_SHADER_TEXT;
   /** Uniform color: Kept here to update the wide-line shader just before #immBegin. */
   float uniform_color[4];
+  /** Shader #uniform_color was last set on, null if it may have been modified since. */
+  GPUShader *uniform_color_shader = NULL;
+
+  /** Merge consecutive compatible draws, see #immBatchingSet. */
+  bool use_batching = false;
+  /** Draw calls issued and draws merged into a previous draw call, see #immStatsGet. */
+  uint draw_call_len = 0;
+  uint merged_draw_len = 0;
 
  public:
   Immediate(){};
@@ -54,9 +62,16 @@ class Immediate {
 
   virtual uchar *begin() = 0;
   virtual void end() = 0;
+  /** Issue the draw call delayed to be merged with the next draws, if any. */
+  virtual void flush_pending(){};
 };
 
 }  // namespace blender::gpu
 
 void immActivate();
 void immDeactivate();
+/**
+ * Issue the pending merged draw of the active immediate mode before any command that depends on
+ * it or modifies the state it uses (uniforms, shader, frame-buffer, read-backs...).
+ */
+void immFlushPending();
@@ -40,6 +40,7 @@ void GPU_indexbuf_init_ex(GPUIndexBufBuilder *builder,
   builder->index_min = UINT32_MAX;
   builder->index_max = 0;
   builder->prim_type = prim_type;
+  MEM_TagScope tag_scope(MEM_TAG_GPU);
   builder->data = (uint *)MEM_callocN(builder->max_index_len * sizeof(uint), "GPUIndexBuf data");
 }
 
@@ -6,6 +6,7 @@
  */
 
 #include "gpu_context_private.hh"
+#include "gpu_immediate_private.hh"
 #include "gpu_matrix_private.h"
 
 #define SUPPRESS_GENERIC_MATRIX_API
@@ -614,6 +615,7 @@ void GPU_matrix_bind(GPUShader *shader)
    * call this before a draw call if desired matrices are dirty
    * call glUseProgram before this, as glUniform expects program to be bound
    */
+  immFlushPending();
   int32_t MV = GPU_shader_get_builtin_uniform(shader, GPU_UNIFORM_MODELVIEW);
   int32_t P = GPU_shader_get_builtin_uniform(shader, GPU_UNIFORM_PROJECTION);
   int32_t MVP = GPU_shader_get_builtin_uniform(shader, GPU_UNIFORM_MVP);
@@ -15,6 +15,8 @@ namespace blender::gpu {
 
 typedef enum GPUQueryType {
   GPU_QUERY_OCCLUSION = 0,
+  /** GPU time spent between the start and the end of the query, in nanoseconds. */
+  GPU_QUERY_TIME_ELAPSED = 1,
 } GPUQueryType;
 
 class QueryPool {
@@ -40,6 +42,11 @@ class QueryPool {
    * drawn.
    */
   virtual void get_occlusion_result(MutableSpan<uint32_t> r_values) = 0;
+  /**
+   * Must be fed with a buffer large enough to contain all the queries issued.
+   * Result for each query is the elapsed GPU time in nanoseconds.
+   */
+  virtual void get_time_elapsed_result(MutableSpan<uint64_t> r_values) = 0;
 };
 
 }  // namespace blender::gpu
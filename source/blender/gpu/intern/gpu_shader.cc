@@ -16,6 +16,7 @@
 
 #include "gpu_backend.hh"
 #include "gpu_context_private.hh"
+#include "gpu_immediate_private.hh"
 #include "gpu_shader_create_info.hh"
 #include "gpu_shader_create_info_private.hh"
 #include "gpu_shader_dependency_private.h"
@@ -495,6 +496,7 @@ void GPU_shader_bind(GPUShader *gpu_shader)
   Context *ctx = Context::get();
 
   if (ctx->shader != shader) {
+    immFlushPending();
     ctx->shader = shader;
     shader->bind();
     GPU_matrix_bind(gpu_shader);
@@ -513,6 +515,7 @@ void GPU_shader_bind(GPUShader *gpu_shader)
 void GPU_shader_unbind()
 {
 #ifndef NDEBUG
+  immFlushPending();
   Context *ctx = Context::get();
   if (ctx->shader) {
     ctx->shader->unbind();
@@ -630,12 +633,14 @@ int GPU_shader_get_program(GPUShader *shader)
 void GPU_shader_uniform_vector(
     GPUShader *shader, int loc, int len, int arraysize, const float *value)
 {
+  immFlushPending();
   unwrap(shader)->uniform_float(loc, len, arraysize, value);
 }
 
 void GPU_shader_uniform_vector_int(
     GPUShader *shader, int loc, int len, int arraysize, const int *value)
 {
+  immFlushPending();
   unwrap(shader)->uniform_int(loc, len, arraysize, value);
 }
 
@@ -272,6 +272,12 @@ void gpu_shader_create_info_init()
     }
   }
 
+  /* Finalize upfront, materials are compiled from multiple threads and #finalize() modifies the
+   * infos they share as additional infos. */
+  for (ShaderCreateInfo *info : g_create_infos->values()) {
+    info->finalize();
+  }
+
   /* TEST */
   // gpu_shader_create_info_compile_all();
 }
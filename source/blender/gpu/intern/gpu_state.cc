@@ -19,6 +19,7 @@
 #include "GPU_state.h"
 
 #include "gpu_context_private.hh"
+#include "gpu_immediate_private.hh"
 
 #include "gpu_state_private.hh"
 
@@ -286,11 +287,13 @@ bool GPU_mipmap_enabled()
 
 void GPU_flush()
 {
+  immFlushPending();
   Context::get()->flush();
 }
 
 void GPU_finish()
 {
+  immFlushPending();
   Context::get()->finish();
 }
 
@@ -315,6 +318,7 @@ void GPU_bgl_start()
   if (!(ctx && ctx->state_manager)) {
     return;
   }
+  immFlushPending();
   StateManager &state_manager = *(Context::get()->state_manager);
   if (state_manager.use_bgl == false) {
     /* Expected by many addons (see T80169, T81289).
@@ -366,6 +370,7 @@ bool GPU_bgl_get()
 
 void GPU_memory_barrier(eGPUBarrier barrier)
 {
+  immFlushPending();
   Context::get()->state_manager->issue_barrier(barrier);
 }
 
@@ -103,4 +103,9 @@ void GPU_storagebuf_clear_to_zero(GPUStorageBuf *ssbo)
   GPU_storagebuf_clear(ssbo, GPU_R32UI, GPU_DATA_UINT, &data);
 }
 
+void GPU_storagebuf_read(GPUStorageBuf *ssbo, void *data)
+{
+  unwrap(ssbo)->read(data);
+}
+
 /** \} */
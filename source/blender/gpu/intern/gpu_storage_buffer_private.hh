@@ -43,6 +43,7 @@ class StorageBuf {
   virtual void clear(eGPUTextureFormat internal_format,
                      eGPUDataFormat data_format,
                      void *data) = 0;
+  virtual void read(void *data) = 0;
 };
 
 /* Syntactic sugar. */
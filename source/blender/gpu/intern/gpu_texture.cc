@@ -13,6 +13,7 @@
 #include "gpu_backend.hh"
 #include "gpu_context_private.hh"
 #include "gpu_framebuffer_private.hh"
+#include "gpu_immediate_private.hh"
 #include "gpu_vertex_buffer_private.hh"
 
 #include "gpu_texture_private.hh"
@@ -432,6 +433,7 @@ void GPU_texture_update_sub(GPUTexture *tex,
 
 void *GPU_texture_read(GPUTexture *tex_, eGPUDataFormat data_format, int miplvl)
 {
+  immFlushPending();
   Texture *tex = reinterpret_cast<Texture *>(tex_);
   return tex->read(miplvl, data_format);
 }
@@ -657,6 +659,11 @@ bool GPU_texture_integer(const GPUTexture *tex)
   return (reinterpret_cast<const Texture *>(tex)->format_flag_get() & GPU_FORMAT_INTEGER) != 0;
 }
 
+bool GPU_texture_is_compressed(const GPUTexture *tex)
+{
+  return (reinterpret_cast<const Texture *>(tex)->format_flag_get() & GPU_FORMAT_COMPRESSED) != 0;
+}
+
 bool GPU_texture_cube(const GPUTexture *tex)
 {
   return (reinterpret_cast<const Texture *>(tex)->type_get() & GPU_TEXTURE_CUBE) != 0;
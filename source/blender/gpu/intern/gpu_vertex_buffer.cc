@@ -75,6 +75,7 @@ void VertBuf::allocate(uint vert_len)
   BLI_assert(vertex_alloc != vert_len || data == nullptr);
   vertex_len = vertex_alloc = vert_len;
 
+  MEM_TagScope tag_scope(MEM_TAG_GPU);
   this->acquire_data();
 
   flag |= GPU_VERTBUF_DATA_DIRTY;
@@ -86,6 +87,7 @@ void VertBuf::resize(uint vert_len)
   BLI_assert(vertex_alloc != vert_len);
   vertex_len = vertex_alloc = vert_len;
 
+  MEM_TagScope tag_scope(MEM_TAG_GPU);
   this->resize_data();
 
   flag |= GPU_VERTBUF_DATA_DIRTY;
@@ -53,6 +53,7 @@ class MTLBackend : public GPUBackend {
    * objects. */
   Context *context_alloc(void *ghost_window) override;
   Batch *batch_alloc() override;
+  CommandList *commandlist_alloc() override;
   DrawList *drawlist_alloc(int list_length) override;
   FrameBuffer *framebuffer_alloc(const char *name) override;
   IndexBuf *indexbuf_alloc() override;
@@ -43,6 +43,12 @@ Batch *MTLBackend::batch_alloc()
   return nullptr;
 };
 
+CommandList *MTLBackend::commandlist_alloc()
+{
+  /* TODO(Metal): Implement MTLCommandList on top of parallel render command encoders. */
+  return nullptr;
+};
+
 DrawList *MTLBackend::drawlist_alloc(int list_length)
 {
   /* TODO(Metal): Implement MTLDrawList. */
@@ -234,6 +234,7 @@ static void detect_workarounds()
     GLContext::geometry_shader_invocations = false;
     GLContext::layered_rendering_support = false;
     GLContext::native_barycentric_support = false;
+    GLContext::program_binary_support = false;
     GLContext::multi_bind_support = false;
     GLContext::multi_draw_indirect_support = false;
     GLContext::shader_draw_parameters_support = false;
@@ -447,6 +448,7 @@ bool GLContext::geometry_shader_invocations = false;
 bool GLContext::fixed_restart_index_support = false;
 bool GLContext::layered_rendering_support = false;
 bool GLContext::native_barycentric_support = false;
+bool GLContext::program_binary_support = false;
 bool GLContext::multi_bind_support = false;
 bool GLContext::multi_draw_indirect_support = false;
 bool GLContext::shader_draw_parameters_support = false;
@@ -524,6 +526,15 @@ void GLBackend::capabilities_init()
   GLContext::fixed_restart_index_support = GLEW_ARB_ES3_compatibility;
   GLContext::layered_rendering_support = GLEW_AMD_vertex_shader_layer;
   GLContext::native_barycentric_support = GLEW_AMD_shader_explicit_vertex_parameter;
+  if (GLEW_ARB_get_program_binary) {
+    /* Drivers can support the extension without supporting any binary format. */
+    GLint binary_formats_len = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binary_formats_len);
+    GLContext::program_binary_support = binary_formats_len > 0;
+    if (GLContext::program_binary_support) {
+      GLShader::program_binary_cache_prune();
+    }
+  }
   GLContext::multi_bind_support = GLEW_ARB_multi_bind;
   GLContext::multi_draw_indirect_support = GLEW_ARB_multi_draw_indirect;
   GLContext::shader_draw_parameters_support = GLEW_ARB_shader_draw_parameters;
@@ -12,6 +12,7 @@
 #include "BLI_vector.hh"
 
 #include "gl_batch.hh"
+#include "gl_command_list.hh"
 #include "gl_compute.hh"
 #include "gl_context.hh"
 #include "gl_drawlist.hh"
@@ -67,6 +68,11 @@ class GLBackend : public GPUBackend {
     return new GLBatch();
   };
 
+  CommandList *commandlist_alloc() override
+  {
+    return new GLCommandList();
+  };
+
   DrawList *drawlist_alloc(int list_length) override
   {
     return new GLDrawList(list_length);
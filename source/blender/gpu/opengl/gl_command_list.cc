@@ -0,0 +1,150 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2022 Blender Foundation. All rights reserved. */
+
+/** \file
+ * \ingroup gpu
+ *
+ * Command lists replayed on the context thread.
+ */
+
+#include <cstring>
+
+#include "BLI_assert.h"
+
+#include "GPU_batch.h"
+#include "GPU_shader.h"
+
+#include "gl_command_list.hh"
+
+namespace blender::gpu {
+
+void GLCommandList::clear()
+{
+  commands_.clear();
+  uniform_data_.clear();
+  shader_ = nullptr;
+}
+
+void GLCommandList::shader_bind(GPUShader *shader)
+{
+  Command cmd;
+  cmd.type = Type::SHADER_BIND;
+  cmd.shader = shader;
+  commands_.append(cmd);
+  shader_ = shader;
+}
+
+void GLCommandList::uniform_vector(int location, int length, int arraysize, const float *value)
+{
+  BLI_assert_msg(shader_ != nullptr, "A shader must be bound before setting uniforms");
+  if (location == -1) {
+    return;
+  }
+  Command cmd;
+  cmd.type = Type::UNIFORM_FLOAT;
+  cmd.uniform.location = location;
+  cmd.uniform.length = length;
+  cmd.uniform.arraysize = arraysize;
+  cmd.uniform.offset = uniform_data_.size();
+  uniform_data_.extend(Span<float>(value, length * arraysize));
+  commands_.append(cmd);
+}
+
+void GLCommandList::uniform_vector_int(int location, int length, int arraysize, const int *value)
+{
+  BLI_assert_msg(shader_ != nullptr, "A shader must be bound before setting uniforms");
+  if (location == -1) {
+    return;
+  }
+  Command cmd;
+  cmd.type = Type::UNIFORM_INT;
+  cmd.uniform.location = location;
+  cmd.uniform.length = length;
+  cmd.uniform.arraysize = arraysize;
+  cmd.uniform.offset = uniform_data_.size();
+  const int value_len = length * arraysize;
+  uniform_data_.resize(cmd.uniform.offset + value_len);
+  BLI_STATIC_ASSERT(sizeof(int) == sizeof(float), "Uniform data type size mismatch");
+  memcpy(&uniform_data_[cmd.uniform.offset], value, sizeof(int) * value_len);
+  commands_.append(cmd);
+}
+
+void GLCommandList::state_set(eGPUWriteMask write_mask,
+                              eGPUBlend blend,
+                              eGPUFaceCullTest culling_test,
+                              eGPUDepthTest depth_test,
+                              eGPUStencilTest stencil_test,
+                              eGPUStencilOp stencil_op,
+                              eGPUProvokingVertex provoking_vert)
+{
+  Command cmd;
+  cmd.type = Type::STATE_SET;
+  cmd.state.write_mask = write_mask;
+  cmd.state.blend = blend;
+  cmd.state.culling_test = culling_test;
+  cmd.state.depth_test = depth_test;
+  cmd.state.stencil_test = stencil_test;
+  cmd.state.stencil_op = stencil_op;
+  cmd.state.provoking_vert = provoking_vert;
+  commands_.append(cmd);
+}
+
+void GLCommandList::batch_draw(GPUBatch *batch, int v_first, int v_count, int i_first, int i_count)
+{
+  BLI_assert_msg(shader_ != nullptr, "A shader must be bound before drawing");
+  Command cmd;
+  cmd.type = Type::BATCH_DRAW;
+  cmd.draw.batch = batch;
+  cmd.draw.v_first = v_first;
+  cmd.draw.v_count = v_count;
+  cmd.draw.i_first = i_first;
+  cmd.draw.i_count = i_count;
+  commands_.append(cmd);
+}
+
+void GLCommandList::submit()
+{
+  GPUShader *shader = nullptr;
+  for (const Command &cmd : commands_) {
+    switch (cmd.type) {
+      case Type::SHADER_BIND:
+        shader = cmd.shader;
+        GPU_shader_bind(shader);
+        break;
+      case Type::UNIFORM_FLOAT:
+        GPU_shader_uniform_vector(shader,
+                                  cmd.uniform.location,
+                                  cmd.uniform.length,
+                                  cmd.uniform.arraysize,
+                                  &uniform_data_[cmd.uniform.offset]);
+        break;
+      case Type::UNIFORM_INT:
+        GPU_shader_uniform_vector_int(
+            shader,
+            cmd.uniform.location,
+            cmd.uniform.length,
+            cmd.uniform.arraysize,
+            reinterpret_cast<const int *>(&uniform_data_[cmd.uniform.offset]));
+        break;
+      case Type::STATE_SET:
+        GPU_state_set(cmd.state.write_mask,
+                      cmd.state.blend,
+                      cmd.state.culling_test,
+                      cmd.state.depth_test,
+                      cmd.state.stencil_test,
+                      cmd.state.stencil_op,
+                      cmd.state.provoking_vert);
+        break;
+      case Type::BATCH_DRAW:
+        GPU_batch_set_shader(cmd.draw.batch, shader);
+        GPU_batch_draw_advanced(cmd.draw.batch,
+                                cmd.draw.v_first,
+                                cmd.draw.v_count,
+                                cmd.draw.i_first,
+                                cmd.draw.i_count);
+        break;
+    }
+  }
+}
+
+}  // namespace blender::gpu
@@ -0,0 +1,90 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2022 Blender Foundation. All rights reserved. */
+
+/** \file
+ * \ingroup gpu
+ *
+ * OpenGL has no way to record commands outside of the context thread.
+ * Commands are stored and replayed on submission.
+ */
+
+#pragma once
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_vector.hh"
+
+#include "gpu_command_list_private.hh"
+
+namespace blender {
+namespace gpu {
+
+/**
+ * Deferred replay of the recorded commands through the GPU module API.
+ */
+class GLCommandList : public CommandList {
+ public:
+  void clear() override;
+  void shader_bind(GPUShader *shader) override;
+  void uniform_vector(int location, int length, int arraysize, const float *value) override;
+  void uniform_vector_int(int location, int length, int arraysize, const int *value) override;
+  void state_set(eGPUWriteMask write_mask,
+                 eGPUBlend blend,
+                 eGPUFaceCullTest culling_test,
+                 eGPUDepthTest depth_test,
+                 eGPUStencilTest stencil_test,
+                 eGPUStencilOp stencil_op,
+                 eGPUProvokingVertex provoking_vert) override;
+  void batch_draw(GPUBatch *batch, int v_first, int v_count, int i_first, int i_count) override;
+  void submit() override;
+
+ private:
+  enum class Type : uint8_t {
+    SHADER_BIND,
+    UNIFORM_FLOAT,
+    UNIFORM_INT,
+    STATE_SET,
+    BATCH_DRAW,
+  };
+
+  struct Command {
+    Type type;
+    union {
+      GPUShader *shader;
+      struct {
+        int location;
+        int length;
+        int arraysize;
+        /** Offset of the values in #uniform_data_. */
+        int64_t offset;
+      } uniform;
+      struct {
+        eGPUWriteMask write_mask;
+        eGPUBlend blend;
+        eGPUFaceCullTest culling_test;
+        eGPUDepthTest depth_test;
+        eGPUStencilTest stencil_test;
+        eGPUStencilOp stencil_op;
+        eGPUProvokingVertex provoking_vert;
+      } state;
+      struct {
+        GPUBatch *batch;
+        int v_first;
+        int v_count;
+        int i_first;
+        int i_count;
+      } draw;
+    };
+  };
+
+  Vector<Command> commands_;
+  /** Values of the uniform commands. Ints are stored bitwise in the same buffer. */
+  Vector<float> uniform_data_;
+  /** Last recorded shader, only used for checks. */
+  GPUShader *shader_ = nullptr;
+
+  MEM_CXX_CLASS_ALLOC_FUNCS("GLCommandList");
+};
+
+}  // namespace gpu
+}  // namespace blender
@@ -16,6 +16,8 @@
 
 #include "gl_framebuffer.hh"
 
+#include "gpu_immediate_private.hh"
+
 namespace blender::gpu {
 
 /* -------------------------------------------------------------------- */
@@ -246,6 +248,8 @@ void GLFrameBuffer::apply_state()
 
 void GLFrameBuffer::bind(bool enabled_srgb)
 {
+  immFlushPending();
+
   if (!immutable_ && fbo_id_ == 0) {
     this->init();
   }
@@ -436,6 +440,7 @@ void GLFrameBuffer::read(eGPUFrameBufferBits plane,
       return;
   }
 
+  immFlushPending();
   glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo_id_);
   glReadBuffer(mode);
   glReadPixels(UNPACK4(area), format, type, r_data);
@@ -447,6 +452,8 @@ void GLFrameBuffer::blit_to(
   GLFrameBuffer *src = this;
   GLFrameBuffer *dst = static_cast<GLFrameBuffer *>(dst_);
 
+  immFlushPending();
+
   /* Frame-buffers must be up to date. This simplify this function. */
   if (src->dirty_attachments_) {
     src->bind(true);
@@ -96,6 +96,11 @@ class GLFrameBuffer : public FrameBuffer {
 
   void apply_state();
 
+  bool is_state_applied() const
+  {
+    return !dirty_state_;
+  }
+
  private:
   void init();
   void update_attachments();
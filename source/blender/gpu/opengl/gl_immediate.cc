@@ -9,6 +9,8 @@
 
 #include "BKE_global.h"
 
+#include "GPU_matrix.h"
+
 #include "gpu_context_private.hh"
 #include "gpu_shader_private.hh"
 #include "gpu_vertex_format_private.h"
@@ -95,6 +97,8 @@ uchar *GLImmediate::begin()
     buffer_offset() += pre_padding;
   }
   else {
+    /* The pending draw reads from the orphaned storage. */
+    flush_pending();
     /* orphan this buffer & start with a fresh one */
     glBufferData(GL_ARRAY_BUFFER, buffer_size(), nullptr, GL_DYNAMIC_DRAW);
     buffer_offset() = 0;
@@ -136,31 +140,122 @@ void GLImmediate::end()
   glUnmapBuffer(GL_ARRAY_BUFFER);
 
   if (vertex_len > 0) {
-    GLContext::get()->state_manager->apply_state();
-
     /* We convert the offset in vertex offset from the buffer's start.
      * This works because we added some padding to align the first vertex. */
     uint v_first = buffer_offset() / vertex_format.stride;
-    GLVertArray::update_bindings(
-        vao_id_, v_first, &vertex_format, reinterpret_cast<Shader *>(shader)->interface);
 
-    /* Update matrices. */
-    GPU_shader_bind(shader);
+    if (pending_can_merge(v_first)) {
+      /* The vertices directly follow the pending ones, extend its draw call. */
+      pending_.vertex_len += vertex_len;
+      merged_draw_len++;
+    }
+    else {
+      flush_pending();
+
+      GLContext::get()->state_manager->apply_state();
+
+      GLVertArray::update_bindings(
+          vao_id_, v_first, &vertex_format, reinterpret_cast<Shader *>(shader)->interface);
+
+      /* Update matrices. */
+      GPU_shader_bind(shader);
+
+      if (batching_is_supported()) {
+        pending_.shader = shader;
+        pending_.prim_type = prim_type;
+        pending_.vertex_format = vertex_format;
+        pending_.vbo_id = vbo_id();
+        pending_.v_first = v_first;
+        pending_.vertex_len = vertex_len;
+      }
+      else {
+        draw_arrays(prim_type, vertex_len);
+      }
+    }
+  }
+
+  buffer_offset() += buffer_bytes_used;
+}
+
+void GLImmediate::flush_pending()
+{
+  if (pending_.vertex_len == 0) {
+    return;
+  }
+  const uint vertex_len = pending_.vertex_len;
+  pending_.vertex_len = 0;
 
+  /* The vertex array bindings, the shader and the state are still the ones of the first merged
+   * draw. Any change to them flushes the pending draw first. */
+  glBindVertexArray(vao_id_);
+  draw_arrays(pending_.prim_type, vertex_len);
+}
+
+void GLImmediate::draw_arrays(GPUPrimType prim_type, uint vertex_len)
+{
 #ifdef __APPLE__
-    glDisable(GL_PRIMITIVE_RESTART);
+  glDisable(GL_PRIMITIVE_RESTART);
 #endif
-    glDrawArrays(to_gl(prim_type), 0, vertex_len);
+  glDrawArrays(to_gl(prim_type), 0, vertex_len);
 #ifdef __APPLE__
-    glEnable(GL_PRIMITIVE_RESTART);
+  glEnable(GL_PRIMITIVE_RESTART);
 #endif
-    /* These lines are causing crash on startup on some old GPU + drivers.
-     * They are not required so just comment them. (T55722) */
-    // glBindBuffer(GL_ARRAY_BUFFER, 0);
-    // glBindVertexArray(0);
+  /* These lines are causing crash on startup on some old GPU + drivers.
+   * They are not required so just comment them. (T55722) */
+  // glBindBuffer(GL_ARRAY_BUFFER, 0);
+  // glBindVertexArray(0);
+  draw_call_len++;
+}
+
+bool GLImmediate::batching_is_supported() const
+{
+  if (!use_batching || !ELEM(prim_type, GPU_PRIM_POINTS, GPU_PRIM_LINES, GPU_PRIM_TRIS)) {
+    return false;
   }
+  /* Only shaders that don't read textures or uniform buffers, these can be modified without
+   * flushing the pending draw. */
+  return ELEM(builtin_shader_bound,
+              GPU_SHADER_2D_UNIFORM_COLOR,
+              GPU_SHADER_3D_UNIFORM_COLOR,
+              GPU_SHADER_2D_FLAT_COLOR,
+              GPU_SHADER_3D_FLAT_COLOR,
+              GPU_SHADER_2D_SMOOTH_COLOR,
+              GPU_SHADER_3D_SMOOTH_COLOR,
+              GPU_SHADER_3D_POLYLINE_UNIFORM_COLOR,
+              GPU_SHADER_3D_POLYLINE_FLAT_COLOR,
+              GPU_SHADER_3D_POLYLINE_SMOOTH_COLOR);
+}
 
-  buffer_offset() += buffer_bytes_used;
+static bool vertex_format_equals(const GPUVertFormat &a, const GPUVertFormat &b)
+{
+  if (a.attr_len != b.attr_len || a.stride != b.stride) {
+    return false;
+  }
+  for (uint i = 0; i < a.attr_len; i++) {
+    const GPUVertAttr &attr_a = a.attrs[i];
+    const GPUVertAttr &attr_b = b.attrs[i];
+    if (attr_a.comp_type != attr_b.comp_type || attr_a.comp_len != attr_b.comp_len ||
+        attr_a.fetch_mode != attr_b.fetch_mode || attr_a.offset != attr_b.offset ||
+        attr_a.name_len != attr_b.name_len) {
+      return false;
+    }
+    for (uint n = 0; n < attr_a.name_len; n++) {
+      if (!STREQ(GPU_vertformat_attr_name_get(&a, &attr_a, n),
+                 GPU_vertformat_attr_name_get(&b, &attr_b, n))) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool GLImmediate::pending_can_merge(uint v_first)
+{
+  return pending_.vertex_len > 0 && batching_is_supported() && pending_.shader == shader &&
+         pending_.prim_type == prim_type && pending_.vbo_id == vbo_id() &&
+         pending_.v_first + pending_.vertex_len == v_first &&
+         vertex_format_equals(pending_.vertex_format, vertex_format) &&
+         !GPU_matrix_dirty_get() && GLContext::state_manager_active_get()->is_state_applied();
 }
 
 /** \} */
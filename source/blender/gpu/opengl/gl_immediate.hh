@@ -38,14 +38,30 @@ class GLImmediate : public Immediate {
   /** Vertex array for this immediate mode instance. */
   GLuint vao_id_ = 0;
 
+  /** Draw call delayed to be merged with the next compatible draws, see #immBatchingSet. */
+  struct {
+    GPUShader *shader = nullptr;
+    GPUPrimType prim_type = GPU_PRIM_NONE;
+    GPUVertFormat vertex_format = {};
+    GLuint vbo_id = 0;
+    uint v_first = 0;
+    /** Zero if there is no pending draw. */
+    uint vertex_len = 0;
+  } pending_;
+
  public:
   GLImmediate();
   ~GLImmediate();
 
   uchar *begin() override;
   void end() override;
+  void flush_pending() override;
 
  private:
+  bool pending_can_merge(uint v_first);
+  bool batching_is_supported() const;
+  void draw_arrays(GPUPrimType prim_type, uint vertex_len);
+
   GLuint &vbo_id()
   {
     return strict_vertex_len ? buffer_strict.vbo_id : buffer.vbo_id;
@@ -5,6 +5,8 @@
  * \ingroup gpu
  */
 
+#include "gpu_immediate_private.hh"
+
 #include "gl_query.hh"
 
 namespace blender::gpu {
@@ -35,6 +37,7 @@ void GLQueryPool::reset(GPUQueryType type)
 void GLQueryPool::begin_query()
 {
   /* TODO: add assert about expected usage. */
+  immFlushPending();
   while (query_issued_ >= query_ids_.size()) {
     int64_t prev_size = query_ids_.size();
     int64_t chunk_size = prev_size == 0 ? query_ids_.capacity() : QUERY_CHUNCK_LEN;
@@ -47,11 +50,13 @@ void GLQueryPool::begin_query()
 void GLQueryPool::end_query()
 {
   /* TODO: add assert about expected usage. */
+  immFlushPending();
   glEndQuery(gl_type_);
 }
 
 void GLQueryPool::get_occlusion_result(MutableSpan<uint32_t> r_values)
 {
+  BLI_assert(type_ == GPU_QUERY_OCCLUSION);
   BLI_assert(r_values.size() == query_issued_);
 
   for (int i = 0; i < query_issued_; i++) {
@@ -60,4 +65,15 @@ void GLQueryPool::get_occlusion_result(MutableSpan<uint32_t> r_values)
   }
 }
 
+void GLQueryPool::get_time_elapsed_result(MutableSpan<uint64_t> r_values)
+{
+  BLI_assert(type_ == GPU_QUERY_TIME_ELAPSED);
+  BLI_assert(r_values.size() == query_issued_);
+
+  for (int i = 0; i < query_issued_; i++) {
+    /* NOTE: This is a sync point. */
+    glGetQueryObjectui64v(query_ids_[i], GL_QUERY_RESULT, &r_values[i]);
+  }
+}
+
 }  // namespace blender::gpu
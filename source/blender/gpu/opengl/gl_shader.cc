@@ -5,10 +5,26 @@
  * \ingroup gpu
  */
 
+#include "BKE_appdir.h"
 #include "BKE_global.h"
 
+#include "BLI_array.hh"
+#include "BLI_fileops.h"
+#include "BLI_fileops_types.h"
+#include "BLI_hash_md5.h"
+#include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_system.h"
 #include "BLI_vector.hh"
+#include BLI_SYSTEM_PID_H
+
+/* For S_ISREG() on Windows. */
+#ifdef WIN32
+#  include "BLI_winstuff.h"
+#endif
+
+#include <algorithm>
+#include <atomic>
 
 #include "GPU_capabilities.h"
 #include "GPU_platform.h"
@@ -945,32 +961,42 @@ GLuint GLShader::create_shader_stage(GLenum gl_stage, MutableSpan<const char *>
   return shader;
 }
 
+void GLShader::deferred_stage_add(GLenum gl_stage, GLuint *r_shader, Span<const char *> sources)
+{
+  DeferredStage stage;
+  stage.gl_stage = gl_stage;
+  stage.r_shader = r_shader;
+  /* The first source slot is the patch, which is part of the program binary cache key. */
+  stage.sources.append(glsl_patch_get(gl_stage));
+  for (const char *source : sources.drop_front(1)) {
+    stage.sources.append(source);
+  }
+  deferred_stages_.append(std::move(stage));
+}
+
 void GLShader::vertex_shader_from_glsl(MutableSpan<const char *> sources)
 {
-  vert_shader_ = this->create_shader_stage(GL_VERTEX_SHADER, sources);
+  deferred_stage_add(GL_VERTEX_SHADER, &vert_shader_, sources);
 }
 
 void GLShader::geometry_shader_from_glsl(MutableSpan<const char *> sources)
 {
-  geom_shader_ = this->create_shader_stage(GL_GEOMETRY_SHADER, sources);
+  deferred_stage_add(GL_GEOMETRY_SHADER, &geom_shader_, sources);
 }
 
 void GLShader::fragment_shader_from_glsl(MutableSpan<const char *> sources)
 {
-  frag_shader_ = this->create_shader_stage(GL_FRAGMENT_SHADER, sources);
+  deferred_stage_add(GL_FRAGMENT_SHADER, &frag_shader_, sources);
 }
 
 void GLShader::compute_shader_from_glsl(MutableSpan<const char *> sources)
 {
-  compute_shader_ = this->create_shader_stage(GL_COMPUTE_SHADER, sources);
+  is_compute_ = true;
+  deferred_stage_add(GL_COMPUTE_SHADER, &compute_shader_, sources);
 }
 
 bool GLShader::finalize(const shader::ShaderCreateInfo *info)
 {
-  if (compilation_failed_) {
-    return false;
-  }
-
   if (info && do_geometry_shader_injection(info)) {
     std::string source = workaround_geometry_shader_source_create(*info);
     Vector<const char *> sources;
@@ -979,18 +1005,44 @@ bool GLShader::finalize(const shader::ShaderCreateInfo *info)
     geometry_shader_from_glsl(sources);
   }
 
-  glLinkProgram(shader_program_);
+  const std::string cache_filepath = program_binary_cache_filepath();
+  const bool use_cache = !cache_filepath.empty();
 
-  GLint status;
-  glGetProgramiv(shader_program_, GL_LINK_STATUS, &status);
-  if (!status) {
-    char log[5000];
-    glGetProgramInfoLog(shader_program_, sizeof(log), nullptr, log);
-    Span<const char *> sources;
-    GLLogParser parser;
-    this->print_log(sources, log, "Linking", true, &parser);
-    return false;
+  if (!use_cache || !program_binary_load(cache_filepath.c_str())) {
+    for (DeferredStage &stage : deferred_stages_) {
+      Vector<const char *> sources;
+      for (const std::string &source : stage.sources) {
+        sources.append(source.c_str());
+      }
+      *stage.r_shader = this->create_shader_stage(stage.gl_stage, sources);
+    }
+
+    if (compilation_failed_) {
+      return false;
+    }
+
+    if (use_cache) {
+      glProgramParameteri(shader_program_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+
+    glLinkProgram(shader_program_);
+
+    GLint status;
+    glGetProgramiv(shader_program_, GL_LINK_STATUS, &status);
+    if (!status) {
+      char log[5000];
+      glGetProgramInfoLog(shader_program_, sizeof(log), nullptr, log);
+      Span<const char *> sources;
+      GLLogParser parser;
+      this->print_log(sources, log, "Linking", true, &parser);
+      return false;
+    }
+
+    if (use_cache) {
+      program_binary_save(cache_filepath.c_str());
+    }
   }
+  deferred_stages_.clear_and_make_inline();
 
   if (info != nullptr && info->legacy_resource_location_ == false) {
     interface = new GLShaderInterface(shader_program_, *info);
@@ -1004,6 +1056,173 @@ bool GLShader::finalize(const shader::ShaderCreateInfo *info)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Program Binary Cache
+ * \{ */
+
+/** Least recently used binaries are removed at startup when the cache is larger than this. */
+#define PROGRAM_BINARY_CACHE_MAX_SIZE (int64_t(256) * 1024 * 1024)
+
+static bool program_binary_cache_dir_get(char *r_dirpath, const size_t dirpath_len)
+{
+  char cache_dir[FILE_MAX];
+  if (!BKE_appdir_folder_caches(cache_dir, sizeof(cache_dir))) {
+    return false;
+  }
+  BLI_path_join(r_dirpath, dirpath_len, cache_dir, "gpu_shaders", nullptr);
+  return true;
+}
+
+void GLShader::program_binary_cache_prune()
+{
+  char dirpath[FILE_MAX];
+  if (!program_binary_cache_dir_get(dirpath, sizeof(dirpath)) || !BLI_is_dir(dirpath)) {
+    return;
+  }
+
+  struct direntry *entries;
+  const uint entries_num = BLI_filelist_dir_contents(dirpath, &entries);
+
+  Vector<const direntry *> files;
+  int64_t cache_size = 0;
+  for (const uint i : IndexRange(entries_num)) {
+    if (S_ISREG(entries[i].type)) {
+      files.append(&entries[i]);
+      cache_size += int64_t(entries[i].s.st_size);
+    }
+  }
+
+  if (cache_size > PROGRAM_BINARY_CACHE_MAX_SIZE) {
+    /* Loading a binary updates its modification time, so the oldest are the least recently
+     * used. */
+    std::sort(files.begin(), files.end(), [](const direntry *a, const direntry *b) {
+      return a->s.st_mtime < b->s.st_mtime;
+    });
+    for (const direntry *file : files) {
+      if (cache_size <= PROGRAM_BINARY_CACHE_MAX_SIZE) {
+        break;
+      }
+      if (BLI_delete(file->path, false, false) == 0) {
+        cache_size -= int64_t(file->s.st_size);
+      }
+    }
+  }
+
+  BLI_filelist_free(entries, entries_num);
+}
+
+std::string GLShader::program_binary_cache_filepath() const
+{
+  /* Compilation messages are wanted when debugging, and the names of transform feedback varyings
+   * are not part of the key. */
+  if (!GLContext::program_binary_support || (G.debug & G_DEBUG_GPU) ||
+      transform_feedback_type_ != GPU_SHADER_TFB_NONE) {
+    return "";
+  }
+
+  char cache_dir[FILE_MAX];
+  if (!program_binary_cache_dir_get(cache_dir, sizeof(cache_dir))) {
+    return "";
+  }
+
+  /* Binaries are only valid for the same driver. Strings are separated by null characters, so
+   * that different splits of the same text don't give the same key. */
+  std::string key;
+  const char *driver_strings[] = {
+      GPU_platform_vendor(), GPU_platform_renderer(), GPU_platform_version()};
+  for (const char *str : driver_strings) {
+    key.append(str);
+    key.push_back('\0');
+  }
+  for (const DeferredStage &stage : deferred_stages_) {
+    key.append(std::to_string(stage.gl_stage));
+    key.push_back('\0');
+    for (const std::string &source : stage.sources) {
+      key.append(source);
+      key.push_back('\0');
+    }
+  }
+
+  uchar digest[16];
+  char digest_hex[33];
+  BLI_hash_md5_buffer(key.data(), key.size(), digest);
+  BLI_hash_md5_to_hexdigest(digest, digest_hex);
+
+  char filepath[FILE_MAX];
+  BLI_path_join(filepath, sizeof(filepath), cache_dir, digest_hex, nullptr);
+  return filepath;
+}
+
+bool GLShader::program_binary_load(const char *filepath)
+{
+  size_t size;
+  char *data = static_cast<char *>(BLI_file_read_binary_as_mem(filepath, 0, &size));
+  if (data == nullptr) {
+    return false;
+  }
+
+  /* The binary format is stored before the binary. */
+  GLint status = GL_FALSE;
+  if (size > sizeof(GLenum)) {
+    GLenum binary_format;
+    memcpy(&binary_format, data, sizeof(binary_format));
+    glProgramBinary(
+        shader_program_, binary_format, data + sizeof(GLenum), size - sizeof(GLenum));
+    /* Binaries are rejected when the driver changed in a way that makes them incompatible. */
+    glGetProgramiv(shader_program_, GL_LINK_STATUS, &status);
+  }
+  MEM_freeN(data);
+
+  if (status == GL_TRUE) {
+    /* Mark as recently used for #program_binary_cache_prune. */
+    BLI_file_touch(filepath);
+  }
+
+  return status == GL_TRUE;
+}
+
+void GLShader::program_binary_save(const char *filepath)
+{
+  GLint binary_len = 0;
+  glGetProgramiv(shader_program_, GL_PROGRAM_BINARY_LENGTH, &binary_len);
+  if (binary_len <= 0) {
+    return;
+  }
+
+  Array<char> data(sizeof(GLenum) + binary_len);
+  GLenum binary_format;
+  glGetProgramBinary(
+      shader_program_, binary_len, nullptr, &binary_format, data.data() + sizeof(GLenum));
+  memcpy(data.data(), &binary_format, sizeof(binary_format));
+
+  char dirpath[FILE_MAX];
+  BLI_split_dir_part(filepath, dirpath, sizeof(dirpath));
+  if (!BLI_dir_create_recursive(dirpath)) {
+    return;
+  }
+
+  /* Write to a temporary file first, so other Blender instances never read a partial file.
+   * Shaders with the same sources can be compiled by multiple threads at the same time. */
+  static std::atomic<int> tmp_file_counter = 0;
+  char filepath_tmp[FILE_MAX];
+  BLI_snprintf(filepath_tmp,
+               sizeof(filepath_tmp),
+               "%s.%d.%d.tmp",
+               filepath,
+               abs(getpid()),
+               tmp_file_counter.fetch_add(1));
+  FILE *file = BLI_fopen(filepath_tmp, "wb");
+  if (file == nullptr) {
+    return;
+  }
+  const bool success = fwrite(data.data(), data.size(), 1, file) == 1;
+  fclose(file);
+
+  if (!success || BLI_rename(filepath_tmp, filepath) != 0) {
+    BLI_delete(filepath_tmp, false, false);
+  }
+}
+
 /* -------------------------------------------------------------------- */
 /** \name Binding
  * \{ */
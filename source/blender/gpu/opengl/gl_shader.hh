@@ -9,6 +9,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_vector.hh"
+
 #include "glew-mx.h"
 
 #include "gpu_shader_create_info.hh"
@@ -34,6 +36,18 @@ class GLShader : public Shader {
   GLuint compute_shader_ = 0;
   /** True if any shader failed to compile. */
   bool compilation_failed_ = false;
+  bool is_compute_ = false;
+
+  /**
+   * Shader stages are compiled in #finalize, so that their compilation can be skipped when the
+   * linked program is found in the program binary cache.
+   */
+  struct DeferredStage {
+    GLenum gl_stage;
+    GLuint *r_shader;
+    Vector<std::string> sources;
+  };
+  Vector<DeferredStage> deferred_stages_;
 
   eGPUShaderTFBType transform_feedback_type_ = GPU_SHADER_TFB_NONE;
 
@@ -74,14 +88,29 @@ class GLShader : public Shader {
 
   bool is_compute() const
   {
-    return compute_shader_ != 0;
+    return is_compute_;
   }
 
+  /** Remove the least recently used program binaries when the cache got too large. */
+  static void program_binary_cache_prune();
+
  private:
   char *glsl_patch_get(GLenum gl_stage);
 
   /** Create, compile and attach the shader stage to the shader program. */
   GLuint create_shader_stage(GLenum gl_stage, MutableSpan<const char *> sources);
+  /** Store the sources of the stage for compilation in #finalize. */
+  void deferred_stage_add(GLenum gl_stage, GLuint *r_shader, Span<const char *> sources);
+
+  /**
+   * Program binaries of linked shaders are cached on disk, identified by the sources of all
+   * stages and the driver.
+   * \return An empty string when the program binary cache can't be used for this shader.
+   */
+  std::string program_binary_cache_filepath() const;
+  /** \return True when the program was linked successfully from the cached binary. */
+  bool program_binary_load(const char *filepath);
+  void program_binary_save(const char *filepath);
 
   /**
    * \brief features available on newer implementation such as native barycentric coordinates
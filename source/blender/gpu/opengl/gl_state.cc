@@ -21,6 +21,8 @@
 
 #include "gl_state.hh"
 
+#include "gpu_immediate_private.hh"
+
 namespace blender::gpu {
 
 /* -------------------------------------------------------------------- */
@@ -59,6 +61,9 @@ GLStateManager::GLStateManager()
 
 void GLStateManager::apply_state()
 {
+  /* The pending draw uses the state applied before. */
+  immFlushPending();
+
   if (!this->use_bgl) {
     this->set_state(this->state);
     this->set_mutable_state(this->mutable_state);
@@ -69,6 +74,12 @@ void GLStateManager::apply_state()
   active_fb->apply_state();
 };
 
+bool GLStateManager::is_state_applied() const
+{
+  return !this->use_bgl && this->state == current_ && this->mutable_state == current_mutable_ &&
+         dirty_texture_binds_ == 0 && dirty_image_binds_ == 0 && active_fb->is_state_applied();
+}
+
 void GLStateManager::force_state()
 {
   /* Little exception for clip distances since they need to keep the old count correct. */
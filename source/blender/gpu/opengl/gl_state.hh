@@ -57,6 +57,8 @@ class GLStateManager : public StateManager {
   GLStateManager();
 
   void apply_state() override;
+  /** True if no state was changed since the last #apply_state. */
+  bool is_state_applied() const;
   /**
    * Will set all the states regardless of the current ones.
    */
@@ -144,6 +144,22 @@ void GLStorageBuf::clear(eGPUTextureFormat internal_format, eGPUDataFormat data_
   }
 }
 
+void GLStorageBuf::read(void *data)
+{
+  if (ssbo_id_ == 0) {
+    this->init();
+  }
+
+  if (GLContext::direct_state_access_support) {
+    glGetNamedBufferSubData(ssbo_id_, 0, size_in_bytes_, data);
+  }
+  else {
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, ssbo_id_);
+    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, size_in_bytes_, data);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+  }
+}
+
 /** \} */
 
 }  // namespace blender::gpu
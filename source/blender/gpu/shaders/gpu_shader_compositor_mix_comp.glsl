@@ -0,0 +1,50 @@
+
+/**
+ * Compositor mix operations, see `MixBaseOperation::get_gpu_blend_type` for the blend types.
+ */
+
+#define BLEND_MIX 0
+#define BLEND_ADD 1
+#define BLEND_SUBTRACT 2
+#define BLEND_MULTIPLY 3
+
+/* Single element inputs are 1x1 textures, clamping reads their only element everywhere. */
+vec4 load_input(sampler2D tx, ivec2 texel, ivec2 offset)
+{
+  return texelFetch(tx, clamp(texel - offset, ivec2(0), textureSize(tx, 0) - 1), 0);
+}
+
+void main()
+{
+  ivec2 texel = ivec2(gl_GlobalInvocationID.xy);
+  if (any(greaterThanEqual(texel, imageSize(output_img)))) {
+    return;
+  }
+
+  float value = load_input(value_tx, texel, input_offsets[0]).r;
+  vec4 color1 = load_input(color1_tx, texel, input_offsets[1]);
+  vec4 color2 = load_input(color2_tx, texel, input_offsets[2]);
+  if (use_alpha) {
+    value *= color2.a;
+  }
+
+  vec4 result = vec4(0.0, 0.0, 0.0, color1.a);
+  switch (blend_type) {
+    case BLEND_MIX:
+      result.rgb = mix(color1.rgb, color2.rgb, value);
+      break;
+    case BLEND_ADD:
+      result.rgb = color1.rgb + value * color2.rgb;
+      break;
+    case BLEND_SUBTRACT:
+      result.rgb = color1.rgb - value * color2.rgb;
+      break;
+    case BLEND_MULTIPLY:
+      result.rgb = color1.rgb * ((1.0 - value) + value * color2.rgb);
+      break;
+  }
+  if (use_clamp) {
+    result = clamp(result, 0.0, 1.0);
+  }
+  imageStore(output_img, texel, result);
+}
@@ -0,0 +1,35 @@
+
+/**
+ * One step of the sculpt mesh filter smoothing, see `mesh_filter_task_cb`.
+ * The neighbors of each vertex are already reduced to the ones used by the interior smoothing,
+ * vertices without neighbors keep their position.
+ */
+
+void main()
+{
+  uint index = gl_GlobalInvocationID.x;
+  if (index >= uint(verts_len)) {
+    return;
+  }
+
+  vec3 co = co_in[index].xyz;
+  uint first = neighbor_offsets[index];
+  uint last = neighbor_offsets[index + 1u];
+
+  float fade = clamp(vert_factor[index] * strength, -1.0, 1.0);
+  if (fade == 0.0 || first == last) {
+    co_out[index] = vec4(co, 1.0);
+    return;
+  }
+
+  vec3 avg = vec3(0.0);
+  for (uint i = first; i < last; i++) {
+    avg += co_in[neighbors[i]].xyz;
+  }
+  avg /= float(last - first);
+
+  vec3 orig = orig_co[index].xyz;
+  /* Only keep the displacement along the enabled axes of the filter orientation. */
+  vec3 disp = mat3(axis_mat) * ((avg - orig) * fade);
+  co_out[index] = vec4(orig + disp, 1.0);
+}
@@ -0,0 +1,49 @@
+
+/**
+ * Sequencer strip blend modes, matching the float versions of the effects in `effects.c`.
+ * See `seq_render_strip_stack_gpu_blend_type` for the blend types.
+ */
+
+#define BLEND_ALPHAOVER 0
+#define BLEND_CROSS 1
+#define BLEND_ADD 2
+#define BLEND_SUBTRACT 3
+#define BLEND_MULTIPLY 4
+
+void main()
+{
+  ivec2 texel = ivec2(gl_GlobalInvocationID.xy);
+  if (any(greaterThanEqual(texel, imageSize(output_img)))) {
+    return;
+  }
+
+  vec4 color1 = texelFetch(image1_tx, texel, 0);
+  vec4 color2 = texelFetch(image2_tx, texel, 0);
+
+  vec4 result = color1;
+  switch (blend_type) {
+    case BLEND_ALPHAOVER: {
+      float mfac = 1.0 - fac * color1.a;
+      if (fac <= 0.0) {
+        result = color2;
+      }
+      else if (mfac > 0.0) {
+        result = fac * color1 + mfac * color2;
+      }
+      break;
+    }
+    case BLEND_CROSS:
+      result = mix(color1, color2, fac);
+      break;
+    case BLEND_ADD:
+      result.rgb += (1.0 - color1.a * (1.0 - fac)) * color2.a * color2.rgb;
+      break;
+    case BLEND_SUBTRACT:
+      result.rgb = max(color1.rgb - (1.0 - color1.a * (1.0 - fac)) * color2.a * color2.rgb, 0.0);
+      break;
+    case BLEND_MULTIPLY:
+      result = color1 + fac * color1 * (color2 - 1.0);
+      break;
+  }
+  imageStore(output_img, texel, result);
+}
@@ -0,0 +1,21 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2022 Blender Foundation. All rights reserved. */
+
+/** \file
+ * \ingroup gpu
+ */
+
+#include "gpu_shader_create_info.hh"
+
+GPU_SHADER_CREATE_INFO(gpu_shader_compositor_mix)
+    .local_group_size(16, 16)
+    .sampler(0, ImageType::FLOAT_2D, "value_tx")
+    .sampler(1, ImageType::FLOAT_2D, "color1_tx")
+    .sampler(2, ImageType::FLOAT_2D, "color2_tx")
+    .image(0, GPU_RGBA32F, Qualifier::WRITE, ImageType::FLOAT_2D, "output_img")
+    .push_constant(Type::IVEC2, "input_offsets", 3)
+    .push_constant(Type::INT, "blend_type")
+    .push_constant(Type::BOOL, "use_alpha")
+    .push_constant(Type::BOOL, "use_clamp")
+    .compute_source("gpu_shader_compositor_mix_comp.glsl")
+    .do_static_compilation(true);
@@ -0,0 +1,22 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2022 Blender Foundation. All rights reserved. */
+
+/** \file
+ * \ingroup gpu
+ */
+
+#include "gpu_shader_create_info.hh"
+
+GPU_SHADER_CREATE_INFO(gpu_shader_sculpt_smooth)
+    .local_group_size(64)
+    .storage_buf(0, Qualifier::READ, "vec4", "orig_co[]")
+    .storage_buf(1, Qualifier::READ, "vec4", "co_in[]")
+    .storage_buf(2, Qualifier::WRITE, "vec4", "co_out[]")
+    .storage_buf(3, Qualifier::READ, "uint", "neighbor_offsets[]")
+    .storage_buf(4, Qualifier::READ, "uint", "neighbors[]")
+    .storage_buf(5, Qualifier::READ, "float", "vert_factor[]")
+    .push_constant(Type::MAT4, "axis_mat")
+    .push_constant(Type::FLOAT, "strength")
+    .push_constant(Type::INT, "verts_len")
+    .compute_source("gpu_shader_sculpt_smooth_comp.glsl")
+    .do_static_compilation(true);
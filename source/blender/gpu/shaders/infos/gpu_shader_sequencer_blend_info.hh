@@ -0,0 +1,18 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * Copyright 2022 Blender Foundation. All rights reserved. */
+
+/** \file
+ * \ingroup gpu
+ */
+
+#include "gpu_shader_create_info.hh"
+
+GPU_SHADER_CREATE_INFO(gpu_shader_sequencer_blend)
+    .local_group_size(16, 16)
+    .sampler(0, ImageType::FLOAT_2D, "image1_tx")
+    .sampler(1, ImageType::FLOAT_2D, "image2_tx")
+    .image(0, GPU_RGBA32F, Qualifier::WRITE, ImageType::FLOAT_2D, "output_img")
+    .push_constant(Type::INT, "blend_type")
+    .push_constant(Type::FLOAT, "fac")
+    .compute_source("gpu_shader_sequencer_blend_comp.glsl")
+    .do_static_compilation(true);
@@ -0,0 +1,98 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_task.hh"
+
+#include "GPU_batch.h"
+#include "GPU_command_list.h"
+#include "GPU_framebuffer.h"
+#include "GPU_shader.h"
+#include "GPU_texture.h"
+#include "GPU_vertex_buffer.h"
+#include "GPU_vertex_format.h"
+
+#include "gpu_testing.hh"
+
+namespace blender::gpu::tests {
+
+static GPUBatch *quad_batch_create(float xmin, float xmax)
+{
+  GPUVertFormat format = {0};
+  GPU_vertformat_attr_add(&format, "pos", GPU_COMP_F32, 2, GPU_FETCH_FLOAT);
+  GPUVertBuf *vbo = GPU_vertbuf_create_with_format(&format);
+  GPU_vertbuf_data_alloc(vbo, 4);
+  const float pos[4][2] = {{xmin, -1.0f}, {xmax, -1.0f}, {xmin, 1.0f}, {xmax, 1.0f}};
+  GPU_vertbuf_attr_fill(vbo, 0, pos);
+  return GPU_batch_create_ex(GPU_PRIM_TRI_STRIP, vbo, nullptr, GPU_BATCH_OWNS_VBO);
+}
+
+static void test_gpu_command_list_submit_order()
+{
+  static constexpr int SIZE = 4;
+
+  GPUTexture *texture = GPU_texture_create_2d(
+      "gpu_command_list_submit_order", SIZE, SIZE, 1, GPU_RGBA32F, nullptr);
+  EXPECT_NE(texture, nullptr);
+  GPUFrameBuffer *framebuffer = nullptr;
+  GPU_framebuffer_ensure_config(&framebuffer,
+                                {GPU_ATTACHMENT_NONE, GPU_ATTACHMENT_TEXTURE(texture)});
+  GPU_framebuffer_bind(framebuffer);
+
+  GPUShader *shader = GPU_shader_get_builtin_shader(GPU_SHADER_2D_UNIFORM_COLOR);
+  const int color_loc = GPU_shader_get_builtin_uniform(shader, GPU_UNIFORM_COLOR);
+
+  /* The first list fills the whole target, the second one overwrites the left half. */
+  GPUBatch *batches[2] = {quad_batch_create(-1.0f, 1.0f), quad_batch_create(-1.0f, 0.0f)};
+  const float colors[2][4] = {{1.0f, 0.0f, 0.0f, 1.0f}, {0.0f, 1.0f, 0.0f, 1.0f}};
+  GPUCommandList *lists[2] = {GPU_command_list_create(), GPU_command_list_create()};
+
+  /* Record on worker threads, without using the context. */
+  threading::parallel_for(IndexRange(2), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      GPU_command_list_state_set(lists[i],
+                                 GPU_WRITE_COLOR,
+                                 GPU_BLEND_NONE,
+                                 GPU_CULL_NONE,
+                                 GPU_DEPTH_NONE,
+                                 GPU_STENCIL_NONE,
+                                 GPU_STENCIL_OP_NONE,
+                                 GPU_VERTEX_LAST);
+      GPU_command_list_shader_bind(lists[i], shader);
+      GPU_command_list_uniform_vector(lists[i], color_loc, 4, 1, colors[i]);
+      GPU_command_list_batch_draw(lists[i], batches[i], 0, 0, 0, 0);
+    }
+  });
+
+  GPU_command_list_submit(lists[0]);
+  GPU_command_list_submit(lists[1]);
+
+  float *data = static_cast<float *>(GPU_texture_read(texture, GPU_DATA_FLOAT, 0));
+  EXPECT_NE(data, nullptr);
+  for (int y = 0; y < SIZE; y++) {
+    for (int x = 0; x < SIZE; x++) {
+      const float *expected = colors[x < SIZE / 2 ? 1 : 0];
+      const float *pixel = &data[(y * SIZE + x) * 4];
+      EXPECT_FLOAT_EQ(pixel[0], expected[0]);
+      EXPECT_FLOAT_EQ(pixel[1], expected[1]);
+      EXPECT_FLOAT_EQ(pixel[2], expected[2]);
+      EXPECT_FLOAT_EQ(pixel[3], expected[3]);
+    }
+  }
+  MEM_freeN(data);
+
+  /* Cleanup. */
+  for (int i = 0; i < 2; i++) {
+    GPU_command_list_discard(lists[i]);
+    GPU_batch_discard(batches[i]);
+  }
+  GPU_shader_unbind();
+  GPU_framebuffer_restore();
+  GPU_framebuffer_free(framebuffer);
+  GPU_texture_free(texture);
+}
+GPU_TEST(gpu_command_list_submit_order)
+
+}  // namespace blender::gpu::tests
@@ -928,6 +928,28 @@ void IMB_transform(const struct ImBuf *src,
 void IMB_ffmpeg_init(void);
 const char *IMB_ffmpeg_last_error(void);
 
+typedef enum eIMBDecodeThreadType {
+  /** Frame threads when the codec supports them, slice threads otherwise. */
+  IMB_DECODE_THREADS_AUTO = 0,
+  /** Decode multiple frames at once, faster playback but slower seeking. */
+  IMB_DECODE_THREADS_FRAME = 1,
+  /** Decode parts of a frame at once, without the delay of frame threads. */
+  IMB_DECODE_THREADS_SLICE = 2,
+} eIMBDecodeThreadType;
+
+/**
+ * Set how movies opened afterwards are decoded.
+ *
+ * \param threads: Number of decoding threads, zero to pick automatically.
+ * \param use_hardware: Decode with a hardware device (VAAPI, NVDEC, VideoToolbox, D3D11VA...)
+ * when FFmpeg supports one for the codec, falling back to software decoding otherwise.
+ *
+ * \attention defined in anim_movie.c
+ */
+void IMB_ffmpeg_set_decode_settings(int threads,
+                                    eIMBDecodeThreadType thread_type,
+                                    bool use_hardware);
+
 /**
  *
  * \attention defined in util_gpu.c
@@ -937,6 +959,16 @@ struct GPUTexture *IMB_create_gpu_texture(const char *name,
                                           bool use_high_bitdepth,
                                           bool use_premult,
                                           bool limit_gl_texture_size);
+/**
+ * Create a block compressed texture with all its mipmap levels from a byte image. Return NULL if
+ * the image can't be compressed, the texture can't be updated afterwards.
+ *
+ * \attention defined in util_gpu.c
+ */
+struct GPUTexture *IMB_create_gpu_texture_compressed(const char *name,
+                                                     struct ImBuf *ibuf,
+                                                     bool use_premult,
+                                                     bool limit_gl_texture_size);
 /**
  * The `ibuf` is only here to detect the storage type. The produced texture will have undefined
  * content. It will need to be populated by using #IMB_update_gpu_texture_sub().
@@ -78,6 +78,16 @@ float *IMB_exr_channel_rect(void *handle,
                             const char *view);
 
 void IMB_exr_read_channels(void *handle);
+/**
+ * Read rows of a single layer RGB(A) file without loading the whole image, alpha is one when the
+ * file has none. Returns false for other files.
+ *
+ * \param ymin, ymax: Rows to read, from the bottom like #ImBuf.
+ * \param rect: Four channel buffer of `r_width * (ymax - ymin)` pixels, when null only the
+ * image size is returned.
+ */
+bool IMB_exr_rgba_rows_read(
+    const char *filepath, int *r_width, int *r_height, int ymin, int ymax, float *rect);
 void IMB_exr_write_channels(void *handle);
 /**
  * Temporary function, used for FSA and Save Buffers.
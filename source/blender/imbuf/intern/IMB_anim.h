@@ -65,8 +65,10 @@
 #define MAXNUMSTREAMS 50
 
 struct IDProperty;
+struct TaskPool;
 struct _AviMovie;
 struct anim_index;
+struct anim_key_frame_index;
 
 struct anim {
   int ib_flags;
@@ -113,7 +115,13 @@ struct anim {
   int pFrameComplete;
   AVFrame *pFrameRGB;
   AVFrame *pFrameDeinterlaced;
+  /** Frame decoded by a hardware device, transferred to #pFrame when used. */
+  AVFrame *pFrameHardware;
+  /** Pixel format of frames in device memory, #AV_PIX_FMT_NONE for software decoding. */
+  enum AVPixelFormat hw_pix_fmt;
   struct SwsContext *img_convert_ctx;
+  /** Source pixel format of #img_convert_ctx. */
+  enum AVPixelFormat img_convert_fmt;
   int videoStream;
 
   struct ImBuf *cur_frame_final;
@@ -129,6 +137,9 @@ struct anim {
 
   struct anim *proxy_anim[IMB_PROXY_MAX_SLOT];
   struct anim_index *curr_idx[IMB_TC_MAX_SLOT];
+  /** Published by the task of #key_frame_index_pool, see #IMB_anim_key_frame_index_get. */
+  struct anim_key_frame_index *key_frame_index;
+  struct TaskPool *key_frame_index_pool;
 
   char colorspace[64];
   char suffix[64]; /* MAX_NAME - multiview */
@@ -95,6 +95,34 @@ int IMB_indexer_can_scan(struct anim_index *idx, int old_frame_index, int new_fr
 
 void IMB_indexer_close(struct anim_index *idx);
 
+/**
+ * Key frame packets of the video stream, found by reading the packets of the movie without
+ * decoding them. Lets seeking go straight to the key frame a frame is decoded from when there is
+ * no timecode index, and is also written into the BL_proxy directory structure.
+ */
+typedef struct anim_key_frame {
+  /** Presentation timestamp, or decoding timestamp when the packet has none. */
+  int64_t pts;
+  /** Byte position of the packet, -1 when unknown. */
+  int64_t pos;
+} anim_key_frame;
+
+struct anim_key_frame_index {
+  int num_key_frames;
+  struct anim_key_frame *key_frames;
+};
+
+/**
+ * Get the key frame index of the movie. It is read or built in the background on first use,
+ * NULL is returned until it is available or when it couldn't be built.
+ */
+const struct anim_key_frame_index *IMB_anim_key_frame_index_get(struct anim *anim);
+/**
+ * Return the last key frame with a timestamp not after \a pts, NULL if there is none.
+ */
+const struct anim_key_frame *IMB_key_frame_index_find(const struct anim_key_frame_index *idx,
+                                                      int64_t pts);
+
 void IMB_free_indices(struct anim *anim);
 
 struct anim *IMB_anim_open_proxy(struct anim *anim, IMB_Proxy_Size preview_size);
@@ -361,7 +361,15 @@ void *imb_alloc_pixels(
   }
 
   size_t size = (size_t)x * (size_t)y * (size_t)channels * typesize;
-  return MEM_callocN(size, name);
+
+  /* Attribute pixels to images, unless the caller already did, e.g. the sequencer cache. */
+  const eMEMTag tag_prev = MEM_tag_get();
+  if (tag_prev == MEM_TAG_NONE) {
+    MEM_tag_set(MEM_TAG_IMAGE);
+  }
+  void *pixels = MEM_callocN(size, name);
+  MEM_tag_set(tag_prev);
+  return pixels;
 }
 
 bool imb_addrectfloatImBuf(ImBuf *ibuf)
@@ -65,6 +65,7 @@
 
 #  include <libavcodec/avcodec.h>
 #  include <libavformat/avformat.h>
+#  include <libavutil/hwcontext.h>
 #  include <libavutil/imgutils.h>
 #  include <libavutil/rational.h>
 #  include <libswscale/swscale.h>
@@ -488,6 +489,143 @@ static ImBuf *avi_fetchibuf(struct anim *anim, int position)
 
 #ifdef WITH_FFMPEG
 
+/* Settings of decoders opened afterwards, see #IMB_ffmpeg_set_decode_settings. */
+static struct {
+  int threads;
+  eIMBDecodeThreadType thread_type;
+  bool use_hardware;
+} g_decode_settings = {0, IMB_DECODE_THREADS_AUTO, false};
+
+void IMB_ffmpeg_set_decode_settings(int threads,
+                                    eIMBDecodeThreadType thread_type,
+                                    bool use_hardware)
+{
+  g_decode_settings.threads = threads;
+  g_decode_settings.thread_type = thread_type;
+  g_decode_settings.use_hardware = use_hardware;
+}
+
+static void ffmpeg_decode_threads_init(AVCodecContext *pCodecCtx, const AVCodec *pCodec)
+{
+  if (g_decode_settings.threads > 0) {
+    pCodecCtx->thread_count = g_decode_settings.threads;
+  }
+  else if (pCodec->capabilities & AV_CODEC_CAP_AUTO_THREADS) {
+    pCodecCtx->thread_count = 0;
+  }
+  else {
+    pCodecCtx->thread_count = BLI_system_thread_count();
+  }
+
+  const bool allow_frame_threads = ELEM(
+      g_decode_settings.thread_type, IMB_DECODE_THREADS_AUTO, IMB_DECODE_THREADS_FRAME);
+  const bool allow_slice_threads = ELEM(
+      g_decode_settings.thread_type, IMB_DECODE_THREADS_AUTO, IMB_DECODE_THREADS_SLICE);
+  if (allow_frame_threads && (pCodec->capabilities & AV_CODEC_CAP_FRAME_THREADS)) {
+    pCodecCtx->thread_type = FF_THREAD_FRAME;
+  }
+  else if (allow_slice_threads && (pCodec->capabilities & AV_CODEC_CAP_SLICE_THREADS)) {
+    pCodecCtx->thread_type = FF_THREAD_SLICE;
+  }
+}
+
+static enum AVPixelFormat ffmpeg_hw_get_format(AVCodecContext *pCodecCtx,
+                                               const enum AVPixelFormat *pix_fmts)
+{
+  const struct anim *anim = pCodecCtx->opaque;
+  for (const enum AVPixelFormat *pix_fmt = pix_fmts; *pix_fmt != AV_PIX_FMT_NONE; pix_fmt++) {
+    if (*pix_fmt == anim->hw_pix_fmt) {
+      return *pix_fmt;
+    }
+  }
+  /* The device doesn't support this stream, fall back to software decoding. */
+  return avcodec_default_get_format(pCodecCtx, pix_fmts);
+}
+
+/**
+ * Let the first hardware device that can be created for the codec decode the video.
+ * Returns false when decoding stays in software.
+ */
+static bool ffmpeg_hw_device_init(struct anim *anim,
+                                  AVCodecContext *pCodecCtx,
+                                  const AVCodec *pCodec)
+{
+  for (int i = 0;; i++) {
+    const AVCodecHWConfig *config = avcodec_get_hw_config(pCodec, i);
+    if (config == NULL) {
+      return false;
+    }
+    if ((config->methods & AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX) == 0) {
+      continue;
+    }
+
+    AVBufferRef *device_ctx = NULL;
+    if (av_hwdevice_ctx_create(&device_ctx, config->device_type, NULL, NULL, 0) < 0) {
+      continue;
+    }
+    pCodecCtx->hw_device_ctx = device_ctx;
+    pCodecCtx->opaque = anim;
+    pCodecCtx->get_format = ffmpeg_hw_get_format;
+    anim->hw_pix_fmt = config->pix_fmt;
+    av_log(
+        NULL, AV_LOG_INFO, "Decoding with %s\n", av_hwdevice_get_type_name(config->device_type));
+    return true;
+  }
+}
+
+/* Create the conversion of decoded frames in given pixel format to the RGBA #ImBuf. */
+static struct SwsContext *ffmpeg_sws_context_create(struct anim *anim, enum AVPixelFormat format)
+{
+  /* The following for color space determination */
+  int srcRange, dstRange, brightness, contrast, saturation;
+  int *table;
+  const int *inv_table;
+
+  struct SwsContext *img_convert_ctx = sws_getContext(anim->x,
+                                                      anim->y,
+                                                      format,
+                                                      anim->x,
+                                                      anim->y,
+                                                      AV_PIX_FMT_RGBA,
+                                                      SWS_BILINEAR | SWS_PRINT_INFO |
+                                                          SWS_FULL_CHR_H_INT,
+                                                      NULL,
+                                                      NULL,
+                                                      NULL);
+  if (!img_convert_ctx) {
+    return NULL;
+  }
+
+  /* Try do detect if input has 0-255 YCbCR range (JFIF Jpeg MotionJpeg) */
+  if (!sws_getColorspaceDetails(img_convert_ctx,
+                                (int **)&inv_table,
+                                &srcRange,
+                                &table,
+                                &dstRange,
+                                &brightness,
+                                &contrast,
+                                &saturation)) {
+    srcRange = srcRange || anim->pCodecCtx->color_range == AVCOL_RANGE_JPEG;
+    inv_table = sws_getCoefficients(anim->pCodecCtx->colorspace);
+
+    if (sws_setColorspaceDetails(img_convert_ctx,
+                                 (int *)inv_table,
+                                 srcRange,
+                                 table,
+                                 dstRange,
+                                 brightness,
+                                 contrast,
+                                 saturation)) {
+      fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
+    }
+  }
+  else {
+    fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
+  }
+
+  return img_convert_ctx;
+}
+
 static int startffmpeg(struct anim *anim)
 {
   int i, video_stream_index;
@@ -501,11 +639,6 @@ static int startffmpeg(struct anim *anim)
   double frs_den;
   int streamcount;
 
-  /* The following for color space determination */
-  int srcRange, dstRange, brightness, contrast, saturation;
-  int *table;
-  const int *inv_table;
-
   if (anim == NULL) {
     return (-1);
   }
@@ -555,18 +688,12 @@ static int startffmpeg(struct anim *anim)
   avcodec_parameters_to_context(pCodecCtx, video_stream->codecpar);
   pCodecCtx->workaround_bugs = FF_BUG_AUTODETECT;
 
-  if (pCodec->capabilities & AV_CODEC_CAP_AUTO_THREADS) {
-    pCodecCtx->thread_count = 0;
-  }
-  else {
-    pCodecCtx->thread_count = BLI_system_thread_count();
-  }
+  ffmpeg_decode_threads_init(pCodecCtx, pCodec);
 
-  if (pCodec->capabilities & AV_CODEC_CAP_FRAME_THREADS) {
-    pCodecCtx->thread_type = FF_THREAD_FRAME;
-  }
-  else if (pCodec->capabilities & AV_CODEC_CAP_SLICE_THREADS) {
-    pCodecCtx->thread_type = FF_THREAD_SLICE;
+  /* Deinterlacing works on frames in the codec pixel format. */
+  anim->hw_pix_fmt = AV_PIX_FMT_NONE;
+  if (g_decode_settings.use_hardware && !(anim->ib_flags & IB_animdeinterlace)) {
+    ffmpeg_hw_device_init(anim, pCodecCtx, pCodec);
   }
 
   if (avcodec_open2(pCodecCtx, pCodec, NULL) < 0) {
@@ -685,6 +812,7 @@ static int startffmpeg(struct anim *anim)
   anim->pFrame = av_frame_alloc();
   anim->pFrameComplete = false;
   anim->pFrameDeinterlaced = av_frame_alloc();
+  anim->pFrameHardware = av_frame_alloc();
   anim->pFrameRGB = av_frame_alloc();
   anim->pFrameRGB->format = AV_PIX_FMT_RGBA;
   anim->pFrameRGB->width = anim->x;
@@ -697,6 +825,7 @@ static int startffmpeg(struct anim *anim)
     av_packet_free(&anim->cur_packet);
     av_frame_free(&anim->pFrameRGB);
     av_frame_free(&anim->pFrameDeinterlaced);
+    av_frame_free(&anim->pFrameHardware);
     av_frame_free(&anim->pFrame);
     anim->pCodecCtx = NULL;
     return -1;
@@ -709,6 +838,7 @@ static int startffmpeg(struct anim *anim)
     av_packet_free(&anim->cur_packet);
     av_frame_free(&anim->pFrameRGB);
     av_frame_free(&anim->pFrameDeinterlaced);
+    av_frame_free(&anim->pFrameHardware);
     av_frame_free(&anim->pFrame);
     anim->pCodecCtx = NULL;
     return -1;
@@ -728,16 +858,8 @@ static int startffmpeg(struct anim *anim)
                          1);
   }
 
-  anim->img_convert_ctx = sws_getContext(anim->x,
-                                         anim->y,
-                                         anim->pCodecCtx->pix_fmt,
-                                         anim->x,
-                                         anim->y,
-                                         AV_PIX_FMT_RGBA,
-                                         SWS_BILINEAR | SWS_PRINT_INFO | SWS_FULL_CHR_H_INT,
-                                         NULL,
-                                         NULL,
-                                         NULL);
+  anim->img_convert_fmt = anim->pCodecCtx->pix_fmt;
+  anim->img_convert_ctx = ffmpeg_sws_context_create(anim, anim->img_convert_fmt);
 
   if (!anim->img_convert_ctx) {
     fprintf(stderr, "Can't transform color space??? Bailing out...\n");
@@ -746,38 +868,12 @@ static int startffmpeg(struct anim *anim)
     av_packet_free(&anim->cur_packet);
     av_frame_free(&anim->pFrameRGB);
     av_frame_free(&anim->pFrameDeinterlaced);
+    av_frame_free(&anim->pFrameHardware);
     av_frame_free(&anim->pFrame);
     anim->pCodecCtx = NULL;
     return -1;
   }
 
-  /* Try do detect if input has 0-255 YCbCR range (JFIF Jpeg MotionJpeg) */
-  if (!sws_getColorspaceDetails(anim->img_convert_ctx,
-                                (int **)&inv_table,
-                                &srcRange,
-                                &table,
-                                &dstRange,
-                                &brightness,
-                                &contrast,
-                                &saturation)) {
-    srcRange = srcRange || anim->pCodecCtx->color_range == AVCOL_RANGE_JPEG;
-    inv_table = sws_getCoefficients(anim->pCodecCtx->colorspace);
-
-    if (sws_setColorspaceDetails(anim->img_convert_ctx,
-                                 (int *)inv_table,
-                                 srcRange,
-                                 table,
-                                 dstRange,
-                                 brightness,
-                                 contrast,
-                                 saturation)) {
-      fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
-    }
-  }
-  else {
-    fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
-  }
-
   return 0;
 }
 
@@ -797,6 +893,33 @@ static void ffmpeg_postprocess(struct anim *anim)
     return;
   }
 
+  /* Only frames that are shown are copied from device memory, not the ones decoded while
+   * seeking. */
+  if (input->format == anim->hw_pix_fmt && anim->hw_pix_fmt != AV_PIX_FMT_NONE) {
+    AVFrame *hw_frame = anim->pFrameHardware;
+    av_frame_unref(hw_frame);
+    av_frame_move_ref(hw_frame, input);
+    if (av_hwframe_transfer_data(input, hw_frame, 0) < 0 ||
+        av_frame_copy_props(input, hw_frame) < 0) {
+      fprintf(stderr, "ffmpeg_fetchibuf: could not transfer frame from device\n");
+      av_frame_unref(input);
+      av_frame_move_ref(input, hw_frame);
+      return;
+    }
+    av_frame_unref(hw_frame);
+  }
+
+  /* Frames transferred from a device can be in a different format than the codec. */
+  if (input->format != anim->img_convert_fmt) {
+    struct SwsContext *img_convert_ctx = ffmpeg_sws_context_create(anim, input->format);
+    if (img_convert_ctx == NULL) {
+      return;
+    }
+    sws_freeContext(anim->img_convert_ctx);
+    anim->img_convert_ctx = img_convert_ctx;
+    anim->img_convert_fmt = input->format;
+  }
+
   /* This means the data wasn't read properly,
    * this check stops crashing */
   if (input->data[0] == 0 && input->data[1] == 0 && input->data[2] == 0 && input->data[3] == 0) {
@@ -1218,6 +1341,23 @@ static bool ffmpeg_seek_buffers_need_flushing(struct anim *anim, int position, i
   return true;
 }
 
+/* Seek to a key frame found by the key frame index. */
+static int ffmpeg_seek_to_indexed_key_frame(struct anim *anim,
+                                            const struct anim_key_frame *key_frame)
+{
+  anim->cur_key_frame_pts = key_frame->pts;
+
+  av_log(
+      anim->pFormatCtx, AV_LOG_DEBUG, "KEY FRAME INDEX seek pts = %" PRId64 "\n", key_frame->pts);
+
+  if (ffmpeg_seek_by_byte(anim->pFormatCtx) && key_frame->pos >= 0) {
+    av_log(anim->pFormatCtx, AV_LOG_DEBUG, "... using BYTE seek_pos\n");
+    return av_seek_frame(anim->pFormatCtx, -1, key_frame->pos, AVSEEK_FLAG_BYTE);
+  }
+  return av_seek_frame(
+      anim->pFormatCtx, anim->videoStream, key_frame->pts, AVSEEK_FLAG_BACKWARD);
+}
+
 /* Seek to last necessary key frame. */
 static int ffmpeg_seek_to_key_frame(struct anim *anim,
                                     int position,
@@ -1227,7 +1367,25 @@ static int ffmpeg_seek_to_key_frame(struct anim *anim,
   int64_t seek_pos;
   int ret;
 
-  if (tc_index) {
+  /* Built in the background on first use, when there is no timecode index. */
+  const struct anim_key_frame_index *key_frame_index = tc_index ?
+                                                           NULL :
+                                                           IMB_anim_key_frame_index_get(anim);
+  const struct anim_key_frame *key_frame = key_frame_index ?
+                                               IMB_key_frame_index_find(key_frame_index,
+                                                                        pts_to_search) :
+                                               NULL;
+
+  if (key_frame) {
+    if (key_frame->pts == anim->cur_key_frame_pts && position > anim->cur_position &&
+        anim->cur_pts < pts_to_search) {
+      /* The frame is further in the current GOP, no need to seek. */
+      return 0;
+    }
+    seek_pos = key_frame->pts;
+    ret = ffmpeg_seek_to_indexed_key_frame(anim, key_frame);
+  }
+  else if (tc_index) {
     /* We can use timestamps generated from our indexer to seek. */
     int new_frame_index = IMB_indexer_get_frame_index(tc_index, position);
     int old_frame_index = IMB_indexer_get_frame_index(tc_index, anim->cur_position);
@@ -1410,6 +1568,7 @@ static void free_anim_ffmpeg(struct anim *anim)
     av_frame_free(&anim->pFrame);
     av_frame_free(&anim->pFrameRGB);
     av_frame_free(&anim->pFrameDeinterlaced);
+    av_frame_free(&anim->pFrameHardware);
 
     sws_freeContext(anim->img_convert_ctx);
     IMB_freeImBuf(anim->cur_frame_final);
@@ -31,6 +31,7 @@
 #include "BLI_math_color.h"
 #include "BLI_rect.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "BKE_appdir.h"
@@ -2191,6 +2192,114 @@ void IMB_colormanagement_colorspace_to_scene_linear(float *buffer,
   }
 }
 
+typedef struct ImbufToTextureData {
+  const struct ImBuf *ibuf;
+  int offset_x;
+  int offset_y;
+  int width;
+  void *out_buffer;
+  OCIO_ConstCPUProcessorRcPtr *processor;
+  bool use_premultiply;
+  bool use_unpremultiply;
+} ImbufToTextureData;
+
+static void imbuf_to_byte_texture_row(void *__restrict userdata,
+                                      const int y,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ImbufToTextureData *data = userdata;
+  const struct ImBuf *ibuf = data->ibuf;
+  const int width = data->width;
+  const size_t in_offset = (data->offset_y + y) * ibuf->x + data->offset_x;
+  const size_t out_offset = y * width;
+  const unsigned char *in = (unsigned char *)ibuf->rect + in_offset * 4;
+  unsigned char *out = (unsigned char *)data->out_buffer + out_offset * 4;
+
+  if (data->processor != NULL) {
+    /* Convert to scene linear, to sRGB and premultiply. */
+    for (int x = 0; x < width; x++, in += 4, out += 4) {
+      float pixel[4];
+      rgba_uchar_to_float(pixel, in);
+      OCIO_cpuProcessorApplyRGB(data->processor, pixel);
+      linearrgb_to_srgb_v3_v3(pixel, pixel);
+      if (data->use_premultiply) {
+        mul_v3_fl(pixel, pixel[3]);
+      }
+      rgba_float_to_uchar(out, pixel);
+    }
+  }
+  else if (data->use_premultiply) {
+    /* Premultiply only. */
+    for (int x = 0; x < width; x++, in += 4, out += 4) {
+      out[0] = (in[0] * in[3]) >> 8;
+      out[1] = (in[1] * in[3]) >> 8;
+      out[2] = (in[2] * in[3]) >> 8;
+      out[3] = in[3];
+    }
+  }
+  else {
+    /* Copy only. */
+    memcpy(out, in, sizeof(unsigned char[4]) * width);
+  }
+}
+
+static void imbuf_to_float_texture_row(void *__restrict userdata,
+                                       const int y,
+                                       const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ImbufToTextureData *data = userdata;
+  const struct ImBuf *ibuf = data->ibuf;
+  const int width = data->width;
+  const int in_channels = ibuf->channels;
+  const size_t in_offset = (data->offset_y + y) * ibuf->x + data->offset_x;
+  const size_t out_offset = y * width;
+  const float *in = ibuf->rect_float + in_offset * in_channels;
+  float *out = (float *)data->out_buffer + out_offset * 4;
+
+  if (in_channels == 1) {
+    /* Copy single channel. */
+    for (int x = 0; x < width; x++, in += 1, out += 4) {
+      out[0] = in[0];
+      out[1] = in[0];
+      out[2] = in[0];
+      out[3] = in[0];
+    }
+  }
+  else if (in_channels == 3) {
+    /* Copy RGB. */
+    for (int x = 0; x < width; x++, in += 3, out += 4) {
+      out[0] = in[0];
+      out[1] = in[1];
+      out[2] = in[2];
+      out[3] = 1.0f;
+    }
+  }
+  else if (in_channels == 4) {
+    /* Copy or convert RGBA. */
+    if (data->use_unpremultiply) {
+      for (int x = 0; x < width; x++, in += 4, out += 4) {
+        premul_to_straight_v4_v4(out, in);
+      }
+    }
+    else {
+      memcpy(out, in, sizeof(float[4]) * width);
+    }
+  }
+}
+
+static void imbuf_to_texture_parallel(ImbufToTextureData *data,
+                                      const int height,
+                                      TaskParallelRangeFunc func)
+{
+  /* Large textures are converted on the draw thread the first time they are drawn, split the
+   * work over rows so that doesn't stall the viewport for long. */
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = ((size_t)data->width * height) > 256 * 256;
+  settings.min_iter_per_thread = 16;
+  BLI_task_parallel_range(0, height, data, func, &settings);
+}
+
 void IMB_colormanagement_imbuf_to_byte_texture(unsigned char *out_buffer,
                                                const int offset_x,
                                                const int offset_y,
@@ -2211,48 +2320,16 @@ void IMB_colormanagement_imbuf_to_byte_texture(unsigned char *out_buffer,
     processor = colorspace_to_scene_linear_cpu_processor(ibuf->rect_colorspace);
   }
 
-  /* TODO(brecht): make this multi-threaded, or at least process in batches. */
-  const unsigned char *in_buffer = (unsigned char *)ibuf->rect;
-  const bool use_premultiply = IMB_alpha_affects_rgb(ibuf) && store_premultiplied;
-
-  for (int y = 0; y < height; y++) {
-    const size_t in_offset = (offset_y + y) * ibuf->x + offset_x;
-    const size_t out_offset = y * width;
-    const unsigned char *in = in_buffer + in_offset * 4;
-    unsigned char *out = out_buffer + out_offset * 4;
-
-    if (processor != NULL) {
-      /* Convert to scene linear, to sRGB and premultiply. */
-      for (int x = 0; x < width; x++, in += 4, out += 4) {
-        float pixel[4];
-        rgba_uchar_to_float(pixel, in);
-        OCIO_cpuProcessorApplyRGB(processor, pixel);
-        linearrgb_to_srgb_v3_v3(pixel, pixel);
-        if (use_premultiply) {
-          mul_v3_fl(pixel, pixel[3]);
-        }
-        rgba_float_to_uchar(out, pixel);
-      }
-    }
-    else if (use_premultiply) {
-      /* Premultiply only. */
-      for (int x = 0; x < width; x++, in += 4, out += 4) {
-        out[0] = (in[0] * in[3]) >> 8;
-        out[1] = (in[1] * in[3]) >> 8;
-        out[2] = (in[2] * in[3]) >> 8;
-        out[3] = in[3];
-      }
-    }
-    else {
-      /* Copy only. */
-      for (int x = 0; x < width; x++, in += 4, out += 4) {
-        out[0] = in[0];
-        out[1] = in[1];
-        out[2] = in[2];
-        out[3] = in[3];
-      }
-    }
-  }
+  ImbufToTextureData data = {
+      .ibuf = ibuf,
+      .offset_x = offset_x,
+      .offset_y = offset_y,
+      .width = width,
+      .out_buffer = out_buffer,
+      .processor = processor,
+      .use_premultiply = IMB_alpha_affects_rgb(ibuf) && store_premultiplied,
+  };
+  imbuf_to_texture_parallel(&data, height, imbuf_to_byte_texture_row);
 }
 
 void IMB_colormanagement_imbuf_to_float_texture(float *out_buffer,
@@ -2265,46 +2342,15 @@ void IMB_colormanagement_imbuf_to_float_texture(float *out_buffer,
 {
   /* Float texture are stored in scene linear color space, with premultiplied
    * alpha depending on the image alpha mode. */
-  const float *in_buffer = ibuf->rect_float;
-  const int in_channels = ibuf->channels;
-  const bool use_unpremultiply = IMB_alpha_affects_rgb(ibuf) && !store_premultiplied;
-
-  for (int y = 0; y < height; y++) {
-    const size_t in_offset = (offset_y + y) * ibuf->x + offset_x;
-    const size_t out_offset = y * width;
-    const float *in = in_buffer + in_offset * in_channels;
-    float *out = out_buffer + out_offset * 4;
-
-    if (in_channels == 1) {
-      /* Copy single channel. */
-      for (int x = 0; x < width; x++, in += 1, out += 4) {
-        out[0] = in[0];
-        out[1] = in[0];
-        out[2] = in[0];
-        out[3] = in[0];
-      }
-    }
-    else if (in_channels == 3) {
-      /* Copy RGB. */
-      for (int x = 0; x < width; x++, in += 3, out += 4) {
-        out[0] = in[0];
-        out[1] = in[1];
-        out[2] = in[2];
-        out[3] = 1.0f;
-      }
-    }
-    else if (in_channels == 4) {
-      /* Copy or convert RGBA. */
-      if (use_unpremultiply) {
-        for (int x = 0; x < width; x++, in += 4, out += 4) {
-          premul_to_straight_v4_v4(out, in);
-        }
-      }
-      else {
-        memcpy(out, in, sizeof(float[4]) * width);
-      }
-    }
-  }
+  ImbufToTextureData data = {
+      .ibuf = ibuf,
+      .offset_x = offset_x,
+      .offset_y = offset_y,
+      .width = width,
+      .out_buffer = out_buffer,
+      .use_unpremultiply = IMB_alpha_affects_rgb(ibuf) && !store_premultiplied,
+  };
+  imbuf_to_texture_parallel(&data, height, imbuf_to_float_texture_row);
 }
 
 void IMB_colormanagement_scene_linear_to_color_picking_v3(float pixel[3])
@@ -3868,15 +3914,21 @@ void IMB_colormanagement_processor_apply_byte(
    * but for now it's not so important.
    */
   BLI_assert(channels == 4);
-  float pixel[4];
+
+  /* Convert one row at a time, so the OCIO processor is applied to a whole row in one call
+   * instead of once for every pixel. */
+  float *row_float = MEM_mallocN(sizeof(float[4]) * width, __func__);
   for (int y = 0; y < height; y++) {
+    unsigned char *row = buffer + channels * ((size_t)y) * width;
+    for (int x = 0; x < width; x++) {
+      rgba_uchar_to_float(row_float + 4 * x, row + channels * x);
+    }
+    IMB_colormanagement_processor_apply(cm_processor, row_float, width, 1, 4, false);
     for (int x = 0; x < width; x++) {
-      size_t offset = channels * (((size_t)y) * width + x);
-      rgba_uchar_to_float(pixel, buffer + offset);
-      IMB_colormanagement_processor_apply_v4(cm_processor, pixel);
-      rgba_float_to_uchar(buffer + offset, pixel);
+      rgba_float_to_uchar(row + channels * x, row_float + 4 * x);
     }
   }
+  MEM_freeN(row_float);
 }
 
 void IMB_colormanagement_processor_free(ColormanageProcessor *cm_processor)
@@ -16,6 +16,7 @@
 #include "BLI_math.h"
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 #ifdef _WIN32
@@ -24,6 +25,8 @@
 
 #include "PIL_time.h"
 
+#include "atomic_ops.h"
+
 #include "IMB_anim.h"
 #include "IMB_indexer.h"
 #include "imbuf.h"
@@ -54,6 +57,9 @@ static int tc_types[] = {
 
 #define INDEX_FILE_VERSION 2
 
+static const char key_frame_header_str[] = "BlenMKfi";
+#define KEY_FRAME_INDEX_FILE_VERSION 1
+
 /* ----------------------------------------------------------------------
  * - time code index functions
  * ---------------------------------------------------------------------- */
@@ -460,6 +466,244 @@ static void get_tc_filename(struct anim *anim, IMB_Timecode_Type tc, char *fname
   BLI_join_dirfile(fname, FILE_MAXFILE + FILE_MAXDIR, index_dir, index_name);
 }
 
+/* ----------------------------------------------------------------------
+ * - key frame index
+ * ---------------------------------------------------------------------- */
+
+#ifdef WITH_FFMPEG
+
+typedef struct KeyFrameIndexTask {
+  struct anim *anim;
+  char filepath[FILE_MAX];
+  char index_filepath[FILE_MAX];
+  int video_stream;
+} KeyFrameIndexTask;
+
+static void get_key_frame_index_filename(struct anim *anim, char *fname)
+{
+  char index_dir[FILE_MAXDIR];
+  char stream_suffix[20];
+  char index_name[256];
+
+  stream_suffix[0] = 0;
+
+  if (anim->streamindex > 0) {
+    BLI_snprintf(stream_suffix, 20, "_st%d", anim->streamindex);
+  }
+
+  BLI_snprintf(index_name, 256, "key_frames%s%s.blen_kf", stream_suffix, anim->suffix);
+
+  get_index_dir(anim, index_dir, sizeof(index_dir));
+
+  BLI_join_dirfile(fname, FILE_MAXFILE + FILE_MAXDIR, index_dir, index_name);
+}
+
+static void key_frame_index_free(struct anim_key_frame_index *idx)
+{
+  MEM_SAFE_FREE(idx->key_frames);
+  MEM_freeN(idx);
+}
+
+/**
+ * The header stores the size and modification time of the movie, so an index of a movie that
+ * was replaced isn't used.
+ */
+static struct anim_key_frame_index *key_frame_index_read(const char *index_filepath,
+                                                         const BLI_stat_t *movie_stat)
+{
+  FILE *fp = BLI_fopen(index_filepath, "rb");
+  if (!fp) {
+    return NULL;
+  }
+
+  char header[8];
+  char endian;
+  int version, num_key_frames;
+  int64_t movie_size, movie_mtime;
+  size_t items_read = 0;
+  items_read += fread(header, sizeof(header), 1, fp);
+  items_read += fread(&endian, sizeof(endian), 1, fp);
+  items_read += fread(&version, sizeof(version), 1, fp);
+  items_read += fread(&movie_size, sizeof(movie_size), 1, fp);
+  items_read += fread(&movie_mtime, sizeof(movie_mtime), 1, fp);
+  items_read += fread(&num_key_frames, sizeof(num_key_frames), 1, fp);
+
+  /* Indices are only written and read by the same machine, so other endians are just rebuilt. */
+  if (items_read != 6 || memcmp(header, key_frame_header_str, sizeof(header)) != 0 ||
+      endian != ((ENDIAN_ORDER == B_ENDIAN) ? 'V' : 'v') ||
+      version != KEY_FRAME_INDEX_FILE_VERSION || movie_size != (int64_t)movie_stat->st_size ||
+      movie_mtime != (int64_t)movie_stat->st_mtime || num_key_frames <= 0) {
+    fclose(fp);
+    return NULL;
+  }
+
+  struct anim_key_frame_index *idx = MEM_callocN(sizeof(*idx), __func__);
+  idx->num_key_frames = num_key_frames;
+  idx->key_frames = MEM_malloc_arrayN(num_key_frames, sizeof(anim_key_frame), __func__);
+  if (fread(idx->key_frames, sizeof(anim_key_frame), num_key_frames, fp) !=
+      (size_t)num_key_frames) {
+    fprintf(stderr, "Error: Element data size mismatch in: %s\n", index_filepath);
+    key_frame_index_free(idx);
+    idx = NULL;
+  }
+
+  fclose(fp);
+  return idx;
+}
+
+static void key_frame_index_write(const char *index_filepath,
+                                  const struct anim_key_frame_index *idx,
+                                  const BLI_stat_t *movie_stat)
+{
+  char temp_filepath[FILE_MAX];
+  BLI_snprintf(temp_filepath, sizeof(temp_filepath), "%s%s", index_filepath, temp_ext);
+
+  BLI_make_existing_file(temp_filepath);
+  FILE *fp = BLI_fopen(temp_filepath, "wb");
+  if (!fp) {
+    return;
+  }
+
+  const char endian = (ENDIAN_ORDER == B_ENDIAN) ? 'V' : 'v';
+  const int version = KEY_FRAME_INDEX_FILE_VERSION;
+  const int64_t movie_size = (int64_t)movie_stat->st_size;
+  const int64_t movie_mtime = (int64_t)movie_stat->st_mtime;
+  size_t items_written = 0;
+  items_written += fwrite(key_frame_header_str, 8, 1, fp);
+  items_written += fwrite(&endian, sizeof(endian), 1, fp);
+  items_written += fwrite(&version, sizeof(version), 1, fp);
+  items_written += fwrite(&movie_size, sizeof(movie_size), 1, fp);
+  items_written += fwrite(&movie_mtime, sizeof(movie_mtime), 1, fp);
+  items_written += fwrite(&idx->num_key_frames, sizeof(idx->num_key_frames), 1, fp);
+  items_written += fwrite(
+      idx->key_frames, sizeof(anim_key_frame) * idx->num_key_frames, 1, fp);
+  fclose(fp);
+
+  if (items_written != 7) {
+    unlink(temp_filepath);
+    return;
+  }
+  unlink(index_filepath);
+  BLI_rename(temp_filepath, index_filepath);
+}
+
+/* Read all packets of the video stream, without decoding them. */
+static struct anim_key_frame_index *key_frame_index_build(TaskPool *__restrict pool,
+                                                          const char *filepath,
+                                                          const int video_stream)
+{
+  AVFormatContext *format_ctx = NULL;
+  if (avformat_open_input(&format_ctx, filepath, NULL, NULL) != 0) {
+    return NULL;
+  }
+  if (avformat_find_stream_info(format_ctx, NULL) < 0 ||
+      video_stream >= (int)format_ctx->nb_streams) {
+    avformat_close_input(&format_ctx);
+    return NULL;
+  }
+
+  struct anim_key_frame_index *idx = MEM_callocN(sizeof(*idx), __func__);
+  int capacity = 0;
+
+  AVPacket *packet = av_packet_alloc();
+  while (av_read_frame(format_ctx, packet) >= 0) {
+    if (packet->stream_index == video_stream && (packet->flags & AV_PKT_FLAG_KEY)) {
+      if (idx->num_key_frames == capacity) {
+        capacity = max_ii(capacity * 2, 256);
+        idx->key_frames = MEM_reallocN(idx->key_frames, sizeof(anim_key_frame) * capacity);
+      }
+      anim_key_frame *key_frame = &idx->key_frames[idx->num_key_frames++];
+      key_frame->pts = timestamp_from_pts_or_dts(packet->pts, packet->dts);
+      key_frame->pos = packet->pos;
+    }
+    av_packet_unref(packet);
+
+    if (BLI_task_pool_current_canceled(pool)) {
+      break;
+    }
+  }
+  av_packet_free(&packet);
+  avformat_close_input(&format_ctx);
+
+  if (BLI_task_pool_current_canceled(pool) || idx->num_key_frames == 0) {
+    key_frame_index_free(idx);
+    return NULL;
+  }
+
+  /* Demuxers return packets in decoding order. */
+  for (int i = 1; i < idx->num_key_frames; i++) {
+    if (idx->key_frames[i].pts == AV_NOPTS_VALUE ||
+        idx->key_frames[i].pts <= idx->key_frames[i - 1].pts) {
+      /* Without increasing timestamps the index can't be searched. */
+      key_frame_index_free(idx);
+      return NULL;
+    }
+  }
+  return idx;
+}
+
+static void key_frame_index_task(TaskPool *__restrict pool, void *taskdata)
+{
+  KeyFrameIndexTask *task = taskdata;
+
+  BLI_stat_t movie_stat;
+  if (BLI_stat(task->filepath, &movie_stat) != 0) {
+    return;
+  }
+
+  struct anim_key_frame_index *idx = key_frame_index_read(task->index_filepath, &movie_stat);
+  if (idx == NULL) {
+    idx = key_frame_index_build(pool, task->filepath, task->video_stream);
+    if (idx == NULL) {
+      return;
+    }
+    key_frame_index_write(task->index_filepath, idx, &movie_stat);
+  }
+
+  atomic_cas_ptr((void **)&task->anim->key_frame_index, NULL, idx);
+}
+
+const struct anim_key_frame_index *IMB_anim_key_frame_index_get(struct anim *anim)
+{
+  if (anim->curtype != ANIM_FFMPEG || anim->pFormatCtx == NULL) {
+    return NULL;
+  }
+
+  if (anim->key_frame_index_pool == NULL) {
+    KeyFrameIndexTask *task = MEM_callocN(sizeof(*task), __func__);
+    task->anim = anim;
+    BLI_strncpy(task->filepath, anim->name, sizeof(task->filepath));
+    get_key_frame_index_filename(anim, task->index_filepath);
+    task->video_stream = anim->videoStream;
+
+    anim->key_frame_index_pool = BLI_task_pool_create_background(NULL, TASK_PRIORITY_LOW);
+    BLI_task_pool_push(anim->key_frame_index_pool, key_frame_index_task, task, true, NULL);
+    return NULL;
+  }
+
+  /* Only the task writes the pointer, once. */
+  return atomic_cas_ptr((void **)&anim->key_frame_index, NULL, NULL);
+}
+
+const struct anim_key_frame *IMB_key_frame_index_find(const struct anim_key_frame_index *idx,
+                                                      const int64_t pts)
+{
+  int first = 0;
+  int last = idx->num_key_frames;
+  while (first < last) {
+    const int middle = first + (last - first) / 2;
+    if (idx->key_frames[middle].pts <= pts) {
+      first = middle + 1;
+    }
+    else {
+      last = middle;
+    }
+  }
+  return first > 0 ? &idx->key_frames[first - 1] : NULL;
+}
+
+#endif /* WITH_FFMPEG */
+
 /* ----------------------------------------------------------------------
  * - common rebuilder structures
  * ---------------------------------------------------------------------- */
@@ -1516,6 +1760,18 @@ void IMB_free_indices(struct anim *anim)
     }
   }
 
+#ifdef WITH_FFMPEG
+  if (anim->key_frame_index_pool) {
+    BLI_task_pool_cancel(anim->key_frame_index_pool);
+    BLI_task_pool_free(anim->key_frame_index_pool);
+    anim->key_frame_index_pool = NULL;
+  }
+  if (anim->key_frame_index) {
+    key_frame_index_free(anim->key_frame_index);
+    anim->key_frame_index = NULL;
+  }
+#endif
+
   anim->proxies_tried = 0;
   anim->indices_tried = 0;
 }
@@ -79,6 +79,7 @@ _CRTIMP void __cdecl _invalid_parameter_noinfo(void)
 #include "BLI_blenlib.h"
 #include "BLI_math_color.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "BKE_idprop.h"
@@ -1096,6 +1097,26 @@ void IMB_exr_clear_channels(void *handle)
   BLI_freelistN(&data->channels);
 }
 
+struct ExrHalfChannelData {
+  const float *rect;
+  int xstride;
+  int width;
+  half *rect_half;
+};
+
+static void exr_channel_to_half_row(void *__restrict userdata,
+                                    const int y,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ExrHalfChannelData *data = static_cast<const ExrHalfChannelData *>(userdata);
+  const size_t offset = ((size_t)y) * data->width;
+  const float *rect = data->rect + offset * data->xstride;
+  half *cur = data->rect_half + offset;
+  for (int x = 0; x < data->width; x++, cur++) {
+    *cur = float_to_half_safe(rect[((size_t)x) * data->xstride]);
+  }
+}
+
 void IMB_exr_write_channels(void *handle)
 {
   ExrHandle *data = (ExrHandle *)handle;
@@ -1116,11 +1137,14 @@ void IMB_exr_write_channels(void *handle)
     for (echan = (ExrChannel *)data->channels.first; echan; echan = echan->next) {
       /* Writing starts from last scan-line, stride negative. */
       if (echan->use_half_float) {
-        float *rect = echan->rect;
-        half *cur = current_rect_half;
-        for (size_t i = 0; i < num_pixels; i++, cur++) {
-          *cur = float_to_half_safe(rect[i * echan->xstride]);
-        }
+        /* Conversion of large multilayer images takes a significant part of the write time. */
+        ExrHalfChannelData half_data = {
+            echan->rect, echan->xstride, data->width, current_rect_half};
+        TaskParallelSettings settings;
+        BLI_parallel_range_settings_defaults(&settings);
+        settings.use_threading = num_pixels > 256 * 256;
+        settings.min_iter_per_thread = 16;
+        BLI_task_parallel_range(0, data->height, &half_data, exr_channel_to_half_row, &settings);
         half *rect_to_write = current_rect_half + (data->height - 1L) * data->width;
         frameBuffer.insert(
             echan->name,
@@ -1894,6 +1918,58 @@ static bool imb_exr_is_multi(MultiPartInputFile &file)
   return false;
 }
 
+bool IMB_exr_rgba_rows_read(
+    const char *filepath, int *r_width, int *r_height, const int ymin, const int ymax, float *rect)
+{
+  /* 32 is arbitrary, but zero length files crashes exr. */
+  if (!(BLI_exists(filepath) && BLI_file_size(filepath) > 32)) {
+    return false;
+  }
+
+  try {
+    IFileStream stream(filepath);
+    MultiPartInputFile file(stream);
+
+    const char *rgb_channels[3];
+    if (imb_exr_is_multi(file) || exr_has_rgb(file, rgb_channels) != 3) {
+      return false;
+    }
+
+    const Box2i dw = file.header(0).dataWindow();
+    const int width = dw.max.x - dw.min.x + 1;
+    const int height = dw.max.y - dw.min.y + 1;
+    *r_width = width;
+    *r_height = height;
+    if (rect == nullptr) {
+      return true;
+    }
+    BLI_assert(0 <= ymin && ymin < ymax && ymax <= height);
+
+    /* Like #imb_load_openexr, but the first pixel is in row `ymin` of the y-flipped image. */
+    const size_t xstride = sizeof(float[4]);
+    const size_t ystride = -xstride * width;
+    float *first = rect + 4 * (ptrdiff_t(dw.min.y + height - 1 - ymin) * width - dw.min.x);
+
+    FrameBuffer frameBuffer;
+    for (int i = 0; i < 3; i++) {
+      frameBuffer.insert(exr_rgba_channelname(file, rgb_channels[i]),
+                         Slice(Imf::FLOAT, (char *)(first + i), xstride, ystride));
+    }
+    frameBuffer.insert(exr_rgba_channelname(file, "A"),
+                       Slice(Imf::FLOAT, (char *)(first + 3), xstride, ystride, 1, 1, 1.0f));
+
+    /* Only the scan-lines or tiles overlapping the rows are decoded. */
+    InputPart in(file, 0);
+    in.setFrameBuffer(frameBuffer);
+    in.readPixels(dw.min.y + height - ymax, dw.min.y + height - 1 - ymin);
+  }
+  catch (const std::exception &exc) {
+    std::cerr << "OpenEXR-readPixels: ERROR: " << exc.what() << std::endl;
+    return false;
+  }
+  return true;
+}
+
 bool IMB_exr_has_multilayer(void *handle)
 {
   ExrHandle *data = (ExrHandle *)handle;
@@ -74,6 +74,15 @@ float *IMB_exr_channel_rect(void * /*handle*/,
 void IMB_exr_read_channels(void * /*handle*/)
 {
 }
+bool IMB_exr_rgba_rows_read(const char * /*filepath*/,
+                            int * /*r_width*/,
+                            int * /*r_height*/,
+                            int /*ymin*/,
+                            int /*ymax*/,
+                            float * /*rect*/)
+{
+  return false;
+}
 void IMB_exr_write_channels(void * /*handle*/)
 {
 }
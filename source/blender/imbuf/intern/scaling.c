@@ -9,6 +9,7 @@
 
 #include "BLI_math_color.h"
 #include "BLI_math_interp.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 #include "MEM_guardedalloc.h"
 
@@ -1688,22 +1689,54 @@ struct imbufRGBA {
   float r, g, b, a;
 };
 
+typedef struct ScaleFastData {
+  const unsigned int *rect;
+  unsigned int *newrect;
+  const struct imbufRGBA *rectf;
+  struct imbufRGBA *newrectf;
+  /** Source column of every destination column, the same for all rows. */
+  const size_t *src_x;
+  size_t stepy;
+  int width;
+  int newx;
+} ScaleFastData;
+
+static void scalefast_row(void *__restrict userdata,
+                          const int y,
+                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ScaleFastData *data = userdata;
+  const size_t src_row = ((32768 + (size_t)y * data->stepy) >> 16) * data->width;
+  const size_t dst_row = (size_t)y * data->newx;
+
+  if (data->newrect) {
+    const unsigned int *rect = data->rect + src_row;
+    unsigned int *newrect = data->newrect + dst_row;
+    for (int x = 0; x < data->newx; x++) {
+      newrect[x] = rect[data->src_x[x]];
+    }
+  }
+
+  if (data->newrectf) {
+    const struct imbufRGBA *rectf = data->rectf + src_row;
+    struct imbufRGBA *newrectf = data->newrectf + dst_row;
+    for (int x = 0; x < data->newx; x++) {
+      newrectf[x] = rectf[data->src_x[x]];
+    }
+  }
+}
+
 bool IMB_scalefastImBuf(struct ImBuf *ibuf, unsigned int newx, unsigned int newy)
 {
   BLI_assert_msg(newx > 0 && newy > 0, "Images must be at least 1 on both dimensions!");
 
-  unsigned int *rect, *_newrect, *newrect;
-  struct imbufRGBA *rectf, *_newrectf, *newrectf;
-  int x, y;
+  unsigned int *_newrect;
+  struct imbufRGBA *_newrectf;
   bool do_float = false, do_rect = false;
-  size_t ofsx, ofsy, stepx, stepy;
+  size_t stepx, stepy;
 
-  rect = NULL;
   _newrect = NULL;
-  newrect = NULL;
-  rectf = NULL;
   _newrectf = NULL;
-  newrectf = NULL;
 
   if (ibuf == NULL) {
     return false;
@@ -1727,7 +1760,6 @@ bool IMB_scalefastImBuf(struct ImBuf *ibuf, unsigned int newx, unsigned int newy
     if (_newrect == NULL) {
       return false;
     }
-    newrect = _newrect;
   }
 
   if (do_float) {
@@ -1738,34 +1770,35 @@ bool IMB_scalefastImBuf(struct ImBuf *ibuf, unsigned int newx, unsigned int newy
       }
       return false;
     }
-    newrectf = _newrectf;
   }
 
   stepx = round(65536.0 * (ibuf->x - 1.0) / (newx - 1.0));
   stepy = round(65536.0 * (ibuf->y - 1.0) / (newy - 1.0));
-  ofsy = 32768;
 
-  for (y = newy; y > 0; y--, ofsy += stepy) {
-    if (do_rect) {
-      rect = ibuf->rect;
-      rect += (ofsy >> 16) * ibuf->x;
-      ofsx = 32768;
-
-      for (x = newx; x > 0; x--, ofsx += stepx) {
-        *newrect++ = rect[ofsx >> 16];
-      }
-    }
-
-    if (do_float) {
-      rectf = (struct imbufRGBA *)ibuf->rect_float;
-      rectf += (ofsy >> 16) * ibuf->x;
-      ofsx = 32768;
-
-      for (x = newx; x > 0; x--, ofsx += stepx) {
-        *newrectf++ = rectf[ofsx >> 16];
-      }
-    }
-  }
+  size_t *src_x = MEM_mallocN(sizeof(*src_x) * newx, __func__);
+  size_t ofsx = 32768;
+  for (int x = 0; x < (int)newx; x++, ofsx += stepx) {
+    src_x[x] = ofsx >> 16;
+  }
+
+  ScaleFastData data = {
+      .rect = ibuf->rect,
+      .newrect = _newrect,
+      .rectf = (const struct imbufRGBA *)ibuf->rect_float,
+      .newrectf = _newrectf,
+      .src_x = src_x,
+      .stepy = stepy,
+      .width = ibuf->x,
+      .newx = (int)newx,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = ((size_t)newx * newy) > 256 * 256;
+  settings.min_iter_per_thread = 16;
+  BLI_task_parallel_range(0, (int)newy, &data, scalefast_row, &settings);
+
+  MEM_freeN(src_x);
 
   if (do_rect) {
     imb_freerectImBuf(ibuf);
@@ -8,6 +8,7 @@
 #include "imbuf.h"
 
 #include "BLI_math.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 #include "MEM_guardedalloc.h"
 
@@ -263,3 +264,285 @@ GPUTexture *IMB_create_gpu_texture(const char *name,
 
   return tex;
 }
+
+/* -------------------------------------------------------------------- */
+/** \name Block Compression
+ *
+ * Encode byte images as DXT1 (BC1) when they are opaque and DXT5 (BC3) otherwise. The end-points
+ * of every 4x4 block are fitted along the principal axis of its colors, which is fast enough to
+ * run at load time, with a lower quality than offline encoders.
+ * \{ */
+
+static ushort imb_dxt_color_pack_565(const float color[3])
+{
+  const int r = clamp_i((int)(color[0] * (31.0f / 255.0f) + 0.5f), 0, 31);
+  const int g = clamp_i((int)(color[1] * (63.0f / 255.0f) + 0.5f), 0, 63);
+  const int b = clamp_i((int)(color[2] * (31.0f / 255.0f) + 0.5f), 0, 31);
+  return (ushort)((r << 11) | (g << 5) | b);
+}
+
+static void imb_dxt_color_unpack_565(const ushort packed, float r_color[3])
+{
+  r_color[0] = (float)((packed >> 11) & 31) * (255.0f / 31.0f);
+  r_color[1] = (float)((packed >> 5) & 63) * (255.0f / 63.0f);
+  r_color[2] = (float)(packed & 31) * (255.0f / 31.0f);
+}
+
+static void imb_dxt_encode_color_block(const uchar block[16][4], uchar *r_dst)
+{
+  float mean[3] = {0.0f};
+  for (int i = 0; i < 16; i++) {
+    mean[0] += block[i][0];
+    mean[1] += block[i][1];
+    mean[2] += block[i][2];
+  }
+  mul_v3_fl(mean, 1.0f / 16.0f);
+
+  float covariance[3][3] = {{0.0f}};
+  for (int i = 0; i < 16; i++) {
+    const float d[3] = {block[i][0] - mean[0], block[i][1] - mean[1], block[i][2] - mean[2]};
+    for (int a = 0; a < 3; a++) {
+      for (int b = 0; b < 3; b++) {
+        covariance[a][b] += d[a] * d[b];
+      }
+    }
+  }
+
+  /* Principal axis from a few power iterations. */
+  float axis[3] = {1.0f, 1.0f, 1.0f};
+  for (int iter = 0; iter < 4; iter++) {
+    float next[3];
+    mul_v3_m3v3(next, covariance, axis);
+    if (normalize_v3_v3(axis, next) == 0.0f) {
+      copy_v3_fl(axis, 1.0f);
+      break;
+    }
+  }
+
+  float proj_min = FLT_MAX, proj_max = -FLT_MAX;
+  for (int i = 0; i < 16; i++) {
+    const float d[3] = {block[i][0] - mean[0], block[i][1] - mean[1], block[i][2] - mean[2]};
+    const float proj = dot_v3v3(d, axis);
+    proj_min = min_ff(proj_min, proj);
+    proj_max = max_ff(proj_max, proj);
+  }
+
+  float end[2][3];
+  madd_v3_v3v3fl(end[0], mean, axis, proj_max);
+  madd_v3_v3v3fl(end[1], mean, axis, proj_min);
+  ushort packed[2] = {imb_dxt_color_pack_565(end[0]), imb_dxt_color_pack_565(end[1])};
+  /* Four color mode needs the first end-point to be the largest. */
+  if (packed[0] < packed[1]) {
+    SWAP(ushort, packed[0], packed[1]);
+  }
+
+  float palette[4][3];
+  imb_dxt_color_unpack_565(packed[0], palette[0]);
+  imb_dxt_color_unpack_565(packed[1], palette[1]);
+  interp_v3_v3v3(palette[2], palette[0], palette[1], 1.0f / 3.0f);
+  interp_v3_v3v3(palette[3], palette[0], palette[1], 2.0f / 3.0f);
+
+  uint indices = 0;
+  if (packed[0] != packed[1]) {
+    for (int i = 0; i < 16; i++) {
+      const float color[3] = {block[i][0], block[i][1], block[i][2]};
+      uint best = 0;
+      float best_dist = FLT_MAX;
+      for (uint p = 0; p < 4; p++) {
+        const float dist = len_squared_v3v3(color, palette[p]);
+        if (dist < best_dist) {
+          best_dist = dist;
+          best = p;
+        }
+      }
+      indices |= best << (i * 2);
+    }
+  }
+
+  r_dst[0] = (uchar)(packed[0] & 0xFF);
+  r_dst[1] = (uchar)(packed[0] >> 8);
+  r_dst[2] = (uchar)(packed[1] & 0xFF);
+  r_dst[3] = (uchar)(packed[1] >> 8);
+  r_dst[4] = (uchar)(indices & 0xFF);
+  r_dst[5] = (uchar)((indices >> 8) & 0xFF);
+  r_dst[6] = (uchar)((indices >> 16) & 0xFF);
+  r_dst[7] = (uchar)(indices >> 24);
+}
+
+static void imb_dxt_encode_alpha_block(const uchar block[16][4], uchar *r_dst)
+{
+  int alpha_min = 255, alpha_max = 0;
+  for (int i = 0; i < 16; i++) {
+    alpha_min = min_ii(alpha_min, block[i][3]);
+    alpha_max = max_ii(alpha_max, block[i][3]);
+  }
+
+  /* Eight alpha mode, the first end-point is the largest. */
+  float palette[8];
+  palette[0] = (float)alpha_max;
+  palette[1] = (float)alpha_min;
+  for (int p = 2; p < 8; p++) {
+    palette[p] = ((8 - p) * palette[0] + (p - 1) * palette[1]) / 7.0f;
+  }
+
+  uint64_t indices = 0;
+  if (alpha_min != alpha_max) {
+    for (int i = 0; i < 16; i++) {
+      uint64_t best = 0;
+      float best_dist = FLT_MAX;
+      for (uint64_t p = 0; p < 8; p++) {
+        const float dist = fabsf(palette[p] - block[i][3]);
+        if (dist < best_dist) {
+          best_dist = dist;
+          best = p;
+        }
+      }
+      indices |= best << (i * 3);
+    }
+  }
+
+  r_dst[0] = (uchar)alpha_max;
+  r_dst[1] = (uchar)alpha_min;
+  for (int i = 0; i < 6; i++) {
+    r_dst[2 + i] = (uchar)((indices >> (i * 8)) & 0xFF);
+  }
+}
+
+typedef struct DXTEncodeData {
+  const uchar *rect;
+  int size[2];
+  bool use_alpha;
+  uchar *dst;
+} DXTEncodeData;
+
+static void imb_dxt_encode_row(void *__restrict userdata,
+                               const int block_y,
+                               const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const DXTEncodeData *data = (const DXTEncodeData *)userdata;
+  const int blocks_x = (data->size[0] + 3) / 4;
+  const int block_size = data->use_alpha ? 16 : 8;
+  uchar *dst = data->dst + (size_t)block_y * blocks_x * block_size;
+
+  for (int block_x = 0; block_x < blocks_x; block_x++, dst += block_size) {
+    uchar block[16][4];
+    for (int i = 0; i < 16; i++) {
+      /* Repeat the last pixels for the levels smaller than a block. */
+      const int x = min_ii(block_x * 4 + (i & 3), data->size[0] - 1);
+      const int y = min_ii(block_y * 4 + (i >> 2), data->size[1] - 1);
+      copy_v4_v4_uchar(block[i], data->rect + ((size_t)y * data->size[0] + x) * 4);
+    }
+    if (data->use_alpha) {
+      imb_dxt_encode_alpha_block(block, dst);
+      imb_dxt_encode_color_block(block, dst + 8);
+    }
+    else {
+      imb_dxt_encode_color_block(block, dst);
+    }
+  }
+}
+
+/* Average of 2x2 pixels of the previous mipmap level. */
+static uchar *imb_dxt_mip_downsample(const uchar *rect, const int size[2], int r_size[2])
+{
+  r_size[0] = max_ii(size[0] / 2, 1);
+  r_size[1] = max_ii(size[1] / 2, 1);
+  uchar *result = MEM_mallocN(sizeof(uchar[4]) * r_size[0] * r_size[1], __func__);
+  for (int y = 0; y < r_size[1]; y++) {
+    const int y0 = min_ii(y * 2, size[1] - 1), y1 = min_ii(y * 2 + 1, size[1] - 1);
+    for (int x = 0; x < r_size[0]; x++) {
+      const int x0 = min_ii(x * 2, size[0] - 1), x1 = min_ii(x * 2 + 1, size[0] - 1);
+      for (int c = 0; c < 4; c++) {
+        const int sum = rect[(y0 * size[0] + x0) * 4 + c] + rect[(y0 * size[0] + x1) * 4 + c] +
+                        rect[(y1 * size[0] + x0) * 4 + c] + rect[(y1 * size[0] + x1) * 4 + c];
+        result[(y * r_size[0] + x) * 4 + c] = (uchar)((sum + 2) / 4);
+      }
+    }
+  }
+  return result;
+}
+
+GPUTexture *IMB_create_gpu_texture_compressed(const char *name,
+                                              ImBuf *ibuf,
+                                              bool use_premult,
+                                              bool limit_gl_texture_size)
+{
+  if (ibuf->rect == NULL || ibuf->rect_float != NULL) {
+    return NULL;
+  }
+
+  int size[2] = {GPU_texture_size_with_limit(ibuf->x, limit_gl_texture_size),
+                 GPU_texture_size_with_limit(ibuf->y, limit_gl_texture_size)};
+  const bool do_rescale = (ibuf->x != size[0]) || (ibuf->y != size[1]);
+  /* Same restriction as the DDS images. */
+  if (!is_power_of_2_i(size[0]) || !is_power_of_2_i(size[1]) || min_ii(UNPACK2(size)) < 4) {
+    return NULL;
+  }
+
+  eGPUDataFormat data_format;
+  eGPUTextureFormat tex_format;
+  imb_gpu_get_format(ibuf, false, &data_format, &tex_format);
+  const bool compress_as_srgb = (tex_format == GPU_SRGB8_A8);
+
+  bool freebuf = false;
+  uchar *rect = imb_gpu_get_data(ibuf, do_rescale, size, compress_as_srgb, use_premult, &freebuf);
+  if (rect == NULL) {
+    return NULL;
+  }
+
+  bool use_alpha = false;
+  for (size_t i = 0; i < (size_t)size[0] * size[1]; i++) {
+    if (rect[i * 4 + 3] != 255) {
+      use_alpha = true;
+      break;
+    }
+  }
+  const int block_size = use_alpha ? 16 : 8;
+  if (use_alpha) {
+    tex_format = compress_as_srgb ? GPU_SRGB8_A8_DXT5 : GPU_RGBA8_DXT5;
+  }
+  else {
+    tex_format = compress_as_srgb ? GPU_SRGB8_A8_DXT1 : GPU_RGBA8_DXT1;
+  }
+
+  const int miplen = 1 + (int)floorf(log2f((float)max_ii(UNPACK2(size))));
+  size_t data_len = 0;
+  for (int mip = 0; mip < miplen; mip++) {
+    const int mip_size[2] = {max_ii(size[0] >> mip, 1), max_ii(size[1] >> mip, 1)};
+    data_len += (size_t)((mip_size[0] + 3) / 4) * ((mip_size[1] + 3) / 4) * block_size;
+  }
+  uchar *data = MEM_mallocN(data_len, __func__);
+
+  DXTEncodeData encode_data = {.rect = rect, .use_alpha = use_alpha, .dst = data};
+  copy_v2_v2_int(encode_data.size, size);
+  for (int mip = 0; mip < miplen; mip++) {
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    const int blocks_y = (encode_data.size[1] + 3) / 4;
+    BLI_task_parallel_range(0, blocks_y, &encode_data, imb_dxt_encode_row, &settings);
+    encode_data.dst += (size_t)((encode_data.size[0] + 3) / 4) * blocks_y * block_size;
+
+    if (mip + 1 < miplen) {
+      int next_size[2];
+      uchar *next_rect = imb_dxt_mip_downsample(encode_data.rect, encode_data.size, next_size);
+      if (encode_data.rect != rect || freebuf) {
+        MEM_freeN((void *)encode_data.rect);
+      }
+      encode_data.rect = next_rect;
+      copy_v2_v2_int(encode_data.size, next_size);
+    }
+  }
+  if (encode_data.rect != rect || freebuf) {
+    MEM_freeN((void *)encode_data.rect);
+  }
+
+  GPUTexture *tex = GPU_texture_create_compressed_2d(
+      name, UNPACK2(size), miplen, tex_format, data);
+  MEM_freeN(data);
+  if (tex != NULL) {
+    GPU_texture_anisotropic_filter(tex, true);
+  }
+  return tex;
+}
+
+/** \} */
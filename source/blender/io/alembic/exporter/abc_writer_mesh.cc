@@ -10,6 +10,7 @@
 
 #include "BLI_assert.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.hh"
 
 #include "BKE_attribute.h"
 #include "BKE_customdata.h"
@@ -435,11 +436,13 @@ static void get_vertices(struct Mesh *mesh, std::vector<Imath::V3f> &points)
   points.clear();
   points.resize(mesh->totvert);
 
-  MVert *verts = mesh->mvert;
+  const MVert *verts = mesh->mvert;
 
-  for (int i = 0, e = mesh->totvert; i < e; i++) {
-    copy_yup_from_zup(points[i].getValue(), verts[i].co);
-  }
+  threading::parallel_for(IndexRange(mesh->totvert), 4096, [&](IndexRange range) {
+    for (const int i : range) {
+      copy_yup_from_zup(points[i].getValue(), verts[i].co);
+    }
+  });
 }
 
 static void get_topology(struct Mesh *mesh,
@@ -471,11 +471,10 @@ static void read_velocity(const V3fArraySamplePtr &velocities,
 static void read_mesh_sample(const std::string &iobject_full_name,
                              ImportSettings *settings,
                              const IPolyMeshSchema &schema,
+                             const IPolyMeshSchema::Sample &sample,
                              const ISampleSelector &selector,
                              CDStreamConfig &config)
 {
-  const IPolyMeshSchema::Sample sample = schema.getValue(selector);
-
   AbcMeshData abc_mesh_data;
   abc_mesh_data.face_counts = sample.getFaceCounts();
   abc_mesh_data.face_indices = sample.getFaceIndices();
@@ -733,7 +732,9 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
   settings.velocity_name = velocity_name;
   settings.velocity_scale = velocity_scale;
 
-  if (topology_changed(existing_mesh, sample_sel)) {
+  /* Same test as #topology_changed, without reading the sample again. */
+  if (positions->size() != existing_mesh->totvert || face_counts->size() != existing_mesh->totpoly ||
+      face_indices->size() != existing_mesh->totloop) {
     new_mesh = BKE_mesh_new_nomain_from_template(
         existing_mesh, positions->size(), 0, 0, face_indices->size(), face_counts->size());
 
@@ -761,7 +762,7 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
   config.time = sample_sel.getRequestedTime();
   config.modifier_error_message = err_str;
 
-  read_mesh_sample(m_iobject.getFullName(), &settings, m_schema, sample_sel, config);
+  read_mesh_sample(m_iobject.getFullName(), &settings, m_schema, sample, sample_sel, config);
 
   if (new_mesh) {
     /* Here we assume that the number of materials doesn't change, i.e. that
@@ -851,11 +852,10 @@ BLI_INLINE MEdge *find_edge(MEdge *edges, int totedge, int v1, int v2)
 static void read_subd_sample(const std::string &iobject_full_name,
                              ImportSettings *settings,
                              const ISubDSchema &schema,
+                             const ISubDSchema::Sample &sample,
                              const ISampleSelector &selector,
                              CDStreamConfig &config)
 {
-  const ISubDSchema::Sample sample = schema.getValue(selector);
-
   AbcMeshData abc_mesh_data;
   abc_mesh_data.face_counts = sample.getFaceCounts();
   abc_mesh_data.face_indices = sample.getFaceIndices();
@@ -1094,7 +1094,7 @@ Mesh *AbcSubDReader::read_mesh(Mesh *existing_mesh,
   const bool use_vertex_interpolation = read_flag & MOD_MESHSEQ_INTERPOLATE_VERTICES;
   CDStreamConfig config = get_config(mesh_to_export, use_vertex_interpolation);
   config.time = sample_sel.getRequestedTime();
-  read_subd_sample(m_iobject.getFullName(), &settings, m_schema, sample_sel, config);
+  read_subd_sample(m_iobject.getFullName(), &settings, m_schema, sample, sample_sel, config);
 
   return mesh_to_export;
 }
@@ -0,0 +1,24 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup stl
+ */
+
+#include "BLI_timeit.hh"
+
+#include "IO_stl.h"
+
+#include "stl_exporter.hh"
+#include "stl_importer.hh"
+
+void STL_import(bContext *C, const STLImportParams *import_params)
+{
+  SCOPED_TIMER("STL import");
+  blender::io::stl::importer_main(C, *import_params);
+}
+
+void STL_export(bContext *C, const STLExportParams *export_params)
+{
+  SCOPED_TIMER("STL export");
+  blender::io::stl::exporter_main(C, *export_params);
+}
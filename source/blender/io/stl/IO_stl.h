@@ -0,0 +1,51 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup stl
+ */
+
+#pragma once
+
+#include "BKE_context.h"
+#include "BLI_path_util.h"
+
+#include "IO_wavefront_obj.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct STLImportParams {
+  /** Full path to the source STL file to import. */
+  char filepath[FILE_MAX];
+  /** Applied to the vertex coordinates. */
+  float global_scale;
+  /** Value 0 disables clamping. */
+  float clamp_size;
+  eTransformAxisForward forward_axis;
+  eTransformAxisUp up_axis;
+};
+
+struct STLExportParams {
+  /** Full path to the destination STL file. */
+  char filepath[FILE_MAX];
+  float global_scale;
+  eTransformAxisForward forward_axis;
+  eTransformAxisUp up_axis;
+  bool export_selected_objects;
+  bool apply_modifiers;
+};
+
+/**
+ * Import a binary or ASCII STL file as a single mesh object.
+ */
+void STL_import(bContext *C, const struct STLImportParams *import_params);
+
+/**
+ * Export the triangles of all mesh objects to one binary STL file.
+ */
+void STL_export(bContext *C, const struct STLExportParams *export_params);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,135 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup stl
+ */
+
+#include <cstdio>
+#include <cstring>
+
+#include "BKE_context.h"
+#include "BKE_mesh.h"
+#include "BKE_mesh_runtime.h"
+#include "BKE_object.h"
+
+#include "BLI_array.hh"
+#include "BLI_endian_defines.h"
+#include "BLI_endian_switch.h"
+#include "BLI_fileops.h"
+#include "BLI_math_geom.h"
+#include "BLI_math_matrix.h"
+#include "BLI_math_rotation.h"
+#include "BLI_math_vec_types.hh"
+#include "BLI_math_vector.h"
+#include "BLI_string.h"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
+
+#include "DEG_depsgraph.h"
+#include "DEG_depsgraph_query.h"
+
+#include "DNA_layer_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_object_types.h"
+
+#include "stl_exporter.hh"
+
+namespace blender::io::stl {
+
+/** Normal, three corners and a 16 bit attribute. */
+static constexpr size_t BINARY_TRIANGLE_SIZE = sizeof(float[4][3]) + sizeof(uint16_t);
+
+/**
+ * Triangles of one object in the binary STL layout, transformed to the export space.
+ */
+static Array<char> object_triangles_get(const Object &object,
+                                        const Mesh &mesh,
+                                        const float axes_transform[4][4])
+{
+  float world_to_export[4][4];
+  mul_m4_m4m4(world_to_export, axes_transform, object.obmat);
+
+  const MLoopTri *looptris = BKE_mesh_runtime_looptri_ensure(&mesh);
+  const int looptris_num = BKE_mesh_runtime_looptri_len(&mesh);
+  Array<char> data(int64_t(looptris_num) * BINARY_TRIANGLE_SIZE, 0);
+  threading::parallel_for(IndexRange(looptris_num), 4096, [&](IndexRange range) {
+    for (const int64_t i : range) {
+      float tri[4][3];
+      for (int corner = 0; corner < 3; corner++) {
+        const MVert &vert = mesh.mvert[mesh.mloop[looptris[i].tri[corner]].v];
+        mul_v3_m4v3(tri[corner + 1], world_to_export, vert.co);
+      }
+      normal_tri_v3(tri[0], tri[1], tri[2], tri[3]);
+      if (ENDIAN_ORDER == B_ENDIAN) {
+        BLI_endian_switch_float_array(&tri[0][0], 12);
+      }
+      memcpy(&data[i * BINARY_TRIANGLE_SIZE], tri, sizeof(tri));
+    }
+  });
+  return data;
+}
+
+void exporter_main(bContext *C, const STLExportParams &export_params)
+{
+  Depsgraph *depsgraph = CTX_data_ensure_evaluated_depsgraph(C);
+
+  float axes_transform[3][3];
+  /* +Y-forward and +Z-up are the default Blender axis settings. */
+  mat3_from_axis_conversion(OBJ_AXIS_Y_FORWARD,
+                            OBJ_AXIS_Z_UP,
+                            export_params.forward_axis,
+                            export_params.up_axis,
+                            axes_transform);
+  /* mat3_from_axis_conversion returns a transposed matrix! */
+  transpose_m3(axes_transform);
+  mul_m3_fl(axes_transform, export_params.global_scale);
+  float axes_transform_4x4[4][4];
+  copy_m4_m3(axes_transform_4x4, axes_transform);
+
+  /* Triangles are converted in parallel, one object at a time since dupli objects are only
+   * valid during the iteration. */
+  Vector<Array<char>> object_data;
+  const int deg_objects_visibility_flags = DEG_ITER_OBJECT_FLAG_LINKED_DIRECTLY |
+                                           DEG_ITER_OBJECT_FLAG_LINKED_VIA_SET |
+                                           DEG_ITER_OBJECT_FLAG_VISIBLE |
+                                           DEG_ITER_OBJECT_FLAG_DUPLI;
+  DEG_OBJECT_ITER_BEGIN (depsgraph, object, deg_objects_visibility_flags) {
+    if (export_params.export_selected_objects && !(object->base_flag & BASE_SELECTED)) {
+      continue;
+    }
+    if (object->type != OB_MESH) {
+      continue;
+    }
+    const Mesh *mesh = export_params.apply_modifiers ? BKE_object_get_evaluated_mesh(object) :
+                                                       BKE_object_get_pre_modified_mesh(object);
+    if (mesh != nullptr) {
+      object_data.append(object_triangles_get(*object, *mesh, axes_transform_4x4));
+    }
+  }
+  DEG_OBJECT_ITER_END;
+
+  FILE *outfile = BLI_fopen(export_params.filepath, "wb");
+  if (outfile == nullptr) {
+    fprintf(stderr, "Cannot write to STL file:'%s'\n", export_params.filepath);
+    return;
+  }
+
+  char header[80] = {0};
+  STRNCPY(header, "Binary STL written by Blender");
+  uint32_t tris_num = 0;
+  for (const Array<char> &data : object_data) {
+    tris_num += uint32_t(data.size() / BINARY_TRIANGLE_SIZE);
+  }
+  if (ENDIAN_ORDER == B_ENDIAN) {
+    BLI_endian_switch_uint32(&tris_num);
+  }
+  fwrite(header, sizeof(header), 1, outfile);
+  fwrite(&tris_num, sizeof(tris_num), 1, outfile);
+  for (const Array<char> &data : object_data) {
+    fwrite(data.data(), 1, data.size(), outfile);
+  }
+  fclose(outfile);
+}
+
+}  // namespace blender::io::stl
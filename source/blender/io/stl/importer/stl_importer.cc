@@ -0,0 +1,210 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup stl
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+
+#ifndef WIN32
+#  include <unistd.h>
+#else
+#  include <io.h>
+#endif
+
+#include "BKE_collection.h"
+#include "BKE_context.h"
+#include "BKE_customdata.h"
+#include "BKE_layer.h"
+#include "BKE_mesh.h"
+#include "BKE_object.h"
+
+#include "BLI_array.hh"
+#include "BLI_endian_defines.h"
+#include "BLI_endian_switch.h"
+#include "BLI_fileops.h"
+#include "BLI_math_vec_types.hh"
+#include "BLI_math_vector.h"
+#include "BLI_mmap.h"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
+#include "BLI_vector_set.hh"
+
+#include "DEG_depsgraph.h"
+#include "DEG_depsgraph_build.h"
+
+#include "DNA_collection_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_object_types.h"
+#include "DNA_scene_types.h"
+
+#include "importer_mesh_utils.hh"
+#include "stl_importer.hh"
+
+namespace blender::io::stl {
+
+/** 80 byte header followed by the number of triangles. */
+static constexpr size_t BINARY_HEADER_SIZE = 80 + sizeof(uint32_t);
+/** Normal, three corners and a 16 bit attribute. */
+static constexpr size_t BINARY_TRIANGLE_SIZE = sizeof(float[4][3]) + sizeof(uint16_t);
+
+/**
+ * Binary files may start with "solid" as well, so recognize them by their size matching the
+ * triangle count in the header.
+ */
+static bool is_binary_stl(const char *data, const size_t size)
+{
+  if (size < BINARY_HEADER_SIZE) {
+    return false;
+  }
+  uint32_t tris_num;
+  memcpy(&tris_num, data + 80, sizeof(tris_num));
+  if (ENDIAN_ORDER == B_ENDIAN) {
+    BLI_endian_switch_uint32(&tris_num);
+  }
+  return BINARY_HEADER_SIZE + size_t(tris_num) * BINARY_TRIANGLE_SIZE == size;
+}
+
+static Array<float3> read_binary_corners(const char *data, const size_t size)
+{
+  const int64_t tris_num = (size - BINARY_HEADER_SIZE) / BINARY_TRIANGLE_SIZE;
+  Array<float3> corners(tris_num * 3);
+  threading::parallel_for(IndexRange(tris_num), 4096, [&](IndexRange range) {
+    for (const int64_t i : range) {
+      /* Skip the facet normal, normals are calculated from the winding order. */
+      const char *tri = data + BINARY_HEADER_SIZE + i * BINARY_TRIANGLE_SIZE + sizeof(float[3]);
+      memcpy(&corners[i * 3], tri, sizeof(float[3][3]));
+    }
+  });
+  if (ENDIAN_ORDER == B_ENDIAN) {
+    BLI_endian_switch_float_array(reinterpret_cast<float *>(corners.data()),
+                                  int(corners.size() * 3));
+  }
+  return corners;
+}
+
+static Array<float3> read_ascii_corners(const char *data, const size_t size)
+{
+  /* Copy to get a null terminated string for #strtof. */
+  const std::string text(data, size);
+  Vector<float3> corners;
+  size_t pos = 0;
+  while ((pos = text.find("vertex", pos)) != std::string::npos) {
+    const char *str = text.c_str() + pos + strlen("vertex");
+    char *end;
+    float3 co;
+    for (int axis = 0; axis < 3; axis++) {
+      co[axis] = strtof(str, &end);
+      str = end;
+    }
+    corners.append(co);
+    pos = size_t(str - text.c_str());
+  }
+  /* Ignore an incomplete last triangle. */
+  corners.resize(corners.size() - corners.size() % 3);
+  return corners.as_span();
+}
+
+static Mesh *mesh_from_corners(Span<float3> corners, const float global_scale)
+{
+  /* STL stores every corner of every triangle, merge the ones with the same position. */
+  VectorSet<float3> verts;
+  Array<int> corner_verts(corners.size());
+  for (const int64_t i : corners.index_range()) {
+    corner_verts[i] = int(verts.index_of_or_add(corners[i]));
+  }
+
+  /* Merging can make triangles degenerate, which are invalid as polygons. */
+  Vector<int> tris;
+  for (const int64_t i : IndexRange(corners.size() / 3)) {
+    const int v1 = corner_verts[i * 3];
+    const int v2 = corner_verts[i * 3 + 1];
+    const int v3 = corner_verts[i * 3 + 2];
+    if (v1 != v2 && v2 != v3 && v3 != v1) {
+      tris.append(int(i));
+    }
+  }
+
+  Mesh *mesh = BKE_mesh_new_nomain(verts.size(), 0, 0, tris.size() * 3, tris.size());
+  threading::parallel_for(verts.index_range(), 4096, [&](IndexRange range) {
+    for (const int64_t i : range) {
+      mul_v3_v3fl(mesh->mvert[i].co, verts[i], global_scale);
+    }
+  });
+  threading::parallel_for(tris.index_range(), 4096, [&](IndexRange range) {
+    for (const int64_t i : range) {
+      MPoly &poly = mesh->mpoly[i];
+      poly.loopstart = int(i * 3);
+      poly.totloop = 3;
+      for (const int corner : IndexRange(3)) {
+        mesh->mloop[i * 3 + corner].v = corner_verts[tris[i] * 3 + corner];
+      }
+    }
+  });
+  BKE_mesh_calc_edges(mesh, false, false);
+  return mesh;
+}
+
+void importer_main(bContext *C, const STLImportParams &import_params)
+{
+  Main *bmain = CTX_data_main(C);
+  Scene *scene = CTX_data_scene(C);
+  ViewLayer *view_layer = CTX_data_view_layer(C);
+
+  const int file = BLI_open(import_params.filepath, O_BINARY | O_RDONLY, 0);
+  if (file == -1) {
+    fprintf(stderr, "Cannot read from STL file:'%s'\n", import_params.filepath);
+    return;
+  }
+  const size_t size = BLI_file_descriptor_size(file);
+  BLI_mmap_file *mmap_file = BLI_mmap_open(file);
+  close(file);
+  if (mmap_file == nullptr) {
+    fprintf(stderr, "Cannot map STL file:'%s'\n", import_params.filepath);
+    return;
+  }
+  const char *data = static_cast<const char *>(BLI_mmap_get_pointer(mmap_file));
+  const Array<float3> corners = is_binary_stl(data, size) ? read_binary_corners(data, size) :
+                                                            read_ascii_corners(data, size);
+  BLI_mmap_free(mmap_file);
+
+  Mesh *mesh = mesh_from_corners(corners, import_params.global_scale);
+
+  char ob_name[FILE_MAX];
+  BLI_strncpy(ob_name, BLI_path_basename(import_params.filepath), sizeof(ob_name));
+  BLI_path_extension_replace(ob_name, sizeof(ob_name), "");
+
+  Object *obj = BKE_object_add_only_object(bmain, OB_MESH, ob_name);
+  obj->data = BKE_object_obdata_add_from_type(bmain, OB_MESH, ob_name);
+  BKE_mesh_nomain_to_mesh(mesh, static_cast<Mesh *>(obj->data), obj, &CD_MASK_EVERYTHING, true);
+
+  /* Share the axis conversion and size clamping of the OBJ importer. */
+  OBJImportParams obj_params{};
+  obj_params.clamp_size = import_params.clamp_size;
+  obj_params.forward_axis = import_params.forward_axis;
+  obj_params.up_axis = import_params.up_axis;
+  obj::transform_object(obj, obj_params);
+
+  BKE_view_layer_base_deselect_all(view_layer);
+  LayerCollection *lc = BKE_layer_collection_get_active(view_layer);
+  BKE_collection_object_add(bmain, lc->collection, obj);
+  Base *base = BKE_view_layer_base_find(view_layer, obj);
+  BKE_view_layer_base_select_and_set_active(view_layer, base);
+
+  DEG_id_tag_update(&lc->collection->id, ID_RECALC_COPY_ON_WRITE);
+  DEG_id_tag_update_ex(bmain,
+                       &obj->id,
+                       ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY | ID_RECALC_ANIMATION |
+                           ID_RECALC_BASE_FLAGS);
+  DEG_id_tag_update(&scene->id, ID_RECALC_BASE_FLAGS);
+  DEG_relations_tag_update(bmain);
+  static_cast<void>(CTX_data_ensure_evaluated_depsgraph(C));
+}
+
+}  // namespace blender::io::stl
@@ -30,6 +30,7 @@
 #include "BLI_math_rotation.h"
 #include "BLI_path_util.h"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 
 #include "DEG_depsgraph.h"
 #include "DEG_depsgraph_build.h"
@@ -217,6 +218,20 @@ static void import_startjob(void *customdata, short *stop, short *do_update, flo
 
   *data->progress = 0.2f;
 
+  if (data->params.use_parallel_read) {
+    /* USD stages support reading prims from multiple threads, Blender data is still created
+     * serially below. */
+    const std::vector<USDPrimReader *> &readers = archive->readers();
+    blender::threading::parallel_for(
+        blender::IndexRange(readers.size()), 1, [&](const blender::IndexRange range) {
+          for (const int64_t i : range) {
+            if (readers[i] && !G.is_break) {
+              readers[i]->read_geometry(0.0);
+            }
+          }
+        });
+  }
+
   const float size = static_cast<float>(archive->readers().size());
   size_t i = 0;
 
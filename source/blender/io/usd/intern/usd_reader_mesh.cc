@@ -7,6 +7,7 @@
 #include "usd_reader_material.h"
 
 #include "BKE_customdata.h"
+#include "BKE_lib_id.h"
 #include "BKE_main.h"
 #include "BKE_material.h"
 #include "BKE_mesh.h"
@@ -180,6 +181,14 @@ USDMeshReader::USDMeshReader(const pxr::UsdPrim &prim,
 {
 }
 
+USDMeshReader::~USDMeshReader()
+{
+  /* Not moved into the object when the import was canceled. */
+  if (prefetched_mesh_ && !(object_ && object_->data == prefetched_mesh_)) {
+    BKE_id_free(nullptr, prefetched_mesh_);
+  }
+}
+
 void USDMeshReader::create_object(Main *bmain, const double /* motionSampleTime */)
 {
   Mesh *mesh = BKE_mesh_add(bmain, name_.c_str());
@@ -192,11 +201,14 @@ void USDMeshReader::read_object_data(Main *bmain, const double motionSampleTime)
 {
   Mesh *mesh = (Mesh *)object_->data;
 
-  is_initial_load_ = true;
-  Mesh *read_mesh = this->read_mesh(
-      mesh, motionSampleTime, import_params_.mesh_read_flag, nullptr);
+  Mesh *read_mesh = prefetched_mesh_;
+  prefetched_mesh_ = nullptr;
+  if (read_mesh == nullptr) {
+    is_initial_load_ = true;
+    read_mesh = this->read_mesh(mesh, motionSampleTime, import_params_.mesh_read_flag, nullptr);
+    is_initial_load_ = false;
+  }
 
-  is_initial_load_ = false;
   if (read_mesh != mesh) {
     /* FIXME: after 2.80; `mesh->flag` isn't copied by #BKE_mesh_nomain_to_mesh() */
     /* read_mesh can be freed by BKE_mesh_nomain_to_mesh(), so get the flag before that happens. */
@@ -227,6 +239,15 @@ void USDMeshReader::read_object_data(Main *bmain, const double motionSampleTime)
   USDXformReader::read_object_data(bmain, motionSampleTime);
 }
 
+void USDMeshReader::read_geometry(const double motionSampleTime)
+{
+  /* Only reads the prim and writes the (non-#Main) mesh of this reader. */
+  is_initial_load_ = true;
+  prefetched_mesh_ = this->read_mesh(
+      (Mesh *)object_->data, motionSampleTime, import_params_.mesh_read_flag, nullptr);
+  is_initial_load_ = false;
+}
+
 bool USDMeshReader::valid() const
 {
   return static_cast<bool>(mesh_prim_);
@@ -38,15 +38,20 @@ class USDMeshReader : public USDGeomReader {
    * implemented.  Note this will break if faces or positions vary. */
   bool is_initial_load_;
 
+  /** Mesh read by #read_geometry, moved into the object by #read_object_data. */
+  Mesh *prefetched_mesh_ = nullptr;
+
  public:
   USDMeshReader(const pxr::UsdPrim &prim,
                 const USDImportParams &import_params,
                 const ImportSettings &settings);
+  ~USDMeshReader() override;
 
   bool valid() const override;
 
   void create_object(Main *bmain, double motionSampleTime) override;
   void read_object_data(Main *bmain, double motionSampleTime) override;
+  void read_geometry(double motionSampleTime) override;
 
   struct Mesh *read_mesh(struct Mesh *existing_mesh,
                          double motionSampleTime,
@@ -75,6 +75,11 @@ class USDPrimReader {
 
   virtual void create_object(Main *bmain, double motionSampleTime) = 0;
   virtual void read_object_data(Main * /* bmain */, double /* motionSampleTime */){};
+  /**
+   * Read the data of the prim that doesn't need #Main before #read_object_data. Called for all
+   * readers in parallel when the import uses multiple threads.
+   */
+  virtual void read_geometry(double /* motionSampleTime */){};
 
   Object *object() const;
   void object(Object *ob);
@@ -102,6 +102,20 @@ struct USDMeshData {
   pxr::VtFloatArray corner_sharpnesses;
 };
 
+static void get_face_groups(const Mesh *mesh, USDMeshData &usd_mesh_data)
+{
+  /* Only construct face groups (a.k.a. geometry subsets) when we need them for material
+   * assignments. */
+  if (mesh->totcol <= 1) {
+    return;
+  }
+
+  const MPoly *mpoly = mesh->mpoly;
+  for (int i = 0; i < mesh->totpoly; ++i, ++mpoly) {
+    usd_mesh_data.face_groups[mpoly->mat_nr].push_back(i);
+  }
+}
+
 void USDGenericMeshWriter::write_uv_maps(const Mesh *mesh, pxr::UsdGeomMesh usd_mesh)
 {
   pxr::UsdTimeCode timecode = get_export_time_code();
@@ -146,7 +160,6 @@ void USDGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
   write_visibility(context, timecode, usd_mesh);
 
   USDMeshData usd_mesh_data;
-  get_geometry_data(mesh, usd_mesh_data);
 
   if (usd_export_context_.export_params.use_instancing && context.is_instance()) {
     if (!mark_as_instance(context, usd_mesh.GetPrim())) {
@@ -158,12 +171,16 @@ void USDGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
      * out of its own sub-tree. It does work when we override the material with exactly the same
      * path, though. */
     if (usd_export_context_.export_params.export_materials) {
+      /* The instance references the geometry, only the face groups are needed here. */
+      get_face_groups(mesh, usd_mesh_data);
       assign_materials(context, usd_mesh, usd_mesh_data.face_groups);
     }
 
     return;
   }
 
+  get_geometry_data(mesh, usd_mesh_data);
+
   pxr::UsdAttribute attr_points = usd_mesh.CreatePointsAttr(pxr::VtValue(), true);
   pxr::UsdAttribute attr_face_vertex_counts = usd_mesh.CreateFaceVertexCountsAttr(pxr::VtValue(),
                                                                                   true);
@@ -253,10 +270,6 @@ static void get_vertices(const Mesh *mesh, USDMeshData &usd_mesh_data)
 
 static void get_loops_polys(const Mesh *mesh, USDMeshData &usd_mesh_data)
 {
-  /* Only construct face groups (a.k.a. geometry subsets) when we need them for material
-   * assignments. */
-  bool construct_face_groups = mesh->totcol > 1;
-
   usd_mesh_data.face_vertex_counts.reserve(mesh->totpoly);
   usd_mesh_data.face_indices.reserve(mesh->totloop);
 
@@ -268,10 +281,6 @@ static void get_loops_polys(const Mesh *mesh, USDMeshData &usd_mesh_data)
     for (int j = 0; j < mpoly->totloop; ++j, ++loop) {
       usd_mesh_data.face_indices.push_back(loop->v);
     }
-
-    if (construct_face_groups) {
-      usd_mesh_data.face_groups[mpoly->mat_nr].push_back(i);
-    }
   }
 }
 
@@ -322,6 +331,7 @@ void USDGenericMeshWriter::get_geometry_data(const Mesh *mesh, USDMeshData &usd_
 {
   get_vertices(mesh, usd_mesh_data);
   get_loops_polys(mesh, usd_mesh_data);
+  get_face_groups(mesh, usd_mesh_data);
   get_edge_creases(mesh, usd_mesh_data);
   get_vert_creases(mesh, usd_mesh_data);
 }
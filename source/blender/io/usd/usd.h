@@ -57,6 +57,7 @@ struct USDImportParams {
   bool import_usd_preview;
   bool set_material_blend;
   float light_intensity_scale;
+  bool use_parallel_read;
 };
 
 /* The USD_export takes a as_background_job parameter, and returns a boolean.
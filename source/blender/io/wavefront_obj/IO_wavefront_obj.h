@@ -47,6 +47,11 @@ struct OBJExportParams {
   int start_frame;
   /** The last frame to be exported. */
   int end_frame;
+  /**
+   * Number of frames evaluated at the same time, each by its own dependency graph.
+   * Only used when the frames of the scene can be evaluated independently.
+   */
+  int parallel_frames;
 
   /* Geometry Transform options. */
   eTransformAxisForward forward_axis;
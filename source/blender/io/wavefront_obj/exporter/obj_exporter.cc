@@ -10,10 +10,13 @@
 
 #include "BKE_scene.h"
 
+#include "BLI_array.hh"
+#include "BLI_math_base.h"
 #include "BLI_path_util.h"
 #include "BLI_task.hh"
 #include "BLI_vector.hh"
 
+#include "DEG_depsgraph_build.h"
 #include "DEG_depsgraph_query.h"
 
 #include "DNA_scene_types.h"
@@ -301,6 +304,63 @@ bool append_frame_to_filename(const char *filepath, const int frame, char *r_fil
   return BLI_path_extension_replace(r_filepath_with_frames, FILE_MAX, ".obj");
 }
 
+/**
+ * Export the animation in batches of frames, each frame of a batch is evaluated by its own
+ * dependency graph at the same time. The scene frame is left untouched.
+ */
+static void export_frames_parallel(bContext *C, const OBJExportParams &export_params)
+{
+  Main *bmain = CTX_data_main(C);
+  Scene *scene = CTX_data_scene(C);
+  ViewLayer *view_layer = CTX_data_view_layer(C);
+  const int frames_num = export_params.end_frame - export_params.start_frame + 1;
+  if (frames_num <= 0) {
+    return;
+  }
+
+  Array<Depsgraph *> depsgraphs(min_ii(export_params.parallel_frames, frames_num));
+  for (Depsgraph *&depsgraph : depsgraphs) {
+    depsgraph = DEG_graph_new(bmain, scene, view_layer, export_params.export_eval_mode);
+    /* Same content as the depsgraph used for exporting a single frame. */
+    if (export_params.export_eval_mode == DAG_EVAL_RENDER) {
+      DEG_graph_build_for_all_objects(depsgraph);
+    }
+    else {
+      DEG_graph_build_from_view_layer(depsgraph);
+    }
+  }
+
+  Array<float> frames(depsgraphs.size());
+  char filepath_with_frames[FILE_MAX];
+  for (int batch_start = export_params.start_frame; batch_start <= export_params.end_frame;
+       batch_start += depsgraphs.size()) {
+    const int batch_size = min_ii(depsgraphs.size(), export_params.end_frame - batch_start + 1);
+    for (const int i : IndexRange(batch_size)) {
+      frames[i] = float(batch_start + i);
+    }
+    DEG_evaluate_on_framechange_multi(depsgraphs.data(), frames.data(), batch_size);
+
+    bool filepath_ok = true;
+    for (const int i : IndexRange(batch_size)) {
+      filepath_ok = append_frame_to_filename(
+          export_params.filepath, batch_start + i, filepath_with_frames);
+      if (!filepath_ok) {
+        fprintf(stderr, "Error: File Path too long.\n%s\n", filepath_with_frames);
+        break;
+      }
+      fprintf(stderr, "Writing to %s\n", filepath_with_frames);
+      export_frame(depsgraphs[i], export_params, filepath_with_frames);
+    }
+    if (!filepath_ok) {
+      break;
+    }
+  }
+
+  for (Depsgraph *depsgraph : depsgraphs) {
+    DEG_graph_free(depsgraph);
+  }
+}
+
 void exporter_main(bContext *C, const OBJExportParams &export_params)
 {
   ED_object_mode_set(C, OB_MODE_OBJECT);
@@ -315,6 +375,11 @@ void exporter_main(bContext *C, const OBJExportParams &export_params)
     return;
   }
 
+  if (export_params.parallel_frames > 1 && DEG_frames_are_independent(obj_depsgraph.get())) {
+    export_frames_parallel(C, export_params);
+    return;
+  }
+
   char filepath_with_frames[FILE_MAX];
   /* Used to reset the Scene to its original state. */
   const int original_frame = CFRA;
@@ -23,16 +23,9 @@
 
 namespace blender::io::obj {
 
-Object *MeshFromGeometry::create_mesh(
-    Main *bmain,
-    const Map<std::string, std::unique_ptr<MTLMaterial>> &materials,
-    Map<std::string, Material *> &created_materials,
-    const OBJImportParams &import_params)
+void MeshFromGeometry::create_mesh_data()
 {
-  std::string ob_name{mesh_geometry_.geometry_name_};
-  if (ob_name.empty()) {
-    ob_name = "Untitled";
-  }
+  BLI_assert(mesh_ == nullptr);
   fixup_invalid_faces();
 
   const int64_t tot_verts_object{mesh_geometry_.vertex_indices_.size()};
@@ -41,29 +34,49 @@ Object *MeshFromGeometry::create_mesh(
   const int64_t tot_face_elems{mesh_geometry_.face_elements_.size()};
   const int64_t tot_loops{mesh_geometry_.total_loops_};
 
-  Mesh *mesh = BKE_mesh_new_nomain(tot_verts_object, tot_edges, 0, tot_loops, tot_face_elems);
-  Object *obj = BKE_object_add_only_object(bmain, OB_MESH, ob_name.c_str());
-  obj->data = BKE_object_obdata_add_from_type(bmain, OB_MESH, ob_name.c_str());
+  mesh_ = BKE_mesh_new_nomain(tot_verts_object, tot_edges, 0, tot_loops, tot_face_elems);
 
-  create_vertices(mesh);
-  create_polys_loops(obj, mesh);
-  create_edges(mesh);
-  create_uv_verts(mesh);
-  create_normals(mesh);
-  create_materials(bmain, materials, created_materials, obj);
+  create_vertices(mesh_);
+  create_polys_loops(mesh_);
+  create_edges(mesh_);
+  create_uv_verts(mesh_);
+  create_normals(mesh_);
 
   bool verbose_validate = false;
 #ifdef DEBUG
   verbose_validate = true;
 #endif
-  BKE_mesh_validate(mesh, verbose_validate, false);
+  BKE_mesh_validate(mesh_, verbose_validate, false);
+}
+
+Object *MeshFromGeometry::create_mesh(
+    Main *bmain,
+    const Map<std::string, std::unique_ptr<MTLMaterial>> &materials,
+    Map<std::string, Material *> &created_materials,
+    const OBJImportParams &import_params)
+{
+  if (mesh_ == nullptr) {
+    create_mesh_data();
+  }
+
+  std::string ob_name{mesh_geometry_.geometry_name_};
+  if (ob_name.empty()) {
+    ob_name = "Untitled";
+  }
+
+  Object *obj = BKE_object_add_only_object(bmain, OB_MESH, ob_name.c_str());
+  obj->data = BKE_object_obdata_add_from_type(bmain, OB_MESH, ob_name.c_str());
+
+  create_vertex_groups(obj);
+  create_materials(bmain, materials, created_materials, obj);
   transform_object(obj, import_params);
 
   /* FIXME: after 2.80; `mesh->flag` isn't copied by #BKE_mesh_nomain_to_mesh() */
-  const short autosmooth = (mesh->flag & ME_AUTOSMOOTH);
+  const short autosmooth = (mesh_->flag & ME_AUTOSMOOTH);
   Mesh *dst = static_cast<Mesh *>(obj->data);
-  BKE_mesh_nomain_to_mesh(mesh, dst, obj, &CD_MASK_EVERYTHING, true);
+  BKE_mesh_nomain_to_mesh(mesh_, dst, obj, &CD_MASK_EVERYTHING, true);
   dst->flag |= autosmooth;
+  mesh_ = nullptr;
 
   return obj;
 }
@@ -153,7 +166,7 @@ void MeshFromGeometry::create_vertices(Mesh *mesh)
   }
 }
 
-void MeshFromGeometry::create_polys_loops(Object *obj, Mesh *mesh)
+void MeshFromGeometry::create_polys_loops(Mesh *mesh)
 {
   /* Will not be used if vertex groups are not imported. */
   mesh->dvert = nullptr;
@@ -168,9 +181,6 @@ void MeshFromGeometry::create_polys_loops(Object *obj, Mesh *mesh)
     UNUSED_VARS(weight);
   }
 
-  /* Do not remove elements from the VectorSet since order of insertion is required.
-   * StringRef is fine since per-face deform group name outlives the VectorSet. */
-  VectorSet<StringRef> group_names;
   const int64_t tot_face_elems{mesh->totpoly};
   int tot_loop_idx = 0;
 
@@ -212,22 +222,22 @@ void MeshFromGeometry::create_polys_loops(Object *obj, Mesh *mesh)
             MEM_callocN(sizeof(MDeformWeight), "OBJ Import Deform Weight"));
       }
       /* Every vertex in a face is assigned the same deform group. */
-      int64_t pos_name{group_names.index_of_try(curr_face.vertex_group)};
+      int64_t pos_name{vertex_group_names_.index_of_try(curr_face.vertex_group)};
       if (pos_name == -1) {
-        group_names.add_new(curr_face.vertex_group);
-        pos_name = group_names.size() - 1;
+        vertex_group_names_.add_new(curr_face.vertex_group);
+        pos_name = vertex_group_names_.size() - 1;
       }
       BLI_assert(pos_name >= 0);
       /* Deform group number (def_nr) must behave like an index into the names' list. */
       *(def_vert.dw) = {static_cast<unsigned int>(pos_name), weight};
     }
   }
+}
 
-  if (!mesh->dvert) {
-    return;
-  }
+void MeshFromGeometry::create_vertex_groups(Object *obj)
+{
   /* Add deform group(s) to the object's defbase. */
-  for (StringRef name : group_names) {
+  for (StringRef name : vertex_group_names_) {
     /* Adding groups in this order assumes that def_nr is an index into the names' list. */
     BKE_object_defgroup_add_name(obj, name.data());
   }
@@ -9,6 +9,7 @@
 #include "BKE_lib_id.h"
 
 #include "BLI_utility_mixins.hh"
+#include "BLI_vector_set.hh"
 
 #include "obj_import_mtl.hh"
 #include "obj_import_objects.hh"
@@ -24,6 +25,13 @@ class MeshFromGeometry : NonMovable, NonCopyable {
  private:
   Geometry &mesh_geometry_;
   const GlobalVertices &global_vertices_;
+  /** Mesh created by #create_mesh_data, owned until it is moved into the object's mesh. */
+  Mesh *mesh_ = nullptr;
+  /**
+   * Deform group names in order of their index. Do not remove elements since order of insertion
+   * is required. StringRef is fine since per-face deform group name outlives the VectorSet.
+   */
+  VectorSet<StringRef> vertex_group_names_;
 
  public:
   MeshFromGeometry(Geometry &mesh_geometry, const GlobalVertices &global_vertices)
@@ -31,6 +39,18 @@ class MeshFromGeometry : NonMovable, NonCopyable {
   {
   }
 
+  ~MeshFromGeometry()
+  {
+    if (mesh_ != nullptr) {
+      BKE_id_free(nullptr, mesh_);
+    }
+  }
+
+  /**
+   * Build the mesh geometry without touching #Main, so this can run in parallel for different
+   * geometries. Called by #create_mesh when it was not done before.
+   */
+  void create_mesh_data();
   Object *create_mesh(Main *bmain,
                       const Map<std::string, std::unique_ptr<MTLMaterial>> &materials,
                       Map<std::string, Material *> &created_materials,
@@ -51,7 +71,11 @@ class MeshFromGeometry : NonMovable, NonCopyable {
    * It must receive all polygons to be added to the mesh.
    * Remove holes from polygons before * calling this.
    */
-  void create_polys_loops(Object *obj, Mesh *mesh);
+  void create_polys_loops(Mesh *mesh);
+  /**
+   * Add the deform groups referenced by the polygons to the object.
+   */
+  void create_vertex_groups(Object *obj);
   /**
    * Add explicitly imported OBJ edges to the mesh.
    */
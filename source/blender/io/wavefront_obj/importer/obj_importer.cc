@@ -6,10 +6,12 @@
 
 #include <string>
 
+#include "BLI_array.hh"
 #include "BLI_map.hh"
 #include "BLI_math_vec_types.hh"
 #include "BLI_set.hh"
 #include "BLI_string_ref.hh"
+#include "BLI_task.hh"
 
 #include "BKE_layer.h"
 #include "BKE_scene.h"
@@ -42,11 +44,26 @@ static void geometry_to_blender_objects(
   BKE_view_layer_base_deselect_all(view_layer);
   LayerCollection *lc = BKE_layer_collection_get_active(view_layer);
 
-  for (const std::unique_ptr<Geometry> &geometry : all_geometries) {
+  /* Parallel over geometries: build the mesh data, which does not need #Main. */
+  Array<std::unique_ptr<MeshFromGeometry>> mesh_from_geometries(all_geometries.size());
+  threading::parallel_for(all_geometries.index_range(), 1, [&](IndexRange range) {
+    for (const int64_t i : range) {
+      Geometry &geometry = *all_geometries[i];
+      if (geometry.geom_type_ == GEOM_MESH) {
+        mesh_from_geometries[i] = std::make_unique<MeshFromGeometry>(geometry, global_vertices);
+        mesh_from_geometries[i]->create_mesh_data();
+      }
+    }
+  });
+
+  /* Serial: create objects, materials and add them to #Main. */
+  for (const int64_t i : all_geometries.index_range()) {
+    const std::unique_ptr<Geometry> &geometry = all_geometries[i];
     Object *obj = nullptr;
     if (geometry->geom_type_ == GEOM_MESH) {
-      MeshFromGeometry mesh_ob_from_geometry{*geometry, global_vertices};
-      obj = mesh_ob_from_geometry.create_mesh(bmain, materials, created_materials, import_params);
+      obj = mesh_from_geometries[i]->create_mesh(
+          bmain, materials, created_materials, import_params);
+      mesh_from_geometries[i].reset();
     }
     else if (geometry->geom_type_ == GEOM_CURVE) {
       CurveFromGeometry curve_ob_from_geometry(*geometry, global_vertices);
@@ -1,5 +1,8 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -100,20 +103,52 @@ void split_by_char(StringRef in_string, const char delimiter, Vector<StringRef>
   }
 }
 
+/**
+ * Null-terminated copy of a string to parse, kept on the stack for the short strings numbers are
+ * made of, to avoid a heap allocation for every number in the file.
+ */
+class NumberString {
+  char buffer_[64];
+  std::string long_string_;
+  const char *c_str_;
+
+ public:
+  NumberString(StringRef src)
+  {
+    if (src.size() < sizeof(buffer_)) {
+      src.copy(buffer_);
+      c_str_ = buffer_;
+    }
+    else {
+      long_string_ = src;
+      c_str_ = long_string_.c_str();
+    }
+  }
+
+  const char *c_str() const
+  {
+    return c_str_;
+  }
+};
+
 void copy_string_to_float(StringRef src, const float fallback_value, float &r_dst)
 {
-  try {
-    r_dst = std::stof(string(src));
-  }
-  catch (const std::invalid_argument &inv_arg) {
-    std::cerr << "Bad conversion to float:'" << inv_arg.what() << "':'" << src << "'" << std::endl;
+  /* Same checks as `std::stof`, without the string allocation and exceptions. */
+  const NumberString str(src);
+  char *end;
+  errno = 0;
+  const float value = std::strtof(str.c_str(), &end);
+  if (end == str.c_str()) {
+    std::cerr << "Bad conversion to float:'" << src << "'" << std::endl;
     r_dst = fallback_value;
   }
-  catch (const std::out_of_range &out_of_range) {
-    std::cerr << "Out of range for float:'" << out_of_range.what() << ":'" << src << "'"
-              << std::endl;
+  else if (errno == ERANGE) {
+    std::cerr << "Out of range for float:'" << src << "'" << std::endl;
     r_dst = fallback_value;
   }
+  else {
+    r_dst = value;
+  }
 }
 
 void copy_string_to_float(Span<StringRef> src,
@@ -132,18 +167,22 @@ void copy_string_to_float(Span<StringRef> src,
 
 void copy_string_to_int(StringRef src, const int fallback_value, int &r_dst)
 {
-  try {
-    r_dst = std::stoi(string(src));
-  }
-  catch (const std::invalid_argument &inv_arg) {
-    std::cerr << "Bad conversion to int:'" << inv_arg.what() << "':'" << src << "'" << std::endl;
+  /* Same checks as `std::stoi`, without the string allocation and exceptions. */
+  const NumberString str(src);
+  char *end;
+  errno = 0;
+  const long value = std::strtol(str.c_str(), &end, 10);
+  if (end == str.c_str()) {
+    std::cerr << "Bad conversion to int:'" << src << "'" << std::endl;
     r_dst = fallback_value;
   }
-  catch (const std::out_of_range &out_of_range) {
-    std::cerr << "Out of range for int:'" << out_of_range.what() << ":'" << src << "'"
-              << std::endl;
+  else if (errno == ERANGE || value < INT_MIN || value > INT_MAX) {
+    std::cerr << "Out of range for int:'" << src << "'" << std::endl;
     r_dst = fallback_value;
   }
+  else {
+    r_dst = static_cast<int>(value);
+  }
 }
 
 void copy_string_to_int(Span<StringRef> src, const int fallback_value, MutableSpan<int> r_dst)
@@ -81,6 +81,7 @@ struct OBJExportParamsDefault {
     params.export_animation = false;
     params.start_frame = 0;
     params.end_frame = 1;
+    params.parallel_frames = 1;
 
     params.forward_axis = OBJ_AXIS_NEGATIVE_Z_FORWARD;
     params.up_axis = OBJ_AXIS_Y_UP;
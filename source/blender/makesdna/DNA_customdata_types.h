@@ -46,6 +46,12 @@ typedef struct CustomDataLayer {
    * automatically.
    */
   const struct AnonymousAttributeID *anonymous_id;
+  /**
+   * Run-time user count for layers whose data is shared with layers of other #CustomData
+   * (see #CD_SHARE). The data is freed by the last user, and it has to be duplicated before
+   * being modified while there are other users.
+   */
+  struct CustomDataSharingInfo *sharing_info;
 } CustomDataLayer;
 
 #define MAX_CUSTOMDATA_LAYER_NAME 64
@@ -98,6 +98,12 @@ void DNA_reconstruct_info_free(struct DNA_ReconstructInfo *reconstruct_info);
  */
 int DNA_struct_find_nr_ex(const struct SDNA *sdna, const char *str, unsigned int *index_last);
 int DNA_struct_find_nr(const struct SDNA *sdna, const char *str);
+/**
+ * Whether the struct or any struct it contains has pointer members. Only structs without
+ * pointers can be compared bytewise, the pointed to data can change while the pointer stays
+ * the same.
+ */
+bool DNA_struct_has_pointers(const struct SDNA *sdna, int struct_nr);
 /**
  * Does endian swapping on the fields of a struct value.
  *
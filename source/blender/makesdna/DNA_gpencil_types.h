@@ -250,6 +250,13 @@ typedef struct bGPDstroke_Runtime {
   /** Curve Handles offset in the IBO where this handle starts. */
   int curve_start;
 
+  /**
+   * Changed since the draw cache wrote this stroke to its buffers.
+   * See #bGPdata_Runtime.draw_dirty_strokes_only.
+   */
+  char draw_dirty;
+  char _pad3[7];
+
   /** Original stroke (used to dereference evaluated data) */
   struct bGPDstroke *gps_orig;
   void *_pad2;
@@ -626,7 +633,12 @@ typedef struct bGPdata_Runtime {
    */
   /** Flags for stroke that cache represents. */
   short sbuffer_sflag;
-  char _pad1[2];
+  /**
+   * Only strokes tagged with #bGPDstroke_Runtime.draw_dirty changed since the draw cache was
+   * built, set by an update-on-write of the evaluated data.
+   */
+  char draw_dirty_strokes_only;
+  char _pad1[1];
   /** Number of elements currently used in cache. */
   int sbuffer_used;
   /** Number of total elements available in cache. */
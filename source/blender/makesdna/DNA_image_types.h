@@ -244,6 +244,8 @@ enum {
   /* Has any limited scale textures been allocated.
    * Adds additional checks to reuse max resolution images when they fit inside limited scale. */
   IMA_GPU_HAS_LIMITED_SCALE_TEXTURES = (1 << 2),
+  /* The image was updated partially, don't use block compressed textures anymore. */
+  IMA_GPU_NO_COMPRESSION = (1 << 3),
 };
 
 /* Image.source, where the image comes from */
@@ -135,6 +135,15 @@ typedef struct Mesh_Runtime {
    */
   char vert_normals_dirty;
   char poly_normals_dirty;
+
+  /**
+   * Identifies the topology arrays of the mesh, zero when not assigned yet. Meshes copied with
+   * referenced custom data share the version of their source. See
+   * #BKE_mesh_topology_version_ensure.
+   */
+  unsigned int topology_version;
+  char _pad3[4];
+
   float (*vert_normals)[3];
   float (*poly_normals)[3];
 
@@ -2292,7 +2292,11 @@ typedef struct NodesModifierData {
    * This can be used to help the user to debug a node tree.
    */
   void *runtime_eval_log;
-  void *_pad1;
+  /**
+   * Outputs of expensive nodes from previous evaluations that can be reused when their inputs did
+   * not change. Only stored on the original modifier.
+   */
+  void *runtime_node_cache;
 } NodesModifierData;
 
 typedef struct MeshToVolumeModifierData {
@@ -458,10 +458,13 @@ typedef struct bNodeLink {
 #ifdef __cplusplus
 namespace blender::nodes {
 struct FieldInferencingInterface;
-}
+class NodeTreeRef;
+}  // namespace blender::nodes
 using FieldInferencingInterfaceHandle = blender::nodes::FieldInferencingInterface;
+using NodeTreeRefHandle = blender::nodes::NodeTreeRef;
 #else
 typedef struct FieldInferencingInterfaceHandle FieldInferencingInterfaceHandle;
+typedef struct NodeTreeRefHandle NodeTreeRefHandle;
 #endif
 
 /* the basis for a Node tree, all links and nodes reside internal here */
@@ -488,6 +491,11 @@ typedef struct bNodeTree {
   ListBase nodes, links;
   /** Information about how inputs and outputs of the node group interact with fields. */
   FieldInferencingInterfaceHandle *field_inferencing_interface;
+  /**
+   * Shared #NodeTreeRef of an evaluated node tree, created on demand by its users. The evaluated
+   * tree is copied again when the original changes, which frees this as well.
+   */
+  NodeTreeRefHandle *shared_tree_ref;
 
   int type;
 
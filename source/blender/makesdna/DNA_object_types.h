@@ -166,6 +166,14 @@ typedef struct Object_Runtime {
    */
   struct Mesh *mesh_deform_eval;
 
+  /**
+   * GPU batch cache of the previous evaluated mesh. When the mesh was only deformed the draw
+   * manager takes it over for the next evaluated mesh and only updates vertex positions. With
+   * asynchronous mesh extraction it is drawn until the batches of the new mesh are ready.
+   */
+  void *mesh_batch_cache_prev;
+  void *_pad4;
+
   /* Evaluated mesh cage in edit mode. */
   struct Mesh *editmesh_eval_cage;
 
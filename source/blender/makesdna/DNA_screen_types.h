@@ -448,6 +448,10 @@ typedef struct ARegion_Runtime {
 
   /* Maps uiBlock->name to uiBlock for faster lookups. */
   struct GHash *block_name_map;
+
+  /** Number of times the region was drawn, shown with debug value 888. */
+  int redraw_count;
+  char _pad[4];
 } ARegion_Runtime;
 
 typedef struct ARegion {
@@ -767,6 +767,10 @@ enum {
   SEQ_CACHE_PREFETCH_ENABLE = (1 << 10),
   SEQ_CACHE_DISK_CACHE_ENABLE = (1 << 11),
   SEQ_CACHE_STORE_THUMBNAIL = (1 << 12),
+  /* #Editing.cache_flag only: store final images compressed in RAM. */
+  SEQ_CACHE_COMPRESS_FINAL_OUT = (1 << 13),
+  /* #Editing.cache_flag only: free frames by render cost and distance to the playhead. */
+  SEQ_CACHE_RECYCLE_BY_COST = (1 << 14),
 };
 
 /** #Sequence.color_tag. */
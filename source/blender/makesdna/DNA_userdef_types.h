@@ -651,7 +651,32 @@ typedef struct UserDef_Experimental {
   char use_named_attribute_nodes;
   char enable_eevee_next;
   char use_sculpt_texture_paint;
-  char _pad0[1];
+  char use_depsgraph_critical_path;
+  char use_draw_async_mesh_extraction;
+  char use_draw_mesh_lod;
+  char use_draw_occlusion_culling;
+  char use_gpu_texture_compression;
+  char use_render_write_background;
+  char use_imm_batching;
+  char use_sculpt_gpu_filter;
+  char use_subdiv_gpu_final;
+  char use_subdiv_topology_version;
+  char use_compositor_gpu;
+  char use_compositor_partial_exr;
+  char use_compositor_progressive;
+  char use_sequencer_parallel_strips;
+  char use_sequencer_gpu_blend;
+  char use_sequencer_prefetch_threads;
+  char use_render_lazy_passes;
+  char use_native_stl_io;
+  char use_edit_mesh_partial_undo;
+  char use_edit_mesh_pack;
+  char use_customdata_pool;
+  char use_parallel_main_relations;
+  char use_file_preview_cache;
+  char use_gpencil_partial_draw_update;
+  char use_deferred_addon_registration;
+  char _pad0[8];
   /** `makesdna` does not allow empty structs. */
 } UserDef_Experimental;
 
@@ -775,13 +800,23 @@ typedef struct UserDef {
   char keyconfigstr[64];
 
   short undosteps;
-  char _pad1[2];
+  /** Compress global undo steps older than this number of steps (0 to disable). */
+  short undo_compress_steps;
   int undomemory;
   float gpu_viewport_quality DNA_DEPRECATED;
   short gp_manhattandist, gp_euclideandist, gp_eraser;
   /** #eGP_UserdefSettings. */
   short gp_settings;
-  char _pad13[4];
+  /** Memory limit in megabytes of the geometry nodes output cache of each modifier. */
+  int geometry_nodes_cache_limit;
+  /** Memory limit in megabytes of the compositor operation result cache, zero disables it. */
+  int compositor_cache_limit;
+  /** Number of threads decoding each movie, zero to pick automatically. */
+  short movie_decode_threads;
+  /** #eUserpref_MovieDecodeThreadType. */
+  char movie_decode_thread_type;
+  /** #eUserpref_MovieDecodeFlag. */
+  char movie_decode_flag;
   struct SolidLight light_param[4];
   float light_ambient[3];
   char gizmo_flag;
@@ -799,7 +834,8 @@ typedef struct UserDef {
   int prefetchframes;
   /** Control the rotation step of the view when PAD2, PAD4, PAD6&PAD8 is use. */
   float pad_rot_angle;
-  char _pad12[4];
+  /** Memory limit in megabytes of the evaluated geometry frame cache, zero disables it. */
+  int geometry_cache_limit;
   /** Rotating view icon size. */
   short rvisize;
   /** Rotating view icon brightness. */
@@ -1390,6 +1426,18 @@ typedef enum eUserpref_SeqProxySetup {
   USER_SEQ_PROXY_SETUP_AUTOMATIC = 1,
 } eUserpref_SeqProxySetup;
 
+/** #UserDef.movie_decode_thread_type, matches #eIMBDecodeThreadType. */
+typedef enum eUserpref_MovieDecodeThreadType {
+  USER_MOVIE_DECODE_THREADS_AUTO = 0,
+  USER_MOVIE_DECODE_THREADS_FRAME = 1,
+  USER_MOVIE_DECODE_THREADS_SLICE = 2,
+} eUserpref_MovieDecodeThreadType;
+
+/** #UserDef.movie_decode_flag */
+typedef enum eUserpref_MovieDecodeFlag {
+  USER_MOVIE_DECODE_HARDWARE = (1 << 0),
+} eUserpref_MovieDecodeFlag;
+
 /* Locale Ids. Auto will try to get local from OS. Our default is English though. */
 /** #UserDef.language */
 enum {
@@ -289,6 +289,23 @@ int DNA_struct_alias_find_nr(const SDNA *sdna, const char *str)
   return DNA_struct_alias_find_nr_ex(sdna, str, &index_last_dummy);
 }
 
+bool DNA_struct_has_pointers(const SDNA *sdna, const int struct_nr)
+{
+  const SDNA_Struct *dna_struct = sdna->structs[struct_nr];
+  for (int i = 0; i < dna_struct->members_len; i++) {
+    const SDNA_StructMember *member = &dna_struct->members[i];
+    const char *name = sdna->names[member->name];
+    if (ELEM(name[0], '*', '(')) {
+      return true;
+    }
+    const int member_struct_nr = DNA_struct_find_nr(sdna, sdna->types[member->type]);
+    if (member_struct_nr != -1 && DNA_struct_has_pointers(sdna, member_struct_nr)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 /* ************************* END DIV ********************** */
 
 /* ************************* READ DNA ********************** */
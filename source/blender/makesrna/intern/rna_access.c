@@ -4384,8 +4384,33 @@ static int rna_raw_access(ReportList *reports,
         return 1;
       }
 
-      /* Could also be faster with non-matching types,
-       * for now we just do slower loop. */
+      /* Non-matching raw types, convert each value with the same casts the slower loop below
+       * uses, but without looking up every item through RNA. */
+      if (RNA_raw_type_sizeof(in.type) && RNA_raw_type_sizeof(out.type)) {
+        RawArray in_item = in;
+        RawArray out_item = out;
+        const int in_size = RNA_raw_type_sizeof(in.type) * arraylen;
+        int a, j;
+
+        for (a = 0; a < out.len; a++) {
+          for (j = 0; j < arraylen; j++) {
+            double value;
+            if (set) {
+              RAW_GET(double, value, in_item, j);
+              RAW_SET(double, out_item, j, value);
+            }
+            else {
+              RAW_GET(double, value, out_item, j);
+              RAW_SET(double, in_item, j, value);
+            }
+          }
+
+          in_item.array = (char *)in_item.array + in_size;
+          out_item.array = (char *)out_item.array + out.stride;
+        }
+
+        return 1;
+      }
     }
   }
 
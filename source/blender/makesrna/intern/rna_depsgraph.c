@@ -170,6 +170,23 @@ static void rna_DepsgraphObjectInstance_uv_get(PointerRNA *ptr, float *uv)
   }
 }
 
+/* The instance has no DNA struct, its data is the iterator. The struct name only matches the
+ * declaration of the function generated by makesrna. */
+struct DepsgraphObjectInstance;
+
+static bool rna_DepsgraphObjectInstance_instance_attribute_lookup(
+    struct DepsgraphObjectInstance *instance, const char *name, float value[4])
+{
+  BLI_Iterator *iterator = (BLI_Iterator *)instance;
+  DEGObjectIterData *deg_iter = (DEGObjectIterData *)iterator->data;
+  if (deg_iter->dupli_object_current != NULL &&
+      BKE_object_dupli_find_rgba_attribute(deg_iter->dupli_object_current, name, value)) {
+    return true;
+  }
+  zero_v4(value);
+  return false;
+}
+
 /* ******************** Sorted  ***************** */
 
 static int rna_Depsgraph_mode_get(PointerRNA *ptr)
@@ -240,6 +257,16 @@ static void rna_Depsgraph_debug_stats_gnuplot(Depsgraph *depsgraph,
   fclose(f);
 }
 
+static void rna_Depsgraph_debug_trace_chrome(Depsgraph *UNUSED(depsgraph), const char *filename)
+{
+  FILE *f = fopen(filename, "w");
+  if (f == NULL) {
+    return;
+  }
+  DEG_debug_trace_chrome(f);
+  fclose(f);
+}
+
 static void rna_Depsgraph_debug_tag_update(Depsgraph *depsgraph)
 {
   DEG_graph_tag_relations_update(depsgraph);
@@ -491,6 +518,8 @@ static void rna_def_depsgraph_instance(BlenderRNA *brna)
 {
   StructRNA *srna;
   PropertyRNA *prop;
+  FunctionRNA *func;
+  PropertyRNA *parm;
 
   srna = RNA_def_struct(brna, "DepsgraphObjectInstance", NULL);
   RNA_def_struct_ui_text(srna,
@@ -578,6 +607,31 @@ static void rna_def_depsgraph_instance(BlenderRNA *brna)
   RNA_def_property_array(prop, 2);
   RNA_def_property_clear_flag(prop, PROP_ANIMATABLE | PROP_EDITABLE);
   RNA_def_property_float_funcs(prop, "rna_DepsgraphObjectInstance_uv_get", NULL, NULL);
+
+  func = RNA_def_function(srna,
+                          "instance_attribute_lookup",
+                          "rna_DepsgraphObjectInstance_instance_attribute_lookup");
+  RNA_def_function_ui_description(
+      func,
+      "Find an attribute on the instance domain of the geometry this instance was created from, "
+      "as a color");
+  parm = RNA_def_string(func, "name", NULL, 0, "Name", "Name of the attribute");
+  RNA_def_parameter_flags(parm, 0, PARM_REQUIRED);
+  parm = RNA_def_float_vector(func,
+                              "value",
+                              4,
+                              NULL,
+                              -FLT_MAX,
+                              FLT_MAX,
+                              "Value",
+                              "Value of the attribute",
+                              -FLT_MAX,
+                              FLT_MAX);
+  RNA_def_parameter_flags(parm, PROP_THICK_WRAP, 0);
+  RNA_def_function_output(func, parm);
+  parm = RNA_def_boolean(
+      func, "found", false, "Found", "True if an instance level has the attribute");
+  RNA_def_function_return(func, parm);
 }
 
 static void rna_def_depsgraph_update(BlenderRNA *brna)
@@ -653,6 +707,15 @@ static void rna_def_depsgraph(BlenderRNA *brna)
                                   "File name where gnuplot script will save the result");
   RNA_def_parameter_flags(parm, 0, PARM_REQUIRED);
 
+  func = RNA_def_function(srna, "debug_trace_chrome", "rna_Depsgraph_debug_trace_chrome");
+  RNA_def_function_ui_description(
+      func,
+      "Write the evaluation timeline recorded with --debug-depsgraph-trace, "
+      "in the Chrome trace event format");
+  parm = RNA_def_string_file_path(
+      func, "filename", NULL, FILE_MAX, "File Name", "Output path for the JSON trace file");
+  RNA_def_parameter_flags(parm, 0, PARM_REQUIRED);
+
   func = RNA_def_function(srna, "debug_tag_update", "rna_Depsgraph_debug_tag_update");
 
   func = RNA_def_function(srna, "debug_stats", "rna_Depsgraph_debug_stats");
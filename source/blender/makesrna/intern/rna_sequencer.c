@@ -2315,6 +2315,20 @@ static void rna_def_editor(BlenderRNA *brna)
   RNA_def_property_boolean_sdna(prop, NULL, "cache_flag", SEQ_CACHE_STORE_FINAL_OUT);
   RNA_def_property_ui_text(prop, "Cache Final", "Cache final image for each frame");
 
+  prop = RNA_def_property(srna, "use_cache_compression", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "cache_flag", SEQ_CACHE_COMPRESS_FINAL_OUT);
+  RNA_def_property_ui_text(prop,
+                           "Compress Final",
+                           "Store cached final images compressed, to cache more frames in the "
+                           "same memory at the cost of decompressing them during playback");
+
+  prop = RNA_def_property(srna, "use_cache_recycle_by_cost", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "cache_flag", SEQ_CACHE_RECYCLE_BY_COST);
+  RNA_def_property_ui_text(prop,
+                           "Free by Render Cost",
+                           "When the cache is full, free the frames that are fastest to render "
+                           "again relative to their distance from the current frame first");
+
   prop = RNA_def_property(srna, "use_prefetch", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, NULL, "cache_flag", SEQ_CACHE_PREFETCH_ENABLE);
   RNA_def_property_ui_text(
@@ -177,6 +177,8 @@ static const EnumPropertyItem rna_enum_userdef_viewport_aa_items[] = {
 #  include "DEG_depsgraph.h"
 
 #  include "GPU_capabilities.h"
+
+#  include "IMB_imbuf.h"
 #  include "GPU_select.h"
 #  include "GPU_texture.h"
 
@@ -589,6 +591,18 @@ static void rna_Userdef_memcache_update(Main *UNUSED(bmain),
   USERDEF_TAG_DIRTY;
 }
 
+static void rna_Userdef_movie_decode_update(Main *UNUSED(bmain),
+                                            Scene *UNUSED(scene),
+                                            PointerRNA *UNUSED(ptr))
+{
+#  ifdef WITH_FFMPEG
+  IMB_ffmpeg_set_decode_settings(U.movie_decode_threads,
+                                 (eIMBDecodeThreadType)U.movie_decode_thread_type,
+                                 (U.movie_decode_flag & USER_MOVIE_DECODE_HARDWARE) != 0);
+#  endif
+  USERDEF_TAG_DIRTY;
+}
+
 static void rna_Userdef_disk_cache_dir_update(Main *UNUSED(bmain),
                                               Scene *UNUSED(scene),
                                               PointerRNA *UNUSED(ptr))
@@ -5049,6 +5063,14 @@ static void rna_def_userdef_edit(BlenderRNA *brna)
   RNA_def_property_ui_text(
       prop, "Undo Steps", "Number of undo steps available (smaller values conserve memory)");
 
+  prop = RNA_def_property(srna, "undo_compress_steps", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, NULL, "undo_compress_steps");
+  RNA_def_property_range(prop, 0, 256);
+  RNA_def_property_ui_text(prop,
+                           "Compress Undo Steps",
+                           "Compress global and sculpt undo steps older than this number of steps "
+                           "in the background, to reduce memory usage (0 to disable)");
+
   prop = RNA_def_property(srna, "undo_memory_limit", PROP_INT, PROP_NONE);
   RNA_def_property_int_sdna(prop, NULL, "undomemory");
   RNA_def_property_range(prop, 0, max_memory_in_megabytes_int());
@@ -5447,6 +5469,25 @@ static void rna_def_userdef_system(BlenderRNA *brna)
       {0, NULL, 0, NULL, NULL},
   };
 
+  static const EnumPropertyItem movie_decode_thread_type_items[] = {
+      {USER_MOVIE_DECODE_THREADS_AUTO,
+       "AUTO",
+       0,
+       "Automatic",
+       "Decode multiple frames at once when the codec supports it, parts of frames otherwise"},
+      {USER_MOVIE_DECODE_THREADS_FRAME,
+       "FRAME",
+       0,
+       "Frame",
+       "Decode multiple frames at once, faster playback but slower seeking"},
+      {USER_MOVIE_DECODE_THREADS_SLICE,
+       "SLICE",
+       0,
+       "Slice",
+       "Decode parts of a frame at once, when the codec supports it"},
+      {0, NULL, 0, NULL, NULL},
+  };
+
   srna = RNA_def_struct(brna, "PreferencesSystem", NULL);
   RNA_def_struct_sdna(srna, "UserDef");
   RNA_def_struct_nested(brna, srna, "Preferences");
@@ -5489,6 +5530,36 @@ static void rna_def_userdef_system(BlenderRNA *brna)
   RNA_def_property_ui_text(prop, "Memory Cache Limit", "Memory cache limit (in megabytes)");
   RNA_def_property_update(prop, 0, "rna_Userdef_memcache_update");
 
+  prop = RNA_def_property(srna, "geometry_cache_limit", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, NULL, "geometry_cache_limit");
+  RNA_def_property_range(prop, 0, max_memory_in_megabytes_int());
+  RNA_def_property_ui_text(prop,
+                           "Geometry Cache Limit",
+                           "Memory limit for caching the evaluated geometry of objects per frame, "
+                           "to speed up playing back the same frames again (in megabytes, zero "
+                           "disables the cache)");
+  RNA_def_property_update(prop, 0, "rna_userdef_update");
+
+  prop = RNA_def_property(srna, "geometry_nodes_cache_limit", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, NULL, "geometry_nodes_cache_limit");
+  RNA_def_property_range(prop, 0, max_memory_in_megabytes_int());
+  RNA_def_property_ui_text(prop,
+                           "Geometry Nodes Cache Limit",
+                           "Memory limit of each Geometry Nodes modifier for keeping the results "
+                           "of expensive nodes, which are reused when their inputs did not change "
+                           "(in megabytes, zero disables the cache)");
+  RNA_def_property_update(prop, 0, "rna_userdef_update");
+
+  prop = RNA_def_property(srna, "compositor_cache_limit", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, NULL, "compositor_cache_limit");
+  RNA_def_property_range(prop, 0, max_memory_in_megabytes_int());
+  RNA_def_property_ui_text(prop,
+                           "Compositor Cache Limit",
+                           "Memory limit for keeping the results of compositor operations, which "
+                           "are reused when the nodes they are computed from did not change "
+                           "(in megabytes, zero disables the cache)");
+  RNA_def_property_update(prop, 0, "rna_userdef_update");
+
   /* Sequencer disk cache */
 
   prop = RNA_def_property(srna, "use_sequencer_disk_cache", PROP_BOOLEAN, PROP_NONE);
@@ -5521,6 +5592,31 @@ static void rna_def_userdef_system(BlenderRNA *brna)
   RNA_def_property_enum_sdna(prop, NULL, "sequencer_proxy_setup");
   RNA_def_property_ui_text(prop, "Proxy Setup", "When and how proxies are created");
 
+  /* Movie decoding */
+
+  prop = RNA_def_property(srna, "movie_decode_threads", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, NULL, "movie_decode_threads");
+  RNA_def_property_range(prop, 0, 1024);
+  RNA_def_property_ui_text(prop,
+                           "Decoding Threads",
+                           "Number of threads decoding each movie, zero to pick automatically. "
+                           "Used by movies opened afterwards");
+  RNA_def_property_update(prop, 0, "rna_Userdef_movie_decode_update");
+
+  prop = RNA_def_property(srna, "movie_decode_thread_type", PROP_ENUM, PROP_NONE);
+  RNA_def_property_enum_items(prop, movie_decode_thread_type_items);
+  RNA_def_property_enum_sdna(prop, NULL, "movie_decode_thread_type");
+  RNA_def_property_ui_text(prop, "Threading", "How movie decoding is split between threads");
+  RNA_def_property_update(prop, 0, "rna_Userdef_movie_decode_update");
+
+  prop = RNA_def_property(srna, "use_movie_hardware_decoding", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "movie_decode_flag", USER_MOVIE_DECODE_HARDWARE);
+  RNA_def_property_ui_text(prop,
+                           "Hardware Decoding",
+                           "Decode movies with the GPU or a dedicated device when available, "
+                           "falling back to the CPU. Used by movies opened afterwards");
+  RNA_def_property_update(prop, 0, "rna_Userdef_movie_decode_update");
+
   prop = RNA_def_property(srna, "scrollback", PROP_INT, PROP_UNSIGNED);
   RNA_def_property_int_sdna(prop, NULL, "scrollback");
   RNA_def_property_range(prop, 32, 32768);
@@ -6404,6 +6500,188 @@ static void rna_def_userdef_experimental(BlenderRNA *brna)
   RNA_def_property_ui_text(
       prop, "Sculpt Mode Tilt Support", "Support for pen tablet tilt events in Sculpt Mode");
 
+  prop = RNA_def_property(srna, "use_depsgraph_critical_path", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_depsgraph_critical_path", 1);
+  RNA_def_property_ui_text(prop,
+                           "Critical Path Scheduling",
+                           "Evaluate the dependency graph operations on the longest chains first, "
+                           "based on timings of previous evaluations");
+
+  prop = RNA_def_property(srna, "use_draw_async_mesh_extraction", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_draw_async_mesh_extraction", 1);
+  RNA_def_property_ui_text(prop,
+                           "Asynchronous Mesh Extraction",
+                           "Keep drawing the previous batches of large meshes while their new "
+                           "GPU buffers are extracted in the background");
+
+  prop = RNA_def_property(srna, "use_draw_mesh_lod", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_draw_mesh_lod", 1);
+  RNA_def_property_ui_text(prop,
+                           "Mesh Level of Detail",
+                           "Draw dense meshes that are small on screen with a simplified surface "
+                           "in Solid shading");
+
+  prop = RNA_def_property(srna, "use_draw_occlusion_culling", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_draw_occlusion_culling", 1);
+  RNA_def_property_ui_text(prop,
+                           "Occlusion Culling",
+                           "Skip drawing objects hidden behind other objects in the previous "
+                           "redraw of the viewport in Solid shading");
+
+  prop = RNA_def_property(srna, "use_gpu_texture_compression", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_gpu_texture_compression", 1);
+  RNA_def_property_ui_text(prop,
+                           "Texture Compression",
+                           "Compress 8 bit image textures with power of two sizes when they are "
+                           "loaded, using up to 8 times less GPU memory at a lower quality");
+  RNA_def_property_update(prop, 0, "rna_userdef_gl_texture_limit_update");
+
+  prop = RNA_def_property(srna, "use_render_write_background", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_render_write_background", 1);
+  RNA_def_property_ui_text(prop,
+                           "Background Animation Saving",
+                           "Save the images or movie frames of an animation render while the "
+                           "next frames render. The render_write handlers run once the frame is "
+                           "saved, after later frames rendered");
+
+  prop = RNA_def_property(srna, "use_imm_batching", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_imm_batching", 1);
+  RNA_def_property_ui_text(prop,
+                           "Batched Immediate Drawing",
+                           "Merge consecutive immediate mode draws of the editors that use the "
+                           "same shader and state into a single draw call");
+
+  prop = RNA_def_property(srna, "use_sculpt_gpu_filter", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_sculpt_gpu_filter", 1);
+  RNA_def_property_ui_text(prop,
+                           "GPU Mesh Filter Smoothing",
+                           "Run the smooth mesh filter of Sculpt Mode in a compute shader, on "
+                           "meshes without deform modifiers or shape keys");
+
+  prop = RNA_def_property(srna, "use_subdiv_gpu_final", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_subdiv_gpu_final", 1);
+  RNA_def_property_ui_text(prop,
+                           "GPU Subdivision Mesh Evaluation",
+                           "Evaluate the vertex positions of subdivided meshes with OpenSubdiv's "
+                           "GPU evaluator when a GPU context is available, for example when "
+                           "applying the modifier. Not used with multires displacement");
+
+  prop = RNA_def_property(srna, "use_subdiv_topology_version", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_subdiv_topology_version", 1);
+  RNA_def_property_ui_text(prop,
+                           "Subdivision Topology Version",
+                           "Reuse the subdivision topology of the previous evaluation without "
+                           "comparing it against the mesh, when the mesh still references the "
+                           "same topology arrays");
+
+  prop = RNA_def_property(srna, "use_compositor_gpu", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_compositor_gpu", 1);
+  RNA_def_property_ui_text(prop,
+                           "GPU Compositor Operations",
+                           "Render the compositor operations that have a compute shader on the "
+                           "GPU with the Full Frame execution model, keeping intermediate results "
+                           "on the GPU. Currently only Mix, Add, Subtract and Multiply mix nodes");
+
+  prop = RNA_def_property(srna, "use_compositor_partial_exr", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_compositor_partial_exr", 1);
+  RNA_def_property_ui_text(prop,
+                           "Compositor Partial EXR Reads",
+                           "Read only the rows of single layer OpenEXR images used by the "
+                           "compositor with the Full Frame execution model, instead of loading "
+                           "the whole image");
+
+  prop = RNA_def_property(srna, "use_compositor_progressive", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_compositor_progressive", 1);
+  RNA_def_property_ui_text(prop,
+                           "Progressive Compositor Preview",
+                           "Show a quarter resolution result of the compositor with the Full "
+                           "Frame execution model first, before compositing in full resolution");
+
+  prop = RNA_def_property(srna, "use_sequencer_parallel_strips", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_sequencer_parallel_strips", 1);
+  RNA_def_property_ui_text(prop,
+                           "Parallel Sequencer Strips",
+                           "Read and preprocess the image and movie strips stacked in a frame "
+                           "at the same time, before blending them in order");
+
+  prop = RNA_def_property(srna, "use_sequencer_gpu_blend", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_sequencer_gpu_blend", 1);
+  RNA_def_property_ui_text(prop,
+                           "GPU Sequencer Blending",
+                           "Blend float images of stacked strips with a GPU compute shader when "
+                           "rendering the sequencer preview");
+
+  prop = RNA_def_property(srna, "use_sequencer_prefetch_threads", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_sequencer_prefetch_threads", 1);
+  RNA_def_property_ui_text(prop,
+                           "Multi-Threaded Sequencer Prefetch",
+                           "Prefetch several frames at the same time when the strips allow it: "
+                           "image, color, meta and most effect strips without animation");
+
+  prop = RNA_def_property(srna, "use_render_lazy_passes", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_render_lazy_passes", 1);
+  RNA_def_property_ui_text(prop,
+                           "Lazy Render Passes",
+                           "Only allocate render passes of add-on render engines once they are "
+                           "written, saving memory for passes an engine leaves empty");
+
+  prop = RNA_def_property(srna, "use_native_stl_io", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_native_stl_io", 1);
+  RNA_def_property_ui_text(prop,
+                           "Native STL Import/Export",
+                           "Show the built-in STL importer and exporter in the File menu");
+
+  prop = RNA_def_property(srna, "use_edit_mesh_partial_undo", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_edit_mesh_partial_undo", 1);
+  RNA_def_property_ui_text(prop,
+                           "Partial Edit Mesh Undo",
+                           "Only store the vertex positions in edit-mode undo steps after "
+                           "transforming, copying everything else from the previous step");
+
+  prop = RNA_def_property(srna, "use_edit_mesh_pack", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_edit_mesh_pack", 1);
+  RNA_def_property_ui_text(prop,
+                           "Pack Edit Mesh Elements",
+                           "Order mesh elements by topology when entering edit mode, for faster "
+                           "editing of large meshes. Changes the vertex, edge and face indices");
+
+  prop = RNA_def_property(srna, "use_customdata_pool", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_customdata_pool", 1);
+  RNA_def_property_ui_text(prop,
+                           "Recycle Mesh Data Arrays",
+                           "Keep large freed mesh data arrays for reuse, reducing allocation "
+                           "overhead when playing back animated meshes. Uses up to 256 MB");
+
+  prop = RNA_def_property(srna, "use_parallel_main_relations", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_parallel_main_relations", 1);
+  RNA_def_property_ui_text(prop,
+                           "Parallel Data-Block Relations",
+                           "Gather the relations between data-blocks from multiple threads, "
+                           "speeding up library override resync when opening large files");
+
+  prop = RNA_def_property(srna, "use_file_preview_cache", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_file_preview_cache", 1);
+  RNA_def_property_ui_text(prop,
+                           "Keep File Browser Previews",
+                           "Keep the previews of recently browsed files in memory, so they show "
+                           "instantly when browsing the same directories again. "
+                           "Uses up to 128 MB");
+
+  prop = RNA_def_property(srna, "use_gpencil_partial_draw_update", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_gpencil_partial_draw_update", 1);
+  RNA_def_property_ui_text(prop,
+                           "Partial Grease Pencil Draw Updates",
+                           "Only upload the changed strokes to the GPU when sculpting or editing "
+                           "grease pencil strokes, instead of the strokes of the whole object");
+
+  prop = RNA_def_property(srna, "use_deferred_addon_registration", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_deferred_addon_registration", 1);
+  RNA_def_property_ui_text(prop,
+                           "Deferred Add-on Registration",
+                           "Register enabled add-ons after the first window redraw, so the "
+                           "interface shows sooner on startup. Add-ons miss the load handlers of "
+                           "the startup file and are not available to startup scripts");
+
   prop = RNA_def_property(srna, "use_sculpt_texture_paint", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, NULL, "use_sculpt_texture_paint", 1);
   RNA_def_property_ui_text(prop, "Sculpt Texture Paint", "Use texture painting in Sculpt Mode");
@@ -17,6 +17,13 @@ extern "C" {
  */
 void MOD_nodes_update_interface(struct Object *object, struct NodesModifierData *nmd);
 
+/**
+ * Write the execution time and allocated memory of every node in the latest evaluation of the
+ * modifier to a JSON file.
+ * \return False when the modifier has not been evaluated yet or the file can't be written.
+ */
+bool MOD_nodes_write_profile(const struct NodesModifierData *nmd, const char *filepath);
+
 #ifdef __cplusplus
 }
 #endif
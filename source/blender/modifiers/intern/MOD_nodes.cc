@@ -12,6 +12,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_array.hh"
+#include "BLI_fileops.hh"
 #include "BLI_listbase.h"
 #include "BLI_math_vec_types.hh"
 #include "BLI_multi_value_map.hh"
@@ -32,6 +33,7 @@
 #include "DNA_scene_types.h"
 #include "DNA_screen_types.h"
 #include "DNA_space_types.h"
+#include "DNA_userdef_types.h"
 #include "DNA_windowmanager_types.h"
 
 #include "BKE_attribute_math.hh"
@@ -71,6 +73,7 @@
 
 #include "MOD_modifiertypes.h"
 #include "MOD_nodes.h"
+#include "MOD_nodes_cache.hh"
 #include "MOD_nodes_evaluator.hh"
 #include "MOD_ui_common.h"
 
@@ -112,6 +115,7 @@ using blender::fn::Field;
 using blender::fn::GField;
 using blender::fn::ValueOrField;
 using blender::fn::ValueOrFieldCPPType;
+using blender::modifiers::geometry_nodes::NodeOutputCache;
 using blender::nodes::FieldInferencingInterface;
 using blender::nodes::GeoNodeExecParams;
 using blender::nodes::InputSocketFieldType;
@@ -127,6 +131,8 @@ static void initData(ModifierData *md)
   BLI_assert(MEMCMP_STRUCT_AFTER_IS_ZERO(nmd, modifier));
 
   MEMCPY_STRUCT_AFTER(nmd, DNA_struct_default_get(NodesModifierData), modifier);
+
+  nmd->runtime_node_cache = new NodeOutputCache();
 }
 
 static void add_used_ids_from_sockets(const ListBase &sockets, Set<ID *> &ids)
@@ -731,6 +737,21 @@ void MOD_nodes_update_interface(Object *object, NodesModifierData *nmd)
   DEG_id_tag_update(&object->id, ID_RECALC_GEOMETRY);
 }
 
+bool MOD_nodes_write_profile(const NodesModifierData *nmd, const char *filepath)
+{
+  const geo_log::ModifierLog *log = static_cast<const geo_log::ModifierLog *>(
+      nmd->runtime_eval_log);
+  if (log == nullptr) {
+    return false;
+  }
+  blender::fstream stream(filepath, std::ios::out | std::ios::trunc);
+  if (!stream.is_open()) {
+    return false;
+  }
+  log->write_profile_json(stream);
+  return stream.good();
+}
+
 static void initialize_group_input(NodesModifierData &nmd,
                                    const OutputSocketRef &socket,
                                    void *r_value)
@@ -894,6 +915,34 @@ static void clear_runtime_data(NodesModifierData *nmd)
   }
 }
 
+static void free_node_cache(NodesModifierData *nmd)
+{
+  if (nmd->runtime_node_cache != nullptr) {
+    delete static_cast<NodeOutputCache *>(nmd->runtime_node_cache);
+    nmd->runtime_node_cache = nullptr;
+  }
+}
+
+/**
+ * The node output cache is stored on the original modifier, so that it is kept when the evaluated
+ * modifier is copied again. It is created and freed together with the original modifier, because
+ * multiple depsgraphs can evaluate the same modifier at the same time.
+ */
+static NodeOutputCache *get_node_cache(NodesModifierData *nmd, const ModifierEvalContext *ctx)
+{
+  NodesModifierData *nmd_orig = (NodesModifierData *)BKE_modifier_get_original(ctx->object,
+                                                                               &nmd->modifier);
+  NodeOutputCache *cache = static_cast<NodeOutputCache *>(nmd_orig->runtime_node_cache);
+  if (cache == nullptr) {
+    return nullptr;
+  }
+  if (U.geometry_nodes_cache_limit <= 0) {
+    cache->clear();
+    return nullptr;
+  }
+  return cache;
+}
+
 struct OutputAttributeInfo {
   GField field;
   StringRefNull name;
@@ -1110,6 +1159,8 @@ static GeometrySet compute_geometry(const DerivedNodeTree &tree,
   eval_params.depsgraph = ctx->depsgraph;
   eval_params.self_object = ctx->object;
   eval_params.geo_logger = geo_logger.has_value() ? &*geo_logger : nullptr;
+  eval_params.node_cache = get_node_cache(nmd, ctx);
+  eval_params.node_cache_memory_limit = int64_t(U.geometry_nodes_cache_limit) * 1024 * 1024;
   blender::modifiers::geometry_nodes::evaluate_geometry_nodes(eval_params);
 
   GeometrySet output_geometry_set = std::move(*eval_params.r_output_values[0].get<GeometrySet>());
@@ -1188,8 +1239,7 @@ static void modifyGeometry(ModifierData *md,
 
   check_property_socket_sync(ctx->object, md);
 
-  NodeTreeRefMap tree_refs;
-  DerivedNodeTree tree{*nmd->node_group, tree_refs};
+  DerivedNodeTree tree{*nmd->node_group};
 
   if (tree.has_link_cycles()) {
     BKE_modifier_set_error(ctx->object, md, "Node group has cycles");
@@ -1646,6 +1696,7 @@ static void blendRead(BlendDataReader *reader, ModifierData *md)
   BLO_read_data_address(reader, &nmd->settings.properties);
   IDP_BlendDataRead(reader, &nmd->settings.properties);
   nmd->runtime_eval_log = nullptr;
+  nmd->runtime_node_cache = new NodeOutputCache();
 }
 
 static void copyData(const ModifierData *md, ModifierData *target, const int flag)
@@ -1656,6 +1707,8 @@ static void copyData(const ModifierData *md, ModifierData *target, const int fla
   BKE_modifier_copydata_generic(md, target, flag);
 
   tnmd->runtime_eval_log = nullptr;
+  /* Only original modifiers have a cache, evaluated copies use the one of the original. */
+  tnmd->runtime_node_cache = (flag & LIB_ID_CREATE_NO_MAIN) ? nullptr : new NodeOutputCache();
 
   if (nmd->settings.properties != nullptr) {
     tnmd->settings.properties = IDP_CopyProperty_ex(nmd->settings.properties, flag);
@@ -1671,6 +1724,7 @@ static void freeData(ModifierData *md)
   }
 
   clear_runtime_data(nmd);
+  free_node_cache(nmd);
 }
 
 static void requiredDataMask(Object *UNUSED(ob),
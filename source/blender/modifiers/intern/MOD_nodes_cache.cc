@@ -0,0 +1,573 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <cstring>
+
+#include "MEM_guardedalloc.h"
+
+#include "DNA_curves_types.h"
+#include "DNA_genfile.h"
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_node_types.h"
+#include "DNA_pointcloud_types.h"
+#include "DNA_sdna_types.h"
+
+#include "BKE_anonymous_attribute.h"
+#include "BKE_customdata.h"
+#include "BKE_geometry_set.hh"
+#include "BKE_node.h"
+
+#include "FN_field_cpp_type.hh"
+
+#include "MOD_nodes_cache.hh"
+
+namespace blender::modifiers::geometry_nodes {
+
+/* -------------------------------------------------------------------- */
+/** \name Geometry Data Hashing
+ *
+ * Geometry that is not owned by the evaluation can be freed or changed after the evaluation, so
+ * it is compared with a hash of its data. That has to be fast, because it runs over all the data
+ * every time the node is evaluated.
+ * \{ */
+
+class DataHasher {
+ private:
+  uint64_t hash_ = 0x27d4eb2f165667c5;
+
+ public:
+  void add(const uint64_t value)
+  {
+    /* Same as a round of xxHash64. */
+    hash_ += value * 0xc2b2ae3d27d4eb4f;
+    hash_ = (hash_ << 31) | (hash_ >> 33);
+    hash_ *= 0x9e3779b185ebca87;
+  }
+
+  void add_bytes(const void *data, const int64_t size)
+  {
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    int64_t offset = 0;
+    for (; offset + 8 <= size; offset += 8) {
+      uint64_t word;
+      memcpy(&word, bytes + offset, 8);
+      this->add(word);
+    }
+    uint64_t tail = 0;
+    memcpy(&tail, bytes + offset, size_t(size - offset));
+    this->add(tail);
+    this->add(uint64_t(size));
+  }
+
+  void add_string(const char *str)
+  {
+    this->add_bytes(str, int64_t(strlen(str)));
+  }
+
+  void add_id(const ID *id)
+  {
+    this->add(uint64_t(uintptr_t(id)));
+    this->add(id ? id->session_uuid : 0);
+  }
+
+  uint64_t get() const
+  {
+    /* Avalanche of xxHash64. */
+    uint64_t hash = hash_;
+    hash ^= hash >> 33;
+    hash *= 0xc2b2ae3d27d4eb4f;
+    hash ^= hash >> 29;
+    hash *= 0x165667b19e3779f9;
+    hash ^= hash >> 32;
+    return hash;
+  }
+};
+
+static bool hash_custom_data(DataHasher &hasher, const CustomData &data, const int size)
+{
+  hasher.add(uint64_t(size));
+  hasher.add(uint64_t(data.totlayer));
+  for (const CustomDataLayer &layer : Span(data.layers, data.totlayer)) {
+    hasher.add(uint64_t(layer.type));
+    if (layer.anonymous_id != nullptr) {
+      /* Unique during the session, unlike the address of the id. */
+      hasher.add_string(BKE_anonymous_attribute_id_internal_name(layer.anonymous_id));
+    }
+    else {
+      hasher.add_string(layer.name);
+    }
+    if (layer.data == nullptr) {
+      hasher.add(0);
+      continue;
+    }
+    if (layer.type == CD_MDEFORMVERT) {
+      for (const MDeformVert &dvert : Span(static_cast<const MDeformVert *>(layer.data), size)) {
+        hasher.add_bytes(dvert.dw, int64_t(sizeof(MDeformWeight)) * dvert.totweight);
+      }
+      continue;
+    }
+    if (CustomData_layertype_is_dynamic(layer.type)) {
+      /* The layer references other data that would have to be hashed as well. */
+      return false;
+    }
+    hasher.add_bytes(layer.data, int64_t(CustomData_sizeof(layer.type)) * size);
+  }
+  return true;
+}
+
+static void hash_materials(DataHasher &hasher, Material *const *materials, const int materials_num)
+{
+  hasher.add(uint64_t(materials_num));
+  for (const int i : IndexRange(materials_num)) {
+    hasher.add_id(reinterpret_cast<const ID *>(materials[i]));
+  }
+}
+
+static bool hash_component_data(const GeometryComponent &component, uint64_t &r_hash)
+{
+  DataHasher hasher;
+  switch (component.type()) {
+    case GEO_COMPONENT_TYPE_MESH: {
+      const Mesh *mesh = static_cast<const MeshComponent &>(component).get_for_read();
+      if (mesh == nullptr) {
+        break;
+      }
+      hasher.add(uint64_t(mesh->flag));
+      hasher.add_bytes(&mesh->smoothresh, sizeof(mesh->smoothresh));
+      if (!hash_custom_data(hasher, mesh->vdata, mesh->totvert) ||
+          !hash_custom_data(hasher, mesh->edata, mesh->totedge) ||
+          !hash_custom_data(hasher, mesh->ldata, mesh->totloop) ||
+          !hash_custom_data(hasher, mesh->pdata, mesh->totpoly)) {
+        return false;
+      }
+      hash_materials(hasher, mesh->mat, mesh->totcol);
+      break;
+    }
+    case GEO_COMPONENT_TYPE_POINT_CLOUD: {
+      const PointCloud *pointcloud =
+          static_cast<const PointCloudComponent &>(component).get_for_read();
+      if (pointcloud == nullptr) {
+        break;
+      }
+      if (!hash_custom_data(hasher, pointcloud->pdata, pointcloud->totpoint)) {
+        return false;
+      }
+      hash_materials(hasher, pointcloud->mat, pointcloud->totcol);
+      break;
+    }
+    case GEO_COMPONENT_TYPE_CURVE: {
+      const Curves *curves = static_cast<const CurveComponent &>(component).get_for_read();
+      if (curves == nullptr) {
+        break;
+      }
+      const CurvesGeometry &geometry = curves->geometry;
+      if (!hash_custom_data(hasher, geometry.point_data, geometry.point_size) ||
+          !hash_custom_data(hasher, geometry.curve_data, geometry.curve_size)) {
+        return false;
+      }
+      if (geometry.curve_offsets != nullptr) {
+        hasher.add_bytes(geometry.curve_offsets, int64_t(sizeof(int)) * (geometry.curve_size + 1));
+      }
+      hash_materials(hasher, curves->mat, curves->totcol);
+      break;
+    }
+    default:
+      /* Instances and volumes are only compared by version. */
+      return false;
+  }
+  r_hash = hasher.get();
+  return true;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Cache Key
+ * \{ */
+
+enum class KeyTag : uint64_t {
+  Node = 1,
+  Value,
+  Geometry,
+  FieldInput,
+  FieldConstant,
+  FieldOperation,
+  FieldOperationOfNode,
+};
+
+/** Comparing keys of very large field trees is not worth it. */
+static constexpr int64_t max_key_words = 4096;
+
+/**
+ * Instances of objects and collections stay the same when the instanced data changes, so
+ * geometry referencing them can't be cached.
+ */
+static bool geometry_references_ids(const GeometrySet &geometry)
+{
+  const InstancesComponent *instances = geometry.get_component_for_read<InstancesComponent>();
+  if (instances == nullptr) {
+    return false;
+  }
+  for (const InstanceReference &reference : instances->references()) {
+    switch (reference.type()) {
+      case InstanceReference::Type::Object:
+      case InstanceReference::Type::Collection:
+        return true;
+      case InstanceReference::Type::GeometrySet:
+        if (geometry_references_ids(reference.geometry_set())) {
+          return true;
+        }
+        break;
+      case InstanceReference::Type::None:
+        break;
+    }
+  }
+  return false;
+}
+
+bool NodeOutputCacheKey::add_node(const bNode &bnode)
+{
+  words_.append(uint64_t(KeyTag::Node));
+  words_.append(uint64_t(uintptr_t(bnode.typeinfo)));
+  /* The name and label are used for the names of anonymous attributes created by the node. */
+  this->add_string(bnode.name);
+  this->add_string(bnode.label);
+  words_.append(uint64_t(uint16_t(bnode.custom1)));
+  words_.append(uint64_t(uint16_t(bnode.custom2)));
+  this->add_bytes(&bnode.custom3, sizeof(bnode.custom3));
+  this->add_bytes(&bnode.custom4, sizeof(bnode.custom4));
+  words_.append(uint64_t(uintptr_t(bnode.id)));
+  words_.append(bnode.id ? bnode.id->session_uuid : 0);
+  if (bnode.storage == nullptr) {
+    return true;
+  }
+  const SDNA *sdna = DNA_sdna_current_get();
+  const int struct_nr = DNA_struct_find_nr(sdna, bnode.typeinfo->storagename);
+  if (struct_nr == -1 || DNA_struct_has_pointers(sdna, struct_nr)) {
+    return false;
+  }
+  this->add_bytes(bnode.storage, sdna->types_size[sdna->structs[struct_nr]->type]);
+  return true;
+}
+
+bool NodeOutputCacheKey::add_input(const InputSocketRef &socket,
+                                   const void *value,
+                                   const OwnedMultiFunctionNodes &owned_fn_nodes)
+{
+  const bNodeSocketType &socket_type = *socket.typeinfo();
+  const CPPType &base_type = *socket_type.base_cpp_type;
+  if (socket_type.geometry_nodes_cpp_type == &base_type) {
+    if (base_type.is<GeometrySet>()) {
+      return this->add_geometry(*static_cast<const GeometrySet *>(value));
+    }
+    return this->add_value({base_type, value});
+  }
+  const fn::ValueOrFieldCPPType &value_or_field_type =
+      *static_cast<const fn::ValueOrFieldCPPType *>(socket_type.geometry_nodes_cpp_type);
+  if (value_or_field_type.is_field(value)) {
+    const fn::GField &field = *value_or_field_type.get_field_ptr(value);
+    fields_.append(field);
+    return this->add_field(field, owned_fn_nodes);
+  }
+  return this->add_value({base_type, value_or_field_type.get_value_ptr(value)});
+}
+
+void NodeOutputCacheKey::add_number(const uint64_t number)
+{
+  words_.append(number);
+}
+
+bool NodeOutputCacheKey::add_value(const GPointer value)
+{
+  const CPPType &type = *value.type();
+  words_.append(uint64_t(KeyTag::Value));
+  words_.append(uint64_t(uintptr_t(&type)));
+  if (type.is<std::string>()) {
+    this->add_string(*value.get<std::string>());
+    return true;
+  }
+  if (type.is<Object *>() || type.is<Collection *>() || type.is<Tex *>() || type.is<Image *>() ||
+      type.is<Material *>()) {
+    const ID *id = *static_cast<const ID *const *>(value.get());
+    words_.append(uint64_t(uintptr_t(id)));
+    words_.append(id ? id->session_uuid : 0);
+    return true;
+  }
+  if (type.is_trivial()) {
+    this->add_bytes(value.get(), type.size());
+    return true;
+  }
+  return false;
+}
+
+bool NodeOutputCacheKey::add_field(const fn::GFieldRef field,
+                                   const OwnedMultiFunctionNodes &owned_fn_nodes)
+{
+  if (words_.size() > max_key_words) {
+    return false;
+  }
+  const fn::FieldNode &field_node = field.node();
+  switch (field_node.node_type()) {
+    case fn::FieldNodeType::Input: {
+      words_.append(uint64_t(KeyTag::FieldInput));
+      words_.append(field_node.hash());
+      words_.append(uint64_t(field.node_output_index()));
+      field_inputs_.append(field);
+      return true;
+    }
+    case fn::FieldNodeType::Constant: {
+      const fn::FieldConstant &constant = static_cast<const fn::FieldConstant &>(field_node);
+      words_.append(uint64_t(KeyTag::FieldConstant));
+      return this->add_value(constant.value());
+    }
+    case fn::FieldNodeType::Operation: {
+      const fn::FieldOperation &operation = static_cast<const fn::FieldOperation &>(field_node);
+      const fn::MultiFunction &fn = operation.multi_function();
+      if (operation.owns_multi_function()) {
+        const bNode *bnode = owned_fn_nodes.lookup_default(&fn, nullptr);
+        if (bnode == nullptr) {
+          /* The function may depend on data that can't be compared. */
+          return false;
+        }
+        words_.append(uint64_t(KeyTag::FieldOperationOfNode));
+        if (!this->add_node(*bnode)) {
+          return false;
+        }
+      }
+      else {
+        words_.append(uint64_t(KeyTag::FieldOperation));
+        words_.append(uint64_t(uintptr_t(&fn)));
+      }
+      words_.append(uint64_t(field.node_output_index()));
+      words_.append(uint64_t(operation.inputs().size()));
+      for (const fn::GField &input : operation.inputs()) {
+        if (!this->add_field(input, owned_fn_nodes)) {
+          return false;
+        }
+      }
+      return true;
+    }
+  }
+  BLI_assert_unreachable();
+  return false;
+}
+
+bool NodeOutputCacheKey::add_geometry(const GeometrySet &geometry)
+{
+  if (geometry_references_ids(geometry)) {
+    return false;
+  }
+  words_.append(uint64_t(KeyTag::Geometry));
+  for (const GeometryComponent *component : geometry.get_components_for_read()) {
+    words_.append(uint64_t(component->type()));
+    if (component->owns_direct_data()) {
+      words_.append(component->version());
+      continue;
+    }
+    uint64_t hash;
+    if (!hash_component_data(*component, hash)) {
+      return false;
+    }
+    /* Zero is not used as version. */
+    words_.append(0);
+    words_.append(hash);
+  }
+  words_.append(GEO_COMPONENT_TYPE_ENUM_SIZE);
+  return true;
+}
+
+void NodeOutputCacheKey::add_string(const StringRef str)
+{
+  this->add_bytes(str.data(), str.size());
+}
+
+void NodeOutputCacheKey::add_bytes(const void *data, const int64_t size)
+{
+  words_.append(uint64_t(size));
+  const int64_t words_num = (size + 7) / 8;
+  const int64_t old_size = words_.size();
+  words_.append_n_times(0, words_num);
+  memcpy(words_.data() + old_size, data, size_t(size));
+}
+
+uint64_t NodeOutputCacheKey::hash() const
+{
+  DataHasher hasher;
+  hasher.add_bytes(words_.data(), words_.size() * int64_t(sizeof(uint64_t)));
+  return hasher.get();
+}
+
+bool operator==(const NodeOutputCacheKey &a, const NodeOutputCacheKey &b)
+{
+  if (a.words_ != b.words_) {
+    return false;
+  }
+  /* Equal words have the same number of field inputs. */
+  for (const int i : a.field_inputs_.index_range()) {
+    if (!(a.field_inputs_[i] == b.field_inputs_[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Cache
+ * \{ */
+
+static int64_t custom_data_memory_size(const CustomData &data, const int size)
+{
+  int64_t memory_size = 0;
+  for (const CustomDataLayer &layer : Span(data.layers, data.totlayer)) {
+    memory_size += int64_t(CustomData_sizeof(layer.type)) * size;
+  }
+  return memory_size;
+}
+
+static int64_t geometry_memory_size(const GeometrySet &geometry)
+{
+  int64_t memory_size = 0;
+  if (const Mesh *mesh = geometry.get_mesh_for_read()) {
+    memory_size += custom_data_memory_size(mesh->vdata, mesh->totvert);
+    memory_size += custom_data_memory_size(mesh->edata, mesh->totedge);
+    memory_size += custom_data_memory_size(mesh->ldata, mesh->totloop);
+    memory_size += custom_data_memory_size(mesh->pdata, mesh->totpoly);
+  }
+  if (const PointCloud *pointcloud = geometry.get_pointcloud_for_read()) {
+    memory_size += custom_data_memory_size(pointcloud->pdata, pointcloud->totpoint);
+  }
+  if (const Curves *curves = geometry.get_curves_for_read()) {
+    const CurvesGeometry &curves_geometry = curves->geometry;
+    memory_size += custom_data_memory_size(curves_geometry.point_data, curves_geometry.point_size);
+    memory_size += custom_data_memory_size(curves_geometry.curve_data, curves_geometry.curve_size);
+    memory_size += int64_t(sizeof(int)) * (curves_geometry.curve_size + 1);
+  }
+  if (const InstancesComponent *instances = geometry.get_component_for_read<InstancesComponent>()) {
+    memory_size += int64_t(sizeof(float4x4) + sizeof(int)) * instances->instances_amount();
+    memory_size += custom_data_memory_size(instances->attributes().data,
+                                           instances->instances_amount());
+    for (const InstanceReference &reference : instances->references()) {
+      if (reference.type() == InstanceReference::Type::GeometrySet) {
+        memory_size += geometry_memory_size(reference.geometry_set());
+      }
+    }
+  }
+  return memory_size;
+}
+
+NodeOutputCache::Entry::~Entry()
+{
+  for (GMutablePointer value : this->outputs) {
+    if (value.get() != nullptr) {
+      value.destruct();
+      MEM_freeN(value.get());
+    }
+  }
+}
+
+bool NodeOutputCache::lookup(const NodeOutputCacheKey &key,
+                             FunctionRef<void(int output_index, GPointer value)> fn,
+                             nodes::GeoNodeExecReport &r_report)
+{
+  const uint64_t hash = key.hash();
+  std::lock_guard lock{mutex_};
+  const std::unique_ptr<Entry> *entry_ptr = entries_.lookup_ptr(hash);
+  if (entry_ptr == nullptr) {
+    return false;
+  }
+  Entry &entry = **entry_ptr;
+  if (!(entry.key == key)) {
+    return false;
+  }
+  entry.last_used = ++use_counter_;
+  for (const int i : entry.outputs.index_range()) {
+    if (entry.outputs[i].get() != nullptr) {
+      fn(i, entry.outputs[i]);
+    }
+  }
+  r_report = entry.report;
+  return true;
+}
+
+void NodeOutputCache::add(NodeOutputCacheKey key,
+                          Span<GPointer> outputs,
+                          const nodes::GeoNodeExecReport &report,
+                          const int64_t memory_limit)
+{
+  int64_t memory_size = 0;
+  for (const GPointer value : outputs) {
+    if (value.get() == nullptr) {
+      continue;
+    }
+    memory_size += value.type()->size();
+    if (value.type()->is<GeometrySet>()) {
+      const GeometrySet &geometry = *value.get<GeometrySet>();
+      if (geometry_references_ids(geometry)) {
+        return;
+      }
+      memory_size += geometry_memory_size(geometry);
+    }
+  }
+  if (memory_size > memory_limit) {
+    return;
+  }
+
+  std::unique_ptr<Entry> entry = std::make_unique<Entry>();
+  entry->key = std::move(key);
+  entry->report = report;
+  entry->memory_size = memory_size;
+  for (const GPointer value : outputs) {
+    if (value.get() == nullptr) {
+      entry->outputs.append({});
+      continue;
+    }
+    const CPPType &type = *value.type();
+    void *buffer = MEM_mallocN_aligned(type.size(), type.alignment(), __func__);
+    type.copy_construct(value.get(), buffer);
+    if (type.is<GeometrySet>()) {
+      /* The data might be freed when the evaluation is done. */
+      static_cast<GeometrySet *>(buffer)->ensure_owns_direct_data();
+    }
+    entry->outputs.append({type, buffer});
+  }
+
+  const uint64_t hash = entry->key.hash();
+  Vector<std::unique_ptr<Entry>> removed_entries;
+
+  std::lock_guard lock{mutex_};
+  entry->last_used = ++use_counter_;
+  if (std::unique_ptr<Entry> *old_entry = entries_.lookup_ptr(hash)) {
+    memory_size_ -= (*old_entry)->memory_size;
+    removed_entries.append(std::move(*old_entry));
+  }
+  memory_size_ += entry->memory_size;
+  entries_.add_overwrite(hash, std::move(entry));
+
+  /* Remove the least recently used entries. The new entry is not removed, because it fits. */
+  while (memory_size_ > memory_limit) {
+    uint64_t oldest_hash = 0;
+    uint64_t oldest_last_used = UINT64_MAX;
+    for (const auto item : entries_.items()) {
+      if (item.value->last_used < oldest_last_used) {
+        oldest_hash = item.key;
+        oldest_last_used = item.value->last_used;
+      }
+    }
+    std::unique_ptr<Entry> oldest_entry = entries_.pop(oldest_hash);
+    memory_size_ -= oldest_entry->memory_size;
+    removed_entries.append(std::move(oldest_entry));
+  }
+}
+
+void NodeOutputCache::clear()
+{
+  std::lock_guard lock{mutex_};
+  entries_.clear();
+  memory_size_ = 0;
+}
+
+/** \} */
+
+}  // namespace blender::modifiers::geometry_nodes
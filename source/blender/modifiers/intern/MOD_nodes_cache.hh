@@ -0,0 +1,123 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup modifiers
+ *
+ * Cache for the outputs of expensive geometry nodes, see
+ * #bNodeType.geometry_node_execute_supports_caching. It is stored on the original modifier, so
+ * that later evaluations can reuse the outputs of nodes whose inputs and properties did not
+ * change. For example, changing an input of a node at the end of the node tree doesn't execute
+ * a "Distribute Points on Faces" node at the start again.
+ *
+ * Geometry is compared with #GeometryComponent::version when it is owned by the evaluation.
+ * Geometry owned by others, like the input geometry of the modifier, is compared by a hash of its
+ * data instead. Fields are compared structurally.
+ */
+
+#include <memory>
+#include <mutex>
+
+#include "BLI_generic_pointer.hh"
+#include "BLI_map.hh"
+#include "BLI_vector.hh"
+
+#include "FN_field.hh"
+
+#include "NOD_derived_node_tree.hh"
+#include "NOD_geometry_exec.hh"
+
+namespace blender::modifiers::geometry_nodes {
+
+using namespace nodes::derived_node_tree_types;
+
+/**
+ * Multi-functions that are built for a specific node during the evaluation. Fields using them are
+ * compared by the identity of that node, because the functions are built again by every
+ * evaluation.
+ */
+using OwnedMultiFunctionNodes = Map<const fn::MultiFunction *, const bNode *>;
+
+/**
+ * Identifies an execution of a node by everything its outputs depend on.
+ */
+class NodeOutputCacheKey {
+ private:
+  /** Identity and properties of the node and the values of all its inputs. */
+  Vector<uint64_t> words_;
+  /** Field inputs that the input fields depend on, compared with #FieldNode::is_equal_to. */
+  Vector<fn::GFieldRef> field_inputs_;
+  /**
+   * Input fields are kept alive, so that the memory of the field nodes and multi-functions that
+   * are compared by address is not reused for something else.
+   */
+  Vector<fn::GField> fields_;
+
+ public:
+  /**
+   * \return False when the node can't be cached, because its properties can't be compared.
+   */
+  bool add_node(const bNode &bnode);
+  /**
+   * Add the value of an input socket of the node.
+   * \return False when the value can't be compared, so that the node can't be cached.
+   */
+  bool add_input(const InputSocketRef &socket,
+                 const void *value,
+                 const OwnedMultiFunctionNodes &owned_fn_nodes);
+  void add_number(uint64_t number);
+
+  uint64_t hash() const;
+  friend bool operator==(const NodeOutputCacheKey &a, const NodeOutputCacheKey &b);
+
+ private:
+  bool add_value(GPointer value);
+  bool add_field(fn::GFieldRef field, const OwnedMultiFunctionNodes &owned_fn_nodes);
+  bool add_geometry(const GeometrySet &geometry);
+  void add_string(StringRef str);
+  void add_bytes(const void *data, int64_t size);
+};
+
+class NodeOutputCache : NonCopyable, NonMovable {
+ private:
+  struct Entry {
+    NodeOutputCacheKey key;
+    /** Copies of the outputs, indexed by socket index. Null for outputs that were not computed. */
+    Vector<GMutablePointer> outputs;
+    nodes::GeoNodeExecReport report;
+    int64_t memory_size = 0;
+    uint64_t last_used = 0;
+
+    ~Entry();
+  };
+
+  std::mutex mutex_;
+  Map<uint64_t, std::unique_ptr<Entry>> entries_;
+  int64_t memory_size_ = 0;
+  uint64_t use_counter_ = 0;
+
+ public:
+  /**
+   * Find the outputs that were computed for the key. The callback is called for every output
+   * that was computed while the cache is locked and has to copy the value.
+   */
+  bool lookup(const NodeOutputCacheKey &key,
+              FunctionRef<void(int output_index, GPointer value)> fn,
+              nodes::GeoNodeExecReport &r_report);
+
+  /**
+   * Store copies of the outputs of a node execution, indexed by socket index (null for outputs
+   * that were not computed). Least recently used entries are removed to stay below the memory
+   * limit.
+   */
+  void add(NodeOutputCacheKey key,
+           Span<GPointer> outputs,
+           const nodes::GeoNodeExecReport &report,
+           int64_t memory_limit);
+
+  /** Remove all entries. */
+  void clear();
+};
+
+}  // namespace blender::modifiers::geometry_nodes
@@ -2,11 +2,14 @@
 
 #include "MOD_nodes_evaluator.hh"
 
+#include "MEM_guardedalloc.h"
+
 #include "BKE_type_conversions.hh"
 
 #include "NOD_geometry_exec.hh"
 #include "NOD_socket_declarations.hh"
 
+#include "DEG_depsgraph_debug.h"
 #include "DEG_depsgraph_query.h"
 
 #include "FN_field.hh"
@@ -23,6 +26,7 @@
 #include "BLI_vector_set.hh"
 
 #include <chrono>
+#include <optional>
 
 namespace blender::modifiers::geometry_nodes {
 
@@ -33,6 +37,8 @@ using fn::ValueOrFieldCPPType;
 using nodes::GeoNodeExecParams;
 using namespace fn::multi_function_types;
 
+using Clock = std::chrono::steady_clock;
+
 enum class ValueUsage : uint8_t {
   /* The value is definitely used. */
   Required,
@@ -247,6 +253,14 @@ struct NodeState {
    * not run twice at the same time accidentally.
    */
   NodeScheduleState schedule_state = NodeScheduleState::NotScheduled;
+
+  /**
+   * Nodes without geometry sockets only process single values and build fields, which is much
+   * cheaper than the overhead of running them from a separate task. They are run on the thread
+   * that scheduled them instead. This is not changed after the state is initialized, so it can be
+   * read without locking.
+   */
+  bool run_inline = false;
 };
 
 /**
@@ -403,6 +417,8 @@ static bool node_supports_laziness(const DNode node)
 struct NodeTaskRunState {
   /** The node that should be run on the same thread after the current node finished. */
   DNode next_node_to_run;
+  /** Other scheduled nodes that are cheap enough to run on the same thread, see #run_inline. */
+  Vector<DNode> inline_nodes_to_run;
 };
 
 /** Implements the callbacks that might be called when a node is executed. */
@@ -423,6 +439,9 @@ class NodeParamsProvider : public nodes::GeoNodeExecParamsProvider {
   GMutablePointer extract_input(StringRef identifier) override;
   Vector<GMutablePointer> extract_multi_input(StringRef identifier) override;
   GPointer get_input(StringRef identifier) const override;
+  /** When not empty, copies of the output values are stored here, indexed by socket index. */
+  MutableSpan<GMutablePointer> output_copies;
+
   GMutablePointer alloc_output_value(const CPPType &type) override;
   void set_output(StringRef identifier, GMutablePointer value) override;
   void set_input_unused(StringRef identifier) override;
@@ -465,6 +484,9 @@ class GeometryNodesEvaluator {
   GeometryNodesEvaluationParams &params_;
   const blender::bke::DataTypeConversions &conversions_;
 
+  /** Only used when the node output cache is used. */
+  OwnedMultiFunctionNodes owned_fn_nodes_;
+
   friend NodeParamsProvider;
 
  public:
@@ -541,6 +563,15 @@ class GeometryNodesEvaluator {
         node_state.inputs[socket->index()].force_compute = true;
       }
     }
+
+    if (params_.node_cache != nullptr) {
+      for (const NodeWithState &item : node_states_) {
+        const nodes::NodeMultiFunctions::Item &fn_item = params_.mf_by_node->try_get(item.node);
+        if (fn_item.owned_fn) {
+          owned_fn_nodes_.add(fn_item.fn, item.node->bnode());
+        }
+      }
+    }
   }
 
   void initialize_node_state(const DNode node, NodeState &node_state, LinearAllocator<> &allocator)
@@ -583,6 +614,7 @@ class GeometryNodesEvaluator {
       }
     }
     /* Initialize output states. */
+    bool has_geometry_socket = false;
     for (const int i : node->outputs().index_range()) {
       OutputState &output_state = node_state.outputs[i];
       const DOutputSocket socket = node.output(i);
@@ -597,6 +629,9 @@ class GeometryNodesEvaluator {
         output_state.output_usage = ValueUsage::Unused;
         continue;
       }
+      if (*type == CPPType::get<GeometrySet>()) {
+        has_geometry_socket = true;
+      }
       /* Count the number of potential users for this socket. */
       socket.foreach_target_socket(
           [&, this](const DInputSocket target_socket,
@@ -614,6 +649,12 @@ class GeometryNodesEvaluator {
         output_state.output_usage = ValueUsage::Unused;
       }
     }
+    for (const InputState &input_state : node_state.inputs) {
+      if (input_state.type != nullptr && *input_state.type == CPPType::get<GeometrySet>()) {
+        has_geometry_socket = true;
+      }
+    }
+    node_state.run_inline = !has_geometry_socket;
   }
 
   void destruct_node_states()
@@ -743,12 +784,17 @@ class GeometryNodesEvaluator {
      * - Fewer round trips through the task pool which add threading overhead.
      * - Helps with cpu cache efficiency, because a thread is more likely to process data that it
      *   has processed shortly before.
+     * Scheduled nodes that are cheap to run are executed on this thread as well.
      */
-    DNode next_node_to_run = root_node_with_state->node;
-    while (next_node_to_run) {
+    Vector<DNode, 16> nodes_to_run = {root_node_with_state->node};
+    while (!nodes_to_run.is_empty()) {
       NodeTaskRunState run_state;
-      evaluator.node_task_run(next_node_to_run, &run_state);
-      next_node_to_run = run_state.next_node_to_run;
+      evaluator.node_task_run(nodes_to_run.pop_last(), &run_state);
+      nodes_to_run.extend(run_state.inline_nodes_to_run);
+      /* Added last so that it runs next. */
+      if (run_state.next_node_to_run) {
+        nodes_to_run.append(run_state.next_node_to_run);
+      }
     }
   }
 
@@ -977,19 +1023,183 @@ class GeometryNodesEvaluator {
 
   void execute_geometry_node(const DNode node, NodeState &node_state, NodeTaskRunState *run_state)
   {
-    using Clock = std::chrono::steady_clock;
     const bNode &bnode = *node->bnode();
 
+    std::optional<NodeOutputCacheKey> cache_key;
+    if (params_.node_cache != nullptr && bnode.typeinfo->geometry_node_execute_supports_caching) {
+      BLI_assert(!node_supports_laziness(node));
+      cache_key = this->build_node_output_cache_key(node, node_state);
+    }
+
     NodeParamsProvider params_provider{*this, node, node_state, run_state};
-    GeoNodeExecParams params{params_provider};
-    Clock::time_point begin = Clock::now();
-    bnode.typeinfo->geometry_node_execute(params);
-    Clock::time_point end = Clock::now();
+    const bool do_trace = DEG_debug_trace_is_enabled();
+    if (do_trace) {
+      DEG_debug_trace_begin("geometry_nodes", bnode.name);
+    }
+    const Clock::time_point begin = Clock::now();
+    const size_t allocated_before = MEM_get_thread_allocated();
+    if (cache_key.has_value()) {
+      this->execute_geometry_node_with_cache(
+          node, node_state, std::move(*cache_key), params_provider, run_state);
+    }
+    else {
+      GeoNodeExecParams params{params_provider};
+      bnode.typeinfo->geometry_node_execute(params);
+    }
+    this->log_node_execution(node, begin, allocated_before);
+    if (do_trace) {
+      DEG_debug_trace_end();
+    }
+  }
+
+  /**
+   * Log the time and the memory allocated by a node execution that started at the given point.
+   * Only allocations on the executing thread are counted, not those of tasks it spawned.
+   */
+  void log_node_execution(const DNode node,
+                          const Clock::time_point begin,
+                          const size_t allocated_before)
+  {
+    if (params_.geo_logger == nullptr) {
+      return;
+    }
+    const Clock::time_point end = Clock::now();
     const std::chrono::microseconds duration =
         std::chrono::duration_cast<std::chrono::microseconds>(end - begin);
+    const size_t allocated = MEM_get_thread_allocated() - allocated_before;
+    params_.geo_logger->local().log_execution_time(node, duration, int64_t(allocated));
+  }
+
+  /**
+   * Build the key that identifies the execution of the node with its current inputs in the node
+   * output cache, or nothing when the inputs can't be compared.
+   */
+  std::optional<NodeOutputCacheKey> build_node_output_cache_key(const DNode node,
+                                                                const NodeState &node_state)
+  {
+    NodeOutputCacheKey key;
+    if (!key.add_node(*node->bnode())) {
+      return std::nullopt;
+    }
+    /* Outputs that are not used might not be computed. */
+    uint64_t used_outputs_mask = 0;
+    for (const int i : node->outputs().index_range()) {
+      if (node_state.outputs[i].output_usage_for_execution == ValueUsage::Unused) {
+        continue;
+      }
+      if (i >= 64) {
+        return std::nullopt;
+      }
+      used_outputs_mask |= uint64_t(1) << i;
+    }
+    key.add_number(used_outputs_mask);
+
+    for (const InputSocketRef *socket_ref : node->inputs()) {
+      const InputState &input_state = node_state.inputs[socket_ref->index()];
+      if (input_state.type == nullptr) {
+        continue;
+      }
+      BLI_assert(input_state.was_ready_for_execution);
+      if (socket_ref->is_multi_input_socket()) {
+        const MultiInputValue &multi_value = *input_state.value.multi;
+        key.add_number(uint64_t(multi_value.values.size()));
+        for (const void *value : multi_value.values) {
+          if (!key.add_input(*socket_ref, value, owned_fn_nodes_)) {
+            return std::nullopt;
+          }
+        }
+        continue;
+      }
+      const void *value = input_state.value.single->value;
+      if (value == nullptr || !key.add_input(*socket_ref, value, owned_fn_nodes_)) {
+        return std::nullopt;
+      }
+    }
+    return key;
+  }
+
+  /**
+   * Reuse the outputs of a previous execution with the same inputs, or execute the node and store
+   * its outputs in the cache.
+   */
+  void execute_geometry_node_with_cache(const DNode node,
+                                        NodeState &node_state,
+                                        NodeOutputCacheKey cache_key,
+                                        NodeParamsProvider &params_provider,
+                                        NodeTaskRunState *run_state)
+  {
+    if (this->forward_cached_outputs(node, node_state, cache_key, run_state)) {
+      return;
+    }
+
+    nodes::GeoNodeExecReport report;
+    Array<GMutablePointer> output_copies(node->outputs().size());
+    params_provider.report = &report;
+    params_provider.output_copies = output_copies;
+    GeoNodeExecParams params{params_provider};
+    node->bnode()->typeinfo->geometry_node_execute(params);
+
+    Array<GPointer> outputs(output_copies.size());
+    for (const int i : output_copies.index_range()) {
+      outputs[i] = output_copies[i];
+    }
+    params_.node_cache->add(
+        std::move(cache_key), outputs, report, params_.node_cache_memory_limit);
+    for (GMutablePointer value : output_copies) {
+      if (value.get() != nullptr) {
+        value.destruct();
+      }
+    }
+  }
+
+  /**
+   * Forward copies of the outputs that were cached for a previous execution of the node with the
+   * same inputs, instead of executing it again.
+   */
+  bool forward_cached_outputs(const DNode node,
+                              NodeState &node_state,
+                              const NodeOutputCacheKey &key,
+                              NodeTaskRunState *run_state)
+  {
+    Vector<std::pair<int, GMutablePointer>> output_values;
+    nodes::GeoNodeExecReport report;
+    const bool found = params_.node_cache->lookup(
+        key,
+        [&](const int output_index, const GPointer value) {
+          GMutablePointer copy;
+          this->copy_output_value(value, copy);
+          output_values.append({output_index, copy});
+        },
+        report);
+    if (!found) {
+      return false;
+    }
+
     if (params_.geo_logger != nullptr) {
-      params_.geo_logger->local().log_execution_time(node, duration);
+      geo_log::LocalGeoLogger &local_logger = params_.geo_logger->local();
+      for (auto &warning : report.warnings) {
+        local_logger.log_node_warning(node, warning.first, std::move(warning.second));
+      }
+      for (auto &attribute_usage : report.used_named_attributes) {
+        local_logger.log_used_named_attribute(
+            node, std::move(attribute_usage.first), attribute_usage.second);
+      }
     }
+    /* Forward outside of the lookup, because the cache is locked there. */
+    for (const auto &[output_index, value] : output_values) {
+      this->forward_output(node.output(output_index), value, run_state);
+      node_state.outputs[output_index].has_been_computed = true;
+    }
+    return true;
+  }
+
+  void copy_output_value(const GPointer value, GMutablePointer &r_copy)
+  {
+    LinearAllocator<> &allocator = local_allocators_.local();
+    const CPPType &type = *value.type();
+    void *buffer = allocator.allocate(type.size(), type.alignment());
+    type.copy_construct(value.get(), buffer);
+    r_copy = {type, buffer};
   }
 
   void execute_multi_function_node(const DNode node,
@@ -1021,6 +1231,8 @@ class GeometryNodesEvaluator {
       }
     }
 
+    const Clock::time_point begin = Clock::now();
+    const size_t allocated_before = MEM_get_thread_allocated();
     if (any_input_is_field) {
       this->execute_multi_function_node__field(
           node, fn_item, node_state, allocator, input_values, input_types, run_state);
@@ -1029,6 +1241,7 @@ class GeometryNodesEvaluator {
       this->execute_multi_function_node__value(
           node, *fn_item.fn, node_state, allocator, input_values, input_types, run_state);
     }
+    this->log_node_execution(node, begin, allocated_before);
   }
 
   void execute_multi_function_node__field(const DNode node,
@@ -1733,6 +1946,9 @@ class GeometryNodesEvaluator {
          * the most data usually comes first in nodes. */
         run_state->next_node_to_run = node_to_schedule;
       }
+      else if (run_state != nullptr && this->get_node_state(node_to_schedule).run_inline) {
+        run_state->inline_nodes_to_run.append(node_to_schedule);
+      }
       else {
         /* Push the node to the task pool so that another thread can start working on it. */
         this->add_node_to_task_pool(node_to_schedule);
@@ -1839,6 +2055,9 @@ void NodeParamsProvider::set_output(StringRef identifier, GMutablePointer value)
 
   OutputState &output_state = node_state_.outputs[socket->index()];
   BLI_assert(!output_state.has_been_computed);
+  if (!output_copies.is_empty()) {
+    evaluator_.copy_output_value(value, output_copies[socket->index()]);
+  }
   evaluator_.forward_output(socket, value, run_state_);
   output_state.has_been_computed = true;
 }
@@ -1916,6 +2135,9 @@ void NodeParamsProvider::set_default_remaining_outputs()
     BLI_assert(type != nullptr);
     void *buffer = allocator.allocate(type->size(), type->alignment());
     type->value_initialize(buffer);
+    if (!output_copies.is_empty()) {
+      evaluator_.copy_output_value({type, buffer}, output_copies[i]);
+    }
     evaluator_.forward_output(socket, {type, buffer}, run_state_);
     output_state.has_been_computed = true;
   }
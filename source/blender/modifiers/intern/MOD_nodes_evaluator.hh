@@ -13,6 +13,8 @@
 
 #include "FN_multi_function.hh"
 
+#include "MOD_nodes_cache.hh"
+
 namespace geo_log = blender::nodes::geometry_nodes_eval_log;
 
 namespace blender::modifiers::geometry_nodes {
@@ -35,6 +37,12 @@ struct GeometryNodesEvaluationParams {
   Depsgraph *depsgraph;
   Object *self_object;
   geo_log::GeoLogger *geo_logger;
+  /**
+   * When not null, the outputs of expensive nodes are stored here and reused by later evaluations
+   * when the inputs did not change.
+   */
+  NodeOutputCache *node_cache = nullptr;
+  int64_t node_cache_memory_limit = 0;
 
   Vector<GMutablePointer> r_output_values;
 };
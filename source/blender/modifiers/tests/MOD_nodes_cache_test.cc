@@ -0,0 +1,97 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "MOD_nodes_cache.hh"
+
+namespace blender::modifiers::geometry_nodes::tests {
+
+static NodeOutputCacheKey make_key(const Span<uint64_t> numbers)
+{
+  NodeOutputCacheKey key;
+  for (const uint64_t number : numbers) {
+    key.add_number(number);
+  }
+  return key;
+}
+
+static void add_int(NodeOutputCache &cache,
+                    const NodeOutputCacheKey &key,
+                    const int value,
+                    const int64_t memory_limit)
+{
+  /* The first output was not computed. */
+  cache.add(key, {GPointer(), GPointer(CPPType::get<int>(), &value)}, {}, memory_limit);
+}
+
+/** \return The cached value of the second output, or -1 when nothing is cached. */
+static int lookup_int(NodeOutputCache &cache, const NodeOutputCacheKey &key)
+{
+  int result = -1;
+  nodes::GeoNodeExecReport report;
+  const bool found = cache.lookup(
+      key,
+      [&](const int output_index, const GPointer value) {
+        EXPECT_EQ(output_index, 1);
+        result = *value.get<int>();
+      },
+      report);
+  EXPECT_EQ(found, result != -1);
+  return result;
+}
+
+TEST(node_output_cache, LookupHit)
+{
+  NodeOutputCache cache;
+  add_int(cache, make_key({1, 2}), 5, 1024);
+  EXPECT_EQ(lookup_int(cache, make_key({1, 2})), 5);
+  /* Lookups don't consume the entry. */
+  EXPECT_EQ(lookup_int(cache, make_key({1, 2})), 5);
+}
+
+TEST(node_output_cache, ChangedInputsMiss)
+{
+  NodeOutputCache cache;
+  add_int(cache, make_key({1, 2}), 5, 1024);
+  EXPECT_EQ(lookup_int(cache, make_key({1, 3})), -1);
+  EXPECT_EQ(lookup_int(cache, make_key({1, 2, 3})), -1);
+  EXPECT_EQ(lookup_int(cache, make_key({})), -1);
+}
+
+TEST(node_output_cache, AddOverwrites)
+{
+  NodeOutputCache cache;
+  add_int(cache, make_key({1}), 5, 1024);
+  add_int(cache, make_key({1}), 6, 1024);
+  EXPECT_EQ(lookup_int(cache, make_key({1})), 6);
+}
+
+TEST(node_output_cache, Clear)
+{
+  NodeOutputCache cache;
+  add_int(cache, make_key({1}), 5, 1024);
+  add_int(cache, make_key({2}), 6, 1024);
+  cache.clear();
+  EXPECT_EQ(lookup_int(cache, make_key({1})), -1);
+  EXPECT_EQ(lookup_int(cache, make_key({2})), -1);
+}
+
+TEST(node_output_cache, MemoryLimit)
+{
+  NodeOutputCache cache;
+  /* Outputs larger than the limit are not cached at all. */
+  add_int(cache, make_key({1}), 5, sizeof(int) - 1);
+  EXPECT_EQ(lookup_int(cache, make_key({1})), -1);
+
+  /* Room for two entries, the least recently used one is removed. */
+  const int64_t limit = sizeof(int) * 2;
+  add_int(cache, make_key({1}), 5, limit);
+  add_int(cache, make_key({2}), 6, limit);
+  EXPECT_EQ(lookup_int(cache, make_key({1})), 5);
+  add_int(cache, make_key({3}), 7, limit);
+  EXPECT_EQ(lookup_int(cache, make_key({1})), 5);
+  EXPECT_EQ(lookup_int(cache, make_key({2})), -1);
+  EXPECT_EQ(lookup_int(cache, make_key({3})), 7);
+}
+
+}  // namespace blender::modifiers::geometry_nodes::tests
@@ -178,6 +178,8 @@ class DerivedNodeTree {
   LinearAllocator<> allocator_;
   DTreeContext *root_context_;
   VectorSet<const NodeTreeRef *> used_node_tree_refs_;
+  /** Tree refs of original node trees when the shared tree refs are used. */
+  NodeTreeRefMap owned_tree_refs_;
 
  public:
   /**
@@ -187,6 +189,11 @@ class DerivedNodeTree {
    * derived node tree.
    */
   DerivedNodeTree(bNodeTree &btree, NodeTreeRefMap &node_tree_refs);
+  /**
+   * Construct a derived node tree that uses the tree refs shared by all users of the evaluated
+   * node trees (see #get_shared_tree_ref), so that only the contexts are built for every user.
+   */
+  DerivedNodeTree(bNodeTree &btree);
   ~DerivedNodeTree();
 
   const DTreeContext &root_context() const;
@@ -207,7 +214,7 @@ class DerivedNodeTree {
   DTreeContext &construct_context_recursively(DTreeContext *parent_context,
                                               const NodeRef *parent_node,
                                               bNodeTree &btree,
-                                              NodeTreeRefMap &node_tree_refs);
+                                              NodeTreeRefMap *node_tree_refs);
   void destruct_context_recursively(DTreeContext *context);
 
   void foreach_node_in_context_recursive(const DTreeContext &context,
@@ -43,6 +43,15 @@ using fn::ValueOrField;
 using geometry_nodes_eval_log::NamedAttributeUsage;
 using geometry_nodes_eval_log::NodeWarningType;
 
+/**
+ * Information a node reports during its execution in addition to its outputs. The evaluator
+ * records it when the outputs of the node are cached, to report it again when they are reused.
+ */
+struct GeoNodeExecReport {
+  Vector<std::pair<NodeWarningType, std::string>> warnings;
+  Vector<std::pair<std::string, NamedAttributeUsage>> used_named_attributes;
+};
+
 /**
  * This class exists to separate the memory management details of the geometry nodes evaluator
  * from the node execution functions and related utilities.
@@ -54,6 +63,8 @@ class GeoNodeExecParamsProvider {
   const ModifierData *modifier = nullptr;
   Depsgraph *depsgraph = nullptr;
   geometry_nodes_eval_log::GeoLogger *logger = nullptr;
+  /** When not null, warnings and attribute usages are recorded here as well. */
+  GeoNodeExecReport *report = nullptr;
 
   /**
    * Returns true when the node is allowed to get/extract the input value. The identifier is
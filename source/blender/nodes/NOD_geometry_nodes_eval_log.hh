@@ -29,6 +29,7 @@
 #include "FN_field.hh"
 
 #include <chrono>
+#include <ostream>
 
 struct SpaceNode;
 struct SpaceSpreadsheet;
@@ -157,6 +158,8 @@ struct NodeWithWarning {
 struct NodeWithExecutionTime {
   DNode node;
   std::chrono::microseconds exec_time;
+  /** Bytes allocated by the thread that executed the node, see #MEM_get_thread_allocated. */
+  int64_t allocated_bytes;
 };
 
 struct NodeWithDebugMessage {
@@ -217,7 +220,9 @@ class LocalGeoLogger {
   void log_value_for_sockets(Span<DSocket> sockets, GPointer value);
   void log_multi_value_socket(DSocket socket, Span<GPointer> values);
   void log_node_warning(DNode node, NodeWarningType type, std::string message);
-  void log_execution_time(DNode node, std::chrono::microseconds exec_time);
+  void log_execution_time(DNode node,
+                          std::chrono::microseconds exec_time,
+                          int64_t allocated_bytes);
   void log_used_named_attribute(DNode node, std::string attribute_name, NamedAttributeUsage usage);
   /**
    * Log a message that will be displayed in the node editor next to the node.
@@ -300,6 +305,9 @@ class NodeLog {
   Vector<std::string, 0> debug_messages_;
   Vector<UsedNamedAttribute, 0> used_named_attributes_;
   std::chrono::microseconds exec_time_;
+  int64_t allocated_bytes_ = 0;
+  /** Index of the thread that executed the node in the evaluation, -1 if not executed. */
+  int thread_index_ = -1;
 
   friend ModifierLog;
 
@@ -338,6 +346,16 @@ class NodeLog {
     return exec_time_;
   }
 
+  int64_t allocated_bytes() const
+  {
+    return allocated_bytes_;
+  }
+
+  int thread_index() const
+  {
+    return thread_index_;
+  }
+
   Vector<const GeometryAttributeInfo *> lookup_available_attributes() const;
 };
 
@@ -354,6 +372,19 @@ class TreeLog {
   const NodeLog *lookup_node_log(const bNode &node) const;
   const TreeLog *lookup_child_log(StringRef node_name) const;
   void foreach_node_log(FunctionRef<void(const NodeLog &)> fn) const;
+  /**
+   * Same as #foreach_node_log, but also passes the names of the group nodes that contain the
+   * node, starting at this tree, and the name of the node.
+   */
+  void foreach_node_log_with_path(
+      FunctionRef<void(Span<std::string> group_path, StringRef node_name, const NodeLog &)> fn)
+      const;
+
+ private:
+  void foreach_node_log_with_path(
+      Vector<std::string> &group_path,
+      FunctionRef<void(Span<std::string> group_path, StringRef node_name, const NodeLog &)> fn)
+      const;
 };
 
 /** Contains information about an entire geometry nodes evaluation. */
@@ -390,6 +421,12 @@ class ModifierLog {
       const SpaceSpreadsheet &sspreadsheet);
   void foreach_node_log(FunctionRef<void(const NodeLog &)> fn) const;
 
+  /**
+   * Write the execution time, allocated memory and thread of all executed nodes as JSON, sorted
+   * by execution time, to find the nodes that take most of the evaluation time.
+   */
+  void write_profile_json(std::ostream &stream) const;
+
   const GeometryValueLog *input_geometry_log() const;
   const GeometryValueLog *output_geometry_log() const;
 
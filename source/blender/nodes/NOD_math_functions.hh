@@ -7,6 +7,7 @@
 #include "BLI_math_base_safe.h"
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.hh"
+#include "BLI_span.hh"
 #include "BLI_string_ref.hh"
 
 namespace blender::nodes {
@@ -26,6 +27,32 @@ const FloatMathOperationInfo *get_float_math_operation_info(int operation);
 const FloatMathOperationInfo *get_float3_math_operation_info(int operation);
 const FloatMathOperationInfo *get_float_compare_operation_info(int operation);
 
+using FloatSpanMathFunction = void (*)(Span<float> a, Span<float> b, MutableSpan<float> r_result);
+using Float3SpanMathFunction = void (*)(Span<float3> a,
+                                        Span<float3> b,
+                                        MutableSpan<float3> r_result);
+
+/**
+ * Explicitly vectorized versions of some of the functions passed to the callback of
+ * #try_dispatch_float_math_fl_fl_to_fl and #try_dispatch_float_math_fl3_fl3_to_fl3. They process
+ * contiguous spans and compute the same values as the element functions.
+ * \return Null when the operation is not vectorized for the current platform.
+ */
+FloatSpanMathFunction get_float_math_fl_fl_to_fl_span_function(int operation);
+Float3SpanMathFunction get_float3_math_fl3_fl3_to_fl3_span_function(int operation);
+
+/**
+ * Linear map range of a span of values with the same ranges for all values, vectorized when
+ * possible. Computes the same values as the Map Range node.
+ */
+void map_range_linear_span(Span<float> values,
+                           float from_min,
+                           float from_max,
+                           float to_min,
+                           float to_max,
+                           bool clamp,
+                           MutableSpan<float> r_results);
+
 /**
  * This calls the `callback` with two arguments:
  * 1. The math function that takes a float as input and outputs a new float.
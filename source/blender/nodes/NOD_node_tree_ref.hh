@@ -320,6 +320,13 @@ using NodeTreeRefMap = Map<bNodeTree *, std::unique_ptr<const NodeTreeRef>>;
 
 const NodeTreeRef &get_tree_ref_from_map(NodeTreeRefMap &node_tree_refs, bNodeTree &btree);
 
+/**
+ * Get a tree ref that is shared by all users of an evaluated node tree, so that it only has to be
+ * built once, even when the tree is used by many modifiers. Original node trees can change at any
+ * time, so their tree ref is added to #owned_tree_refs instead.
+ */
+const NodeTreeRef &get_shared_tree_ref(bNodeTree &btree, NodeTreeRefMap &owned_tree_refs);
+
 namespace node_tree_ref_types {
 using nodes::InputSocketRef;
 using nodes::NodeRef;
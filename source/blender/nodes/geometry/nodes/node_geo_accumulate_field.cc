@@ -229,19 +229,21 @@ template<typename T> class AccumulateFieldInput final : public GeometryFieldInpu
     Array<T> accumulations_out(domain_size);
 
     if (group_indices.is_single()) {
-      T accumulation = T();
-      if (accumulation_mode_ == AccumulationMode::Leading) {
-        for (const int i : values.index_range()) {
-          accumulation = values[i] + accumulation;
-          accumulations_out[i] = accumulation;
+      devirtualize_varray(values, [&](const auto values) {
+        T accumulation = T();
+        if (accumulation_mode_ == AccumulationMode::Leading) {
+          for (const int i : values.index_range()) {
+            accumulation = values[i] + accumulation;
+            accumulations_out[i] = accumulation;
+          }
         }
-      }
-      else {
-        for (const int i : values.index_range()) {
-          accumulations_out[i] = accumulation;
-          accumulation = values[i] + accumulation;
+        else {
+          for (const int i : values.index_range()) {
+            accumulations_out[i] = accumulation;
+            accumulation = values[i] + accumulation;
+          }
         }
-      }
+      });
     }
     else {
       Map<int, T> accumulations;
@@ -314,9 +316,11 @@ template<typename T> class TotalFieldInput final : public GeometryFieldInput {
 
     if (group_indices.is_single()) {
       T accumulation = T();
-      for (const int i : values.index_range()) {
-        accumulation = values[i] + accumulation;
-      }
+      devirtualize_varray(values, [&](const auto values) {
+        for (const int i : values.index_range()) {
+          accumulation = values[i] + accumulation;
+        }
+      });
       return VArray<T>::ForSingle(accumulation, domain_size);
     }
 
@@ -119,5 +119,6 @@ void register_node_type_geo_boolean()
   ntype.updatefunc = file_ns::node_update;
   node_type_init(&ntype, file_ns::node_init);
   ntype.geometry_node_execute = file_ns::node_geo_exec;
+  ntype.geometry_node_execute_supports_caching = true;
   nodeRegisterType(&ntype);
 }
@@ -307,5 +307,6 @@ void register_node_type_geo_convex_hull()
   geo_node_type_base(&ntype, GEO_NODE_CONVEX_HULL, "Convex Hull", NODE_CLASS_GEOMETRY);
   ntype.declare = file_ns::node_declare;
   ntype.geometry_node_execute = file_ns::node_geo_exec;
+  ntype.geometry_node_execute_supports_caching = true;
   nodeRegisterType(&ntype);
 }
@@ -660,5 +660,6 @@ void register_node_type_geo_curve_resample()
   node_type_init(&ntype, file_ns::node_init);
   node_type_update(&ntype, file_ns::node_update);
   ntype.geometry_node_execute = file_ns::node_geo_exec;
+  ntype.geometry_node_execute_supports_caching = true;
   nodeRegisterType(&ntype);
 }
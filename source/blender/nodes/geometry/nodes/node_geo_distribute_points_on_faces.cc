@@ -1,6 +1,5 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
 
-#include "BLI_kdtree.h"
 #include "BLI_noise.hh"
 #include "BLI_rand.hh"
 #include "BLI_task.hh"
@@ -17,6 +16,8 @@
 #include "BKE_mesh_sample.hh"
 #include "BKE_pointcloud.h"
 
+#include "GEO_find_duplicates.hh"
+
 #include "UI_interface.h"
 #include "UI_resources.h"
 
@@ -108,17 +109,17 @@ static void sample_mesh_surface(const Mesh &mesh,
   const Span<MLoopTri> looptris{BKE_mesh_runtime_looptri_ensure(&mesh),
                                 BKE_mesh_runtime_looptri_len(&mesh)};
 
-  for (const int looptri_index : looptris.index_range()) {
+  /* Every triangle has its own random number generator, so the points of all triangles can be
+   * sampled in parallel. The number of points is computed first to find where the points of every
+   * triangle are stored, the generator is seeded again to sample the same points afterwards. */
+  auto sample_looptri_points_num = [&](const int looptri_index, RandomNumberGenerator &rng) {
     const MLoopTri &looptri = looptris[looptri_index];
     const int v0_loop = looptri.tri[0];
     const int v1_loop = looptri.tri[1];
     const int v2_loop = looptri.tri[2];
-    const int v0_index = mesh.mloop[v0_loop].v;
-    const int v1_index = mesh.mloop[v1_loop].v;
-    const int v2_index = mesh.mloop[v2_loop].v;
-    const float3 v0_pos = float3(mesh.mvert[v0_index].co);
-    const float3 v1_pos = float3(mesh.mvert[v1_index].co);
-    const float3 v2_pos = float3(mesh.mvert[v2_index].co);
+    const float3 v0_pos = float3(mesh.mvert[mesh.mloop[v0_loop].v].co);
+    const float3 v1_pos = float3(mesh.mvert[mesh.mloop[v1_loop].v].co);
+    const float3 v2_pos = float3(mesh.mvert[mesh.mloop[v2_loop].v].co);
 
     float looptri_density_factor = 1.0f;
     if (!density_factors.is_empty()) {
@@ -129,35 +130,56 @@ static void sample_mesh_surface(const Mesh &mesh,
     }
     const float area = area_tri_v3(v0_pos, v1_pos, v2_pos);
 
-    const int looptri_seed = noise::hash(looptri_index, seed);
-    RandomNumberGenerator looptri_rng(looptri_seed);
-
-    const int point_amount = looptri_rng.round_probabilistic(area * base_density *
-                                                             looptri_density_factor);
+    rng.seed(noise::hash(looptri_index, seed));
+    return rng.round_probabilistic(area * base_density * looptri_density_factor);
+  };
 
-    for (int i = 0; i < point_amount; i++) {
-      const float3 bary_coord = looptri_rng.get_barycentric_coordinates();
-      float3 point_pos;
-      interp_v3_v3v3v3(point_pos, v0_pos, v1_pos, v2_pos, bary_coord);
-      r_positions.append(point_pos);
-      r_bary_coords.append(bary_coord);
-      r_looptri_indices.append(looptri_index);
+  Array<int> looptri_offsets(looptris.size() + 1);
+  threading::parallel_for(looptris.index_range(), 1024, [&](const IndexRange range) {
+    RandomNumberGenerator looptri_rng;
+    for (const int looptri_index : range) {
+      looptri_offsets[looptri_index] = sample_looptri_points_num(looptri_index, looptri_rng);
     }
+  });
+  int offset = 0;
+  for (const int looptri_index : looptris.index_range()) {
+    const int point_amount = looptri_offsets[looptri_index];
+    looptri_offsets[looptri_index] = offset;
+    offset += point_amount;
   }
-}
-
-BLI_NOINLINE static KDTree_3d *build_kdtree(Span<float3> positions)
-{
-  KDTree_3d *kdtree = BLI_kdtree_3d_new(positions.size());
-
-  int i_point = 0;
-  for (const float3 position : positions) {
-    BLI_kdtree_3d_insert(kdtree, i_point, position);
-    i_point++;
-  }
-
-  BLI_kdtree_3d_balance(kdtree);
-  return kdtree;
+  looptri_offsets.last() = offset;
+
+  const int64_t old_size = r_positions.size();
+  r_positions.resize(old_size + offset);
+  r_bary_coords.resize(old_size + offset);
+  r_looptri_indices.resize(old_size + offset);
+  MutableSpan<float3> positions = r_positions.as_mutable_span().drop_front(old_size);
+  MutableSpan<float3> bary_coords = r_bary_coords.as_mutable_span().drop_front(old_size);
+  MutableSpan<int> looptri_indices = r_looptri_indices.as_mutable_span().drop_front(old_size);
+
+  threading::parallel_for(looptris.index_range(), 1024, [&](const IndexRange range) {
+    RandomNumberGenerator looptri_rng;
+    for (const int looptri_index : range) {
+      const IndexRange points(looptri_offsets[looptri_index],
+                              looptri_offsets[looptri_index + 1] - looptri_offsets[looptri_index]);
+      if (points.is_empty()) {
+        continue;
+      }
+      /* Advance the generator in the same way as when counting the points. */
+      sample_looptri_points_num(looptri_index, looptri_rng);
+
+      const MLoopTri &looptri = looptris[looptri_index];
+      const float3 v0_pos = float3(mesh.mvert[mesh.mloop[looptri.tri[0]].v].co);
+      const float3 v1_pos = float3(mesh.mvert[mesh.mloop[looptri.tri[1]].v].co);
+      const float3 v2_pos = float3(mesh.mvert[mesh.mloop[looptri.tri[2]].v].co);
+      for (const int i : points) {
+        const float3 bary_coord = looptri_rng.get_barycentric_coordinates();
+        interp_v3_v3v3v3(positions[i], v0_pos, v1_pos, v2_pos, bary_coord);
+        bary_coords[i] = bary_coord;
+        looptri_indices[i] = looptri_index;
+      }
+    }
+  });
 }
 
 BLI_NOINLINE static void update_elimination_mask_for_close_points(
@@ -167,32 +189,20 @@ BLI_NOINLINE static void update_elimination_mask_for_close_points(
     return;
   }
 
-  KDTree_3d *kdtree = build_kdtree(positions);
-  BLI_SCOPED_DEFER([&]() { BLI_kdtree_3d_free(kdtree); });
-
-  for (const int i : positions.index_range()) {
-    if (elimination_mask[i]) {
-      continue;
+  /* Every point that is not eliminated yet eliminates all points within the minimum distance
+   * that come after it. That is the same as merging the eliminated points into the ones that are
+   * kept. */
+  Array<int> merge_map(positions.size(), -1);
+  geometry::find_duplicates_within_distance(
+      positions, IndexMask(positions.size()), minimum_distance, merge_map);
+
+  threading::parallel_for(positions.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      if (!ELEM(merge_map[i], -1, i)) {
+        elimination_mask[i] = true;
+      }
     }
-
-    struct CallbackData {
-      int index;
-      MutableSpan<bool> elimination_mask;
-    } callback_data = {i, elimination_mask};
-
-    BLI_kdtree_3d_range_search_cb(
-        kdtree,
-        positions[i],
-        minimum_distance,
-        [](void *user_data, int index, const float *UNUSED(co), float UNUSED(dist_sq)) {
-          CallbackData &callback_data = *static_cast<CallbackData *>(user_data);
-          if (index != callback_data.index) {
-            callback_data.elimination_mask[index] = true;
-          }
-          return true;
-        },
-        &callback_data);
-  }
+  });
 }
 
 BLI_NOINLINE static void update_elimination_mask_based_on_density_factors(
@@ -579,6 +589,7 @@ void register_node_type_geo_distribute_points_on_faces()
   node_type_size(&ntype, 170, 100, 320);
   ntype.declare = file_ns::node_declare;
   ntype.geometry_node_execute = file_ns::node_geo_exec;
+  ntype.geometry_node_execute_supports_caching = true;
   ntype.draw_buttons = file_ns::node_layout;
   nodeRegisterType(&ntype);
 }
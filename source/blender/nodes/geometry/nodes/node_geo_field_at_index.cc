@@ -107,16 +107,18 @@ class FieldAtIndex final : public GeometryFieldInput {
       using T = decltype(dummy);
       Array<T> dst_array(mask.min_array_size());
       VArray<T> src_values = values.typed<T>();
-      threading::parallel_for(mask.index_range(), 1024, [&](const IndexRange range) {
-        for (const int i : mask.slice(range)) {
-          const int index = indices[i];
-          if (index >= 0 && index < src_values.size()) {
-            dst_array[i] = src_values[index];
+      devirtualize_varray2(indices, src_values, [&](const auto indices, const auto src_values) {
+        threading::parallel_for(mask.index_range(), 1024, [&](const IndexRange range) {
+          for (const int i : mask.slice(range)) {
+            const int index = indices[i];
+            if (index >= 0 && index < src_values.size()) {
+              dst_array[i] = src_values[index];
+            }
+            else {
+              dst_array[i] = {};
+            }
           }
-          else {
-            dst_array[i] = {};
-          }
-        }
+        });
       });
       output_array = VArray<T>::ForContainer(std::move(dst_array));
     });
@@ -143,6 +143,7 @@ void register_node_type_geo_merge_by_distance()
                     node_copy_standard_storage);
   ntype.declare = file_ns::node_declare;
   ntype.geometry_node_execute = file_ns::node_geo_exec;
+  ntype.geometry_node_execute_supports_caching = true;
   ntype.draw_buttons = file_ns::node_layout;
   nodeRegisterType(&ntype);
 }
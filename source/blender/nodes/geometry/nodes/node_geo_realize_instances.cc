@@ -53,5 +53,6 @@ void register_node_type_geo_realize_instances()
   ntype.declare = file_ns::node_declare;
   ntype.draw_buttons_ex = file_ns::node_layout;
   ntype.geometry_node_execute = file_ns::node_geo_exec;
+  ntype.geometry_node_execute_supports_caching = true;
   nodeRegisterType(&ntype);
 }
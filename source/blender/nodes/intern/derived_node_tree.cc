@@ -11,19 +11,25 @@ DerivedNodeTree::DerivedNodeTree(bNodeTree &btree, NodeTreeRefMap &node_tree_ref
   /* Construct all possible contexts immediately. This is significantly cheaper than inlining all
    * node groups. If it still becomes a performance issue in the future, contexts could be
    * constructed lazily when they are needed. */
-  root_context_ = &this->construct_context_recursively(nullptr, nullptr, btree, node_tree_refs);
+  root_context_ = &this->construct_context_recursively(nullptr, nullptr, btree, &node_tree_refs);
+}
+
+DerivedNodeTree::DerivedNodeTree(bNodeTree &btree)
+{
+  root_context_ = &this->construct_context_recursively(nullptr, nullptr, btree, nullptr);
 }
 
 DTreeContext &DerivedNodeTree::construct_context_recursively(DTreeContext *parent_context,
                                                              const NodeRef *parent_node,
                                                              bNodeTree &btree,
-                                                             NodeTreeRefMap &node_tree_refs)
+                                                             NodeTreeRefMap *node_tree_refs)
 {
   DTreeContext &context = *allocator_.construct<DTreeContext>().release();
   context.parent_context_ = parent_context;
   context.parent_node_ = parent_node;
   context.derived_tree_ = this;
-  context.tree_ = &get_tree_ref_from_map(node_tree_refs, btree);
+  context.tree_ = node_tree_refs ? &get_tree_ref_from_map(*node_tree_refs, btree) :
+                                   &get_shared_tree_ref(btree, owned_tree_refs_);
   used_node_tree_refs_.add(context.tree_);
 
   for (const NodeRef *node : context.tree_->nodes()) {
@@ -9,6 +9,8 @@
 
 #include "FN_field_cpp_type.hh"
 
+#include "BLI_serialize.hh"
+
 #include "BLT_translation.h"
 
 #include <chrono>
@@ -29,6 +31,7 @@ ModifierLog::ModifierLog(GeoLogger &logger)
   LogByTreeContext log_by_tree_context;
 
   /* Combine all the local loggers that have been used by separate threads. */
+  int thread_index = 0;
   for (LocalGeoLogger &local_logger : logger) {
     /* Take ownership of the allocator. */
     logger_allocators_.append(std::move(local_logger.allocator_));
@@ -55,7 +58,10 @@ ModifierLog::ModifierLog(GeoLogger &logger)
     for (NodeWithExecutionTime &node_with_exec_time : local_logger.node_exec_times_) {
       NodeLog &node_log = this->lookup_or_add_node_log(log_by_tree_context,
                                                        node_with_exec_time.node);
-      node_log.exec_time_ = node_with_exec_time.exec_time;
+      /* Nodes that support laziness can be executed more than once. */
+      node_log.exec_time_ += node_with_exec_time.exec_time;
+      node_log.allocated_bytes_ += node_with_exec_time.allocated_bytes;
+      node_log.thread_index_ = thread_index;
     }
 
     for (NodeWithDebugMessage &debug_message : local_logger.node_debug_messages_) {
@@ -69,6 +75,7 @@ ModifierLog::ModifierLog(GeoLogger &logger)
                                                        node_with_attribute_name.node);
       node_log.used_named_attributes_.append(std::move(node_with_attribute_name.attribute));
     }
+    thread_index++;
   }
 }
 
@@ -121,6 +128,60 @@ void ModifierLog::foreach_node_log(FunctionRef<void(const NodeLog &)> fn) const
   }
 }
 
+void ModifierLog::write_profile_json(std::ostream &stream) const
+{
+  using namespace io::serialize;
+
+  struct ProfiledNode {
+    Vector<std::string> group_path;
+    std::string name;
+    const NodeLog *log;
+  };
+  Vector<ProfiledNode> profiled_nodes;
+  std::chrono::microseconds total_time{0};
+  if (root_tree_logs_) {
+    root_tree_logs_->foreach_node_log_with_path(
+        [&](const Span<std::string> group_path, const StringRef name, const NodeLog &node_log) {
+          if (node_log.thread_index() == -1) {
+            return;
+          }
+          profiled_nodes.append({group_path, name, &node_log});
+          total_time += node_log.execution_time();
+        });
+  }
+  std::sort(profiled_nodes.begin(),
+            profiled_nodes.end(),
+            [](const ProfiledNode &a, const ProfiledNode &b) {
+              return a.log->execution_time() > b.log->execution_time();
+            });
+
+  DictionaryValue root;
+  DictionaryValue::Items &root_items = root.elements();
+  root_items.append_as(std::pair("total_time_us", new IntValue(total_time.count())));
+  ArrayValue *nodes = new ArrayValue();
+  for (const ProfiledNode &profiled_node : profiled_nodes) {
+    DictionaryValue *node = new DictionaryValue();
+    DictionaryValue::Items &node_items = node->elements();
+    ArrayValue *group_path = new ArrayValue();
+    for (const std::string &group_name : profiled_node.group_path) {
+      group_path->elements().append_as(new StringValue(group_name));
+    }
+    node_items.append_as(std::pair("group_path", group_path));
+    node_items.append_as(std::pair("name", new StringValue(profiled_node.name)));
+    node_items.append_as(
+        std::pair("time_us", new IntValue(profiled_node.log->execution_time().count())));
+    node_items.append_as(
+        std::pair("allocated_bytes", new IntValue(profiled_node.log->allocated_bytes())));
+    node_items.append_as(std::pair("thread", new IntValue(profiled_node.log->thread_index())));
+    nodes->elements().append_as(node);
+  }
+  root_items.append_as(std::pair("nodes", nodes));
+
+  JsonFormatter formatter;
+  formatter.indentation_len = 2;
+  formatter.serialize(stream, root);
+}
+
 const GeometryValueLog *ModifierLog::input_geometry_log() const
 {
   return input_geometry_log_.get();
@@ -164,6 +225,30 @@ void TreeLog::foreach_node_log(FunctionRef<void(const NodeLog &)> fn) const
   }
 }
 
+void TreeLog::foreach_node_log_with_path(
+    FunctionRef<void(Span<std::string> group_path, StringRef node_name, const NodeLog &)> fn)
+    const
+{
+  Vector<std::string> group_path;
+  this->foreach_node_log_with_path(group_path, fn);
+}
+
+void TreeLog::foreach_node_log_with_path(
+    Vector<std::string> &group_path,
+    FunctionRef<void(Span<std::string> group_path, StringRef node_name, const NodeLog &)> fn)
+    const
+{
+  for (auto node_log : node_logs_.items()) {
+    fn(group_path, node_log.key, *node_log.value);
+  }
+
+  for (auto child : child_logs_.items()) {
+    group_path.append(child.key);
+    child.value->foreach_node_log_with_path(group_path, fn);
+    group_path.remove_last();
+  }
+}
+
 const SocketLog *NodeLog::lookup_socket_log(eNodeSocketInOut in_out, int index) const
 {
   BLI_assert(index >= 0);
@@ -488,9 +573,11 @@ void LocalGeoLogger::log_node_warning(DNode node, NodeWarningType type, std::str
   node_warnings_.append({node, {type, std::move(message)}});
 }
 
-void LocalGeoLogger::log_execution_time(DNode node, std::chrono::microseconds exec_time)
+void LocalGeoLogger::log_execution_time(DNode node,
+                                        std::chrono::microseconds exec_time,
+                                        const int64_t allocated_bytes)
 {
-  node_exec_times_.append({node, exec_time});
+  node_exec_times_.append({node, exec_time, allocated_bytes});
 }
 
 void LocalGeoLogger::log_used_named_attribute(DNode node,
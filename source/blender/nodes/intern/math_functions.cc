@@ -1,5 +1,9 @@
 /* SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <algorithm>
+
+#include "BLI_simd.h"
+
 #include "NOD_math_functions.hh"
 
 namespace blender::nodes {
@@ -204,4 +208,194 @@ const FloatMathOperationInfo *get_float3_math_operation_info(const int operation
   return nullptr;
 }
 
+#ifdef BLI_HAVE_SSE2
+
+/**
+ * Apply the operation to four floats at a time. The remaining elements are copied to padded
+ * buffers, so that no scalar version of the operation is needed.
+ */
+template<__m128 (*SimdFn)(__m128 a, __m128 b)>
+BLI_NOINLINE static void execute_float_simd(const float *a,
+                                            const float *b,
+                                            float *r_result,
+                                            const int64_t size)
+{
+  int64_t i = 0;
+  for (; i + 4 <= size; i += 4) {
+    _mm_storeu_ps(r_result + i, SimdFn(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+  }
+  const int64_t tail_size = size - i;
+  if (tail_size > 0) {
+    float a_tail[4] = {0.0f}, b_tail[4] = {0.0f}, result_tail[4];
+    std::copy_n(a + i, tail_size, a_tail);
+    std::copy_n(b + i, tail_size, b_tail);
+    _mm_storeu_ps(result_tail, SimdFn(_mm_loadu_ps(a_tail), _mm_loadu_ps(b_tail)));
+    std::copy_n(result_tail, tail_size, r_result + i);
+  }
+}
+
+template<__m128 (*SimdFn)(__m128 a, __m128 b)>
+static void float_span_fn(Span<float> a, Span<float> b, MutableSpan<float> r_result)
+{
+  execute_float_simd<SimdFn>(a.data(), b.data(), r_result.data(), r_result.size());
+}
+
+/** The vectorized #float3 operations are per component, so vectors are processed as floats. */
+template<__m128 (*SimdFn)(__m128 a, __m128 b)>
+static void float3_span_fn(Span<float3> a, Span<float3> b, MutableSpan<float3> r_result)
+{
+  execute_float_simd<SimdFn>(reinterpret_cast<const float *>(a.data()),
+                             reinterpret_cast<const float *>(b.data()),
+                             reinterpret_cast<float *>(r_result.data()),
+                             r_result.size() * 3);
+}
+
+static __m128 add_simd(const __m128 a, const __m128 b)
+{
+  return _mm_add_ps(a, b);
+}
+
+static __m128 subtract_simd(const __m128 a, const __m128 b)
+{
+  return _mm_sub_ps(a, b);
+}
+
+static __m128 multiply_simd(const __m128 a, const __m128 b)
+{
+  return _mm_mul_ps(a, b);
+}
+
+/** Same as #safe_divide, zero when the divisor is zero. */
+static __m128 safe_divide_simd(const __m128 a, const __m128 b)
+{
+  const __m128 is_nonzero = _mm_cmpneq_ps(b, _mm_setzero_ps());
+  return _mm_and_ps(is_nonzero, _mm_div_ps(a, b));
+}
+
+/**
+ * The operand order of the minimum and maximum functions matters for NaN. `_mm_min_ps(a, b)` is
+ * `a < b ? a : b`, while `std::min(a, b)` is `b < a ? b : a`.
+ */
+static __m128 std_min_simd(const __m128 a, const __m128 b)
+{
+  return _mm_min_ps(b, a);
+}
+
+static __m128 std_max_simd(const __m128 a, const __m128 b)
+{
+  return _mm_max_ps(b, a);
+}
+
+static __m128 min_simd(const __m128 a, const __m128 b)
+{
+  return _mm_min_ps(a, b);
+}
+
+static __m128 max_simd(const __m128 a, const __m128 b)
+{
+  return _mm_max_ps(a, b);
+}
+
+#endif
+
+FloatSpanMathFunction get_float_math_fl_fl_to_fl_span_function(const int operation)
+{
+#ifdef BLI_HAVE_SSE2
+  switch (operation) {
+    case NODE_MATH_ADD:
+      return float_span_fn<add_simd>;
+    case NODE_MATH_SUBTRACT:
+      return float_span_fn<subtract_simd>;
+    case NODE_MATH_MULTIPLY:
+      return float_span_fn<multiply_simd>;
+    case NODE_MATH_DIVIDE:
+      return float_span_fn<safe_divide_simd>;
+    case NODE_MATH_MINIMUM:
+      return float_span_fn<std_min_simd>;
+    case NODE_MATH_MAXIMUM:
+      return float_span_fn<std_max_simd>;
+  }
+#else
+  UNUSED_VARS(operation);
+#endif
+  return nullptr;
+}
+
+Float3SpanMathFunction get_float3_math_fl3_fl3_to_fl3_span_function(const int operation)
+{
+#ifdef BLI_HAVE_SSE2
+  switch (operation) {
+    case NODE_VECTOR_MATH_ADD:
+      return float3_span_fn<add_simd>;
+    case NODE_VECTOR_MATH_SUBTRACT:
+      return float3_span_fn<subtract_simd>;
+    case NODE_VECTOR_MATH_MULTIPLY:
+      return float3_span_fn<multiply_simd>;
+    case NODE_VECTOR_MATH_DIVIDE:
+      return float3_span_fn<safe_divide_simd>;
+    case NODE_VECTOR_MATH_MINIMUM:
+      return float3_span_fn<min_simd>;
+    case NODE_VECTOR_MATH_MAXIMUM:
+      return float3_span_fn<max_simd>;
+  }
+#else
+  UNUSED_VARS(operation);
+#endif
+  return nullptr;
+}
+
+void map_range_linear_span(const Span<float> values,
+                           const float from_min,
+                           const float from_max,
+                           const float to_min,
+                           const float to_max,
+                           const bool clamp,
+                           MutableSpan<float> r_results)
+{
+  const float from_range = from_max - from_min;
+  const float to_range = to_max - to_min;
+  /* Same as the order of the arguments of `std::clamp` in #clamp_range. */
+  const float clamp_min = (to_min > to_max) ? to_max : to_min;
+  const float clamp_max = (to_min > to_max) ? to_min : to_max;
+
+  if (from_range == 0.0f) {
+    /* The factor computed with #safe_divide is always zero. */
+    float result = to_min + 0.0f * to_range;
+    if (clamp) {
+      result = std::clamp(result, clamp_min, clamp_max);
+    }
+    r_results.fill(result);
+    return;
+  }
+
+  const int64_t size = values.size();
+  int64_t i = 0;
+#ifdef BLI_HAVE_SSE2
+  const __m128 from_min_v = _mm_set1_ps(from_min);
+  const __m128 from_range_v = _mm_set1_ps(from_range);
+  const __m128 to_min_v = _mm_set1_ps(to_min);
+  const __m128 to_range_v = _mm_set1_ps(to_range);
+  const __m128 clamp_min_v = _mm_set1_ps(clamp_min);
+  const __m128 clamp_max_v = _mm_set1_ps(clamp_max);
+  for (; i + 4 <= size; i += 4) {
+    const __m128 factor = _mm_div_ps(_mm_sub_ps(_mm_loadu_ps(&values[i]), from_min_v),
+                                     from_range_v);
+    __m128 result = _mm_add_ps(to_min_v, _mm_mul_ps(factor, to_range_v));
+    if (clamp) {
+      /* The operand order gives the same result as `std::clamp`, also for NaN. */
+      result = _mm_min_ps(clamp_max_v, _mm_max_ps(clamp_min_v, result));
+    }
+    _mm_storeu_ps(&r_results[i], result);
+  }
+#endif
+  for (; i < size; i++) {
+    const float factor = (values[i] - from_min) / from_range;
+    float result = to_min + factor * to_range;
+    if (clamp) {
+      result = std::clamp(result, clamp_min, clamp_max);
+    }
+    r_results[i] = result;
+  }
+}
+
 }  // namespace blender::nodes
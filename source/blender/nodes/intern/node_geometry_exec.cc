@@ -16,6 +16,9 @@ namespace blender::nodes {
 
 void GeoNodeExecParams::error_message_add(const NodeWarningType type, std::string message) const
 {
+  if (provider_->report != nullptr) {
+    provider_->report->warnings.append({type, message});
+  }
   if (provider_->logger == nullptr) {
     return;
   }
@@ -26,6 +29,9 @@ void GeoNodeExecParams::error_message_add(const NodeWarningType type, std::strin
 void GeoNodeExecParams::used_named_attribute(std::string attribute_name,
                                              const NamedAttributeUsage usage)
 {
+  if (provider_->report != nullptr) {
+    provider_->report->used_named_attributes.append({attribute_name, usage});
+  }
   if (provider_->logger == nullptr) {
     return;
   }
@@ -9,6 +9,8 @@
 
 #include "RNA_prototypes.h"
 
+#include "DEG_depsgraph_query.h"
+
 namespace blender::nodes {
 
 NodeTreeRef::NodeTreeRef(bNodeTree *btree) : btree_(btree)
@@ -664,4 +666,18 @@ const NodeTreeRef &get_tree_ref_from_map(NodeTreeRefMap &node_tree_refs, bNodeTr
                                           [&]() { return std::make_unique<NodeTreeRef>(&btree); });
 }
 
+const NodeTreeRef &get_shared_tree_ref(bNodeTree &btree, NodeTreeRefMap &owned_tree_refs)
+{
+  if (!DEG_is_evaluated_id(&btree.id)) {
+    return get_tree_ref_from_map(owned_tree_refs, btree);
+  }
+  /* The tree ref is only built once for all users, so a single lock for all trees is enough. */
+  static std::mutex mutex;
+  std::lock_guard lock{mutex};
+  if (btree.shared_tree_ref == nullptr) {
+    btree.shared_tree_ref = new NodeTreeRef(&btree);
+  }
+  return *btree.shared_tree_ref;
+}
+
 }  // namespace blender::nodes
@@ -11,6 +11,7 @@
 
 #include "BLI_math_base_safe.h"
 
+#include "NOD_math_functions.hh"
 #include "NOD_socket_search_link.hh"
 
 #include "UI_interface.h"
@@ -424,6 +425,20 @@ class MapRangeFunction : public fn::MultiFunction {
     const VArray<float> &to_max = params.readonly_single_input<float>(4, "To Max");
     MutableSpan<float> results = params.uninitialized_single_output<float>(5, "Result");
 
+    if (mask.is_range() && values.is_span() && from_min.is_single() && from_max.is_single() &&
+        to_min.is_single() && to_max.is_single()) {
+      /* Common case of mapping a field with constant ranges, which can be vectorized. */
+      const IndexRange range = mask.as_range();
+      map_range_linear_span(values.get_internal_span().slice(range),
+                            from_min.get_internal_single(),
+                            from_max.get_internal_single(),
+                            to_min.get_internal_single(),
+                            to_max.get_internal_single(),
+                            clamp_,
+                            results.slice(range));
+      return;
+    }
+
     for (int64_t i : mask) {
       float factor = safe_divide(values[i] - from_min[i], from_max[i] - from_min[i]);
       results[i] = to_min[i] + factor * (to_max[i] - to_min[i]);
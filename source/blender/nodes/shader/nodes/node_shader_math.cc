@@ -117,7 +117,9 @@ static const fn::MultiFunction *get_base_multi_function(bNode &node)
   try_dispatch_float_math_fl_fl_to_fl(mode,
                                       [&](auto function, const FloatMathOperationInfo &info) {
                                         static fn::CustomMF_SI_SI_SO<float, float, float> fn{
-                                            info.title_case_name.c_str(), function};
+                                            info.title_case_name.c_str(),
+                                            function,
+                                            get_float_math_fl_fl_to_fl_span_function(mode)};
                                         base_fn = &fn;
                                       });
   if (base_fn != nullptr) {
@@ -234,7 +234,10 @@ static const fn::MultiFunction *get_multi_function(bNode &node)
   try_dispatch_float_math_fl3_fl3_to_fl3(operation,
                                          [&](auto function, const FloatMathOperationInfo &info) {
                                            static fn::CustomMF_SI_SI_SO<float3, float3, float3> fn{
-                                               info.title_case_name.c_str(), function};
+                                               info.title_case_name.c_str(),
+                                               function,
+                                               get_float3_math_fl3_fl3_to_fl3_span_function(
+                                                   operation)};
                                            multi_fn = &fn;
                                          });
   if (multi_fn != nullptr) {
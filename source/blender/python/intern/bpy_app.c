@@ -29,14 +29,19 @@
 
 /* modules */
 #include "bpy_app_icons.h"
+#include "bpy_app_profiler.h"
 #include "bpy_app_timers.h"
 
+#include "MEM_guardedalloc.h"
+
 #include "BLI_utildefines.h"
 
 #include "BKE_appdir.h"
 #include "BKE_blender_version.h"
 #include "BKE_global.h"
 
+#include "BLO_io_stats.h"
+
 #include "DNA_ID.h"
 
 #include "UI_interface_icons.h"
@@ -112,6 +117,7 @@ static PyStructSequence_Field app_info_fields[] = {
     /* Modules (not struct sequence). */
     {"icons", "Manage custom icons"},
     {"timers", "Manage timers"},
+    {"profiler", "Measure the Python code called by Blender"},
     {NULL},
 };
 
@@ -198,6 +204,7 @@ static PyObject *make_app_info(void)
   /* modules */
   SetObjItem(BPY_app_icons_module());
   SetObjItem(BPY_app_timers_module());
+  SetObjItem(BPY_app_profiler_module());
 
 #undef SetIntItem
 #undef SetStrItem
@@ -314,6 +321,34 @@ static PyObject *bpy_app_tempdir_get(PyObject *UNUSED(self), void *UNUSED(closur
   return PyC_UnicodeFromByte(BKE_tempdir_session());
 }
 
+PyDoc_STRVAR(bpy_app_io_stats_doc,
+             "String, JSON with the statistics collected for the last blend file read and write "
+             "when :data:`bpy.app.debug_io_stats` is enabled, None otherwise (read-only)");
+static PyObject *bpy_app_io_stats_get(PyObject *UNUSED(self), void *UNUSED(closure))
+{
+  char *json = BLO_io_stats_as_json();
+  if (json == NULL) {
+    Py_RETURN_NONE;
+  }
+  PyObject *ret = PyUnicode_FromString(json);
+  MEM_freeN(json);
+  return ret;
+}
+
+PyDoc_STRVAR(bpy_app_memory_usage_by_tag_doc,
+             "Dictionary with the memory in use in bytes per subsystem, memory not attributed to "
+             "any subsystem is listed as 'Other' (read-only)");
+static PyObject *bpy_app_memory_usage_by_tag_get(PyObject *UNUSED(self), void *UNUSED(closure))
+{
+  PyObject *ret = PyDict_New();
+  for (int tag = 0; tag < MEM_TAG_NUM; tag++) {
+    PyObject *value = PyLong_FromSize_t(MEM_get_memory_in_use_by_tag((eMEMTag)tag));
+    PyDict_SetItemString(ret, MEM_tag_name((eMEMTag)tag), value);
+    Py_DECREF(value);
+  }
+  return ret;
+}
+
 PyDoc_STRVAR(
     bpy_app_driver_dict_doc,
     "Dictionary for drivers namespace, editable in-place, reset on file load (read-only)");
@@ -399,12 +434,22 @@ static PyGetSetDef bpy_app_getsets[] = {
      bpy_app_debug_set,
      bpy_app_debug_doc,
      (void *)G_DEBUG_DEPSGRAPH_PRETTY},
+    {"debug_depsgraph_trace",
+     bpy_app_debug_get,
+     bpy_app_debug_set,
+     bpy_app_debug_doc,
+     (void *)G_DEBUG_DEPSGRAPH_TRACE},
     {"debug_simdata",
      bpy_app_debug_get,
      bpy_app_debug_set,
      bpy_app_debug_doc,
      (void *)G_DEBUG_SIMDATA},
     {"debug_io", bpy_app_debug_get, bpy_app_debug_set, bpy_app_debug_doc, (void *)G_DEBUG_IO},
+    {"debug_io_stats",
+     bpy_app_debug_get,
+     bpy_app_debug_set,
+     bpy_app_debug_doc,
+     (void *)G_DEBUG_IO_STATS},
 
     {"use_event_simulate",
      bpy_app_global_flag_get,
@@ -424,6 +469,12 @@ static PyGetSetDef bpy_app_getsets[] = {
      bpy_app_debug_value_doc,
      NULL},
     {"tempdir", bpy_app_tempdir_get, NULL, bpy_app_tempdir_doc, NULL},
+    {"io_stats", bpy_app_io_stats_get, NULL, bpy_app_io_stats_doc, NULL},
+    {"memory_usage_by_tag",
+     bpy_app_memory_usage_by_tag_get,
+     NULL,
+     bpy_app_memory_usage_by_tag_doc,
+     NULL},
     {"driver_namespace", bpy_app_driver_dict_get, NULL, bpy_app_driver_dict_doc, NULL},
 
     {"render_icon_size",
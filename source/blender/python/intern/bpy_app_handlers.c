@@ -16,6 +16,7 @@
 #include "RNA_access.h"
 #include "RNA_types.h"
 #include "bpy_app_handlers.h"
+#include "bpy_app_profiler.h"
 #include "bpy_rna.h"
 
 #include "../generic/python_utildefines.h"
@@ -339,7 +340,10 @@ void bpy_app_generic_callback(struct Main *UNUSED(main),
     for (pos = 0; pos < PyList_GET_SIZE(cb_list); pos++) {
       func = PyList_GET_ITEM(cb_list, pos);
       PyObject *args = choose_arguments(func, args_all, args_single);
+      const double profile_time = bpy_app_profiler_begin();
       ret = PyObject_Call(func, args, NULL);
+      bpy_app_profiler_end_callable(
+          profile_time, app_cb_info_fields[POINTER_AS_INT(arg)].name, func);
       if (ret == NULL) {
         /* Don't set last system variables because they might cause some
          * dangling pointers to external render engines (when exception
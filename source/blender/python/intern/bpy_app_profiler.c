@@ -0,0 +1,261 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup pythonintern
+ *
+ * Cumulative time and call counts of the Python code Blender calls into: app handlers, timers,
+ * draw callbacks, methods of registered classes (operators, panels, menus...) and driver
+ * expressions. Unlike `cProfile` this only measures the entry points, so the cost of an add-on
+ * shows up under the handler or operator responsible for it.
+ *
+ * Disabled by default, in that case every call site only checks a boolean.
+ */
+
+#include "BLI_utildefines.h"
+#include "PIL_time.h"
+#include <Python.h>
+
+#include "bpy_app_profiler.h"
+
+#include "../generic/python_utildefines.h"
+
+static bool profiler_enabled = false;
+/** Maps `"category: name"` strings to `[calls, seconds]` lists. */
+static PyObject *profiler_stats = NULL;
+
+double bpy_app_profiler_begin(void)
+{
+  return profiler_enabled ? PIL_check_seconds_timer() : 0.0;
+}
+
+static void profiler_stats_add(PyObject *key, const double time_begin)
+{
+  const double duration = PIL_check_seconds_timer() - time_begin;
+
+  if (profiler_stats == NULL) {
+    profiler_stats = PyDict_New();
+  }
+  PyObject *item = PyDict_GetItem(profiler_stats, key);
+  if (item == NULL) {
+    item = PyList_New(2);
+    PyList_SET_ITEM(item, 0, PyLong_FromLong(0));
+    PyList_SET_ITEM(item, 1, PyFloat_FromDouble(0.0));
+    PyDict_SetItem(profiler_stats, key, item);
+    Py_DECREF(item);
+  }
+  const long calls = PyLong_AsLong(PyList_GET_ITEM(item, 0));
+  const double seconds = PyFloat_AsDouble(PyList_GET_ITEM(item, 1));
+  PyList_SetItem(item, 0, PyLong_FromLong(calls + 1));
+  PyList_SetItem(item, 1, PyFloat_FromDouble(seconds + duration));
+}
+
+void bpy_app_profiler_end_callable(const double time_begin,
+                                   const char *category,
+                                   PyObject *callable)
+{
+  if (time_begin == 0.0) {
+    return;
+  }
+  /* The call may have left an exception set, which is reported by the caller afterwards. */
+  PyObject *error_type, *error_value, *error_traceback;
+  PyErr_Fetch(&error_type, &error_value, &error_traceback);
+
+  PyObject *module = PyObject_GetAttrString(callable, "__module__");
+  PyObject *qualname = PyObject_GetAttrString(callable, "__qualname__");
+  PyObject *key;
+  if (module && qualname && PyUnicode_Check(module) && PyUnicode_Check(qualname)) {
+    key = PyUnicode_FromFormat("%s: %U.%U", category, module, qualname);
+  }
+  else {
+    PyErr_Clear();
+    key = PyUnicode_FromFormat("%s: %R", category, callable);
+  }
+  Py_XDECREF(module);
+  Py_XDECREF(qualname);
+
+  if (key) {
+    profiler_stats_add(key, time_begin);
+    Py_DECREF(key);
+  }
+  PyErr_Clear();
+  PyErr_Restore(error_type, error_value, error_traceback);
+}
+
+void bpy_app_profiler_end_name(const double time_begin, const char *category, const char *name)
+{
+  if (time_begin == 0.0) {
+    return;
+  }
+  PyObject *error_type, *error_value, *error_traceback;
+  PyErr_Fetch(&error_type, &error_value, &error_traceback);
+
+  PyObject *key = PyUnicode_FromFormat("%s: %s", category, name);
+  if (key) {
+    profiler_stats_add(key, time_begin);
+    Py_DECREF(key);
+  }
+  PyErr_Clear();
+  PyErr_Restore(error_type, error_value, error_traceback);
+}
+
+PyDoc_STRVAR(bpy_app_profiler_enable_doc,
+             ".. function:: enable()\n"
+             "\n"
+             "   Start measuring the Python code called by Blender, adding to existing results.\n");
+static PyObject *bpy_app_profiler_enable(PyObject *UNUSED(self))
+{
+  profiler_enabled = true;
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(bpy_app_profiler_disable_doc,
+             ".. function:: disable()\n"
+             "\n"
+             "   Stop measuring, results are kept until :func:`clear` is called.\n");
+static PyObject *bpy_app_profiler_disable(PyObject *UNUSED(self))
+{
+  profiler_enabled = false;
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(bpy_app_profiler_is_enabled_doc,
+             ".. function:: is_enabled()\n"
+             "\n"
+             "   :return: True while the profiler is measuring.\n"
+             "   :rtype: bool\n");
+static PyObject *bpy_app_profiler_is_enabled(PyObject *UNUSED(self))
+{
+  return PyBool_FromLong(profiler_enabled);
+}
+
+PyDoc_STRVAR(bpy_app_profiler_clear_doc,
+             ".. function:: clear()\n"
+             "\n"
+             "   Remove all results.\n");
+static PyObject *bpy_app_profiler_clear(PyObject *UNUSED(self))
+{
+  Py_CLEAR(profiler_stats);
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(bpy_app_profiler_results_doc,
+             ".. function:: results()\n"
+             "\n"
+             "   :return: Call count and total time in seconds of every measured callable, keyed "
+             "by ``\"category: name\"``, where the category is the handler type, ``timer``, "
+             "``draw_handler``, ``class`` or ``driver``.\n"
+             "   :rtype: dict of (int, float) tuples\n");
+static PyObject *bpy_app_profiler_results(PyObject *UNUSED(self))
+{
+  PyObject *ret = PyDict_New();
+  if (profiler_stats == NULL) {
+    return ret;
+  }
+  PyObject *key, *value;
+  Py_ssize_t pos = 0;
+  while (PyDict_Next(profiler_stats, &pos, &key, &value)) {
+    PyObject *item = PyList_AsTuple(value);
+    PyDict_SetItem(ret, key, item);
+    Py_DECREF(item);
+  }
+  return ret;
+}
+
+PyDoc_STRVAR(bpy_app_profiler_print_doc,
+             ".. function:: print(limit=20)\n"
+             "\n"
+             "   Print the results with the highest total time to the console.\n"
+             "\n"
+             "   :arg limit: Maximum number of results to print, zero for all.\n"
+             "   :type limit: int\n");
+static PyObject *bpy_app_profiler_print(PyObject *UNUSED(self), PyObject *args, PyObject *kw)
+{
+  int limit = 20;
+  static const char *_keywords[] = {"limit", NULL};
+  static _PyArg_Parser _parser = {
+      "|$" /* Optional keyword only arguments. */
+      "i"  /* `limit` */
+      ":print",
+      _keywords,
+      0,
+  };
+  if (!_PyArg_ParseTupleAndKeywordsFast(args, kw, &_parser, &limit)) {
+    return NULL;
+  }
+
+  /* Sort `(seconds, calls, name)` tuples, slowest first. */
+  PyObject *rows = PyList_New(0);
+  if (profiler_stats != NULL) {
+    PyObject *key, *value;
+    Py_ssize_t pos = 0;
+    while (PyDict_Next(profiler_stats, &pos, &key, &value)) {
+      PyObject *row = PyTuple_New(3);
+      PyTuple_SET_ITEMS(row,
+                        Py_INCREF_RET(PyList_GET_ITEM(value, 1)),
+                        Py_INCREF_RET(PyList_GET_ITEM(value, 0)),
+                        Py_INCREF_RET(key));
+      PyList_Append(rows, row);
+      Py_DECREF(row);
+    }
+  }
+  PyList_Sort(rows);
+  PyList_Reverse(rows);
+
+  const Py_ssize_t rows_num = PyList_GET_SIZE(rows);
+  const Py_ssize_t print_num = (limit > 0) ? MIN2(rows_num, limit) : rows_num;
+  printf("%12s %10s %14s  %s\n", "Total (ms)", "Calls", "Per Call (ms)", "Name");
+  for (Py_ssize_t i = 0; i < print_num; i++) {
+    PyObject *row = PyList_GET_ITEM(rows, i);
+    const double seconds = PyFloat_AsDouble(PyTuple_GET_ITEM(row, 0));
+    const long calls = PyLong_AsLong(PyTuple_GET_ITEM(row, 1));
+    printf("%12.3f %10ld %14.4f  %s\n",
+           seconds * 1000.0,
+           calls,
+           seconds * 1000.0 / (double)MAX2(calls, 1),
+           PyUnicode_AsUTF8(PyTuple_GET_ITEM(row, 2)));
+  }
+  Py_DECREF(rows);
+  Py_RETURN_NONE;
+}
+
+static struct PyMethodDef M_AppProfiler_methods[] = {
+    {"enable", (PyCFunction)bpy_app_profiler_enable, METH_NOARGS, bpy_app_profiler_enable_doc},
+    {"disable", (PyCFunction)bpy_app_profiler_disable, METH_NOARGS, bpy_app_profiler_disable_doc},
+    {"is_enabled",
+     (PyCFunction)bpy_app_profiler_is_enabled,
+     METH_NOARGS,
+     bpy_app_profiler_is_enabled_doc},
+    {"clear", (PyCFunction)bpy_app_profiler_clear, METH_NOARGS, bpy_app_profiler_clear_doc},
+    {"results", (PyCFunction)bpy_app_profiler_results, METH_NOARGS, bpy_app_profiler_results_doc},
+    {"print",
+     (PyCFunction)bpy_app_profiler_print,
+     METH_VARARGS | METH_KEYWORDS,
+     bpy_app_profiler_print_doc},
+    {NULL, NULL, 0, NULL},
+};
+
+static void bpy_app_profiler_free(void *UNUSED(module))
+{
+  profiler_enabled = false;
+  Py_CLEAR(profiler_stats);
+}
+
+static struct PyModuleDef M_AppProfiler_module_def = {
+    PyModuleDef_HEAD_INIT,
+    "bpy.app.profiler",    /* m_name */
+    NULL,                  /* m_doc */
+    0,                     /* m_size */
+    M_AppProfiler_methods, /* m_methods */
+    NULL,                  /* m_reload */
+    NULL,                  /* m_traverse */
+    NULL,                  /* m_clear */
+    bpy_app_profiler_free, /* m_free */
+};
+
+PyObject *BPY_app_profiler_module(void)
+{
+  PyObject *sys_modules = PyImport_GetModuleDict();
+  PyObject *mod = PyModule_Create(&M_AppProfiler_module_def);
+  PyDict_SetItem(sys_modules, PyModule_GetNameObject(mod), mod);
+  return mod;
+}
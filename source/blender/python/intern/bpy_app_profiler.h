@@ -0,0 +1,32 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup pythonintern
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Start timing a call into Python, returns zero when profiling is disabled,
+ * which makes the matching `bpy_app_profiler_end_*` call a no-op.
+ */
+double bpy_app_profiler_begin(void);
+/**
+ * Add the time since \a time_begin to the totals of \a callable,
+ * identified by its module and qualified name. The GIL must be held.
+ */
+void bpy_app_profiler_end_callable(double time_begin, const char *category, PyObject *callable);
+/**
+ * Add the time since \a time_begin to the totals of \a name. The GIL must be held.
+ */
+void bpy_app_profiler_end_name(double time_begin, const char *category, const char *name);
+
+PyObject *BPY_app_profiler_module(void);
+
+#ifdef __cplusplus
+}
+#endif
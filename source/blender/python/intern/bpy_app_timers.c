@@ -10,6 +10,7 @@
 #include <Python.h>
 
 #include "BPY_extern.h"
+#include "bpy_app_profiler.h"
 #include "bpy_app_timers.h"
 
 #include "../generic/py_capi_utils.h"
@@ -50,7 +51,9 @@ static double py_timer_execute(uintptr_t UNUSED(uuid), void *user_data)
   PyGILState_STATE gilstate;
   gilstate = PyGILState_Ensure();
 
+  const double profile_time = bpy_app_profiler_begin();
   PyObject *py_ret = PyObject_CallObject(function, NULL);
+  bpy_app_profiler_end_callable(profile_time, "timer", function);
   const double ret = handle_returned_value(function, py_ret);
 
   PyGILState_Release(gilstate);
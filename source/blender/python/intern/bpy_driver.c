@@ -26,6 +26,7 @@
 
 #include "bpy_rna_driver.h" /* For #pyrna_driver_get_variable_value. */
 
+#include "bpy_app_profiler.h"
 #include "bpy_intern_string.h"
 
 #include "bpy_driver.h"
@@ -621,7 +622,9 @@ float BPY_driver_exec(struct PathResolvedRNA *anim_rna,
 #else
   /* Evaluate the compiled expression. */
   if (expr_code) {
+    const double profile_time = bpy_app_profiler_begin();
     retval = PyEval_EvalCode((void *)expr_code, bpy_pydriver_Dict, driver_vars);
+    bpy_app_profiler_end_name(profile_time, "driver", expr);
   }
 #endif
 
@@ -27,6 +27,7 @@
 #include "BPY_extern.h"
 #include "BPY_extern_clog.h"
 
+#include "bpy_app_profiler.h"
 #include "bpy_capi_utils.h"
 #include "bpy_intern_string.h"
 #include "bpy_props.h"
@@ -5198,6 +5199,52 @@ static bool foreach_compat_buffer(RawPropertyType raw_type, int attr_signed, con
   return 0;
 }
 
+/**
+ * Raw type of a buffer that doesn't match the attribute's type but holds the same kind of numbers
+ * (integer or floating point), so RNA can convert the values directly instead of going through a
+ * Python object per value.
+ */
+static RawPropertyType foreach_convert_buffer_raw_type(RawPropertyType raw_type,
+                                                       const Py_buffer *buf,
+                                                       const int tot)
+{
+  const char f = buf->format ? *buf->format : 'B'; /* B is assumed when not set */
+  RawPropertyType buf_raw_type;
+
+  switch (f) {
+    case 'b':
+      buf_raw_type = PROP_RAW_CHAR;
+      break;
+    case 'h':
+      buf_raw_type = PROP_RAW_SHORT;
+      break;
+    case 'i':
+      buf_raw_type = PROP_RAW_INT;
+      break;
+    case 'f':
+      buf_raw_type = PROP_RAW_FLOAT;
+      break;
+    case 'd':
+      buf_raw_type = PROP_RAW_DOUBLE;
+      break;
+    default:
+      return PROP_RAW_UNSET;
+  }
+
+  if (ELEM(raw_type, PROP_RAW_BOOLEAN, PROP_RAW_UNSET)) {
+    return PROP_RAW_UNSET;
+  }
+  if (ELEM(raw_type, PROP_RAW_FLOAT, PROP_RAW_DOUBLE) !=
+      ELEM(buf_raw_type, PROP_RAW_FLOAT, PROP_RAW_DOUBLE)) {
+    return PROP_RAW_UNSET;
+  }
+  if (buf->itemsize != RNA_raw_type_sizeof(buf_raw_type) ||
+      buf->len != (Py_ssize_t)tot * buf->itemsize) {
+    return PROP_RAW_UNSET;
+  }
+  return buf_raw_type;
+}
+
 static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
 {
   PyObject *item = NULL;
@@ -5235,6 +5282,14 @@ static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
         ok = RNA_property_collection_raw_set(
             NULL, &self->ptr, self->prop, attr, buf.buf, raw_type, tot);
       }
+      else {
+        const RawPropertyType buf_raw_type = foreach_convert_buffer_raw_type(raw_type, &buf, tot);
+        if (buf_raw_type != PROP_RAW_UNSET) {
+          buffer_is_compat = true;
+          ok = RNA_property_collection_raw_set(
+              NULL, &self->ptr, self->prop, attr, buf.buf, buf_raw_type, tot);
+        }
+      }
 
       PyBuffer_Release(&buf);
     }
@@ -5291,6 +5346,14 @@ static PyObject *foreach_getset(BPy_PropertyRNA *self, PyObject *args, int set)
         ok = RNA_property_collection_raw_get(
             NULL, &self->ptr, self->prop, attr, buf.buf, raw_type, tot);
       }
+      else {
+        const RawPropertyType buf_raw_type = foreach_convert_buffer_raw_type(raw_type, &buf, tot);
+        if (buf_raw_type != PROP_RAW_UNSET) {
+          buffer_is_compat = true;
+          ok = RNA_property_collection_raw_get(
+              NULL, &self->ptr, self->prop, attr, buf.buf, buf_raw_type, tot);
+        }
+      }
 
       PyBuffer_Release(&buf);
     }
@@ -5382,6 +5445,248 @@ static PyObject *pyrna_prop_collection_foreach_set(BPy_PropertyRNA *self, PyObje
   return foreach_getset(self, args, 1);
 }
 
+/**
+ * An attribute of all items of a collection, exposed through the buffer protocol without copying.
+ * The array is looked up again for every exported buffer.
+ */
+typedef struct BPy_PropertyCollectionBuffer {
+  PyObject_HEAD /* Required Python macro. */
+  BPy_PropertyRNA *collection;
+  char attr[64];
+} BPy_PropertyCollectionBuffer;
+
+/** Stored in #Py_buffer.internal while a buffer is exported. */
+typedef struct PropertyCollectionBufferExport {
+  Py_ssize_t shape[2];
+  Py_ssize_t strides[2];
+  PointerRNA itemptr;
+  PropertyRNA *itemprop;
+} PropertyCollectionBufferExport;
+
+static const char *pyrna_raw_type_buffer_format(const RawPropertyType raw_type,
+                                                const bool attr_signed)
+{
+  switch (raw_type) {
+    case PROP_RAW_CHAR:
+      return attr_signed ? "b" : "B";
+    case PROP_RAW_SHORT:
+      return attr_signed ? "h" : "H";
+    case PROP_RAW_INT:
+      return attr_signed ? "i" : "I";
+    case PROP_RAW_BOOLEAN:
+      return "?";
+    case PROP_RAW_FLOAT:
+      return "f";
+    case PROP_RAW_DOUBLE:
+      return "d";
+    case PROP_RAW_UNSET:
+      break;
+  }
+  return NULL;
+}
+
+static int pyrna_prop_collection_buffer_get(BPy_PropertyCollectionBuffer *self,
+                                            Py_buffer *view,
+                                            int flags)
+{
+  BPy_PropertyRNA *collection = self->collection;
+  PYRNA_PROP_CHECK_INT(collection);
+
+  PointerRNA itemptr = PointerRNA_NULL;
+  PropertyRNA *itemprop = NULL;
+  RNA_PROP_BEGIN (&collection->ptr, itemptr_iter, collection->prop) {
+    itemptr = itemptr_iter;
+    itemprop = RNA_struct_find_property(&itemptr, self->attr);
+    break;
+  }
+  RNA_PROP_END;
+
+  RawArray array;
+  if (itemprop == NULL ||
+      !RNA_property_collection_raw_array(&collection->ptr, collection->prop, itemprop, &array) ||
+      array.len == 0) {
+    PyErr_Format(PyExc_BufferError,
+                 "as_buffer: '%.200s.%.200s[...]' has no raw array of '%.200s'",
+                 RNA_struct_identifier(collection->ptr.type),
+                 RNA_property_identifier(collection->prop),
+                 self->attr);
+    return -1;
+  }
+
+  const char *format = pyrna_raw_type_buffer_format(
+      array.type, RNA_property_subtype(itemprop) != PROP_UNSIGNED);
+  const int itemsize = RNA_raw_type_sizeof(array.type);
+  const int attr_tot = MAX2(RNA_property_array_length(&itemptr, itemprop), 1);
+  if (format == NULL) {
+    PyErr_SetString(PyExc_BufferError, "as_buffer: unsupported attribute type");
+    return -1;
+  }
+  if ((array.stride != itemsize * attr_tot) && ((flags & PyBUF_STRIDES) != PyBUF_STRIDES)) {
+    PyErr_SetString(PyExc_BufferError,
+                    "as_buffer: items are not contiguous, a strided buffer is required");
+    return -1;
+  }
+
+  PropertyCollectionBufferExport *buf_export = PyMem_Malloc(sizeof(*buf_export));
+  buf_export->shape[0] = array.len;
+  buf_export->shape[1] = attr_tot;
+  buf_export->strides[0] = array.stride;
+  buf_export->strides[1] = itemsize;
+  buf_export->itemptr = itemptr;
+  buf_export->itemprop = itemprop;
+
+  view->buf = array.array;
+  view->obj = (PyObject *)self;
+  Py_INCREF(self);
+  view->len = (Py_ssize_t)array.len * attr_tot * itemsize;
+  view->readonly = 0;
+  view->itemsize = itemsize;
+  view->format = (flags & PyBUF_FORMAT) ? (char *)format : NULL;
+  view->ndim = (attr_tot > 1) ? 2 : 1;
+  view->shape = ((flags & PyBUF_ND) == PyBUF_ND) ? buf_export->shape : NULL;
+  view->strides = ((flags & PyBUF_STRIDES) == PyBUF_STRIDES) ? buf_export->strides : NULL;
+  view->suboffsets = NULL;
+  view->internal = buf_export;
+  return 0;
+}
+
+static void pyrna_prop_collection_buffer_release(BPy_PropertyCollectionBuffer *self,
+                                                 Py_buffer *view)
+{
+  PropertyCollectionBufferExport *buf_export = view->internal;
+  /* The buffer may have been written to. */
+  if (self->collection->ptr.type != NULL) {
+    RNA_property_update(BPY_context_get(), &buf_export->itemptr, buf_export->itemprop);
+  }
+  PyMem_Free(buf_export);
+}
+
+static void pyrna_prop_collection_buffer_dealloc(BPy_PropertyCollectionBuffer *self)
+{
+  Py_DECREF(self->collection);
+  PyObject_Del(self);
+}
+
+static PyBufferProcs pyrna_prop_collection_buffer_as_buffer = {
+    (getbufferproc)pyrna_prop_collection_buffer_get,
+    (releasebufferproc)pyrna_prop_collection_buffer_release,
+};
+
+static PyTypeObject pyrna_prop_collection_buffer_Type = {
+    PyVarObject_HEAD_INIT(NULL, 0) "bpy_prop_collection_buffer", /* tp_name */
+    sizeof(BPy_PropertyCollectionBuffer),                        /* tp_basicsize */
+    0,                                                           /* tp_itemsize */
+    /* methods */
+    (destructor)pyrna_prop_collection_buffer_dealloc, /* tp_dealloc */
+    0,                                                /* tp_vectorcall_offset */
+    NULL,                                             /* getattrfunc tp_getattr; */
+    NULL,                                             /* setattrfunc tp_setattr; */
+    NULL,
+    /* tp_compare */ /* DEPRECATED in Python 3.0! */
+    NULL,            /* tp_repr */
+
+    /* Method suites for standard classes */
+
+    NULL, /* PyNumberMethods *tp_as_number; */
+    NULL, /* PySequenceMethods *tp_as_sequence; */
+    NULL, /* PyMappingMethods *tp_as_mapping; */
+
+    /* More standard operations (here for binary compatibility) */
+
+    NULL, /* hashfunc tp_hash; */
+    NULL, /* ternaryfunc tp_call; */
+    NULL, /* reprfunc tp_str; */
+    NULL, /* getattrofunc tp_getattro; */
+    NULL, /* setattrofunc tp_setattro; */
+
+    /* Functions to access object as input/output buffer */
+    &pyrna_prop_collection_buffer_as_buffer, /* PyBufferProcs *tp_as_buffer; */
+
+    /*** Flags to define presence of optional/expanded features ***/
+    Py_TPFLAGS_DEFAULT, /* long tp_flags; */
+
+    NULL, /*  char *tp_doc;  Documentation string */
+    /*** Assigned meaning in release 2.0 ***/
+    /* call function for all accessible objects */
+    NULL, /* traverseproc tp_traverse; */
+
+    /* delete references to contained objects */
+    NULL, /* inquiry tp_clear; */
+
+    /***  Assigned meaning in release 2.1 ***/
+    /*** rich comparisons (subclassed) ***/
+    NULL, /* richcmpfunc tp_richcompare; */
+
+    /***  weak reference enabler ***/
+    0,
+    /*** Added in release 2.2 ***/
+    /*   Iterators */
+    NULL, /* getiterfunc tp_iter; */
+    NULL, /* iternextfunc tp_iternext; */
+
+    /*** Attribute descriptor and subclassing stuff ***/
+    NULL, /* struct PyMethodDef *tp_methods; */
+    NULL, /* struct PyMemberDef *tp_members; */
+    NULL, /* struct PyGetSetDef *tp_getset; */
+    NULL, /* struct _typeobject *tp_base; */
+    NULL, /* PyObject *tp_dict; */
+    NULL, /* descrgetfunc tp_descr_get; */
+    NULL, /* descrsetfunc tp_descr_set; */
+    0,    /* long tp_dictoffset; */
+    NULL, /* initproc tp_init; */
+    NULL, /* allocfunc tp_alloc; */
+    NULL, /* newfunc tp_new; */
+    /*  Low-level free-memory routine */
+    NULL, /* freefunc tp_free; */
+    /* For PyObject_IS_GC */
+    NULL, /* inquiry tp_is_gc; */
+    NULL, /* PyObject *tp_bases; */
+    /* method resolution order */
+    NULL, /* PyObject *tp_mro; */
+    NULL, /* PyObject *tp_cache; */
+    NULL, /* PyObject *tp_subclasses; */
+    NULL, /* PyObject *tp_weaklist; */
+    NULL,
+};
+
+PyDoc_STRVAR(pyrna_prop_collection_as_buffer_doc,
+             ".. method:: as_buffer(attr)\n"
+             "\n"
+             "   Access an attribute of all items in the collection without copying, "
+             "through the buffer protocol.\n"
+             "   Writes are followed by the attribute's update once the buffer is released.\n"
+             "\n"
+             "   .. code-block:: python\n"
+             "\n"
+             "      data = mesh.attributes[\"value\"].data\n"
+             "      with memoryview(data.as_buffer(\"value\")) as view:\n"
+             "          view[0] = 1.0\n"
+             "\n"
+             "   :arg attr: Name of the attribute of the items.\n"
+             "   :type attr: str\n"
+             "   :return: An object supporting the buffer protocol.\n"
+             "\n"
+             "   .. warning::\n"
+             "\n"
+             "      Buffers point to the data directly, so they must be released before the data "
+             "is reallocated, e.g. by adding items, undo or changing modes.\n");
+static PyObject *pyrna_prop_collection_as_buffer(BPy_PropertyRNA *self, PyObject *args)
+{
+  PYRNA_PROP_CHECK_OBJ(self);
+
+  const char *attr;
+  if (!PyArg_ParseTuple(args, "s:as_buffer", &attr)) {
+    return NULL;
+  }
+
+  BPy_PropertyCollectionBuffer *ret = PyObject_New(BPy_PropertyCollectionBuffer,
+                                                   &pyrna_prop_collection_buffer_Type);
+  ret->collection = self;
+  Py_INCREF(self);
+  STRNCPY(ret->attr, attr);
+  return (PyObject *)ret;
+}
+
 static PyObject *pyprop_array_foreach_getset(BPy_PropertyArrayRNA *self,
                                              PyObject *args,
                                              const bool do_set)
@@ -5731,6 +6036,10 @@ static struct PyMethodDef pyrna_prop_collection_methods[] = {
      (PyCFunction)pyrna_prop_collection_foreach_set,
      METH_VARARGS,
      pyrna_prop_collection_foreach_set_doc},
+    {"as_buffer",
+     (PyCFunction)pyrna_prop_collection_as_buffer,
+     METH_VARARGS,
+     pyrna_prop_collection_as_buffer_doc},
 
     {"keys", (PyCFunction)pyrna_prop_collection_keys, METH_NOARGS, pyrna_prop_collection_keys_doc},
     {"items",
@@ -7622,6 +7931,10 @@ void BPY_rna_init(void)
     return;
   }
 
+  if (PyType_Ready(&pyrna_prop_collection_buffer_Type) < 0) {
+    return;
+  }
+
   if (PyType_Ready(&pyrna_func_Type) < 0) {
     return;
   }
@@ -8560,7 +8873,9 @@ static int bpy_class_call(bContext *C, PointerRNA *ptr, FunctionRNA *func, Param
 #endif
       /* *** Main Caller *** */
 
+      const double profile_time = bpy_app_profiler_begin();
       ret = PyObject_Call(item, args, NULL);
+      bpy_app_profiler_end_callable(profile_time, "class", item);
 
       /* *** Done Calling *** */
 
@@ -26,6 +26,7 @@
 
 #include "BPY_extern.h" /* For public API. */
 
+#include "bpy_app_profiler.h"
 #include "bpy_capi_utils.h"
 #include "bpy_rna.h"
 #include "bpy_rna_callback.h" /* Own include. */
@@ -51,7 +52,9 @@ static void cb_region_draw(const bContext *C, ARegion *UNUSED(region), void *cus
 
   cb_func = PyTuple_GET_ITEM((PyObject *)customdata, 1);
   cb_args = PyTuple_GET_ITEM((PyObject *)customdata, 2);
+  const double profile_time = bpy_app_profiler_begin();
   result = PyObject_CallObject(cb_func, cb_args);
+  bpy_app_profiler_end_callable(profile_time, "draw_handler", cb_func);
 
   if (result) {
     Py_DECREF(result);
@@ -96,7 +99,9 @@ static void cb_wm_cursor_draw(bContext *C, int x, int y, void *customdata)
   PyObject *cb_args_with_xy = PyC_Tuple_CopySized(cb_args, cb_args_len + 1);
   PyTuple_SET_ITEM(cb_args_with_xy, cb_args_len, cb_args_xy);
 
+  const double profile_time = bpy_app_profiler_begin();
   result = PyObject_CallObject(cb_func, cb_args_with_xy);
+  bpy_app_profiler_end_callable(profile_time, "draw_handler", cb_func);
 
   Py_DECREF(cb_args_with_xy);
 
@@ -139,6 +139,10 @@ typedef struct RenderResult {
   struct StampData *stamp_data;
 
   bool passes_allocated;
+
+  /* Differs for every allocated result and changes when the pixels of the result are replaced,
+   * so that caches of its pixels can't mistake it for a previous result. */
+  unsigned int generation;
 } RenderResult;
 
 typedef struct RenderStats {
@@ -432,6 +436,10 @@ struct RenderPass *RE_pass_find_by_name(struct RenderLayer *rl,
 struct RenderPass *RE_pass_find_by_type(struct RenderLayer *rl,
                                         int passtype,
                                         const char *viewname);
+/**
+ * Allocate the pixels of the pass if they aren't yet, initialized to the pass default value.
+ */
+float *RE_pass_rect_ensure(struct RenderPass *rpass);
 
 /* shaded view or baking options */
 #define RE_BAKE_NORMALS 0
@@ -21,6 +21,7 @@
 #include "BLI_utildefines.h"
 
 #include "DNA_object_types.h"
+#include "DNA_userdef_types.h"
 
 #include "BKE_camera.h"
 #include "BKE_colortools.h"
@@ -180,6 +181,7 @@ static RenderResult *render_result_from_bake(RenderEngine *engine, int x, int y,
 {
   /* Create render result with specified size. */
   RenderResult *rr = MEM_callocN(sizeof(RenderResult), __func__);
+  render_result_generation_update(rr);
 
   rr->rectx = w;
   rr->recty = h;
@@ -313,6 +315,12 @@ static void engine_tile_highlight_set(RenderEngine *engine,
   BLI_mutex_unlock(&re->highlighted_tiles_mutex);
 }
 
+/* Only for engines going through the RNA API, which allocates passes on access. */
+static bool engine_use_lazy_passes(RenderEngine *engine)
+{
+  return USER_EXPERIMENTAL_TEST(&U, use_render_lazy_passes) && !(engine->type->flag & RE_INTERNAL);
+}
+
 RenderResult *RE_engine_begin_result(
     RenderEngine *engine, int x, int y, int w, int h, const char *layername, const char *viewname)
 {
@@ -352,7 +360,14 @@ RenderResult *RE_engine_begin_result(
   /* can be NULL if we CLAMP the width or height to 0 */
   if (result) {
     render_result_clone_passes(re, result, viewname);
-    render_result_passes_allocated_ensure(result);
+    if (engine_use_lazy_passes(engine)) {
+      /* Other passes are allocated once the engine writes them, unwritten ones are skipped when
+       * merging so the full result keeps its initial values. */
+      render_result_combined_passes_allocated_ensure(result);
+    }
+    else {
+      render_result_passes_allocated_ensure(result);
+    }
 
     BLI_addtail(&engine->fullresult, result);
 
@@ -31,6 +31,7 @@
 #include "BLI_path_util.h"
 #include "BLI_rect.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 #include "BLI_timecode.h"
 
@@ -810,6 +811,7 @@ void RE_InitState(Render *re,
     /* make empty render result, so display callbacks can initialize */
     render_result_free(re->result);
     re->result = MEM_callocN(sizeof(RenderResult), "new render result");
+    render_result_generation_update(re->result);
     re->result->rectx = re->rectx;
     re->result->recty = re->recty;
     render_result_view_new(re->result, "");
@@ -2091,6 +2093,184 @@ static int do_write_image_or_movie(Render *re,
   return ok;
 }
 
+/** Number of animation frames that may wait to be written while the next frame renders. */
+#define RENDER_WRITE_QUEUE_MAX 2
+
+/**
+ * Image or movie frame of an animation written in the background while the next frames render,
+ * see #render_write_task_begin.
+ */
+typedef struct RenderWriteTask {
+  struct RenderWriteTask *next, *prev;
+  /** Copy of the scene settings of the frame, the next frame may animate them. */
+  Scene scene;
+  RenderResult *result;
+  char name[FILE_MAX];
+  ReportList reports;
+  /** Appends to the movies of the render when set, instead of writing an image file. */
+  bMovieHandle *mh;
+  void **movie_ctx_arr;
+  int totvideos;
+  bool ok;
+  bool done;
+} RenderWriteTask;
+
+/**
+ * Frames written in the background, oldest first. Movie frames are appended in order by a serial
+ * pool, images may be written at the same time.
+ */
+typedef struct RenderWriteQueue {
+  TaskPool *pool;
+  ListBase tasks;
+  int tasks_num;
+  ThreadMutex mutex;
+  ThreadCondition cond;
+} RenderWriteQueue;
+
+static void render_write_task_run(TaskPool *__restrict pool, void *taskdata)
+{
+  RenderWriteQueue *queue = BLI_task_pool_user_data(pool);
+  RenderWriteTask *task = (RenderWriteTask *)taskdata;
+  if (task->mh) {
+    task->ok = RE_WriteRenderViewsMovie(&task->reports,
+                                        task->result,
+                                        &task->scene,
+                                        &task->scene.r,
+                                        task->mh,
+                                        task->movie_ctx_arr,
+                                        task->totvideos,
+                                        false);
+  }
+  else {
+    task->ok = BKE_image_render_write(
+        &task->reports, task->result, &task->scene, true, task->name);
+  }
+
+  BLI_mutex_lock(&queue->mutex);
+  task->done = true;
+  BLI_condition_notify_all(&queue->cond);
+  BLI_mutex_unlock(&queue->mutex);
+}
+
+static void render_write_queue_init(RenderWriteQueue *queue, const bool is_movie)
+{
+  memset(queue, 0, sizeof(*queue));
+  BLI_mutex_init(&queue->mutex);
+  BLI_condition_init(&queue->cond);
+  queue->pool = is_movie ? BLI_task_pool_create_background_serial(queue, TASK_PRIORITY_LOW) :
+                           BLI_task_pool_create_background(queue, TASK_PRIORITY_LOW);
+}
+
+static void render_write_queue_free(RenderWriteQueue *queue)
+{
+  BLI_assert(BLI_listbase_is_empty(&queue->tasks));
+  BLI_task_pool_free(queue->pool);
+  BLI_condition_end(&queue->cond);
+  BLI_mutex_end(&queue->mutex);
+}
+
+static void render_write_task_begin(Render *re,
+                                    Main *bmain,
+                                    Scene *scene,
+                                    RenderWriteQueue *queue,
+                                    bMovieHandle *mh,
+                                    const int totvideos)
+{
+  RenderWriteTask *task = MEM_callocN(sizeof(*task), __func__);
+  task->scene = *scene;
+  BKE_reports_init(&task->reports, RPT_STORE);
+  if (mh) {
+    task->mh = mh;
+    task->movie_ctx_arr = re->movie_ctx_arr;
+    task->totvideos = totvideos;
+  }
+  else {
+    BKE_image_path_from_imformat(task->name,
+                                 scene->r.pic,
+                                 BKE_main_blendfile_path(bmain),
+                                 scene->r.cfra,
+                                 &scene->r.im_format,
+                                 (scene->r.scemode & R_EXTENSION) != 0,
+                                 true,
+                                 NULL);
+  }
+
+  RenderResult rres;
+  RE_AcquireResultImageViews(re, &rres);
+  task->result = RE_DuplicateRenderResult(&rres);
+  RE_ReleaseResultImageViews(re, &rres);
+
+  BLI_addtail(&queue->tasks, task);
+  queue->tasks_num++;
+  BLI_task_pool_push(queue->pool, render_write_task_run, task, false, NULL);
+
+  char name[FILE_MAX];
+  re->i.lastframetime = PIL_check_seconds_timer() - re->i.starttime;
+  BLI_timecode_string_from_time_simple(name, sizeof(name), re->i.lastframetime);
+  printf(" Time: %s (Saving in background)\n\n", name);
+  fflush(stdout);
+
+  render_callback_exec_null(re, G_MAIN, BKE_CB_EVT_RENDER_STATS);
+}
+
+/**
+ * Wait for the oldest frame of the queue to be written and run the write callbacks for it.
+ * Return false on write errors, reported for the frame that failed.
+ */
+static bool render_write_task_finish_oldest(Render *re, Scene *scene, RenderWriteQueue *queue)
+{
+  RenderWriteTask *task = queue->tasks.first;
+  if (task == NULL) {
+    return true;
+  }
+
+  BLI_mutex_lock(&queue->mutex);
+  while (!task->done) {
+    BLI_condition_wait(&queue->cond, &queue->mutex);
+  }
+  BLI_mutex_unlock(&queue->mutex);
+
+  BLI_remlink(&queue->tasks, task);
+  queue->tasks_num--;
+
+  LISTBASE_FOREACH (Report *, report, &task->reports.list) {
+    BKE_report(re->reports, report->type, report->message);
+  }
+  BKE_reports_clear(&task->reports);
+  render_result_free(task->result);
+
+  const bool ok = task->ok;
+  if (ok) {
+    /* Callbacks see the frame of the written file. */
+    const int cfra = scene->r.cfra;
+    scene->r.cfra = task->scene.r.cfra;
+    render_callback_exec_id(re, re->main, &scene->id, BKE_CB_EVT_RENDER_WRITE);
+    scene->r.cfra = cfra;
+  }
+  else {
+    BKE_reportf(re->reports, RPT_ERROR, "Failed to save frame %d", task->scene.r.cfra);
+  }
+
+  MEM_freeN(task);
+  return ok;
+}
+
+/**
+ * Wait until fewer than \a tasks_max frames are queued.
+ * Return false on write errors, all queued frames are still waited for.
+ */
+static bool render_write_queue_flush(Render *re,
+                                     Scene *scene,
+                                     RenderWriteQueue *queue,
+                                     const int tasks_max)
+{
+  bool ok = true;
+  while (queue->tasks_num > 0 && (queue->tasks_num >= tasks_max || !ok)) {
+    ok &= render_write_task_finish_oldest(re, scene, queue);
+  }
+  return ok;
+}
+
 static void get_videos_dimensions(const Render *re,
                                   const RenderData *rd,
                                   size_t *r_width,
@@ -2149,6 +2329,8 @@ void RE_RenderAnim(Render *re,
   const bool is_movie = BKE_imtype_is_movie(rd.im_format.imtype);
   const bool is_multiview_name = ((rd.scemode & R_MULTIVIEW) != 0 &&
                                   (rd.im_format.views_format == R_IMF_VIEWS_INDIVIDUAL));
+  RenderWriteQueue write_queue;
+  bool use_write_queue = false;
 
   /* do not fully call for each frame, it initializes & pops output window */
   if (!render_init_from_main(re, &rd, bmain, scene, single_layer, camera_override, 0, 1)) {
@@ -2163,6 +2345,14 @@ void RE_RenderAnim(Render *re,
 
   render_init_depsgraph(re);
 
+  /* Write frames in the background while the next frames are evaluated and rendered.
+   * Touched files are not supported, they are removed on errors of the frame being rendered. */
+  if (USER_EXPERIMENTAL_TEST(&U, use_render_write_background) && do_write_file &&
+      (rd.mode & R_TOUCH) == 0) {
+    render_write_queue_init(&write_queue, is_movie);
+    use_write_queue = true;
+  }
+
   if (is_movie && do_write_file) {
     size_t width, height;
     int i;
@@ -2173,6 +2363,9 @@ void RE_RenderAnim(Render *re,
     mh = BKE_movie_handle_get(rd.im_format.imtype);
     if (mh == NULL) {
       BKE_report(re->reports, RPT_ERROR, "Movie format unsupported");
+      if (use_write_queue) {
+        render_write_queue_free(&write_queue);
+      }
       return;
     }
 
@@ -2200,6 +2393,9 @@ void RE_RenderAnim(Render *re,
       /* report is handled above */
       re_movie_free_all(re, mh, i + 1);
       render_pipeline_free(re);
+      if (use_write_queue) {
+        render_write_queue_free(&write_queue);
+      }
       return;
     }
   }
@@ -2330,7 +2526,16 @@ void RE_RenderAnim(Render *re,
 
       if (re->test_break(re->tbh) == 0) {
         if (!G.is_break) {
-          if (!do_write_image_or_movie(re, bmain, scene, mh, totvideos, NULL)) {
+          if (use_write_queue) {
+            /* Previous frames were written while this one was rendered. */
+            if (render_write_queue_flush(re, scene, &write_queue, RENDER_WRITE_QUEUE_MAX)) {
+              render_write_task_begin(re, bmain, scene, &write_queue, mh, totvideos);
+            }
+            else {
+              G.is_break = true;
+            }
+          }
+          else if (!do_write_image_or_movie(re, bmain, scene, mh, totvideos, NULL)) {
             G.is_break = true;
           }
         }
@@ -2375,11 +2580,20 @@ void RE_RenderAnim(Render *re,
       if (G.is_break == false) {
         /* keep after file save */
         render_callback_exec_id(re, re->main, &scene->id, BKE_CB_EVT_RENDER_POST);
-        render_callback_exec_id(re, re->main, &scene->id, BKE_CB_EVT_RENDER_WRITE);
+        if (!use_write_queue) {
+          render_callback_exec_id(re, re->main, &scene->id, BKE_CB_EVT_RENDER_WRITE);
+        }
       }
     }
   }
 
+  if (use_write_queue) {
+    if (!render_write_queue_flush(re, scene, &write_queue, 1)) {
+      G.is_break = true;
+    }
+    render_write_queue_free(&write_queue);
+  }
+
   /* end movie */
   if (is_movie && do_write_file) {
     re_movie_free_all(re, mh, totvideos);
@@ -2548,10 +2762,14 @@ void RE_layer_load_from_file(
 
 void RE_result_load_from_file(RenderResult *result, ReportList *reports, const char *filepath)
 {
+  /* Tile results of engines may have passes that weren't allocated yet. */
+  render_result_passes_allocated_ensure(result);
+
   if (!render_result_exr_file_read_path(result, NULL, filepath)) {
     BKE_reportf(reports, RPT_ERROR, "%s: failed to load '%s'", __func__, filepath);
     return;
   }
+  render_result_generation_update(result);
 }
 
 bool RE_layers_have_name(struct RenderResult *rr)
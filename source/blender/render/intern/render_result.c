@@ -22,6 +22,8 @@
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
+#include "atomic_ops.h"
+
 #include "BKE_appdir.h"
 #include "BKE_camera.h"
 #include "BKE_global.h"
@@ -164,13 +166,13 @@ void render_result_views_shallowdelete(RenderResult *rr)
 
 /********************************** New **************************************/
 
-static void render_layer_allocate_pass(RenderResult *rr, RenderPass *rp)
+float *RE_pass_rect_ensure(RenderPass *rp)
 {
   if (rp->rect != NULL) {
-    return;
+    return rp->rect;
   }
 
-  const size_t rectsize = ((size_t)rr->rectx) * rr->recty * rp->channels;
+  const size_t rectsize = ((size_t)rp->rectx) * rp->recty * rp->channels;
   rp->rect = MEM_callocN(sizeof(float) * rectsize, rp->name);
 
   if (STREQ(rp->name, RE_PASSNAME_VECTOR)) {
@@ -186,6 +188,8 @@ static void render_layer_allocate_pass(RenderResult *rr, RenderPass *rp)
       rect[x] = 10e10;
     }
   }
+
+  return rp->rect;
 }
 
 RenderPass *render_layer_add_pass(RenderResult *rr,
@@ -222,7 +226,7 @@ RenderPass *render_layer_add_pass(RenderResult *rr,
   BLI_addtail(&rl->passes, rpass);
 
   if (allocate) {
-    render_layer_allocate_pass(rr, rpass);
+    RE_pass_rect_ensure(rpass);
   }
   else {
     /* The result contains non-allocated pass now, so tag it as such. */
@@ -250,6 +254,7 @@ RenderResult *render_result_new(Render *re,
   }
 
   rr = MEM_callocN(sizeof(RenderResult), "new render result");
+  render_result_generation_update(rr);
   rr->rectx = rectx;
   rr->recty = recty;
   rr->renrect.xmin = 0;
@@ -422,6 +427,13 @@ RenderResult *render_result_new(Render *re,
   return rr;
 }
 
+static unsigned int render_result_generation_counter = 0;
+
+void render_result_generation_update(RenderResult *rr)
+{
+  rr->generation = atomic_add_and_fetch_u(&render_result_generation_counter, 1);
+}
+
 void render_result_passes_allocated_ensure(RenderResult *rr)
 {
   if (rr == NULL) {
@@ -436,13 +448,24 @@ void render_result_passes_allocated_ensure(RenderResult *rr)
         continue;
       }
 
-      render_layer_allocate_pass(rr, rp);
+      RE_pass_rect_ensure(rp);
     }
   }
 
   rr->passes_allocated = true;
 }
 
+void render_result_combined_passes_allocated_ensure(RenderResult *rr)
+{
+  LISTBASE_FOREACH (RenderLayer *, rl, &rr->layers) {
+    LISTBASE_FOREACH (RenderPass *, rp, &rl->passes) {
+      if (STREQ(rp->name, RE_PASSNAME_COMBINED)) {
+        RE_pass_rect_ensure(rp);
+      }
+    }
+  }
+}
+
 void render_result_clone_passes(Render *re, RenderResult *rr, const char *viewname)
 {
   RenderLayer *rl;
@@ -725,6 +748,7 @@ RenderResult *render_result_new_from_exr(
   const char *to_colorspace = IMB_colormanagement_role_colorspace_name_get(
       COLOR_ROLE_SCENE_LINEAR);
 
+  render_result_generation_update(rr);
   rr->rectx = rectx;
   rr->recty = recty;
 
@@ -821,19 +845,23 @@ void render_result_merge(RenderResult *rr, RenderResult *rrpart)
       /* Passes are allocated in sync. */
       for (rpass = rl->passes.first, rpassp = rlp->passes.first; rpass && rpassp;
            rpass = rpass->next) {
-        /* For save buffers, skip any passes that are only saved to disk. */
-        if (rpass->rect == NULL || rpassp->rect == NULL) {
-          continue;
-        }
         /* Renderresult have all passes, renderpart only the active view's passes. */
         if (!STREQ(rpassp->fullname, rpass->fullname)) {
           continue;
         }
 
-        do_merge_tile(rr, rrpart, rpass->rect, rpassp->rect, rpass->channels);
+        float *rect_part = rpassp->rect;
 
         /* manually get next render pass */
         rpassp = rpassp->next;
+
+        /* For save buffers, skip any passes that are only saved to disk. Tile passes are NULL
+         * when the engine didn't write them, see #RE_pass_rect_ensure. */
+        if (rpass->rect == NULL || rect_part == NULL) {
+          continue;
+        }
+
+        do_merge_tile(rr, rrpart, rpass->rect, rect_part, rpass->channels);
       }
     }
   }
@@ -894,6 +922,7 @@ void render_result_single_layer_end(Render *re)
 
   RE_FreeRenderResult(re->pushedresult);
   re->pushedresult = NULL;
+  render_result_generation_update(re->result);
 }
 
 int render_result_exr_file_read_path(RenderResult *rr,
@@ -42,6 +42,16 @@ struct RenderResult *render_result_new(struct Render *re,
                                        const char *viewname);
 
 void render_result_passes_allocated_ensure(struct RenderResult *rr);
+/**
+ * Only allocate the combined passes, others are allocated with #RE_pass_rect_ensure.
+ */
+void render_result_combined_passes_allocated_ensure(struct RenderResult *rr);
+
+/**
+ * Give the render result a new #RenderResult.generation, call when its pixels are replaced
+ * outside of rendering.
+ */
+void render_result_generation_update(struct RenderResult *rr);
 
 /**
  * From imbuf, if a handle was returned and
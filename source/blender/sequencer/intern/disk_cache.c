@@ -592,6 +592,7 @@ bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf
     return true;
   }
 
+  fclose(file);
   BLI_mutex_unlock(&disk_cache->read_write_mutex);
   return false;
 }
@@ -604,7 +605,6 @@ ImBuf *seq_disk_cache_read_file(SeqDiskCache *disk_cache, SeqCacheKey *key)
   DiskCacheHeader header;
 
   seq_disk_cache_get_file_path(disk_cache, key, path, sizeof(path));
-  BLI_make_existing_file(path);
 
   FILE *file = BLI_fopen(path, "rb");
   if (!file) {
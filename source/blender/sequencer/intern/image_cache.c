@@ -9,6 +9,8 @@
 #include <stddef.h>
 #include <time.h>
 
+#include <zstd.h>
+
 #include "MEM_guardedalloc.h"
 
 #include "DNA_scene_types.h"
@@ -18,6 +20,7 @@
 #include "IMB_colormanagement.h"
 #include "IMB_imbuf.h"
 #include "IMB_imbuf_types.h"
+#include "IMB_metadata.h"
 
 #include "BLI_blenlib.h"
 #include "BLI_endian_defines.h"
@@ -66,8 +69,23 @@
  * entries one by one in reverse order to their creation.
  *
  * User can exclude caching of some images. Such entries will have is_temp_cache set.
+ *
+ * Compression:
+ * With #SEQ_CACHE_COMPRESS_FINAL_OUT, final images are stored compressed with zstd. The item
+ * keeps an #ImBuf without pixels for the image properties, every cache hit decompresses into
+ * a new #ImBuf. This trades playback time for a longer cached range.
+ *
+ * Recycling by cost:
+ * With #SEQ_CACHE_RECYCLE_BY_COST, the frame with the lowest render cost relative to its
+ * distance to the playhead is freed first, instead of the frame at the end of the cached range
+ * furthest from the playhead. Render cost is set by #seq_cache_final_out_cost_set.
  */
 
+/** Fast compression level, cache hits are decompressed during playback. */
+#define SEQ_CACHE_COMPRESSION_LEVEL 1
+/** Cost of frames whose render time is unknown, such as frames read from the disk cache. */
+#define SEQ_CACHE_COST_MIN 0.01f
+
 #define THUMB_CACHE_LIMIT 5000
 
 typedef struct SeqCache {
@@ -83,9 +101,25 @@ typedef struct SeqCache {
 
 typedef struct SeqCacheItem {
   struct SeqCache *cache_owner;
+  /** Without pixels when the image is compressed. */
   struct ImBuf *ibuf;
+  /** Compressed pixels of #ibuf, see #seq_cache_compress. */
+  void *compressed_data;
+  size_t compressed_size;
+  size_t raw_size;
+  bool is_float;
+  /** Render time of final images divided by the frame duration, see #SEQ_CACHE_RECYCLE_BY_COST. */
+  float cost;
 } SeqCacheItem;
 
+/** Image pixels compressed outside of the cache lock, see #seq_cache_put. */
+typedef struct SeqCacheCompressed {
+  void *data;
+  size_t size;
+  size_t raw_size;
+  bool is_float;
+} SeqCacheCompressed;
+
 static ThreadMutex cache_create_lock = BLI_MUTEX_INITIALIZER;
 
 static bool seq_cmp_render_data(const SeqRenderData *a, const SeqRenderData *b)
@@ -194,10 +228,76 @@ static void seq_cache_valfree(void *val)
   if (item->ibuf) {
     IMB_freeImBuf(item->ibuf);
   }
+  MEM_SAFE_FREE(item->compressed_data);
 
   BLI_mempool_free(item->cache_owner->items_pool, item);
 }
 
+static bool seq_cache_compress(ImBuf *ibuf, SeqCacheCompressed *r_compressed)
+{
+  const size_t pixels_num = (size_t)ibuf->x * (size_t)ibuf->y;
+  const void *data;
+  if (ibuf->rect_float) {
+    data = ibuf->rect_float;
+    r_compressed->raw_size = pixels_num * ibuf->channels * sizeof(float);
+    r_compressed->is_float = true;
+  }
+  else if (ibuf->rect) {
+    data = ibuf->rect;
+    r_compressed->raw_size = pixels_num * sizeof(uint);
+    r_compressed->is_float = false;
+  }
+  else {
+    return false;
+  }
+
+  const size_t bound = ZSTD_compressBound(r_compressed->raw_size);
+  void *buffer = MEM_mallocN(bound, __func__);
+  const size_t size = ZSTD_compress(
+      buffer, bound, data, r_compressed->raw_size, SEQ_CACHE_COMPRESSION_LEVEL);
+  /* Keep the image as is when it doesn't compress. */
+  if (ZSTD_isError(size) || size >= r_compressed->raw_size) {
+    MEM_freeN(buffer);
+    return false;
+  }
+  r_compressed->data = MEM_reallocN(buffer, size);
+  r_compressed->size = size;
+  return true;
+}
+
+/* Image properties of a compressed image, the pixels are only in the compressed data. */
+static ImBuf *seq_cache_compressed_imbuf_header(const ImBuf *ibuf)
+{
+  ImBuf *header = IMB_allocImBuf(ibuf->x, ibuf->y, ibuf->planes, 0);
+  header->channels = ibuf->channels;
+  header->rect_colorspace = ibuf->rect_colorspace;
+  header->float_colorspace = ibuf->float_colorspace;
+  IMB_metadata_copy(header, (ImBuf *)ibuf);
+  return header;
+}
+
+static ImBuf *seq_cache_decompress(const SeqCacheItem *item)
+{
+  const ImBuf *header = item->ibuf;
+  ImBuf *ibuf = IMB_allocImBuf(
+      header->x, header->y, header->planes, item->is_float ? IB_rectfloat : IB_rect);
+  if (ibuf == NULL) {
+    return NULL;
+  }
+  void *data = item->is_float ? (void *)ibuf->rect_float : (void *)ibuf->rect;
+  ibuf->channels = header->channels;
+  const size_t size = ZSTD_decompress(
+      data, item->raw_size, item->compressed_data, item->compressed_size);
+  if (ZSTD_isError(size) || size != item->raw_size) {
+    IMB_freeImBuf(ibuf);
+    return NULL;
+  }
+  ibuf->rect_colorspace = header->rect_colorspace;
+  ibuf->float_colorspace = header->float_colorspace;
+  IMB_metadata_copy(ibuf, (ImBuf *)header);
+  return ibuf;
+}
+
 static int get_stored_types_flag(Scene *scene, SeqCacheKey *key)
 {
   int flag;
@@ -214,13 +314,32 @@ static int get_stored_types_flag(Scene *scene, SeqCacheKey *key)
   return flag;
 }
 
-static void seq_cache_put_ex(Scene *scene, SeqCacheKey *key, ImBuf *ibuf)
+/**
+ * \param compressed: Compressed pixels of \a ibuf, owned by the cache afterwards. NULL to store
+ * \a ibuf as is.
+ */
+static void seq_cache_put_ex(Scene *scene,
+                             SeqCacheKey *key,
+                             ImBuf *ibuf,
+                             SeqCacheCompressed *compressed)
 {
   SeqCache *cache = seq_cache_get_from_scene(scene);
   SeqCacheItem *item;
   item = BLI_mempool_alloc(cache->items_pool);
   item->cache_owner = cache;
   item->ibuf = ibuf;
+  item->compressed_data = NULL;
+  item->compressed_size = 0;
+  item->raw_size = 0;
+  item->is_float = false;
+  item->cost = 0.0f;
+  if (compressed) {
+    item->ibuf = seq_cache_compressed_imbuf_header(ibuf);
+    item->compressed_data = compressed->data;
+    item->compressed_size = compressed->size;
+    item->raw_size = compressed->raw_size;
+    item->is_float = compressed->is_float;
+  }
 
   const int stored_types_flag = get_stored_types_flag(scene, key);
 
@@ -233,7 +352,8 @@ static void seq_cache_put_ex(Scene *scene, SeqCacheKey *key, ImBuf *ibuf)
   /* Store pointer to last cached key. */
   SeqCacheKey *temp_last_key = cache->last_key;
 
-  if (BLI_ghash_reinsert(cache->hash, key, item, seq_cache_keyfree, seq_cache_valfree)) {
+  if (BLI_ghash_reinsert(cache->hash, key, item, seq_cache_keyfree, seq_cache_valfree) &&
+      compressed == NULL) {
     IMB_refImBuf(ibuf);
 
     if (!key->is_temp_cache || key->type != SEQ_CACHE_STORE_THUMBNAIL) {
@@ -258,6 +378,9 @@ static ImBuf *seq_cache_get_ex(SeqCache *cache, SeqCacheKey *key)
 {
   SeqCacheItem *item = BLI_ghash_lookup(cache->hash, key);
 
+  if (item && item->compressed_data) {
+    return seq_cache_decompress(item);
+  }
   if (item && item->ibuf) {
     IMB_refImBuf(item->ibuf);
 
@@ -383,6 +506,39 @@ static void seq_cache_recycle_linked(Scene *scene, SeqCacheKey *base)
   }
 }
 
+static bool seq_cache_key_is_prefetched(Scene *scene, const SeqCacheKey *key)
+{
+  if (!(scene->ed->cache_flag & SEQ_CACHE_PREFETCH_ENABLE) ||
+      !seq_prefetch_job_is_running(scene)) {
+    return false;
+  }
+  int pfjob_start, pfjob_end;
+  seq_prefetch_get_time_range(scene, &pfjob_start, &pfjob_end);
+  return key->timeline_frame >= pfjob_start && key->timeline_frame <= pfjob_end;
+}
+
+/**
+ * Frames that are cheap to render again and far from the playhead are freed first.
+ * Frames in the range the prefetch job is working on are kept, see #seq_cache_choose_key.
+ */
+static SeqCacheKey *seq_cache_choose_key_by_cost(Scene *scene,
+                                                 SeqCacheKey *key,
+                                                 const SeqCacheItem *item,
+                                                 SeqCacheKey *best_key,
+                                                 float *r_best_score)
+{
+  if (seq_cache_key_is_prefetched(scene, key)) {
+    return best_key;
+  }
+  const float distance = fabsf(key->timeline_frame - (float)scene->r.cfra);
+  const float score = distance / max_ff(item->cost, SEQ_CACHE_COST_MIN);
+  if (best_key == NULL || score > *r_best_score) {
+    *r_best_score = score;
+    return key;
+  }
+  return best_key;
+}
+
 static SeqCacheKey *seq_cache_get_item_for_removal(Scene *scene)
 {
   SeqCache *cache = seq_cache_get_from_scene(scene);
@@ -392,6 +548,9 @@ static SeqCacheKey *seq_cache_get_item_for_removal(Scene *scene)
   /* Rightmost key. */
   SeqCacheKey *rkey = NULL;
   SeqCacheKey *key = NULL;
+  const bool use_cost = (scene->ed->cache_flag & SEQ_CACHE_RECYCLE_BY_COST) != 0;
+  SeqCacheKey *cost_key = NULL;
+  float cost_score = 0.0f;
 
   GHashIterator gh_iter;
   BLI_ghashIterator_init(&gh_iter, cache->hash);
@@ -416,6 +575,11 @@ static SeqCacheKey *seq_cache_get_item_for_removal(Scene *scene)
 
     total_count++;
 
+    if (use_cost) {
+      cost_key = seq_cache_choose_key_by_cost(scene, key, item, cost_key, &cost_score);
+      continue;
+    }
+
     if (lkey) {
       if (key->timeline_frame < lkey->timeline_frame) {
         lkey = key;
@@ -434,6 +598,10 @@ static SeqCacheKey *seq_cache_get_item_for_removal(Scene *scene)
     }
   }
 
+  if (use_cost) {
+    return cost_key;
+  }
+
   finalkey = seq_cache_choose_key(scene, lkey, rkey);
 
   return finalkey;
@@ -778,7 +946,7 @@ struct ImBuf *seq_cache_get(const SeqRenderData *context,
     /* Store read image in RAM. Only recycle item for final type. */
     if (key.type != SEQ_CACHE_STORE_FINAL_OUT || seq_cache_recycle_item(scene)) {
       SeqCacheKey *new_key = seq_cache_allocate_key(cache, context, seq, timeline_frame, type);
-      seq_cache_put_ex(scene, new_key, ibuf);
+      seq_cache_put_ex(scene, new_key, ibuf, NULL);
     }
   }
 
@@ -836,7 +1004,7 @@ void seq_cache_thumbnail_put(
     seq_cache_thumbnail_cleanup(scene, &view_area_safe);
   }
 
-  seq_cache_put_ex(scene, key, i);
+  seq_cache_put_ex(scene, key, i, NULL);
   cache->thumbnail_count++;
   seq_cache_unlock(scene);
 }
@@ -868,10 +1036,17 @@ void seq_cache_put(
     seq_cache_create(context->bmain, scene);
   }
 
+  /* Only final images that are kept are compressed, others are used right away. */
+  SeqCacheCompressed compressed;
+  const bool use_compression = type == SEQ_CACHE_STORE_FINAL_OUT &&
+                               (scene->ed->cache_flag & SEQ_CACHE_STORE_FINAL_OUT) &&
+                               (scene->ed->cache_flag & SEQ_CACHE_COMPRESS_FINAL_OUT) &&
+                               seq_cache_compress(i, &compressed);
+
   seq_cache_lock(scene);
   SeqCache *cache = seq_cache_get_from_scene(scene);
   SeqCacheKey *key = seq_cache_allocate_key(cache, context, seq, timeline_frame, type);
-  seq_cache_put_ex(scene, key, i);
+  seq_cache_put_ex(scene, key, i, use_compression ? &compressed : NULL);
   seq_cache_unlock(scene);
 
   if (!key->is_temp_cache) {
@@ -914,6 +1089,34 @@ void SEQ_cache_iterate(
   seq_cache_unlock(scene);
 }
 
+void seq_cache_final_out_cost_set(const SeqRenderData *context,
+                                  Sequence *seq,
+                                  float timeline_frame,
+                                  float render_time)
+{
+  Scene *scene = context->scene;
+
+  if (context->is_prefetch_render) {
+    context = seq_prefetch_get_original_context(context);
+    scene = context->scene;
+    seq = seq_prefetch_get_original_sequence(seq, scene);
+  }
+
+  SeqCache *cache = seq_cache_get_from_scene(scene);
+  if (!cache || !seq) {
+    return;
+  }
+
+  seq_cache_lock(scene);
+  SeqCacheKey key;
+  seq_cache_populate_key(&key, context, seq, timeline_frame, SEQ_CACHE_STORE_FINAL_OUT);
+  SeqCacheItem *item = BLI_ghash_lookup(cache->hash, &key);
+  if (item) {
+    item->cost = render_time * (float)FPS;
+  }
+  seq_cache_unlock(scene);
+}
+
 bool seq_cache_is_full(void)
 {
   return seq_cache_get_mem_total() < MEM_get_memory_in_use();
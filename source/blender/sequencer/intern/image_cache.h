@@ -68,6 +68,14 @@ void seq_cache_cleanup_sequence(struct Scene *scene,
                                 int invalidate_types,
                                 bool force_seq_changed_range);
 void seq_cache_thumbnail_cleanup(Scene *scene, rctf *view_area);
+/**
+ * Store the time it took to render the final image of a frame, used to choose the frames
+ * to free with #SEQ_CACHE_RECYCLE_BY_COST.
+ */
+void seq_cache_final_out_cost_set(const struct SeqRenderData *context,
+                                  struct Sequence *seq,
+                                  float timeline_frame,
+                                  float render_time);
 bool seq_cache_is_full(void);
 float seq_cache_frame_index_to_timeline_frame(struct Sequence *seq, float frame_index);
 
@@ -15,9 +15,12 @@
 #include "DNA_scene_types.h"
 #include "DNA_screen_types.h"
 #include "DNA_sequence_types.h"
+#include "DNA_userdef_types.h"
 #include "DNA_windowmanager_types.h"
 
 #include "BLI_listbase.h"
+#include "BLI_math_base.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "IMB_imbuf.h"
@@ -446,6 +449,76 @@ static bool seq_prefetch_must_skip_frame(PrefetchJob *pfjob, ListBase *channels,
   return false;
 }
 
+/** Maximum number of frames rendered at the same time by the prefetch job. */
+#define SEQ_PREFETCH_CONCURRENT_FRAMES_MAX 8
+
+/* Strips that can be rendered for several frames at the same time. Movie strips share one
+ * decoder between all frames, scene, clip and mask strips evaluate their data for one frame, and
+ * speed and text effects build shared state while rendering. Proxies are read by a decoder too. */
+static bool seq_prefetch_seq_is_thread_safe(Sequence *seq)
+{
+  if (seq->flag & SEQ_USE_PROXY) {
+    return false;
+  }
+  LISTBASE_FOREACH (SequenceModifierData *, smd, &seq->modifiers) {
+    if (smd->mask_id) {
+      return false;
+    }
+  }
+  if (seq->type & SEQ_TYPE_EFFECT) {
+    return !ELEM(seq->type, SEQ_TYPE_SPEED, SEQ_TYPE_TEXT);
+  }
+  return ELEM(seq->type, SEQ_TYPE_IMAGE, SEQ_TYPE_META, SEQ_TYPE_SOUND_RAM);
+}
+
+/* Frames are only rendered concurrently when nothing has to be evaluated per frame: the scene
+ * copy is shared by all frames. */
+static bool seq_prefetch_can_render_frames_concurrently(PrefetchJob *pfjob)
+{
+  if (!U.experimental.use_sequencer_prefetch_threads || BLI_task_scheduler_num_threads() < 2) {
+    return false;
+  }
+  AnimData *adt = BKE_animdata_from_id(&pfjob->scene_eval->id);
+  if (adt && (adt->action || !BLI_listbase_is_empty(&adt->drivers) ||
+              !BLI_listbase_is_empty(&adt->nla_tracks))) {
+    return false;
+  }
+
+  ListBase *seqbase = SEQ_active_seqbase_get(SEQ_editing_get(pfjob->scene_eval));
+  SeqCollection *strips = SEQ_query_all_strips_recursive(seqbase);
+  bool is_thread_safe = true;
+  Sequence *seq;
+  SEQ_ITERATOR_FOREACH (seq, strips) {
+    if (!seq_prefetch_seq_is_thread_safe(seq)) {
+      is_thread_safe = false;
+      break;
+    }
+  }
+  SEQ_collection_free(strips);
+  return is_thread_safe;
+}
+
+/**
+ * Render the next frames at the same time, starting at the current prefetch frame.
+ * \return The number of rendered frames.
+ */
+static int seq_prefetch_render_frames_concurrently(PrefetchJob *pfjob)
+{
+  float timeline_frames[SEQ_PREFETCH_CONCURRENT_FRAMES_MAX];
+  const int frames_max = min_ii(BLI_task_scheduler_num_threads(),
+                                SEQ_PREFETCH_CONCURRENT_FRAMES_MAX);
+  int frames_num = 0;
+  for (; frames_num < frames_max; frames_num++) {
+    const float timeline_frame = seq_prefetch_cfra(pfjob) + frames_num;
+    if (timeline_frame > pfjob->scene->r.efra) {
+      break;
+    }
+    timeline_frames[frames_num] = timeline_frame;
+  }
+  seq_render_frames_concurrent(&pfjob->context_cpy, timeline_frames, frames_num);
+  return frames_num;
+}
+
 static bool seq_prefetch_need_suspend(PrefetchJob *pfjob)
 {
   return seq_prefetch_is_cache_full(pfjob->scene) || seq_prefetch_is_scrubbing(pfjob->bmain) ||
@@ -493,9 +566,16 @@ static void *seq_prefetch_frames(void *job)
       continue;
     }
 
-    ImBuf *ibuf = SEQ_render_give_ibuf(&pfjob->context_cpy, seq_prefetch_cfra(pfjob), 0);
-    seq_cache_free_temp_cache(pfjob->scene, pfjob->context.task_id, seq_prefetch_cfra(pfjob));
-    IMB_freeImBuf(ibuf);
+    if (seq_prefetch_can_render_frames_concurrently(pfjob)) {
+      /* Continue from the last rendered frame. */
+      pfjob->num_frames_prefetched += seq_prefetch_render_frames_concurrently(pfjob) - 1;
+      seq_cache_free_temp_cache(pfjob->scene, pfjob->context.task_id, seq_prefetch_cfra(pfjob));
+    }
+    else {
+      ImBuf *ibuf = SEQ_render_give_ibuf(&pfjob->context_cpy, seq_prefetch_cfra(pfjob), 0);
+      seq_cache_free_temp_cache(pfjob->scene, pfjob->context.task_id, seq_prefetch_cfra(pfjob));
+      IMB_freeImBuf(ibuf);
+    }
 
     /* Suspend thread if there is nothing to be prefetched. */
     seq_prefetch_do_suspend(pfjob);
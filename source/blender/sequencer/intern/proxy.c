@@ -248,12 +248,17 @@ ImBuf *seq_proxy_fetch(const SeqRenderData *context, Sequence *seq, int timeline
   return NULL;
 }
 
+/**
+ * \param r_ibuf_render: Strip image at full size, rendered on first use and reused for the other
+ * proxy sizes of the same frame. Must be freed by the caller.
+ */
 static void seq_proxy_build_frame(const SeqRenderData *context,
                                   SeqRenderState *state,
                                   Sequence *seq,
                                   int timeline_frame,
                                   int proxy_render_size,
-                                  const bool overwrite)
+                                  const bool overwrite,
+                                  ImBuf **r_ibuf_render)
 {
   char name[PROXY_MAXFILE];
   int quality;
@@ -269,7 +274,10 @@ static void seq_proxy_build_frame(const SeqRenderData *context,
     return;
   }
 
-  ibuf_tmp = seq_render_strip(context, state, seq, timeline_frame);
+  if (*r_ibuf_render == NULL) {
+    *r_ibuf_render = seq_render_strip(context, state, seq, timeline_frame);
+  }
+  ibuf_tmp = *r_ibuf_render;
 
   rectx = (proxy_render_size * ibuf_tmp->x) / 100;
   recty = (proxy_render_size * ibuf_tmp->y) / 100;
@@ -277,11 +285,13 @@ static void seq_proxy_build_frame(const SeqRenderData *context,
   if (ibuf_tmp->x != rectx || ibuf_tmp->y != recty) {
     ibuf = IMB_dupImBuf(ibuf_tmp);
     IMB_metadata_copy(ibuf, ibuf_tmp);
-    IMB_freeImBuf(ibuf_tmp);
     IMB_scalefastImBuf(ibuf, (short)rectx, (short)recty);
   }
   else {
+    /* Settings below are the same for every proxy size, so the rendered image can be saved
+     * as is. */
     ibuf = ibuf_tmp;
+    IMB_refImBuf(ibuf);
   }
 
   /* depth = 32 is intentionally left in, otherwise ALPHA channels
@@ -526,17 +536,26 @@ void SEQ_proxy_rebuild(SeqIndexBuildContext *context,
   for (timeline_frame = seq->startdisp + seq->startstill;
        timeline_frame < seq->enddisp - seq->endstill;
        timeline_frame++) {
+    /* Render the strip once and scale it down for every proxy size. */
+    ImBuf *ibuf_render = NULL;
     if (context->size_flags & IMB_PROXY_25) {
-      seq_proxy_build_frame(&render_context, &state, seq, timeline_frame, 25, overwrite);
+      seq_proxy_build_frame(
+          &render_context, &state, seq, timeline_frame, 25, overwrite, &ibuf_render);
     }
     if (context->size_flags & IMB_PROXY_50) {
-      seq_proxy_build_frame(&render_context, &state, seq, timeline_frame, 50, overwrite);
+      seq_proxy_build_frame(
+          &render_context, &state, seq, timeline_frame, 50, overwrite, &ibuf_render);
     }
     if (context->size_flags & IMB_PROXY_75) {
-      seq_proxy_build_frame(&render_context, &state, seq, timeline_frame, 75, overwrite);
+      seq_proxy_build_frame(
+          &render_context, &state, seq, timeline_frame, 75, overwrite, &ibuf_render);
     }
     if (context->size_flags & IMB_PROXY_100) {
-      seq_proxy_build_frame(&render_context, &state, seq, timeline_frame, 100, overwrite);
+      seq_proxy_build_frame(
+          &render_context, &state, seq, timeline_frame, 100, overwrite, &ibuf_render);
+    }
+    if (ibuf_render) {
+      IMB_freeImBuf(ibuf_render);
     }
 
     *progress = (float)(timeline_frame - seq->startdisp - seq->startstill) /
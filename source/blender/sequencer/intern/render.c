@@ -17,11 +17,16 @@
 #include "DNA_scene_types.h"
 #include "DNA_sequence_types.h"
 #include "DNA_space_types.h"
+#include "DNA_userdef_types.h"
 
 #include "BLI_linklist.h"
 #include "BLI_listbase.h"
 #include "BLI_path_util.h"
 #include "BLI_rect.h"
+#include "BLI_task.h"
+#include "BLI_threads.h"
+
+#include "PIL_time.h"
 
 #include "BKE_anim_data.h"
 #include "BKE_animsys.h"
@@ -39,6 +44,13 @@
 #include "DEG_depsgraph.h"
 #include "DEG_depsgraph_query.h"
 
+#include "GPU_capabilities.h"
+#include "GPU_compute.h"
+#include "GPU_context.h"
+#include "GPU_shader.h"
+#include "GPU_state.h"
+#include "GPU_texture.h"
+
 #include "IMB_colormanagement.h"
 #include "IMB_imbuf.h"
 #include "IMB_imbuf_types.h"
@@ -1461,6 +1473,10 @@ static ImBuf *seq_render_scene_strip(const SeqRenderData *context,
       context->scene->r.seq_prev_type = 3 /* == OB_SOLID */;
     }
 
+    /* Evaluating and drawing the scene is not attributed to the sequencer, see
+     * #seq_render_give_ibuf_seqbase. */
+    const eMEMTag tag_prev = MEM_tag_set(MEM_TAG_NONE);
+
     /* opengl offscreen render */
     depsgraph = BKE_scene_ensure_depsgraph(context->bmain, scene, view_layer);
     BKE_scene_graph_update_for_newframe(depsgraph);
@@ -1480,6 +1496,7 @@ static ImBuf *seq_render_scene_strip(const SeqRenderData *context,
         viewname,
         context->gpu_offscreen,
         err_out);
+    MEM_tag_set(tag_prev);
     if (ibuf == NULL) {
       fprintf(stderr, "seq_render_scene_strip failed to get opengl buffer: %s\n", err_out);
     }
@@ -1504,8 +1521,12 @@ static ImBuf *seq_render_scene_strip(const SeqRenderData *context,
         re = RE_NewSceneRender(scene);
       }
 
+      /* Rendering the scene is not attributed to the sequencer, only the copies of the result
+       * below are. */
+      const eMEMTag tag_prev = MEM_tag_set(MEM_TAG_NONE);
       RE_RenderFrame(
           re, context->bmain, scene, have_comp ? NULL : view_layer, camera, frame, 0.0f, false);
+      MEM_tag_set(tag_prev);
 
       /* restore previous state after it was toggled on & off by RE_RenderFrame */
       G.is_rendering = is_rendering;
@@ -1565,7 +1586,9 @@ finally:
   scene->r.subframe = orig_data.subframe;
 
   if (is_frame_update && (depsgraph != NULL)) {
+    const eMEMTag tag_prev = MEM_tag_set(MEM_TAG_NONE);
     BKE_scene_graph_update_for_newframe(depsgraph);
+    MEM_tag_set(tag_prev);
   }
 
 #ifdef DURIAN_CAMERA_SWITCH
@@ -1783,6 +1806,114 @@ static int seq_get_early_out_for_blend_mode(Sequence *seq)
   return early_out;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name GPU Blending
+ * \{ */
+
+/** Matches the local group size of `gpu_shader_sequencer_blend`. */
+#define SEQ_GPU_BLEND_GROUP_SIZE 16
+
+/**
+ * Blend type of `gpu_shader_sequencer_blend` for the blend mode of \a seq,
+ * -1 when it can only be blended on the CPU.
+ */
+static int seq_render_strip_stack_gpu_blend_type(const Sequence *seq)
+{
+  switch (seq->blend_mode) {
+    case SEQ_TYPE_ALPHAOVER:
+      return 0;
+    case SEQ_TYPE_CROSS:
+      return 1;
+    case SEQ_TYPE_ADD:
+      return 2;
+    case SEQ_TYPE_SUB:
+      return 3;
+    case SEQ_TYPE_MUL:
+      return 4;
+  }
+  return -1;
+}
+
+static GPUTexture *seq_render_gpu_texture_from_imbuf(const char *name, ImBuf *ibuf)
+{
+  return GPU_texture_create_2d(name, ibuf->x, ibuf->y, 1, GPU_RGBA32F, ibuf->rect_float);
+}
+
+/**
+ * Blend float images with a compute shader, when enabled in the experimental preferences.
+ * Only used when rendering on the main thread, which has a GPU context while drawing the preview.
+ * The prefetch and final render threads have none.
+ *
+ * \return The blended image, or NULL when the blend has to be done on the CPU.
+ */
+static ImBuf *seq_render_strip_stack_apply_effect_gpu(
+    const SeqRenderData *context, Sequence *seq, float fac, ImBuf *ibuf1, ImBuf *ibuf2)
+{
+  const int blend_type = seq_render_strip_stack_gpu_blend_type(seq);
+  const int width = context->rectx;
+  const int height = context->recty;
+
+  if (!U.experimental.use_sequencer_gpu_blend || blend_type == -1 || !BLI_thread_is_main() ||
+      GPU_context_active_get() == NULL || !GPU_compute_shader_support()) {
+    return NULL;
+  }
+  /* Byte results are blended with integer math on the CPU, only float results match. */
+  if (ibuf1->rect_float == NULL && ibuf2->rect_float == NULL) {
+    return NULL;
+  }
+  if (ibuf1->x != width || ibuf1->y != height || ibuf2->x != width || ibuf2->y != height ||
+      ibuf1->channels != 4 || ibuf2->channels != 4) {
+    return NULL;
+  }
+
+  /* Same conversion as `prepare_effect_imbufs`. */
+  Scene *scene = context->scene;
+  if (ibuf1->rect_float == NULL) {
+    seq_imbuf_to_sequencer_space(scene, ibuf1, true);
+  }
+  if (ibuf2->rect_float == NULL) {
+    seq_imbuf_to_sequencer_space(scene, ibuf2, true);
+  }
+
+  GPUShader *shader = GPU_shader_get_builtin_shader(GPU_SHADER_SEQUENCER_BLEND);
+  GPU_shader_bind(shader);
+  GPU_shader_uniform_1i(shader, "blend_type", blend_type);
+  GPU_shader_uniform_1f(shader, "fac", fac);
+
+  GPUTexture *texture1 = seq_render_gpu_texture_from_imbuf("seq_blend_input1", ibuf1);
+  GPUTexture *texture2 = seq_render_gpu_texture_from_imbuf("seq_blend_input2", ibuf2);
+  GPUTexture *result = GPU_texture_create_2d(
+      "seq_blend_result", width, height, 1, GPU_RGBA32F, NULL);
+  GPU_texture_bind(texture1, 0);
+  GPU_texture_bind(texture2, 1);
+  GPU_texture_image_bind(result, 0);
+
+  GPU_compute_dispatch(shader,
+                       (width + SEQ_GPU_BLEND_GROUP_SIZE - 1) / SEQ_GPU_BLEND_GROUP_SIZE,
+                       (height + SEQ_GPU_BLEND_GROUP_SIZE - 1) / SEQ_GPU_BLEND_GROUP_SIZE,
+                       1);
+  GPU_memory_barrier(GPU_BARRIER_TEXTURE_UPDATE);
+
+  GPU_texture_image_unbind(result);
+  GPU_texture_unbind(texture1);
+  GPU_texture_unbind(texture2);
+  GPU_shader_unbind();
+
+  ImBuf *out = IMB_allocImBuf(width, height, 32, 0);
+  out->rect_float = GPU_texture_read(result, GPU_DATA_FLOAT, 0);
+  out->mall |= IB_rectfloat;
+  out->flags |= IB_rectfloat;
+  IMB_colormanagement_assign_float_colorspace(out, scene->sequencer_colorspace_settings.name);
+
+  GPU_texture_free(texture1);
+  GPU_texture_free(texture2);
+  GPU_texture_free(result);
+
+  return out;
+}
+
+/** \} */
+
 static ImBuf *seq_render_strip_stack_apply_effect(
     const SeqRenderData *context, Sequence *seq, float timeline_frame, ImBuf *ibuf1, ImBuf *ibuf2)
 {
@@ -1791,6 +1922,12 @@ static ImBuf *seq_render_strip_stack_apply_effect(
   float fac = seq->blend_opacity / 100.0f;
   int swap_input = seq_must_swap_input_in_blend_mode(seq);
 
+  out = swap_input ? seq_render_strip_stack_apply_effect_gpu(context, seq, fac, ibuf2, ibuf1) :
+                     seq_render_strip_stack_apply_effect_gpu(context, seq, fac, ibuf1, ibuf2);
+  if (out) {
+    return out;
+  }
+
   if (swap_input) {
     if (sh.multithreaded) {
       out = seq_render_effect_execute_threaded(
@@ -1813,6 +1950,85 @@ static ImBuf *seq_render_strip_stack_apply_effect(
   return out;
 }
 
+typedef struct RenderStackStripTask {
+  const SeqRenderData *context;
+  Sequence *seq;
+  float timeline_frame;
+  ImBuf **r_ibuf;
+} RenderStackStripTask;
+
+static void seq_render_stack_strip_task(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  RenderStackStripTask *task = taskdata;
+  SeqRenderState state;
+  seq_render_state_init(&state);
+  *task->r_ibuf = seq_render_strip(task->context, &state, task->seq, task->timeline_frame);
+}
+
+/* Strips that only read files can be rendered at the same time as other strips. Scene strips
+ * render through the render pipeline or the viewport, meta strips and effects recurse into
+ * other strips. */
+static bool seq_render_strip_is_independent(const Sequence *seq)
+{
+  if (!ELEM(seq->type, SEQ_TYPE_IMAGE, SEQ_TYPE_MOVIE)) {
+    return false;
+  }
+  LISTBASE_FOREACH (SequenceModifierData *, smd, &seq->modifiers) {
+    if (smd->mask_sequence || smd->mask_id) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Render the independent strips of the stack that are blended into the result concurrently,
+ * into \a r_ibufs. Strips below the first replacing one are never blended.
+ */
+static void seq_render_strip_stack_independent(const SeqRenderData *context,
+                                               Sequence **seq_arr,
+                                               int count,
+                                               float timeline_frame,
+                                               ImBuf **r_ibufs)
+{
+  RenderStackStripTask tasks[MAXSEQ + 1];
+  int tasks_num = 0;
+  for (int i = count - 1; i >= 0; i--) {
+    Sequence *seq = seq_arr[i];
+    if (seq_get_early_out_for_blend_mode(seq) != EARLY_USE_INPUT_1 &&
+        seq_render_strip_is_independent(seq)) {
+      tasks[tasks_num++] = (RenderStackStripTask){context, seq, timeline_frame, &r_ibufs[i]};
+    }
+    if (seq->blend_mode == SEQ_BLEND_REPLACE) {
+      break;
+    }
+  }
+  if (tasks_num < 2) {
+    return;
+  }
+
+  TaskPool *task_pool = BLI_task_pool_create(NULL, TASK_PRIORITY_HIGH);
+  for (int i = 0; i < tasks_num; i++) {
+    BLI_task_pool_push(task_pool, seq_render_stack_strip_task, &tasks[i], false, NULL);
+  }
+  BLI_task_pool_work_and_wait(task_pool);
+  BLI_task_pool_free(task_pool);
+}
+
+/* Get the image of a strip in the stack, rendered beforehand or now. */
+static ImBuf *seq_render_stack_strip(const SeqRenderData *context,
+                                     SeqRenderState *state,
+                                     Sequence *seq,
+                                     float timeline_frame,
+                                     ImBuf *rendered_ibuf)
+{
+  if (rendered_ibuf) {
+    IMB_refImBuf(rendered_ibuf);
+    return rendered_ibuf;
+  }
+  return seq_render_strip(context, state, seq, timeline_frame);
+}
+
 static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
                                      SeqRenderState *state,
                                      ListBase *channels,
@@ -1821,6 +2037,7 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
                                      int chanshown)
 {
   Sequence *seq_arr[MAXSEQ + 1];
+  ImBuf *rendered_ibufs[MAXSEQ + 1] = {NULL};
   int count;
   int i;
   ImBuf *out = NULL;
@@ -1832,6 +2049,14 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
     return NULL;
   }
 
+  if (U.experimental.use_sequencer_parallel_strips && count > 1) {
+    out = seq_cache_get(context, seq_arr[count - 1], timeline_frame, SEQ_CACHE_STORE_COMPOSITE);
+    if (out) {
+      return out;
+    }
+    seq_render_strip_stack_independent(context, seq_arr, count, timeline_frame, rendered_ibufs);
+  }
+
   for (i = count - 1; i >= 0; i--) {
     int early_out;
     Sequence *seq = seq_arr[i];
@@ -1842,7 +2067,7 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
       break;
     }
     if (seq->blend_mode == SEQ_BLEND_REPLACE) {
-      out = seq_render_strip(context, state, seq, timeline_frame);
+      out = seq_render_stack_strip(context, state, seq, timeline_frame, rendered_ibufs[i]);
       break;
     }
 
@@ -1851,7 +2076,7 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
     /* Early out for alpha over. It requires image to be rendered, so it can't use
      * `seq_get_early_out_for_blend_mode`. */
     if (out == NULL && seq->blend_mode == SEQ_TYPE_ALPHAOVER && seq->blend_opacity == 100.0f) {
-      ImBuf *test = seq_render_strip(context, state, seq, timeline_frame);
+      ImBuf *test = seq_render_stack_strip(context, state, seq, timeline_frame, rendered_ibufs[i]);
       if (ELEM(test->planes, R_IMF_PLANES_BW, R_IMF_PLANES_RGB)) {
         early_out = EARLY_USE_INPUT_2;
       }
@@ -1865,7 +2090,7 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
     switch (early_out) {
       case EARLY_NO_INPUT:
       case EARLY_USE_INPUT_2:
-        out = seq_render_strip(context, state, seq, timeline_frame);
+        out = seq_render_stack_strip(context, state, seq, timeline_frame, rendered_ibufs[i]);
         break;
       case EARLY_USE_INPUT_1:
         if (i == 0) {
@@ -1875,7 +2100,8 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
       case EARLY_DO_EFFECT:
         if (i == 0) {
           ImBuf *ibuf1 = IMB_allocImBuf(context->rectx, context->recty, 32, IB_rect);
-          ImBuf *ibuf2 = seq_render_strip(context, state, seq, timeline_frame);
+          ImBuf *ibuf2 = seq_render_stack_strip(
+              context, state, seq, timeline_frame, rendered_ibufs[i]);
 
           out = seq_render_strip_stack_apply_effect(context, seq, timeline_frame, ibuf1, ibuf2);
 
@@ -1898,7 +2124,8 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
 
     if (seq_get_early_out_for_blend_mode(seq) == EARLY_DO_EFFECT) {
       ImBuf *ibuf1 = out;
-      ImBuf *ibuf2 = seq_render_strip(context, state, seq, timeline_frame);
+      ImBuf *ibuf2 = seq_render_stack_strip(
+          context, state, seq, timeline_frame, rendered_ibufs[i]);
 
       out = seq_render_strip_stack_apply_effect(context, seq, timeline_frame, ibuf1, ibuf2);
 
@@ -1909,6 +2136,10 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
     seq_cache_put(context, seq_arr[i], timeline_frame, SEQ_CACHE_STORE_COMPOSITE, out);
   }
 
+  for (i = 0; i < count; i++) {
+    IMB_freeImBuf(rendered_ibufs[i]);
+  }
+
   return out;
 }
 
@@ -1952,7 +2183,13 @@ ImBuf *SEQ_render_give_ibuf(const SeqRenderData *context, float timeline_frame,
 
   if (count && !out) {
     BLI_mutex_lock(&seq_render_mutex);
+    /* Rendered images end up in the sequencer cache. Scene strips clear the tag while evaluating
+     * and rendering their scene. */
+    const eMEMTag tag_prev = MEM_tag_set(MEM_TAG_SEQUENCER);
+    const double start_time = PIL_check_seconds_timer();
     out = seq_render_strip_stack(context, &state, channels, seqbasep, timeline_frame, chanshown);
+    const double render_time = PIL_check_seconds_timer() - start_time;
+    MEM_tag_set(tag_prev);
 
     if (context->is_prefetch_render) {
       seq_cache_put(context, seq_arr[count - 1], timeline_frame, SEQ_CACHE_STORE_FINAL_OUT, out);
@@ -1961,6 +2198,8 @@ ImBuf *SEQ_render_give_ibuf(const SeqRenderData *context, float timeline_frame,
       seq_cache_put_if_possible(
           context, seq_arr[count - 1], timeline_frame, SEQ_CACHE_STORE_FINAL_OUT, out);
     }
+    seq_cache_final_out_cost_set(
+        context, seq_arr[count - 1], timeline_frame, (float)render_time);
     BLI_mutex_unlock(&seq_render_mutex);
   }
 
@@ -1969,6 +2208,65 @@ ImBuf *SEQ_render_give_ibuf(const SeqRenderData *context, float timeline_frame,
   return out;
 }
 
+typedef struct RenderFrameTask {
+  const SeqRenderData *context;
+  float timeline_frame;
+} RenderFrameTask;
+
+static void seq_render_frame_task(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  RenderFrameTask *task = taskdata;
+  const SeqRenderData *context = task->context;
+  Editing *ed = SEQ_editing_get(context->scene);
+  Sequence *seq_arr[MAXSEQ + 1];
+
+  const int count = seq_get_shown_sequences(
+      ed->displayed_channels, ed->seqbasep, task->timeline_frame, 0, seq_arr);
+  if (count == 0) {
+    return;
+  }
+  ImBuf *out = seq_cache_get(
+      context, seq_arr[count - 1], task->timeline_frame, SEQ_CACHE_STORE_FINAL_OUT);
+  if (out == NULL) {
+    SeqRenderState state;
+    seq_render_state_init(&state);
+    const eMEMTag tag_prev = MEM_tag_set(MEM_TAG_SEQUENCER);
+    const double start_time = PIL_check_seconds_timer();
+    out = seq_render_strip_stack(
+        context, &state, ed->displayed_channels, ed->seqbasep, task->timeline_frame, 0);
+    const double render_time = PIL_check_seconds_timer() - start_time;
+    MEM_tag_set(tag_prev);
+    seq_cache_put(
+        context, seq_arr[count - 1], task->timeline_frame, SEQ_CACHE_STORE_FINAL_OUT, out);
+    seq_cache_final_out_cost_set(
+        context, seq_arr[count - 1], task->timeline_frame, (float)render_time);
+  }
+  IMB_freeImBuf(out);
+}
+
+void seq_render_frames_concurrent(const SeqRenderData *context,
+                                  const float *timeline_frames,
+                                  int frames_num)
+{
+  if (SEQ_editing_get(context->scene) == NULL) {
+    return;
+  }
+
+  RenderFrameTask *tasks = MEM_malloc_arrayN(frames_num, sizeof(*tasks), __func__);
+  BLI_mutex_lock(&seq_render_mutex);
+  TaskPool *pool = BLI_task_pool_create(NULL, TASK_PRIORITY_LOW);
+  /* Frames closest to the playhead are pushed first, so they are started first. */
+  for (int i = 0; i < frames_num; i++) {
+    tasks[i].context = context;
+    tasks[i].timeline_frame = timeline_frames[i];
+    BLI_task_pool_push(pool, seq_render_frame_task, &tasks[i], false, NULL);
+  }
+  BLI_task_pool_work_and_wait(pool);
+  BLI_task_pool_free(pool);
+  BLI_mutex_unlock(&seq_render_mutex);
+  MEM_freeN(tasks);
+}
+
 ImBuf *seq_render_give_ibuf_seqbase(const SeqRenderData *context,
                                     float timeline_frame,
                                     int chan_shown,
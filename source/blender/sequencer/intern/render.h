@@ -43,6 +43,13 @@ struct ImBuf *seq_render_effect_execute_threaded(struct SeqEffectHandle *sh,
                                                  struct ImBuf *ibuf1,
                                                  struct ImBuf *ibuf2,
                                                  struct ImBuf *ibuf3);
+/**
+ * Render the final images of several frames at the same time and store them in the cache.
+ * Only for scenes whose strips can be rendered concurrently, see #seq_prefetch_frames.
+ */
+void seq_render_frames_concurrent(const struct SeqRenderData *context,
+                                  const float *timeline_frames,
+                                  int frames_num);
 void seq_imbuf_to_sequencer_space(struct Scene *scene, struct ImBuf *ibuf, bool make_float);
 int seq_get_shown_sequences(struct ListBase *channels,
                             struct ListBase *seqbase,
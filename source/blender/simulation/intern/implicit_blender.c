@@ -18,6 +18,7 @@
 #  include "DNA_texture_types.h"
 
 #  include "BLI_math.h"
+#  include "BLI_task.h"
 #  include "BLI_utildefines.h"
 
 #  include "BKE_cloth.h"
@@ -34,6 +35,9 @@
 #    define CLOTH_OPENMP_LIMIT 512
 #  endif
 
+/* Minimum vertex count to split solver work over threads. */
+#  define CLOTH_THREADING_LIMIT 512
+
 //#define DEBUG_TIME
 
 #  ifdef DEBUG_TIME
@@ -597,6 +601,27 @@ DO_INLINE void initdiag_bfmatrix(fmatrix3x3 *matrix, float m3[3][3])
   }
 }
 
+typedef struct MulBFMatrixLowerData {
+  float (*to)[3];
+  fmatrix3x3 *from;
+  lfVector *fLongVector;
+} MulBFMatrixLowerData;
+
+static void mul_bfmatrix_lfvector_lower(float (*to)[3], fmatrix3x3 *from, lfVector *fLongVector)
+{
+  for (unsigned int i = from[0].vcount; i < from[0].vcount + from[0].scount; i++) {
+    /* This is the lower triangle of the sparse matrix,
+     * therefore multiplication occurs with transposed submatrices. */
+    muladd_fmatrixT_fvector(to[from[i].c], from[i].m, fLongVector[from[i].r]);
+  }
+}
+
+static void mul_bfmatrix_lfvector_lower_task(TaskPool *__restrict UNUSED(pool), void *taskdata)
+{
+  MulBFMatrixLowerData *data = taskdata;
+  mul_bfmatrix_lfvector_lower(data->to, data->from, data->fLongVector);
+}
+
 /* SPARSE SYMMETRIC multiply big matrix with long vector. */
 /* STATUS: verified */
 DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3], fmatrix3x3 *from, lfVector *fLongVector)
@@ -606,21 +631,25 @@ DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3], fmatrix3x3 *from, lfVector
 
   zero_lfvector(to, vcount);
 
-#  pragma omp parallel sections if (vcount > CLOTH_OPENMP_LIMIT)
-  {
-#  pragma omp section
-    {
-      for (unsigned int i = from[0].vcount; i < from[0].vcount + from[0].scount; i++) {
-        /* This is the lower triangle of the sparse matrix,
-         * therefore multiplication occurs with transposed submatrices. */
-        muladd_fmatrixT_fvector(to[from[i].c], from[i].m, fLongVector[from[i].r]);
-      }
+  /* The lower and upper triangle write to separate vectors, so the lower triangle can run in
+   * another thread while this one does the rest. The result does not depend on threading. */
+  if (vcount > CLOTH_THREADING_LIMIT) {
+    MulBFMatrixLowerData lower_data = {to, from, fLongVector};
+    TaskPool *task_pool = BLI_task_pool_create(NULL, TASK_PRIORITY_HIGH);
+    BLI_task_pool_push(task_pool, mul_bfmatrix_lfvector_lower_task, &lower_data, false, NULL);
+
+    for (unsigned int i = 0; i < from[0].vcount + from[0].scount; i++) {
+      muladd_fmatrix_fvector(temp[from[i].r], from[i].m, fLongVector[from[i].c]);
     }
-#  pragma omp section
-    {
-      for (unsigned int i = 0; i < from[0].vcount + from[0].scount; i++) {
-        muladd_fmatrix_fvector(temp[from[i].r], from[i].m, fLongVector[from[i].c]);
-      }
+
+    BLI_task_pool_work_and_wait(task_pool);
+    BLI_task_pool_free(task_pool);
+  }
+  else {
+    mul_bfmatrix_lfvector_lower(to, from, fLongVector);
+
+    for (unsigned int i = 0; i < from[0].vcount + from[0].scount; i++) {
+      muladd_fmatrix_fvector(temp[from[i].r], from[i].m, fLongVector[from[i].c]);
     }
   }
   add_lfvector_lfvector(to, to, temp, from[0].vcount);
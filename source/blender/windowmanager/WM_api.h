@@ -247,6 +247,15 @@ bool WM_stereo3d_enabled(struct wmWindow *win, bool only_fullscreen_test);
 
 void WM_file_autoexec_init(const char *filepath);
 bool WM_file_read(struct bContext *C, const char *filepath, struct ReportList *reports);
+/**
+ * \param use_scene_only: Only read the data-blocks used by the active scene (and the UI), for
+ * loading a file that is only rendered. Anything else is missing from the loaded file, so it
+ * must not be used when scripts may run or the file may be saved again.
+ */
+bool WM_file_read_ex(struct bContext *C,
+                     const char *filepath,
+                     bool use_scene_only,
+                     struct ReportList *reports);
 void WM_file_autosave_init(struct wmWindowManager *wm);
 bool WM_file_recover_last_session(struct bContext *C, struct ReportList *reports);
 void WM_file_tag_modified(void);
@@ -1294,6 +1303,7 @@ enum {
   WM_JOB_TYPE_TRACE_IMAGE,
   WM_JOB_TYPE_LINEART,
   WM_JOB_TYPE_SEQ_DRAW_THUMBNAIL,
+  WM_JOB_TYPE_AUTOSAVE,
   /* add as needed, bake, seq proxy build
    * if having hard coded values is a problem */
 };
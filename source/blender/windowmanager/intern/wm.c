@@ -627,5 +627,8 @@ void WM_main(bContext *C)
 
     /* Execute cached changes draw. */
     wm_draw_update(C);
+
+    /* Only does something once, after the first redraw. */
+    wm_init_deferred_run(C);
   }
 }
@@ -452,6 +452,12 @@ static void wm_init_userdef(Main *bmain)
   MEM_CacheLimiter_set_maximum(((size_t)U.memcachelimit) * 1024 * 1024);
   BKE_sound_init(bmain);
 
+#ifdef WITH_FFMPEG
+  IMB_ffmpeg_set_decode_settings(U.movie_decode_threads,
+                                 (eIMBDecodeThreadType)U.movie_decode_thread_type,
+                                 (U.movie_decode_flag & USER_MOVIE_DECODE_HARDWARE) != 0);
+#endif
+
   /* Update the temporary directory from the preferences or fallback to the system default. */
   BKE_tempdir_init(U.tempdir);
 
@@ -884,7 +890,10 @@ static void file_read_reports_finalize(BlendFileReadReport *bf_reports)
   bf_reports->resynced_lib_overrides_libraries = NULL;
 }
 
-bool WM_file_read(bContext *C, const char *filepath, ReportList *reports)
+bool WM_file_read_ex(bContext *C,
+                     const char *filepath,
+                     const bool use_scene_only,
+                     ReportList *reports)
 {
   /* assume automated tasks with background, don't write recent file list */
   const bool do_history_file_update = (G.background == false) &&
@@ -911,7 +920,7 @@ bool WM_file_read(bContext *C, const char *filepath, ReportList *reports)
         /* Loading preferences when the user intended to load a regular file is a security
          * risk, because the excluded path list is also loaded. Further it's just confusing
          * if a user loads a file and various preferences change. */
-        .skip_flags = BLO_READ_SKIP_USERDEF,
+        .skip_flags = BLO_READ_SKIP_USERDEF | (use_scene_only ? BLO_READ_SKIP_UNREACHABLE : 0),
     };
 
     BlendFileReadReport bf_reports = {.reports = reports,
@@ -1002,6 +1011,11 @@ bool WM_file_read(bContext *C, const char *filepath, ReportList *reports)
   return success;
 }
 
+bool WM_file_read(bContext *C, const char *filepath, ReportList *reports)
+{
+  return WM_file_read_ex(C, filepath, false, reports);
+}
+
 static struct {
   char app_template[64];
   bool override;
@@ -1827,6 +1841,8 @@ static bool wm_file_write(bContext *C,
                          .remap_mode = remap_mode,
                          .use_save_versions = true,
                          .use_save_as_copy = use_save_as_copy,
+                         /* Interactive sessions tend to save the same file repeatedly. */
+                         .use_frame_cache = !G.background,
                          .thumb = thumb,
                      },
                      reports)) {
@@ -1918,6 +1934,47 @@ static void wm_autosave_location(char *filepath)
   BLI_join_dirfile(filepath, FILE_MAX, BKE_tempdir_base(), path);
 }
 
+typedef struct AutosaveJob {
+  char filepath[FILE_MAX];
+  /** Shares the chunk buffers of the undo memfile, since undo steps may be freed meanwhile. */
+  MemFile memfile;
+} AutosaveJob;
+
+static void wm_autosave_job_startjob(void *customdata,
+                                     short *UNUSED(stop),
+                                     short *UNUSED(do_update),
+                                     float *UNUSED(progress))
+{
+  AutosaveJob *autosave_job = customdata;
+  /* Ignore the stop request, a partially written file is worse than waiting for it. */
+  BLO_memfile_write_file(&autosave_job->memfile, autosave_job->filepath);
+}
+
+static void wm_autosave_job_free(void *customdata)
+{
+  AutosaveJob *autosave_job = customdata;
+  BLO_memfile_free(&autosave_job->memfile);
+  MEM_freeN(autosave_job);
+}
+
+/**
+ * Write the undo memfile from a background job, so that the disk IO for big files doesn't
+ * freeze the interface. The job only takes references to the buffers of the memfile, their
+ * content isn't copied.
+ */
+static void wm_autosave_write_job(wmWindowManager *wm, MemFile *memfile, const char *filepath)
+{
+  AutosaveJob *autosave_job = MEM_callocN(sizeof(*autosave_job), __func__);
+  STRNCPY(autosave_job->filepath, filepath);
+  BLO_memfile_shared_copy(memfile, &autosave_job->memfile);
+
+  wmJob *wm_job = WM_jobs_get(wm, NULL, wm, "Auto Save", 0, WM_JOB_TYPE_AUTOSAVE);
+  WM_jobs_customdata_set(wm_job, autosave_job, wm_autosave_job_free);
+  WM_jobs_timer(wm_job, 0.5, 0, 0);
+  WM_jobs_callbacks(wm_job, wm_autosave_job_startjob, NULL, NULL, NULL);
+  WM_jobs_start(wm, wm_job);
+}
+
 static void wm_autosave_write(Main *bmain, wmWindowManager *wm)
 {
   char filepath[FILE_MAX];
@@ -1928,7 +1985,12 @@ static void wm_autosave_write(Main *bmain, wmWindowManager *wm)
   const bool use_memfile = (U.uiflag & USER_GLOBALUNDO) != 0;
   MemFile *memfile = use_memfile ? ED_undosys_stack_memfile_get_active(wm->undo_stack) : NULL;
   if (memfile != NULL) {
-    BLO_memfile_write_file(memfile, filepath);
+    if (G.background) {
+      BLO_memfile_write_file(memfile, filepath);
+    }
+    else {
+      wm_autosave_write_job(wm, memfile, filepath);
+    }
   }
   else {
     if (use_memfile) {
@@ -1991,6 +2053,12 @@ void wm_autosave_timer(Main *bmain, wmWindowManager *wm, wmTimer *UNUSED(wt))
     }
   }
 
+  /* The previous auto-save is still being written, try again a bit later. */
+  if (WM_jobs_test(wm, wm, WM_JOB_TYPE_AUTOSAVE)) {
+    wm_autosave_timer_begin_ex(wm, 1.0);
+    return;
+  }
+
   wm_autosave_write(bmain, wm);
 
   /* Restart the timer after file write, just in case file write takes a long time. */
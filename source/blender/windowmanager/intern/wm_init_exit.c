@@ -25,6 +25,8 @@
 #include "DNA_userdef_types.h"
 #include "DNA_windowmanager_types.h"
 
+#include "PIL_time.h"
+
 #include "BLI_listbase.h"
 #include "BLI_path_util.h"
 #include "BLI_string.h"
@@ -33,6 +35,7 @@
 #include "BLI_timer.h"
 #include "BLI_utildefines.h"
 
+#include "BLO_io_stats.h"
 #include "BLO_undofile.h"
 #include "BLO_writefile.h"
 
@@ -132,6 +135,11 @@ CLG_LOGREF_DECLARE_GLOBAL(WM_LOG_TOOLS, "wm.tool");
 CLG_LOGREF_DECLARE_GLOBAL(WM_LOG_MSGBUS_PUB, "wm.msgbus.pub");
 CLG_LOGREF_DECLARE_GLOBAL(WM_LOG_MSGBUS_SUB, "wm.msgbus.sub");
 
+static CLG_LogRef LOG = {"wm.init"};
+
+/** Startup work left for #wm_init_deferred_run, see #WM_init. */
+static bool wm_init_deferred_pending = false;
+
 static void wm_init_reports(bContext *C)
 {
   ReportList *reports = CTX_wm_reports(C);
@@ -209,6 +217,8 @@ static void sound_jack_sync_callback(Main *bmain, int mode, double time)
 
 void WM_init(bContext *C, int argc, const char **argv)
 {
+  /* Timings of the slowest startup steps, reported with `--log "wm.init"`. */
+  const double time_start = PIL_check_seconds_timer();
 
   if (!G.background) {
     wm_ghost_init(C); /* NOTE: it assigns C to ghost! */
@@ -285,6 +295,7 @@ void WM_init(bContext *C, int argc, const char **argv)
    * Creating a dummy window-manager early, or moving the key-maps into the preferences
    * would resolve this and may be worth looking into long-term, see: D12184 for details.
    */
+  const double time_homefile = PIL_check_seconds_timer();
   struct wmFileReadPost_Params *params_file_read_post = NULL;
   wm_homefile_read_ex(C,
                       &(const struct wmHomeFileRead_Params){
@@ -311,6 +322,7 @@ void WM_init(bContext *C, int argc, const char **argv)
   /* That one is generated on demand, we need to be sure it's clear on init. */
   IMB_thumb_clear_translations();
 
+  const double time_gpu = PIL_check_seconds_timer();
   if (!G.background) {
 
 #ifdef WITH_INPUT_NDOF
@@ -331,6 +343,7 @@ void WM_init(bContext *C, int argc, const char **argv)
 
   ED_spacemacros_init();
 
+  const double time_python = PIL_check_seconds_timer();
 #ifdef WITH_PYTHON
   BPY_python_start(C, argc, argv);
   BPY_python_reset(C);
@@ -347,6 +360,8 @@ void WM_init(bContext *C, int argc, const char **argv)
     }
   }
 
+  const double time_python_end = PIL_check_seconds_timer();
+
   BKE_material_copybuf_clear();
   ED_render_clear_mtex_copybuf();
 
@@ -355,6 +370,39 @@ void WM_init(bContext *C, int argc, const char **argv)
   BLI_strncpy(G.lib, BKE_main_blendfile_path_from_global(), sizeof(G.lib));
 
   wm_homefile_read_post(C, params_file_read_post);
+
+  /* Add-ons may be registered after the first redraw, see #wm_init_deferred_run. */
+  wm_init_deferred_pending = !G.background;
+
+  const double time_end = PIL_check_seconds_timer();
+  CLOG_INFO(&LOG,
+            1,
+            "Startup took %.3fs (types %.3fs, home file %.3fs, GPU/UI %.3fs, Python %.3fs)",
+            time_end - time_start,
+            time_homefile - time_start,
+            time_gpu - time_homefile,
+            time_python - time_gpu,
+            time_python_end - time_python);
+}
+
+void wm_init_deferred_run(bContext *C)
+{
+  if (!wm_init_deferred_pending) {
+    return;
+  }
+  wm_init_deferred_pending = false;
+
+#ifdef WITH_PYTHON
+  const double time_start = PIL_check_seconds_timer();
+  /* Does nothing unless the "Deferred Add-on Registration" option left add-ons out of startup.
+   * Their asset views only start loading asset libraries once they are registered. */
+  BPY_run_string_exec(
+      C, (const char *[]){"bpy", NULL}, "bpy.utils._addons_initialize_deferred()");
+  WM_main_add_notifier(NC_WINDOW, NULL);
+  CLOG_INFO(&LOG, 1, "Deferred startup took %.3fs", PIL_check_seconds_timer() - time_start);
+#else
+  UNUSED_VARS(C);
+#endif
 }
 
 void WM_init_splash(bContext *C)
@@ -513,6 +561,9 @@ void WM_exit_ex(bContext *C, const bool do_python)
 
   free_openrecent();
 
+  BLO_write_frame_cache_free();
+  BLO_io_stats_free();
+
   BKE_mball_cubeTable_free();
 
   /* render code might still access databases */
@@ -617,6 +668,10 @@ void WM_exit_ex(bContext *C, const bool do_python)
 
   DNA_sdna_current_free();
 
+  if (G.debug & G_DEBUG) {
+    BLI_task_parallel_for_stats_print();
+  }
+
   BLI_threadapi_exit();
   BLI_task_scheduler_exit();
 
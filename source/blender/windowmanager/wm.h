@@ -32,6 +32,10 @@ typedef struct wmPaintCursor {
  * call to avoid leaking memory when trying to exit from within operators.
  */
 void wm_exit_schedule_delayed(const bContext *C);
+/**
+ * Run the startup work #WM_init leaves for after the first redraw, once.
+ */
+void wm_init_deferred_run(bContext *C);
 
 /**
  * Context is allowed to be NULL, do not free wm itself (lib_id.c).
@@ -305,16 +305,24 @@ int main(int argc,
    */
   {
     int i;
+    bool use_threadcache_allocator = false;
     for (i = 0; i < argc; i++) {
       if (STR_ELEM(argv[i], "-d", "--debug", "--debug-memory", "--debug-all")) {
         printf("Switching to fully guarded memory allocator.\n");
         MEM_use_guarded_allocator();
+        use_threadcache_allocator = false;
         break;
       }
+      if (STREQ(argv[i], "--memory-thread-cache")) {
+        use_threadcache_allocator = true;
+      }
       if (STREQ(argv[i], "--")) {
         break;
       }
     }
+    if (use_threadcache_allocator) {
+      MEM_use_threadcache_allocator();
+    }
     MEM_init_memleak_detection();
   }
 
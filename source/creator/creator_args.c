@@ -360,6 +360,9 @@ fail:
 /** \name Utilities Python Context Macro (#BPY_CTX_SETUP)
  * \{ */
 
+/** Set once any Python code passed on the command line ran, see #arg_load_file_use_scene_only. */
+static bool arg_py_has_run = false;
+
 #  ifdef WITH_PYTHON
 
 struct BlendePyContextStore {
@@ -373,6 +376,7 @@ static void arg_py_context_backup(bContext *C,
                                   struct BlendePyContextStore *c_py,
                                   const char *script_id)
 {
+  arg_py_has_run = true;
   c_py->wm = CTX_wm_manager(C);
   c_py->scene = CTX_data_scene(C);
   c_py->has_win = !BLI_listbase_is_empty(&c_py->wm->windows);
@@ -575,6 +579,7 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
   BLI_args_print_arg_doc(ba, "--debug-depsgraph-time");
   BLI_args_print_arg_doc(ba, "--debug-depsgraph-pretty");
   BLI_args_print_arg_doc(ba, "--debug-depsgraph-uuid");
+  BLI_args_print_arg_doc(ba, "--debug-depsgraph-trace");
   BLI_args_print_arg_doc(ba, "--debug-ghost");
   BLI_args_print_arg_doc(ba, "--debug-gpu");
   BLI_args_print_arg_doc(ba, "--debug-gpu-force-workarounds");
@@ -585,6 +590,7 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
 #  endif
   BLI_args_print_arg_doc(ba, "--debug-all");
   BLI_args_print_arg_doc(ba, "--debug-io");
+  BLI_args_print_arg_doc(ba, "--debug-io-stats");
 
   printf("\n");
   BLI_args_print_arg_doc(ba, "--debug-fpe");
@@ -600,6 +606,7 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
   BLI_args_print_arg_doc(ba, "--app-template");
   BLI_args_print_arg_doc(ba, "--factory-startup");
   BLI_args_print_arg_doc(ba, "--enable-event-simulate");
+  BLI_args_print_arg_doc(ba, "--memory-thread-cache");
   printf("\n");
   BLI_args_print_arg_doc(ba, "--env-system-datafiles");
   BLI_args_print_arg_doc(ba, "--env-system-scripts");
@@ -977,9 +984,16 @@ static const char arg_handle_debug_mode_generic_set_doc_depsgraph_no_threads[] =
 static const char arg_handle_debug_mode_generic_set_doc_depsgraph_pretty[] =
     "\n\t"
     "Enable colors for dependency graph debug messages.";
+static const char arg_handle_debug_mode_generic_set_doc_depsgraph_trace[] =
+    "\n\t"
+    "Record a timeline of dependency graph evaluation, which can be exported with\n"
+    "\t'Depsgraph.debug_trace_chrome()' from Python.";
 static const char arg_handle_debug_mode_generic_set_doc_depsgraph_uuid[] =
     "\n\t"
     "Verify validness of session-wide identifiers assigned to ID datablocks.";
+static const char arg_handle_debug_mode_generic_set_doc_io_stats[] =
+    "\n\t"
+    "Enable timing and size statistics per ID for reading and writing blend files.";
 static const char arg_handle_debug_mode_generic_set_doc_gpu_force_workarounds[] =
     "\n\t"
     "Enable workarounds for typical GPU issues and disable all GPU extensions.";
@@ -1058,6 +1072,19 @@ static int arg_handle_debug_mode_memory_set(int UNUSED(argc),
   return 0;
 }
 
+static const char arg_handle_memory_thread_cache_set_doc[] =
+    "\n\t"
+    "Use a memory allocator with per-thread caches of freed blocks, for less contention between\n"
+    "\tthreads in allocation heavy work.\n"
+    "\tIgnored when fully guarded memory allocation is enabled by debug arguments.";
+static int arg_handle_memory_thread_cache_set(int UNUSED(argc),
+                                              const char **UNUSED(argv),
+                                              void *UNUSED(data))
+{
+  /* Handled in `main()` before any allocation happens. */
+  return 0;
+}
+
 static const char arg_handle_debug_value_set_doc[] =
     "<value>\n"
     "\tSet debug value of <value> on startup.";
@@ -1945,7 +1972,43 @@ static int arg_handle_addons_set(int argc, const char **argv, void *data)
   return 0;
 }
 
-static int arg_handle_load_file(int UNUSED(argc), const char **argv, void *data)
+/**
+ * Whether the file loaded by the current argument is only rendered in the background, so that
+ * only the data-blocks used by its active scene have to be read. This is the case when a render
+ * argument follows, and no Python code or scene change could access other data-blocks.
+ */
+static bool arg_load_file_use_scene_only(int argc, const char **argv)
+{
+  if (!G.background || arg_py_has_run || (G.f & G_FLAG_SCRIPT_AUTOEXEC)) {
+    return false;
+  }
+
+  bool has_render = false;
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    if (STR_ELEM(arg, "-f", "--render-frame", "-a", "--render-anim")) {
+      has_render = true;
+    }
+    else if (STR_ELEM(arg,
+                      "-P",
+                      "--python",
+                      "--python-text",
+                      "--python-expr",
+                      "--python-console",
+                      "--addons",
+                      "-S",
+                      "--scene")) {
+      return false;
+    }
+    else if (arg[0] != '-' && BLO_has_bfile_extension(arg)) {
+      /* Arguments after another file apply to that file. */
+      break;
+    }
+  }
+  return has_render;
+}
+
+static int arg_handle_load_file(int argc, const char **argv, void *data)
 {
   bContext *C = data;
   ReportList reports;
@@ -1967,7 +2030,7 @@ static int arg_handle_load_file(int UNUSED(argc), const char **argv, void *data)
   /* load the file */
   BKE_reports_init(&reports, RPT_PRINT);
   WM_file_autoexec_init(filepath);
-  success = WM_file_read(C, filepath, &reports);
+  success = WM_file_read_ex(C, filepath, arg_load_file_use_scene_only(argc, argv), &reports);
   BKE_reports_clear(&reports);
 
   if (success) {
@@ -2135,6 +2198,11 @@ void main_args_setup(bContext *C, bArgs *ba)
   BLI_args_add(ba, NULL, "--debug-all", CB(arg_handle_debug_mode_all), NULL);
 
   BLI_args_add(ba, NULL, "--debug-io", CB(arg_handle_debug_mode_io), NULL);
+  BLI_args_add(ba,
+               NULL,
+               "--debug-io-stats",
+               CB_EX(arg_handle_debug_mode_generic_set, io_stats),
+               (void *)G_DEBUG_IO_STATS);
 
   BLI_args_add(ba, NULL, "--debug-fpe", CB(arg_handle_debug_fpe_set), NULL);
 
@@ -2195,6 +2263,11 @@ void main_args_setup(bContext *C, bArgs *ba)
                "--debug-depsgraph-uuid",
                CB_EX(arg_handle_debug_mode_generic_set, depsgraph_uuid),
                (void *)G_DEBUG_DEPSGRAPH_UUID);
+  BLI_args_add(ba,
+               NULL,
+               "--debug-depsgraph-trace",
+               CB_EX(arg_handle_debug_mode_generic_set, depsgraph_trace),
+               (void *)G_DEBUG_DEPSGRAPH_TRACE);
   BLI_args_add(ba,
                NULL,
                "--debug-gpu-force-workarounds",
@@ -2207,6 +2280,7 @@ void main_args_setup(bContext *C, bArgs *ba)
   BLI_args_add(ba, NULL, "--app-template", CB(arg_handle_app_template), NULL);
   BLI_args_add(ba, NULL, "--factory-startup", CB(arg_handle_factory_startup_set), NULL);
   BLI_args_add(ba, NULL, "--enable-event-simulate", CB(arg_handle_enable_event_simulate), NULL);
+  BLI_args_add(ba, NULL, "--memory-thread-cache", CB(arg_handle_memory_thread_cache_set), NULL);
 
   /* Pass: Custom Window Stuff. */
   BLI_args_pass_set(ba, ARG_PASS_SETTINGS_GUI);
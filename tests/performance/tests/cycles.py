@@ -45,6 +45,10 @@ def _run(args):
                 else:
                     index += 1
 
+    # Print scene update statistics, for scene update and BVH build times.
+    import _cycles
+    _cycles.enable_print_stats()
+
     # Render
     bpy.ops.render.render(write_still=True)
 
@@ -78,9 +82,17 @@ class CyclesTest(api.Test):
         prefix_time = "Render time (without synchronization): "
         prefix_memory = "Peak: "
         prefix_time_per_sample = "Average time per sample: "
+        prefix_rendered_samples = "Rendered "
+        prefix_sync_time = "Total time spent synchronizing data: "
         time = None
         time_per_sample = None
         memory = None
+        samples_per_second = None
+        sync_time = 0.0
+        scene_update_time = 0.0
+        bvh_time = 0.0
+        in_update_stats = False
+        update_stats_section = None
         for line in lines:
             line = line.strip()
             offset = line.find(prefix_time)
@@ -98,13 +110,46 @@ class CyclesTest(api.Test):
                 memory = memory.split()[0].replace(',', '')
                 memory = float(memory)
 
+            # Render statistics: "Rendered N samples in T seconds".
+            if line.startswith(prefix_rendered_samples) and line.endswith(" seconds"):
+                tokens = line.split()
+                if len(tokens) == 6 and float(tokens[4]) > 0.0:
+                    samples_per_second = float(tokens[1]) / float(tokens[4])
+
+            # Blender to Cycles synchronization, printed after every sync.
+            offset = line.find(prefix_sync_time)
+            if offset != -1:
+                sync_time += float(line[offset + len(prefix_sync_time):])
+
+            # Scene update statistics, printed after every scene update.
+            if line == "Update statistics:":
+                in_update_stats = True
+                update_stats_section = None
+            elif in_update_stats:
+                if not line:
+                    in_update_stats = False
+                elif line.endswith(":"):
+                    update_stats_section = line[:-1]
+                elif update_stats_section == "Scene" and line.startswith("Total time: "):
+                    scene_update_time += float(line[len("Total time: "):].rstrip('s'))
+                elif update_stats_section == "Geometry" and line.find("BVH") != -1:
+                    bvh_time += float(line.split()[-1].rstrip('s'))
+
         if time_per_sample:
             time = time_per_sample
 
         if not (time and memory):
             raise Exception("Error parsing render time output")
 
-        return {'time': time, 'peak_memory': memory}
+        output = {'time': time,
+                  'peak_memory': memory,
+                  'sync_time': sync_time,
+                  'scene_update_time': scene_update_time,
+                  'bvh_build_time': bvh_time}
+        if samples_per_second:
+            output['samples_per_second'] = samples_per_second
+
+        return output
 
 
 def generate(env):